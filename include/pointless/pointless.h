@@ -9,6 +9,8 @@
 #include <pointless/pointless_reader_helpers.h>
 #include <pointless/pointless_eval.h>
 #include <pointless/pointless_recreate.h>
+#include <pointless/pointless_vector_ops.h>
+#include <pointless/pointless_prepared_key.h>
 
 #endif
 
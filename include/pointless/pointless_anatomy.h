@@ -0,0 +1,80 @@
+#ifndef __POINTLESS__ANATOMY__H__
+#define __POINTLESS__ANATOMY__H__
+
+#include <stdio.h>
+#include <string.h>
+
+#include <pointless/pointless_defs.h>
+#include <pointless/pointless_value.h>
+#include <pointless/pointless_malloc.h>
+
+// file anatomy, where the bytes of a file go
+//
+// every byte of the file is attributed to a single category: the header, the offset vectors, each kind of heap
+// object, or padding, which is the alignment of the heap and of vectors, and any object no value refers to (such as
+// the empty key vector of a dense map). heap objects are typed by the values referring to them, so the heap is walked
+// from the root, each object being counted once, the first time it is reached
+//
+// hash, key and value vectors of sets and maps are categories of their own, less their empty slots (the index slots
+// of the compact layout, the absent keys of dense maps), see pointless_hash_table_stats.h. the vectors making up an
+// encoded vector are counted as the encoded vector
+//
+// if the root is a map, the bytes of each of its entries are those of the objects first reached from its key and
+// value, so objects shared between entries count towards the first of them, in iteration order. the header and
+// vectors of the root map itself are in no entry
+#define POINTLESS_ANATOMY_HEADER              0
+#define POINTLESS_ANATOMY_OFFSETS             1
+#define POINTLESS_ANATOMY_PADDING             2
+#define POINTLESS_ANATOMY_STRING              3
+#define POINTLESS_ANATOMY_STRING_SYMBOLS      4
+#define POINTLESS_ANATOMY_STRING_SYMBOL_TABLE 5
+#define POINTLESS_ANATOMY_UNICODE             6
+#define POINTLESS_ANATOMY_VECTOR_VALUE        7
+#define POINTLESS_ANATOMY_VECTOR_I8           8
+#define POINTLESS_ANATOMY_VECTOR_U8           9
+#define POINTLESS_ANATOMY_VECTOR_I16          10
+#define POINTLESS_ANATOMY_VECTOR_U16          11
+#define POINTLESS_ANATOMY_VECTOR_I32          12
+#define POINTLESS_ANATOMY_VECTOR_U32          13
+#define POINTLESS_ANATOMY_VECTOR_I64          14
+#define POINTLESS_ANATOMY_VECTOR_U64          15
+#define POINTLESS_ANATOMY_VECTOR_FLOAT        16
+#define POINTLESS_ANATOMY_VECTOR_DICTIONARY   17
+#define POINTLESS_ANATOMY_VECTOR_RUNS         18
+#define POINTLESS_ANATOMY_VECTOR_SPLIT        19
+#define POINTLESS_ANATOMY_VECTOR_BLOCKS       20
+#define POINTLESS_ANATOMY_TABLE               21
+#define POINTLESS_ANATOMY_BITVECTOR           22
+#define POINTLESS_ANATOMY_HASH_TABLE_HEADER   23
+#define POINTLESS_ANATOMY_HASH_VECTOR         24
+#define POINTLESS_ANATOMY_KEY_VECTOR          25
+#define POINTLESS_ANATOMY_VALUE_VECTOR        26
+#define POINTLESS_ANATOMY_EMPTY_SLOTS         27
+#define POINTLESS_ANATOMY_BLOOM               28
+#define POINTLESS_ANATOMY_N_CATEGORIES        29
+
+typedef struct {
+	pointless_complete_value_t key;
+	uint64_t n_bytes;
+} pointless_anatomy_entry_t;
+
+typedef struct {
+	uint64_t n_bytes[POINTLESS_ANATOMY_N_CATEGORIES];
+	uint64_t n_objects[POINTLESS_ANATOMY_N_CATEGORIES];
+
+	// the entries of a root map, in iteration order, 0 if the root is not a map
+	uint32_t n_entries;
+	pointless_anatomy_entry_t* entries;
+} pointless_anatomy_t;
+
+// short name of a category, e.g. "hash vectors"
+const char* pointless_anatomy_category_name(uint32_t category);
+
+// the caller frees the entries with pointless_anatomy_free()
+int pointless_anatomy(pointless_t* p, pointless_anatomy_t* a, const char** error);
+void pointless_anatomy_free(pointless_anatomy_t* a);
+
+// the categories, then the root map entries, largest first
+int pointless_anatomy_print(pointless_t* p, FILE* out, const char** error);
+
+#endif
@@ -19,10 +19,90 @@
 #include <pointless/pointless_create_cache.h>
 #include <pointless/pointless_unicode_utils.h>
 #include <pointless/bitutils.h>
+#include <pointless/pointless_string_symbols.h>
 
 // creation
 void pointless_create_begin_32(pointless_create_t* c);
 void pointless_create_begin_64(pointless_create_t* c);
+
+// same as pointless_create_begin_64(), but the file is written with 32-bit offsets if its heap is small enough for them
+void pointless_create_begin_auto(pointless_create_t* c);
+
+// attach a Bloom filter to sets and maps with at least 'n_keys' keys, 0 (the default) for none
+void pointless_create_bloom_threshold(pointless_create_t* c, uint32_t n_keys);
+
+// store sets and maps in the compact layout (see pointless_hash_table.h), iterated in insertion order
+void pointless_create_compact_hash_tables(pointless_create_t* c, uint32_t is_compact);
+
+// store the keys and values of sets and maps in primitive vectors (i8..u64, float) when their contents
+// allow, this implies the compact layout. keys must fit into 32 bits, so 64-bit integer keys are not typed
+void pointless_create_typed_hash_tables(pointless_create_t* c, uint32_t is_typed);
+
+// store maps whose keys are 32-bit integers covering a dense range in the dense layout (see pointless_hash_table.h),
+// looked up without hashing and iterated in key order. other maps are stored as before
+void pointless_create_dense_maps(pointless_create_t* c, uint32_t is_dense);
+
+// let maps with the same keys, in the same order, share one hash and key vector (and Bloom filter), so only
+// their value vectors are stored per map. readers see no difference
+void pointless_create_shared_schemas(pointless_create_t* c, uint32_t is_shared);
+
+// store value vectors of at least POINTLESS_CREATE_ENCODED_VECTOR_MIN_ITEMS strings, booleans, nulls and 32-bit
+// numbers, which are not set/map keys, dictionary or run-length encoded (see POINTLESS_VECTOR_DICTIONARY), if that
+// takes at most half of their space. their items are then only read through pointless_reader_vector_value_case()
+#define POINTLESS_CREATE_ENCODED_VECTOR_MIN_ITEMS 16
+void pointless_create_encoded_vectors(pointless_create_t* c, uint32_t is_encoded);
+
+// store 8-bit strings of at most POINTLESS_STRING_INLINE_MAX_LEN characters inside their value (POINTLESS_STRING_INLINE),
+// instead of on the heap, so reading them takes no offset or heap access. they are not interned, and take no space
+// beyond their value
+void pointless_create_inline_strings(pointless_create_t* c, uint32_t is_inline);
+
+// store the value vectors eligible for encoding (see pointless_create_encoded_vectors()), which are not dictionary
+// or run-length encoded, as split vectors (see POINTLESS_VECTOR_SPLIT), with their item types and data apart
+void pointless_create_split_vectors(pointless_create_t* c, uint32_t is_split);
+
+// store value vectors of at least POINTLESS_CREATE_BLOCK_VECTOR_MIN_ITEMS integers, which are not set/map keys, and
+// would otherwise become primitive vectors, as block vectors (see POINTLESS_VECTOR_BLOCKS), if that takes at most 3/4
+// of their space. their items are then only read through pointless_reader_vector_value_case(), each in constant time,
+// not as an array. vectors created as primitive vectors, outside vectors included, are never block vectors
+#define POINTLESS_CREATE_BLOCK_VECTOR_MIN_ITEMS 256
+void pointless_create_block_vectors(pointless_create_t* c, uint32_t is_block);
+
+// compress the 8-bit heap strings of at most POINTLESS_STRING_SYMBOLS_MAX_LEN characters with a symbol table built
+// from a sample of them (see pointless_string_symbols.h), each string which gets smaller, unless the table takes more
+// space than it saves. compressed strings (POINTLESS_STRING_SYMBOLS) are decoded on each access, and the file can
+// only be read by readers which know them
+void pointless_create_string_symbols(pointless_create_t* c, uint32_t is_symbols);
+
+// hash strings, vectors and bitvectors with the version 2 hash (see pointless_hash_v2_state_t), which reads 32 bytes
+// per step and has fewer collisions, e.g. of anagrams, so set and map probes are shorter. the file is written with one
+// of the MIXHASH file format versions, which only newer readers know. call it after pointless_create_begin_*()
+void pointless_create_mix_hash(pointless_create_t* c, uint32_t is_mix);
+
+// write the offset vectors as delta offset vectors (see POINTLESS_FF_VERSION_OFFSET_DELTA_NEWHASH), taking 2.5 bytes
+// per offset instead of 4 or 8, if no block of POINTLESS_OFFSET_DELTA_BLOCK_SIZE offsets spans more than
+// POINTLESS_OFFSET_DELTA_MAX bytes of heap. otherwise this has no effect
+void pointless_create_delta_offsets(pointless_create_t* c, uint32_t is_delta);
+
+// start the items of all vectors at a multiple of 'alignment' bytes into the file, and the items of vectors with at
+// least 'large_alignment' bytes of items at a multiple of 'large_alignment', e.g. 64 for cache lines and 4096 for
+// pages of large vectors. both must be powers of two in [4, 65536], the default of 4 for both leaves the file
+// readable by older readers
+void pointless_create_vector_alignment(pointless_create_t* c, uint32_t alignment, uint32_t large_alignment);
+
+// order of strings, vectors, bitvectors, sets and maps on the heap. by default they are grouped by type, in creation
+// order. in depth-first or breadth-first order from the root, containers are placed next to the containers they
+// refer to, with sets and maps followed by their hash, key and value vectors, so that a lookup touches fewer pages
+// and a cold file needs fewer reads. offsets then no longer increase, so delta offsets rarely apply
+#define POINTLESS_CREATE_HEAP_ORDER_TYPE 0
+#define POINTLESS_CREATE_HEAP_ORDER_DFS 1
+#define POINTLESS_CREATE_HEAP_ORDER_BFS 2
+void pointless_create_heap_order(pointless_create_t* c, uint32_t heap_order);
+
+// place the given values first on the heap, in the given order, e.g. from an access trace, with sets, maps, tables
+// and encoded vectors followed by their own vectors. the rest follows in the heap order, values without heap data are
+// ignored. returns 0 if out of memory
+int pointless_create_heap_order_trace(pointless_create_t* c, uint32_t* values, uint32_t n_values);
 void pointless_create_end(pointless_create_t* c);
 int pointless_create_output_and_end_f(pointless_create_t* c, const char* fname, const char** error);
 int pointless_create_output_and_end_b(pointless_create_t* c, void** buf, size_t* buflen, const char** error);
@@ -34,6 +114,10 @@ void pointless_create_set_root(pointless_create_t* c, uint32_t root);
 uint32_t pointless_create_i32(pointless_create_t* c, int32_t v);
 uint32_t pointless_create_u32(pointless_create_t* c, uint32_t v);
 uint32_t pointless_create_float(pointless_create_t* c, float v);
+
+// 64-bit integers, values which fit in 32 bits become I32/U32 values, others must end up in integer vectors
+uint32_t pointless_create_i64(pointless_create_t* c, int64_t v);
+uint32_t pointless_create_u64(pointless_create_t* c, uint64_t v);
 uint32_t pointless_create_null(pointless_create_t* c);
 
 uint32_t pointless_create_boolean_true(pointless_create_t* c);
@@ -103,4 +187,8 @@ uint32_t pointless_create_set_add(pointless_create_t* c, uint32_t s, uint32_t k)
 uint32_t pointless_create_map(pointless_create_t* c);
 uint32_t pointless_create_map_add(pointless_create_t* c, uint32_t m, uint32_t k, uint32_t v);
 
+// tables, 'keys' is a vector, and one column vector of n_rows items must be added per key, in key order
+uint32_t pointless_create_table(pointless_create_t* c, uint32_t n_rows, uint32_t keys);
+uint32_t pointless_create_table_add_column(pointless_create_t* c, uint32_t t, uint32_t column);
+
 #endif
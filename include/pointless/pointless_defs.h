@@ -26,11 +26,42 @@ extern "C" {
 #include <pointless/pointless_create_cache.h>
 
 #define POINTLESS_FILE_FORMAT_OLDEST_VERSION_ 0
-#define POINTLESS_FILE_FORMAT_LATEST_VERSION_ 2
+#define POINTLESS_FILE_FORMAT_LATEST_VERSION_ 6
 
 #define POINTLESS_FF_VERSION_OFFSET_32_OLDHASH 0
 #define POINTLESS_FF_VERSION_OFFSET_32_NEWHASH 1
 #define POINTLESS_FF_VERSION_OFFSET_64_NEWHASH 2
+#define POINTLESS_FF_VERSION_OFFSET_DELTA_NEWHASH 3
+
+// same offset vectors as their NEWHASH counterparts, but strings, vectors and bitvectors are hashed with the
+// version 2 hash (see pointless_hash_v2_state_t)
+#define POINTLESS_FF_VERSION_OFFSET_32_MIXHASH 4
+#define POINTLESS_FF_VERSION_OFFSET_64_MIXHASH 5
+#define POINTLESS_FF_VERSION_OFFSET_DELTA_MIXHASH 6
+#define POINTLESS_FF_VERSION_IS_MIXHASH(v) ((v) >= POINTLESS_FF_VERSION_OFFSET_32_MIXHASH)
+
+// delta offset vectors hold a 64-bit base offset for each block of POINTLESS_OFFSET_DELTA_BLOCK_SIZE
+// offsets, followed by a 16-bit delta for each offset, in units of 4 bytes from the base of its block,
+// with each of the two padded to 8 bytes
+#define POINTLESS_OFFSET_DELTA_BLOCK_SIZE 16
+#define POINTLESS_OFFSET_DELTA_MAX (65535 * 4)
+
+// the header version holds the file format version in its low 15 bits, POINTLESS_FF_STRING_SYMBOLS in bit 15, the
+// vector alignment in the next 8 bits and the large vector alignment in the top 8 bits, each as its log2, or 0 for
+// the default of 4 bytes
+//
+// the items of all vectors start at a multiple of the vector alignment, and those of vectors with at least as
+// many bytes of items as the large vector alignment at a multiple of it. the heap starts at a multiple of the
+// larger of the two, and all of this is relative to the start of the file
+//
+// files with compressed strings (POINTLESS_STRING_SYMBOLS) have POINTLESS_FF_STRING_SYMBOLS set, so older readers
+// refuse them, and their last string is the symbol table
+#define POINTLESS_FF_VERSION(v) ((v) & 0x7FFF)
+#define POINTLESS_FF_STRING_SYMBOLS 0x8000
+#define POINTLESS_FF_VECTOR_ALIGNMENT(v) POINTLESS_FF_ALIGNMENT(((v) >> 16) & 0xFF)
+#define POINTLESS_FF_LARGE_VECTOR_ALIGNMENT(v) POINTLESS_FF_ALIGNMENT(((v) >> 24) & 0xFF)
+#define POINTLESS_FF_ALIGNMENT(log2) ((log2) ? ((uint64_t)1 << (log2)) : 4)
+#define POINTLESS_FF_ALIGNMENT_MAX_LOG2 16
 
 #define ASSERT_CONCAT_(a, b) a##b
 #define ASSERT_CONCAT(a, b) ASSERT_CONCAT_(a, b)
@@ -103,13 +134,52 @@ extern "C" {
 #define POINTLESS_BOOLEAN 23
 #define POINTLESS_NULL    24
 
-// these two are not really supported yet, but are used internally
+// 64-bit integers, never stored inline in a file, but as items of POINTLESS_VECTOR_I64/U64 vectors,
+// at create-time they are only allowed in vectors that compress to one of those types
 #define POINTLESS_I64     27
 #define POINTLESS_U64     28
 
-
-#define PC_HEAP_OFFSET(p, offsets, i) ((char*)((p)->heap_ptr) + ((p)->is_32_offset ? ((p)->offsets##_32[i]) : ((p)->offsets##_64[i])))
-#define PC_OFFSET(p, offsets, i)      (                         ((p)->is_32_offset ? ((p)->offsets##_32[i]) : ((p)->offsets##_64[i])))
+// columnar table, a vector of maps with identical keys, stored column-by-column
+#define POINTLESS_TABLE   30
+
+// encoded vectors, read through pointless_reader_vector_value_case() only. like tables, they are stored as a value
+// vector of two vectors: the values, and a vector of u8/u16 codes indexing the values for dictionary encoded vectors,
+// or a vector of u8/u16/u32 run ends (exclusive, strictly increasing) for run-length encoded vectors. the values are
+// never containers
+#define POINTLESS_VECTOR_DICTIONARY 31
+#define POINTLESS_VECTOR_RUNS       32
+
+// 8-bit strings of at most POINTLESS_STRING_INLINE_MAX_LEN characters, stored inline in the value data, zero-padded
+// and zero-terminated, so two of them are the same string iff their data is the same
+#define POINTLESS_STRING_INLINE 33
+#define POINTLESS_STRING_INLINE_MAX_LEN 3
+
+// split vectors, encoded vectors storing a value vector as a struct of arrays. their value vector holds a u8 vector
+// of item types, with a single type if all items have the same one, and a u32 vector of item data, so an item takes
+// 5 bytes, or 4, instead of 8. the items are never containers
+#define POINTLESS_VECTOR_SPLIT 34
+
+// block vectors, encoded vectors storing an integer vector in blocks of POINTLESS_VECTOR_BLOCK_SIZE items, each item
+// being the smallest item of its block plus a delta of the same bit width for the whole block. their value vector
+// holds a u64 vector, with the item type and number of items ((type << 32) | n_items), then, for each block, its
+// smallest item (as 64 bits) and the u32 word its deltas start at and their width ((word << 8) | width), and a u32
+// vector of the deltas, packed least significant bit first, followed by 2 words of padding. any item is decoded
+// from at most 3 words
+#define POINTLESS_VECTOR_BLOCKS 35
+#define POINTLESS_VECTOR_BLOCK_SIZE 128
+
+// 8-bit strings of at most POINTLESS_STRING_SYMBOLS_MAX_LEN characters, compressed with the symbol table of the file
+// (see pointless_string_symbols.h). on the heap, a 32-bit word holding the number of characters in its low 16 bits
+// and the number of codes in its high 16 bits, followed by the codes
+#define POINTLESS_STRING_SYMBOLS 36
+#define POINTLESS_STRING_SYMBOLS_MAX_LEN 255
+#define POINTLESS_STRING_SYMBOLS_LEN(w) ((w) & 0xFFFF)
+#define POINTLESS_STRING_SYMBOLS_N_CODES(w) ((w) >> 16)
+
+
+#define PC_DELTA_OFFSET(p, offsets, i) ((p)->offsets##_base[(i) / POINTLESS_OFFSET_DELTA_BLOCK_SIZE] + ((uint64_t)((p)->offsets##_delta[i]) << 2))
+#define PC_HEAP_OFFSET(p, offsets, i) ((char*)((p)->heap_ptr) + ((p)->is_32_offset ? ((p)->offsets##_32[i]) : (p)->is_64_offset ? ((p)->offsets##_64[i]) : PC_DELTA_OFFSET(p, offsets, i)))
+#define PC_OFFSET(p, offsets, i)      (                         ((p)->is_32_offset ? ((p)->offsets##_32[i]) : (p)->is_64_offset ? ((p)->offsets##_64[i]) : PC_DELTA_OFFSET(p, offsets, i)))
 
 typedef union {
 	int32_t data_i32;
@@ -205,6 +275,10 @@ uint32/64_t set_offsets[n_sets]
 uint32/64_t map_offsets[n_maps]
 
 <HEAP>
+
+Tables share the vector offsets, their heap value is a value vector of the form:
+
+[n_rows (POINTLESS_U32), key vector, column vector 0, ..., column vector n_keys - 1]
 */
 
 typedef struct {
@@ -243,24 +317,61 @@ typedef struct {
 	uint64_t* set_offsets_64;
 	uint64_t* map_offsets_64;
 
+	uint64_t* string_unicode_offsets_base;
+	uint64_t* vector_offsets_base;
+	uint64_t* bitvector_offsets_base;
+	uint64_t* set_offsets_base;
+	uint64_t* map_offsets_base;
+
+	uint16_t* string_unicode_offsets_delta;
+	uint16_t* vector_offsets_delta;
+	uint16_t* bitvector_offsets_delta;
+	uint16_t* set_offsets_delta;
+	uint16_t* map_offsets_delta;
+
 	int is_32_offset;
 	int is_64_offset;
+	int is_delta_offset;
+
+	// file format version and vector alignments, from the header version
+	uint32_t version;
+	uint64_t vector_alignment;
+	uint64_t large_vector_alignment;
+
+	// set and map functions specialized for the offset encoding, see pointless_reader_core.h
+	const struct pointless_reader_core_s* core;
 
 	// base heap pointer
 	void* heap_ptr;
 	uint64_t heap_len;
+
+	// access trace and background prefetch, see pointless_trace.h
+	struct pointless_trace_s* trace;
+	struct pointless_prefetch_s* prefetch;
+
+	// symbol table of compressed strings, 0 if the file has none, see pointless_string_symbols.h
+	struct pointless_string_symbols_s* string_symbols;
 } pointless_t;
 
+// 'bloom' is 0 if the set/map has no Bloom filter, otherwise 1 + the id of a POINTLESS_VECTOR_U32
+// holding the filter blocks, see pointless_hash_table_bloom_maybe_contains()
+//
+// a set/map is in the compact layout (see pointless_hash_table.h) iff its key vector holds exactly
+// n_items keys, the regular layout always has more buckets than items. only the compact layout may have
+// primitive key and value vectors
+//
+// a map is in the dense layout (see pointless_hash_table.h) iff its key vector is an I32 or U32 value,
+// the smallest key, rather than a vector
 typedef struct {
 	uint32_t n_items;
-	uint32_t padding;
+	uint32_t bloom;
 	pointless_value_t hash_vector;
 	pointless_value_t key_vector;
 } __attribute__ ((aligned (4))) pointless_set_header_t;
 
 typedef struct {
 	uint32_t n_items;
-	uint32_t padding;
+	uint32_t bloom;
 	pointless_value_t hash_vector;
 	pointless_value_t key_vector;
 	pointless_value_t value_vector;
@@ -294,6 +405,7 @@ typedef struct {
 	// used during serialization phase, no-one else touches these
 	uint32_t serialize_hash;
 	uint32_t serialize_keys;
+	uint32_t serialize_bloom;
 } pointless_create_set_t;
 
 typedef struct {
@@ -305,6 +417,14 @@ typedef struct {
 	uint32_t serialize_hash;
 	uint32_t serialize_keys;
 	uint32_t serialize_values;
+	uint32_t serialize_bloom;
+
+	// non-zero for the dense layout, whose header holds the smallest key instead of a key vector
+	uint32_t serialize_is_dense;
+	pointless_value_t serialize_min_key;
+
+	// map owning the hash and key vectors of this one, POINTLESS_CREATE_VALUE_FAIL if it owns its own
+	uint32_t serialize_schema;
 } pointless_create_map_t;
 
 typedef struct {
@@ -332,9 +452,16 @@ typedef struct {
 	// string/unicode-create-id -> string/unicode buffer (void*)
 	pointless_dynarray_t string_unicode_values;
 
+	// string-create-id -> compressed string buffer (void*), 0 if the string is not compressed, filled in when the
+	// file is written, see pointless_create_string_symbols()
+	pointless_dynarray_t string_symbols_values;
+
 	// bitvector-create-id -> bitvector buffer (void*)
 	pointless_dynarray_t bitvector_values;
 
+	// 64-bit-integer-create-id -> two's complement bits (uint64_t)
+	pointless_dynarray_t int_64_values;
+
 	// string/unicode value -> unicode reference
 	Pvoid_t string_unicode_map_judy;
 	uint32_t string_unicode_map_judy_count;
@@ -343,6 +470,50 @@ typedef struct {
 	Pvoid_t bitvector_map_judy;
 	uint32_t bitvector_map_judy_count;
 
+	// sets and maps with at least this many keys get a Bloom filter, 0 for none
+	uint32_t bloom_threshold;
+
+	// non-zero for the compact set/map layout
+	uint32_t compact_hash_tables;
+
+	// non-zero for primitive key/value vectors in sets and maps, where possible
+	uint32_t typed_hash_tables;
+
+	// non-zero for the dense layout of maps with integer keys, where possible
+	uint32_t dense_maps;
+
+	// non-zero for sharing hash and key vectors between maps with the same keys
+	uint32_t shared_schemas;
+
+	// non-zero for dictionary and run-length encoded value vectors, where they are smaller
+	uint32_t encoded_vectors;
+
+	// non-zero for storing short 8-bit strings inline, see POINTLESS_STRING_INLINE
+	uint32_t inline_strings;
+
+	// non-zero for storing value vectors as split vectors, where they are not encoded otherwise
+	uint32_t split_vectors;
+
+	// non-zero for storing large integer vectors as block vectors, where they are smaller
+	uint32_t block_vectors;
+
+	// non-zero for compressing 8-bit strings with a symbol table, where the file gets smaller
+	uint32_t string_symbols;
+
+	// non-zero for writing 64-bit files with 32-bit offsets, where the heap fits
+	uint32_t auto_offsets;
+
+	// non-zero for writing delta offset vectors, where the heap layout allows
+	uint32_t delta_offsets;
+
+	// alignment of vector items, and of the items of large vectors, see POINTLESS_FF_VECTOR_ALIGNMENT()
+	uint32_t vector_alignment;
+	uint32_t large_vector_alignment;
+
+	// order of the heap, see pointless_create_heap_order(), and the values placed first (uint32_t)
+	uint32_t heap_order;
+	pointless_dynarray_t heap_order_trace;
+
 	// file format version
 	uint32_t version;
 } pointless_create_t;
@@ -359,6 +530,7 @@ typedef struct {
 #define cv_float_at(v) pointless_create_value_get_float(cv_value_at(v))
 #define cv_i32_at(v) pointless_create_value_get_i32(cv_value_at(v))
 #define cv_u32_at(v) pointless_create_value_get_u32(cv_value_at(v))
+#define cv_get_int_64(cv) pointless_dynarray_ITEM_AT(uint64_t, &c->int_64_values, (cv)->data.data_u32)
 
 #define cv_priv_vector_at(v) (&pointless_dynarray_ITEM_AT(pointless_create_vector_priv_t, &c->priv_vector_values, cv_value_data_u32(v)))
 #define cv_outside_vector_at(v) (&pointless_dynarray_ITEM_AT(pointless_create_vector_outside_t, &c->outside_vector_values, cv_value_data_u32(v)))
@@ -376,20 +548,53 @@ typedef struct {
 #define cv_get_unicode(cv) (*((void**)&pointless_dynarray_ITEM_AT(void*, &c->string_unicode_values, (cv)->data.data_u32)))
 #define cv_get_string(cv) (*((void**)&pointless_dynarray_ITEM_AT(void*, &c->string_unicode_values, (cv)->data.data_u32)))
 
+// characters of a heap or inline 8-bit string, compressed strings keep their characters at create-time
+#define cv_get_string_ascii(cv) ((cv)->header.type_29 == POINTLESS_STRING_INLINE ? (uint8_t*)&(cv)->data : (uint8_t*)((uint32_t*)cv_get_string(cv) + 1))
+
 // top-level type checkers
 int32_t pointless_is_vector_type(uint32_t type);
+int32_t pointless_is_encoded_vector_type(uint32_t type);
+int32_t pointless_is_string_8_type(uint32_t type);
 int32_t pointless_is_bitvector_type(uint32_t type);
 int32_t pointless_is_integer_type(uint32_t type);
 
 // hash functions
+
+// version 2 hash, of a sequence of bytes, fed to it in any number of pieces
+//
+// the bytes are consumed 32 at a time, as four 64-bit words, each pair of words folded into a 64-bit state with a
+// 64x64->128-bit multiply, after wyhash. the two multiplies of a step are independent, so they overlap. the last,
+// partial, step reads its bytes in overlapping pieces, and takes a single multiply if it has at most 16 bytes. the
+// number of bytes is folded in last, and the 32-bit hash is the xor of the two halves of the state
+typedef struct {
+	uint64_t h;
+	uint64_t n_bytes;
+
+	union {
+		uint64_t u64[4];
+		uint32_t u32[8];
+		uint8_t u8[32];
+	} block;
+} pointless_hash_v2_state_t;
+
+void pointless_hash_v2_init(pointless_hash_v2_state_t* state, uint64_t seed);
+void pointless_hash_v2_update(pointless_hash_v2_state_t* state, const void* s, size_t n);
+void pointless_hash_v2_update_32(pointless_hash_v2_state_t* state, uint32_t v);
+uint32_t pointless_hash_v2_end(pointless_hash_v2_state_t* state);
+
+// vectors, for all file format versions, the item hashes are combined one at a time, or 'n' at a time by
+// pointless_vector_hash_next_n_32()
 typedef struct {
+	uint32_t version;
 	uint32_t mult;
 	uint32_t x;
 	uint32_t len;
+	pointless_hash_v2_state_t v2;
 } pointless_vector_hash_state_32_t;
 
-void pointless_vector_hash_init_32(pointless_vector_hash_state_32_t* state, uint32_t len);
+void pointless_vector_hash_init_32(pointless_vector_hash_state_32_t* state, uint32_t version, uint32_t len);
 void pointless_vector_hash_next_32(pointless_vector_hash_state_32_t* state, uint32_t hash);
+void pointless_vector_hash_next_n_32(pointless_vector_hash_state_32_t* state, const uint32_t* hashes, uint32_t n);
 uint32_t pointless_vector_hash_end_32(pointless_vector_hash_state_32_t* state);
 
 uint32_t pointless_is_hashable(uint32_t type);
@@ -404,6 +609,18 @@ uint32_t pointless_hash_unicode_ucs2_v1_32(uint16_t* s);
 uint32_t pointless_hash_string_v1_32(uint8_t* s);
 uint32_t pointless_hash_string_v1_32_(uint8_t* s, size_t n);
 
+// a unicode string hashes as the 8-bit string of the same characters, if there is one
+uint32_t pointless_hash_unicode_ucs4_v2_32(uint32_t* s);
+uint32_t pointless_hash_unicode_ucs2_v2_32(uint16_t* s);
+uint32_t pointless_hash_string_v2_32(uint8_t* s);
+uint32_t pointless_hash_string_v2_32_(uint8_t* s, size_t n);
+
+// the above, for file format version 'version'
+uint32_t pointless_hash_unicode_ucs4_32(uint32_t version, uint32_t* s);
+uint32_t pointless_hash_unicode_ucs2_32(uint32_t version, uint16_t* s);
+uint32_t pointless_hash_string_32(uint32_t version, uint8_t* s);
+uint32_t pointless_hash_string_32_(uint32_t version, uint8_t* s, size_t n);
+
 uint32_t pointless_hash_float_32(float f);
 uint32_t pointless_hash_i32_32(int32_t i);
 uint32_t pointless_hash_u32_32(uint32_t i);
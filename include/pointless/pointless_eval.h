@@ -35,6 +35,8 @@ int pointless_eval_get(pointless_t* p, pointless_value_t* root, pointless_value_
 // and convencience functions
 int pointless_eval_get_as_u32(pointless_t* p, pointless_value_t* root, uint32_t* v, const char* e, ...);
 int pointless_eval_get_as_map(pointless_t* p, pointless_value_t* root, pointless_value_t* v, const char* e, ...);
+// uncompressed heap strings only, inline strings (POINTLESS_STRING_INLINE) have no storage outside the value, and
+// compressed strings (POINTLESS_STRING_SYMBOLS) no characters on the heap, use pointless_eval_get()
 int pointless_eval_get_as_string(pointless_t* p, pointless_value_t* root, uint8_t** v, const char* e, ...);
 int pointless_eval_get_as_vector_u8(pointless_t* p, pointless_value_t* root, uint8_t** v, uint32_t* n, const char* e, ...);
 int pointless_eval_get_as_vector_u16(pointless_t* p, pointless_value_t* root, uint16_t** v, uint32_t* n, const char* e, ...);
@@ -106,6 +106,35 @@ typedef struct {
 	uint32_t iter_state;
 } PyPointlessMapItemIter;
 
+typedef struct {
+	PyObject_HEAD
+	PyPointless* pp;
+	pointless_value_t* v;
+	unsigned long container_id;
+
+	// key -> column index, built on first keyed access
+	PyObject* key_index;
+} PyPointlessTable;
+
+typedef struct {
+	PyObject_HEAD
+	PyPointlessTable* table;
+	uint32_t row;
+} PyPointlessTableRow;
+
+typedef struct {
+	PyObject_HEAD
+	PyObject* key;
+
+	// str, unicode and int keys have a prepared form
+	int is_prepared;
+	pointless_prepared_key_t prepared;
+
+	// other keys cache their hash for each file format version
+	uint32_t hash_valid;
+	uint32_t hash[POINTLESS_FILE_FORMAT_LATEST_VERSION_ + 1];
+} PyPointlessKey;
+
 #define POINTLESS_PRIM_VECTOR_TYPE_I8 0
 #define POINTLESS_PRIM_VECTOR_TYPE_U8 1
 #define POINTLESS_PRIM_VECTOR_TYPE_I16 2
@@ -136,6 +165,7 @@ PyPointlessBitvector* PyPointlessBitvector_New(PyPointless* pp, pointless_value_
 
 PyPointlessSet* PyPointlessSet_New(PyPointless* pp, pointless_value_t* v);
 PyPointlessMap* PyPointlessMap_New(PyPointless* pp, pointless_value_t* v);
+PyPointlessTable* PyPointlessTable_New(PyPointless* pp, pointless_value_t* v);
 
 PyObject* pypointless_i32(PyPointless* p, int32_t v);
 PyObject* pypointless_u32(PyPointless* p, uint32_t v);
@@ -145,13 +175,20 @@ PyObject* pypointless_float(PyPointless* p, float v);
 PyObject* pypointless_value_string(pointless_t* p, pointless_value_t* v);
 PyObject* pypointless_value_unicode(pointless_t* p, pointless_value_t* v);
 PyObject* pypointless_value(PyPointless* p, pointless_value_t* v);
+PyObject* pypointless_vector_item(PyPointless* p, pointless_value_t* v, uint32_t i);
 
 PyObject* PyPointless_str(PyObject* py_object);
 PyObject* PyPointless_repr(PyObject* py_object);
 
 uint32_t pypointless_cmp_eq(pointless_t* p, pointless_complete_value_t* v, PyObject* py_object, const char** error);
 uint32_t pyobject_hash_32(PyObject* py_object, uint32_t version, const char** error);
-uint32_t pointless_pybitvector_hash_32(PyPointlessBitvector* bitvector);
+uint32_t pointless_pybitvector_hash_32(PyPointlessBitvector* bitvector, uint32_t version);
+
+// lookup keys
+//
+// returns -1 on error, 1 if the key has a prepared form, stored in *prepared, which may point to 'local',
+// and 0 if the key must take the generic path, with Python object *py_key and hash *hash
+int pypointless_lookup_key(PyObject* key, pointless_t* p, pointless_prepared_key_t* local, pointless_prepared_key_t** prepared, PyObject** py_key, uint32_t* hash);
 
 // custom types
 extern PyTypeObject PyPointlessType;
@@ -165,6 +202,9 @@ extern PyTypeObject PyPointlessMapType;
 extern PyTypeObject PyPointlessMapKeyIterType;
 extern PyTypeObject PyPointlessMapValueIterType;
 extern PyTypeObject PyPointlessMapItemIterType;
+extern PyTypeObject PyPointlessTableType;
+extern PyTypeObject PyPointlessTableRowType;
+extern PyTypeObject PyPointlessKeyType;
 extern PyTypeObject PyPointlessPrimVectorType;
 extern PyTypeObject PyPointlessPrimVectorIterType;
 
@@ -173,12 +213,24 @@ extern PyTypeObject PyPointlessPrimVectorIterType;
 #define PyPointlessBitvector_Check(op) PyObject_TypeCheck(op, &PyPointlessBitvectorType)
 #define PyPointlessSet_Check(op) PyObject_TypeCheck(op, &PyPointlessSetType)
 #define PyPointlessMap_Check(op) PyObject_TypeCheck(op, &PyPointlessMapType)
+#define PyPointlessTable_Check(op) PyObject_TypeCheck(op, &PyPointlessTableType)
+#define PyPointlessTableRow_Check(op) PyObject_TypeCheck(op, &PyPointlessTableRowType)
+#define PyPointlessKey_Check(op) PyObject_TypeCheck(op, &PyPointlessKeyType)
 #define PyPointlessPrimVector_Check(op) PyObject_TypeCheck(op, &PyPointlessPrimVectorType)
 
 // C-API
 PyPointlessPrimVector* PyPointlessPrimVector_from_T_vector(pointless_dynarray_t* v, uint32_t t);
 PyPointlessPrimVector* PyPointlessPrimVector_from_buffer(void* buffer, size_t n_buffer);
 
+// vector operations, shared by prim-vectors and primitive pointless vectors
+PyObject* pypointless_vector_ops_sum(void* v, uint32_t type, size_t n);
+PyObject* pypointless_vector_ops_argmin(void* v, uint32_t type, size_t n);
+PyObject* pypointless_vector_ops_argmax(void* v, uint32_t type, size_t n);
+PyObject* pypointless_vector_ops_count_range(void* v, uint32_t type, size_t n, PyObject* args);
+PyObject* pypointless_vector_ops_filter(void* v, uint32_t type, size_t n, PyObject* args);
+PyObject* pypointless_vector_ops_filter_range(void* v, uint32_t type, size_t n, PyObject* args);
+PyObject* pypointless_vector_ops_histogram(void* v, uint32_t type, size_t n, PyObject* args);
+
 typedef struct {
 	// prim-vector operations
 	void(*primvector_init)(pointless_dynarray_t* a, size_t item_size);
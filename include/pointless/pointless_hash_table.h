@@ -26,7 +26,57 @@ uint32_t pointless_hash_table_probe(pointless_t* p, uint32_t value_hash, pointle
 uint32_t pointless_hash_table_probe_ext(pointless_t* p, uint32_t value_hash, pointless_eq_cb cb, void* user, uint32_t n_buckets, uint32_t* hash_vector, pointless_value_t* key_vector, const char** error);
 int pointless_hash_table_populate(pointless_create_t* c, uint32_t* hash_vector, uint32_t* keys_vector, uint32_t* values_vector, uint32_t n_keys, uint32_t* hash_serialize, uint32_t* keys_serialize, uint32_t* values_serialize, uint32_t n_buckets, uint32_t empty_slot_handle, const char** error);
 
+// blocked Bloom filters, for negative lookups
+//
+// the filter is an array of 512-bit (cache line) blocks, sized at POINTLESS_BLOOM_BITS_PER_KEY bits
+// per key, each key sets POINTLESS_BLOOM_N_PROBES bits within a single block, so a test touches one
+// cache line
+#define POINTLESS_BLOOM_BLOCK_WORDS 16
+#define POINTLESS_BLOOM_BITS_PER_KEY 10
+#define POINTLESS_BLOOM_N_PROBES 6
+
+uint32_t pointless_hash_table_bloom_n_words(uint32_t n_keys);
+void pointless_hash_table_bloom_add(uint32_t* bloom, uint32_t n_words, uint32_t hash);
+uint32_t pointless_hash_table_bloom_maybe_contains(uint32_t* bloom, uint32_t n_words, uint32_t hash);
+
 void pointless_hash_table_probe_hash_init(pointless_t* p, uint32_t value_hash, uint32_t n_buckets, pointless_hash_iter_state_t* state);
 uint32_t pointless_hash_table_probe_hash(pointless_t* p, uint32_t* hash_vector, pointless_value_t* key_vector, pointless_hash_iter_state_t* state, uint32_t* bucket_out);
 
+// compact layout
+//
+// the key (and value) vectors hold the n_items entries, in insertion order and without empty slots,
+// and the hash vector holds their hashes, followed by an index of pointless_hash_compute_n_buckets(n_items)
+// slots packed into 32-bit words. a slot is 0 if empty, 1 + the entry otherwise, and is 8, 16 or 32 bits
+// wide, depending on n_items. probes return entries, not buckets
+//
+// since empty slots are only marked in the index, the key and value vectors may be primitive vectors (see
+// pointless_create_typed_hash_tables()), so the compact probes take the key vector itself, not its items
+uint32_t pointless_hash_table_compact_slot_size(uint32_t n_items);
+uint32_t pointless_hash_table_compact_n_index_words(uint32_t n_items);
+uint32_t pointless_hash_table_compact_probe(pointless_t* p, uint32_t value_hash, pointless_value_t* value, uint32_t n_items, uint32_t* hash_vector, pointless_value_t* key_vector, const char** error);
+uint32_t pointless_hash_table_compact_probe_ext(pointless_t* p, uint32_t value_hash, pointless_eq_cb cb, void* user, uint32_t n_items, uint32_t* hash_vector, pointless_value_t* key_vector, const char** error);
+uint32_t pointless_hash_table_compact_probe_hash(pointless_t* p, uint32_t* hash_vector, uint32_t n_items, pointless_hash_iter_state_t* state, uint32_t* entry_out);
+int pointless_hash_table_compact_populate(pointless_create_t* c, uint32_t* hash_vector, uint32_t* keys_vector, uint32_t n_keys, void* index, const char** error);
+
+// dense layout
+//
+// maps whose keys are all 32-bit integers, filling at least 1 / POINTLESS_HASH_TABLE_DENSE_MIN_FILL of the range
+// [smallest key, largest key], are stored without hashes (see pointless_create_dense_maps()). the key vector field of
+// the header is the smallest key itself, an I32 or U32 value, the hash vector holds one bit per integer in the range,
+// set for the keys present, and the value vector one value per integer in the range. the entry of a key is its
+// distance from the smallest key, so a lookup is a range check and a bit test
+//
+// the probes taking a hash try the keys with that hash, integers hash to themselves, so there are at most two
+#define POINTLESS_HASH_TABLE_DENSE_MIN_FILL 2
+
+uint32_t pointless_hash_table_dense_n_words(uint32_t n_range);
+uint32_t pointless_hash_table_dense_is_set(uint32_t* bits, uint32_t entry);
+void pointless_hash_table_dense_set(uint32_t* bits, uint32_t entry);
+pointless_complete_value_t pointless_hash_table_dense_key(int64_t min_key, uint32_t entry);
+uint32_t pointless_hash_table_dense_entry(int64_t min_key, uint32_t* bits, uint32_t n_words, int64_t k);
+uint32_t pointless_hash_table_dense_probe(pointless_t* p, uint32_t value_hash, pointless_value_t* value, int64_t min_key, uint32_t* bits, uint32_t n_words, const char** error);
+uint32_t pointless_hash_table_dense_probe_ext(pointless_t* p, uint32_t value_hash, pointless_eq_cb cb, void* user, int64_t min_key, uint32_t* bits, uint32_t n_words, const char** error);
+void pointless_hash_table_dense_probe_hash_init(pointless_hash_iter_state_t* state);
+uint32_t pointless_hash_table_dense_probe_hash(int64_t min_key, uint32_t* bits, uint32_t n_words, uint32_t value_hash, pointless_hash_iter_state_t* state, uint32_t* entry_out);
+
 #endif
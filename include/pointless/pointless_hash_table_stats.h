@@ -0,0 +1,49 @@
+#ifndef __POINTLESS__HASH__TABLE__STATS__H__
+#define __POINTLESS__HASH__TABLE__STATS__H__
+
+#include <stdio.h>
+#include <string.h>
+
+#include <pointless/pointless_defs.h>
+#include <pointless/pointless_hash_table.h>
+#include <pointless/pointless_reader_utils.h>
+
+// hash table statistics, to find the sets and maps which are slow to look up in
+//
+// the probe length of a key is the number of buckets a successful lookup of it visits, 1 if it is in its first
+// bucket, following the same recurrence as pointless_hash_table_probe(). a key collides if an earlier key on its
+// probe sequence has the same hash, so its lookup compares keys more than once. empty bytes are those spent on empty
+// slots, in the hash, key and value vectors of the regular layout, the index of the compact layout, and the value
+// vector of the dense layout. keys of dense maps are looked up without probing, with a probe length of 1
+//
+// the load factor is n_items / n_buckets, the average probe length n_probes / n_items
+#define POINTLESS_HASH_TABLE_LAYOUT_REGULAR 0
+#define POINTLESS_HASH_TABLE_LAYOUT_COMPACT 1
+#define POINTLESS_HASH_TABLE_LAYOUT_DENSE 2
+
+typedef struct {
+	uint32_t n_tables;
+	uint32_t layout;
+	uint64_t n_items;
+	uint64_t n_buckets;
+	uint64_t n_probes;
+	uint32_t max_probe_len;
+	uint64_t n_collisions;
+	uint64_t n_empty_bytes;
+} pointless_hash_table_stats_t;
+
+typedef int (*pointless_hash_table_stats_cb)(pointless_t* p, pointless_value_t* v, pointless_hash_table_stats_t* stats, void* user);
+
+// a single set or map
+int pointless_hash_table_stats(pointless_t* p, pointless_value_t* v, pointless_hash_table_stats_t* stats, const char** error);
+
+// every set and map of the file, by id, calling 'cb' (if not 0) with each, and summing them into 'sets' and 'maps'
+// (if not 0). the walk stops if 'cb' returns 0, the sums then only hold the tables visited. the empty bytes of the
+// hash and key vectors of maps sharing a schema count once in 'maps', as in pointless_anatomy(), while 'cb' gets
+// those of each map
+int pointless_hash_table_stats_all(pointless_t* p, pointless_hash_table_stats_cb cb, void* user, pointless_hash_table_stats_t* sets, pointless_hash_table_stats_t* maps, const char** error);
+
+// a line per set and map, followed by the totals of sets, maps, and both
+int pointless_hash_table_stats_print(pointless_t* p, FILE* out, const char** error);
+
+#endif
@@ -6,6 +6,7 @@
 
 void* pointless_calloc(size_t nmemb, size_t size);
 void* pointless_malloc(size_t size);
+void* pointless_malloc_aligned(size_t alignment, size_t size);
 void pointless_free(void* ptr);
 void* pointless_realloc(void* ptr, size_t size);
 char* pointless_strdup(const char* s);
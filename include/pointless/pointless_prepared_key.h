@@ -0,0 +1,66 @@
+#ifndef __POINTLESS__PREPARED__KEY__H__
+#define __POINTLESS__PREPARED__KEY__H__
+
+#ifndef __cplusplus
+#include <limits.h>
+#include <stdint.h>
+#else
+#include <climits>
+#include <cstdint>
+#endif
+
+#include <pointless/pointless_defs.h>
+#include <pointless/pointless_reader.h>
+
+// prepared lookup keys
+//
+// a prepared key is a string, unicode string or integer, together with its hash for each
+// file format version, computed on first use. a key which is looked up in many sets and maps
+// is hashed at most once per version, and compared against the on-disk keys without any
+// type dispatch on the key side.
+//
+// the key data is not copied, it must outlive the prepared key
+
+#define POINTLESS_PREPARED_KEY_STRING 0
+#define POINTLESS_PREPARED_KEY_UNICODE_UCS2 1
+#define POINTLESS_PREPARED_KEY_UNICODE_UCS4 2
+#define POINTLESS_PREPARED_KEY_INT 3
+
+typedef struct {
+	uint32_t type;
+	uint32_t hash_valid;
+	uint32_t hash[POINTLESS_FILE_FORMAT_LATEST_VERSION_ + 1];
+
+	union {
+		uint8_t* string_8;
+		uint16_t* string_16;
+		uint32_t* string_32;
+		int64_t i;
+	} data;
+} pointless_prepared_key_t;
+
+void pointless_prepared_key_init_string(pointless_prepared_key_t* k, uint8_t* s);
+void pointless_prepared_key_init_unicode_ucs2(pointless_prepared_key_t* k, uint16_t* s);
+void pointless_prepared_key_init_unicode_ucs4(pointless_prepared_key_t* k, uint32_t* s);
+
+// integers must be in [INT32_MIN, UINT32_MAX], returns 0 otherwise
+int pointless_prepared_key_init_int(pointless_prepared_key_t* k, int64_t i);
+
+// hash of the key for the file format version of 'p'
+uint32_t pointless_prepared_key_hash(pointless_t* p, pointless_prepared_key_t* k);
+
+// key equality against an on-disk value
+uint32_t pointless_prepared_key_eq(pointless_t* p, pointless_value_t* v, pointless_prepared_key_t* k);
+
+// a pointless_eq_cb, for pointless_reader_{set,map}_lookup_ext(), with the prepared key as 'user'
+uint32_t pointless_prepared_key_eq_cb(pointless_t* p, pointless_complete_value_t* v, void* user, const char** error);
+
+// probes, returning the entry of the key or POINTLESS_HASH_TABLE_PROBE_MISS, for all sets/maps
+uint32_t pointless_reader_set_probe_prepared(pointless_t* p, pointless_value_t* s, pointless_prepared_key_t* k);
+uint32_t pointless_reader_map_probe_prepared(pointless_t* p, pointless_value_t* m, pointless_prepared_key_t* k);
+
+// lookups, *kk (and *vv) are 0 if the key is not in the set/map, for sets/maps with value key/value vectors
+void pointless_reader_set_lookup_prepared(pointless_t* p, pointless_value_t* s, pointless_prepared_key_t* k, pointless_value_t** kk);
+void pointless_reader_map_lookup_prepared(pointless_t* p, pointless_value_t* m, pointless_prepared_key_t* k, pointless_value_t** kk, pointless_value_t** vv);
+
+#endif
@@ -24,9 +24,17 @@
 #include <pointless/pointless_hash_table.h>
 #include <pointless/pointless_validate.h>
 #include <pointless/pointless_reader_utils.h>
+#include <pointless/pointless_trace.h>
+#include <pointless/pointless_hash_table_stats.h>
+#include <pointless/pointless_anatomy.h>
 
+// pointless_open_b() reads a copy of the buffer, aligned so the vector alignment of the file holds in memory, as it
+// does for the pages pointless_open_f() maps
 int pointless_open_f(pointless_t* p, const char* fname, int force_ucs2, const char** error);
 int pointless_open_b(pointless_t* p, const void* buffer, size_t n_buffer, int force_ucs2, const char** error);
 void pointless_close(pointless_t* p);
 
+// size of an offset vector of 'n' offsets, in the encoding of 'p'
+uint64_t pointless_offset_vector_size(pointless_t* p, uint64_t n);
+
 #endif
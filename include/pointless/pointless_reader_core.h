@@ -0,0 +1,218 @@
+// set and map reader core, specialized for one offset vector encoding
+//
+// this file has no include guard, pointless_reader.c includes it once per offset encoding, with PC_CORE_FN(name)
+// naming the specialized functions and PC_CORE_OFFSET(p, offsets, i) reading an offset in that encoding. the
+// encoding is then only looked at once, in pointless_init(), instead of on every container access of a lookup
+// or iteration
+//
+// hash, key and value vectors of sets and maps are never encoded, so only plain vectors are read here
+
+static void* PC_CORE_FN(vector_base_ptr)(pointless_t* p, pointless_value_t* v)
+{
+	assert(!pointless_is_encoded_vector_type(v->type));
+
+	if (v->type == POINTLESS_VECTOR_EMPTY)
+		return 0;
+
+	assert(v->data.data_u32 < p->header->n_vector);
+	PC_TRACE(p, v);
+	return (void*)((uint32_t*)((char*)p->heap_ptr + PC_CORE_OFFSET(p, vector_offsets, v->data.data_u32)) + 1);
+}
+
+static uint32_t PC_CORE_FN(vector_n_items)(pointless_t* p, pointless_value_t* v)
+{
+	assert(!pointless_is_encoded_vector_type(v->type));
+
+	if (v->type == POINTLESS_VECTOR_EMPTY)
+		return 0;
+
+	assert(v->data.data_u32 < p->header->n_vector);
+	PC_TRACE(p, v);
+	return *(uint32_t*)((char*)p->heap_ptr + PC_CORE_OFFSET(p, vector_offsets, v->data.data_u32));
+}
+
+static pointless_set_header_t* PC_CORE_FN(set_header)(pointless_t* p, pointless_value_t* s)
+{
+	assert(s->type == POINTLESS_SET_VALUE);
+	PC_TRACE(p, s);
+	return (pointless_set_header_t*)((char*)p->heap_ptr + PC_CORE_OFFSET(p, set_offsets, s->data.data_u32));
+}
+
+static pointless_map_header_t* PC_CORE_FN(map_header)(pointless_t* p, pointless_value_t* m)
+{
+	assert(m->type == POINTLESS_MAP_VALUE_VALUE);
+	PC_TRACE(p, m);
+	return (pointless_map_header_t*)((char*)p->heap_ptr + PC_CORE_OFFSET(p, map_offsets, m->data.data_u32));
+}
+
+static uint32_t PC_CORE_FN(bloom_maybe_contains)(pointless_t* p, uint32_t bloom, uint32_t hash)
+{
+	if (bloom == 0)
+		return 1;
+
+	pointless_value_t v;
+	v.type = POINTLESS_VECTOR_U32;
+	v.data.data_u32 = bloom - 1;
+
+	return pointless_hash_table_bloom_maybe_contains((uint32_t*)PC_CORE_FN(vector_base_ptr)(p, &v), PC_CORE_FN(vector_n_items)(p, &v), hash);
+}
+
+static uint32_t PC_CORE_FN(is_compact)(pointless_t* p, uint32_t n_items, pointless_value_t* key_vector)
+{
+	return (PC_CORE_FN(vector_n_items)(p, key_vector) == n_items);
+}
+
+static uint32_t PC_CORE_FN(hash_table_probe)(pointless_t* p, uint32_t n_items, uint32_t bloom, pointless_value_t* hash_vector, pointless_value_t* key_vector, uint32_t hash, pointless_value_t* k, pointless_eq_cb cb, void* user, const char** error)
+{
+	// most misses end here
+	if (!PC_CORE_FN(bloom_maybe_contains)(p, bloom, hash))
+		return POINTLESS_HASH_TABLE_PROBE_MISS;
+
+	uint32_t* hashes = (uint32_t*)PC_CORE_FN(vector_base_ptr)(p, hash_vector);
+
+	// dense maps have a bit per key instead of hashes
+	if (pointless_reader_is_dense(key_vector)) {
+		int64_t min_key = pointless_reader_dense_min_key(key_vector);
+		uint32_t n_words = PC_CORE_FN(vector_n_items)(p, hash_vector);
+
+		if (cb)
+			return pointless_hash_table_dense_probe_ext(p, hash, cb, user, min_key, hashes, n_words, error);
+
+		return pointless_hash_table_dense_probe(p, hash, k, min_key, hashes, n_words, error);
+	}
+
+	// compact tables may have primitive key vectors
+	if (PC_CORE_FN(is_compact)(p, n_items, key_vector)) {
+		if (cb)
+			return pointless_hash_table_compact_probe_ext(p, hash, cb, user, n_items, hashes, key_vector, error);
+
+		return pointless_hash_table_compact_probe(p, hash, k, n_items, hashes, key_vector, error);
+	}
+
+	pointless_value_t* keys = (pointless_value_t*)PC_CORE_FN(vector_base_ptr)(p, key_vector);
+	uint32_t n_buckets = PC_CORE_FN(vector_n_items)(p, key_vector);
+
+	if (cb)
+		return pointless_hash_table_probe_ext(p, hash, cb, user, n_buckets, hashes, keys, error);
+
+	return pointless_hash_table_probe(p, hash, k, n_buckets, hashes, keys, error);
+}
+
+static uint32_t PC_CORE_FN(hash_table_iter_entry)(pointless_t* p, uint32_t n_items, pointless_value_t* hash_vector, pointless_value_t* key_vector, uint32_t* entry, uint32_t* iter_state)
+{
+	// the entries of a dense map are the bits set, in key order
+	if (pointless_reader_is_dense(key_vector)) {
+		uint32_t* bits = (uint32_t*)PC_CORE_FN(vector_base_ptr)(p, hash_vector);
+		uint32_t n_bits = PC_CORE_FN(vector_n_items)(p, hash_vector) * 32;
+
+		while (*iter_state < n_bits) {
+			*entry = (*iter_state)++;
+
+			if (pointless_hash_table_dense_is_set(bits, *entry))
+				return 1;
+		}
+
+		return 0;
+	}
+
+	// every entry of a compact table is a key
+	if (PC_CORE_FN(is_compact)(p, n_items, key_vector)) {
+		if (*iter_state >= n_items)
+			return 0;
+
+		*entry = (*iter_state)++;
+		return 1;
+	}
+
+	pointless_value_t* keys = (pointless_value_t*)PC_CORE_FN(vector_base_ptr)(p, key_vector);
+	uint32_t n_buckets = PC_CORE_FN(vector_n_items)(p, key_vector);
+
+	while (*iter_state < n_buckets) {
+		*entry = (*iter_state)++;
+
+		if (keys[*entry].type != POINTLESS_EMPTY_SLOT)
+			return 1;
+	}
+
+	return 0;
+}
+
+static uint32_t PC_CORE_FN(set_iter)(pointless_t* p, pointless_value_t* s, pointless_value_t** k, uint32_t* iter_state)
+{
+	pointless_set_header_t* header = PC_CORE_FN(set_header)(p, s);
+	assert(header->key_vector.type == POINTLESS_VECTOR_VALUE_HASHABLE);
+	uint32_t entry = 0;
+
+	if (!PC_CORE_FN(hash_table_iter_entry)(p, header->n_items, &header->hash_vector, &header->key_vector, &entry, iter_state))
+		return 0;
+
+	*k = &((pointless_value_t*)PC_CORE_FN(vector_base_ptr)(p, &header->key_vector))[entry];
+	return 1;
+}
+
+static uint32_t PC_CORE_FN(map_iter)(pointless_t* p, pointless_value_t* m, pointless_value_t** k, pointless_value_t** v, uint32_t* iter_state)
+{
+	pointless_map_header_t* header = PC_CORE_FN(map_header)(p, m);
+	assert(header->key_vector.type == POINTLESS_VECTOR_VALUE_HASHABLE);
+	assert(header->value_vector.type == POINTLESS_VECTOR_VALUE || header->value_vector.type == POINTLESS_VECTOR_VALUE_HASHABLE);
+	uint32_t entry = 0;
+
+	if (!PC_CORE_FN(hash_table_iter_entry)(p, header->n_items, &header->hash_vector, &header->key_vector, &entry, iter_state))
+		return 0;
+
+	*k = &((pointless_value_t*)PC_CORE_FN(vector_base_ptr)(p, &header->key_vector))[entry];
+	*v = &((pointless_value_t*)PC_CORE_FN(vector_base_ptr)(p, &header->value_vector))[entry];
+	return 1;
+}
+
+static uint32_t PC_CORE_FN(set_probe)(pointless_t* p, pointless_value_t* s, pointless_value_t* k, const char** error)
+{
+	// value must be hashable
+	if (!pointless_is_hashable(k->type)) {
+		*error = "value is not hashable";
+		return POINTLESS_HASH_TABLE_PROBE_ERROR;
+	}
+
+	pointless_set_header_t* header = PC_CORE_FN(set_header)(p, s);
+	uint32_t hash = pointless_hash_reader_32(p, k);
+	return PC_CORE_FN(hash_table_probe)(p, header->n_items, header->bloom, &header->hash_vector, &header->key_vector, hash, k, 0, 0, error);
+}
+
+static uint32_t PC_CORE_FN(map_probe)(pointless_t* p, pointless_value_t* m, pointless_value_t* k, const char** error)
+{
+	// value must be hashable
+	if (!pointless_is_hashable(k->type)) {
+		*error = "value is not hashable";
+		return POINTLESS_HASH_TABLE_PROBE_ERROR;
+	}
+
+	pointless_map_header_t* header = PC_CORE_FN(map_header)(p, m);
+
+	// integers are looked up in dense maps without hashing
+	if (pointless_reader_is_dense(&header->key_vector)) {
+		int64_t min_key = pointless_reader_dense_min_key(&header->key_vector);
+		uint32_t* bits = (uint32_t*)PC_CORE_FN(vector_base_ptr)(p, &header->hash_vector);
+		uint32_t n_words = PC_CORE_FN(vector_n_items)(p, &header->hash_vector);
+
+		switch (k->type) {
+			case POINTLESS_I32:
+				return pointless_hash_table_dense_entry(min_key, bits, n_words, (int64_t)k->data.data_i32);
+			case POINTLESS_U32:
+			case POINTLESS_BOOLEAN:
+				return pointless_hash_table_dense_entry(min_key, bits, n_words, (int64_t)k->data.data_u32);
+		}
+	}
+
+	uint32_t hash = pointless_hash_reader_32(p, k);
+	return PC_CORE_FN(hash_table_probe)(p, header->n_items, header->bloom, &header->hash_vector, &header->key_vector, hash, k, 0, 0, error);
+}
+
+static const pointless_reader_core_t PC_CORE_FN(core) = {
+	PC_CORE_FN(bloom_maybe_contains),
+	PC_CORE_FN(hash_table_probe),
+	PC_CORE_FN(hash_table_iter_entry),
+	PC_CORE_FN(set_iter),
+	PC_CORE_FN(map_iter),
+	PC_CORE_FN(set_probe),
+	PC_CORE_FN(map_probe)
+};
@@ -3,6 +3,7 @@
 
 #include <pointless/pointless_defs.h>
 #include <pointless/pointless_hash_table.h>
+#include <pointless/pointless_string_symbols.h>
 
 // the root value
 pointless_value_t* pointless_root(pointless_t* p);
@@ -11,8 +12,12 @@ pointless_value_t* pointless_root(pointless_t* p);
 uint32_t pointless_reader_unicode_len(pointless_t* p, pointless_value_t* v);
 uint32_t* pointless_reader_unicode_value_ucs4(pointless_t* p, pointless_value_t* v);
 
+// the characters of an inline string (POINTLESS_STRING_INLINE) are inside 'v', which must outlive them. compressed
+// strings (POINTLESS_STRING_SYMBOLS) have no characters on the heap, and are decoded into 'buffer', which holds
+// POINTLESS_STRING_SYMBOLS_BUFFER_LEN bytes, and must outlive them
 uint32_t pointless_reader_string_len(pointless_t* p, pointless_value_t* v);
 uint8_t* pointless_reader_string_value_ascii(pointless_t* p, pointless_value_t* v);
+uint8_t* pointless_reader_string_value_ascii_buffer(pointless_t* p, pointless_value_t* v, uint8_t* buffer);
 
 #ifdef POINTLESS_WCHAR_T_IS_4_BYTES
 wchar_t* pointless_reader_unicode_value_wchar(pointless_t* p, pointless_value_t* v);
@@ -35,43 +40,106 @@ int64_t* pointless_reader_vector_i64(pointless_t* p, pointless_value_t* v);
 uint64_t* pointless_reader_vector_u64(pointless_t* p, pointless_value_t* v);
 float* pointless_reader_vector_float(pointless_t* p, pointless_value_t* v);
 
-// general value fetcher
+// general value fetcher, the only way to read the items of encoded vectors
 pointless_complete_value_t pointless_reader_vector_value_case(pointless_t* p, pointless_value_t* v, uint32_t i);
 
+// the values and codes/run ends of an encoded vector (see POINTLESS_VECTOR_DICTIONARY), and a single code/run end
+pointless_value_t* pointless_reader_encoded_vector_values(pointless_t* p, pointless_value_t* v);
+pointless_value_t* pointless_reader_encoded_vector_codes(pointless_t* p, pointless_value_t* v);
+uint32_t pointless_reader_encoded_vector_code(pointless_t* p, pointless_value_t* codes, uint32_t i);
+
+// the item types (a u8 vector, with a single type if all items have it) and item data (a u32 vector) of a split
+// vector (see POINTLESS_VECTOR_SPLIT), and the type of a single item, so items can be scanned by type alone
+pointless_value_t* pointless_reader_split_vector_types(pointless_t* p, pointless_value_t* v);
+pointless_value_t* pointless_reader_split_vector_data(pointless_t* p, pointless_value_t* v);
+uint32_t pointless_reader_split_vector_type(pointless_t* p, pointless_value_t* v, uint32_t i);
+
+// the u64 vector of item type, number of items and block frames/starts, and the u32 vector of packed deltas, of a
+// block vector (see POINTLESS_VECTOR_BLOCKS), and the vector type its items are read as (e.g. POINTLESS_VECTOR_U16)
+//
+// the u64 vector is only 4-byte aligned, so its words are read with pointless_reader_block_vector_block()
+pointless_value_t* pointless_reader_block_vector_blocks(pointless_t* p, pointless_value_t* v);
+pointless_value_t* pointless_reader_block_vector_words(pointless_t* p, pointless_value_t* v);
+uint64_t pointless_reader_block_vector_block(pointless_t* p, pointless_value_t* v, uint32_t i);
+uint32_t pointless_reader_block_vector_item_type(pointless_t* p, pointless_value_t* v);
+
 // bitvectors
 uint32_t pointless_reader_bitvector_n_bits(pointless_t* p, pointless_value_t* v);
 uint32_t pointless_reader_bitvector_is_set(pointless_t* p, pointless_value_t* v, uint32_t bit);
 void* pointless_reader_bitvector_buffer(pointless_t* p, pointless_value_t* v);
 
+// sets and maps
+//
+// the functions returning pointers to keys and values require value key/value vectors. the entry functions work
+// for all sets and maps, including those with primitive key/value vectors (see pointless_create_typed_hash_tables())
+// and dense maps (see pointless_create_dense_maps()), whose key vector is their smallest key. the keys and values
+// of entries are read with pointless_reader_{set,map}_key() and pointless_reader_map_value(), and probes return
+// POINTLESS_HASH_TABLE_PROBE_MISS or POINTLESS_HASH_TABLE_PROBE_ERROR if there is no such entry
+
 // sets
 uint32_t pointless_reader_set_n_items(pointless_t* p, pointless_value_t* s);
 uint32_t pointless_reader_set_n_buckets(pointless_t* p, pointless_value_t* s);
+uint32_t pointless_reader_set_is_compact(pointless_t* p, pointless_value_t* s);
 uint32_t pointless_reader_set_iter(pointless_t* p, pointless_value_t* s, pointless_value_t** k, uint32_t* iter_state);
 void pointless_reader_set_lookup(pointless_t* p, pointless_value_t* s, pointless_value_t* k, pointless_value_t** kk, const char** error);
 void pointless_reader_set_lookup_ext(pointless_t* p, pointless_value_t* s, uint32_t hash, pointless_eq_cb cb, void* user, pointless_value_t** kk, const char** error);
 
+uint32_t pointless_reader_set_iter_entry(pointless_t* p, pointless_value_t* s, uint32_t* entry, uint32_t* iter_state);
+uint32_t pointless_reader_set_probe(pointless_t* p, pointless_value_t* s, pointless_value_t* k, const char** error);
+uint32_t pointless_reader_set_probe_ext(pointless_t* p, pointless_value_t* s, uint32_t hash, pointless_eq_cb cb, void* user, const char** error);
+pointless_complete_value_t pointless_reader_set_key(pointless_t* p, pointless_value_t* s, uint32_t entry);
+
+// 0 if the Bloom filter rules out a key with this hash, always 1 without a filter
+uint32_t pointless_reader_set_maybe_contains_hash(pointless_t* p, pointless_value_t* s, uint32_t hash);
+
+// 0 if there is no Bloom filter, otherwise 1 + the id of its POINTLESS_VECTOR_U32
+uint32_t pointless_reader_set_bloom(pointless_t* p, pointless_value_t* s);
+
 pointless_value_t* pointless_set_hash_vector(pointless_t* p, pointless_value_t* s);
 pointless_value_t* pointless_set_key_vector(pointless_t* p, pointless_value_t* s);
 
 // maps
 uint32_t pointless_reader_map_n_items(pointless_t* p, pointless_value_t* m);
 uint32_t pointless_reader_map_n_buckets(pointless_t* p, pointless_value_t* m);
+uint32_t pointless_reader_map_is_compact(pointless_t* p, pointless_value_t* m);
+uint32_t pointless_reader_map_is_dense(pointless_t* p, pointless_value_t* m);
 uint32_t pointless_reader_map_iter(pointless_t* p, pointless_value_t* m, pointless_value_t** k, pointless_value_t** vv, uint32_t* iter_state);
 void pointless_reader_map_lookup(pointless_t* p, pointless_value_t* m, pointless_value_t* k, pointless_value_t** kk, pointless_value_t** vv, const char** error);
 void pointless_reader_map_lookup_ext(pointless_t* p, pointless_value_t* m, uint32_t hash, pointless_eq_cb cb, void* user, pointless_value_t** kk, pointless_value_t** vv, const char** error);
 
+uint32_t pointless_reader_map_iter_entry(pointless_t* p, pointless_value_t* m, uint32_t* entry, uint32_t* iter_state);
+uint32_t pointless_reader_map_probe(pointless_t* p, pointless_value_t* m, pointless_value_t* k, const char** error);
+uint32_t pointless_reader_map_probe_ext(pointless_t* p, pointless_value_t* m, uint32_t hash, pointless_eq_cb cb, void* user, const char** error);
+pointless_complete_value_t pointless_reader_map_key(pointless_t* p, pointless_value_t* m, uint32_t entry);
+pointless_complete_value_t pointless_reader_map_value(pointless_t* p, pointless_value_t* m, uint32_t entry);
+
+// entry of integer 'k' in a dense map, no hash involved
+uint32_t pointless_reader_map_dense_entry(pointless_t* p, pointless_value_t* m, int64_t k);
+
+uint32_t pointless_reader_map_maybe_contains_hash(pointless_t* p, pointless_value_t* m, uint32_t hash);
+uint32_t pointless_reader_map_bloom(pointless_t* p, pointless_value_t* m);
+
 pointless_value_t* pointless_map_hash_vector(pointless_t* p, pointless_value_t* m);
 pointless_value_t* pointless_map_key_vector(pointless_t* p, pointless_value_t* m);
 pointless_value_t* pointless_map_value_vector(pointless_t* p, pointless_value_t* m);
 
+// tables, the value at (row, column) is pointless_reader_vector_value_case(p, &columns[column], row)
+uint32_t pointless_reader_table_n_rows(pointless_t* p, pointless_value_t* t);
+uint32_t pointless_reader_table_n_columns(pointless_t* p, pointless_value_t* t);
+pointless_value_t* pointless_reader_table_keys(pointless_t* p, pointless_value_t* t);
+pointless_value_t* pointless_reader_table_columns(pointless_t* p, pointless_value_t* t);
+pointless_complete_value_t pointless_reader_table_value(pointless_t* p, pointless_value_t* t, uint32_t row, uint32_t column);
+
 // map/set conditional iterators
 void pointless_reader_map_iter_hash_init(pointless_t* p, pointless_value_t* m, uint32_t hash, pointless_hash_iter_state_t* iter_state);
 uint32_t pointless_reader_map_iter_hash(pointless_t* p, pointless_value_t* m, uint32_t hash, pointless_value_t** kk, pointless_value_t** vv, pointless_hash_iter_state_t* iter_state);
+uint32_t pointless_reader_map_iter_hash_entry(pointless_t* p, pointless_value_t* m, uint32_t hash, uint32_t* entry, pointless_hash_iter_state_t* iter_state);
 
 void pointless_reader_set_iter_hash_init(pointless_t* p, pointless_value_t* m, uint32_t hash, pointless_hash_iter_state_t* iter_state);
 uint32_t pointless_reader_set_iter_hash(pointless_t* p, pointless_value_t* s, uint32_t hash, pointless_value_t** kk, pointless_hash_iter_state_t* iter_state);
+uint32_t pointless_reader_set_iter_hash_entry(pointless_t* p, pointless_value_t* s, uint32_t hash, uint32_t* entry, pointless_hash_iter_state_t* iter_state);
 
-// get ID of container (non-empty vectors, sets and maps)
+// get ID of container (non-empty vectors, tables, sets and maps)
 uint32_t pointless_n_containers(pointless_t* p);
 uint32_t pointless_container_id(pointless_t* p, pointless_value_t* c);
 
@@ -11,4 +11,9 @@ uint32_t pointless_recreate_value(pointless_t* p_in, pointless_value_t* v_in, po
 int pointless_recreate_32(const char* fname_in, const char* fname_out, const char** error);
 int pointless_recreate_64(const char* fname_in, const char* fname_out, const char** error);
 
+// rewrite a file in the given heap order (see pointless_create_heap_order()), with the containers in 'trace', values of
+// the input file, placed first. the output is written as by pointless_create_begin_auto(), and like the other
+// recreate functions, it holds the same values, but none of the optional encodings of the input
+int pointless_recreate_heap_order(const char* fname_in, const char* fname_out, uint32_t heap_order, pointless_value_t* trace, uint32_t n_trace, const char** error);
+
 #endif
@@ -0,0 +1,62 @@
+#ifndef __POINTLESS__STRING__SYMBOLS__H__
+#define __POINTLESS__STRING__SYMBOLS__H__
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include <pointless/pointless_defs.h>
+#include <pointless/pointless_malloc.h>
+
+// string compression with a static symbol table, after FSST
+//
+// a table holds up to POINTLESS_STRING_SYMBOLS_N_SYMBOLS symbols of 1 to POINTLESS_STRING_SYMBOLS_SYMBOL_LEN bytes.
+// a compressed string (POINTLESS_STRING_SYMBOLS) is a sequence of codes, each the index of a symbol, or
+// POINTLESS_STRING_SYMBOLS_ESCAPE followed by a single character. every string decodes on its own, from its codes and
+// the table, so strings keep their random access
+//
+// a file holds at most one table, as its last string, each symbol being its length followed by its characters. the
+// table is built from a sample of the 8-bit strings of the file, in a few rounds, each keeping the symbols, and
+// concatenations of adjacent symbols, which would have saved the most bytes when compressing the sample with the
+// table of the previous round
+#define POINTLESS_STRING_SYMBOLS_N_SYMBOLS 255
+#define POINTLESS_STRING_SYMBOLS_SYMBOL_LEN 8
+#define POINTLESS_STRING_SYMBOLS_ESCAPE 255
+#define POINTLESS_STRING_SYMBOLS_ROUNDS 5
+#define POINTLESS_STRING_SYMBOLS_SAMPLE_LEN (1 << 16)
+
+// decoding writes whole symbols, so its buffer has room for a symbol past the longest string
+#define POINTLESS_STRING_SYMBOLS_BUFFER_LEN (POINTLESS_STRING_SYMBOLS_MAX_LEN + POINTLESS_STRING_SYMBOLS_SYMBOL_LEN)
+#define POINTLESS_STRING_SYMBOLS_TABLE_LEN (POINTLESS_STRING_SYMBOLS_N_SYMBOLS * (1 + POINTLESS_STRING_SYMBOLS_SYMBOL_LEN))
+
+typedef struct pointless_string_symbols_s {
+	// symbols, zero-padded, and their lengths, 0 for codes which are not symbols
+	uint32_t n_symbols;
+	uint8_t len[256];
+	uint8_t symbol[256][POINTLESS_STRING_SYMBOLS_SYMBOL_LEN];
+
+	// for encoding, the codes of symbols starting with each character, longest first
+	uint16_t first[257];
+	uint8_t by_first[256];
+} pointless_string_symbols_t;
+
+// reader, the table of a file is read when it is opened, and its strings are validated against it
+int pointless_string_symbols_init(pointless_t* p, const char** error);
+void pointless_string_symbols_end(pointless_t* p);
+
+// decodes 'n_codes' codes into 'buffer', which holds POINTLESS_STRING_SYMBOLS_BUFFER_LEN bytes, and zero-terminates
+// it. returns the number of characters, or UINT32_MAX if the codes are not a valid string
+uint32_t pointless_string_symbols_decode(pointless_string_symbols_t* t, const uint8_t* codes, uint32_t n_codes, uint8_t* buffer);
+
+// creation, a table for 'n_strings' non-empty strings of the given lengths, each at most
+// POINTLESS_STRING_SYMBOLS_MAX_LEN characters
+int pointless_string_symbols_build(pointless_string_symbols_t* t, uint8_t** strings, uint32_t* lens, uint32_t n_strings, const char** error);
+
+// compresses a string of 'len' characters into 'codes', which holds 2 * len bytes, returning the number of codes
+uint32_t pointless_string_symbols_encode(pointless_string_symbols_t* t, const uint8_t* s, uint32_t len, uint8_t* codes);
+
+// the table as stored in the file, into 'buffer', which holds POINTLESS_STRING_SYMBOLS_TABLE_LEN + 1 bytes, and is
+// zero-terminated. returns its length
+uint32_t pointless_string_symbols_serialize(pointless_string_symbols_t* t, uint8_t* buffer);
+
+#endif
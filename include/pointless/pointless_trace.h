@@ -0,0 +1,45 @@
+#ifndef __POINTLESS__TRACE__H__
+#define __POINTLESS__TRACE__H__
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#include <pointless/pointless_defs.h>
+#include <pointless/pointless_value.h>
+#include <pointless/pointless_malloc.h>
+
+// access tracing and prefetching
+//
+// while tracing, a reader records the heap containers (strings, vectors, bitvectors, sets and maps) it accesses,
+// each once, in order of first access. after the first access of a container, the cost is a bit test. recording
+// takes no locks, so any number of threads may read while tracing
+//
+// the trace is written to a small sidecar file, and replayed when the next file is opened. a background thread
+// asks the kernel to read ahead the pages of the traced containers, first the page holding the start of each, then
+// the remainder of each. traces are container ids, so they may be replayed on a newer file of the same shape, ids
+// the file does not have are skipped
+
+// records the access of a heap container, if the reader is tracing
+#define PC_TRACE(p, v) do { if ((p)->trace) pointless_trace_touch((p), (v)); } while (0)
+
+// start tracing, keeping up to 'n_values_max' containers, 0 meaning all of them. pointless_trace_end() frees the
+// trace, so it must not run while other threads read through 'p', or write its trace
+int pointless_trace_begin(pointless_t* p, uint64_t n_values_max, const char** error);
+void pointless_trace_touch(pointless_t* p, pointless_value_t* v);
+void pointless_trace_end(pointless_t* p);
+
+// the sidecar file, the values hold a type and a container id, as in the reader (e.g. POINTLESS_VECTOR_U32, 3), the
+// caller frees them with pointless_free()
+int pointless_trace_write_f(pointless_t* p, const char* fname, const char** error);
+int pointless_trace_read_f(const char* fname, pointless_value_t** values, uint32_t* n_values, const char** error);
+
+// start prefetching a mapped file from a trace file, right after opening it. pointless_prefetch_wait() waits for
+// the prefetch to finish, pointless_prefetch_stop() cuts it short, as pointless_close() does
+int pointless_prefetch_f(pointless_t* p, const char* fname, const char** error);
+void pointless_prefetch_wait(pointless_t* p);
+void pointless_prefetch_stop(pointless_t* p);
+
+#endif
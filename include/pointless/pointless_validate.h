@@ -64,5 +64,7 @@ int32_t pointless_validate_heap_value(pointless_validate_context_t* context, poi
 
 // validate hash table invariants
 int32_t pointless_hash_table_validate(pointless_t* p, uint32_t n_items, uint32_t n_buckets, uint32_t* hash_vector, pointless_value_t* key_vector, pointless_value_t* value_vector, const char** error);
+int32_t pointless_hash_table_validate_compact(pointless_t* p, uint32_t n_items, uint32_t n_hash, uint32_t* hash_vector, pointless_value_t* key_vector, const char** error);
+int32_t pointless_hash_table_validate_dense(pointless_t* p, uint32_t n_items, pointless_value_t* min_key, uint32_t n_hash, uint32_t* hash_vector, uint32_t n_range, const char** error);
 
 #endif
@@ -24,6 +24,9 @@ pointless_create_value_t pointless_value_create_bool_true(void);
 pointless_create_value_t pointless_value_create_null(void);
 pointless_create_value_t pointless_value_create_empty_slot(void);
 
+// 'len' is at most POINTLESS_STRING_INLINE_MAX_LEN
+pointless_create_value_t pointless_value_create_string_inline(uint8_t* v, uint32_t len);
+
 // read-time values
 pointless_value_t pointless_value_create_as_read_i32(int32_t v);
 pointless_value_t pointless_value_create_as_read_u32(uint32_t v);
@@ -61,6 +64,7 @@ int64_t pointless_get_int_as_int64(uint32_t t, pointless_value_data_t* v);
 
 // create-time accessor
 int64_t pointless_create_get_int_as_int64(pointless_create_value_t* v);
+uint64_t pointless_create_value_get_int_bits(pointless_create_t* c, pointless_create_value_t* v);
 int32_t pointless_create_value_get_i32(pointless_create_value_t* v);
 uint32_t pointless_create_value_get_u32(pointless_create_value_t* v);
 float pointless_create_value_get_float(pointless_create_value_t* v);
@@ -79,6 +83,8 @@ pointless_complete_create_value_t pointless_create_value_to_complete(pointless_c
 
 // utilities
 int32_t pointless_is_vector_type(uint32_t type);
+int32_t pointless_is_encoded_vector_type(uint32_t type);
+int32_t pointless_is_string_8_type(uint32_t type);
 int32_t pointless_is_integer_type(uint32_t type);
 
 #endif
@@ -0,0 +1,83 @@
+#ifndef __POINTLESS__VECTOR__OPS__H__
+#define __POINTLESS__VECTOR__OPS__H__
+
+#include <pointless/pointless_defs.h>
+#include <pointless/pointless_dynarray.h>
+
+#include <math.h>
+#include <float.h>
+
+#ifndef __cplusplus
+#include <limits.h>
+#include <stdint.h>
+#else
+#include <climits>
+#include <cstdint>
+#endif
+
+// reductions and filters over primitive vectors
+//
+// a vector is given as a base pointer, an item type and a number of items, so the same
+// routines work on mmap'ed pointless vectors (pointless_reader_vector_i8() etc.) and on
+// in-memory buffers. the item type is one of POINTLESS_VECTOR_I8 ... POINTLESS_VECTOR_U64,
+// POINTLESS_VECTOR_FLOAT or POINTLESS_VECTOR_EMPTY.
+//
+// the inner loops are branch-free and specialized on the item type, so the compiler can
+// auto-vectorize them
+
+// a scalar operand, or a result
+#define POINTLESS_VECTOR_NUMBER_I64 0
+#define POINTLESS_VECTOR_NUMBER_U64 1
+#define POINTLESS_VECTOR_NUMBER_DOUBLE 2
+
+typedef struct {
+	uint32_t type;
+
+	union {
+		int64_t i;
+		uint64_t u;
+		double f;
+	} data;
+} pointless_vector_number_t;
+
+pointless_vector_number_t pointless_vector_number_i64(int64_t v);
+pointless_vector_number_t pointless_vector_number_u64(uint64_t v);
+pointless_vector_number_t pointless_vector_number_double(double v);
+
+// predicates, item OP a, except for RANGE, which is a <= item < b
+//
+// operands are compared by value against the items, so any operand type works with any vector type
+#define POINTLESS_VECTOR_OP_EQ 0
+#define POINTLESS_VECTOR_OP_NE 1
+#define POINTLESS_VECTOR_OP_LT 2
+#define POINTLESS_VECTOR_OP_LE 3
+#define POINTLESS_VECTOR_OP_GT 4
+#define POINTLESS_VECTOR_OP_GE 5
+#define POINTLESS_VECTOR_OP_RANGE 6
+
+// sum of all items: I64 for signed vectors, U64 for unsigned vectors (both modulo 2**64) and DOUBLE for floats
+int pointless_vector_sum(void* v, uint32_t type, size_t n, pointless_vector_number_t* sum, const char** error);
+
+// index of the first minimum/maximum item
+int pointless_vector_argmin(void* v, uint32_t type, size_t n, size_t* i, const char** error);
+int pointless_vector_argmax(void* v, uint32_t type, size_t n, size_t* i, const char** error);
+
+// number of items for which the predicate holds
+int pointless_vector_count(void* v, uint32_t type, size_t n, uint32_t op, pointless_vector_number_t a, pointless_vector_number_t b, size_t* count, const char** error);
+
+// indices of the items for which the predicate holds, 'indices' must be an empty uint32_t dynarray
+int pointless_vector_filter(void* v, uint32_t type, size_t n, uint32_t op, pointless_vector_number_t a, pointless_vector_number_t b, pointless_dynarray_t* indices, const char** error);
+
+// size of a single item, 0 for empty vectors
+size_t pointless_vector_type_item_size(uint32_t type);
+
+// dst[i] = src[index[i]], for all i < n_index
+//
+// 'src' and 'dst' items have the same type, 'dst' must have room for n_index items, and all
+// index items must be in [0, n_src[
+int pointless_vector_gather(void* src, uint32_t src_type, size_t n_src, void* index, uint32_t index_type, size_t n_index, void* dst, const char** error);
+
+// equal-width histogram of the items in [lo, hi[
+int pointless_vector_histogram(void* v, uint32_t type, size_t n, double lo, double hi, uint64_t* bins, uint32_t n_bins, const char** error);
+
+#endif
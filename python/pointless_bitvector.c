@@ -932,7 +932,7 @@ PyPointlessBitvector* PyPointlessBitvector_New(PyPointless* pp, pointless_value_
 	return pv;
 }
 
-uint32_t pointless_pybitvector_hash_32(PyPointlessBitvector* bitvector)
+uint32_t pointless_pybitvector_hash_32(PyPointlessBitvector* bitvector, uint32_t version)
 {
 	if (bitvector->is_pointless) {
 		void* buffer = 0;
@@ -940,11 +940,11 @@ uint32_t pointless_pybitvector_hash_32(PyPointlessBitvector* bitvector)
 		if (bitvector->pointless_v->type == POINTLESS_BITVECTOR)
 			buffer = pointless_reader_bitvector_buffer(&bitvector->pointless_pp->p, bitvector->pointless_v);
 
-		return pointless_bitvector_hash_32(bitvector->pointless_v->type, &bitvector->pointless_v->data, buffer);
+		return pointless_bitvector_hash_32(version, bitvector->pointless_v->type, &bitvector->pointless_v->data, buffer);
 	}
 
 	uint32_t n_bits = bitvector->primitive_n_bits;
 	void* bits = bitvector->primitive_bits;
 
-	return pointless_bitvector_hash_n_bits_bits_32(n_bits, bits);
+	return pointless_bitvector_hash_n_bits_bits_32(version, n_bits, bits);
 }
@@ -7,6 +7,8 @@ typedef struct {
 	Pvoid_t objects_used;   // PyObject* -> create-time-handle
 	int unwiden_strings;    // true iff: we find the smallest representations for strings
 	int normalize_bitvector;
+	int columnar;           // true iff: lists of dicts with identical keys become tables
+	int vector_item;        // true iff: the object being exported is a list/tuple item, which may be a 64-bit integer
 } pointless_export_state_t;
 
 static uint32_t pointless_export_get_seen(pointless_export_state_t* state, PyObject* py_object)
@@ -28,6 +30,112 @@ static int pointless_export_set_seen(pointless_export_state_t* state, PyObject*
 	return 1;
 }
 
+static uint32_t pointless_export_py_rec(pointless_export_state_t* state, PyObject* py_object, uint32_t depth);
+
+// if a list/tuple holds only dicts, with the same non-empty set of keys, return those keys in the order of the first dict
+static PyObject* pointless_export_table_keys(PyObject* py_object)
+{
+	Py_ssize_t i, j, n_rows = PySequence_Fast_GET_SIZE(py_object);
+
+	if (n_rows == 0 || !PyDict_Check(PySequence_Fast_GET_ITEM(py_object, 0)))
+		return 0;
+
+	PyObject* keys = PyDict_Keys(PySequence_Fast_GET_ITEM(py_object, 0));
+
+	if (keys == 0) {
+		PyErr_Clear();
+		return 0;
+	}
+
+	Py_ssize_t n_keys = PyList_GET_SIZE(keys);
+
+	if (n_keys == 0)
+		goto not_table;
+
+	for (i = 1; i < n_rows; i++) {
+		PyObject* row = PySequence_Fast_GET_ITEM(py_object, i);
+
+		if (!PyDict_Check(row) || PyDict_Size(row) != n_keys)
+			goto not_table;
+
+		for (j = 0; j < n_keys; j++) {
+			if (PyDict_GetItem(row, PyList_GET_ITEM(keys, j)) == 0)
+				goto not_table;
+		}
+	}
+
+	return keys;
+
+not_table:
+	Py_DECREF(keys);
+	return 0;
+}
+
+static uint32_t pointless_export_py_table(pointless_export_state_t* state, PyObject* py_object, PyObject* keys, uint32_t depth)
+{
+	Py_ssize_t i, j, n_rows = PySequence_Fast_GET_SIZE(py_object), n_keys = PyList_GET_SIZE(keys);
+	uint32_t keys_handle = POINTLESS_CREATE_VALUE_FAIL, handle = POINTLESS_CREATE_VALUE_FAIL;
+
+	if (n_rows > UINT32_MAX) {
+		PyErr_SetString(PyExc_ValueError, "too many rows for a table");
+		state->is_error = 1;
+		state->error_line = __LINE__;
+		return POINTLESS_CREATE_VALUE_FAIL;
+	}
+
+	// the key list is a temporary, so its vector is built here, rather than through the seen-cache
+	keys_handle = pointless_create_vector_value(&state->c);
+
+	if (keys_handle == POINTLESS_CREATE_VALUE_FAIL)
+		goto oom;
+
+	for (j = 0; j < n_keys; j++) {
+		uint32_t key_handle = pointless_export_py_rec(state, PyList_GET_ITEM(keys, j), depth + 1);
+
+		if (key_handle == POINTLESS_CREATE_VALUE_FAIL)
+			return key_handle;
+
+		if (pointless_create_vector_value_append(&state->c, keys_handle, key_handle) == POINTLESS_CREATE_VALUE_FAIL)
+			goto oom;
+	}
+
+	handle = pointless_create_table(&state->c, (uint32_t)n_rows, keys_handle);
+
+	if (handle == POINTLESS_CREATE_VALUE_FAIL || !pointless_export_set_seen(state, py_object, handle))
+		goto oom;
+
+	// one vector per key, they get compressed like any other vector on output
+	for (j = 0; j < n_keys; j++) {
+		uint32_t column = pointless_create_vector_value(&state->c);
+
+		if (column == POINTLESS_CREATE_VALUE_FAIL)
+			goto oom;
+
+		for (i = 0; i < n_rows; i++) {
+			PyObject* value = PyDict_GetItem(PySequence_Fast_GET_ITEM(py_object, i), PyList_GET_ITEM(keys, j));
+			state->vector_item = 1;
+			uint32_t value_handle = pointless_export_py_rec(state, value, depth + 2);
+
+			if (value_handle == POINTLESS_CREATE_VALUE_FAIL)
+				return value_handle;
+
+			if (pointless_create_vector_value_append(&state->c, column, value_handle) == POINTLESS_CREATE_VALUE_FAIL)
+				goto oom;
+		}
+
+		if (pointless_create_table_add_column(&state->c, handle, column) == POINTLESS_CREATE_VALUE_FAIL)
+			goto oom;
+	}
+
+	return handle;
+
+oom:
+	PyErr_NoMemory();
+	state->is_error = 1;
+	state->error_line = __LINE__;
+	return POINTLESS_CREATE_VALUE_FAIL;
+}
+
 static uint32_t pointless_export_py_rec(pointless_export_state_t* state, PyObject* py_object, uint32_t depth)
 {
 	// don't go too deep
@@ -42,6 +150,10 @@ static uint32_t pointless_export_py_rec(pointless_export_state_t* state, PyObjec
 	// check simple types first
 	uint32_t handle = POINTLESS_CREATE_VALUE_FAIL;
 
+	// only applies to this object, not its children
+	int vector_item = state->vector_item;
+	state->vector_item = 0;
+
 	// return an error on failure
 	#define RETURN_OOM(state) {PyErr_NoMemory(); (state)->is_error = 1; printf("line: %i\n", __LINE__); state->error_line = __LINE__; return POINTLESS_CREATE_VALUE_FAIL;}
 	#define RETURN_OOM_IF_FAIL(handle, state) if ((handle) == POINTLESS_CREATE_VALUE_FAIL) RETURN_OOM(state);
@@ -58,8 +170,11 @@ static uint32_t pointless_export_py_rec(pointless_export_state_t* state, PyObjec
 	} else if (PyInt_Check(py_object)) {
 		long v = PyInt_AS_LONG(py_object);
 
+		// 64-bit integers, which end up in an I64/U64 vector
+		if (vector_item && !(INT32_MIN <= v && v <= UINT32_MAX)) {
+			handle = pointless_create_i64(&state->c, (int64_t)v);
 		// unsigned
-		if (v >= 0) {
+		} else if (v >= 0) {
 			if (v > UINT32_MAX) {
 				PyErr_Format(PyExc_ValueError, "integer too large for mere 32 bits");
 				printf("line: %i\n", __LINE__);
@@ -87,10 +202,24 @@ static uint32_t pointless_export_py_rec(pointless_export_state_t* state, PyObjec
 	} else if (PyLong_Check(py_object)) {
 		// this will raise an overflow error if number is outside the legal range of PY_LONG_LONG
 		PY_LONG_LONG v = PyLong_AsLongLong(py_object);
+		unsigned PY_LONG_LONG vu = 0;
 
-		// if there was an exception, clear it, and set our own
+		// if there was an exception, clear it, and set our own, unless it is an unsigned 64-bit vector item
 		if (PyErr_Occurred()) {
 			PyErr_Clear();
+
+			if (vector_item && _PyLong_Sign(py_object) > 0) {
+				vu = PyLong_AsUnsignedLongLong(py_object);
+
+				if (!PyErr_Occurred()) {
+					handle = pointless_create_u64(&state->c, (uint64_t)vu);
+					RETURN_OOM_IF_FAIL(handle, state);
+					return handle;
+				}
+
+				PyErr_Clear();
+			}
+
 			PyErr_SetString(PyExc_ValueError, "value of long is way beyond what we can store right now");
 			printf("line: %i\n", __LINE__);
 			state->is_error = 1;
@@ -98,8 +227,11 @@ static uint32_t pointless_export_py_rec(pointless_export_state_t* state, PyObjec
 			return POINTLESS_CREATE_VALUE_FAIL;
 		}
 
+		// 64-bit integers, which end up in an I64/U64 vector
+		if (vector_item && !(INT32_MIN <= v && v <= UINT32_MAX)) {
+			handle = pointless_create_i64(&state->c, (int64_t)v);
 		// unsigned
-		if (v >= 0) {
+		} else if (v >= 0) {
 			if (v > UINT32_MAX) {
 				PyErr_Format(PyExc_ValueError, "long too large for mere 32 bits");
 				printf("line: %i\n", __LINE__);
@@ -144,6 +276,17 @@ static uint32_t pointless_export_py_rec(pointless_export_state_t* state, PyObjec
 	if (handle != POINTLESS_CREATE_VALUE_FAIL)
 		return handle;
 
+	// list/tuple of uniform dicts, stored column-by-column
+	if (state->columnar && (PyList_Check(py_object) || PyTuple_Check(py_object))) {
+		PyObject* keys = pointless_export_table_keys(py_object);
+
+		if (keys != 0) {
+			handle = pointless_export_py_table(state, py_object, keys, depth);
+			Py_DECREF(keys);
+			return handle;
+		}
+	}
+
 	// list/tuple object
 	if (PyList_Check(py_object) || PyTuple_Check(py_object)) {
 		// create and cache handle
@@ -161,6 +304,7 @@ static uint32_t pointless_export_py_rec(pointless_export_state_t* state, PyObjec
 
 		for (i = 0; i < n_items; i++) {
 			PyObject* child = PyList_Check(py_object) ? PyList_GET_ITEM(py_object, i) : PyTuple_GET_ITEM(py_object, i);
+			state->vector_item = 1;
 			uint32_t child_handle = pointless_export_py_rec(state, child, depth + 1);
 
 			if (child_handle == POINTLESS_CREATE_VALUE_FAIL)
@@ -540,14 +684,67 @@ static void pointless_export_py(pointless_export_state_t* state, PyObject* py_ob
 		pointless_create_set_root(&state->c, root);
 }
 
+// the heap order of a 'heap_order' argument, returns 0 if there is none
+static int pointless_parse_heap_order(const char* heap_order, uint32_t* code)
+{
+	if (strcmp(heap_order, "type") == 0)
+		*code = POINTLESS_CREATE_HEAP_ORDER_TYPE;
+	else if (strcmp(heap_order, "dfs") == 0)
+		*code = POINTLESS_CREATE_HEAP_ORDER_DFS;
+	else if (strcmp(heap_order, "bfs") == 0)
+		*code = POINTLESS_CREATE_HEAP_ORDER_BFS;
+	else
+		return 0;
+
+	return 1;
+}
+
 const char pointless_write_object_doc[] =
 "0\n"
 "pointless.serialize_to_file(object, fname)\n"
 "\n"
 "Serializes the object to a file.\n"
 "\n"
-"  object: the object\n"
-"  fname:  the file name\n"
+"  object:   the object\n"
+"  fname:    the file name\n"
+"  columnar: if True, lists of dicts with identical keys are stored as tables\n"
+"  bloom_threshold: sets and dicts with at least this many keys get a Bloom filter, speeding up\n"
+"                   lookups of missing keys, 0 (the default) for none\n"
+"  compact_hash_tables: if True, sets and dicts use the compact layout, which is smaller and\n"
+"                       iterates in insertion order\n"
+"  typed_hash_tables: if True, numeric keys and values of sets and dicts are stored in primitive\n"
+"                     vectors where possible, implies compact_hash_tables\n"
+"  dense_maps: if True, dicts whose keys are integers covering most of a range are stored as an\n"
+"              array indexed by key, looked up without hashing and iterated in key order\n"
+"  shared_schemas: if True, dicts with the same keys in the same order share their hash and key\n"
+"                  vectors, so only their values are stored per dict\n"
+"  encoded_vectors: if True, long lists of strings, booleans, Nones and numbers, which are not\n"
+"                   set members or dict keys, are stored dictionary or run-length encoded when\n"
+"                   that takes at most half the space, and decoded on access\n"
+"  inline_strings: if True, 8-bit strings of at most 3 characters are stored inside their value,\n"
+"                  instead of on the heap, and read without a heap access\n"
+"  split_vectors: if True, long lists of strings, booleans, Nones and numbers, which are not set\n"
+"                 members, dict keys or encoded, store the types and data of their items apart,\n"
+"                 in about 5 bytes per item instead of 8\n"
+"  delta_offsets: if True, the offsets of strings and containers are stored as 16-bit deltas in\n"
+"                 blocks, in about 2.5 bytes per offset instead of 4 or 8, where the file allows it\n"
+"  vector_alignment: the items of all lists and vectors start at a multiple of this many bytes into\n"
+"                    the file, a power of two from 4 to 65536, e.g. 64 for cache lines\n"
+"  large_vector_alignment: the same, for lists and vectors of at least this many bytes, e.g. 4096 for\n"
+"                          pages. files with alignments other than 4 need a newer reader\n"
+"  heap_order: 'type' (the default) to group strings and containers by type, 'dfs' or 'bfs' to\n"
+"              place them depth-first or breadth-first from the root, next to what refers to them\n"
+"  block_vectors: if True, long lists of integers, which are not set members or dict keys, are\n"
+"                 stored in blocks of 128 items with their deltas from the smallest item of the\n"
+"                 block bit-packed, when that takes at most 3/4 of the space, and decoded on access.\n"
+"                 such lists are read back as value-based vectors, without the buffer protocol and\n"
+"                 primitive vector operations (max(), sum(), ...). PointlessPrimVector and other\n"
+"                 primitive vectors are kept as they are\n"
+"  string_symbols: if True, 8-bit strings of at most 255 characters are compressed with a symbol\n"
+"                  table built from them, each decoding on its own on access, where the file gets\n"
+"                  smaller. such files need a newer reader\n"
+"  mix_hash: if True, strings, tuples and bitvectors are hashed with a stronger and faster 64-bit state\n"
+"            hash, giving shorter set and dict probes. such files need a newer reader\n"
 ;
 PyObject* pointless_write_object(PyObject* self, PyObject* args, PyObject* kwds)
 {
@@ -556,6 +753,23 @@ PyObject* pointless_write_object(PyObject* self, PyObject* args, PyObject* kwds)
 	PyObject* retval = 0;
 	PyObject* normalize_bitvector = Py_True;
 	PyObject* unwiden_strings = Py_False;
+	PyObject* columnar = Py_False;
+	unsigned int bloom_threshold = 0;
+	PyObject* compact_hash_tables = Py_False;
+	PyObject* typed_hash_tables = Py_False;
+	PyObject* dense_maps = Py_False;
+	PyObject* shared_schemas = Py_False;
+	PyObject* encoded_vectors = Py_False;
+	PyObject* inline_strings = Py_False;
+	PyObject* split_vectors = Py_False;
+	PyObject* delta_offsets = Py_False;
+	unsigned int vector_alignment = 4;
+	unsigned int large_vector_alignment = 4;
+	const char* heap_order = "type";
+	PyObject* block_vectors = Py_False;
+	PyObject* string_symbols = Py_False;
+	PyObject* mix_hash = Py_False;
+	uint32_t heap_order_code = POINTLESS_CREATE_HEAP_ORDER_TYPE;
 	int create_end = 0;
 
 	const char* error = 0;
@@ -566,16 +780,38 @@ PyObject* pointless_write_object(PyObject* self, PyObject* args, PyObject* kwds)
 	state.error_line = -1;
 	state.unwiden_strings = 0;
 	state.normalize_bitvector = 1;
+	state.columnar = 0;
+	state.vector_item = 0;
 
-	static char* kwargs[] = {"object", "filename", "unwiden_strings", "normalize_bitvector", 0};
+	static char* kwargs[] = {"object", "filename", "unwiden_strings", "normalize_bitvector", "columnar", "bloom_threshold", "compact_hash_tables", "typed_hash_tables", "dense_maps", "shared_schemas", "encoded_vectors", "inline_strings", "split_vectors", "delta_offsets", "vector_alignment", "large_vector_alignment", "heap_order", "block_vectors", "string_symbols", "mix_hash", 0};
 
-	if (!PyArg_ParseTupleAndKeywords(args, kwds, "Os|O!O!:serialize", kwargs, &object, &fname, &PyBool_Type, &unwiden_strings, &PyBool_Type, &normalize_bitvector))
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "Os|O!O!O!IO!O!O!O!O!O!O!O!IIsO!O!O!:serialize", kwargs, &object, &fname, &PyBool_Type, &unwiden_strings, &PyBool_Type, &normalize_bitvector, &PyBool_Type, &columnar, &bloom_threshold, &PyBool_Type, &compact_hash_tables, &PyBool_Type, &typed_hash_tables, &PyBool_Type, &dense_maps, &PyBool_Type, &shared_schemas, &PyBool_Type, &encoded_vectors, &PyBool_Type, &inline_strings, &PyBool_Type, &split_vectors, &PyBool_Type, &delta_offsets, &vector_alignment, &large_vector_alignment, &heap_order, &PyBool_Type, &block_vectors, &PyBool_Type, &string_symbols, &PyBool_Type, &mix_hash))
 		return 0;
 
+	if (!pointless_parse_heap_order(heap_order, &heap_order_code)) {
+		PyErr_SetString(PyExc_ValueError, "heap_order must be 'type', 'dfs' or 'bfs'");
+		return 0;
+	}
+
 	state.unwiden_strings = (unwiden_strings == Py_True);
 	state.normalize_bitvector = (normalize_bitvector == Py_True);
-
-	pointless_create_begin_64(&state.c);
+	state.columnar = (columnar == Py_True);
+
+	pointless_create_begin_auto(&state.c);
+	pointless_create_bloom_threshold(&state.c, bloom_threshold);
+	pointless_create_compact_hash_tables(&state.c, (compact_hash_tables == Py_True));
+	pointless_create_typed_hash_tables(&state.c, (typed_hash_tables == Py_True));
+	pointless_create_dense_maps(&state.c, (dense_maps == Py_True));
+	pointless_create_shared_schemas(&state.c, (shared_schemas == Py_True));
+	pointless_create_encoded_vectors(&state.c, (encoded_vectors == Py_True));
+	pointless_create_inline_strings(&state.c, (inline_strings == Py_True));
+	pointless_create_split_vectors(&state.c, (split_vectors == Py_True));
+	pointless_create_block_vectors(&state.c, (block_vectors == Py_True));
+	pointless_create_string_symbols(&state.c, (string_symbols == Py_True));
+	pointless_create_mix_hash(&state.c, (mix_hash == Py_True));
+	pointless_create_delta_offsets(&state.c, (delta_offsets == Py_True));
+	pointless_create_vector_alignment(&state.c, vector_alignment, large_vector_alignment);
+	pointless_create_heap_order(&state.c, heap_order_code);
 
 	pointless_export_py(&state, object);
 
@@ -610,7 +846,45 @@ const char pointless_write_object_to_buffer_doc[] =
 "\n"
 "Serializes the object to a buffer.\n"
 "\n"
-"  object: the object\n"
+"  object:   the object\n"
+"  columnar: if True, lists of dicts with identical keys are stored as tables\n"
+"  bloom_threshold: sets and dicts with at least this many keys get a Bloom filter, speeding up\n"
+"                   lookups of missing keys, 0 (the default) for none\n"
+"  compact_hash_tables: if True, sets and dicts use the compact layout, which is smaller and\n"
+"                       iterates in insertion order\n"
+"  typed_hash_tables: if True, numeric keys and values of sets and dicts are stored in primitive\n"
+"                     vectors where possible, implies compact_hash_tables\n"
+"  dense_maps: if True, dicts whose keys are integers covering most of a range are stored as an\n"
+"              array indexed by key, looked up without hashing and iterated in key order\n"
+"  shared_schemas: if True, dicts with the same keys in the same order share their hash and key\n"
+"                  vectors, so only their values are stored per dict\n"
+"  encoded_vectors: if True, long lists of strings, booleans, Nones and numbers, which are not\n"
+"                   set members or dict keys, are stored dictionary or run-length encoded when\n"
+"                   that takes at most half the space, and decoded on access\n"
+"  inline_strings: if True, 8-bit strings of at most 3 characters are stored inside their value,\n"
+"                  instead of on the heap, and read without a heap access\n"
+"  split_vectors: if True, long lists of strings, booleans, Nones and numbers, which are not set\n"
+"                 members, dict keys or encoded, store the types and data of their items apart,\n"
+"                 in about 5 bytes per item instead of 8\n"
+"  delta_offsets: if True, the offsets of strings and containers are stored as 16-bit deltas in\n"
+"                 blocks, in about 2.5 bytes per offset instead of 4 or 8, where the file allows it\n"
+"  vector_alignment: the items of all lists and vectors start at a multiple of this many bytes into\n"
+"                    the file, a power of two from 4 to 65536, e.g. 64 for cache lines\n"
+"  large_vector_alignment: the same, for lists and vectors of at least this many bytes, e.g. 4096 for\n"
+"                          pages. files with alignments other than 4 need a newer reader\n"
+"  heap_order: 'type' (the default) to group strings and containers by type, 'dfs' or 'bfs' to\n"
+"              place them depth-first or breadth-first from the root, next to what refers to them\n"
+"  block_vectors: if True, long lists of integers, which are not set members or dict keys, are\n"
+"                 stored in blocks of 128 items with their deltas from the smallest item of the\n"
+"                 block bit-packed, when that takes at most 3/4 of the space, and decoded on access.\n"
+"                 such lists are read back as value-based vectors, without the buffer protocol and\n"
+"                 primitive vector operations (max(), sum(), ...). PointlessPrimVector and other\n"
+"                 primitive vectors are kept as they are\n"
+"  string_symbols: if True, 8-bit strings of at most 255 characters are compressed with a symbol\n"
+"                  table built from them, each decoding on its own on access, where the file gets\n"
+"                  smaller. such files need a newer reader\n"
+"  mix_hash: if True, strings, tuples and bitvectors are hashed with a stronger and faster 64-bit state\n"
+"            hash, giving shorter set and dict probes. such files need a newer reader\n"
 ;
 PyObject* pointless_write_object_to_buffer(PyObject* self, PyObject* args, PyObject* kwds)
 {
@@ -618,6 +892,23 @@ PyObject* pointless_write_object_to_buffer(PyObject* self, PyObject* args, PyObj
 	PyObject* retval = 0;
 	PyObject* normalize_bitvector = Py_True;
 	PyObject* unwiden_strings = Py_False;
+	PyObject* columnar = Py_False;
+	unsigned int bloom_threshold = 0;
+	PyObject* compact_hash_tables = Py_False;
+	PyObject* typed_hash_tables = Py_False;
+	PyObject* dense_maps = Py_False;
+	PyObject* shared_schemas = Py_False;
+	PyObject* encoded_vectors = Py_False;
+	PyObject* inline_strings = Py_False;
+	PyObject* split_vectors = Py_False;
+	PyObject* delta_offsets = Py_False;
+	unsigned int vector_alignment = 4;
+	unsigned int large_vector_alignment = 4;
+	const char* heap_order = "type";
+	PyObject* block_vectors = Py_False;
+	PyObject* string_symbols = Py_False;
+	PyObject* mix_hash = Py_False;
+	uint32_t heap_order_code = POINTLESS_CREATE_HEAP_ORDER_TYPE;
 	int create_end = 0;
 
 	void* buf = 0;
@@ -631,16 +922,38 @@ PyObject* pointless_write_object_to_buffer(PyObject* self, PyObject* args, PyObj
 	state.error_line = -1;
 	state.unwiden_strings = 0;
 	state.normalize_bitvector = 1;
+	state.columnar = 0;
+	state.vector_item = 0;
 
-	static char* kwargs[] = {"object", "unwiden_strings", "normalize_bitvector", 0};
+	static char* kwargs[] = {"object", "unwiden_strings", "normalize_bitvector", "columnar", "bloom_threshold", "compact_hash_tables", "typed_hash_tables", "dense_maps", "shared_schemas", "encoded_vectors", "inline_strings", "split_vectors", "delta_offsets", "vector_alignment", "large_vector_alignment", "heap_order", "block_vectors", "string_symbols", "mix_hash", 0};
 
-	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O!O!:serialize", kwargs, &object, &PyBool_Type, &unwiden_strings, &PyBool_Type, &normalize_bitvector))
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O!O!O!IO!O!O!O!O!O!O!O!IIsO!O!O!:serialize", kwargs, &object, &PyBool_Type, &unwiden_strings, &PyBool_Type, &normalize_bitvector, &PyBool_Type, &columnar, &bloom_threshold, &PyBool_Type, &compact_hash_tables, &PyBool_Type, &typed_hash_tables, &PyBool_Type, &dense_maps, &PyBool_Type, &shared_schemas, &PyBool_Type, &encoded_vectors, &PyBool_Type, &inline_strings, &PyBool_Type, &split_vectors, &PyBool_Type, &delta_offsets, &vector_alignment, &large_vector_alignment, &heap_order, &PyBool_Type, &block_vectors, &PyBool_Type, &string_symbols, &PyBool_Type, &mix_hash))
 		return 0;
 
+	if (!pointless_parse_heap_order(heap_order, &heap_order_code)) {
+		PyErr_SetString(PyExc_ValueError, "heap_order must be 'type', 'dfs' or 'bfs'");
+		return 0;
+	}
+
 	state.unwiden_strings = (unwiden_strings == Py_True);
 	state.normalize_bitvector = (normalize_bitvector == Py_True);
-
-	pointless_create_begin_64(&state.c);
+	state.columnar = (columnar == Py_True);
+
+	pointless_create_begin_auto(&state.c);
+	pointless_create_bloom_threshold(&state.c, bloom_threshold);
+	pointless_create_compact_hash_tables(&state.c, (compact_hash_tables == Py_True));
+	pointless_create_typed_hash_tables(&state.c, (typed_hash_tables == Py_True));
+	pointless_create_dense_maps(&state.c, (dense_maps == Py_True));
+	pointless_create_shared_schemas(&state.c, (shared_schemas == Py_True));
+	pointless_create_encoded_vectors(&state.c, (encoded_vectors == Py_True));
+	pointless_create_inline_strings(&state.c, (inline_strings == Py_True));
+	pointless_create_split_vectors(&state.c, (split_vectors == Py_True));
+	pointless_create_block_vectors(&state.c, (block_vectors == Py_True));
+	pointless_create_string_symbols(&state.c, (string_symbols == Py_True));
+	pointless_create_mix_hash(&state.c, (mix_hash == Py_True));
+	pointless_create_delta_offsets(&state.c, (delta_offsets == Py_True));
+	pointless_create_vector_alignment(&state.c, vector_alignment, large_vector_alignment);
+	pointless_create_heap_order(&state.c, heap_order_code);
 
 	pointless_export_py(&state, object);
 
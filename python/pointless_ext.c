@@ -73,7 +73,7 @@ initpointless(void)
 	struct {
 		PyTypeObject* type;
 		const char* name;
-	} types[13] = {
+	} types[16] = {
 		{&PyPointlessType,               "Pointless"               },
 		{&PyPointlessVectorType,         "PointlessVector"         },
 		{&PyPointlessVectorIterType,     "PointlessVectorIter"     },
@@ -85,13 +85,16 @@ initpointless(void)
 		{&PyPointlessMapKeyIterType,     "PointlessMapKeyIter"     },
 		{&PyPointlessMapValueIterType,   "PointlessMapValueIter"   },
 		{&PyPointlessMapItemIterType,    "PointlessMapItemIter"    },
+		{&PyPointlessTableType,          "PointlessTable"          },
+		{&PyPointlessTableRowType,       "PointlessTableRow"       },
+		{&PyPointlessKeyType,            "Key"                     },
 		{&PyPointlessPrimVectorType,     "PointlessPrimVector"     },
 		{&PyPointlessPrimVectorIterType, "PointlessPrimVectorIter" }
 	};
 
 	int i;
 
-	for (i = 0; i < 13; i++) {
+	for (i = 0; i < 16; i++) {
 		if (PyType_Ready(types[i].type) < 0)
 			return;
 
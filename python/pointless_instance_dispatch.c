@@ -93,7 +93,8 @@ static int pointless_value_string_is_7bit(uint8_t* s)
 
 PyObject* pypointless_value_string(pointless_t* p, pointless_value_t* v)
 {
-	uint8_t* string_ascii = pointless_reader_string_value_ascii(p, v);
+	uint8_t buffer[POINTLESS_STRING_SYMBOLS_BUFFER_LEN];
+	uint8_t* string_ascii = pointless_reader_string_value_ascii_buffer(p, v, buffer);
 
 	// if 7-bit, string, otherwise unicode
 	if (pointless_value_string_is_7bit(string_ascii))
@@ -112,6 +113,63 @@ PyObject* pypointless_value_string(pointless_t* p, pointless_value_t* v)
 	// does not
 }
 
+PyObject* pypointless_vector_item(PyPointless* p, pointless_value_t* v, uint32_t i)
+{
+	switch (v->type) {
+		case POINTLESS_VECTOR_VALUE:
+		case POINTLESS_VECTOR_VALUE_HASHABLE:
+			return pypointless_value(p, pointless_reader_vector_value(&p->p, v) + i);
+		case POINTLESS_VECTOR_I8:
+			return pypointless_i32(p, (int32_t)pointless_reader_vector_i8(&p->p, v)[i]);
+		case POINTLESS_VECTOR_U8:
+			return pypointless_u32(p, (uint32_t)pointless_reader_vector_u8(&p->p, v)[i]);
+		case POINTLESS_VECTOR_I16:
+			return pypointless_i32(p, (int32_t)pointless_reader_vector_i16(&p->p, v)[i]);
+		case POINTLESS_VECTOR_U16:
+			return pypointless_u32(p, (uint32_t)pointless_reader_vector_u16(&p->p, v)[i]);
+		case POINTLESS_VECTOR_I32:
+			return pypointless_i32(p, pointless_reader_vector_i32(&p->p, v)[i]);
+		case POINTLESS_VECTOR_U32:
+			return pypointless_u32(p, pointless_reader_vector_u32(&p->p, v)[i]);
+		case POINTLESS_VECTOR_I64:
+			return pypointless_i64(p, pointless_reader_vector_i64(&p->p, v)[i]);
+		case POINTLESS_VECTOR_U64:
+			return pypointless_u64(p, pointless_reader_vector_u64(&p->p, v)[i]);
+		case POINTLESS_VECTOR_FLOAT:
+			return pypointless_float(p, pointless_reader_vector_float(&p->p, v)[i]);
+		// decoded on the fly, their values are never containers or 64-bit integers
+		case POINTLESS_VECTOR_DICTIONARY:
+		case POINTLESS_VECTOR_RUNS:
+		case POINTLESS_VECTOR_SPLIT:
+		{
+			pointless_complete_value_t cv = pointless_reader_vector_value_case(&p->p, v, i);
+			pointless_value_t _v = pointless_value_from_complete(&cv);
+			return pypointless_value(p, &_v);
+		}
+		// decoded on the fly, their items are integers of any width
+		case POINTLESS_VECTOR_BLOCKS:
+		{
+			pointless_complete_value_t cv = pointless_reader_vector_value_case(&p->p, v, i);
+
+			switch (cv.type) {
+				case POINTLESS_I32:
+					return pypointless_i32(p, cv.complete_data.data_i32);
+				case POINTLESS_U32:
+					return pypointless_u32(p, cv.complete_data.data_u32);
+				case POINTLESS_I64:
+					return pypointless_i64(p, cv.complete_data.data_i64);
+				case POINTLESS_U64:
+					return pypointless_u64(p, cv.complete_data.data_u64);
+			}
+
+			break;
+		}
+	}
+
+	PyErr_Format(PyExc_TypeError, "strange array type");
+	return 0;
+}
+
 PyObject* pypointless_value(PyPointless* p, pointless_value_t* v)
 {
 	// create the actual value
@@ -128,9 +186,15 @@ PyObject* pypointless_value(PyPointless* p, pointless_value_t* v)
 		case POINTLESS_VECTOR_U64:
 		case POINTLESS_VECTOR_FLOAT:
 		case POINTLESS_VECTOR_EMPTY:
+		case POINTLESS_VECTOR_DICTIONARY:
+		case POINTLESS_VECTOR_RUNS:
+		case POINTLESS_VECTOR_SPLIT:
+		case POINTLESS_VECTOR_BLOCKS:
 			return (PyObject*)PyPointlessVector_New(p, v, 0, pointless_reader_vector_n_items(&p->p, v));
 
 		case POINTLESS_STRING_:
+		case POINTLESS_STRING_INLINE:
+		case POINTLESS_STRING_SYMBOLS:
 			return pypointless_value_string(&p->p, v);
 
 		case POINTLESS_UNICODE_:
@@ -166,6 +230,9 @@ PyObject* pypointless_value(PyPointless* p, pointless_value_t* v)
 
 		case POINTLESS_MAP_VALUE_VALUE:
 			return (PyObject*)PyPointlessMap_New(p, v);
+
+		case POINTLESS_TABLE:
+			return (PyObject*)PyPointlessTable_New(p, v);
 	}
 
 	PyErr_Format(PyExc_ValueError, "internal error, got strange type ID %u, this file should not have passed validation", (unsigned int)v->type);
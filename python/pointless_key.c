@@ -0,0 +1,186 @@
+#include "pointless/pointless_ext.h"
+
+// str, unicode and int keys, the key data is owned by the Python object
+static int pypointless_prepared_key_init(pointless_prepared_key_t* k, PyObject* py_object)
+{
+	// exact types only, subclasses may override equality, and bool must compare as a boolean
+	if (PyString_CheckExact(py_object)) {
+		pointless_prepared_key_init_string(k, (uint8_t*)PyString_AS_STRING(py_object));
+		return 1;
+	}
+
+	if (PyUnicode_CheckExact(py_object)) {
+#ifdef Py_UNICODE_WIDE
+		pointless_prepared_key_init_unicode_ucs4(k, (uint32_t*)PyUnicode_AS_UNICODE(py_object));
+#else
+		pointless_prepared_key_init_unicode_ucs2(k, (uint16_t*)PyUnicode_AS_UNICODE(py_object));
+#endif
+		return 1;
+	}
+
+	// integers exceeding 32-bits are not hashable, the generic path reports it
+	if (PyInt_CheckExact(py_object))
+		return pointless_prepared_key_init_int(k, (int64_t)PyInt_AS_LONG(py_object));
+
+	return 0;
+}
+
+static int PyPointlessKey_hash(PyPointlessKey* self, uint32_t version, uint32_t* hash)
+{
+	if (!(self->hash_valid & (1 << version))) {
+		const char* error = 0;
+		self->hash[version] = pyobject_hash_32(self->key, version, &error);
+
+		if (error) {
+			PyErr_Format(PyExc_ValueError, "pointless hash error: %s", error);
+			return 0;
+		}
+
+		self->hash_valid |= (1 << version);
+	}
+
+	*hash = self->hash[version];
+	return 1;
+}
+
+int pypointless_lookup_key(PyObject* key, pointless_t* p, pointless_prepared_key_t* local, pointless_prepared_key_t** prepared, PyObject** py_key, uint32_t* hash)
+{
+	if (PyPointlessKey_Check(key)) {
+		PyPointlessKey* k = (PyPointlessKey*)key;
+
+		if (k->is_prepared) {
+			*prepared = &k->prepared;
+			return 1;
+		}
+
+		if (!PyPointlessKey_hash(k, p->version, hash))
+			return -1;
+
+		*py_key = k->key;
+		return 0;
+	}
+
+	if (pypointless_prepared_key_init(local, key)) {
+		*prepared = local;
+		return 1;
+	}
+
+	const char* error = 0;
+	*hash = pyobject_hash_32(key, p->version, &error);
+
+	if (error) {
+		PyErr_Format(PyExc_ValueError, "pointless hash error: %s", error);
+		return -1;
+	}
+
+	*py_key = key;
+	return 0;
+}
+
+static void PyPointlessKey_dealloc(PyPointlessKey* self)
+{
+	Py_XDECREF(self->key);
+	self->key = 0;
+	Py_TYPE(self)->tp_free(self);
+}
+
+static PyObject* PyPointlessKey_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
+{
+	PyPointlessKey* self = (PyPointlessKey*)type->tp_alloc(type, 0);
+
+	if (self) {
+		self->key = 0;
+		self->is_prepared = 0;
+		self->hash_valid = 0;
+	}
+
+	return (PyObject*)self;
+}
+
+static int PyPointlessKey_init(PyPointlessKey* self, PyObject* args, PyObject* kwds)
+{
+	static char* kwargs[] = {"key", 0};
+	PyObject* key = 0;
+	uint32_t hash = 0;
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O:Key", kwargs, &key))
+		return -1;
+
+	// a key of a key is the same key
+	if (PyPointlessKey_Check(key))
+		key = ((PyPointlessKey*)key)->key;
+
+	Py_INCREF(key);
+	Py_XDECREF(self->key);
+	self->key = key;
+	self->hash_valid = 0;
+	self->is_prepared = pypointless_prepared_key_init(&self->prepared, key);
+
+	// reject keys which can never be looked up
+	if (!self->is_prepared && !PyPointlessKey_hash(self, POINTLESS_FILE_FORMAT_LATEST_VERSION_, &hash))
+		return -1;
+
+	return 0;
+}
+
+static PyObject* PyPointlessKey_repr(PyPointlessKey* self)
+{
+	if (self->key == 0)
+		return PyString_FromString("pointless.Key()");
+
+	PyObject* key_repr = PyObject_Repr(self->key);
+
+	if (key_repr == 0)
+		return 0;
+
+	PyObject* repr = PyString_FromFormat("pointless.Key(%s)", PyString_AS_STRING(key_repr));
+	Py_DECREF(key_repr);
+	return repr;
+}
+
+static PyMemberDef PyPointlessKey_memberlist[] = {
+	{"key",  T_OBJECT, offsetof(PyPointlessKey, key), READONLY},
+	{NULL}
+};
+
+PyTypeObject PyPointlessKeyType = {
+	PyObject_HEAD_INIT(NULL)
+	0,                                     /*ob_size*/
+	"pointless.PyPointlessKey",            /*tp_name*/
+	sizeof(PyPointlessKey),                /*tp_basicsize*/
+	0,                                     /*tp_itemsize*/
+	(destructor)PyPointlessKey_dealloc,    /*tp_dealloc*/
+	0,                                     /*tp_print*/
+	0,                                     /*tp_getattr*/
+	0,                                     /*tp_setattr*/
+	0,                                     /*tp_compare*/
+	(reprfunc)PyPointlessKey_repr,         /*tp_repr*/
+	0,                                     /*tp_as_number*/
+	0,                                     /*tp_as_sequence*/
+	0,                                     /*tp_as_mapping*/
+	0,                                     /*tp_hash */
+	0,                                     /*tp_call*/
+	0,                                     /*tp_str*/
+	0,                                     /*tp_getattro*/
+	0,                                     /*tp_setattro*/
+	0,                                     /*tp_as_buffer*/
+	Py_TPFLAGS_DEFAULT,                    /*tp_flags*/
+	"PyPointlessKey wrapper",              /*tp_doc */
+	0,                                     /*tp_traverse */
+	0,                                     /*tp_clear */
+	0,                                     /*tp_richcompare */
+	0,                                     /*tp_weaklistoffset */
+	0,                                     /*tp_iter */
+	0,                                     /*tp_iternext */
+	0,                                     /*tp_methods */
+	PyPointlessKey_memberlist,             /*tp_members */
+	0,                                     /*tp_getset */
+	0,                                     /*tp_base */
+	0,                                     /*tp_dict */
+	0,                                     /*tp_descr_get */
+	0,                                     /*tp_descr_set */
+	0,                                     /*tp_dictoffset */
+	(initproc)PyPointlessKey_init,         /*tp_init */
+	0,                                     /*tp_alloc */
+	PyPointlessKey_new,                    /*tp_new */
+};
@@ -135,17 +135,34 @@ static PyObject* PyPointlessMap_iter(PyObject* map)
 	return (PyObject*)iter;
 }
 
+// keys and values by entry, the key/value vectors may be primitive vectors
+static PyObject* PyPointlessMap_key(PyPointlessMap* m, uint32_t entry)
+{
+	// dense maps hold integer keys, without a key vector
+	if (pointless_reader_map_is_dense(&m->pp->p, m->v)) {
+		pointless_complete_value_t k = pointless_reader_map_key(&m->pp->p, m->v, entry);
+		pointless_value_t v = pointless_value_from_complete(&k);
+		return pypointless_value(m->pp, &v);
+	}
+
+	return pypointless_vector_item(m->pp, pointless_map_key_vector(&m->pp->p, m->v), entry);
+}
+
+static PyObject* PyPointlessMap_value(PyPointlessMap* m, uint32_t entry)
+{
+	return pypointless_vector_item(m->pp, pointless_map_value_vector(&m->pp->p, m->v), entry);
+}
+
 static PyObject* PyPointlessMapKeyIter_iternext(PyPointlessMapKeyIter* iter)
 {
 	// iterator already reached end
 	if (iter->map == 0)
 		return 0;
 
-	pointless_value_t* k = 0;
-	pointless_value_t* v = 0;
+	uint32_t entry = 0;
 
-	if (pointless_reader_map_iter(&iter->map->pp->p, iter->map->v, &k, &v, &iter->iter_state))
-		return pypointless_value(iter->map->pp, k);
+	if (pointless_reader_map_iter_entry(&iter->map->pp->p, iter->map->v, &entry, &iter->iter_state))
+		return PyPointlessMap_key(iter->map, entry);
 
 	Py_DECREF(iter->map);
 	iter->map = 0;
@@ -158,11 +175,10 @@ static PyObject* PyPointlessMapValueIter_iternext(PyPointlessMapValueIter* iter)
 	if (iter->map == 0)
 		return 0;
 
-	pointless_value_t* k = 0;
-	pointless_value_t* v = 0;
+	uint32_t entry = 0;
 
-	if (pointless_reader_map_iter(&iter->map->pp->p, iter->map->v, &k, &v, &iter->iter_state))
-		return pypointless_value(iter->map->pp, v);
+	if (pointless_reader_map_iter_entry(&iter->map->pp->p, iter->map->v, &entry, &iter->iter_state))
+		return PyPointlessMap_value(iter->map, entry);
 
 	Py_DECREF(iter->map);
 	iter->map = 0;
@@ -175,12 +191,11 @@ static PyObject* PyPointlessMapItemIter_iternext(PyPointlessMapItemIter* iter)
 	if (iter->map == 0)
 		return 0;
 
-	pointless_value_t* k = 0;
-	pointless_value_t* v = 0;
+	uint32_t entry = 0;
 
-	if (pointless_reader_map_iter(&iter->map->pp->p, iter->map->v, &k, &v, &iter->iter_state)) {
-		PyObject* kk = pypointless_value(iter->map->pp, k);
-		PyObject* vv = pypointless_value(iter->map->pp, v);
+	if (pointless_reader_map_iter_entry(&iter->map->pp->p, iter->map->v, &entry, &iter->iter_state)) {
+		PyObject* kk = PyPointlessMap_key(iter->map, entry);
+		PyObject* vv = PyPointlessMap_value(iter->map, entry);
 
 		if (kk == 0 || vv == 0) {
 			Py_XDECREF(kk);
@@ -201,27 +216,43 @@ static uint32_t PyPointlessMap_eq_cb(pointless_t* p, pointless_complete_value_t*
 	return pypointless_cmp_eq(p, v, (PyObject*)user, error);
 }
 
-static int PyPointlessMap_contains_(PyPointlessMap* m, PyObject* key)
+// returns 0 and sets a Python exception on failure, *entry is POINTLESS_HASH_TABLE_PROBE_MISS if the key is not in the map
+static int PyPointlessMap_lookup(PyPointlessMap* m, PyObject* key, uint32_t* entry)
 {
+	pointless_t* p = &m->pp->p;
+	pointless_prepared_key_t local;
+	pointless_prepared_key_t* prepared = 0;
+	PyObject* py_key = 0;
+	uint32_t hash = 0;
 	const char* error = 0;
-	uint32_t hash = pyobject_hash_32(key, m->pp->p.header->version, &error);
 
-	if (error) {
-		PyErr_Format(PyExc_ValueError, "pointless hash error: %s", error);
-		return -1;
+	switch (pypointless_lookup_key(key, p, &local, &prepared, &py_key, &hash)) {
+		case -1:
+			return 0;
+		case 1:
+			// prepared keys skip the generic hash and comparison callbacks
+			*entry = pointless_reader_map_probe_prepared(p, m->v, prepared);
+			return 1;
 	}
 
-	pointless_value_t* k = 0;
-	pointless_value_t* v = 0;
-
-	pointless_reader_map_lookup_ext(&m->pp->p, m->v, hash, PyPointlessMap_eq_cb, (void*)key, &k, &v, &error);
+	*entry = pointless_reader_map_probe_ext(p, m->v, hash, PyPointlessMap_eq_cb, (void*)py_key, &error);
 
 	if (error) {
 		PyErr_Format(PyExc_ValueError, "pointless map query error: %s", error);
-		return -1;
+		return 0;
 	}
 
-	return (k != 0);
+	return 1;
+}
+
+static int PyPointlessMap_contains_(PyPointlessMap* m, PyObject* key)
+{
+	uint32_t entry = 0;
+
+	if (!PyPointlessMap_lookup(m, key, &entry))
+		return -1;
+
+	return (entry != POINTLESS_HASH_TABLE_PROBE_MISS);
 }
 
 static PyObject* PyPointlessMap_contains(PyPointlessMap* m, PyObject* k)
@@ -283,30 +314,17 @@ static PyMemberDef PyPointlessMap_memberlist[] = {
 
 static PyObject* PyPointlessMap_subscript(PyPointlessMap* m, PyObject* key)
 {
-	const char* error = 0;
-	uint32_t hash = pyobject_hash_32(key, m->pp->p.header->version, &error);
+	uint32_t entry = 0;
 
-	if (error) {
-		PyErr_Format(PyExc_ValueError, "pointless hash error: %s", error);
+	if (!PyPointlessMap_lookup(m, key, &entry))
 		return 0;
-	}
 
-	pointless_value_t* k = 0;
-	pointless_value_t* v = 0;
-
-	pointless_reader_map_lookup_ext(&m->pp->p, m->v, hash, PyPointlessMap_eq_cb, (void*)key, &k, &v, &error);
-
-	if (error) {
-		PyErr_Format(PyExc_ValueError, "pointless map query error: %s", error);
-		return 0;
-	}
-
-	if (k == 0) {
+	if (entry == POINTLESS_HASH_TABLE_PROBE_MISS) {
 		PyErr_SetObject(PyExc_KeyError, key);
 		return 0;
 	}
 
-	return pypointless_value(m->pp, v);
+	return PyPointlessMap_value(m, entry);
 }
 
 static PyMappingMethods PyPointlessMap_as_mapping = {
@@ -323,30 +341,17 @@ static PyObject* PyPointlessMap_get(PyPointlessMap* m, PyObject* args)
 	if (!PyArg_UnpackTuple(args, "get", 1, 2, &key, &failobj))
 		return NULL;
 
-	const char* error = 0;
-	uint32_t hash = pyobject_hash_32(key, m->pp->p.header->version, &error);
+	uint32_t entry = 0;
 
-	if (error) {
-		PyErr_Format(PyExc_ValueError, "pointless hash error: %s", error);
-		return 0;
-	}
-
-	pointless_value_t* k = 0;
-	pointless_value_t* v = 0;
-
-	pointless_reader_map_lookup_ext(&m->pp->p, m->v, hash, PyPointlessMap_eq_cb, (void*)key, &k, &v, &error);
-
-	if (error) {
-		PyErr_Format(PyExc_ValueError, "pointless map query error: %s", error);
+	if (!PyPointlessMap_lookup(m, key, &entry))
 		return 0;
-	}
 
-	if (v == 0) {
+	if (entry == POINTLESS_HASH_TABLE_PROBE_MISS) {
 		Py_INCREF(failobj);
 		return failobj;
 	}
 
-	return pypointless_value(m->pp, v);
+	return PyPointlessMap_value(m, entry);
 }
 
 #define PyPointlessMap_LIST_TYPE_KEYS 0
@@ -362,23 +367,20 @@ static PyObject* PyPointlessMap_to_list(PyPointlessMap* m, int list_type)
 	if (retval == 0)
 		goto error;
 
-	uint32_t iter_state = 0;
-
-	pointless_value_t* k = 0;
-	pointless_value_t* v = 0;
+	uint32_t iter_state = 0, entry = 0;
 
-	while (pointless_reader_map_iter(&m->pp->p, m->v, &k, &v, &iter_state)) {
+	while (pointless_reader_map_iter_entry(&m->pp->p, m->v, &entry, &iter_state)) {
 		PyObject* item = 0;
 
 		switch (list_type) {
 			case PyPointlessMap_LIST_TYPE_KEYS:
-				item = pypointless_value(m->pp, k);
+				item = PyPointlessMap_key(m, entry);
 				break;
 			case PyPointlessMap_LIST_TYPE_VALUES:
-				item = pypointless_value(m->pp, v);
+				item = PyPointlessMap_value(m, entry);
 				break;
 			case PyPointlessMap_LIST_TYPE_ITEMS:
-				item = Py_BuildValue("(NN)", pypointless_value(m->pp, k), pypointless_value(m->pp, v));
+				item = Py_BuildValue("(NN)", PyPointlessMap_key(m, entry), PyPointlessMap_value(m, entry));
 				break;
 			default:
 				PyErr_SetString(PyExc_ValueError, "PyPointlessMap_to_list(): internal error");
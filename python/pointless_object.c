@@ -96,11 +96,115 @@ static PyObject* PyPointless_sizeof(PyPointless* self)
 		return PyLong_FromUnsignedLongLong(sizeof(PyPointless) + self->p.fd_len);
 }
 
+static PyObject* PyPointless_StartTrace(PyPointless* self, PyObject* args, PyObject* kwds)
+{
+	unsigned long long max_containers = 0;
+	const char* error = 0;
+	static char* kwargs[] = {"max_containers", 0};
+
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "|K", kwargs, &max_containers))
+		return 0;
+
+	if (!pointless_trace_begin(&self->p, max_containers, &error)) {
+		PyErr_Format(PyExc_ValueError, "error starting trace: %s", error);
+		return 0;
+	}
+
+	Py_RETURN_NONE;
+}
+
+static PyObject* PyPointless_WriteTrace(PyPointless* self, PyObject* args)
+{
+	const char* fname = 0;
+	const char* error = 0;
+	int i;
+
+	if (!PyArg_ParseTuple(args, "s", &fname))
+		return 0;
+
+	// the GIL is kept, StopTrace() frees the trace
+	i = pointless_trace_write_f(&self->p, fname, &error);
+
+	if (!i) {
+		PyErr_Format(PyExc_IOError, "error writing trace [%s]: %s", fname, error);
+		return 0;
+	}
+
+	Py_RETURN_NONE;
+}
+
+static PyObject* PyPointless_StopTrace(PyPointless* self)
+{
+	pointless_trace_end(&self->p);
+	Py_RETURN_NONE;
+}
+
+static PyObject* PyPointless_GetAnatomy(PyPointless* self)
+{
+	pointless_anatomy_t a;
+	const char* error = 0;
+	uint32_t i;
+	int ok;
+
+	// the GIL is kept, the walk may record into a trace StopTrace() frees
+	ok = pointless_anatomy(&self->p, &a, &error);
+
+	if (!ok) {
+		PyErr_Format(PyExc_ValueError, "error in anatomy: %s", error);
+		return 0;
+	}
+
+	PyObject* n_bytes = PyDict_New();
+	PyObject* n_objects = PyDict_New();
+	PyObject* entries = PyList_New(a.n_entries);
+	PyObject* anatomy = 0;
+
+	if (n_bytes == 0 || n_objects == 0 || entries == 0)
+		goto cleanup;
+
+	for (i = 0; i < POINTLESS_ANATOMY_N_CATEGORIES; i++) {
+		PyObject* b = PyLong_FromUnsignedLongLong(a.n_bytes[i]);
+		PyObject* o = PyLong_FromUnsignedLongLong(a.n_objects[i]);
+
+		ok = (b && o && PyDict_SetItemString(n_bytes, pointless_anatomy_category_name(i), b) == 0 && PyDict_SetItemString(n_objects, pointless_anatomy_category_name(i), o) == 0);
+
+		Py_XDECREF(b);
+		Py_XDECREF(o);
+
+		if (!ok)
+			goto cleanup;
+	}
+
+	// (key, bytes) of each root map entry, in iteration order
+	for (i = 0; i < a.n_entries; i++) {
+		pointless_value_t key = pointless_value_from_complete(&a.entries[i].key);
+		PyObject* entry = Py_BuildValue("(NK)", pypointless_value(self, &key), (unsigned long long)a.entries[i].n_bytes);
+
+		if (entry == 0)
+			goto cleanup;
+
+		PyList_SET_ITEM(entries, i, entry);
+	}
+
+	anatomy = Py_BuildValue("{sOsOsO}", "bytes", n_bytes, "objects", n_objects, "entries", entries);
+
+cleanup:
+	Py_XDECREF(n_bytes);
+	Py_XDECREF(n_objects);
+	Py_XDECREF(entries);
+	pointless_anatomy_free(&a);
+	return anatomy;
+}
+
 static PyMethodDef PyPointless_methods[] = {
 	{"__sizeof__", (PyCFunction)PyPointless_sizeof,   METH_NOARGS, "get size in bytes of backing file or buffer"},
 	{"GetRoot",    (PyCFunction)PyPointless_GetRoot,  METH_NOARGS, "get pointless root object" },
 	{"GetINode",   (PyCFunction)PyPointless_GetINode, METH_NOARGS, "get inode of file descriptor" },
 	{"GetRefs",    (PyCFunction)PyPointless_GetRefs,  METH_NOARGS, "get inside-reference count to base object" },
+	{"StartTrace", (PyCFunction)PyPointless_StartTrace, METH_VARARGS | METH_KEYWORDS, "record the containers accessed, in order of first access, up to max_containers (0 for all)" },
+	{"WriteTrace", (PyCFunction)PyPointless_WriteTrace, METH_VARARGS, "write the trace to a file, for prefetch=..." },
+	{"StopTrace",  (PyCFunction)PyPointless_StopTrace,  METH_NOARGS, "stop recording" },
+	{"GetAnatomy", (PyCFunction)PyPointless_GetAnatomy, METH_NOARGS, "bytes and objects of the file by category, and the bytes reachable from each root map entry, in a dict: {'bytes': {category: n}, 'objects': {category: n}, 'entries': [(key, n)]}" },
 	{NULL}
 };
 
@@ -143,9 +247,10 @@ static int PyPointless_init(PyPointless* self, PyObject* args, PyObject* kwds)
 	self->n_set_refs = 0;
 
 	PyObject* allow_print = Py_True;
-	static char* kwargs[] = {"filename_or_buffer", "allow_print", 0};
+	const char* prefetch = 0;
+	static char* kwargs[] = {"filename_or_buffer", "allow_print", "prefetch", 0};
 
-	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O!", kwargs, &fname_or_buffer, &PyBool_Type, &allow_print))
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O!z", kwargs, &fname_or_buffer, &PyBool_Type, &allow_print, &prefetch))
 		return -1;
 
 	if (allow_print == Py_False)
@@ -205,6 +310,13 @@ static int PyPointless_init(PyPointless* self, PyObject* args, PyObject* kwds)
 	Py_XDECREF(string_of_unicode);
 
 	self->is_open = 1;
+
+	// prefetching is a background thread, it is stopped when the file is closed
+	if (prefetch && !pointless_prefetch_f(&self->p, prefetch, &error)) {
+		PyErr_Format(PyExc_IOError, "error prefetching from [%s]: %s", prefetch, error);
+		return -1;
+	}
+
 	return 0;
 }
 
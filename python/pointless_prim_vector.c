@@ -1166,7 +1166,6 @@ static PyBufferProcs PointlessPrimVector_as_buffer = {
 
 #define SORT_SWAP(T, B, I_A, I_B) T t = ((T*)(B))[I_A]; ((T*)(B))[I_A] = ((T*)(B))[I_B]; ((T*)(B))[I_B] = t
 #define PRIM_SORT_SWAP(T, P, I_A, I_B) SORT_SWAP(T, ((PyPointlessPrimVector*)P)->array._data, I_A, I_B)
-#define PROJ_SORT_SWAP(T, P, I_A, I_B) SORT_SWAP(T, ((prim_sort_proj_state_t*)P)->p_b, I_A, I_B)
 
 #define SORT_CMP(T, B, I_A, I_B) SIMPLE_CMP(((T*)(B))[I_A], ((T*)(B))[I_B])
 #define SORT_CMP_RET(T, B, I_A, I_B) *c = SORT_CMP(T, B, I_A, I_B); return 1
@@ -1242,9 +1241,11 @@ static PyObject* PyPointlessPrimVector_sort(PyPointlessPrimVector* self)
 	return Py_None;
 }
 
-typedef void (*prim_sort_proj_cmp_index_t)(int a, int b, uint64_t* i_a, uint64_t* i_b, void* p_b);
-typedef int (*prim_sort_proj_cmp_cmp_t)(uint64_t a, uint64_t b, void* v_b);
-
+// projection sort
+//
+// the value vectors are encoded into order preserving unsigned keys, and packed, most
+// significant vector first, into 64-bit words. the words are then sorted with an LSD radix
+// argsort, last word first, which makes the projection sort stable
 typedef struct {
 	// the projection
 	void* p_b;     // base pointer
@@ -1257,86 +1258,244 @@ typedef struct {
 	PyObject* v_p[16]; // Python objects
 	void* v_b[16];     // base pointers
 	uint32_t v_n[16];  // number of items
-	uint32_t v_t[16];  // item types
-
-	// comparison info
-	prim_sort_proj_cmp_index_t cmp_index;
-	prim_sort_proj_cmp_cmp_t cmp_cmp[16];
+	uint32_t v_t[16];  // item types (POINTLESS_PRIM_VECTOR_TYPE_*)
 } prim_sort_proj_state_t;
 
-static void prim_sort_proj_swap_i8(int a, int b, void* user)
-	{ PROJ_SORT_SWAP(int8_t, user, a, b); }
-static void prim_sort_proj_swap_u8(int a, int b, void* user)
-	{ PROJ_SORT_SWAP(uint8_t, user, a, b); }
-static void prim_sort_proj_swap_i16(int a, int b, void* user)
-	{ PROJ_SORT_SWAP(int16_t, user, a, b); }
-static void prim_sort_proj_swap_u16(int a, int b, void* user)
-	{ PROJ_SORT_SWAP(uint16_t, user, a, b); }
-static void prim_sort_proj_swap_i32(int a, int b, void* user)
-	{ PROJ_SORT_SWAP(int32_t, user, a, b); }
-static void prim_sort_proj_swap_u32(int a, int b, void* user)
-	{ PROJ_SORT_SWAP(uint32_t, user, a, b); }
-static void prim_sort_proj_swap_i64(int a, int b, void* user)
-	{ PROJ_SORT_SWAP(int64_t, user, a, b); }
-static void prim_sort_proj_swap_u64(int a, int b, void* user)
-	{ PROJ_SORT_SWAP(uint64_t, user, a, b); }
-
-#define prim_sort_proj_cmp_index_(T, a, b, i_a, i_b, p_b) *(i_a) = ((T*)(p_b))[a]; *(i_b) = ((T*)(p_b))[b];
-
-static void prim_sort_proj_cmp_index_i8(int a, int b, uint64_t* i_a, uint64_t* i_b, void* p_b)
-	{ prim_sort_proj_cmp_index_(int8_t, a, b, i_a, i_b, p_b); }
-static void prim_sort_proj_cmp_index_u8(int a, int b, uint64_t* i_a, uint64_t* i_b, void* p_b)
-	{ prim_sort_proj_cmp_index_(uint8_t, a, b, i_a, i_b, p_b); }
-static void prim_sort_proj_cmp_index_i16(int a, int b, uint64_t* i_a, uint64_t* i_b, void* p_b)
-	{ prim_sort_proj_cmp_index_(int16_t, a, b, i_a, i_b, p_b); }
-static void prim_sort_proj_cmp_index_u16(int a, int b, uint64_t* i_a, uint64_t* i_b, void* p_b)
-	{ prim_sort_proj_cmp_index_(uint16_t, a, b, i_a, i_b, p_b); }
-static void prim_sort_proj_cmp_index_i32(int a, int b, uint64_t* i_a, uint64_t* i_b, void* p_b)
-	{ prim_sort_proj_cmp_index_(int32_t, a, b, i_a, i_b, p_b); }
-static void prim_sort_proj_cmp_index_u32(int a, int b, uint64_t* i_a, uint64_t* i_b, void* p_b)
-	{ prim_sort_proj_cmp_index_(uint32_t, a, b, i_a, i_b, p_b); }
-static void prim_sort_proj_cmp_index_i64(int a, int b, uint64_t* i_a, uint64_t* i_b, void* p_b)
-	{ prim_sort_proj_cmp_index_(int64_t, a, b, i_a, i_b, p_b); }
-static void prim_sort_proj_cmp_index_u64(int a, int b, uint64_t* i_a, uint64_t* i_b, void* p_b)
-	{ prim_sort_proj_cmp_index_(uint64_t, a, b, i_a, i_b, p_b); }
-
-static int prim_sort_proj_cmp_cmp_i8(uint64_t a, uint64_t b, void* v_b)
-	{ return SORT_CMP(int8_t, v_b, a, b); }
-static int prim_sort_proj_cmp_cmp_u8(uint64_t a, uint64_t b, void* v_b)
-	{ return SORT_CMP(uint8_t, v_b, a, b); }
-static int prim_sort_proj_cmp_cmp_i16(uint64_t a, uint64_t b, void* v_b)
-	{ return SORT_CMP(int16_t, v_b, a, b); }
-static int prim_sort_proj_cmp_cmp_u16(uint64_t a, uint64_t b, void* v_b)
-	{ return SORT_CMP(uint16_t, v_b, a, b); }
-static int prim_sort_proj_cmp_cmp_i32(uint64_t a, uint64_t b, void* v_b)
-	{ return SORT_CMP(int32_t, v_b, a, b); }
-static int prim_sort_proj_cmp_cmp_u32(uint64_t a, uint64_t b, void* v_b)
-	{ return SORT_CMP(uint32_t, v_b, a, b); }
-static int prim_sort_proj_cmp_cmp_i64(uint64_t a, uint64_t b, void* v_b)
-	{ return SORT_CMP(int64_t, v_b, a, b); }
-static int prim_sort_proj_cmp_cmp_u64(uint64_t a, uint64_t b, void* v_b)
-	{ return SORT_CMP(uint64_t, v_b, a, b); }
-static int prim_sort_proj_cmp_cmp_f(uint64_t a, uint64_t b, void* v_b)
-	{ return SORT_CMP(float, v_b, a, b); }
-
-static int prim_sort_proj_cmp(int a, int b, int* c, void* user)
-{
-	prim_sort_proj_state_t* state = (prim_sort_proj_state_t*)user;
-
-	uint64_t i_a_u, i_b_u;
+// radix sort state, keys and projection indices are double buffered
+typedef struct {
+	uint32_t n;
+	uint32_t cur;
+	uint64_t* keys[2];
+	uint32_t* idx[2];
+} prim_sort_proj_radix_t;
 
-	uint32_t i;
+static uint32_t prim_sort_proj_key_bits(uint32_t t)
+{
+	switch (t) {
+		case POINTLESS_PRIM_VECTOR_TYPE_I8:
+		case POINTLESS_PRIM_VECTOR_TYPE_U8:
+			return 8;
+		case POINTLESS_PRIM_VECTOR_TYPE_I16:
+		case POINTLESS_PRIM_VECTOR_TYPE_U16:
+			return 16;
+		case POINTLESS_PRIM_VECTOR_TYPE_I32:
+		case POINTLESS_PRIM_VECTOR_TYPE_U32:
+		case POINTLESS_PRIM_VECTOR_TYPE_FLOAT:
+			return 32;
+		case POINTLESS_PRIM_VECTOR_TYPE_I64:
+		case POINTLESS_PRIM_VECTOR_TYPE_U64:
+			return 64;
+	}
+
+	return 0;
+}
+
+static uint32_t prim_sort_proj_float_key(float f)
+{
+	union {
+		float f;
+		uint32_t u;
+	} v;
+
+	v.f = f;
 
-	(*state->cmp_index)(a, b, &i_a_u, &i_b_u, state->p_b);
+	// -0.0 and 0.0 are equal
+	if (v.u == 0x80000000)
+		v.u = 0;
 
-	*c = 0;
+	// negative values are reversed, positive values are moved above them
+	return (v.u & 0x80000000) ? ~v.u : (v.u | 0x80000000);
+}
+
+#define PRIM_SORT_PROJ_IN_BOUNDS_I(T) for (i = 0; i < state->p_n; i++) { if (((T*)state->p_b)[i] < 0 || (uint64_t)((T*)state->p_b)[i] >= n) return 0; } break
+#define PRIM_SORT_PROJ_IN_BOUNDS_U(T) for (i = 0; i < state->p_n; i++) { if ((uint64_t)((T*)state->p_b)[i] >= n) return 0; } break
+
+static int prim_sort_proj_in_bounds(prim_sort_proj_state_t* state)
+{
+	uint64_t n = state->v_n[0];
+	uint32_t i;
 
-	for (i = 0; i < state->n && *c == 0; i++)
-		*c = (*(state->cmp_cmp[i]))(i_a_u, i_b_u, state->v_b[i]);
+	switch (state->p_t) {
+		case POINTLESS_PRIM_VECTOR_TYPE_I8:  PRIM_SORT_PROJ_IN_BOUNDS_I(int8_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_U8:  PRIM_SORT_PROJ_IN_BOUNDS_U(uint8_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_I16: PRIM_SORT_PROJ_IN_BOUNDS_I(int16_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_U16: PRIM_SORT_PROJ_IN_BOUNDS_U(uint16_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_I32: PRIM_SORT_PROJ_IN_BOUNDS_I(int32_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_U32: PRIM_SORT_PROJ_IN_BOUNDS_U(uint32_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_I64: PRIM_SORT_PROJ_IN_BOUNDS_I(int64_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_U64: PRIM_SORT_PROJ_IN_BOUNDS_U(uint64_t);
+		default:
+			return 0;
+	}
 
 	return 1;
 }
 
+// all projection values are inside [0, v_n[0][, so they fit in 32 bits
+#define PRIM_SORT_PROJ_LOAD(T) for (i = 0; i < state->p_n; i++) { idx[i] = (uint32_t)((T*)state->p_b)[i]; } break
+#define PRIM_SORT_PROJ_STORE(T) for (i = 0; i < state->p_n; i++) { ((T*)state->p_b)[i] = (T)idx[i]; } break
+
+static void prim_sort_proj_load(prim_sort_proj_state_t* state, uint32_t* idx)
+{
+	uint32_t i;
+
+	switch (state->p_t) {
+		case POINTLESS_PRIM_VECTOR_TYPE_I8:  PRIM_SORT_PROJ_LOAD(int8_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_U8:  PRIM_SORT_PROJ_LOAD(uint8_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_I16: PRIM_SORT_PROJ_LOAD(int16_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_U16: PRIM_SORT_PROJ_LOAD(uint16_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_I32: PRIM_SORT_PROJ_LOAD(int32_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_U32: PRIM_SORT_PROJ_LOAD(uint32_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_I64: PRIM_SORT_PROJ_LOAD(int64_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_U64: PRIM_SORT_PROJ_LOAD(uint64_t);
+	}
+}
+
+static void prim_sort_proj_store(prim_sort_proj_state_t* state, uint32_t* idx)
+{
+	uint32_t i;
+
+	switch (state->p_t) {
+		case POINTLESS_PRIM_VECTOR_TYPE_I8:  PRIM_SORT_PROJ_STORE(int8_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_U8:  PRIM_SORT_PROJ_STORE(uint8_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_I16: PRIM_SORT_PROJ_STORE(int16_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_U16: PRIM_SORT_PROJ_STORE(uint16_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_I32: PRIM_SORT_PROJ_STORE(int32_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_U32: PRIM_SORT_PROJ_STORE(uint32_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_I64: PRIM_SORT_PROJ_STORE(int64_t);
+		case POINTLESS_PRIM_VECTOR_TYPE_U64: PRIM_SORT_PROJ_STORE(uint64_t);
+	}
+}
+
+// append the encoded value vector items to the keys, 64-bit vectors always have a key to themselves
+#define PRIM_SORT_PROJ_GATHER(T, BITS, X) for (i = 0; i < r->n; i++) { keys[i] = (keys[i] << BITS) | (uint64_t)(((T*)b)[idx[i]] ^ X); } break
+#define PRIM_SORT_PROJ_GATHER_64(X) for (i = 0; i < r->n; i++) { keys[i] = ((uint64_t*)b)[idx[i]] ^ X; } break
+
+static void prim_sort_proj_gather(prim_sort_proj_radix_t* r, void* b, uint32_t t)
+{
+	uint64_t* keys = r->keys[r->cur];
+	uint32_t* idx = r->idx[r->cur];
+	uint32_t i;
+
+	switch (t) {
+		case POINTLESS_PRIM_VECTOR_TYPE_I8:  PRIM_SORT_PROJ_GATHER(uint8_t,  8,  0x80);
+		case POINTLESS_PRIM_VECTOR_TYPE_U8:  PRIM_SORT_PROJ_GATHER(uint8_t,  8,  0);
+		case POINTLESS_PRIM_VECTOR_TYPE_I16: PRIM_SORT_PROJ_GATHER(uint16_t, 16, 0x8000);
+		case POINTLESS_PRIM_VECTOR_TYPE_U16: PRIM_SORT_PROJ_GATHER(uint16_t, 16, 0);
+		case POINTLESS_PRIM_VECTOR_TYPE_I32: PRIM_SORT_PROJ_GATHER(uint32_t, 32, 0x80000000);
+		case POINTLESS_PRIM_VECTOR_TYPE_U32: PRIM_SORT_PROJ_GATHER(uint32_t, 32, 0);
+		case POINTLESS_PRIM_VECTOR_TYPE_I64: PRIM_SORT_PROJ_GATHER_64(0x8000000000000000ULL);
+		case POINTLESS_PRIM_VECTOR_TYPE_U64: PRIM_SORT_PROJ_GATHER_64(0);
+		case POINTLESS_PRIM_VECTOR_TYPE_FLOAT:
+			for (i = 0; i < r->n; i++)
+				keys[i] = (keys[i] << 32) | (uint64_t)prim_sort_proj_float_key(((float*)b)[idx[i]]);
+			break;
+	}
+}
+
+// stable LSD radix sort on the lowest n_bits of the keys, one byte at a time
+static void prim_sort_proj_radix_pass(prim_sort_proj_radix_t* r, uint32_t n_bits)
+{
+	uint32_t counts[8][256];
+	uint32_t n_digits = (n_bits + 7) / 8;
+	uint32_t i, d, j, c, s;
+
+	uint64_t* keys = r->keys[r->cur];
+
+	memset(counts, 0, sizeof(counts));
+
+	// histograms for all digits at once, they do not depend on the order of the keys
+	for (i = 0; i < r->n; i++) {
+		for (d = 0; d < n_digits; d++)
+			counts[d][(keys[i] >> (d * 8)) & 0xFF] += 1;
+	}
+
+	for (d = 0; d < n_digits; d++) {
+		uint64_t* k_in = r->keys[r->cur];
+		uint64_t* k_out = r->keys[!r->cur];
+		uint32_t* i_in = r->idx[r->cur];
+		uint32_t* i_out = r->idx[!r->cur];
+
+		// if all keys share this digit, the pass would not move anything
+		if (counts[d][(k_in[0] >> (d * 8)) & 0xFF] == r->n)
+			continue;
+
+		for (j = 0, s = 0; j < 256; j++) {
+			c = counts[d][j];
+			counts[d][j] = s;
+			s += c;
+		}
+
+		for (i = 0; i < r->n; i++) {
+			j = (k_in[i] >> (d * 8)) & 0xFF;
+			c = counts[d][j]++;
+			k_out[c] = k_in[i];
+			i_out[c] = i_in[i];
+		}
+
+		r->cur = !r->cur;
+	}
+}
+
+// returns 0 iff we ran out of memory, does not need the GIL
+static int prim_sort_proj_radix(prim_sort_proj_state_t* state)
+{
+	prim_sort_proj_radix_t r;
+	uint32_t i, g_begin, g_end, g_bits, bits;
+	int retval = 0;
+
+	r.n = state->p_n;
+	r.cur = 0;
+	r.keys[0] = (uint64_t*)pointless_malloc(sizeof(uint64_t) * r.n);
+	r.keys[1] = (uint64_t*)pointless_malloc(sizeof(uint64_t) * r.n);
+	r.idx[0] = (uint32_t*)pointless_malloc(sizeof(uint32_t) * r.n);
+	r.idx[1] = (uint32_t*)pointless_malloc(sizeof(uint32_t) * r.n);
+
+	if (r.keys[0] == 0 || r.keys[1] == 0 || r.idx[0] == 0 || r.idx[1] == 0)
+		goto cleanup;
+
+	prim_sort_proj_load(state, r.idx[0]);
+
+	// pack value vectors into 64-bit key groups, and sort from the least significant group
+	g_end = state->n;
+
+	while (g_end > 0) {
+		g_begin = g_end;
+		g_bits = 0;
+
+		while (g_begin > 0) {
+			bits = prim_sort_proj_key_bits(state->v_t[g_begin - 1]);
+
+			if (g_bits + bits > 64)
+				break;
+
+			g_bits += bits;
+			g_begin -= 1;
+		}
+
+		memset(r.keys[r.cur], 0, sizeof(uint64_t) * r.n);
+
+		for (i = g_begin; i < g_end; i++)
+			prim_sort_proj_gather(&r, state->v_b[i], state->v_t[i]);
+
+		prim_sort_proj_radix_pass(&r, g_bits);
+
+		g_end = g_begin;
+	}
+
+	prim_sort_proj_store(state, r.idx[r.cur]);
+
+	retval = 1;
+
+cleanup:
+	pointless_free(r.keys[0]);
+	pointless_free(r.keys[1]);
+	pointless_free(r.idx[0]);
+	pointless_free(r.idx[1]);
+
+	return retval;
+}
+
 static PyObject* PyPointlessPrimVector_sort_proj(PyPointlessPrimVector* self, PyObject* args)
 {
 	// initialize sort state
@@ -1371,14 +1530,15 @@ static PyObject* PyPointlessPrimVector_sort_proj(PyPointlessPrimVector* self, Py
 
 	// it must contain integer values
 	switch (self->type) {
-		case POINTLESS_PRIM_VECTOR_TYPE_I8:  state.cmp_index = prim_sort_proj_cmp_index_i8;  break;
-		case POINTLESS_PRIM_VECTOR_TYPE_U8:  state.cmp_index = prim_sort_proj_cmp_index_u8;  break;
-		case POINTLESS_PRIM_VECTOR_TYPE_I16: state.cmp_index = prim_sort_proj_cmp_index_i16; break;
-		case POINTLESS_PRIM_VECTOR_TYPE_U16: state.cmp_index = prim_sort_proj_cmp_index_u16; break;
-		case POINTLESS_PRIM_VECTOR_TYPE_I32: state.cmp_index = prim_sort_proj_cmp_index_i32; break;
-		case POINTLESS_PRIM_VECTOR_TYPE_U32: state.cmp_index = prim_sort_proj_cmp_index_u32; break;
-		case POINTLESS_PRIM_VECTOR_TYPE_I64: state.cmp_index = prim_sort_proj_cmp_index_i64; break;
-		case POINTLESS_PRIM_VECTOR_TYPE_U64: state.cmp_index = prim_sort_proj_cmp_index_u64; break;
+		case POINTLESS_PRIM_VECTOR_TYPE_I8:
+		case POINTLESS_PRIM_VECTOR_TYPE_U8:
+		case POINTLESS_PRIM_VECTOR_TYPE_I16:
+		case POINTLESS_PRIM_VECTOR_TYPE_U16:
+		case POINTLESS_PRIM_VECTOR_TYPE_I32:
+		case POINTLESS_PRIM_VECTOR_TYPE_U32:
+		case POINTLESS_PRIM_VECTOR_TYPE_I64:
+		case POINTLESS_PRIM_VECTOR_TYPE_U64:
+			break;
 		case POINTLESS_PRIM_VECTOR_TYPE_FLOAT:
 			PyErr_SetString(PyExc_ValueError, "projection vector must contain only integer values");
 			goto cleanup;
@@ -1395,66 +1555,57 @@ static PyObject* PyPointlessPrimVector_sort_proj(PyPointlessPrimVector* self, Py
 			state.v_n[state.n] = pointless_dynarray_n_items(&ppv->array);
 			state.v_t[state.n] = ppv->type;
 
-			switch (ppv->type) {
-				case POINTLESS_PRIM_VECTOR_TYPE_I8:    state.cmp_cmp[state.n] = prim_sort_proj_cmp_cmp_i8;  break;
-				case POINTLESS_PRIM_VECTOR_TYPE_U8:    state.cmp_cmp[state.n] = prim_sort_proj_cmp_cmp_u8;  break;
-				case POINTLESS_PRIM_VECTOR_TYPE_I16:   state.cmp_cmp[state.n] = prim_sort_proj_cmp_cmp_i16; break;
-				case POINTLESS_PRIM_VECTOR_TYPE_U16:   state.cmp_cmp[state.n] = prim_sort_proj_cmp_cmp_u16; break;
-				case POINTLESS_PRIM_VECTOR_TYPE_I32:   state.cmp_cmp[state.n] = prim_sort_proj_cmp_cmp_i32; break;
-				case POINTLESS_PRIM_VECTOR_TYPE_U32:   state.cmp_cmp[state.n] = prim_sort_proj_cmp_cmp_u32; break;
-				case POINTLESS_PRIM_VECTOR_TYPE_I64:   state.cmp_cmp[state.n] = prim_sort_proj_cmp_cmp_i64; break;
-				case POINTLESS_PRIM_VECTOR_TYPE_U64:   state.cmp_cmp[state.n] = prim_sort_proj_cmp_cmp_u64; break;
-				case POINTLESS_PRIM_VECTOR_TYPE_FLOAT: state.cmp_cmp[state.n] = prim_sort_proj_cmp_cmp_f;   break;
-				default:
-					PyErr_BadInternalCall();
-					goto cleanup;
+			if (prim_sort_proj_key_bits(ppv->type) == 0) {
+				PyErr_BadInternalCall();
+				goto cleanup;
 			}
 		} else if (PyPointlessVector_Check(state.v_p[state.n])) {
 			PyPointlessVector* pv = (PyPointlessVector*)state.v_p[state.n];
 
 			state.v_n[state.n] = pv->slice_n;
-			state.v_t[state.n] = pv->v->type;
 
 			switch (pv->v->type) {
 				// we only want primitive types, or empty vectors
 				case POINTLESS_VECTOR_I8:
 					state.v_b[state.n] = (void*)(pointless_reader_vector_i8(&pv->pp->p, pv->v)    + pv->slice_i);
-					state.cmp_cmp[state.n] = prim_sort_proj_cmp_cmp_i8;
+					state.v_t[state.n] = POINTLESS_PRIM_VECTOR_TYPE_I8;
 					break;
 				case POINTLESS_VECTOR_U8:
 					state.v_b[state.n] = (void*)(pointless_reader_vector_u8(&pv->pp->p, pv->v)    + pv->slice_i);
-					state.cmp_cmp[state.n] = prim_sort_proj_cmp_cmp_u8;
+					state.v_t[state.n] = POINTLESS_PRIM_VECTOR_TYPE_U8;
 					break;
 				case POINTLESS_VECTOR_I16:
 					state.v_b[state.n] = (void*)(pointless_reader_vector_i16(&pv->pp->p, pv->v)   + pv->slice_i);
-					state.cmp_cmp[state.n] = prim_sort_proj_cmp_cmp_i16;
+					state.v_t[state.n] = POINTLESS_PRIM_VECTOR_TYPE_I16;
 					break;
 				case POINTLESS_VECTOR_U16:
 					state.v_b[state.n] = (void*)(pointless_reader_vector_u16(&pv->pp->p, pv->v)   + pv->slice_i);
-					state.cmp_cmp[state.n] = prim_sort_proj_cmp_cmp_u16;
+					state.v_t[state.n] = POINTLESS_PRIM_VECTOR_TYPE_U16;
 					break;
 				case POINTLESS_VECTOR_I32:
 					state.v_b[state.n] = (void*)(pointless_reader_vector_i32(&pv->pp->p, pv->v)   + pv->slice_i);
-					state.cmp_cmp[state.n] = prim_sort_proj_cmp_cmp_i32;
+					state.v_t[state.n] = POINTLESS_PRIM_VECTOR_TYPE_I32;
 					break;
 				case POINTLESS_VECTOR_U32:
 					state.v_b[state.n] = (void*)(pointless_reader_vector_u32(&pv->pp->p, pv->v)   + pv->slice_i);
-					state.cmp_cmp[state.n] = prim_sort_proj_cmp_cmp_u32;
+					state.v_t[state.n] = POINTLESS_PRIM_VECTOR_TYPE_U32;
 					break;
 				case POINTLESS_VECTOR_I64:
 					state.v_b[state.n] = (void*)(pointless_reader_vector_i64(&pv->pp->p, pv->v)   + pv->slice_i);
-					state.cmp_cmp[state.n] = prim_sort_proj_cmp_cmp_i64;
+					state.v_t[state.n] = POINTLESS_PRIM_VECTOR_TYPE_I64;
 					break;
 				case POINTLESS_VECTOR_U64:
 					state.v_b[state.n] = (void*)(pointless_reader_vector_u64(&pv->pp->p, pv->v)   + pv->slice_i);
-					state.cmp_cmp[state.n] = prim_sort_proj_cmp_cmp_u64;
+					state.v_t[state.n] = POINTLESS_PRIM_VECTOR_TYPE_U64;
 					break;
 				case POINTLESS_VECTOR_FLOAT:
 					state.v_b[state.n] = (void*)(pointless_reader_vector_float(&pv->pp->p, pv->v) + pv->slice_i);
-					state.cmp_cmp[state.n] = prim_sort_proj_cmp_cmp_f;
+					state.v_t[state.n] = POINTLESS_PRIM_VECTOR_TYPE_FLOAT;
 					break;
 				case POINTLESS_VECTOR_EMPTY:
+					// never read, the projection is either empty or out of bounds
 					state.v_b[state.n] = 0;
+					state.v_t[state.n] = POINTLESS_PRIM_VECTOR_TYPE_U8;
 					break;
 				case POINTLESS_VECTOR_VALUE:
 				case POINTLESS_VECTOR_VALUE_HASHABLE:
@@ -1484,52 +1635,32 @@ static PyObject* PyPointlessPrimVector_sort_proj(PyPointlessPrimVector* self, Py
 	if (state.p_n == 0)
 		goto cleanup;
 
-	// true iff: we are inside bounds
-	int in_bounds = 1;
+	// true iff: we are inside bounds, and had enough memory
+	int in_bounds = 0;
+	int sorted = 0;
 
-	{
-		// find min/max values in projection
-		int64_t p_min = 0;
-		uint64_t p_max = 0;
-
-		for (i = 0; i < state.p_n; i++) {
-			int64_t v_a = 0;
-			uint64_t v_b = 0;
-
-			switch (state.p_t) {
-				case POINTLESS_PRIM_VECTOR_TYPE_I8:  v_a = ((int8_t*)state.p_b)[i]; break;
-				case POINTLESS_PRIM_VECTOR_TYPE_U8:  v_b = ((uint8_t*)state.p_b)[i]; break;
-				case POINTLESS_PRIM_VECTOR_TYPE_I16: v_a = ((int16_t*)state.p_b)[i]; break;
-				case POINTLESS_PRIM_VECTOR_TYPE_U16: v_b = ((uint16_t*)state.p_b)[i]; break;
-				case POINTLESS_PRIM_VECTOR_TYPE_I32: v_a = ((int32_t*)state.p_b)[i]; break;
-				case POINTLESS_PRIM_VECTOR_TYPE_U32: v_b = ((uint32_t*)state.p_b)[i]; break;
-				case POINTLESS_PRIM_VECTOR_TYPE_I64: v_a = ((int64_t*)state.p_b)[i]; break;
-				case POINTLESS_PRIM_VECTOR_TYPE_U64: v_b = ((uint64_t*)state.p_b)[i]; break;
-			}
+	// the sort runs without the GIL, so the prim-vectors must not be re-sized meanwhile
+	self->ob_exports++;
 
-			if (i == 0 || v_a < p_min)
-				p_min = v_a;
+	for (i = 0; i < state.n; i++) {
+		if (PyPointlessPrimVector_Check(state.v_p[i]))
+			((PyPointlessPrimVector*)state.v_p[i])->ob_exports++;
+	}
 
-			if (i == 0 || v_b > p_max)
-				p_max = v_b;
-		}
+	Py_BEGIN_ALLOW_THREADS
 
-		// bounds check
-		in_bounds = (0 <= p_min && p_max < (uint64_t)state.v_n[0]);
-
-		// if we are inside the bounds, we can sort
-		if (in_bounds) {
-			switch (state.p_t) {
-				case POINTLESS_PRIM_VECTOR_TYPE_I8:  bentley_sort_((int)state.p_n, prim_sort_proj_cmp,  prim_sort_proj_swap_i8,  (void*)&state); break;
-				case POINTLESS_PRIM_VECTOR_TYPE_U8:  bentley_sort_((int)state.p_n, prim_sort_proj_cmp,  prim_sort_proj_swap_u8,  (void*)&state); break;
-				case POINTLESS_PRIM_VECTOR_TYPE_I16: bentley_sort_((int)state.p_n, prim_sort_proj_cmp,  prim_sort_proj_swap_i16, (void*)&state); break;
-				case POINTLESS_PRIM_VECTOR_TYPE_U16: bentley_sort_((int)state.p_n, prim_sort_proj_cmp,  prim_sort_proj_swap_u16, (void*)&state); break;
-				case POINTLESS_PRIM_VECTOR_TYPE_I32: bentley_sort_((int)state.p_n, prim_sort_proj_cmp,  prim_sort_proj_swap_i32, (void*)&state); break;
-				case POINTLESS_PRIM_VECTOR_TYPE_U32: bentley_sort_((int)state.p_n, prim_sort_proj_cmp,  prim_sort_proj_swap_u32, (void*)&state); break;
-				case POINTLESS_PRIM_VECTOR_TYPE_I64: bentley_sort_((int)state.p_n, prim_sort_proj_cmp,  prim_sort_proj_swap_i64, (void*)&state); break;
-				case POINTLESS_PRIM_VECTOR_TYPE_U64: bentley_sort_((int)state.p_n, prim_sort_proj_cmp,  prim_sort_proj_swap_u64, (void*)&state); break;
-			}
-		}
+	in_bounds = prim_sort_proj_in_bounds(&state);
+
+	if (in_bounds)
+		sorted = prim_sort_proj_radix(&state);
+
+	Py_END_ALLOW_THREADS
+
+	self->ob_exports--;
+
+	for (i = 0; i < state.n; i++) {
+		if (PyPointlessPrimVector_Check(state.v_p[i]))
+			((PyPointlessPrimVector*)state.v_p[i])->ob_exports--;
 	}
 
 	// if we were not in bounds: raise an exception
@@ -1538,6 +1669,11 @@ static PyObject* PyPointlessPrimVector_sort_proj(PyPointlessPrimVector* self, Py
 		goto cleanup;
 	}
 
+	if (!sorted) {
+		PyErr_NoMemory();
+		goto cleanup;
+	}
+
 cleanup:
 
 	if (PyErr_Occurred())
@@ -1576,319 +1712,215 @@ static PyObject* PyPointlessPrimVector_get_typecode(PyPointlessPrimVector* self,
 	return Py_BuildValue("s", s);
 }
 
-static int PyPointlessPrimVector_from_remap_index_vector_prim(PyPointlessPrimVector* v_, size_t i, uint64_t* index)
+// map to the on-disk vector types, for the shared vector operations
+static uint32_t PyPointlessPrimVector_vector_type(PyPointlessPrimVector* self)
 {
-	uint64_t n_u;
-	int64_t n_i = 0;
-	int is_i = 1;
-
-	switch (v_->type) {
-		case POINTLESS_PRIM_VECTOR_TYPE_I8:
-			n_i = *((int8_t*)pointless_dynarray_item_at(&v_->array, i));
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_I16:
-			n_i = *((int16_t*)pointless_dynarray_item_at(&v_->array, i));
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_I32:
-			n_i = *((int32_t*)pointless_dynarray_item_at(&v_->array, i));
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_I64:
-			n_i = *((int64_t*)pointless_dynarray_item_at(&v_->array, i));
-			break;
-		default:
-			is_i = 0;
-			break;
-	}
-
-	if (is_i) {
-		if (n_i < 0)
-			return 0;
-
-		*index = (uint64_t)n_i;
-		return 1;
-	}
-
-	switch (v_->type) {
-		case POINTLESS_PRIM_VECTOR_TYPE_U8:
-			n_u = *((uint8_t*)pointless_dynarray_item_at(&v_->array, i));
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_U16:
-			n_u = *((uint16_t*)pointless_dynarray_item_at(&v_->array, i));
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_U32:
-			n_u = *((uint32_t*)pointless_dynarray_item_at(&v_->array, i));
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_U64:
-			n_u = *((uint64_t*)pointless_dynarray_item_at(&v_->array, i));
-			break;
-		default:
-			return 0;
-	}
-
-	*index = n_u;
-	return 1;
+	switch (self->type) {
+		case POINTLESS_PRIM_VECTOR_TYPE_I8:    return POINTLESS_VECTOR_I8;
+		case POINTLESS_PRIM_VECTOR_TYPE_U8:    return POINTLESS_VECTOR_U8;
+		case POINTLESS_PRIM_VECTOR_TYPE_I16:   return POINTLESS_VECTOR_I16;
+		case POINTLESS_PRIM_VECTOR_TYPE_U16:   return POINTLESS_VECTOR_U16;
+		case POINTLESS_PRIM_VECTOR_TYPE_I32:   return POINTLESS_VECTOR_I32;
+		case POINTLESS_PRIM_VECTOR_TYPE_U32:   return POINTLESS_VECTOR_U32;
+		case POINTLESS_PRIM_VECTOR_TYPE_I64:   return POINTLESS_VECTOR_I64;
+		case POINTLESS_PRIM_VECTOR_TYPE_U64:   return POINTLESS_VECTOR_U64;
+		case POINTLESS_PRIM_VECTOR_TYPE_FLOAT: return POINTLESS_VECTOR_FLOAT;
+	}
+
+	return POINTLESS_VECTOR_VALUE;
 }
 
-static int PyPointlessPrimVector_from_remap_index_vector_pointless(PyPointlessVector* v_, size_t i, uint64_t* index)
+static int PyPointlessPrimVector_prim_type(uint32_t vector_type, uint32_t* prim_type)
 {
-	// take slice into account
-	i += v_->slice_i;
-
-	uint64_t n_u;
-	int64_t n_i = 0;
-	int is_i = 1;
-
-	switch (v_->v->type) {
-		case POINTLESS_VECTOR_I8:
-			n_i = (int64_t)(*(pointless_reader_vector_i8(&v_->pp->p, v_->v) + i));
-			break;
-		case POINTLESS_VECTOR_I16:
-			n_i = (int64_t)(*(pointless_reader_vector_i16(&v_->pp->p, v_->v) + i));
-			break;
-		case POINTLESS_VECTOR_I32:
-			n_i = (int64_t)(*(pointless_reader_vector_i32(&v_->pp->p, v_->v) + i));
-			break;
-		case POINTLESS_VECTOR_I64:
-			n_i = (int64_t)(*(pointless_reader_vector_i64(&v_->pp->p, v_->v) + i));
-			break;
-		default:
-			is_i = 0;
-			break;
+	switch (vector_type) {
+		case POINTLESS_VECTOR_I8:    *prim_type = POINTLESS_PRIM_VECTOR_TYPE_I8;    return 1;
+		case POINTLESS_VECTOR_U8:    *prim_type = POINTLESS_PRIM_VECTOR_TYPE_U8;    return 1;
+		case POINTLESS_VECTOR_I16:   *prim_type = POINTLESS_PRIM_VECTOR_TYPE_I16;   return 1;
+		case POINTLESS_VECTOR_U16:   *prim_type = POINTLESS_PRIM_VECTOR_TYPE_U16;   return 1;
+		case POINTLESS_VECTOR_I32:   *prim_type = POINTLESS_PRIM_VECTOR_TYPE_I32;   return 1;
+		case POINTLESS_VECTOR_U32:   *prim_type = POINTLESS_PRIM_VECTOR_TYPE_U32;   return 1;
+		case POINTLESS_VECTOR_I64:   *prim_type = POINTLESS_PRIM_VECTOR_TYPE_I64;   return 1;
+		case POINTLESS_VECTOR_U64:   *prim_type = POINTLESS_PRIM_VECTOR_TYPE_U64;   return 1;
+		case POINTLESS_VECTOR_FLOAT: *prim_type = POINTLESS_PRIM_VECTOR_TYPE_FLOAT; return 1;
 	}
 
-	if (is_i) {
-		if (n_i < 0)
-			return 0;
-		*index = (uint64_t)n_i;
-		return 1;
-	}
+	return 0;
+}
 
-	switch (v_->v->type) {
-		case POINTLESS_VECTOR_U8:
-			n_u = (uint64_t)(*(pointless_reader_vector_u8(&v_->pp->p, v_->v) + i));
-			break;
-		case POINTLESS_VECTOR_U16:
-			n_u = (uint64_t)(*(pointless_reader_vector_u16(&v_->pp->p, v_->v) + i));
-			break;
-		case POINTLESS_VECTOR_U32:
-			n_u = (uint64_t)(*(pointless_reader_vector_u32(&v_->pp->p, v_->v) + i));
-			break;
-		case POINTLESS_VECTOR_U64:
-			n_u = (uint64_t)(*(pointless_reader_vector_u64(&v_->pp->p, v_->v) + i));
-			break;
-		default:
-			return 0;
+// base pointer, vector type and length of a prim-vector or a pointless vector
+static void PyPointlessPrimVector_from_remap_vector(PyObject* o, void** base, uint32_t* type, size_t* n)
+{
+	if (PyPointlessPrimVector_Check(o)) {
+		PyPointlessPrimVector* pv = (PyPointlessPrimVector*)o;
+		*base = pointless_dynarray_buffer(&pv->array);
+		*type = PyPointlessPrimVector_vector_type(pv);
+		*n = pointless_dynarray_n_items(&pv->array);
+		return;
+	}
+
+	PyPointlessVector* pv = (PyPointlessVector*)o;
+	pointless_t* p = &pv->pp->p;
+
+	*type = pv->v->type;
+	*n = pv->slice_n;
+
+	switch (pv->v->type) {
+		case POINTLESS_VECTOR_I8:    *base = (void*)(pointless_reader_vector_i8(p, pv->v)    + pv->slice_i); break;
+		case POINTLESS_VECTOR_U8:    *base = (void*)(pointless_reader_vector_u8(p, pv->v)    + pv->slice_i); break;
+		case POINTLESS_VECTOR_I16:   *base = (void*)(pointless_reader_vector_i16(p, pv->v)   + pv->slice_i); break;
+		case POINTLESS_VECTOR_U16:   *base = (void*)(pointless_reader_vector_u16(p, pv->v)   + pv->slice_i); break;
+		case POINTLESS_VECTOR_I32:   *base = (void*)(pointless_reader_vector_i32(p, pv->v)   + pv->slice_i); break;
+		case POINTLESS_VECTOR_U32:   *base = (void*)(pointless_reader_vector_u32(p, pv->v)   + pv->slice_i); break;
+		case POINTLESS_VECTOR_I64:   *base = (void*)(pointless_reader_vector_i64(p, pv->v)   + pv->slice_i); break;
+		case POINTLESS_VECTOR_U64:   *base = (void*)(pointless_reader_vector_u64(p, pv->v)   + pv->slice_i); break;
+		case POINTLESS_VECTOR_FLOAT: *base = (void*)(pointless_reader_vector_float(p, pv->v) + pv->slice_i); break;
+		default:                     *base = 0; break;
 	}
-
-	*index = n_u;
-	return 1;
 }
 
 static PyObject* PyPointlessPrimVector_from_remap(PyTypeObject* type, PyObject* args)
 {
-	PyPointlessPrimVector* r_ = 0;
+	PyObject* r_ = 0;
 	PyObject* v_ = 0;
 	pointless_dynarray_t a_;
 
-	if (!PyArg_ParseTuple(args, "O!O", &PyPointlessPrimVectorType, &r_, &v_))
+	if (!PyArg_ParseTuple(args, "OO", &r_, &v_))
 		return 0;
 
+	if (!PyPointlessPrimVector_Check(r_) && !PyPointlessVector_Check(r_)) {
+		PyErr_SetString(PyExc_ValueError, "source vector must be PointlessPrimVector or PointlessVector");
+		return 0;
+	}
+
 	if (!PyPointlessPrimVector_Check(v_) && !PyPointlessVector_Check(v_)) {
 		PyErr_SetString(PyExc_ValueError, "index vector must be PointlessPrimVector or PointlessVector");
 		return 0;
 	}
 
-	// initialize destination vector
-	switch (r_->type) {
-		case POINTLESS_PRIM_VECTOR_TYPE_I8:
-			pointless_dynarray_init(&a_, sizeof(int8_t));
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_U8:
-			pointless_dynarray_init(&a_, sizeof(uint8_t));
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_I16:
-			pointless_dynarray_init(&a_, sizeof(int16_t));
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_U16:
-			pointless_dynarray_init(&a_, sizeof(uint16_t));
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_I32:
-			pointless_dynarray_init(&a_, sizeof(int32_t));
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_U32:
-			pointless_dynarray_init(&a_, sizeof(uint32_t));
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_FLOAT:
-			pointless_dynarray_init(&a_, sizeof(float));
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_I64:
-			pointless_dynarray_init(&a_, sizeof(int64_t));
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_U64:
-			pointless_dynarray_init(&a_, sizeof(uint64_t));
-			break;
-		default:
-			PyErr_SetString(PyExc_ValueError, "unknown source vector type");
-			return 0;
+	void* r_base = 0;
+	void* v_base = 0;
+	uint32_t r_type = 0, v_type = 0, prim_type = 0;
+	size_t n_source = 0, n_index = 0;
+
+	PyPointlessPrimVector_from_remap_vector(r_, &r_base, &r_type, &n_source);
+	PyPointlessPrimVector_from_remap_vector(v_, &v_base, &v_type, &n_index);
+
+	// pointless vectors are gathered from in place, but the result is always a prim-vector
+	if (!PyPointlessPrimVector_prim_type(r_type, &prim_type)) {
+		PyErr_SetString(PyExc_ValueError, "source vector must be a non-empty primitive vector");
+		return 0;
 	}
 
-	// get source vector
-	size_t i, n_source = pointless_dynarray_n_items(&r_->array);
-	size_t n_index = 0;
+	// the output is sized up front
+	size_t item_size = pointless_vector_type_item_size(r_type);
+	void* dst = 0;
 
-	if (PyPointlessPrimVector_Check(v_)) {
-		n_index = pointless_dynarray_n_items(&((PyPointlessPrimVector*)v_)->array);
-	} else {
-		n_index = ((PyPointlessVector*)v_)->slice_n;
+	if (n_index > 0) {
+		dst = pointless_malloc(item_size * n_index);
+
+		if (dst == 0)
+			return PyErr_NoMemory();
 	}
 
-	// for each index
-	for (i = 0; i < n_index; i++) {
-		// get it
-		uint64_t index = 0;
+	// the gather runs without the GIL, so the prim-vectors must not be re-sized meanwhile
+	const char* error = 0;
+	int gathered = 0;
 
-		if (PyPointlessPrimVector_Check(v_) && !PyPointlessPrimVector_from_remap_index_vector_prim((PyPointlessPrimVector*)v_, i, &index)) {
-			PyErr_SetString(PyExc_ValueError, "index vector negative or of the wrong type");
-			return 0;
-		}
+	if (PyPointlessPrimVector_Check(r_))
+		((PyPointlessPrimVector*)r_)->ob_exports++;
 
-		if (PyPointlessVector_Check(v_) && !PyPointlessPrimVector_from_remap_index_vector_pointless((PyPointlessVector*)v_, i, &index)) {
-			PyErr_SetString(PyExc_ValueError, "index vector negative or of the wrong type");
-			return 0;
-		}
+	if (PyPointlessPrimVector_Check(v_))
+		((PyPointlessPrimVector*)v_)->ob_exports++;
 
-		// check for bounds
-		if (index >= n_source) {
-			PyErr_SetString(PyExc_ValueError, "index vector out of bounds");
-			return 0;
-		}
+	Py_BEGIN_ALLOW_THREADS
 
-		// TBD: support more vector types
+	gathered = pointless_vector_gather(r_base, r_type, n_source, v_base, v_type, n_index, dst, &error);
 
-		// add to destination vector
-		void* source = pointless_dynarray_item_at(&r_->array, index);
+	Py_END_ALLOW_THREADS
 
-		if (!pointless_dynarray_push(&a_, source)) {
-			pointless_dynarray_destroy(&a_);
-			return PyErr_NoMemory();
-		}
+	if (PyPointlessPrimVector_Check(r_))
+		((PyPointlessPrimVector*)r_)->ob_exports--;
+
+	if (PyPointlessPrimVector_Check(v_))
+		((PyPointlessPrimVector*)v_)->ob_exports--;
+
+	if (!gathered) {
+		pointless_free(dst);
+		PyErr_SetString(PyExc_ValueError, error);
+		return 0;
 	}
 
-	return (PyObject*)PyPointlessPrimVector_from_T_vector(&a_, r_->type);
-}
+	pointless_dynarray_init(&a_, item_size);
 
-#define POINTLESS_PRIMVECTOR_MAX_LOOP(T, v, n) \
-	{\
-		m_i = 0;\
-		for (i = 1; i < (n); i++) {\
-			if (((T*)(v))[i] > ((T*)(v))[m_i])\
-				m_i = i;\
-		}\
-	}\
+	if (n_index > 0)
+		pointless_dynarray_give_data(&a_, dst, n_index);
+
+	return (PyObject*)PyPointlessPrimVector_from_T_vector(&a_, prim_type);
+}
 
-#define POINTLESS_PRIMVECTOR_MIN_LOOP(T, v, n) \
-	{\
-		m_i = 0;\
-		for (i = 1; i < (n); i++) {\
-			if (((T*)(v))[i] < ((T*)(v))[m_i])\
-				m_i = i;\
-		}\
-	}\
+#define POINTLESS_PRIMVECTOR_OPS_ARGS(self) pointless_dynarray_buffer(&(self)->array), PyPointlessPrimVector_vector_type(self), pointless_dynarray_n_items(&(self)->array)
 
 static PyObject* PyPointlessPrimVector_max(PyPointlessPrimVector* self)
 {
-	size_t i, m_i, n_items;
-	n_items = pointless_dynarray_n_items(&self->array);
-	void* base_ptr = pointless_dynarray_buffer(&self->array);
+	size_t m_i = 0;
+	const char* error = 0;
 
-	if (n_items == 0) {
-		PyErr_SetString(PyExc_ValueError, "vector is empty");
+	if (!pointless_vector_argmax(POINTLESS_PRIMVECTOR_OPS_ARGS(self), &m_i, &error)) {
+		PyErr_SetString(PyExc_ValueError, error);
 		return 0;
 	}
 
-	switch (self->type) {
-		case POINTLESS_PRIM_VECTOR_TYPE_I8:
-			POINTLESS_PRIMVECTOR_MAX_LOOP(int8_t, base_ptr, n_items);
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_U8:
-			POINTLESS_PRIMVECTOR_MAX_LOOP(uint8_t, base_ptr, n_items);
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_I16:
-			POINTLESS_PRIMVECTOR_MAX_LOOP(int16_t, base_ptr, n_items);
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_U16:
-			POINTLESS_PRIMVECTOR_MAX_LOOP(uint16_t, base_ptr, n_items);
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_I32:
-			POINTLESS_PRIMVECTOR_MAX_LOOP(int32_t, base_ptr, n_items);
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_U32:
-			POINTLESS_PRIMVECTOR_MAX_LOOP(uint32_t, base_ptr, n_items);
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_I64:
-			POINTLESS_PRIMVECTOR_MAX_LOOP(int64_t, base_ptr, n_items);
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_U64:
-			POINTLESS_PRIMVECTOR_MAX_LOOP(uint64_t, base_ptr, n_items);
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_FLOAT:
-			POINTLESS_PRIMVECTOR_MAX_LOOP(float, base_ptr, n_items);
-			break;
-		default:
-			PyErr_BadInternalCall();
-			return 0;
-	}
-
 	return PyPointlessPrimVector_subscript_priv(self, m_i);
 }
 
 static PyObject* PyPointlessPrimVector_min(PyPointlessPrimVector* self)
 {
-	size_t i, m_i, n_items;
-	n_items = pointless_dynarray_n_items(&self->array);
-	void* base_ptr = pointless_dynarray_buffer(&self->array);
+	size_t m_i = 0;
+	const char* error = 0;
 
-	if (n_items == 0) {
-		PyErr_SetString(PyExc_ValueError, "vector is empty");
+	if (!pointless_vector_argmin(POINTLESS_PRIMVECTOR_OPS_ARGS(self), &m_i, &error)) {
+		PyErr_SetString(PyExc_ValueError, error);
 		return 0;
 	}
 
-	switch (self->type) {
-		case POINTLESS_PRIM_VECTOR_TYPE_I8:
-			POINTLESS_PRIMVECTOR_MIN_LOOP(int8_t, base_ptr, n_items);
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_U8:
-			POINTLESS_PRIMVECTOR_MIN_LOOP(uint8_t, base_ptr, n_items);
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_I16:
-			POINTLESS_PRIMVECTOR_MIN_LOOP(int16_t, base_ptr, n_items);
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_U16:
-			POINTLESS_PRIMVECTOR_MIN_LOOP(uint16_t, base_ptr, n_items);
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_I32:
-			POINTLESS_PRIMVECTOR_MIN_LOOP(int32_t, base_ptr, n_items);
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_U32:
-			POINTLESS_PRIMVECTOR_MIN_LOOP(uint32_t, base_ptr, n_items);
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_I64:
-			POINTLESS_PRIMVECTOR_MIN_LOOP(int64_t, base_ptr, n_items);
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_U64:
-			POINTLESS_PRIMVECTOR_MIN_LOOP(uint64_t, base_ptr, n_items);
-			break;
-		case POINTLESS_PRIM_VECTOR_TYPE_FLOAT:
-			POINTLESS_PRIMVECTOR_MIN_LOOP(float, base_ptr, n_items);
-			break;
-		default:
-			PyErr_BadInternalCall();
-			return 0;
-	}
-
 	return PyPointlessPrimVector_subscript_priv(self, m_i);
 }
 
+static PyObject* PyPointlessPrimVector_sum(PyPointlessPrimVector* self)
+{
+	return pypointless_vector_ops_sum(POINTLESS_PRIMVECTOR_OPS_ARGS(self));
+}
+
+static PyObject* PyPointlessPrimVector_argmax(PyPointlessPrimVector* self)
+{
+	return pypointless_vector_ops_argmax(POINTLESS_PRIMVECTOR_OPS_ARGS(self));
+}
+
+static PyObject* PyPointlessPrimVector_argmin(PyPointlessPrimVector* self)
+{
+	return pypointless_vector_ops_argmin(POINTLESS_PRIMVECTOR_OPS_ARGS(self));
+}
+
+static PyObject* PyPointlessPrimVector_count_range(PyPointlessPrimVector* self, PyObject* args)
+{
+	return pypointless_vector_ops_count_range(POINTLESS_PRIMVECTOR_OPS_ARGS(self), args);
+}
+
+static PyObject* PyPointlessPrimVector_filter(PyPointlessPrimVector* self, PyObject* args)
+{
+	return pypointless_vector_ops_filter(POINTLESS_PRIMVECTOR_OPS_ARGS(self), args);
+}
+
+static PyObject* PyPointlessPrimVector_filter_range(PyPointlessPrimVector* self, PyObject* args)
+{
+	return pypointless_vector_ops_filter_range(POINTLESS_PRIMVECTOR_OPS_ARGS(self), args);
+}
+
+static PyObject* PyPointlessPrimVector_histogram(PyPointlessPrimVector* self, PyObject* args)
+{
+	return pypointless_vector_ops_histogram(POINTLESS_PRIMVECTOR_OPS_ARGS(self), args);
+}
+
 
 static PyGetSetDef PyPointlessPrimVector_getsets [] = {
 	{"typecode", (getter)PyPointlessPrimVector_get_typecode, 0, "the typecode string used to create the vector"},
@@ -1911,6 +1943,13 @@ static PyMethodDef PyPointlessPrimVector_methods[] = {
 	{"FromRemap",   (PyCFunction)PyPointlessPrimVector_from_remap,    METH_VARARGS | METH_CLASS, ""},
 	{"max",         (PyCFunction)PyPointlessPrimVector_max,           METH_NOARGS, ""},
 	{"min",         (PyCFunction)PyPointlessPrimVector_min,           METH_NOARGS, ""},
+	{"sum",         (PyCFunction)PyPointlessPrimVector_sum,           METH_NOARGS,  ""},
+	{"argmax",      (PyCFunction)PyPointlessPrimVector_argmax,        METH_NOARGS,  ""},
+	{"argmin",      (PyCFunction)PyPointlessPrimVector_argmin,        METH_NOARGS,  ""},
+	{"count_range", (PyCFunction)PyPointlessPrimVector_count_range,   METH_VARARGS, ""},
+	{"filter",      (PyCFunction)PyPointlessPrimVector_filter,        METH_VARARGS, ""},
+	{"filter_range", (PyCFunction)PyPointlessPrimVector_filter_range,  METH_VARARGS, ""},
+	{"histogram",   (PyCFunction)PyPointlessPrimVector_histogram,     METH_VARARGS, ""},
 	{NULL, NULL}
 };
 
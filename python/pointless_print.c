@@ -55,6 +55,8 @@ static int _pypointless_string_str(pointless_t* p, pointless_value_t* v, _pypoin
 static int _pypointless_vector_str(pointless_t* p, pointless_value_t* v, _pypointless_print_state_t* state, uint32_t slice_i, uint32_t slice_n);
 static int _pypointless_set_str(pointless_t* p, pointless_value_t* v, _pypointless_print_state_t* state);
 static int _pypointless_map_str(pointless_t* p, pointless_value_t* v, _pypointless_print_state_t* state);
+static int _pypointless_table_str(pointless_t* p, pointless_value_t* v, _pypointless_print_state_t* state);
+static int _pypointless_table_row_str(pointless_t* p, pointless_value_t* v, uint32_t row, _pypointless_print_state_t* state);
 static int _pypointless_bitvector_str(pointless_t* p, pointless_value_t* v, _pypointless_print_state_t* state);
 static int _pypointless_bitvector_str_buffer(void* buffer, uint32_t n_bits, _pypointless_print_state_t* state);
 
@@ -77,11 +79,15 @@ static int _pypointless_str_rec(pointless_t* p, pointless_complete_value_t* v, _
 		case POINTLESS_UNICODE_:
 			return _pypointless_unicode_str(p, &_v, state);
 		case POINTLESS_STRING_:
+		case POINTLESS_STRING_INLINE:
+		case POINTLESS_STRING_SYMBOLS:
 			return _pypointless_string_str(p, &_v, state);
 		case POINTLESS_SET_VALUE:
 			return _pypointless_set_str(p, &_v, state);
 		case POINTLESS_MAP_VALUE_VALUE:
 			return _pypointless_map_str(p, &_v, state);
+		case POINTLESS_TABLE:
+			return _pypointless_table_str(p, &_v, state);
 		case POINTLESS_I32:
 		case POINTLESS_I64:
 			snprintf(buffer, sizeof(buffer), "%lli", (long long)pointless_complete_value_get_as_i64(v->type, &v->complete_data));
@@ -198,24 +204,23 @@ static int _pypointless_set_str(pointless_t* p, pointless_value_t* v, _pypointle
 	if (!_pypointless_print_append_8_(state, "set(["))
 		return 0;
 
-	pointless_value_t* value = 0;
-
 	if (!print_state_push(state, container_id))
 		return 0;
 
-	uint32_t i = 0, iter_state = 0, n_items = pointless_reader_set_n_items(p, v);
+	uint32_t i = 0, iter_state = 0, entry = 0, n_items = pointless_reader_set_n_items(p, v);
 
-	while (pointless_reader_set_iter(p, v, &value, &iter_state)) {
+	while (pointless_reader_set_iter_entry(p, v, &entry, &iter_state)) {
 		uint32_t v_slice_i = 0;
 		uint32_t v_slice_n = 0;
 
-		if (pointless_is_vector_type(value->type)) {
+		pointless_complete_value_t _value = pointless_reader_vector_value_case(p, pointless_set_key_vector(p, v), entry);
+
+		if (pointless_is_vector_type(_value.type)) {
+			pointless_value_t value = pointless_value_from_complete(&_value);
 			v_slice_i = 0;
-			v_slice_n = pointless_reader_vector_n_items(p, value);
+			v_slice_n = pointless_reader_vector_n_items(p, &value);
 		}
 
-		pointless_complete_value_t _value = pointless_value_to_complete(value);
-
 		if (!_pypointless_str_rec(p, &_value, state, v_slice_i, v_slice_n)) {
 			print_state_pop(state);
 			return 0;
@@ -244,33 +249,32 @@ static int _pypointless_map_str(pointless_t* p, pointless_value_t* v, _pypointle
 	if (!_pypointless_print_append_8_(state, "{"))
 		return 0;
 
-	pointless_value_t* key = 0;
-	pointless_value_t* value = 0;
-
 	if (!print_state_push(state, container_id))
 		return 0;
 
-	uint32_t i = 0, iter_state = 0, n_items = pointless_reader_map_n_items(p, v);
+	uint32_t i = 0, iter_state = 0, entry = 0, n_items = pointless_reader_map_n_items(p, v);
 
-	while (pointless_reader_map_iter(p, v, &key, &value, &iter_state)) {
+	while (pointless_reader_map_iter_entry(p, v, &entry, &iter_state)) {
 		uint32_t v_slice_i_k = 0;
 		uint32_t v_slice_n_k = 0;
 		uint32_t v_slice_i_v = 0;
 		uint32_t v_slice_n_v = 0;
 
-		if (pointless_is_vector_type(key->type)) {
+		pointless_complete_value_t _key = pointless_reader_map_key(p, v, entry);
+		pointless_complete_value_t _value = pointless_reader_map_value(p, v, entry);
+
+		if (pointless_is_vector_type(_key.type)) {
+			pointless_value_t key = pointless_value_from_complete(&_key);
 			v_slice_i_k = 0;
-			v_slice_n_k = pointless_reader_vector_n_items(p, key);
+			v_slice_n_k = pointless_reader_vector_n_items(p, &key);
 		}
 
-		if (pointless_is_vector_type(value->type)) {
+		if (pointless_is_vector_type(_value.type)) {
+			pointless_value_t value = pointless_value_from_complete(&_value);
 			v_slice_i_v = 0;
-			v_slice_n_v = pointless_reader_vector_n_items(p, value);
+			v_slice_n_v = pointless_reader_vector_n_items(p, &value);
 		}
 
-		pointless_complete_value_t _key = pointless_value_to_complete(key);
-		pointless_complete_value_t _value = pointless_value_to_complete(value);
-
 		if (!_pypointless_str_rec(p, &_key, state, v_slice_i_k, v_slice_n_k)) {
 			print_state_pop(state);
 			return 0;
@@ -299,6 +303,80 @@ static int _pypointless_map_str(pointless_t* p, pointless_value_t* v, _pypointle
 	return _pypointless_print_append_8_(state, "}");
 }
 
+// rows are printed as maps, without cycle checks, since all values are vector items
+static int _pypointless_table_row_str(pointless_t* p, pointless_value_t* v, uint32_t row, _pypointless_print_state_t* state)
+{
+	pointless_value_t* keys = pointless_reader_table_keys(p, v);
+	pointless_value_t* columns = pointless_reader_table_columns(p, v);
+	uint32_t i, n_columns = pointless_reader_table_n_columns(p, v);
+
+	if (!_pypointless_print_append_8_(state, "{"))
+		return 0;
+
+	for (i = 0; i < n_columns; i++) {
+		pointless_complete_value_t _key = pointless_reader_vector_value_case(p, keys, i);
+		pointless_complete_value_t _value = pointless_reader_vector_value_case(p, columns + i, row);
+		uint32_t v_slice_n_k = 0;
+		uint32_t v_slice_n_v = 0;
+
+		if (pointless_is_vector_type(_key.type)) {
+			pointless_value_t key = pointless_value_from_complete(&_key);
+			v_slice_n_k = pointless_reader_vector_n_items(p, &key);
+		}
+
+		if (pointless_is_vector_type(_value.type)) {
+			pointless_value_t value = pointless_value_from_complete(&_value);
+			v_slice_n_v = pointless_reader_vector_n_items(p, &value);
+		}
+
+		if (!_pypointless_str_rec(p, &_key, state, 0, v_slice_n_k))
+			return 0;
+
+		if (!_pypointless_print_append_8_(state, ": "))
+			return 0;
+
+		if (!_pypointless_str_rec(p, &_value, state, 0, v_slice_n_v))
+			return 0;
+
+		if (i + 1 < n_columns && !_pypointless_print_append_8_(state, ", "))
+			return 0;
+	}
+
+	return _pypointless_print_append_8_(state, "}");
+}
+
+static int _pypointless_table_str(pointless_t* p, pointless_value_t* v, _pypointless_print_state_t* state)
+{
+	uint32_t container_id = pointless_container_id(p, v);
+
+	if (print_state_has_container(state, container_id))
+		return _pypointless_print_append_8_(state, "[...]");
+
+	if (!_pypointless_print_append_8_(state, "["))
+		return 0;
+
+	if (!print_state_push(state, container_id))
+		return 0;
+
+	uint32_t i, n_rows = pointless_reader_table_n_rows(p, v);
+
+	for (i = 0; i < n_rows; i++) {
+		if (!_pypointless_table_row_str(p, v, i, state)) {
+			print_state_pop(state);
+			return 0;
+		}
+
+		if (i + 1 < n_rows && !_pypointless_print_append_8_(state, ", ")) {
+			print_state_pop(state);
+			return 0;
+		}
+	}
+
+	print_state_pop(state);
+
+	return _pypointless_print_append_8_(state, "]");
+}
+
 static int _pypointless_bitvector_str(pointless_t* p, pointless_value_t* v, _pypointless_print_state_t* state)
 {
 	int32_t n_bits = (int32_t)pointless_reader_bitvector_n_bits(p, v);
@@ -401,6 +479,7 @@ PyObject* PyPointless_str(PyObject* py_object)
 	pointless_value_t* v = 0;
 	uint32_t vector_slice_i = 0;
 	uint32_t vector_slice_n = 0;
+	uint32_t table_row = UINT32_MAX;
 
 	if (PyPointlessBitvector_Check(py_object)) {
 		PyPointlessBitvector* b = (PyPointlessBitvector*)py_object;
@@ -420,6 +499,15 @@ PyObject* PyPointless_str(PyObject* py_object)
 		PyPointlessMap* m = (PyPointlessMap*)py_object;
 		pp = m->pp;
 		v = m->v;
+	} else if (PyPointlessTable_Check(py_object)) {
+		PyPointlessTable* t = (PyPointlessTable*)py_object;
+		pp = t->pp;
+		v = t->v;
+	} else if (PyPointlessTableRow_Check(py_object)) {
+		PyPointlessTableRow* r = (PyPointlessTableRow*)py_object;
+		pp = r->table->pp;
+		v = r->table->v;
+		table_row = r->row;
 	}
 
 	if (pp == 0) {
@@ -431,7 +519,13 @@ PyObject* PyPointless_str(PyObject* py_object)
 		return PyString_FromFormat("<%s object at %p>", Py_TYPE(py_object)->tp_name, (void*)py_object);
 
 	pointless_complete_value_t _v = pointless_value_to_complete(v);
-	int i = _pypointless_str_rec(&pp->p, &_v, &state, vector_slice_i, vector_slice_n); 
+	int i = 0;
+
+	if (table_row != UINT32_MAX)
+		i = _pypointless_table_row_str(&pp->p, v, table_row, &state);
+	else
+		i = _pypointless_str_rec(&pp->p, &_v, &state, vector_slice_i, vector_slice_n);
+
 	PyObject* s = 0;
 
 	char zero = 0;
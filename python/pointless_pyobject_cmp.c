@@ -125,16 +125,21 @@ static pypointless_cmp_cb pypointless_cmp_func(pypointless_cmp_value_t* v, uint3
 		switch (*type) {
 			case POINTLESS_I32:
 			case POINTLESS_U32:
+			case POINTLESS_I64:
+			case POINTLESS_U64:
 			case POINTLESS_FLOAT:
 			case POINTLESS_BOOLEAN:
 				return pypointless_cmp_int_float_bool;
 			case POINTLESS_NULL:
 				return pypointless_cmp_none;
 			case POINTLESS_STRING_:
+			case POINTLESS_STRING_INLINE:
+			case POINTLESS_STRING_SYMBOLS:
 			case POINTLESS_UNICODE_:
 				return pypointless_cmp_string_unicode;
 			case POINTLESS_SET_VALUE:
 			case POINTLESS_MAP_VALUE_VALUE:
+			case POINTLESS_TABLE:
 			case POINTLESS_EMPTY_SLOT:
 				return 0;
 		}
@@ -236,19 +241,20 @@ typedef struct {
 	uint8_t n_bits;
 } _var_string_t;
 
-static _var_string_t pypointless_cmp_extract_string(pypointless_cmp_value_t* v, pypointless_cmp_state_t* state)
+// inline strings are read from 'v_', and compressed strings decoded into 'buffer', which must outlive the string
+static _var_string_t pypointless_cmp_extract_string(pypointless_cmp_value_t* v, pointless_value_t* v_, uint8_t* buffer, pypointless_cmp_state_t* state)
 {
 	_var_string_t s;
 
 	if (v->is_pointless) {
-		pointless_value_t v_ = pointless_value_from_complete(&v->value.pointless.v);
+		*v_ = pointless_value_from_complete(&v->value.pointless.v);
 
-		if (v_.type == POINTLESS_UNICODE_) {
+		if (v_->type == POINTLESS_UNICODE_) {
 			s.n_bits = 32;
-			s.string.string_32 = pointless_reader_unicode_value_ucs4(v->value.pointless.p, &v_);
+			s.string.string_32 = pointless_reader_unicode_value_ucs4(v->value.pointless.p, v_);
 		} else {
 			s.n_bits = 8;
-			s.string.string_8 = pointless_reader_string_value_ascii(v->value.pointless.p, &v_);
+			s.string.string_8 = pointless_reader_string_value_ascii_buffer(v->value.pointless.p, v_, buffer);
 		}
 	} else {
 		assert(PyString_Check(v->value.py_object) || PyUnicode_Check(v->value.py_object));
@@ -272,12 +278,15 @@ static _var_string_t pypointless_cmp_extract_string(pypointless_cmp_value_t* v,
 
 static int32_t pypointless_cmp_string_unicode(pypointless_cmp_value_t* a, pypointless_cmp_value_t* b, pypointless_cmp_state_t* state)
 {
-	_var_string_t s_a = pypointless_cmp_extract_string(a, state);
+	pointless_value_t v_a, v_b;
+	uint8_t buffer_a[POINTLESS_STRING_SYMBOLS_BUFFER_LEN];
+	uint8_t buffer_b[POINTLESS_STRING_SYMBOLS_BUFFER_LEN];
+	_var_string_t s_a = pypointless_cmp_extract_string(a, &v_a, buffer_a, state);
 
 	if (state->error)
 		return 0;
 
-	_var_string_t s_b = pypointless_cmp_extract_string(b, state);
+	_var_string_t s_b = pypointless_cmp_extract_string(b, &v_b, buffer_b, state);
 
 	if (state->error)
 		return 0;
@@ -21,7 +21,7 @@ static uint32_t pyobject_hash_tuple_32(PyObject* py_object, pyobject_hash_state_
 	PyObject* o = 0;
 
 	pointless_vector_hash_state_32_t v_state;
-	pointless_vector_hash_init_32(&v_state, n_items);
+	pointless_vector_hash_init_32(&v_state, state->version, n_items);
 
 	state->depth += 1;
 
@@ -43,7 +43,13 @@ static uint32_t pyobject_hash_primvector_32(PyPointlessPrimVector* v, pyobject_h
 	uint32_t h;
 
 	pointless_vector_hash_state_32_t v_state;
-	pointless_vector_hash_init_32(&v_state, (uint32_t)n_items);
+	pointless_vector_hash_init_32(&v_state, state->version, (uint32_t)n_items);
+
+	// 32-bit integers hash to themselves
+	if (v->type == POINTLESS_PRIM_VECTOR_TYPE_I32 || v->type == POINTLESS_PRIM_VECTOR_TYPE_U32) {
+		pointless_vector_hash_next_n_32(&v_state, (uint32_t*)pointless_dynarray_buffer(&v->array), (uint32_t)n_items);
+		return pointless_vector_hash_end_32(&v_state);
+	}
 
 	for (i = 0; i < n_items; i++) {
 		void* item = pointless_dynarray_item_at(&v->array, i);
@@ -90,52 +96,22 @@ static uint32_t pyobject_hash_primvector_32(PyPointlessPrimVector* v, pyobject_h
 static uint32_t pyobject_hash_unicode_32(PyObject* py_object, pyobject_hash_state_t* state)
 {
 	Py_UNICODE* s = PyUnicode_AS_UNICODE(py_object);
-	uint32_t hash = 0;
-
-	switch (state->version) {
-		#ifdef Py_UNICODE_WIDE
-		case POINTLESS_FF_VERSION_OFFSET_32_OLDHASH:
-			hash = pointless_hash_unicode_ucs4_v0_32((uint32_t*)s);
-			break;
-		case POINTLESS_FF_VERSION_OFFSET_32_NEWHASH:
-		case POINTLESS_FF_VERSION_OFFSET_64_NEWHASH:
-			hash = pointless_hash_unicode_ucs4_v1_32((uint32_t*)s);
-			break;
-		#else
-		case POINTLESS_FF_VERSION_OFFSET_32_OLDHASH:
-			hash = pointless_hash_unicode_ucs2_v0_32((uint16_t*)s);
-			break;
-		case POINTLESS_FF_VERSION_OFFSET_32_NEWHASH:
-		case POINTLESS_FF_VERSION_OFFSET_64_NEWHASH:
-			hash = pointless_hash_unicode_ucs2_v1_32((uint16_t*)s);
-			break;
-		#endif
-	}
 
-	return hash;
+	#ifdef Py_UNICODE_WIDE
+	return pointless_hash_unicode_ucs4_32(state->version, (uint32_t*)s);
+	#else
+	return pointless_hash_unicode_ucs2_32(state->version, (uint16_t*)s);
+	#endif
 }
 
 static uint32_t pyobject_hash_string_32(PyObject* py_object, pyobject_hash_state_t* state)
 {
-	char* s = PyString_AS_STRING(py_object);
-	uint32_t hash = 0;
-
-	switch (state->version) {
-		case POINTLESS_FF_VERSION_OFFSET_32_OLDHASH:
-			hash = pointless_hash_string_v0_32((uint8_t*)s);
-			break;
-		case POINTLESS_FF_VERSION_OFFSET_32_NEWHASH:
-		case POINTLESS_FF_VERSION_OFFSET_64_NEWHASH:
-			hash = pointless_hash_string_v1_32((uint8_t*)s);
-			break;
-	}
-
-	return hash;
+	return pointless_hash_string_32(state->version, (uint8_t*)PyString_AS_STRING(py_object));
 }
 
 static uint32_t pyobject_hash_pypointlessbitvector_32(PyObject* py_object, pyobject_hash_state_t* state)
 {
-	return pointless_pybitvector_hash_32((PyPointlessBitvector*)py_object);
+	return pointless_pybitvector_hash_32((PyPointlessBitvector*)py_object, state->version);
 }
 
 static uint32_t pyobject_hash_int_32(PyObject* py_object, pyobject_hash_state_t* state)
@@ -229,7 +205,7 @@ static uint32_t pyobject_hash_rec_32(PyObject* py_object, pyobject_hash_state_t*
 	}
 
 	if (PyPointlessBitvector_Check(py_object))
-		return pointless_pybitvector_hash_32((PyPointlessBitvector*)py_object);
+		return pointless_pybitvector_hash_32((PyPointlessBitvector*)py_object, state->version);
 
 	if (PyPointlessSet_Check(py_object)) {
 		p = &((PyPointlessSet*)py_object)->pp->p;
@@ -290,17 +266,18 @@ uint32_t pyobject_hash_32(PyObject* py_object, uint32_t version, const char** er
 
 const char pointless_pyobject_hash_32_doc[] =
 "1\n"
-"pointless.pyobject_hash(object)\n"
+"pointless.pyobject_hash(object, version)\n"
 "\n"
 "Return a pointless-consistent hash of a Python object.\n"
 "\n"
 "  object: the object\n"
+"  version: the file format version whose hash to use, defaults to that of files written by default\n"
 ;
 PyObject* pointless_pyobject_hash_32(PyObject* self, PyObject* args)
 {
 	PyObject* object = 0;
 	const char* error = 0;
-	int version = POINTLESS_FILE_FORMAT_LATEST_VERSION_;
+	int version = POINTLESS_FF_VERSION_OFFSET_64_NEWHASH;
 
 	if (!PyArg_ParseTuple(args, "O|i:pyobject_hash", &object, &version))
 		return 0;
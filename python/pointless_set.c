@@ -89,10 +89,12 @@ static PyObject* PyPointlessSetIter_iternext(PyPointlessSetIter* iter)
 	if (iter->set == 0)
 		return 0;
 
-	pointless_value_t* v = 0;
+	pointless_t* p = &iter->set->pp->p;
+	uint32_t entry = 0;
 
-	if (pointless_reader_set_iter(&iter->set->pp->p, iter->set->v, &v, &iter->iter_state))
-		return pypointless_value(iter->set->pp, v);
+	// the key vector may be a primitive vector
+	if (pointless_reader_set_iter_entry(p, iter->set->v, &entry, &iter->iter_state))
+		return pypointless_vector_item(iter->set->pp, pointless_set_key_vector(p, iter->set->v), entry);
 
 	Py_DECREF(iter->set);
 	iter->set = 0;
@@ -106,23 +108,31 @@ static uint32_t PyPointlessSet_eq_cb(pointless_t* p, pointless_complete_value_t*
 
 static int PyPointlessSet_contains(PyPointlessSet* s, PyObject* key)
 {
+	pointless_t* p = &s->pp->p;
+	pointless_prepared_key_t local;
+	pointless_prepared_key_t* prepared = 0;
+	PyObject* py_key = 0;
+	uint32_t hash = 0;
 	const char* error = 0;
-	uint32_t hash = pyobject_hash_32(key, s->pp->p.header->version, &error);
-
-	if (error) {
-		PyErr_Format(PyExc_ValueError, "pointless hash error: %s", error);
-		return -1;
+	uint32_t entry = 0;
+
+	switch (pypointless_lookup_key(key, p, &local, &prepared, &py_key, &hash)) {
+		case -1:
+			return -1;
+		case 1:
+			// prepared keys skip the generic hash and comparison callbacks
+			entry = pointless_reader_set_probe_prepared(p, s->v, prepared);
+			return (entry != POINTLESS_HASH_TABLE_PROBE_MISS);
 	}
 
-	pointless_value_t* kk = 0;
-	pointless_reader_set_lookup_ext(&s->pp->p, s->v, hash, PyPointlessSet_eq_cb, (void*)key, &kk, &error);
+	entry = pointless_reader_set_probe_ext(p, s->v, hash, PyPointlessSet_eq_cb, (void*)py_key, &error);
 
 	if (error) {
 		PyErr_Format(PyExc_ValueError, "pointless set query error: %s", error);
 		return -1;
 	}
 
-	return (kk != 0);
+	return (entry != POINTLESS_HASH_TABLE_PROBE_MISS);
 }
 
 static PyMemberDef PyPointlessSet_memberlist[] = {
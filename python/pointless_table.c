@@ -0,0 +1,477 @@
+#include "pointless/pointless_ext.h"
+
+static void PyPointlessTable_dealloc(PyPointlessTable* self)
+{
+	if (self->pp) {
+		self->pp->n_vector_refs -= 1;
+		Py_DECREF(self->pp);
+	}
+
+	Py_XDECREF(self->key_index);
+
+	self->pp = 0;
+	self->v = 0;
+	self->container_id = 0;
+	self->key_index = 0;
+	PyObject_Del(self);
+}
+
+static void PyPointlessTableRow_dealloc(PyPointlessTableRow* self)
+{
+	Py_XDECREF(self->table);
+	self->table = 0;
+	self->row = 0;
+	Py_TYPE(self)->tp_free(self);
+}
+
+PyObject* PyPointlessTable_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
+{
+	PyPointlessTable* self = (PyPointlessTable*)type->tp_alloc(type, 0);
+
+	if (self) {
+		self->pp = 0;
+		self->v = 0;
+		self->container_id = 0;
+		self->key_index = 0;
+	}
+
+	return (PyObject*)self;
+}
+
+PyObject* PyPointlessTableRow_new(PyTypeObject* type, PyObject* args, PyObject* kwds)
+{
+	PyPointlessTableRow* self = (PyPointlessTableRow*)type->tp_alloc(type, 0);
+
+	if (self) {
+		self->table = 0;
+		self->row = 0;
+	}
+
+	return (PyObject*)self;
+}
+
+static int PyPointlessTable_init(PyPointlessTable* self, PyObject* args)
+{
+	PyErr_SetString(PyExc_TypeError, "unable to instantiate PyPointlessTable directly");
+	return -1;
+}
+
+static int PyPointlessTableRow_init(PyPointlessTableRow* self, PyObject* args)
+{
+	PyErr_SetString(PyExc_TypeError, "unable to instantiate PyPointlessTableRow directly");
+	return -1;
+}
+
+// returns -1 on error, 0 if the table has no such key, 1 otherwise
+static int PyPointlessTable_column_index(PyPointlessTable* t, PyObject* key, uint32_t* column)
+{
+	// prepared keys are looked up by the key they wrap
+	if (PyPointlessKey_Check(key))
+		key = ((PyPointlessKey*)key)->key;
+
+	// keys are few and looked up once per row, so build a dictionary on first use
+	if (t->key_index == 0) {
+		pointless_value_t* keys = pointless_reader_table_keys(&t->pp->p, t->v);
+		uint32_t i, n_keys = pointless_reader_vector_n_items(&t->pp->p, keys);
+		PyObject* key_index = PyDict_New();
+
+		if (key_index == 0)
+			return -1;
+
+		for (i = 0; i < n_keys; i++) {
+			PyObject* k = pypointless_vector_item(t->pp, keys, i);
+			PyObject* c = PyInt_FromLong((long)i);
+
+			if (k == 0 || c == 0 || PyDict_SetItem(key_index, k, c) != 0) {
+				Py_XDECREF(k);
+				Py_XDECREF(c);
+				Py_DECREF(key_index);
+				return -1;
+			}
+
+			Py_DECREF(k);
+			Py_DECREF(c);
+		}
+
+		t->key_index = key_index;
+	}
+
+	PyObject* c = PyDict_GetItem(t->key_index, key);
+
+	if (c == 0)
+		return PyErr_Occurred() ? -1 : 0;
+
+	*column = (uint32_t)PyInt_AS_LONG(c);
+	return 1;
+}
+
+static PyObject* PyPointlessTable_keys_list(PyPointlessTable* t)
+{
+	pointless_value_t* keys = pointless_reader_table_keys(&t->pp->p, t->v);
+	uint32_t i, n_keys = pointless_reader_vector_n_items(&t->pp->p, keys);
+	PyObject* list = PyList_New(n_keys);
+
+	if (list == 0)
+		return 0;
+
+	for (i = 0; i < n_keys; i++) {
+		PyObject* k = pypointless_vector_item(t->pp, keys, i);
+
+		if (k == 0) {
+			Py_DECREF(list);
+			return 0;
+		}
+
+		PyList_SET_ITEM(list, i, k);
+	}
+
+	return list;
+}
+
+static PyPointlessTableRow* PyPointlessTableRow_New(PyPointlessTable* t, uint32_t row)
+{
+	PyPointlessTableRow* r = PyObject_New(PyPointlessTableRow, &PyPointlessTableRowType);
+
+	if (r == 0)
+		return 0;
+
+	Py_INCREF(t);
+	r->table = t;
+	r->row = row;
+
+	return r;
+}
+
+static Py_ssize_t PyPointlessTable_length(PyPointlessTable* self)
+{
+	return (Py_ssize_t)pointless_reader_table_n_rows(&self->pp->p, self->v);
+}
+
+static PyObject* PyPointlessTable_item(PyPointlessTable* self, Py_ssize_t i)
+{
+	if (!(0 <= i && i < (Py_ssize_t)pointless_reader_table_n_rows(&self->pp->p, self->v))) {
+		PyErr_SetString(PyExc_IndexError, "table index out of range");
+		return 0;
+	}
+
+	return (PyObject*)PyPointlessTableRow_New(self, (uint32_t)i);
+}
+
+static PyObject* PyPointlessTable_keys(PyPointlessTable* self)
+{
+	return PyPointlessTable_keys_list(self);
+}
+
+static PyObject* PyPointlessTable_column(PyPointlessTable* self, PyObject* key)
+{
+	uint32_t c = 0;
+	int i = PyPointlessTable_column_index(self, key, &c);
+
+	if (i == -1)
+		return 0;
+
+	if (i == 0) {
+		PyErr_SetObject(PyExc_KeyError, key);
+		return 0;
+	}
+
+	// columns are plain vectors, so this is zero-copy and supports the primitive vector operations
+	pointless_value_t* column = pointless_reader_table_columns(&self->pp->p, self->v) + c;
+	return (PyObject*)PyPointlessVector_New(self->pp, column, 0, pointless_reader_vector_n_items(&self->pp->p, column));
+}
+
+static PyMemberDef PyPointlessTable_memberlist[] = {
+	{"container_id",  T_ULONG, offsetof(PyPointlessTable, container_id), READONLY},
+	{NULL}
+};
+
+static PyMethodDef PyPointlessTable_methods[] = {
+	{"keys",   (PyCFunction)PyPointlessTable_keys,   METH_NOARGS, "column keys, in column order"},
+	{"column", (PyCFunction)PyPointlessTable_column, METH_O,      "column vector for a key"},
+	{NULL, NULL}
+};
+
+static PySequenceMethods PyPointlessTable_as_sequence = {
+	(lenfunc)PyPointlessTable_length,    /* sq_length */
+	0,                                   /* sq_concat */
+	0,                                   /* sq_repeat */
+	(ssizeargfunc)PyPointlessTable_item, /* sq_item */
+	0,                                   /* sq_slice */
+	0,                                   /* sq_ass_item */
+	0,                                   /* sq_ass_slice */
+	0,                                   /* sq_contains */
+};
+
+PyTypeObject PyPointlessTableType = {
+	PyObject_HEAD_INIT(NULL)
+	0,                                     /*ob_size*/
+	"pointless.PyPointlessTable",          /*tp_name*/
+	sizeof(PyPointlessTable),              /*tp_basicsize*/
+	0,                                     /*tp_itemsize*/
+	(destructor)PyPointlessTable_dealloc,  /*tp_dealloc*/
+	0,                                     /*tp_print*/
+	0,                                     /*tp_getattr*/
+	0,                                     /*tp_setattr*/
+	0,                                     /*tp_compare*/
+	PyPointless_repr,                      /*tp_repr*/
+	0,                                     /*tp_as_number*/
+	&PyPointlessTable_as_sequence,         /*tp_as_sequence*/
+	0,                                     /*tp_as_mapping*/
+	0,                                     /*tp_hash */
+	0,                                     /*tp_call*/
+	PyPointless_str,                       /*tp_str*/
+	0,                                     /*tp_getattro*/
+	0,                                     /*tp_setattro*/
+	0,                                     /*tp_as_buffer*/
+	Py_TPFLAGS_DEFAULT,                    /*tp_flags*/
+	"PyPointlessTable wrapper",            /*tp_doc */
+	0,                                     /*tp_traverse */
+	0,                                     /*tp_clear */
+	0,                                     /*tp_richcompare */
+	0,                                     /*tp_weaklistoffset */
+	0,                                     /*tp_iter */
+	0,                                     /*tp_iternext */
+	PyPointlessTable_methods,              /*tp_methods */
+	PyPointlessTable_memberlist,           /*tp_members */
+	0,                                     /*tp_getset */
+	0,                                     /*tp_base */
+	0,                                     /*tp_dict */
+	0,                                     /*tp_descr_get */
+	0,                                     /*tp_descr_set */
+	0,                                     /*tp_dictoffset */
+	(initproc)PyPointlessTable_init,       /*tp_init */
+	0,                                     /*tp_alloc */
+	PyPointlessTable_new,                  /*tp_new */
+};
+
+// rows are read-only views, a single row behaves like a map from keys to the values in that row
+
+static Py_ssize_t PyPointlessTableRow_length(PyPointlessTableRow* self)
+{
+	return (Py_ssize_t)pointless_reader_table_n_columns(&self->table->pp->p, self->table->v);
+}
+
+static PyObject* PyPointlessTableRow_value(PyPointlessTableRow* self, uint32_t c)
+{
+	pointless_value_t* columns = pointless_reader_table_columns(&self->table->pp->p, self->table->v);
+	return pypointless_vector_item(self->table->pp, columns + c, self->row);
+}
+
+static PyObject* PyPointlessTableRow_subscript(PyPointlessTableRow* self, PyObject* key)
+{
+	uint32_t c = 0;
+	int i = PyPointlessTable_column_index(self->table, key, &c);
+
+	if (i == -1)
+		return 0;
+
+	if (i == 0) {
+		PyErr_SetObject(PyExc_KeyError, key);
+		return 0;
+	}
+
+	return PyPointlessTableRow_value(self, c);
+}
+
+static int PyPointlessTableRow_contains_(PyPointlessTableRow* self, PyObject* key)
+{
+	uint32_t c = 0;
+	return PyPointlessTable_column_index(self->table, key, &c);
+}
+
+static PyObject* PyPointlessTableRow_contains(PyPointlessTableRow* self, PyObject* key)
+{
+	int i = PyPointlessTableRow_contains_(self, key);
+
+	if (i == -1)
+		return 0;
+
+	return PyBool_FromLong(i);
+}
+
+static PyObject* PyPointlessTableRow_get(PyPointlessTableRow* self, PyObject* args)
+{
+	PyObject* key;
+	PyObject* failobj = Py_None;
+	uint32_t c = 0;
+
+	if (!PyArg_UnpackTuple(args, "get", 1, 2, &key, &failobj))
+		return NULL;
+
+	int i = PyPointlessTable_column_index(self->table, key, &c);
+
+	if (i == -1)
+		return 0;
+
+	if (i == 0) {
+		Py_INCREF(failobj);
+		return failobj;
+	}
+
+	return PyPointlessTableRow_value(self, c);
+}
+
+static PyObject* PyPointlessTableRow_keys(PyPointlessTableRow* self)
+{
+	return PyPointlessTable_keys_list(self->table);
+}
+
+static PyObject* PyPointlessTableRow_values(PyPointlessTableRow* self)
+{
+	uint32_t i, n_columns = pointless_reader_table_n_columns(&self->table->pp->p, self->table->v);
+	PyObject* list = PyList_New(n_columns);
+
+	if (list == 0)
+		return 0;
+
+	for (i = 0; i < n_columns; i++) {
+		PyObject* v = PyPointlessTableRow_value(self, i);
+
+		if (v == 0) {
+			Py_DECREF(list);
+			return 0;
+		}
+
+		PyList_SET_ITEM(list, i, v);
+	}
+
+	return list;
+}
+
+static PyObject* PyPointlessTableRow_items(PyPointlessTableRow* self)
+{
+	PyObject* keys = PyPointlessTableRow_keys(self);
+	PyObject* values = PyPointlessTableRow_values(self);
+	PyObject* list = 0;
+	Py_ssize_t i;
+
+	if (keys == 0 || values == 0)
+		goto cleanup;
+
+	list = PyList_New(PyList_GET_SIZE(keys));
+
+	if (list == 0)
+		goto cleanup;
+
+	for (i = 0; i < PyList_GET_SIZE(keys); i++) {
+		PyObject* item = PyTuple_Pack(2, PyList_GET_ITEM(keys, i), PyList_GET_ITEM(values, i));
+
+		if (item == 0) {
+			Py_CLEAR(list);
+			goto cleanup;
+		}
+
+		PyList_SET_ITEM(list, i, item);
+	}
+
+cleanup:
+	Py_XDECREF(keys);
+	Py_XDECREF(values);
+	return list;
+}
+
+static PyObject* PyPointlessTableRow_iter(PyPointlessTableRow* self)
+{
+	PyObject* keys = PyPointlessTableRow_keys(self);
+	PyObject* iter = 0;
+
+	if (keys == 0)
+		return 0;
+
+	iter = PyObject_GetIter(keys);
+	Py_DECREF(keys);
+	return iter;
+}
+
+static PyMemberDef PyPointlessTableRow_memberlist[] = {
+	{"row",  T_UINT, offsetof(PyPointlessTableRow, row), READONLY},
+	{NULL}
+};
+
+static PyMappingMethods PyPointlessTableRow_as_mapping = {
+	(lenfunc)PyPointlessTableRow_length,       /*mp_length*/
+	(binaryfunc)PyPointlessTableRow_subscript, /*mp_subscript*/
+	(objobjargproc)0,                          /*mp_ass_subscript*/
+};
+
+static PyMethodDef PyPointlessTableRow_methods[] = {
+	{"__contains__", (PyCFunction)PyPointlessTableRow_contains,  METH_O | METH_COEXIST, ""},
+	{"__getitem__",  (PyCFunction)PyPointlessTableRow_subscript, METH_O | METH_COEXIST, ""},
+	{"get",          (PyCFunction)PyPointlessTableRow_get,       METH_VARARGS, ""},
+	{"keys",         (PyCFunction)PyPointlessTableRow_keys,      METH_NOARGS, ""},
+	{"items",        (PyCFunction)PyPointlessTableRow_items,     METH_NOARGS, ""},
+	{"values",       (PyCFunction)PyPointlessTableRow_values,    METH_NOARGS, ""},
+	{NULL, NULL}
+};
+
+static PySequenceMethods PyPointlessTableRow_as_sequence = {
+	0,                                         /* sq_length */
+	0,                                         /* sq_concat */
+	0,                                         /* sq_repeat */
+	0,                                         /* sq_item */
+	0,                                         /* sq_slice */
+	0,                                         /* sq_ass_item */
+	0,                                         /* sq_ass_slice */
+	(objobjproc)PyPointlessTableRow_contains_, /* sq_contains */
+};
+
+PyTypeObject PyPointlessTableRowType = {
+	PyObject_HEAD_INIT(NULL)
+	0,                                        /*ob_size*/
+	"pointless.PyPointlessTableRow",          /*tp_name*/
+	sizeof(PyPointlessTableRow),              /*tp_basicsize*/
+	0,                                        /*tp_itemsize*/
+	(destructor)PyPointlessTableRow_dealloc,  /*tp_dealloc*/
+	0,                                        /*tp_print*/
+	0,                                        /*tp_getattr*/
+	0,                                        /*tp_setattr*/
+	0,                                        /*tp_compare*/
+	PyPointless_repr,                         /*tp_repr*/
+	0,                                        /*tp_as_number*/
+	&PyPointlessTableRow_as_sequence,         /*tp_as_sequence*/
+	&PyPointlessTableRow_as_mapping,          /*tp_as_mapping*/
+	0,                                        /*tp_hash */
+	0,                                        /*tp_call*/
+	PyPointless_str,                          /*tp_str*/
+	0,                                        /*tp_getattro*/
+	0,                                        /*tp_setattro*/
+	0,                                        /*tp_as_buffer*/
+	Py_TPFLAGS_DEFAULT,                       /*tp_flags*/
+	"PyPointlessTableRow",                    /*tp_doc */
+	0,                                        /*tp_traverse */
+	0,                                        /*tp_clear */
+	0,                                        /*tp_richcompare */
+	0,                                        /*tp_weaklistoffset */
+	(getiterfunc)PyPointlessTableRow_iter,    /*tp_iter */
+	0,                                        /*tp_iternext */
+	PyPointlessTableRow_methods,              /*tp_methods */
+	PyPointlessTableRow_memberlist,           /*tp_members */
+	0,                                        /*tp_getset */
+	0,                                        /*tp_base */
+	0,                                        /*tp_dict */
+	0,                                        /*tp_descr_get */
+	0,                                        /*tp_descr_set */
+	0,                                        /*tp_dictoffset */
+	(initproc)PyPointlessTableRow_init,       /*tp_init */
+	0,                                        /*tp_alloc */
+	PyPointlessTableRow_new,                  /*tp_new */
+};
+
+PyPointlessTable* PyPointlessTable_New(PyPointless* pp, pointless_value_t* v)
+{
+	PyPointlessTable* pt = PyObject_New(PyPointlessTable, &PyPointlessTableType);
+
+	if (pt == 0)
+		return 0;
+
+	// tables live in the vector ID space, so they are accounted for as vectors
+	Py_INCREF(pp);
+	pp->n_vector_refs += 1;
+	pt->pp = pp;
+	pt->v = v;
+	pt->key_index = 0;
+
+	pt->container_id = pointless_container_id(&pp->p, v);
+
+	return pt;
+}
@@ -98,34 +98,7 @@ static int PyPointlessVector_check_index(PyPointlessVector* self, PyObject* item
 
 static PyObject* PyPointlessVector_subscript_priv(PyPointlessVector* self, uint32_t i)
 {
-	i += self->slice_i;
-
-	switch (self->v->type) {
-		case POINTLESS_VECTOR_VALUE:
-		case POINTLESS_VECTOR_VALUE_HASHABLE:
-			return pypointless_value(self->pp, pointless_reader_vector_value(&self->pp->p, self->v) + i);
-		case POINTLESS_VECTOR_I8:
-			return pypointless_i32(self->pp, (int32_t)pointless_reader_vector_i8(&self->pp->p, self->v)[i]);
-		case POINTLESS_VECTOR_U8:
-			return pypointless_u32(self->pp, (uint32_t)pointless_reader_vector_u8(&self->pp->p, self->v)[i]);
-		case POINTLESS_VECTOR_I16:
-			return pypointless_i32(self->pp, (int32_t)pointless_reader_vector_i16(&self->pp->p, self->v)[i]);
-		case POINTLESS_VECTOR_U16:
-			return pypointless_u32(self->pp, (uint32_t)pointless_reader_vector_u16(&self->pp->p, self->v)[i]);
-		case POINTLESS_VECTOR_I32:
-			return pypointless_i32(self->pp, pointless_reader_vector_i32(&self->pp->p, self->v)[i]);
-		case POINTLESS_VECTOR_U32:
-			return pypointless_u32(self->pp, pointless_reader_vector_u32(&self->pp->p, self->v)[i]);
-		case POINTLESS_VECTOR_I64:
-			return pypointless_i64(self->pp, pointless_reader_vector_i64(&self->pp->p, self->v)[i]);
-		case POINTLESS_VECTOR_U64:
-			return pypointless_u64(self->pp, pointless_reader_vector_u64(&self->pp->p, self->v)[i]);
-		case POINTLESS_VECTOR_FLOAT:
-			return pypointless_float(self->pp, pointless_reader_vector_float(&self->pp->p, self->v)[i]);
-	}
-
-	PyErr_Format(PyExc_TypeError, "strange array type");
-	return 0;
+	return pypointless_vector_item(self->pp, self->v, i + self->slice_i);
 }
 
 static PyObject* PyPointlessVector_subscript(PyPointlessVector* self, PyObject* item)
@@ -327,6 +300,10 @@ static PyObject* PyPointlessVector_get_typecode(PyPointlessVector* a, void* clos
 	switch (a->v->type) {
 		case POINTLESS_VECTOR_VALUE:
 		case POINTLESS_VECTOR_VALUE_HASHABLE:
+		case POINTLESS_VECTOR_DICTIONARY:
+		case POINTLESS_VECTOR_RUNS:
+		case POINTLESS_VECTOR_SPLIT:
+		case POINTLESS_VECTOR_BLOCKS:
 			e = "this is a value-based vector";
 			break;
 		case POINTLESS_VECTOR_EMPTY:
@@ -359,6 +336,10 @@ static int pointless_is_prim_vector(pointless_value_t* v)
 	switch (v->type) {
 		case POINTLESS_VECTOR_VALUE:
 		case POINTLESS_VECTOR_VALUE_HASHABLE:
+		case POINTLESS_VECTOR_DICTIONARY:
+		case POINTLESS_VECTOR_RUNS:
+		case POINTLESS_VECTOR_SPLIT:
+		case POINTLESS_VECTOR_BLOCKS:
 			return 0;
 		case POINTLESS_VECTOR_EMPTY:
 		case POINTLESS_VECTOR_I8:
@@ -409,6 +390,10 @@ static void* pointless_prim_vector_base_ptr(PyPointlessVector* self)
 	switch (self->v->type) {
 		case POINTLESS_VECTOR_VALUE:
 		case POINTLESS_VECTOR_VALUE_HASHABLE:
+		case POINTLESS_VECTOR_DICTIONARY:
+		case POINTLESS_VECTOR_RUNS:
+		case POINTLESS_VECTOR_SPLIT:
+		case POINTLESS_VECTOR_BLOCKS:
 			assert(0);
 			return 0;
 		case POINTLESS_VECTOR_EMPTY: return 0;
@@ -480,70 +465,29 @@ static PyObject* PyPointlessVector_sizeof(PyPointlessVector* self)
 	return PyLong_FromSize_t(sizeof(PyPointlessVector));
 }
 
-#define POINTLESS_VECTOR_MAX_LOOP(T, v, n) \
-	{\
-		m_i = 0;\
-		for (i = 1; i < (n); i++) {\
-			if (((T*)(v))[i] > ((T*)(v))[m_i])\
-				m_i = i;\
-		}\
-	}\
-
-#define POINTLESS_VECTOR_MIN_LOOP(T, v, n) \
-	{\
-		m_i = 0;\
-		for (i = 1; i < (n); i++) {\
-			if (((T*)(v))[i] < ((T*)(v))[m_i])\
-				m_i = i;\
-		}\
-	}\
-
-static PyObject* PyPointlessVector_max(PyPointlessVector* self)
+static int pointless_vector_check_prim(PyPointlessVector* self)
 {
 	if (!pointless_is_prim_vector(self->v)) {
 		PyErr_SetString(PyExc_ValueError, "only primitive vectors support this operation");
 		return 0;
 	}
 
-	size_t i, m_i, n_items = self->slice_n;
-	void* base_ptr = pointless_prim_vector_base_ptr(self);
+	return 1;
+}
+
+#define POINTLESS_VECTOR_OPS_ARGS(self) pointless_prim_vector_base_ptr(self), (self)->v->type, (self)->slice_n
 
-	if (n_items == 0) {
-		PyErr_SetString(PyExc_ValueError, "vector is empty");
+static PyObject* PyPointlessVector_max(PyPointlessVector* self)
+{
+	size_t m_i = 0;
+	const char* error = 0;
+
+	if (!pointless_vector_check_prim(self))
 		return 0;
-	}
 
-	switch (self->v->type) {
-		case POINTLESS_VECTOR_I8:
-			POINTLESS_VECTOR_MAX_LOOP(int8_t, base_ptr, n_items);
-			break;
-		case POINTLESS_VECTOR_U8:
-			POINTLESS_VECTOR_MAX_LOOP(uint8_t, base_ptr, n_items);
-			break;
-		case POINTLESS_VECTOR_I16:
-			POINTLESS_VECTOR_MAX_LOOP(int16_t, base_ptr, n_items);
-			break;
-		case POINTLESS_VECTOR_U16:
-			POINTLESS_VECTOR_MAX_LOOP(uint16_t, base_ptr, n_items);
-			break;
-		case POINTLESS_VECTOR_I32:
-			POINTLESS_VECTOR_MAX_LOOP(int32_t, base_ptr, n_items);
-			break;
-		case POINTLESS_VECTOR_U32:
-			POINTLESS_VECTOR_MAX_LOOP(uint32_t, base_ptr, n_items);
-			break;
-		case POINTLESS_VECTOR_I64:
-			POINTLESS_VECTOR_MAX_LOOP(int64_t, base_ptr, n_items);
-			break;
-		case POINTLESS_VECTOR_U64:
-			POINTLESS_VECTOR_MAX_LOOP(uint64_t, base_ptr, n_items);
-			break;
-		case POINTLESS_VECTOR_FLOAT:
-			POINTLESS_VECTOR_MAX_LOOP(float, base_ptr, n_items);
-			break;
-		default:
-			PyErr_BadInternalCall();
-			return 0;
+	if (!pointless_vector_argmax(POINTLESS_VECTOR_OPS_ARGS(self), &m_i, &error)) {
+		PyErr_SetString(PyExc_ValueError, error);
+		return 0;
 	}
 
 	return PyPointlessVector_subscript_priv(self, m_i);
@@ -551,53 +495,74 @@ static PyObject* PyPointlessVector_max(PyPointlessVector* self)
 
 static PyObject* PyPointlessVector_min(PyPointlessVector* self)
 {
-	if (!pointless_is_prim_vector(self->v)) {
-		PyErr_SetString(PyExc_ValueError, "only primitive vectors support this operation");
+	size_t m_i = 0;
+	const char* error = 0;
+
+	if (!pointless_vector_check_prim(self))
+		return 0;
+
+	if (!pointless_vector_argmin(POINTLESS_VECTOR_OPS_ARGS(self), &m_i, &error)) {
+		PyErr_SetString(PyExc_ValueError, error);
 		return 0;
 	}
 
-	size_t i, m_i, n_items = self->slice_n;
-	void* base_ptr = pointless_prim_vector_base_ptr(self);
+	return PyPointlessVector_subscript_priv(self, m_i);
+}
+
+static PyObject* PyPointlessVector_sum(PyPointlessVector* self)
+{
+	if (!pointless_vector_check_prim(self))
+		return 0;
 
-	if (n_items == 0) {
-		PyErr_SetString(PyExc_ValueError, "vector is empty");
+	return pypointless_vector_ops_sum(POINTLESS_VECTOR_OPS_ARGS(self));
+}
+
+static PyObject* PyPointlessVector_argmax(PyPointlessVector* self)
+{
+	if (!pointless_vector_check_prim(self))
 		return 0;
-	}
 
-	switch (self->v->type) {
-		case POINTLESS_VECTOR_I8:
-			POINTLESS_VECTOR_MIN_LOOP(int8_t, base_ptr, n_items);
-			break;
-		case POINTLESS_VECTOR_U8:
-			POINTLESS_VECTOR_MIN_LOOP(uint8_t, base_ptr, n_items);
-			break;
-		case POINTLESS_VECTOR_I16:
-			POINTLESS_VECTOR_MIN_LOOP(int16_t, base_ptr, n_items);
-			break;
-		case POINTLESS_VECTOR_U16:
-			POINTLESS_VECTOR_MIN_LOOP(uint16_t, base_ptr, n_items);
-			break;
-		case POINTLESS_VECTOR_I32:
-			POINTLESS_VECTOR_MIN_LOOP(int32_t, base_ptr, n_items);
-			break;
-		case POINTLESS_VECTOR_U32:
-			POINTLESS_VECTOR_MIN_LOOP(uint32_t, base_ptr, n_items);
-			break;
-		case POINTLESS_VECTOR_I64:
-			POINTLESS_VECTOR_MIN_LOOP(int64_t, base_ptr, n_items);
-			break;
-		case POINTLESS_VECTOR_U64:
-			POINTLESS_VECTOR_MIN_LOOP(uint64_t, base_ptr, n_items);
-			break;
-		case POINTLESS_VECTOR_FLOAT:
-			POINTLESS_VECTOR_MIN_LOOP(float, base_ptr, n_items);
-			break;
-		default:
-			PyErr_BadInternalCall();
-			return 0;
-	}
+	return pypointless_vector_ops_argmax(POINTLESS_VECTOR_OPS_ARGS(self));
+}
 
-	return PyPointlessVector_subscript_priv(self, m_i);
+static PyObject* PyPointlessVector_argmin(PyPointlessVector* self)
+{
+	if (!pointless_vector_check_prim(self))
+		return 0;
+
+	return pypointless_vector_ops_argmin(POINTLESS_VECTOR_OPS_ARGS(self));
+}
+
+static PyObject* PyPointlessVector_count_range(PyPointlessVector* self, PyObject* args)
+{
+	if (!pointless_vector_check_prim(self))
+		return 0;
+
+	return pypointless_vector_ops_count_range(POINTLESS_VECTOR_OPS_ARGS(self), args);
+}
+
+static PyObject* PyPointlessVector_filter(PyPointlessVector* self, PyObject* args)
+{
+	if (!pointless_vector_check_prim(self))
+		return 0;
+
+	return pypointless_vector_ops_filter(POINTLESS_VECTOR_OPS_ARGS(self), args);
+}
+
+static PyObject* PyPointlessVector_filter_range(PyPointlessVector* self, PyObject* args)
+{
+	if (!pointless_vector_check_prim(self))
+		return 0;
+
+	return pypointless_vector_ops_filter_range(POINTLESS_VECTOR_OPS_ARGS(self), args);
+}
+
+static PyObject* PyPointlessVector_histogram(PyPointlessVector* self, PyObject* args)
+{
+	if (!pointless_vector_check_prim(self))
+		return 0;
+
+	return pypointless_vector_ops_histogram(POINTLESS_VECTOR_OPS_ARGS(self), args);
 }
 
 static int parse_pyobject_number(PyObject* v, int* is_signed, int64_t* i, uint64_t* u)
@@ -701,6 +666,13 @@ static PyMemberDef PyPointlessVector_memberlist[] = {
 static PyMethodDef PyPointlessVector_methods[] = {
 	{"max",         (PyCFunction)PyPointlessVector_max,      METH_NOARGS,  ""}, 
 	{"min",         (PyCFunction)PyPointlessVector_min,      METH_NOARGS,  ""}, 
+	{"sum",         (PyCFunction)PyPointlessVector_sum,      METH_NOARGS,  ""},
+	{"argmax",      (PyCFunction)PyPointlessVector_argmax,   METH_NOARGS,  ""},
+	{"argmin",      (PyCFunction)PyPointlessVector_argmin,   METH_NOARGS,  ""},
+	{"count_range", (PyCFunction)PyPointlessVector_count_range,  METH_VARARGS, ""},
+	{"filter",      (PyCFunction)PyPointlessVector_filter,       METH_VARARGS, ""},
+	{"filter_range", (PyCFunction)PyPointlessVector_filter_range, METH_VARARGS, ""},
+	{"histogram",   (PyCFunction)PyPointlessVector_histogram,    METH_VARARGS, ""},
 	{"bisect_left", (PyCFunction)PyPointlessVector_bisect_left,      METH_VARARGS,  ""}, 
 	{"__sizeof__",  (PyCFunction)PyPointlessVector_sizeof,   METH_NOARGS,  ""}, 
 	{NULL, NULL}
@@ -0,0 +1,232 @@
+#include "pointless/pointless_ext.h"
+
+// Python bindings for the primitive vector operations, shared by PyPointlessPrimVector and PyPointlessVector
+
+static int pypointless_vector_ops_number(PyObject* o, pointless_vector_number_t* n)
+{
+	if (PyFloat_Check(o)) {
+		*n = pointless_vector_number_double(PyFloat_AS_DOUBLE(o));
+		return 1;
+	}
+
+	if (PyInt_Check(o)) {
+		long v = PyInt_AS_LONG(o);
+
+		if (v < 0)
+			*n = pointless_vector_number_i64((int64_t)v);
+		else
+			*n = pointless_vector_number_u64((uint64_t)v);
+
+		return 1;
+	}
+
+	if (PyLong_Check(o)) {
+		PY_LONG_LONG ii = PyLong_AsLongLong(o);
+		unsigned PY_LONG_LONG uu = 0;
+
+		if (!PyErr_Occurred()) {
+			if (ii < 0)
+				*n = pointless_vector_number_i64((int64_t)ii);
+			else
+				*n = pointless_vector_number_u64((uint64_t)ii);
+
+			return 1;
+		}
+
+		PyErr_Clear();
+
+		uu = PyLong_AsUnsignedLongLong(o);
+
+		if (!PyErr_Occurred()) {
+			*n = pointless_vector_number_u64((uint64_t)uu);
+			return 1;
+		}
+
+		PyErr_Clear();
+
+		// outside of 64 bits, it is above or below all vector items
+		*n = pointless_vector_number_double(_PyLong_Sign(o) < 0 ? -INFINITY : INFINITY);
+		return 1;
+	}
+
+	PyErr_Format(PyExc_TypeError, "expected a number, got <%s>", o->ob_type->tp_name);
+	return 0;
+}
+
+static PyObject* pypointless_vector_ops_number_to_py(pointless_vector_number_t n)
+{
+	switch (n.type) {
+		case POINTLESS_VECTOR_NUMBER_I64:
+			return PyLong_FromLongLong((PY_LONG_LONG)n.data.i);
+		case POINTLESS_VECTOR_NUMBER_U64:
+			return PyLong_FromUnsignedLongLong((unsigned PY_LONG_LONG)n.data.u);
+		case POINTLESS_VECTOR_NUMBER_DOUBLE:
+			return PyFloat_FromDouble(n.data.f);
+	}
+
+	PyErr_BadInternalCall();
+	return 0;
+}
+
+static int pypointless_vector_ops_op(const char* s, uint32_t* op)
+{
+	if (strcmp(s, "==") == 0)
+		*op = POINTLESS_VECTOR_OP_EQ;
+	else if (strcmp(s, "!=") == 0)
+		*op = POINTLESS_VECTOR_OP_NE;
+	else if (strcmp(s, "<") == 0)
+		*op = POINTLESS_VECTOR_OP_LT;
+	else if (strcmp(s, "<=") == 0)
+		*op = POINTLESS_VECTOR_OP_LE;
+	else if (strcmp(s, ">") == 0)
+		*op = POINTLESS_VECTOR_OP_GT;
+	else if (strcmp(s, ">=") == 0)
+		*op = POINTLESS_VECTOR_OP_GE;
+	else {
+		PyErr_Format(PyExc_ValueError, "unknown operator '%s', expected one of ==, !=, <, <=, >, >=", s);
+		return 0;
+	}
+
+	return 1;
+}
+
+PyObject* pypointless_vector_ops_sum(void* v, uint32_t type, size_t n)
+{
+	pointless_vector_number_t sum;
+	const char* error = 0;
+
+	if (!pointless_vector_sum(v, type, n, &sum, &error)) {
+		PyErr_SetString(PyExc_ValueError, error);
+		return 0;
+	}
+
+	return pypointless_vector_ops_number_to_py(sum);
+}
+
+PyObject* pypointless_vector_ops_argmin(void* v, uint32_t type, size_t n)
+{
+	size_t i = 0;
+	const char* error = 0;
+
+	if (!pointless_vector_argmin(v, type, n, &i, &error)) {
+		PyErr_SetString(PyExc_ValueError, error);
+		return 0;
+	}
+
+	return PyLong_FromSize_t(i);
+}
+
+PyObject* pypointless_vector_ops_argmax(void* v, uint32_t type, size_t n)
+{
+	size_t i = 0;
+	const char* error = 0;
+
+	if (!pointless_vector_argmax(v, type, n, &i, &error)) {
+		PyErr_SetString(PyExc_ValueError, error);
+		return 0;
+	}
+
+	return PyLong_FromSize_t(i);
+}
+
+PyObject* pypointless_vector_ops_count_range(void* v, uint32_t type, size_t n, PyObject* args)
+{
+	PyObject* lo = 0;
+	PyObject* hi = 0;
+	pointless_vector_number_t a, b;
+	size_t count = 0;
+	const char* error = 0;
+
+	if (!PyArg_ParseTuple(args, "OO:count_range", &lo, &hi))
+		return 0;
+
+	if (!pypointless_vector_ops_number(lo, &a) || !pypointless_vector_ops_number(hi, &b))
+		return 0;
+
+	if (!pointless_vector_count(v, type, n, POINTLESS_VECTOR_OP_RANGE, a, b, &count, &error)) {
+		PyErr_SetString(PyExc_ValueError, error);
+		return 0;
+	}
+
+	return PyLong_FromSize_t(count);
+}
+
+static PyObject* pypointless_vector_ops_filter_priv(void* v, uint32_t type, size_t n, uint32_t op, pointless_vector_number_t a, pointless_vector_number_t b)
+{
+	pointless_dynarray_t indices;
+	const char* error = 0;
+
+	pointless_dynarray_init(&indices, sizeof(uint32_t));
+
+	if (!pointless_vector_filter(v, type, n, op, a, b, &indices, &error)) {
+		pointless_dynarray_destroy(&indices);
+		PyErr_SetString(PyExc_ValueError, error);
+		return 0;
+	}
+
+	return (PyObject*)PyPointlessPrimVector_from_T_vector(&indices, POINTLESS_PRIM_VECTOR_TYPE_U32);
+}
+
+PyObject* pypointless_vector_ops_filter(void* v, uint32_t type, size_t n, PyObject* args)
+{
+	const char* op_s = 0;
+	PyObject* value = 0;
+	pointless_vector_number_t a;
+	uint32_t op = 0;
+
+	if (!PyArg_ParseTuple(args, "sO:filter", &op_s, &value))
+		return 0;
+
+	if (!pypointless_vector_ops_op(op_s, &op) || !pypointless_vector_ops_number(value, &a))
+		return 0;
+
+	return pypointless_vector_ops_filter_priv(v, type, n, op, a, a);
+}
+
+PyObject* pypointless_vector_ops_filter_range(void* v, uint32_t type, size_t n, PyObject* args)
+{
+	PyObject* lo = 0;
+	PyObject* hi = 0;
+	pointless_vector_number_t a, b;
+
+	if (!PyArg_ParseTuple(args, "OO:filter_range", &lo, &hi))
+		return 0;
+
+	if (!pypointless_vector_ops_number(lo, &a) || !pypointless_vector_ops_number(hi, &b))
+		return 0;
+
+	return pypointless_vector_ops_filter_priv(v, type, n, POINTLESS_VECTOR_OP_RANGE, a, b);
+}
+
+PyObject* pypointless_vector_ops_histogram(void* v, uint32_t type, size_t n, PyObject* args)
+{
+	double lo = 0.0, hi = 0.0;
+	unsigned int n_bins = 0;
+	pointless_dynarray_t bins;
+	uint64_t* bins_ = 0;
+	const char* error = 0;
+
+	if (!PyArg_ParseTuple(args, "ddI:histogram", &lo, &hi, &n_bins))
+		return 0;
+
+	if (n_bins == 0) {
+		PyErr_SetString(PyExc_ValueError, "histogram must have at least one bin");
+		return 0;
+	}
+
+	bins_ = (uint64_t*)pointless_malloc(sizeof(uint64_t) * n_bins);
+
+	if (bins_ == 0)
+		return PyErr_NoMemory();
+
+	if (!pointless_vector_histogram(v, type, n, lo, hi, bins_, (uint32_t)n_bins, &error)) {
+		pointless_free(bins_);
+		PyErr_SetString(PyExc_ValueError, error);
+		return 0;
+	}
+
+	pointless_dynarray_init(&bins, sizeof(uint64_t));
+	pointless_dynarray_give_data(&bins, bins_, n_bins);
+
+	return (PyObject*)PyPointlessPrimVector_from_T_vector(&bins, POINTLESS_PRIM_VECTOR_TYPE_U64);
+}
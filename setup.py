@@ -46,12 +46,15 @@ setup(
 				'python/pointless_bitvector.c',
 				'python/pointless_set.c',
 				'python/pointless_map.c',
+				'python/pointless_table.c',
+				'python/pointless_key.c',
 				'python/pointless_object.c',
 				'python/pointless_instance_dispatch.c',
 				'python/pointless_pyobject_hash.c',
 				'python/pointless_pyobject_cmp.c',
 				'python/pointless_print.c',
 				'python/pointless_prim_vector.c',
+				'python/pointless_vector_ops.c',
 
 				# libpointless
 				'src/custom_sort.c',
@@ -68,6 +71,7 @@ setup(
 				'src/pointless_hash_table.c',
 				'src/pointless_bitvector.c',
 				'src/pointless_walk.c',
+				'src/pointless_debug.c',
 				'src/pointless_cycle_marker.c',
 				'src/pointless_validate.c',
 				'src/pointless_validate_heap_ref.c',
@@ -76,7 +80,13 @@ setup(
 				'src/pointless_malloc.c',
 				'src/pointless_int_ops.c',
 				'src/pointless_recreate.c',
-				'src/pointless_eval.c'
+				'src/pointless_eval.c',
+				'src/pointless_vector_ops.c',
+				'src/pointless_prepared_key.c',
+				'src/pointless_trace.c',
+				'src/pointless_string_symbols.c',
+				'src/pointless_hash_table_stats.c',
+				'src/pointless_anatomy.c'
 			],
 
 			extra_compile_args = extra_compile_args,
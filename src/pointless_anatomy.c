@@ -0,0 +1,509 @@
+#include <pointless/pointless_anatomy.h>
+#include <pointless/pointless_reader.h>
+#include <pointless/pointless_vector_ops.h>
+#include <pointless/pointless_debug.h>
+#include <pointless/custom_sort.h>
+
+static const char* pointless_anatomy_names[POINTLESS_ANATOMY_N_CATEGORIES] = {
+	"header",
+	"offset vectors",
+	"padding",
+	"strings",
+	"compressed strings",
+	"string symbol table",
+	"unicode strings",
+	"value vectors",
+	"i8 vectors",
+	"u8 vectors",
+	"i16 vectors",
+	"u16 vectors",
+	"i32 vectors",
+	"u32 vectors",
+	"i64 vectors",
+	"u64 vectors",
+	"float vectors",
+	"dictionary vectors",
+	"run-length vectors",
+	"split vectors",
+	"block vectors",
+	"tables",
+	"bitvectors",
+	"set/map headers",
+	"hash vectors",
+	"key vectors",
+	"value vectors of maps",
+	"empty slots",
+	"bloom filters"
+};
+
+typedef struct {
+	pointless_t* p;
+	pointless_anatomy_t* a;
+	const char** error;
+
+	// a bit per heap object, strings first, then vectors, bitvectors, sets and maps, as the offset vectors
+	uint32_t* seen;
+
+	// root map entry being walked, if any
+	pointless_anatomy_entry_t* entry;
+} pointless_anatomy_state_t;
+
+const char* pointless_anatomy_category_name(uint32_t category)
+{
+	if (category >= POINTLESS_ANATOMY_N_CATEGORIES)
+		return "unknown";
+
+	return pointless_anatomy_names[category];
+}
+
+static void pointless_anatomy_add(pointless_anatomy_state_t* state, uint32_t category, uint64_t n_bytes, uint64_t n_objects)
+{
+	state->a->n_bytes[category] += n_bytes;
+	state->a->n_objects[category] += n_objects;
+
+	if (state->entry)
+		state->entry->n_bytes += n_bytes;
+}
+
+// counts an object, with 'n_empty' of its bytes being empty slots, returns 0 if it has been counted before
+static int pointless_anatomy_add_object(pointless_anatomy_state_t* state, uint64_t id, uint32_t category, uint64_t n_bytes, uint64_t n_empty)
+{
+	uint32_t* word = &state->seen[id / 32];
+	uint32_t bit = (1u << (id % 32));
+
+	if (*word & bit)
+		return 0;
+
+	*word |= bit;
+
+	assert(n_empty <= n_bytes);
+	pointless_anatomy_add(state, category, n_bytes - n_empty, 1);
+
+	if (n_empty > 0)
+		pointless_anatomy_add(state, POINTLESS_ANATOMY_EMPTY_SLOTS, n_empty, 0);
+
+	return 1;
+}
+
+static uint64_t pointless_anatomy_vector_item_size(pointless_value_t* v)
+{
+	if (v->type == POINTLESS_VECTOR_VALUE || v->type == POINTLESS_VECTOR_VALUE_HASHABLE)
+		return sizeof(pointless_value_t);
+
+	return pointless_vector_type_item_size(v->type);
+}
+
+static uint32_t pointless_anatomy_vector_category(uint32_t type)
+{
+	switch (type) {
+		case POINTLESS_VECTOR_I8:         return POINTLESS_ANATOMY_VECTOR_I8;
+		case POINTLESS_VECTOR_U8:         return POINTLESS_ANATOMY_VECTOR_U8;
+		case POINTLESS_VECTOR_I16:        return POINTLESS_ANATOMY_VECTOR_I16;
+		case POINTLESS_VECTOR_U16:        return POINTLESS_ANATOMY_VECTOR_U16;
+		case POINTLESS_VECTOR_I32:        return POINTLESS_ANATOMY_VECTOR_I32;
+		case POINTLESS_VECTOR_U32:        return POINTLESS_ANATOMY_VECTOR_U32;
+		case POINTLESS_VECTOR_I64:        return POINTLESS_ANATOMY_VECTOR_I64;
+		case POINTLESS_VECTOR_U64:        return POINTLESS_ANATOMY_VECTOR_U64;
+		case POINTLESS_VECTOR_FLOAT:      return POINTLESS_ANATOMY_VECTOR_FLOAT;
+		case POINTLESS_VECTOR_DICTIONARY: return POINTLESS_ANATOMY_VECTOR_DICTIONARY;
+		case POINTLESS_VECTOR_RUNS:       return POINTLESS_ANATOMY_VECTOR_RUNS;
+		case POINTLESS_VECTOR_SPLIT:      return POINTLESS_ANATOMY_VECTOR_SPLIT;
+		case POINTLESS_VECTOR_BLOCKS:     return POINTLESS_ANATOMY_VECTOR_BLOCKS;
+		case POINTLESS_TABLE:             return POINTLESS_ANATOMY_TABLE;
+	}
+
+	return POINTLESS_ANATOMY_VECTOR_VALUE;
+}
+
+// a plain vector, its item count followed by its items, returns 0 if it has been counted before, or is empty
+static int pointless_anatomy_add_vector(pointless_anatomy_state_t* state, pointless_value_t* v, uint32_t category, uint64_t n_empty)
+{
+	if (v->type == POINTLESS_VECTOR_EMPTY)
+		return 0;
+
+	uint64_t id = (uint64_t)state->p->header->n_string_unicode + v->data.data_u32;
+	uint64_t n_bytes = sizeof(uint32_t) + pointless_reader_vector_n_items(state->p, v) * pointless_anatomy_vector_item_size(v);
+	return pointless_anatomy_add_object(state, id, category, n_bytes, n_empty);
+}
+
+static int pointless_anatomy_value(pointless_anatomy_state_t* state, pointless_value_t* v, uint32_t vector_category);
+
+static int pointless_anatomy_vector_items(pointless_anatomy_state_t* state, pointless_value_t* v, uint32_t vector_category)
+{
+	if (v->type != POINTLESS_VECTOR_VALUE && v->type != POINTLESS_VECTOR_VALUE_HASHABLE)
+		return 1;
+
+	pointless_value_t* items = pointless_reader_vector_value(state->p, v);
+	uint32_t i, n_items = pointless_reader_vector_n_items(state->p, v);
+
+	for (i = 0; i < n_items; i++) {
+		if (!pointless_anatomy_value(state, &items[i], vector_category))
+			return 0;
+	}
+
+	return 1;
+}
+
+static void pointless_anatomy_bloom(pointless_anatomy_state_t* state, uint32_t bloom)
+{
+	if (bloom == 0)
+		return;
+
+	pointless_value_t v;
+	v.type = POINTLESS_VECTOR_U32;
+	v.data.data_u32 = bloom - 1;
+	pointless_anatomy_add_vector(state, &v, POINTLESS_ANATOMY_BLOOM, 0);
+}
+
+// the empty slots of the hash vector of a compact set/map are those of its index
+static uint64_t pointless_anatomy_compact_n_empty(uint32_t n_items)
+{
+	uint64_t n_index_bytes = (uint64_t)pointless_hash_table_compact_n_index_words(n_items) * sizeof(uint32_t);
+	return n_index_bytes - (uint64_t)n_items * pointless_hash_table_compact_slot_size(n_items);
+}
+
+// the header and vectors of a set/map, then, if 'walk' is set, its keys and values
+static int pointless_anatomy_set(pointless_anatomy_state_t* state, pointless_value_t* s, int walk)
+{
+	pointless_t* p = state->p;
+	uint64_t id = (uint64_t)p->header->n_string_unicode + p->header->n_vector + p->header->n_bitvector + s->data.data_u32;
+
+	if (!pointless_anatomy_add_object(state, id, POINTLESS_ANATOMY_HASH_TABLE_HEADER, sizeof(pointless_set_header_t), 0))
+		return 1;
+
+	pointless_value_t* hash_vector = pointless_set_hash_vector(p, s);
+	pointless_value_t* key_vector = pointless_set_key_vector(p, s);
+	uint32_t n_items = pointless_reader_set_n_items(p, s);
+	uint64_t n_hash_empty = 0, n_key_empty = 0;
+
+	if (pointless_reader_set_is_compact(p, s)) {
+		n_hash_empty = pointless_anatomy_compact_n_empty(n_items);
+	} else {
+		uint64_t n_empty = pointless_reader_set_n_buckets(p, s) - n_items;
+		n_hash_empty = n_empty * sizeof(uint32_t);
+		n_key_empty = n_empty * pointless_anatomy_vector_item_size(key_vector);
+	}
+
+	pointless_anatomy_add_vector(state, hash_vector, POINTLESS_ANATOMY_HASH_VECTOR, n_hash_empty);
+	pointless_anatomy_bloom(state, pointless_reader_set_bloom(p, s));
+
+	if (pointless_anatomy_add_vector(state, key_vector, POINTLESS_ANATOMY_KEY_VECTOR, n_key_empty) && walk)
+		return pointless_anatomy_vector_items(state, key_vector, POINTLESS_ANATOMY_N_CATEGORIES);
+
+	return 1;
+}
+
+static int pointless_anatomy_map(pointless_anatomy_state_t* state, pointless_value_t* m, int walk)
+{
+	pointless_t* p = state->p;
+	uint64_t id = (uint64_t)p->header->n_string_unicode + p->header->n_vector + p->header->n_bitvector + p->header->n_set + m->data.data_u32;
+
+	if (!pointless_anatomy_add_object(state, id, POINTLESS_ANATOMY_HASH_TABLE_HEADER, sizeof(pointless_map_header_t), 0))
+		return 1;
+
+	pointless_value_t* hash_vector = pointless_map_hash_vector(p, m);
+	pointless_value_t* key_vector = pointless_map_key_vector(p, m);
+	pointless_value_t* value_vector = pointless_map_value_vector(p, m);
+	uint32_t n_items = pointless_reader_map_n_items(p, m);
+	uint64_t n_hash_empty = 0, n_key_empty = 0, n_value_empty = 0;
+	uint64_t n_empty = pointless_reader_map_n_buckets(p, m) - n_items;
+
+	// dense maps have no key vector, but a value for every integer in their range
+	if (pointless_reader_map_is_dense(p, m)) {
+		n_value_empty = n_empty * pointless_anatomy_vector_item_size(value_vector);
+	} else if (pointless_reader_map_is_compact(p, m)) {
+		n_hash_empty = pointless_anatomy_compact_n_empty(n_items);
+	} else {
+		n_hash_empty = n_empty * sizeof(uint32_t);
+		n_key_empty = n_empty * pointless_anatomy_vector_item_size(key_vector);
+		n_value_empty = n_empty * pointless_anatomy_vector_item_size(value_vector);
+	}
+
+	pointless_anatomy_add_vector(state, hash_vector, POINTLESS_ANATOMY_HASH_VECTOR, n_hash_empty);
+	pointless_anatomy_bloom(state, pointless_reader_map_bloom(p, m));
+
+	if (!pointless_reader_map_is_dense(p, m) && pointless_anatomy_add_vector(state, key_vector, POINTLESS_ANATOMY_KEY_VECTOR, n_key_empty) && walk) {
+		if (!pointless_anatomy_vector_items(state, key_vector, POINTLESS_ANATOMY_N_CATEGORIES))
+			return 0;
+	}
+
+	if (pointless_anatomy_add_vector(state, value_vector, POINTLESS_ANATOMY_VALUE_VECTOR, n_value_empty) && walk)
+		return pointless_anatomy_vector_items(state, value_vector, POINTLESS_ANATOMY_N_CATEGORIES);
+
+	return 1;
+}
+
+// a value and the objects it refers to, vectors are counted as 'vector_category', if it is a category, and
+// as their own type otherwise
+static int pointless_anatomy_value(pointless_anatomy_state_t* state, pointless_value_t* v, uint32_t vector_category)
+{
+	pointless_t* p = state->p;
+	uint64_t heap_offset, n_bytes;
+	uint32_t category = vector_category;
+	pointless_value_t vector;
+
+	switch (v->type) {
+		case POINTLESS_STRING_:
+			n_bytes = sizeof(uint32_t) + ((uint64_t)pointless_reader_string_len(p, v) + 1) * sizeof(uint8_t);
+			pointless_anatomy_add_object(state, v->data.data_u32, POINTLESS_ANATOMY_STRING, n_bytes, 0);
+			return 1;
+		case POINTLESS_STRING_SYMBOLS:
+			heap_offset = PC_OFFSET(p, string_unicode_offsets, v->data.data_u32);
+			n_bytes = sizeof(uint32_t) + POINTLESS_STRING_SYMBOLS_N_CODES(*(uint32_t*)((char*)p->heap_ptr + heap_offset));
+			pointless_anatomy_add_object(state, v->data.data_u32, POINTLESS_ANATOMY_STRING_SYMBOLS, n_bytes, 0);
+			return 1;
+		case POINTLESS_UNICODE_:
+			n_bytes = sizeof(uint32_t) + ((uint64_t)pointless_reader_unicode_len(p, v) + 1) * sizeof(uint32_t);
+			pointless_anatomy_add_object(state, v->data.data_u32, POINTLESS_ANATOMY_UNICODE, n_bytes, 0);
+			return 1;
+		case POINTLESS_BITVECTOR:
+			n_bytes = sizeof(uint32_t) + ICEIL((uint64_t)pointless_reader_bitvector_n_bits(p, v), 8);
+			pointless_anatomy_add_object(state, (uint64_t)p->header->n_string_unicode + p->header->n_vector + v->data.data_u32, POINTLESS_ANATOMY_BITVECTOR, n_bytes, 0);
+			return 1;
+		case POINTLESS_VECTOR_VALUE:
+		case POINTLESS_VECTOR_VALUE_HASHABLE:
+		case POINTLESS_VECTOR_I8:
+		case POINTLESS_VECTOR_U8:
+		case POINTLESS_VECTOR_I16:
+		case POINTLESS_VECTOR_U16:
+		case POINTLESS_VECTOR_I32:
+		case POINTLESS_VECTOR_U32:
+		case POINTLESS_VECTOR_I64:
+		case POINTLESS_VECTOR_U64:
+		case POINTLESS_VECTOR_FLOAT:
+			if (category == POINTLESS_ANATOMY_N_CATEGORIES)
+				category = pointless_anatomy_vector_category(v->type);
+
+			if (!pointless_anatomy_add_vector(state, v, category, 0))
+				return 1;
+
+			return pointless_anatomy_vector_items(state, v, POINTLESS_ANATOMY_N_CATEGORIES);
+		// encoded vectors and tables are a value vector of vectors, the vectors of encoded vectors count as them
+		case POINTLESS_VECTOR_DICTIONARY:
+		case POINTLESS_VECTOR_RUNS:
+		case POINTLESS_VECTOR_SPLIT:
+		case POINTLESS_VECTOR_BLOCKS:
+		case POINTLESS_TABLE:
+			if (category == POINTLESS_ANATOMY_N_CATEGORIES)
+				category = pointless_anatomy_vector_category(v->type);
+
+			vector.type = POINTLESS_VECTOR_VALUE;
+			vector.data = v->data;
+
+			if (!pointless_anatomy_add_vector(state, &vector, category, 0))
+				return 1;
+
+			return pointless_anatomy_vector_items(state, &vector, (v->type == POINTLESS_TABLE) ? POINTLESS_ANATOMY_N_CATEGORIES : category);
+		case POINTLESS_SET_VALUE:
+			return pointless_anatomy_set(state, v, 1);
+		case POINTLESS_MAP_VALUE_VALUE:
+			return pointless_anatomy_map(state, v, 1);
+	}
+
+	// everything else is inline
+	return 1;
+}
+
+// the entries of a root map, each with the objects first reached from it
+static int pointless_anatomy_root_map(pointless_anatomy_state_t* state, pointless_value_t* m)
+{
+	pointless_t* p = state->p;
+	pointless_anatomy_t* a = state->a;
+	uint32_t i = 0, j = 0, entry = 0;
+
+	if (!pointless_anatomy_map(state, m, 0))
+		return 0;
+
+	a->n_entries = pointless_reader_map_n_items(p, m);
+	a->entries = (pointless_anatomy_entry_t*)pointless_calloc(a->n_entries + 1, sizeof(pointless_anatomy_entry_t));
+
+	if (a->entries == 0) {
+		*state->error = "out of memory";
+		return 0;
+	}
+
+	pointless_value_t* key_vector = pointless_map_key_vector(p, m);
+	pointless_value_t* value_vector = pointless_map_value_vector(p, m);
+	uint32_t is_value_keys = (key_vector->type == POINTLESS_VECTOR_VALUE || key_vector->type == POINTLESS_VECTOR_VALUE_HASHABLE);
+	uint32_t is_value_values = (value_vector->type == POINTLESS_VECTOR_VALUE || value_vector->type == POINTLESS_VECTOR_VALUE_HASHABLE);
+
+	while (pointless_reader_map_iter_entry(p, m, &entry, &i)) {
+		assert(j < a->n_entries);
+		state->entry = &a->entries[j++];
+		state->entry->key = pointless_reader_map_key(p, m, entry);
+
+		if (is_value_keys && !pointless_anatomy_value(state, &pointless_reader_vector_value(p, key_vector)[entry], POINTLESS_ANATOMY_N_CATEGORIES))
+			return 0;
+
+		if (is_value_values && !pointless_anatomy_value(state, &pointless_reader_vector_value(p, value_vector)[entry], POINTLESS_ANATOMY_N_CATEGORIES))
+			return 0;
+	}
+
+	state->entry = 0;
+	return 1;
+}
+
+int pointless_anatomy(pointless_t* p, pointless_anatomy_t* a, const char** error)
+{
+	pointless_header_t* h = p->header;
+	uint64_t n_objects = (uint64_t)h->n_string_unicode + h->n_vector + h->n_bitvector + h->n_set + h->n_map;
+	pointless_anatomy_state_t state;
+
+	memset(a, 0, sizeof(*a));
+
+	state.p = p;
+	state.a = a;
+	state.error = error;
+	state.entry = 0;
+	state.seen = (uint32_t*)pointless_calloc(ICEIL(n_objects, 32) + 1, sizeof(uint32_t));
+
+	if (state.seen == 0) {
+		*error = "out of memory";
+		return 0;
+	}
+
+	pointless_value_t* root = pointless_root(p);
+	int ok = (root->type == POINTLESS_MAP_VALUE_VALUE) ? pointless_anatomy_root_map(&state, root) : pointless_anatomy_value(&state, root, POINTLESS_ANATOMY_N_CATEGORIES);
+
+	// the symbol table is the last string, no value refers to it
+	if (ok && (h->version & POINTLESS_FF_STRING_SYMBOLS)) {
+		pointless_value_t table;
+		table.type = POINTLESS_STRING_;
+		table.data.data_u32 = h->n_string_unicode - 1;
+
+		uint64_t n_bytes = sizeof(uint32_t) + ((uint64_t)pointless_reader_string_len(p, &table) + 1) * sizeof(uint8_t);
+		pointless_anatomy_add_object(&state, table.data.data_u32, POINTLESS_ANATOMY_STRING_SYMBOL_TABLE, n_bytes, 0);
+	}
+
+	pointless_free(state.seen);
+
+	if (!ok) {
+		pointless_anatomy_free(a);
+		return 0;
+	}
+
+	// whatever precedes the heap, and is not header or offsets, and whatever on the heap no object accounts for
+	uint64_t heap_start = (uint64_t)((char*)p->heap_ptr - (char*)p->header);
+	uint64_t n_heap_bytes = 0;
+	uint32_t i;
+
+	a->n_bytes[POINTLESS_ANATOMY_HEADER] = sizeof(pointless_header_t);
+	a->n_objects[POINTLESS_ANATOMY_HEADER] = 1;
+
+	a->n_bytes[POINTLESS_ANATOMY_OFFSETS] += pointless_offset_vector_size(p, h->n_string_unicode);
+	a->n_bytes[POINTLESS_ANATOMY_OFFSETS] += pointless_offset_vector_size(p, h->n_vector);
+	a->n_bytes[POINTLESS_ANATOMY_OFFSETS] += pointless_offset_vector_size(p, h->n_bitvector);
+	a->n_bytes[POINTLESS_ANATOMY_OFFSETS] += pointless_offset_vector_size(p, h->n_set);
+	a->n_bytes[POINTLESS_ANATOMY_OFFSETS] += pointless_offset_vector_size(p, h->n_map);
+	a->n_objects[POINTLESS_ANATOMY_OFFSETS] = 5;
+
+	for (i = POINTLESS_ANATOMY_PADDING + 1; i < POINTLESS_ANATOMY_N_CATEGORIES; i++)
+		n_heap_bytes += a->n_bytes[i];
+
+	if (n_heap_bytes > p->heap_len) {
+		pointless_anatomy_free(a);
+		*error = "heap objects larger than the heap, file should not have passed validation";
+		return 0;
+	}
+
+	a->n_bytes[POINTLESS_ANATOMY_PADDING] = (heap_start - a->n_bytes[POINTLESS_ANATOMY_HEADER] - a->n_bytes[POINTLESS_ANATOMY_OFFSETS]) + (p->heap_len - n_heap_bytes);
+	return 1;
+}
+
+void pointless_anatomy_free(pointless_anatomy_t* a)
+{
+	pointless_free(a->entries);
+	a->entries = 0;
+	a->n_entries = 0;
+}
+
+typedef struct {
+	pointless_anatomy_t* a;
+	uint32_t* entries;
+} pointless_anatomy_sort_state_t;
+
+static int pointless_anatomy_sort_cmp(int a, int b, int* c, void* user)
+{
+	pointless_anatomy_sort_state_t* state = (pointless_anatomy_sort_state_t*)user;
+	uint64_t n_a = state->a->entries[state->entries[a]].n_bytes;
+	uint64_t n_b = state->a->entries[state->entries[b]].n_bytes;
+
+	// largest first, then in iteration order
+	*c = (n_a != n_b) ? SIMPLE_CMP(n_b, n_a) : SIMPLE_CMP(state->entries[a], state->entries[b]);
+	return 1;
+}
+
+static void pointless_anatomy_sort_swap(int a, int b, void* user)
+{
+	pointless_anatomy_sort_state_t* state = (pointless_anatomy_sort_state_t*)user;
+	uint32_t t = state->entries[a];
+	state->entries[a] = state->entries[b];
+	state->entries[b] = t;
+}
+
+static double pointless_anatomy_percent(uint64_t n, uint64_t total)
+{
+	return (total > 0) ? 100.0 * (double)n / (double)total : 0.0;
+}
+
+int pointless_anatomy_print(pointless_t* p, FILE* out, const char** error)
+{
+	pointless_anatomy_t a;
+	uint64_t total = 0, n_entry_bytes = 0;
+	uint32_t i;
+
+	if (!pointless_anatomy(p, &a, error))
+		return 0;
+
+	for (i = 0; i < POINTLESS_ANATOMY_N_CATEGORIES; i++)
+		total += a.n_bytes[i];
+
+	for (i = 0; i < POINTLESS_ANATOMY_N_CATEGORIES; i++) {
+		if (a.n_bytes[i] == 0 && a.n_objects[i] == 0)
+			continue;
+
+		fprintf(out, "%-22s %14llu bytes %6.2f%% %12llu objects\n", pointless_anatomy_category_name(i), (unsigned long long)a.n_bytes[i], pointless_anatomy_percent(a.n_bytes[i], total), (unsigned long long)a.n_objects[i]);
+	}
+
+	fprintf(out, "%-22s %14llu bytes\n", "total", (unsigned long long)total);
+
+	if (a.n_entries == 0) {
+		pointless_anatomy_free(&a);
+		return 1;
+	}
+
+	// root map entries, largest first
+	pointless_anatomy_sort_state_t sort_state;
+	sort_state.a = &a;
+	sort_state.entries = (uint32_t*)pointless_malloc(sizeof(uint32_t) * (a.n_entries + 1));
+
+	if (sort_state.entries == 0) {
+		pointless_anatomy_free(&a);
+		*error = "out of memory";
+		return 0;
+	}
+
+	for (i = 0; i < a.n_entries; i++) {
+		sort_state.entries[i] = i;
+		n_entry_bytes += a.entries[i].n_bytes;
+	}
+
+	int ok = bentley_sort_((int)a.n_entries, pointless_anatomy_sort_cmp, pointless_anatomy_sort_swap, (void*)&sort_state);
+
+	if (!ok)
+		*error = "sort error";
+
+	fprintf(out, "\n%-22s %14llu bytes %6.2f%%\n", "root map entries", (unsigned long long)n_entry_bytes, pointless_anatomy_percent(n_entry_bytes, total));
+
+	for (i = 0; ok && i < a.n_entries; i++) {
+		pointless_anatomy_entry_t* entry = &a.entries[sort_state.entries[i]];
+		pointless_value_t key = pointless_value_from_complete(&entry->key);
+
+		fprintf(out, "%14llu bytes %6.2f%% ", (unsigned long long)entry->n_bytes, pointless_anatomy_percent(entry->n_bytes, total));
+		ok = pointless_debug_print_value(p, &key, out, error);
+	}
+
+	pointless_free(sort_state.entries);
+	pointless_anatomy_free(&a);
+	return ok;
+}
@@ -74,11 +74,45 @@ uint32_t pointless_bitvector_n_bits(uint32_t t, pointless_value_data_t* v, void*
 
 #define HASH_BITVECTOR_SEED 1000000001L
 
-uint32_t pointless_bitvector_hash_32_priv(uint32_t t, pointless_value_data_t* v, uint32_t n_bits, void* bits)
+// version 2, the bits are hashed as bytes, the bits of full bitvectors in place
+static uint32_t pointless_bitvector_hash_v2_32(uint32_t t, pointless_value_data_t* v, uint32_t n_bits, void* bits)
+{
+	pointless_hash_v2_state_t state;
+	uint8_t b[32];
+	uint64_t i = 0;
+	uint32_t j, k;
+
+	pointless_hash_v2_init(&state, n_bits);
+
+	if (t == POINTLESS_BITVECTOR) {
+		pointless_hash_v2_update(&state, bits, n_bits / 8);
+		i = (uint64_t)(n_bits / 8) * 8;
+	}
+
+	while (i < n_bits) {
+		for (j = 0; j < sizeof(b) && i < n_bits; j++) {
+			b[j] = 0;
+
+			for (k = 0; k < 8 && i < n_bits; k++, i++) {
+				if (pointless_bitvector_is_set_bits(t, v, bits, (uint32_t)i))
+					b[j] |= (uint8_t)(1 << k);
+			}
+		}
+
+		pointless_hash_v2_update(&state, b, j);
+	}
+
+	return pointless_hash_v2_end(&state);
+}
+
+uint32_t pointless_bitvector_hash_32_priv(uint32_t version, uint32_t t, pointless_value_data_t* v, uint32_t n_bits, void* bits)
 {
 	uint64_t i = 0;
 	uint32_t b = 0, h = 1, j;
 
+	if (POINTLESS_FF_VERSION_IS_MIXHASH(version))
+		return pointless_bitvector_hash_v2_32(t, v, n_bits, bits);
+
 	while (i < n_bits) {
 		b = 0;
 		j = 0;
@@ -130,7 +164,7 @@ uint32_t pointless_bitvector_is_set(uint32_t t, pointless_value_data_t* v, void*
 	return pointless_bitvector_is_set_bits(t, v, bits, bit);
 }
 
-uint32_t pointless_bitvector_hash_32(uint32_t t, pointless_value_data_t* v, void* buffer)
+uint32_t pointless_bitvector_hash_32(uint32_t version, uint32_t t, pointless_value_data_t* v, void* buffer)
 {
 	void* bits = 0;
 	uint32_t n_bits = pointless_bitvector_n_bits(t, v, buffer);
@@ -138,7 +172,7 @@ uint32_t pointless_bitvector_hash_32(uint32_t t, pointless_value_data_t* v, void
 	if (t == POINTLESS_BITVECTOR)
 		bits = pointless_bitvector_bits(buffer);
 
-	return pointless_bitvector_hash_32_priv(t, v, n_bits, bits);
+	return pointless_bitvector_hash_32_priv(version, t, v, n_bits, bits);
 }
 
 uint64_t pointless_bitvector_hash_64(uint32_t t, pointless_value_data_t* v, void* buffer)
@@ -208,7 +242,7 @@ int32_t pointless_bitvector_cmp_buffer_bits(pointless_value_t* v_a, void* buffer
 	return SIMPLE_CMP(n_bits_a, n_bits_b);
 }
 
-uint32_t pointless_bitvector_hash_buffer_32(void* buffer)
+uint32_t pointless_bitvector_hash_buffer_32(uint32_t version, void* buffer)
 {
 	pointless_value_t v;
 	v.type = POINTLESS_BITVECTOR;
@@ -217,7 +251,7 @@ uint32_t pointless_bitvector_hash_buffer_32(void* buffer)
 	uint32_t n_bits = pointless_bitvector_n_bits(v.type, &v.data, buffer);
 	void* bits = pointless_bitvector_bits(buffer);
 
-	return pointless_bitvector_hash_32_priv(v.type, &v.data, n_bits, bits);
+	return pointless_bitvector_hash_32_priv(version, v.type, &v.data, n_bits, bits);
 }
 
 uint64_t pointless_bitvector_hash_buffer_64(void* buffer)
@@ -232,13 +266,13 @@ uint64_t pointless_bitvector_hash_buffer_64(void* buffer)
 	return pointless_bitvector_hash_64_priv(v.type, &v.data, n_bits, bits);
 }
 
-uint32_t pointless_bitvector_hash_n_bits_bits_32(uint32_t n_bits, void* bits)
+uint32_t pointless_bitvector_hash_n_bits_bits_32(uint32_t version, uint32_t n_bits, void* bits)
 {
 	pointless_value_t v;
 	v.type = POINTLESS_BITVECTOR;
 	v.data.data_u32 = 0;
 
-	return pointless_bitvector_hash_32_priv(v.type, &v.data, n_bits, bits);
+	return pointless_bitvector_hash_32_priv(version, v.type, &v.data, n_bits, bits);
 }
 
 uint64_t pointless_bitvector_hash_n_bits_bits_64(uint32_t n_bits, void* bits)
@@ -66,25 +66,29 @@ static int32_t pointless_cmp_reader_string_unicode(pointless_t* p_a, pointless_c
 	pointless_value_t _a = pointless_value_from_complete(a);
 	pointless_value_t _b = pointless_value_from_complete(b);
 
+	// compressed strings are compared decoded
+	uint8_t buffer_a[POINTLESS_STRING_SYMBOLS_BUFFER_LEN];
+	uint8_t buffer_b[POINTLESS_STRING_SYMBOLS_BUFFER_LEN];
+
 	// uu
 	if (a->type == POINTLESS_UNICODE_ && b->type == POINTLESS_UNICODE_) {
 		uint32_t* unicode_a = pointless_reader_unicode_value_ucs4(p_a, &_a);
 		uint32_t* unicode_b = pointless_reader_unicode_value_ucs4(p_b, &_b);
 		return pointless_cmp_string_32_32(unicode_a, unicode_b);
 	// us
-	} else if (a->type == POINTLESS_UNICODE_ && b->type == POINTLESS_STRING_) {
+	} else if (a->type == POINTLESS_UNICODE_ && pointless_is_string_8_type(b->type)) {
 		uint32_t* unicode_a = pointless_reader_unicode_value_ucs4(p_a, &_a);
-		uint8_t* string_b = pointless_reader_string_value_ascii(p_b, &_b);
+		uint8_t* string_b = pointless_reader_string_value_ascii_buffer(p_b, &_b, buffer_b);
 		return pointless_cmp_string_32_8(unicode_a, string_b);
 	// su
-	} else if (a->type == POINTLESS_STRING_ && b->type == POINTLESS_UNICODE_) {
-		uint8_t* string_a = pointless_reader_string_value_ascii(p_a, &_a);
+	} else if (pointless_is_string_8_type(a->type) && b->type == POINTLESS_UNICODE_) {
+		uint8_t* string_a = pointless_reader_string_value_ascii_buffer(p_a, &_a, buffer_a);
 		uint32_t* unicode_b = pointless_reader_unicode_value_ucs4(p_b, &_b);
 		return pointless_cmp_string_8_32(string_a, unicode_b);
 	// ss
-	} else if (a->type == POINTLESS_STRING_ && b->type == POINTLESS_STRING_) {
-		uint8_t* string_a = pointless_reader_string_value_ascii(p_a, &_a);
-		uint8_t* string_b = pointless_reader_string_value_ascii(p_b, &_b);
+	} else if (pointless_is_string_8_type(a->type) && pointless_is_string_8_type(b->type)) {
+		uint8_t* string_a = pointless_reader_string_value_ascii_buffer(p_a, &_a, buffer_a);
+		uint8_t* string_b = pointless_reader_string_value_ascii_buffer(p_b, &_b, buffer_b);
 		return pointless_cmp_string_8_8(string_a, string_b);
 	}
 
@@ -103,19 +107,19 @@ static int32_t pointless_cmp_create_string_unicode(pointless_create_t* c, pointl
 		uint32_t* unicode_b = (uint32_t*)cv_get_unicode(&_b) + 1;
 		return pointless_cmp_string_32_32(unicode_a, unicode_b);
 	// us
-	} else if (_a.header.type_29 == POINTLESS_UNICODE_ && _b.header.type_29 == POINTLESS_STRING_) {
+	} else if (_a.header.type_29 == POINTLESS_UNICODE_ && pointless_is_string_8_type(_b.header.type_29)) {
 		uint32_t* unicode_a = (uint32_t*)cv_get_unicode(&_a) + 1;
-		uint8_t* string_b = (uint8_t*)((uint32_t*)cv_get_string(&_b) + 1);
+		uint8_t* string_b = cv_get_string_ascii(&_b);
 		return pointless_cmp_string_32_8(unicode_a, string_b);
 	// su
-	} else if (_a.header.type_29 == POINTLESS_STRING_ && _b.header.type_29 == POINTLESS_UNICODE_) {
-		uint8_t* string_a = (uint8_t*)((uint32_t*)cv_get_string(&_a) + 1);
+	} else if (pointless_is_string_8_type(_a.header.type_29) && _b.header.type_29 == POINTLESS_UNICODE_) {
+		uint8_t* string_a = cv_get_string_ascii(&_a);
 		uint32_t* unicode_b = (uint32_t*)cv_get_unicode(&_b) + 1;
 		return pointless_cmp_string_8_32(string_a, unicode_b);
 	// ss
-	} else if (_a.header.type_29 == POINTLESS_STRING_ && _b.header.type_29 == POINTLESS_STRING_) {
-		uint8_t* string_a = (uint8_t*)((uint32_t*)cv_get_string(&_a) + 1);
-		uint8_t* string_b = (uint8_t*)((uint32_t*)cv_get_string(&_b) + 1);
+	} else if (pointless_is_string_8_type(_a.header.type_29) && pointless_is_string_8_type(_b.header.type_29)) {
+		uint8_t* string_a = cv_get_string_ascii(&_a);
+		uint8_t* string_b = cv_get_string_ascii(&_b);
 		return pointless_cmp_string_8_8(string_a, string_b);
 	}
 
@@ -286,12 +290,30 @@ static pointless_complete_value_t pointless_cmp_vector_value_reader(pointless_t*
 			return pointless_complete_value_create_as_read_u64(pointless_reader_vector_u64(p, &_v)[i]);
 		case POINTLESS_VECTOR_FLOAT:
 			return pointless_complete_value_create_as_read_float(pointless_reader_vector_float(p, &_v)[i]);
+		case POINTLESS_VECTOR_DICTIONARY:
+		case POINTLESS_VECTOR_RUNS:
+		case POINTLESS_VECTOR_SPLIT:
+		case POINTLESS_VECTOR_BLOCKS:
+			return pointless_reader_vector_value_case(p, &_v, i);
 	}
 
 	assert(0);
 	return vi;
 }
 
+// 64-bit integers live outside of the create-time value
+static pointless_complete_create_value_t pointless_cmp_create_value_to_complete(pointless_create_t* c, pointless_create_value_t* v)
+{
+	switch (v->header.type_29) {
+		case POINTLESS_I64:
+			return pointless_complete_value_create_i64((int64_t)cv_get_int_64(v));
+		case POINTLESS_U64:
+			return pointless_complete_value_create_u64(cv_get_int_64(v));
+	}
+
+	return pointless_create_value_to_complete(v);
+}
+
 // vectors are complicated
 static pointless_complete_create_value_t pointless_cmp_vector_value_create(pointless_create_t* c, pointless_complete_create_value_t* v, uint32_t i)
 {
@@ -343,7 +365,7 @@ static pointless_complete_create_value_t pointless_cmp_vector_value_create(point
 	// everything else is simple
 	} else {
 		uint32_t j = pointless_dynarray_ITEM_AT(uint32_t, &cv_get_priv_vector(&_v)->vector, i);
-		vi = pointless_create_value_to_complete(cv_value_at(j));
+		vi = pointless_cmp_create_value_to_complete(c, cv_value_at(j));
 	}
 
 	return vi;
@@ -406,11 +428,19 @@ static int32_t pointless_cmp_create_set(pointless_create_t* c, pointless_complet
 static int32_t pointless_cmp_create_map(pointless_create_t* c, pointless_complete_create_value_t* a, pointless_complete_create_value_t* b, uint32_t depth, const char** error)
 	{ *error = "map comparison not implemented yet"; return 0; }
 
+// ..and neither are tables
+static int32_t pointless_cmp_reader_table(pointless_t* p_a, pointless_complete_value_t* a, pointless_t* p_b, pointless_complete_value_t* b, uint32_t depth, const char** error)
+	{ *error = "table comparison not implemented yet"; return 0; }
+static int32_t pointless_cmp_create_table(pointless_create_t* c, pointless_complete_create_value_t* a, pointless_complete_create_value_t* b, uint32_t depth, const char** error)
+	{ *error = "table comparison not implemented yet"; return 0; }
+
 static pointless_cmp_reader_cb pointless_cmp_reader_func(uint32_t t)
 {
 	switch (t) {
 		case POINTLESS_UNICODE_:
 		case POINTLESS_STRING_:
+		case POINTLESS_STRING_INLINE:
+		case POINTLESS_STRING_SYMBOLS:
 			return pointless_cmp_reader_string_unicode;
 		case POINTLESS_I32:
 		case POINTLESS_U32:
@@ -440,11 +470,17 @@ static pointless_cmp_reader_cb pointless_cmp_reader_func(uint32_t t)
 		case POINTLESS_VECTOR_U64:
 		case POINTLESS_VECTOR_FLOAT:
 		case POINTLESS_VECTOR_EMPTY:
+		case POINTLESS_VECTOR_DICTIONARY:
+		case POINTLESS_VECTOR_RUNS:
+		case POINTLESS_VECTOR_SPLIT:
+		case POINTLESS_VECTOR_BLOCKS:
 			return pointless_cmp_reader_vector;
 		case POINTLESS_SET_VALUE:
 			return pointless_cmp_reader_set;
 		case POINTLESS_MAP_VALUE_VALUE:
 			return pointless_cmp_reader_map;
+		case POINTLESS_TABLE:
+			return pointless_cmp_reader_table;
 		case POINTLESS_EMPTY_SLOT:
 			return pointless_cmp_reader_empty_slot;
 	}
@@ -458,6 +494,8 @@ static pointless_cmp_create_cb pointless_cmp_create_func(uint32_t t)
 	switch (t) {
 		case POINTLESS_UNICODE_:
 		case POINTLESS_STRING_:
+		case POINTLESS_STRING_INLINE:
+		case POINTLESS_STRING_SYMBOLS:
 			return pointless_cmp_create_string_unicode;
 		case POINTLESS_I32:
 		case POINTLESS_U32:
@@ -490,6 +528,8 @@ static pointless_cmp_create_cb pointless_cmp_create_func(uint32_t t)
 			return pointless_cmp_create_set;
 		case POINTLESS_MAP_VALUE_VALUE:
 			return pointless_cmp_create_map;
+		case POINTLESS_TABLE:
+			return pointless_cmp_create_table;
 		case POINTLESS_EMPTY_SLOT:
 			return pointless_cmp_create_empty_slot;
 	}
@@ -559,8 +599,8 @@ int32_t pointless_cmp_create(pointless_create_t* c, uint32_t a, uint32_t b, cons
 	pointless_create_value_t* v_a = &pointless_dynarray_ITEM_AT(pointless_create_value_t, &c->values, a);
 	pointless_create_value_t* v_b = &pointless_dynarray_ITEM_AT(pointless_create_value_t, &c->values, b);
 
-	pointless_complete_create_value_t _v_a = pointless_create_value_to_complete(v_a);
-	pointless_complete_create_value_t _v_b = pointless_create_value_to_complete(v_b);
+	pointless_complete_create_value_t _v_a = pointless_cmp_create_value_to_complete(c, v_a);
+	pointless_complete_create_value_t _v_b = pointless_cmp_create_value_to_complete(c, v_b);
 
 	return pointless_cmp_create_rec(c, &_v_a, &_v_b, 0, error);
 }
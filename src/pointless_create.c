@@ -12,12 +12,6 @@ static size_t align_next_4_size_t(size_t v)
 	return v + lookup[v%4];
 }
 
-static uint32_t align_next_4_32(uint32_t v)
-{
-	static uint32_t lookup[4] = {0, 3, 2, 1};
-	return v + lookup[v%4];
-}
-
 static uint64_t align_next_4_64(uint64_t v)
 {
 	static uint64_t lookup[4] = {0, 3, 2, 1};
@@ -34,6 +28,10 @@ static pointless_value_t pointless_create_to_read_value(pointless_create_t* c, u
 	if (cv_is_outside_vector(v))
 		data.data_u32 += n_priv_vectors;
 
+	// tables and encoded vectors are stored as their inner (private) value vector
+	if (type == POINTLESS_TABLE || pointless_is_encoded_vector_type(type))
+		data = cv_value_at(data.data_u32)->data;
+
 	pointless_value_t r;
 	r.type = type;
 	r.data = data;
@@ -41,6 +39,150 @@ static pointless_value_t pointless_create_to_read_value(pointless_create_t* c, u
 	return r;
 }
 
+static uint32_t pointless_create_vector_compression(pointless_create_t* c, uint32_t vector);
+
+// store a non-empty set/map serialize vector as a primitive vector, if its contents allow it
+static void pointless_hash_table_create_typed(pointless_create_t* c, uint32_t vector, int is_key)
+{
+	uint32_t compression = pointless_create_vector_compression(c, vector);
+
+	switch (compression) {
+		case POINTLESS_VECTOR_VALUE:
+			return;
+		// keys are read back as 32-bit values, with the same hash as the original key
+		case POINTLESS_VECTOR_I64:
+		case POINTLESS_VECTOR_U64:
+			if (is_key)
+				return;
+			break;
+	}
+
+	cv_value_at(vector)->header.type_29 = compression;
+	cv_value_at(vector)->header.is_compressed_vector = 1;
+}
+
+// the keys of dense maps, other key types would not be read back as they were written
+static int pointless_hash_table_create_dense_key(pointless_create_t* c, uint32_t key, int64_t* k)
+{
+	switch (cv_value_type(key)) {
+		case POINTLESS_I32:
+			*k = (int64_t)cv_i32_at(key);
+			return 1;
+		case POINTLESS_U32:
+			*k = (int64_t)cv_u32_at(key);
+			return 1;
+	}
+
+	return 0;
+}
+
+// non-zero if the map qualifies for the dense layout, with the smallest key and the size of the key range
+static int pointless_hash_table_dense_range(pointless_create_t* c, uint32_t map, int64_t* min_key, uint32_t* n_range)
+{
+	uint32_t i, n_keys = pointless_dynarray_n_items(&cv_map_at(map)->keys);
+	uint32_t* keys = (uint32_t*)(cv_map_at(map)->keys._data);
+	int64_t k = 0, max_key = 0;
+
+	if (!c->dense_maps || n_keys == 0)
+		return 0;
+
+	for (i = 0; i < n_keys; i++) {
+		if (!pointless_hash_table_create_dense_key(c, keys[i], &k))
+			return 0;
+
+		if (i == 0 || k < *min_key)
+			*min_key = k;
+
+		if (i == 0 || k > max_key)
+			max_key = k;
+	}
+
+	// entries must not be mistaken for POINTLESS_HASH_TABLE_PROBE_MISS/_ERROR
+	uint64_t range = (uint64_t)(max_key - *min_key) + 1;
+
+	if (range > (uint64_t)n_keys * POINTLESS_HASH_TABLE_DENSE_MIN_FILL || range >= POINTLESS_HASH_TABLE_PROBE_ERROR)
+		return 0;
+
+	*n_range = (uint32_t)range;
+	return 1;
+}
+
+static int pointless_hash_table_create_dense(pointless_create_t* c, uint32_t map, int64_t min_key, uint32_t n_range, const char** error)
+{
+	int retval = 0;
+
+	uint32_t i, entry, n_keys = pointless_dynarray_n_items(&cv_map_at(map)->keys);
+	uint32_t* keys_vector_ptr = (uint32_t*)(cv_map_at(map)->keys._data);
+	uint32_t* values_vector_ptr = (uint32_t*)(cv_map_at(map)->values._data);
+	uint32_t n_words = pointless_hash_table_dense_n_words(n_range);
+	int64_t k = 0;
+
+	uint32_t* bits_serialize = (uint32_t*)pointless_calloc(n_words, sizeof(uint32_t));
+	uint32_t* values_serialize = (uint32_t*)pointless_malloc(sizeof(uint32_t) * n_range);
+
+	if (bits_serialize == 0 || values_serialize == 0) {
+		*error = "out of memory B";
+		goto cleanup;
+	}
+
+	for (i = 0; i < n_keys; i++) {
+		pointless_hash_table_create_dense_key(c, keys_vector_ptr[i], &k);
+		entry = (uint32_t)(k - min_key);
+
+		if (pointless_hash_table_dense_is_set(bits_serialize, entry)) {
+			*error = "there are duplicate keys in the set/map";
+			goto cleanup;
+		}
+
+		pointless_hash_table_dense_set(bits_serialize, entry);
+		values_serialize[entry] = values_vector_ptr[i];
+	}
+
+	// the smallest key is always present, and the integers in between the keys repeat the value
+	// before them, so the value vector compresses just like the values themselves
+	for (i = 1; i < n_range; i++) {
+		if (!pointless_hash_table_dense_is_set(bits_serialize, i))
+			values_serialize[i] = values_serialize[i - 1];
+	}
+
+	// a shared schema has the same presence bits
+	if (cv_map_at(map)->serialize_schema == POINTLESS_CREATE_VALUE_FAIL) {
+		if (pointless_create_vector_u32_transfer(c, cv_map_at(map)->serialize_hash, bits_serialize, n_words) == POINTLESS_CREATE_VALUE_FAIL) {
+			*error = "unable to transfer hash_serialize vector";
+			goto cleanup;
+		}
+
+		bits_serialize = 0;
+	}
+
+	if (pointless_create_vector_value_transfer(c, cv_map_at(map)->serialize_values, values_serialize, n_range) == POINTLESS_CREATE_VALUE_FAIL) {
+		*error = "unable to transfer values_serialize_vector";
+		goto cleanup;
+	}
+
+	values_serialize = 0;
+
+	if (c->typed_hash_tables)
+		pointless_hash_table_create_typed(c, cv_map_at(map)->serialize_values, 0);
+
+	// the key vector stays empty
+	cv_map_at(map)->serialize_is_dense = 1;
+
+	if (min_key < 0)
+		cv_map_at(map)->serialize_min_key = pointless_value_create_as_read_i32((int32_t)min_key);
+	else
+		cv_map_at(map)->serialize_min_key = pointless_value_create_as_read_u32((uint32_t)min_key);
+
+	retval = 1;
+
+cleanup:
+
+	pointless_free(bits_serialize);
+	pointless_free(values_serialize);
+
+	return retval;
+}
+
 static int pointless_hash_table_create(pointless_create_t* c, uint32_t hash_table, const char** error)
 {
 	// return value
@@ -51,11 +193,19 @@ static int pointless_hash_table_create(pointless_create_t* c, uint32_t hash_tabl
 	uint32_t* keys_serialize = 0;
 	uint32_t* values_serialize = 0;
 	uint32_t* hash_vector = 0;
+	uint32_t* bloom_serialize = 0;
 
 	// serialized vector handles
-	uint32_t sh = 0, sk = 0, sv = 0;
+	uint32_t sh = 0, sk = 0, sv = 0, sb = POINTLESS_CREATE_VALUE_FAIL;
 
-	uint32_t i, n_buckets, empty_slot_handle;
+	// non-zero if the hash and key vectors are those of another map, only the values are ours
+	int is_shared = 0;
+
+	uint32_t i, n_buckets, n_hash, n_entries, empty_slot_handle, n_range = 0;
+	int64_t min_key = 0;
+
+	// typed key/value vectors have no room for empty slots, so they need the compact layout
+	int is_compact = (c->compact_hash_tables || c->typed_hash_tables);
 
 	// WARNING: we are using a direct pointer to dynamic array, but we
 	//          make sure that it can't grow/shrink inside this function
@@ -78,12 +228,25 @@ static int pointless_hash_table_create(pointless_create_t* c, uint32_t hash_tabl
 			goto cleanup;
 	}
 
+	// dense maps have no hashes, and no key vector
+	if (cv_value_type(hash_table) == POINTLESS_MAP_VALUE_VALUE && pointless_hash_table_dense_range(c, hash_table, &min_key, &n_range))
+		return pointless_hash_table_create_dense(c, hash_table, min_key, n_range, error);
+
 	// number of buckets
 	n_buckets = pointless_hash_compute_n_buckets(n_keys);
 
+	// the compact layout stores the entries densely, and the index after the hashes
+	if (is_compact) {
+		n_hash = n_keys + pointless_hash_table_compact_n_index_words(n_keys);
+		n_entries = n_keys;
+	} else {
+		n_hash = n_buckets;
+		n_entries = n_buckets;
+	}
+
 	// allocate output vectors
-	hash_serialize = (uint32_t*)pointless_malloc(sizeof(uint32_t) * n_buckets);
-	keys_serialize = (uint32_t*)pointless_malloc(sizeof(uint32_t) * n_buckets);
+	hash_serialize = (uint32_t*)pointless_malloc(sizeof(uint32_t) * n_hash);
+	keys_serialize = (uint32_t*)pointless_malloc(sizeof(uint32_t) * n_entries);
 	hash_vector = (uint32_t*)pointless_malloc(sizeof(uint32_t) * n_keys);
 
 	if (hash_serialize == 0 || keys_serialize == 0 || hash_vector == 0) {
@@ -93,7 +256,7 @@ static int pointless_hash_table_create(pointless_create_t* c, uint32_t hash_tabl
 
 	// ...and one for values if this is a map
 	if (cv_value_type(hash_table) == POINTLESS_MAP_VALUE_VALUE) {
-		values_serialize = (uint32_t*)pointless_malloc(sizeof(uint32_t) * n_buckets);
+		values_serialize = (uint32_t*)pointless_malloc(sizeof(uint32_t) * n_entries);
 
 		if (values_serialize == 0) {
 			*error = "out of memory C";
@@ -110,8 +273,10 @@ static int pointless_hash_table_create(pointless_create_t* c, uint32_t hash_tabl
 	}
 
 	// initialize all vectors
-	for (i = 0; i < n_buckets; i++) {
+	for (i = 0; i < n_hash; i++)
 		hash_serialize[i] = 0;
+
+	for (i = 0; i < n_entries; i++) {
 		keys_serialize[i] = empty_slot_handle;
 
 		if (values_serialize)
@@ -135,23 +300,34 @@ static int pointless_hash_table_create(pointless_create_t* c, uint32_t hash_tabl
 	}
 
 	// populate the arrays
-	if (!pointless_hash_table_populate(c, hash_vector, keys_vector_ptr, values_vector_ptr, n_keys, hash_serialize, keys_serialize, values_serialize, n_buckets, empty_slot_handle, error))
-		goto cleanup;
+	if (is_compact) {
+		for (i = 0; i < n_keys; i++) {
+			hash_serialize[i] = hash_vector[i];
+			keys_serialize[i] = keys_vector_ptr[i];
 
-	// hash vector no longer needed
-	pointless_free(hash_vector);
-	hash_vector = 0;
+			if (values_serialize)
+				values_serialize[i] = values_vector_ptr[i];
+		}
+
+		if (!pointless_hash_table_compact_populate(c, hash_vector, keys_vector_ptr, n_keys, hash_serialize + n_keys, error))
+			goto cleanup;
+	} else if (!pointless_hash_table_populate(c, hash_vector, keys_vector_ptr, values_vector_ptr, n_keys, hash_serialize, keys_serialize, values_serialize, n_buckets, empty_slot_handle, error)) {
+		goto cleanup;
+	}
 
 	// our serialize vector handles
 	switch (cv_value_type(hash_table)) {
 		case POINTLESS_SET_VALUE:
 			sh = cv_set_at(hash_table)->serialize_hash;
 			sk = cv_set_at(hash_table)->serialize_keys;
+			sb = cv_set_at(hash_table)->serialize_bloom;
 			break;
 		case POINTLESS_MAP_VALUE_VALUE:
 			sh = cv_map_at(hash_table)->serialize_hash;
 			sk = cv_map_at(hash_table)->serialize_keys;
 			sv = cv_map_at(hash_table)->serialize_values;
+			sb = cv_map_at(hash_table)->serialize_bloom;
+			is_shared = (cv_map_at(hash_table)->serialize_schema != POINTLESS_CREATE_VALUE_FAIL);
 			break;
 		default:
 			assert(0);
@@ -159,27 +335,56 @@ static int pointless_hash_table_create(pointless_create_t* c, uint32_t hash_tabl
 			goto cleanup;
 	}
 
-	// transfer hash vector over
-	if (pointless_create_vector_u32_transfer(c, sh, hash_serialize, n_buckets) == POINTLESS_CREATE_VALUE_FAIL) {
-		*error = "unable to transfer hash_serialize vector";
-		goto cleanup;
-	}
+	// Bloom filter, if requested
+	if (sb != POINTLESS_CREATE_VALUE_FAIL) {
+		uint32_t n_words = pointless_hash_table_bloom_n_words(n_keys);
+		bloom_serialize = (uint32_t*)pointless_calloc(n_words, sizeof(uint32_t));
+
+		if (bloom_serialize == 0) {
+			*error = "out of memory E";
+			goto cleanup;
+		}
 
-	// the vector has been transferred, so it being pointless_free()'d is somebody elses problem
-	hash_serialize = 0;
+		for (i = 0; i < n_keys; i++)
+			pointless_hash_table_bloom_add(bloom_serialize, n_words, hash_vector[i]);
 
-	// transfer key vector over
-	if (pointless_create_vector_value_transfer(c, sk, keys_serialize, n_buckets) == POINTLESS_CREATE_VALUE_FAIL) {
-		*error = "unable to transfer keys_serialize vector";
-		goto cleanup;
+		if (pointless_create_vector_u32_transfer(c, sb, bloom_serialize, n_words) == POINTLESS_CREATE_VALUE_FAIL) {
+			*error = "unable to transfer bloom_serialize vector";
+			goto cleanup;
+		}
+
+		// owned by the vector now
+		bloom_serialize = 0;
 	}
 
-	// somebody elses problem now
-	keys_serialize = 0;
+	// hash vector no longer needed
+	pointless_free(hash_vector);
+	hash_vector = 0;
+
+	// the same keys in the same order have the same layout, so a shared schema only needs our values in it
+	if (!is_shared) {
+		// transfer hash vector over
+		if (pointless_create_vector_u32_transfer(c, sh, hash_serialize, n_hash) == POINTLESS_CREATE_VALUE_FAIL) {
+			*error = "unable to transfer hash_serialize vector";
+			goto cleanup;
+		}
+
+		// the vector has been transferred, so it being pointless_free()'d is somebody elses problem
+		hash_serialize = 0;
+
+		// transfer key vector over
+		if (pointless_create_vector_value_transfer(c, sk, keys_serialize, n_entries) == POINTLESS_CREATE_VALUE_FAIL) {
+			*error = "unable to transfer keys_serialize vector";
+			goto cleanup;
+		}
+
+		// somebody elses problem now
+		keys_serialize = 0;
+	}
 
 	// transfer value vector over
 	if (cv_value_type(hash_table) == POINTLESS_MAP_VALUE_VALUE) {
-		if (pointless_create_vector_value_transfer(c, sv, values_serialize, n_buckets) == POINTLESS_CREATE_VALUE_FAIL) {
+		if (pointless_create_vector_value_transfer(c, sv, values_serialize, n_entries) == POINTLESS_CREATE_VALUE_FAIL) {
 			*error = "unable to transfer values_serialize_vector";
 			goto cleanup;
 		}
@@ -188,6 +393,15 @@ static int pointless_hash_table_create(pointless_create_t* c, uint32_t hash_tabl
 		values_serialize = 0;
 	}
 
+	// primitive key/value vectors, the compression check needs at least one item
+	if (c->typed_hash_tables && n_keys > 0) {
+		if (!is_shared)
+			pointless_hash_table_create_typed(c, sk, 1);
+
+		if (cv_value_type(hash_table) == POINTLESS_MAP_VALUE_VALUE)
+			pointless_hash_table_create_typed(c, sv, 0);
+	}
+
 	retval = 1;
 
 cleanup:
@@ -196,6 +410,7 @@ cleanup:
 	pointless_free(keys_serialize);
 	pointless_free(hash_vector);
 	pointless_free(values_serialize);
+	pointless_free(bloom_serialize);
 
 	return retval;
 }
@@ -212,7 +427,10 @@ static void pointless_create_begin_(pointless_create_t* c, uint32_t version)
 	pointless_dynarray_init(&c->set_values, sizeof(pointless_create_set_t));
 	pointless_dynarray_init(&c->map_values, sizeof(pointless_create_map_t));
 	pointless_dynarray_init(&c->string_unicode_values, sizeof(void*));
+	pointless_dynarray_init(&c->string_symbols_values, sizeof(void*));
 	pointless_dynarray_init(&c->bitvector_values, sizeof(void*));
+	pointless_dynarray_init(&c->int_64_values, sizeof(uint64_t));
+	pointless_dynarray_init(&c->heap_order_trace, sizeof(uint32_t));
 
 	c->string_unicode_map_judy = 0;
 	c->bitvector_map_judy = 0;
@@ -220,6 +438,21 @@ static void pointless_create_begin_(pointless_create_t* c, uint32_t version)
 	c->string_unicode_map_judy_count = 0;
 	c->bitvector_map_judy_count = 0;
 
+	c->bloom_threshold = 0;
+	c->compact_hash_tables = 0;
+	c->typed_hash_tables = 0;
+	c->dense_maps = 0;
+	c->shared_schemas = 0;
+	c->encoded_vectors = 0;
+	c->inline_strings = 0;
+	c->split_vectors = 0;
+	c->block_vectors = 0;
+	c->string_symbols = 0;
+	c->auto_offsets = 0;
+	c->delta_offsets = 0;
+	c->vector_alignment = 4;
+	c->large_vector_alignment = 4;
+	c->heap_order = POINTLESS_CREATE_HEAP_ORDER_TYPE;
 	c->version = version;
 }
 
@@ -233,6 +466,97 @@ void pointless_create_begin_64(pointless_create_t* c)
 	pointless_create_begin_(c, POINTLESS_FF_VERSION_OFFSET_64_NEWHASH);
 }
 
+void pointless_create_begin_auto(pointless_create_t* c)
+{
+	pointless_create_begin_(c, POINTLESS_FF_VERSION_OFFSET_64_NEWHASH);
+	c->auto_offsets = 1;
+}
+
+void pointless_create_bloom_threshold(pointless_create_t* c, uint32_t n_keys)
+{
+	c->bloom_threshold = n_keys;
+}
+
+void pointless_create_compact_hash_tables(pointless_create_t* c, uint32_t is_compact)
+{
+	c->compact_hash_tables = is_compact;
+}
+
+void pointless_create_typed_hash_tables(pointless_create_t* c, uint32_t is_typed)
+{
+	c->typed_hash_tables = is_typed;
+}
+
+void pointless_create_dense_maps(pointless_create_t* c, uint32_t is_dense)
+{
+	c->dense_maps = is_dense;
+}
+
+void pointless_create_shared_schemas(pointless_create_t* c, uint32_t is_shared)
+{
+	c->shared_schemas = is_shared;
+}
+
+void pointless_create_encoded_vectors(pointless_create_t* c, uint32_t is_encoded)
+{
+	c->encoded_vectors = is_encoded;
+}
+
+void pointless_create_inline_strings(pointless_create_t* c, uint32_t is_inline)
+{
+	c->inline_strings = is_inline;
+}
+
+void pointless_create_split_vectors(pointless_create_t* c, uint32_t is_split)
+{
+	c->split_vectors = is_split;
+}
+
+void pointless_create_block_vectors(pointless_create_t* c, uint32_t is_block)
+{
+	c->block_vectors = is_block;
+}
+
+void pointless_create_string_symbols(pointless_create_t* c, uint32_t is_symbols)
+{
+	c->string_symbols = is_symbols;
+}
+
+void pointless_create_mix_hash(pointless_create_t* c, uint32_t is_mix)
+{
+	switch (c->version) {
+		case POINTLESS_FF_VERSION_OFFSET_32_NEWHASH:
+		case POINTLESS_FF_VERSION_OFFSET_32_MIXHASH:
+			c->version = is_mix ? POINTLESS_FF_VERSION_OFFSET_32_MIXHASH : POINTLESS_FF_VERSION_OFFSET_32_NEWHASH;
+			break;
+		case POINTLESS_FF_VERSION_OFFSET_64_NEWHASH:
+		case POINTLESS_FF_VERSION_OFFSET_64_MIXHASH:
+			c->version = is_mix ? POINTLESS_FF_VERSION_OFFSET_64_MIXHASH : POINTLESS_FF_VERSION_OFFSET_64_NEWHASH;
+			break;
+	}
+}
+
+void pointless_create_delta_offsets(pointless_create_t* c, uint32_t is_delta)
+{
+	c->delta_offsets = is_delta;
+}
+
+void pointless_create_vector_alignment(pointless_create_t* c, uint32_t alignment, uint32_t large_alignment)
+{
+	c->vector_alignment = alignment;
+	c->large_vector_alignment = large_alignment;
+}
+
+void pointless_create_heap_order(pointless_create_t* c, uint32_t heap_order)
+{
+	c->heap_order = heap_order;
+}
+
+int pointless_create_heap_order_trace(pointless_create_t* c, uint32_t* values, uint32_t n_values)
+{
+	return (n_values == 0 || pointless_dynarray_push_bulk(&c->heap_order_trace, values, n_values));
+}
+
 static void pointless_create_value_free(pointless_create_t* c, uint32_t i)
 {
 	switch (cv_value_type(i)) {
@@ -260,6 +584,7 @@ static void pointless_create_value_free(pointless_create_t* c, uint32_t i)
 			pointless_free(cv_unicode_at(i));
 			break;
 		case POINTLESS_STRING_:
+		case POINTLESS_STRING_SYMBOLS:
 			pointless_free(cv_string_at(i));
 			break;
 		case POINTLESS_SET_VALUE:
@@ -281,13 +606,19 @@ void pointless_create_end(pointless_create_t* c)
 	for (i = 0; i < n_values; i++)
 		pointless_create_value_free(c, i);
 
+	for (i = 0; i < pointless_dynarray_n_items(&c->string_symbols_values); i++)
+		pointless_free(pointless_dynarray_ITEM_AT(void*, &c->string_symbols_values, i));
+
 	pointless_dynarray_destroy(&c->values);
 	pointless_dynarray_destroy(&c->priv_vector_values);
 	pointless_dynarray_destroy(&c->outside_vector_values);
 	pointless_dynarray_destroy(&c->set_values);
 	pointless_dynarray_destroy(&c->map_values);
 	pointless_dynarray_destroy(&c->string_unicode_values);
+	pointless_dynarray_destroy(&c->string_symbols_values);
 	pointless_dynarray_destroy(&c->bitvector_values);
+	pointless_dynarray_destroy(&c->int_64_values);
+	pointless_dynarray_destroy(&c->heap_order_trace);
 
 	JudyHSFreeArray(&c->string_unicode_map_judy, 0);
 	JudyHSFreeArray(&c->bitvector_map_judy, 0);
@@ -315,6 +646,19 @@ static int pointless_serialize_string(pointless_create_cb_t* cb, void* string_bu
 	return 1;
 }
 
+static int pointless_serialize_string_symbols(pointless_create_cb_t* cb, void* symbols_buffer, const char** error)
+{
+	uint32_t* w = (uint32_t*)symbols_buffer;
+
+	if (!(*cb->write)(symbols_buffer, sizeof(*w) + POINTLESS_STRING_SYMBOLS_N_CODES(*w), cb->user, error))
+		return 0;
+
+	if (!(*cb->align_4)(cb->user, error))
+		return 0;
+
+	return 1;
+}
+
 static int pointless_serialize_unicode(pointless_create_cb_t* cb, void* unicode_buffer, const char** error)
 {
 	uint32_t* len = (uint32_t*)unicode_buffer;
@@ -399,6 +743,8 @@ static int pointless_serialize_vector_priv(pointless_create_t* c, uint32_t vecto
 		uint16_t u16;
 		int32_t i32;
 		uint32_t u32;
+		int64_t i64;
+		uint64_t u64;
 		float f;
 		pointless_value_t v;
 	} value;
@@ -459,6 +805,12 @@ static int pointless_serialize_vector_priv(pointless_create_t* c, uint32_t vecto
 	for (i = 0; i < n_items && !is_native; i++) {
 		// uncompressed value vector
 		if (is_uncompressed) {
+			// 64-bit integers have no inline representation
+			if (cv_value_type(items[i]) == POINTLESS_I64 || cv_value_type(items[i]) == POINTLESS_U64) {
+				*error = "64-bit integers can only be stored in vectors of integers";
+				return 0;
+			}
+
 			// WARNING: we are using a pointer to a dynamic array, so during its scope, we must
 			//          not touch the original array, c->values in this case
 			value.v = pointless_create_to_read_value(c, items[i], n_priv_vectors);
@@ -502,6 +854,14 @@ static int pointless_serialize_vector_priv(pointless_create_t* c, uint32_t vecto
 					value.u32 = (uint32_t)pointless_create_get_int_as_int64(cv_value_at(items[i]));
 					w_len = sizeof(value.u32);
 					break;
+				case POINTLESS_VECTOR_I64:
+					value.i64 = (int64_t)pointless_create_value_get_int_bits(c, cv_value_at(items[i]));
+					w_len = sizeof(value.i64);
+					break;
+				case POINTLESS_VECTOR_U64:
+					value.u64 = pointless_create_value_get_int_bits(c, cv_value_at(items[i]));
+					w_len = sizeof(value.u64);
+					break;
 				case POINTLESS_VECTOR_FLOAT:
 					assert(cv_value_type(items[i]) == POINTLESS_FLOAT);
 					value.f = cv_float_at(items[i]);
@@ -542,6 +902,16 @@ static int pointless_serialize_bitvector(pointless_create_cb_t* cb, void* bitvec
 	return 1;
 }
 
+static uint32_t pointless_create_bloom_ref(pointless_create_t* c, uint32_t bloom, uint32_t n_priv_vectors)
+{
+	if (bloom == POINTLESS_CREATE_VALUE_FAIL)
+		return 0;
+
+	pointless_value_t v = pointless_create_to_read_value(c, bloom, n_priv_vectors);
+	assert(v.type == POINTLESS_VECTOR_U32);
+	return (v.data.data_u32 + 1);
+}
+
 static int pointless_serialize_set(pointless_create_cb_t* cb, pointless_create_t* c, uint32_t s, uint32_t n_priv_vectors, const char** error)
 {
 	uint32_t hash_vector_handle = cv_set_at(s)->serialize_hash;
@@ -549,12 +919,12 @@ static int pointless_serialize_set(pointless_create_cb_t* cb, pointless_create_t
 
 	pointless_set_header_t header;
 	header.n_items = pointless_dynarray_n_items(&cv_set_at(s)->keys);
-	header.padding = 0;
+	header.bloom = pointless_create_bloom_ref(c, cv_set_at(s)->serialize_bloom, n_priv_vectors);
 	header.hash_vector = pointless_create_to_read_value(c, hash_vector_handle, n_priv_vectors);
 	header.key_vector = pointless_create_to_read_value(c, keys_vector_handle, n_priv_vectors);
 
 	assert(header.hash_vector.type == POINTLESS_VECTOR_U32);
-	assert(header.key_vector.type == POINTLESS_VECTOR_VALUE_HASHABLE);
+	assert(pointless_is_vector_type(header.key_vector.type));
 
 	if (!(cb->write)(&header, sizeof(header), cb->user, error))
 		return 0;
@@ -567,22 +937,28 @@ static int pointless_serialize_set(pointless_create_cb_t* cb, pointless_create_t
 
 static int pointless_serialize_map(pointless_create_cb_t* cb, pointless_create_t* c, uint32_t m, uint32_t n_priv_vectors, const char** error)
 {
-	uint32_t hash_vector_handle = cv_map_at(m)->serialize_hash;
-	uint32_t keys_vector_handle = cv_map_at(m)->serialize_keys;
+	// the map owning the hash and key vectors, which is this one, unless its schema is shared
+	uint32_t schema = (cv_map_at(m)->serialize_schema != POINTLESS_CREATE_VALUE_FAIL) ? cv_map_at(m)->serialize_schema : m;
+
+	uint32_t hash_vector_handle = cv_map_at(schema)->serialize_hash;
+	uint32_t keys_vector_handle = cv_map_at(schema)->serialize_keys;
 	uint32_t values_vector_handle = cv_map_at(m)->serialize_values;
 
 	assert(pointless_dynarray_n_items(&cv_map_at(m)->keys) == pointless_dynarray_n_items(&cv_map_at(m)->values));
 
 	pointless_map_header_t header;
 	header.n_items = pointless_dynarray_n_items(&cv_map_at(m)->keys);
-	header.padding = 0;
+	header.bloom = pointless_create_bloom_ref(c, cv_map_at(schema)->serialize_bloom, n_priv_vectors);
 	header.hash_vector = pointless_create_to_read_value(c, hash_vector_handle, n_priv_vectors);
 	header.key_vector = pointless_create_to_read_value(c, keys_vector_handle, n_priv_vectors);
 	header.value_vector = pointless_create_to_read_value(c, values_vector_handle, n_priv_vectors);
 
+	// dense maps store their smallest key instead
+	if (cv_map_at(schema)->serialize_is_dense)
+		header.key_vector = cv_map_at(schema)->serialize_min_key;
+
 	assert(header.hash_vector.type == POINTLESS_VECTOR_U32);
-	assert(header.key_vector.type == POINTLESS_VECTOR_VALUE_HASHABLE);
-	assert(header.value_vector.type == POINTLESS_VECTOR_VALUE_HASHABLE || header.value_vector.type == POINTLESS_VECTOR_VALUE);
+	assert(pointless_is_vector_type(header.key_vector.type) || cv_map_at(schema)->serialize_is_dense);
 	assert(pointless_is_vector_type(header.value_vector.type));
 
 	if (!(cb->write)(&header, sizeof(header), cb->user, error))
@@ -604,10 +980,11 @@ static uint32_t pointless_create_vector_compression(pointless_create_t* c, uint3
 	uint32_t compression = POINTLESS_VECTOR_VALUE;
 	size_t i;
 
-	// value ranges we've found, we do not support 64 bit integers, only 8, 16 and 32
-	// so these should hold them just fine
+	// value ranges we've found, unsigned values above INT64_MAX do not fit 'cur_int', so
+	// we track the maximum of the non-negative values as an unsigned integer
 	int64_t min_int = 0, max_int = 0, cur_int = 0;
-	int is_int = 0, init_int = 0, init_float = 0;
+	uint64_t max_uint = 0, cur_uint = 0;
+	int is_int = 0, is_neg = 0, init_int = 0, init_float = 0;
 
 	// create-time IDs for this vector
 	size_t n_items = pointless_dynarray_n_items(&cv_priv_vector_at(vector)->vector);
@@ -619,12 +996,18 @@ static uint32_t pointless_create_vector_compression(pointless_create_t* c, uint3
 		switch (cv_value_type(items[i])) {
 			// compressible types
 			case POINTLESS_I32:
+			case POINTLESS_I64:
 				is_int = 1;
-				cur_int = (int64_t)cv_i32_at(items[i]);
+				cur_int = (int64_t)pointless_create_value_get_int_bits(c, cv_value_at(items[i]));
+				is_neg = (cur_int < 0);
+				cur_uint = (uint64_t)cur_int;
 				break;
 			case POINTLESS_U32:
-				cur_int = (int64_t)cv_u32_at(items[i]);
+			case POINTLESS_U64:
 				is_int = 1;
+				cur_uint = pointless_create_value_get_int_bits(c, cv_value_at(items[i]));
+				cur_int = (cur_uint > INT64_MAX) ? INT64_MAX : (int64_t)cur_uint;
+				is_neg = 0;
 				break;
 			case POINTLESS_FLOAT:
 				init_float = 1;
@@ -649,6 +1032,9 @@ static uint32_t pointless_create_vector_compression(pointless_create_t* c, uint3
 				min_int = SIMPLE_MIN(min_int, cur_int);
 				max_int = SIMPLE_MAX(max_int, cur_int);
 			}
+
+			if (!is_neg)
+				max_uint = SIMPLE_MAX(max_uint, cur_uint);
 		}
 	}
 
@@ -664,16 +1050,20 @@ static uint32_t pointless_create_vector_compression(pointless_create_t* c, uint3
 	assert(min_int <= max_int);
 
 	if (min_int >= 0) {
-		if (max_int <= UINT8_MAX)
+		if (max_uint <= UINT8_MAX)
 			return POINTLESS_VECTOR_U8;
-		else if (max_int <= UINT16_MAX)
+		else if (max_uint <= UINT16_MAX)
 			return POINTLESS_VECTOR_U16;
-		else if (max_int <= UINT32_MAX)
+		else if (max_uint <= UINT32_MAX)
 			return POINTLESS_VECTOR_U32;
 		else
-			assert(0);
+			return POINTLESS_VECTOR_U64;
 	}
 
+	// a mix of negative values and values above INT64_MAX has no vector type
+	if (max_uint > INT64_MAX)
+		return compression;
+
 	if (INT8_MIN <= min_int && max_int <= INT8_MAX)
 		return POINTLESS_VECTOR_I8;
 	else if (INT16_MIN <= min_int && max_int <= INT16_MAX)
@@ -681,9 +1071,7 @@ static uint32_t pointless_create_vector_compression(pointless_create_t* c, uint3
 	else if (INT32_MIN <= min_int && max_int <= INT32_MAX)
 		return POINTLESS_VECTOR_I32;
 
-	// we must have hit something here already
-	assert(0);
-	return 0;
+	return POINTLESS_VECTOR_I64;
 }
 
 //! COMPLICATED BIT HERE, WE NEED TO KNOW FOR EACH POINTLESS_VECTOR_VALUE, IF IT CONTAINS AND NON-HASHABLE VALUES
@@ -704,74 +1092,1281 @@ static uint32_t pointless_create_vector_compression(pointless_create_t* c, uint3
 	   if not is_hashable(child):
 		 return False
 
-	  return True
+	  return True
+
+	def check(vector):
+	  return check_rec(vector, [ ])
+*/
+
+
+static int pointless_vector_check_hashable_rec(pointless_create_t* c, uint32_t v, void* priv_vector_bitmask, void* outside_vector_bitmask, uint32_t depth)
+{
+	// we might see an outside vector here, all of which are hashable
+	if (pointless_is_vector_type(cv_value_type(v)) && cv_value_type(v) != POINTLESS_VECTOR_EMPTY) {
+		if (cv_is_outside_vector(v))
+			return 1;
+	}
+
+	size_t i, ii;
+
+	if (cv_value_type(v) == POINTLESS_VECTOR_VALUE) {
+		// if this is a cycle, it is not hashable
+		ii = cv_value_data_u32(v);
+
+		// outside vector
+		if (cv_is_outside_vector(v)) {
+			if (bm_is_set_(outside_vector_bitmask, ii))
+				return 0;
+
+			bm_set_(outside_vector_bitmask, ii);
+
+			for (i = 0; i < cv_outside_vector_at(v)->n_items; i++) {
+				uint32_t cc = ((uint32_t*)cv_outside_vector_at(v)->items)[i];
+
+				if (!pointless_vector_check_hashable_rec(c, cc, priv_vector_bitmask, outside_vector_bitmask, depth + 1)) {
+					bm_reset_(outside_vector_bitmask, ii);
+					return 0;
+				}
+			}
+
+			bm_reset_(outside_vector_bitmask, ii);
+		// private vector
+		} else {
+			if (bm_is_set_(priv_vector_bitmask, ii))
+				return 0;
+
+			bm_set_(priv_vector_bitmask, ii);
+
+			for (i = 0; i < pointless_dynarray_n_items(&cv_priv_vector_at(v)->vector); i++) {
+				uint32_t cc = pointless_dynarray_ITEM_AT(uint32_t, &cv_priv_vector_at(v)->vector, i);
+
+				if (!pointless_vector_check_hashable_rec(c, cc, priv_vector_bitmask, outside_vector_bitmask, depth + 1)) {
+					bm_reset_(priv_vector_bitmask, ii);
+					return 0;
+				}
+			}
+
+			bm_reset_(priv_vector_bitmask, ii);
+		}
+
+		// vector not in a cycle, and all children are hashable
+		return 1;
+	}
+
+	return pointless_is_hashable(cv_value_type(v));
+}
+
+static int pointless_vector_check_hashable(pointless_create_t* c, uint32_t vector, void* priv_vector_bitmask, void* outside_vector_bitmask)
+{
+	assert(cv_is_outside_vector(vector) == 0);
+	return pointless_vector_check_hashable_rec(c, vector, priv_vector_bitmask, outside_vector_bitmask, 0);
+}
+
+// number of items in a create-time vector, UINT32_MAX if it is not a vector
+static uint32_t pointless_create_vector_n_items(pointless_create_t* c, uint32_t v)
+{
+	if (!pointless_is_vector_type(cv_value_type(v)))
+		return UINT32_MAX;
+
+	if (cv_value_type(v) == POINTLESS_VECTOR_EMPTY)
+		return 0;
+
+	if (cv_is_outside_vector(v))
+		return cv_outside_vector_at(v)->n_items;
+
+	return pointless_dynarray_n_items(&cv_priv_vector_at(v)->vector);
+}
+
+// a table must have exactly one column per key, each with one item per row
+static int pointless_create_table_check(pointless_create_t* c, uint32_t t, const char** error)
+{
+	uint32_t vector = cv_value_data_u32(t);
+	uint32_t* items = (uint32_t*)cv_priv_vector_at(vector)->vector._data;
+	uint32_t i, n_items = pointless_dynarray_n_items(&cv_priv_vector_at(vector)->vector);
+
+	assert(n_items >= 2 && cv_value_type(items[0]) == POINTLESS_U32);
+
+	uint32_t n_rows = cv_u32_at(items[0]);
+	uint32_t n_keys = pointless_create_vector_n_items(c, items[1]);
+
+	if (n_keys == UINT32_MAX) {
+		*error = "table keys are not a vector";
+		return 0;
+	}
+
+	if (n_keys != n_items - 2) {
+		*error = "table does not have exactly one column per key";
+		return 0;
+	}
+
+	for (i = 2; i < n_items; i++) {
+		if (pointless_create_vector_n_items(c, items[i]) != n_rows) {
+			*error = "table column is not a vector with one item per row";
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+// a scalar, which can be a key of a shared schema or an item of an encoded vector. strings are interned, and
+// other scalars are compared bit for bit
+static int pointless_create_is_scalar(pointless_create_t* c, uint32_t v)
+{
+	switch (cv_value_type(v)) {
+		case POINTLESS_UNICODE_:
+		case POINTLESS_STRING_:
+		case POINTLESS_STRING_INLINE:
+		case POINTLESS_STRING_SYMBOLS:
+		case POINTLESS_I32:
+		case POINTLESS_U32:
+		case POINTLESS_FLOAT:
+		case POINTLESS_BOOLEAN:
+		case POINTLESS_NULL:
+			return 1;
+	}
+
+	return 0;
+}
+
+static int pointless_create_scalar_eq(pointless_create_t* c, uint32_t a, uint32_t b)
+{
+	if (a == b)
+		return 1;
+
+	if (cv_value_type(a) != cv_value_type(b))
+		return 0;
+
+	switch (cv_value_type(a)) {
+		case POINTLESS_UNICODE_:
+		case POINTLESS_STRING_:
+		case POINTLESS_STRING_SYMBOLS:
+			return 0;
+		case POINTLESS_NULL:
+			return 1;
+	}
+
+	return (cv_value_data_u32(a) == cv_value_data_u32(b));
+}
+
+// hash of the key sequence of a map, non-zero if all its keys can be part of a shared schema
+static int pointless_create_schema_hash(pointless_create_t* c, uint32_t map, uint32_t* hash)
+{
+	uint32_t i, n_keys = pointless_dynarray_n_items(&cv_map_at(map)->keys);
+	uint32_t* keys = (uint32_t*)(cv_map_at(map)->keys._data);
+
+	*hash = n_keys;
+
+	for (i = 0; i < n_keys; i++) {
+		if (!pointless_create_is_scalar(c, keys[i]))
+			return 0;
+
+		*hash = (*hash * 1000003) ^ cv_value_type(keys[i]);
+		*hash = (*hash * 1000003) ^ cv_value_data_u32(keys[i]);
+	}
+
+	return 1;
+}
+
+static int pointless_create_schema_eq(pointless_create_t* c, uint32_t map_a, uint32_t map_b)
+{
+	uint32_t i, n_keys = pointless_dynarray_n_items(&cv_map_at(map_a)->keys);
+	uint32_t* keys_a = (uint32_t*)(cv_map_at(map_a)->keys._data);
+	uint32_t* keys_b = (uint32_t*)(cv_map_at(map_b)->keys._data);
+
+	if (pointless_dynarray_n_items(&cv_map_at(map_b)->keys) != n_keys)
+		return 0;
+
+	for (i = 0; i < n_keys; i++) {
+		if (!pointless_create_scalar_eq(c, keys_a[i], keys_b[i]))
+			return 0;
+	}
+
+	return 1;
+}
+
+// maps with the same keys, in the same order, get the same hash and key vectors, so all but the first
+// of them point to the vectors of the first one, and leave their own to be emptied. the first map with
+// a given key sequence hash owns the schema, maps colliding with it keep their own vectors
+static int pointless_create_schemas(pointless_create_t* c, const char** error)
+{
+	uint32_t i, hash, n_values = pointless_dynarray_n_items(&c->values);
+	Pvoid_t schemas = 0;
+	PWord_t owner = 0;
+	int retval = 0;
+
+	if (!c->shared_schemas)
+		return 1;
+
+	for (i = 0; i < n_values; i++) {
+		if (cv_value_type(i) != POINTLESS_MAP_VALUE_VALUE || !pointless_create_schema_hash(c, i, &hash))
+			continue;
+
+		owner = (PWord_t)JudyLIns(&schemas, (Word_t)hash, PJE0);
+
+		if (owner == 0) {
+			*error = "out of memory";
+			goto cleanup;
+		}
+
+		if (*owner == 0) {
+			*owner = (Word_t)i + 1;
+			continue;
+		}
+
+		if (!pointless_create_schema_eq(c, (uint32_t)(*owner - 1), i))
+			continue;
+
+		cv_map_at(i)->serialize_schema = (uint32_t)(*owner - 1);
+		cv_value_at(cv_map_at(i)->serialize_hash)->header.is_set_map_vector = 0;
+		cv_value_at(cv_map_at(i)->serialize_keys)->header.is_set_map_vector = 0;
+	}
+
+	retval = 1;
+
+cleanup:
+
+	JudyLFreeArray(&schemas, PJE0);
+
+	return retval;
+}
+
+static int pointless_create_bloom_vectors(pointless_create_t* c, const char** error)
+{
+	uint32_t i, n_keys, bloom, n_range, n_values = pointless_dynarray_n_items(&c->values);
+	int64_t min_key;
+
+	if (c->bloom_threshold == 0)
+		return 1;
+
+	for (i = 0; i < n_values; i++) {
+		switch (cv_value_type(i)) {
+			case POINTLESS_SET_VALUE:
+				n_keys = pointless_dynarray_n_items(&cv_set_at(i)->keys);
+				break;
+			case POINTLESS_MAP_VALUE_VALUE:
+				n_keys = pointless_dynarray_n_items(&cv_map_at(i)->keys);
+
+				// dense maps need no filter, and maps with a shared schema use the filter of its owner
+				if (pointless_hash_table_dense_range(c, i, &min_key, &n_range) || cv_map_at(i)->serialize_schema != POINTLESS_CREATE_VALUE_FAIL)
+					continue;
+
+				break;
+			default:
+				continue;
+		}
+
+		if (n_keys < c->bloom_threshold)
+			continue;
+
+		bloom = pointless_create_vector_u32(c);
+
+		if (bloom == POINTLESS_CREATE_VALUE_FAIL) {
+			*error = "out of memory";
+			return 0;
+		}
+
+		// populated along with the hash vector, so it must not be emptied
+		cv_value_at(bloom)->header.is_set_map_vector = 1;
+
+		if (cv_value_type(i) == POINTLESS_SET_VALUE)
+			cv_set_at(i)->serialize_bloom = bloom;
+		else
+			cv_map_at(i)->serialize_bloom = bloom;
+	}
+
+	return 1;
+}
+
+// set/map keys, and the vectors inside them, are hashed and compared item by item when the hash tables are
+// created, so they are never encoded
+static void pointless_create_encoded_vector_mark_key(pointless_create_t* c, uint32_t v, void* is_key)
+{
+	uint32_t i, n_items;
+
+	if (!pointless_is_vector_type(cv_value_type(v)) || bm_is_set_(is_key, v))
+		return;
+
+	bm_set_(is_key, v);
+
+	if (cv_value_type(v) != POINTLESS_VECTOR_VALUE || cv_is_outside_vector(v))
+		return;
+
+	n_items = pointless_dynarray_n_items(&cv_priv_vector_at(v)->vector);
+
+	for (i = 0; i < n_items; i++)
+		pointless_create_encoded_vector_mark_key(c, pointless_dynarray_ITEM_AT(uint32_t, &cv_priv_vector_at(v)->vector, i), is_key);
+}
+
+// append a dictionary code or run end to a u8/u16/u32 vector
+static uint32_t pointless_create_encoded_vector_code_append(pointless_create_t* c, uint32_t codes, uint32_t code)
+{
+	switch (cv_value_type(codes)) {
+		case POINTLESS_VECTOR_U8:
+			return pointless_create_vector_u8_append(c, codes, (uint8_t)code);
+		case POINTLESS_VECTOR_U16:
+			return pointless_create_vector_u16_append(c, codes, (uint16_t)code);
+		case POINTLESS_VECTOR_U32:
+			return pointless_create_vector_u32_append(c, codes, code);
+	}
+
+	assert(0);
+	return POINTLESS_CREATE_VALUE_FAIL;
+}
+
+// replace a value vector of scalars by a split vector, with the types and data of its items, or a single type
+static int pointless_create_split_vector(pointless_create_t* c, uint32_t vector, int is_uniform, const char** error)
+{
+	uint32_t i, n_items = pointless_dynarray_n_items(&cv_priv_vector_at(vector)->vector);
+	uint32_t* items = (uint32_t*)cv_priv_vector_at(vector)->vector._data;
+	uint32_t types = pointless_create_vector_u8(c);
+	uint32_t data = pointless_create_vector_u32(c);
+	uint32_t inner = pointless_create_vector_value(c);
+
+	if (types == POINTLESS_CREATE_VALUE_FAIL || data == POINTLESS_CREATE_VALUE_FAIL || inner == POINTLESS_CREATE_VALUE_FAIL) {
+		*error = "out of memory";
+		return 0;
+	}
+
+	// string data is already the final string index, and scalars are not renumbered
+	for (i = 0; i < n_items; i++) {
+		if ((i == 0 || !is_uniform) && pointless_create_vector_u8_append(c, types, (uint8_t)cv_value_type(items[i])) == POINTLESS_CREATE_VALUE_FAIL) {
+			*error = "out of memory";
+			return 0;
+		}
+
+		if (pointless_create_vector_u32_append(c, data, cv_value_data_u32(items[i])) == POINTLESS_CREATE_VALUE_FAIL) {
+			*error = "out of memory";
+			return 0;
+		}
+	}
+
+	if (pointless_create_vector_value_append(c, inner, types) == POINTLESS_CREATE_VALUE_FAIL || pointless_create_vector_value_append(c, inner, data) == POINTLESS_CREATE_VALUE_FAIL) {
+		*error = "out of memory";
+		return 0;
+	}
+
+	pointless_dynarray_destroy(&cv_priv_vector_at(vector)->vector);
+
+	cv_value_at(vector)->header.type_29 = POINTLESS_VECTOR_SPLIT;
+	cv_value_at(vector)->data.data_u32 = inner;
+
+	return 1;
+}
+
+// replace a value vector of scalars by a dictionary or run-length encoded vector, if it takes at most half of its
+// space, or a split vector, whichever is smallest. the items of the vector become the distinct values or the values
+// of its runs
+static int pointless_create_encode_vector(pointless_create_t* c, uint32_t vector, const char** error)
+{
+	uint32_t i, n_items = pointless_dynarray_n_items(&cv_priv_vector_at(vector)->vector);
+	uint32_t* items = (uint32_t*)cv_priv_vector_at(vector)->vector._data;
+	uint32_t* codes = 0;
+	uint32_t key[2], n_distinct = 0, n_runs = 0, code_type = 0, values, code_vector, inner;
+	uint64_t n_plain, n_dictionary, n_rle, n_split;
+	int is_dictionary = 0, is_uniform = 1, retval = 0;
+	Pvoid_t distinct = 0;
+	PPvoid_t code = 0;
+
+	for (i = 0; i < n_items; i++) {
+		if (!pointless_create_is_scalar(c, items[i]))
+			return 1;
+	}
+
+	// vectors of 32-bit numbers are better off as primitive vectors
+	if (pointless_create_vector_compression(c, vector) != POINTLESS_VECTOR_VALUE)
+		return 1;
+
+	codes = (uint32_t*)pointless_malloc(n_items * sizeof(uint32_t));
+
+	if (codes == 0) {
+		*error = "out of memory";
+		return 0;
+	}
+
+	// runs, and dictionary codes in order of first appearance
+	for (i = 0; i < n_items; i++) {
+		if (i == 0 || !pointless_create_scalar_eq(c, items[i - 1], items[i]))
+			n_runs += 1;
+
+		if (cv_value_type(items[i]) != cv_value_type(items[0]))
+			is_uniform = 0;
+
+		if (!c->encoded_vectors)
+			continue;
+
+		key[0] = cv_value_type(items[i]);
+		key[1] = cv_value_data_u32(items[i]);
+
+		code = JudyHSIns(&distinct, key, sizeof(key), PJE0);
+
+		if (code == 0) {
+			*error = "out of memory";
+			goto cleanup;
+		}
+
+		if (*code == 0)
+			*code = (Pvoid_t)(Word_t)(++n_distinct);
+
+		codes[i] = (uint32_t)((Word_t)*code - 1);
+	}
+
+	// heap sizes, the encoded vectors need a value vector of values and codes on top
+	n_plain = sizeof(uint32_t) + (uint64_t)n_items * sizeof(pointless_value_t);
+	n_dictionary = UINT64_MAX;
+	n_rle = UINT64_MAX;
+	n_split = UINT64_MAX;
+
+	if (c->encoded_vectors) {
+		n_rle = sizeof(uint32_t) * 4 + 2 * sizeof(pointless_value_t) + (uint64_t)n_runs * sizeof(pointless_value_t);
+
+		if (n_distinct <= UINT16_MAX + 1) {
+			n_dictionary = sizeof(uint32_t) * 4 + 2 * sizeof(pointless_value_t) + (uint64_t)n_distinct * sizeof(pointless_value_t);
+			n_dictionary += (uint64_t)n_items * ((n_distinct <= UINT8_MAX + 1) ? sizeof(uint8_t) : sizeof(uint16_t));
+		}
+
+		n_rle += (uint64_t)n_runs * ((n_items <= UINT8_MAX) ? sizeof(uint8_t) : (n_items <= UINT16_MAX) ? sizeof(uint16_t) : sizeof(uint32_t));
+
+		if (n_dictionary * 2 > n_plain)
+			n_dictionary = UINT64_MAX;
+
+		if (n_rle * 2 > n_plain)
+			n_rle = UINT64_MAX;
+	}
+
+	// a split vector needs a value vector of types and data on top
+	if (c->split_vectors) {
+		n_split = sizeof(uint32_t) * 4 + 2 * sizeof(pointless_value_t) + (uint64_t)n_items * sizeof(uint32_t);
+		n_split += (uint64_t)(is_uniform ? 1 : n_items) * sizeof(uint8_t);
+	}
+
+	if (n_split < SIMPLE_MIN(n_dictionary, n_rle) && n_split < n_plain) {
+		retval = pointless_create_split_vector(c, vector, is_uniform, error);
+		goto cleanup;
+	}
+
+	if (SIMPLE_MIN(n_dictionary, n_rle) == UINT64_MAX) {
+		retval = 1;
+		goto cleanup;
+	}
+
+	is_dictionary = (n_dictionary <= n_rle);
+
+	if (is_dictionary)
+		code_type = (n_distinct <= UINT8_MAX + 1) ? POINTLESS_VECTOR_U8 : POINTLESS_VECTOR_U16;
+	else
+		code_type = (n_items <= UINT8_MAX) ? POINTLESS_VECTOR_U8 : (n_items <= UINT16_MAX) ? POINTLESS_VECTOR_U16 : POINTLESS_VECTOR_U32;
+
+	values = pointless_create_vector_value(c);
+
+	switch (code_type) {
+		case POINTLESS_VECTOR_U8:
+			code_vector = pointless_create_vector_u8(c);
+			break;
+		case POINTLESS_VECTOR_U16:
+			code_vector = pointless_create_vector_u16(c);
+			break;
+		default:
+			code_vector = pointless_create_vector_u32(c);
+			break;
+	}
+
+	inner = pointless_create_vector_value(c);
+
+	if (values == POINTLESS_CREATE_VALUE_FAIL || code_vector == POINTLESS_CREATE_VALUE_FAIL || inner == POINTLESS_CREATE_VALUE_FAIL) {
+		*error = "out of memory";
+		goto cleanup;
+	}
+
+	// the items are still owned by the original vector, which is not touched by the creates above
+	for (i = 0; i < n_items; i++) {
+		uint32_t is_value = 0, is_code = 0, c_code = 0;
+
+		if (is_dictionary) {
+			is_value = (codes[i] == pointless_dynarray_n_items(&cv_priv_vector_at(values)->vector));
+			is_code = 1;
+			c_code = codes[i];
+		} else {
+			is_value = (i == 0 || !pointless_create_scalar_eq(c, items[i - 1], items[i]));
+			is_code = (i + 1 == n_items || !pointless_create_scalar_eq(c, items[i], items[i + 1]));
+			c_code = i + 1;
+		}
+
+		if (is_value && pointless_create_vector_value_append(c, values, items[i]) == POINTLESS_CREATE_VALUE_FAIL) {
+			*error = "out of memory";
+			goto cleanup;
+		}
+
+		if (is_code && pointless_create_encoded_vector_code_append(c, code_vector, c_code) == POINTLESS_CREATE_VALUE_FAIL) {
+			*error = "out of memory";
+			goto cleanup;
+		}
+	}
+
+	if (pointless_create_vector_value_append(c, inner, values) == POINTLESS_CREATE_VALUE_FAIL || pointless_create_vector_value_append(c, inner, code_vector) == POINTLESS_CREATE_VALUE_FAIL) {
+		*error = "out of memory";
+		goto cleanup;
+	}
+
+	// the vector now refers to its inner vector, just like a table, and its own items are gone
+	pointless_dynarray_destroy(&cv_priv_vector_at(vector)->vector);
+
+	cv_value_at(vector)->header.type_29 = (is_dictionary ? POINTLESS_VECTOR_DICTIONARY : POINTLESS_VECTOR_RUNS);
+	cv_value_at(vector)->data.data_u32 = inner;
+
+	retval = 1;
+
+cleanup:
+
+	JudyHSFreeArray(&distinct, PJE0);
+	pointless_free(codes);
+
+	return retval;
+}
+
+// item type of a vector which may become a block vector, with its items, 0 if it may not. only value vectors of
+// integers are candidates, as the primitive vectors they would become, so vectors created as primitive vectors stay
+// readable as plain arrays
+static uint32_t pointless_create_block_vector_type(pointless_create_t* c, uint32_t vector, uint32_t** items, uint32_t* n_items)
+{
+	if (cv_value_type(vector) != POINTLESS_VECTOR_VALUE || cv_is_outside_vector(vector) || cv_is_set_map_vector(vector))
+		return 0;
+
+	*items = (uint32_t*)pointless_dynarray_buffer(&cv_priv_vector_at(vector)->vector);
+	*n_items = pointless_dynarray_n_items(&cv_priv_vector_at(vector)->vector);
+
+	if (*n_items < POINTLESS_CREATE_BLOCK_VECTOR_MIN_ITEMS)
+		return 0;
+
+	uint32_t type = pointless_create_vector_compression(c, vector);
+
+	switch (type) {
+		case POINTLESS_VECTOR_I8:
+		case POINTLESS_VECTOR_U8:
+		case POINTLESS_VECTOR_I16:
+		case POINTLESS_VECTOR_U16:
+		case POINTLESS_VECTOR_I32:
+		case POINTLESS_VECTOR_U32:
+		case POINTLESS_VECTOR_I64:
+		case POINTLESS_VECTOR_U64:
+			return type;
+	}
+
+	return 0;
+}
+
+// item 'i' of a block vector candidate, as 64 bits, sign-extended for negative items
+static uint64_t pointless_create_block_vector_item(pointless_create_t* c, uint32_t* items, uint32_t i)
+{
+	return pointless_create_value_get_int_bits(c, cv_value_at(items[i]));
+}
+
+// smallest item of the block [begin, end), and the bit width of the largest delta from it
+static void pointless_create_block_vector_frame(pointless_create_t* c, uint32_t type, uint32_t* items, uint32_t begin, uint32_t end, uint64_t* frame, uint32_t* width)
+{
+	int is_signed = (type == POINTLESS_VECTOR_I8 || type == POINTLESS_VECTOR_I16 || type == POINTLESS_VECTOR_I32 || type == POINTLESS_VECTOR_I64);
+	uint64_t item, max_delta = 0;
+	uint32_t i;
+
+	*frame = pointless_create_block_vector_item(c, items, begin);
+
+	for (i = begin + 1; i < end; i++) {
+		item = pointless_create_block_vector_item(c, items, i);
+
+		if (is_signed ? ((int64_t)item < (int64_t)*frame) : (item < *frame))
+			*frame = item;
+	}
+
+	for (i = begin; i < end; i++)
+		max_delta = SIMPLE_MAX(max_delta, pointless_create_block_vector_item(c, items, i) - *frame);
+
+	for (*width = 0; *width < 64 && (max_delta >> *width) != 0; *width += 1)
+		;
+}
+
+// replace an integer vector by a block vector, if it takes at most 3/4 of its space
+static int pointless_create_block_vector(pointless_create_t* c, uint32_t vector, uint32_t type, uint32_t* items, uint32_t n_items, const char** error)
+{
+	uint32_t n_blocks = ICEIL(n_items, POINTLESS_VECTOR_BLOCK_SIZE);
+	uint32_t b, i, begin, end, width, shift, blocks_vector, words_vector, inner;
+	uint64_t n_words = 0, bit, delta, n_plain, n_packed, frame;
+	uint64_t* blocks = 0;
+	uint32_t* words = 0;
+	uint32_t* w = 0;
+	int retval = 0;
+
+	blocks = (uint64_t*)pointless_malloc((1 + 2 * (size_t)n_blocks) * sizeof(uint64_t));
+
+	if (blocks == 0) {
+		*error = "out of memory";
+		goto cleanup;
+	}
+
+	blocks[0] = ((uint64_t)type << 32) | n_items;
+
+	for (b = 0; b < n_blocks; b++) {
+		begin = b * POINTLESS_VECTOR_BLOCK_SIZE;
+		end = SIMPLE_MIN(begin + POINTLESS_VECTOR_BLOCK_SIZE, n_items);
+
+		pointless_create_block_vector_frame(c, type, items, begin, end, &frame, &width);
+
+		blocks[1 + 2 * b] = frame;
+		blocks[2 + 2 * b] = (n_words << 8) | width;
+		n_words += ICEIL((uint64_t)(end - begin) * width, 32);
+	}
+
+	switch (type) {
+		case POINTLESS_VECTOR_I8:
+		case POINTLESS_VECTOR_U8:
+			n_plain = (uint64_t)n_items * sizeof(uint8_t);
+			break;
+		case POINTLESS_VECTOR_I16:
+		case POINTLESS_VECTOR_U16:
+			n_plain = (uint64_t)n_items * sizeof(uint16_t);
+			break;
+		case POINTLESS_VECTOR_I32:
+		case POINTLESS_VECTOR_U32:
+			n_plain = (uint64_t)n_items * sizeof(uint32_t);
+			break;
+		default:
+			n_plain = (uint64_t)n_items * sizeof(uint64_t);
+			break;
+	}
+
+	// three vector headers and the two inner values are the overhead, the padding words make any item readable as 3 words
+	n_packed = sizeof(uint32_t) * 3 + 2 * sizeof(pointless_value_t) + (1 + 2 * (uint64_t)n_blocks) * sizeof(uint64_t) + (n_words + 2) * sizeof(uint32_t);
+
+	if (n_packed * 4 > n_plain * 3 || n_words + 2 > UINT32_MAX) {
+		retval = 1;
+		goto cleanup;
+	}
+
+	words = (uint32_t*)pointless_calloc(n_words + 2, sizeof(uint32_t));
+
+	if (words == 0) {
+		*error = "out of memory";
+		goto cleanup;
+	}
+
+	for (i = 0; i < n_items; i++) {
+		b = i / POINTLESS_VECTOR_BLOCK_SIZE;
+		width = (uint32_t)(blocks[2 + 2 * b] & 0xFF);
+		bit = (blocks[2 + 2 * b] >> 8) * 32 + (uint64_t)(i % POINTLESS_VECTOR_BLOCK_SIZE) * width;
+		delta = pointless_create_block_vector_item(c, items, i) - blocks[1 + 2 * b];
+		w = words + bit / 32;
+		shift = bit % 32;
+
+		w[0] |= (uint32_t)(delta << shift);
+		w[1] |= (uint32_t)((delta << shift) >> 32);
+
+		if (shift > 0)
+			w[2] |= (uint32_t)(delta >> (64 - shift));
+	}
+
+	blocks_vector = pointless_create_vector_u64(c);
+	words_vector = pointless_create_vector_u32(c);
+	inner = pointless_create_vector_value(c);
+
+	if (blocks_vector == POINTLESS_CREATE_VALUE_FAIL || words_vector == POINTLESS_CREATE_VALUE_FAIL || inner == POINTLESS_CREATE_VALUE_FAIL) {
+		*error = "out of memory";
+		goto cleanup;
+	}
+
+	for (b = 0; b < 1 + 2 * n_blocks; b++) {
+		if (pointless_create_vector_u64_append(c, blocks_vector, blocks[b]) == POINTLESS_CREATE_VALUE_FAIL) {
+			*error = "out of memory";
+			goto cleanup;
+		}
+	}
+
+	for (i = 0; i < n_words + 2; i++) {
+		if (pointless_create_vector_u32_append(c, words_vector, words[i]) == POINTLESS_CREATE_VALUE_FAIL) {
+			*error = "out of memory";
+			goto cleanup;
+		}
+	}
+
+	if (pointless_create_vector_value_append(c, inner, blocks_vector) == POINTLESS_CREATE_VALUE_FAIL || pointless_create_vector_value_append(c, inner, words_vector) == POINTLESS_CREATE_VALUE_FAIL) {
+		*error = "out of memory";
+		goto cleanup;
+	}
+
+	pointless_dynarray_destroy(&cv_priv_vector_at(vector)->vector);
+
+	cv_value_at(vector)->header.type_29 = POINTLESS_VECTOR_BLOCKS;
+	cv_value_at(vector)->data.data_u32 = inner;
+
+	retval = 1;
+
+cleanup:
+
+	pointless_free(blocks);
+	pointless_free(words);
+
+	return retval;
+}
+
+static int pointless_create_encode_vectors(pointless_create_t* c, const char** error)
+{
+	uint32_t i, j, n_keys, n_values = pointless_dynarray_n_items(&c->values);
+	uint32_t* keys = 0;
+	void* is_key = 0;
+	int retval = 0;
+
+	uint32_t* items = 0;
+	uint32_t type, n_items = 0;
+
+	if (!c->encoded_vectors && !c->split_vectors && !c->block_vectors)
+		return 1;
+
+	is_key = pointless_calloc(ICEIL(n_values, 8), 1);
+
+	if (is_key == 0) {
+		*error = "out of memory";
+		return 0;
+	}
+
+	for (i = 0; i < n_values; i++) {
+		switch (cv_value_type(i)) {
+			case POINTLESS_SET_VALUE:
+				n_keys = pointless_dynarray_n_items(&cv_set_at(i)->keys);
+				keys = (uint32_t*)(cv_set_at(i)->keys._data);
+				break;
+			case POINTLESS_MAP_VALUE_VALUE:
+				n_keys = pointless_dynarray_n_items(&cv_map_at(i)->keys);
+				keys = (uint32_t*)(cv_map_at(i)->keys._data);
+				break;
+			default:
+				continue;
+		}
+
+		for (j = 0; j < n_keys; j++)
+			pointless_create_encoded_vector_mark_key(c, keys[j], is_key);
+	}
+
+	// note: new vectors are appended, but only the original ones are candidates
+	for (i = 0; i < n_values; i++) {
+		if (c->block_vectors && !bm_is_set_(is_key, i) && (type = pointless_create_block_vector_type(c, i, &items, &n_items)) != 0) {
+			if (!pointless_create_block_vector(c, i, type, items, n_items, error))
+				goto cleanup;
+
+			continue;
+		}
+
+		if (!c->encoded_vectors && !c->split_vectors)
+			continue;
+
+		if (cv_value_type(i) != POINTLESS_VECTOR_VALUE || cv_is_outside_vector(i) || cv_is_set_map_vector(i) || bm_is_set_(is_key, i))
+			continue;
+
+		if (pointless_dynarray_n_items(&cv_priv_vector_at(i)->vector) < POINTLESS_CREATE_ENCODED_VECTOR_MIN_ITEMS)
+			continue;
+
+		if (!pointless_create_encode_vector(c, i, error))
+			goto cleanup;
+	}
+
+	retval = 1;
+
+cleanup:
+
+	pointless_free(is_key);
+
+	return retval;
+}
+
+// compresses the 8-bit heap strings which get smaller, unless the symbol table takes more space than they save, in
+// which case 'has_table' is 0. otherwise, the table is appended as the last string
+static int pointless_create_string_symbols_(pointless_create_t* c, int* has_table, const char** error)
+{
+	uint32_t i, n_values = pointless_dynarray_n_items(&c->values), n_strings = 0;
+	uint64_t n_saved = 0, n_table = 0;
+	void* empty = 0;
+	int retval = 0;
+
+	uint8_t codes[2 * POINTLESS_STRING_SYMBOLS_MAX_LEN];
+	uint8_t table_buffer[POINTLESS_STRING_SYMBOLS_TABLE_LEN + 1];
+	pointless_string_symbols_t table;
+
+	*has_table = 0;
+
+	if (!c->string_symbols)
+		return 1;
+
+	// the values of the strings which may be compressed, and their characters
+	uint32_t* values = (uint32_t*)pointless_malloc((n_values + 1) * sizeof(uint32_t));
+	uint8_t** strings = (uint8_t**)pointless_malloc((n_values + 1) * sizeof(uint8_t*));
+	uint32_t* lens = (uint32_t*)pointless_malloc((n_values + 1) * sizeof(uint32_t));
+
+	if (values == 0 || strings == 0 || lens == 0)
+		goto out_of_memory;
+
+	for (i = 0; i < n_values; i++) {
+		if (cv_value_type(i) != POINTLESS_STRING_)
+			continue;
+
+		uint32_t len = *((uint32_t*)cv_string_at(i));
+
+		if (len == 0 || len > POINTLESS_STRING_SYMBOLS_MAX_LEN)
+			continue;
+
+		values[n_strings] = i;
+		strings[n_strings] = (uint8_t*)((uint32_t*)cv_string_at(i) + 1);
+		lens[n_strings] = len;
+		n_strings += 1;
+	}
+
+	if (!pointless_string_symbols_build(&table, strings, lens, n_strings, error))
+		goto cleanup;
+
+	// one compressed buffer per string id, for the strings which get smaller
+	for (i = 0; i < pointless_dynarray_n_items(&c->string_unicode_values); i++) {
+		if (!pointless_dynarray_push(&c->string_symbols_values, &empty))
+			goto out_of_memory;
+	}
+
+	for (i = 0; i < n_strings; i++) {
+		uint32_t n_codes = pointless_string_symbols_encode(&table, strings[i], lens[i], codes);
+		uint64_t n_plain = align_next_4_64(sizeof(uint32_t) + lens[i] + 1);
+		uint64_t n_compressed = align_next_4_64(sizeof(uint32_t) + n_codes);
+
+		if (n_compressed >= n_plain)
+			continue;
+
+		uint32_t* buffer = (uint32_t*)pointless_malloc(sizeof(uint32_t) + n_codes);
+
+		if (buffer == 0)
+			goto out_of_memory;
+
+		buffer[0] = (n_codes << 16) | lens[i];
+		memcpy(buffer + 1, codes, n_codes);
+		pointless_dynarray_ITEM_AT(void*, &c->string_symbols_values, cv_value_data_u32(values[i])) = buffer;
+		n_saved += n_plain - n_compressed;
+	}
+
+	n_table = pointless_string_symbols_serialize(&table, table_buffer);
+
+	if (n_saved <= align_next_4_64(sizeof(uint32_t) + n_table + 1)) {
+		for (i = 0; i < pointless_dynarray_n_items(&c->string_symbols_values); i++)
+			pointless_free(pointless_dynarray_ITEM_AT(void*, &c->string_symbols_values, i));
+
+		pointless_dynarray_clear(&c->string_symbols_values);
+		retval = 1;
+		goto cleanup;
+	}
+
+	for (i = 0; i < n_strings; i++) {
+		if (pointless_dynarray_ITEM_AT(void*, &c->string_symbols_values, cv_value_data_u32(values[i])) != 0)
+			cv_value_at(values[i])->header.type_29 = POINTLESS_STRING_SYMBOLS;
+	}
+
+	// the table is not interned, it is always the last string
+	{
+		void* table_string = pointless_malloc(sizeof(uint32_t) + n_table + 1);
+
+		if (table_string == 0)
+			goto out_of_memory;
+
+		*((uint32_t*)table_string) = (uint32_t)n_table;
+		memcpy((uint32_t*)table_string + 1, table_buffer, n_table + 1);
+
+		pointless_create_value_t value;
+		value.header.type_29 = POINTLESS_STRING_;
+		value.header.is_outside_vector = 0;
+		value.header.is_compressed_vector = 0;
+		value.header.is_set_map_vector = 0;
+		value.data.data_u32 = c->string_unicode_map_judy_count;
+
+		if (!pointless_dynarray_push(&c->string_unicode_values, &table_string)) {
+			pointless_free(table_string);
+			goto out_of_memory;
+		}
+
+		if (!pointless_dynarray_push(&c->values, &value)) {
+			pointless_dynarray_pop(&c->string_unicode_values);
+			pointless_free(table_string);
+			goto out_of_memory;
+		}
+
+		c->string_unicode_map_judy_count += 1;
+	}
+
+	*has_table = 1;
+	retval = 1;
+	goto cleanup;
+
+out_of_memory:
+	*error = "out of memory";
+
+cleanup:
+	pointless_free(values);
+	pointless_free(strings);
+	pointless_free(lens);
+
+	return retval;
+}
+
+// number of offsets in each offset vector, in file order
+static void pointless_create_n_offsets(pointless_header_t* header, uint32_t* n_offsets)
+{
+	n_offsets[0] = header->n_string_unicode;
+	n_offsets[1] = header->n_vector;
+	n_offsets[2] = header->n_bitvector;
+	n_offsets[3] = header->n_set;
+	n_offsets[4] = header->n_map;
+}
+
+// a delta offset vector can hold the offsets iff each is within POINTLESS_OFFSET_DELTA_MAX bytes of the first offset in its block
+static int pointless_create_offsets_fit_delta(pointless_header_t* header, uint64_t* offsets)
+{
+	uint32_t n_offsets[5];
+	uint32_t i, j;
+
+	pointless_create_n_offsets(header, n_offsets);
+
+	for (i = 0; i < 5; i++) {
+		for (j = 0; j < n_offsets[i]; j++) {
+			if (offsets[j] - offsets[j - j % POINTLESS_OFFSET_DELTA_BLOCK_SIZE] > POINTLESS_OFFSET_DELTA_MAX)
+				return 0;
+		}
+
+		offsets += n_offsets[i];
+	}
+
+	return 1;
+}
+
+// file format version, and so offset vector encoding, for a heap of 'heap_size' bytes. all NEWHASH versions hash
+// the same way, as do all MIXHASH versions, so the hash tables do not depend on it
+static uint32_t pointless_create_offset_version(pointless_create_t* c, pointless_header_t* header, uint64_t* offsets, uint64_t heap_size)
+{
+	int is_mix_hash = POINTLESS_FF_VERSION_IS_MIXHASH(c->version);
+
+	if (c->version == POINTLESS_FF_VERSION_OFFSET_32_OLDHASH)
+		return c->version;
+
+	if (c->delta_offsets && pointless_create_offsets_fit_delta(header, offsets))
+		return is_mix_hash ? POINTLESS_FF_VERSION_OFFSET_DELTA_MIXHASH : POINTLESS_FF_VERSION_OFFSET_DELTA_NEWHASH;
+
+	if (c->auto_offsets && heap_size <= UINT32_MAX)
+		return is_mix_hash ? POINTLESS_FF_VERSION_OFFSET_32_MIXHASH : POINTLESS_FF_VERSION_OFFSET_32_NEWHASH;
+
+	return c->version;
+}
+
+static int pointless_create_write_delta_offsets(pointless_create_cb_t* cb, uint64_t* offsets, uint32_t n, const char** error)
+{
+	uint64_t padding = 0;
+	uint32_t i;
+
+	// block bases
+	for (i = 0; i < n; i += POINTLESS_OFFSET_DELTA_BLOCK_SIZE) {
+		if (!(*cb->write)(&offsets[i], sizeof(uint64_t), cb->user, error))
+			return 0;
+	}
+
+	// deltas, the offsets are 4-byte aligned
+	for (i = 0; i < n; i++) {
+		uint64_t delta = offsets[i] - offsets[i - i % POINTLESS_OFFSET_DELTA_BLOCK_SIZE];
+		assert(delta % 4 == 0 && delta <= POINTLESS_OFFSET_DELTA_MAX);
+
+		uint16_t delta_16 = (uint16_t)(delta / 4);
+
+		if (!(*cb->write)(&delta_16, sizeof(delta_16), cb->user, error))
+			return 0;
+	}
+
+	if ((n * sizeof(uint16_t)) % 8 != 0 && !(*cb->write)(&padding, 8 - (n * sizeof(uint16_t)) % 8, cb->user, error))
+		return 0;
+
+	return 1;
+}
+
+// writes the offset vectors, *n_bytes is the number of bytes written
+static int pointless_create_write_offsets(pointless_create_cb_t* cb, uint32_t version, uint64_t* offsets, pointless_header_t* header, uint64_t* n_bytes, const char** error)
+{
+	uint32_t n_offsets[5];
+	uint64_t i, n = 0;
+
+	pointless_create_n_offsets(header, n_offsets);
+
+	for (i = 0; i < 5; i++)
+		n += n_offsets[i];
+
+	switch (version) {
+		case POINTLESS_FF_VERSION_OFFSET_32_OLDHASH:
+		case POINTLESS_FF_VERSION_OFFSET_32_NEWHASH:
+		case POINTLESS_FF_VERSION_OFFSET_32_MIXHASH:
+			for (i = 0; i < n; i++) {
+				uint32_t offset_32 = (uint32_t)offsets[i];
+
+				if (!(*cb->write)(&offset_32, sizeof(offset_32), cb->user, error))
+					return 0;
+			}
+
+			*n_bytes = n * sizeof(uint32_t);
+			return 1;
+		case POINTLESS_FF_VERSION_OFFSET_64_NEWHASH:
+		case POINTLESS_FF_VERSION_OFFSET_64_MIXHASH:
+			*n_bytes = n * sizeof(uint64_t);
+			return (n == 0 || (*cb->write)(offsets, n * sizeof(uint64_t), cb->user, error));
+		case POINTLESS_FF_VERSION_OFFSET_DELTA_NEWHASH:
+		case POINTLESS_FF_VERSION_OFFSET_DELTA_MIXHASH:
+			*n_bytes = 0;
+
+			for (i = 0; i < 5; i++) {
+				if (!pointless_create_write_delta_offsets(cb, offsets, n_offsets[i], error))
+					return 0;
+
+				*n_bytes += ICEIL(n_offsets[i], POINTLESS_OFFSET_DELTA_BLOCK_SIZE) * sizeof(uint64_t) + ICEIL(n_offsets[i] * sizeof(uint16_t), 8) * 8;
+				offsets += n_offsets[i];
+			}
+
+			return 1;
+	}
+
+	assert(0);
+	*error = "unsupported version";
+	return 0;
+}
+
+static int pointless_create_write_padding(pointless_create_cb_t* cb, uint64_t n, const char** error)
+{
+	static const uint8_t zeros[256] = {0};
+
+	while (n > 0) {
+		uint64_t n_write = (n < sizeof(zeros)) ? n : sizeof(zeros);
+
+		if (!(*cb->write)((void*)zeros, (size_t)n_write, cb->user, error))
+			return 0;
+
+		n -= n_write;
+	}
+
+	return 1;
+}
+
+// the vector alignment field of the header version for 'alignment' (see POINTLESS_FF_VECTOR_ALIGNMENT()), or -1 if
+// the alignment is not supported
+static int pointless_create_alignment_log2(uint32_t alignment)
+{
+	int i;
+
+	for (i = 2; i <= POINTLESS_FF_ALIGNMENT_MAX_LOG2; i++) {
+		if (alignment == ((uint32_t)1 << i))
+			return (i == 2) ? 0 : i;
+	}
+
+	return -1;
+}
+
+// alignment of the items of a vector with 'n_bytes' bytes of items
+static uint64_t pointless_create_vector_item_alignment(pointless_create_t* c, uint64_t n_bytes)
+{
+	if (n_bytes >= c->large_vector_alignment && c->large_vector_alignment > c->vector_alignment)
+		return c->large_vector_alignment;
+
+	return c->vector_alignment;
+}
+
+// a string, unicode, vector, bitvector, set or map on the heap
+typedef struct {
+	uint32_t value;
+	uint32_t is_vector;
+	uint32_t padding;
+	uint64_t n_bytes;
+} pointless_create_heap_value_t;
+
+// values referred to by 'v', for the heap order. sets, maps, tables and encoded vectors refer to their own vectors
+// first, only value vectors also refer to their items
+static int pointless_create_heap_order_children(pointless_create_t* c, uint32_t v, pointless_dynarray_t* children, int is_own)
+{
+	uint32_t schema, i, n_items, child[4];
+	uint32_t n_children = 0;
+
+	// keeps the buffer
+	children->n_items = 0;
+
+	switch (cv_value_type(v)) {
+		case POINTLESS_VECTOR_VALUE:
+		case POINTLESS_VECTOR_VALUE_HASHABLE:
+			if (is_own || cv_is_outside_vector(v))
+				return 1;
+
+			n_items = pointless_dynarray_n_items(&cv_priv_vector_at(v)->vector);
+			return (n_items == 0 || pointless_dynarray_push_bulk(children, pointless_dynarray_buffer(&cv_priv_vector_at(v)->vector), n_items));
+		case POINTLESS_SET_VALUE:
+			child[n_children++] = cv_set_at(v)->serialize_bloom;
+			child[n_children++] = cv_set_at(v)->serialize_hash;
+			child[n_children++] = cv_set_at(v)->serialize_keys;
+			break;
+		case POINTLESS_MAP_VALUE_VALUE:
+			schema = (cv_map_at(v)->serialize_schema != POINTLESS_CREATE_VALUE_FAIL) ? cv_map_at(v)->serialize_schema : v;
+			child[n_children++] = cv_map_at(schema)->serialize_bloom;
+			child[n_children++] = cv_map_at(schema)->serialize_hash;
+			child[n_children++] = cv_map_at(schema)->serialize_keys;
+			child[n_children++] = cv_map_at(v)->serialize_values;
+			break;
+		case POINTLESS_TABLE:
+		case POINTLESS_VECTOR_DICTIONARY:
+		case POINTLESS_VECTOR_RUNS:
+		case POINTLESS_VECTOR_SPLIT:
+		case POINTLESS_VECTOR_BLOCKS:
+			child[n_children++] = cv_value_data_u32(v);
+			break;
+	}
+
+	for (i = 0; i < n_children; i++) {
+		if (child[i] != POINTLESS_CREATE_VALUE_FAIL && !pointless_dynarray_push(children, &child[i]))
+			return 0;
+	}
+
+	return 1;
+}
+
+// places the heap value of 'v', if it has one and it has not been placed yet
+static int pointless_create_heap_order_place(uint32_t v, uint32_t* heap_index, void* is_placed, pointless_dynarray_t* order)
+{
+	uint32_t k = heap_index[v];
+
+	if (k == UINT32_MAX || bm_is_set_(is_placed, k))
+		return 1;
+
+	bm_set_(is_placed, k);
+	return pointless_dynarray_push(order, &k);
+}
+
+// order of the heap values, as indices into them. 'heap_index' maps each value to its heap value, or UINT32_MAX
+static int pointless_create_heap_order_(pointless_create_t* c, uint32_t n_values, uint32_t* heap_index, uint32_t n_heap_values, pointless_dynarray_t* order, const char** error)
+{
+	uint32_t i, j, v, n_children, next = 0;
+	uint32_t* trace = (uint32_t*)pointless_dynarray_buffer(&c->heap_order_trace);
+	uint32_t* children_buffer = 0;
+	int retval = 0;
+
+	void* is_placed = pointless_calloc(ICEIL(n_heap_values, 8) + 1, 1);
+	void* is_visited = pointless_calloc(ICEIL(n_values, 8) + 1, 1);
+
+	// values still to visit, a stack for depth-first and a queue from 'next' for breadth-first order
+	pointless_dynarray_t pending, children;
+	pointless_dynarray_init(&pending, sizeof(uint32_t));
+	pointless_dynarray_init(&children, sizeof(uint32_t));
+
+	if (is_placed == 0 || is_visited == 0)
+		goto out_of_memory;
+
+	// traced values, each followed by its own vectors
+	for (i = 0; i < pointless_dynarray_n_items(&c->heap_order_trace); i++) {
+		if (trace[i] >= n_values)
+			continue;
+
+		if (!pointless_create_heap_order_place(trace[i], heap_index, is_placed, order))
+			goto out_of_memory;
 
-	def check(vector):
-	  return check_rec(vector, [ ])
-*/
+		if (!pointless_create_heap_order_children(c, trace[i], &children, 1))
+			goto out_of_memory;
 
+		children_buffer = (uint32_t*)pointless_dynarray_buffer(&children);
 
-static int pointless_vector_check_hashable_rec(pointless_create_t* c, uint32_t v, void* priv_vector_bitmask, void* outside_vector_bitmask, uint32_t depth)
-{
-	// we might see an outside vector here, all of which are hashable
-	if (pointless_is_vector_type(cv_value_type(v)) && cv_value_type(v) != POINTLESS_VECTOR_EMPTY) {
-		if (cv_is_outside_vector(v))
-			return 1;
+		for (j = 0; j < pointless_dynarray_n_items(&children); j++) {
+			if (children_buffer[j] < n_values && !pointless_create_heap_order_place(children_buffer[j], heap_index, is_placed, order))
+				goto out_of_memory;
+		}
 	}
 
-	size_t i, ii;
+	// then everything reachable from the root
+	if (c->heap_order != POINTLESS_CREATE_HEAP_ORDER_TYPE) {
+		bm_set_(is_visited, c->root);
 
-	if (cv_value_type(v) == POINTLESS_VECTOR_VALUE) {
-		// if this is a cycle, it is not hashable
-		ii = cv_value_data_u32(v);
+		if (!pointless_dynarray_push(&pending, &c->root))
+			goto out_of_memory;
 
-		// outside vector
-		if (cv_is_outside_vector(v)) {
-			if (bm_is_set_(outside_vector_bitmask, ii))
-				return 0;
+		while (next < pointless_dynarray_n_items(&pending)) {
+			if (c->heap_order == POINTLESS_CREATE_HEAP_ORDER_DFS) {
+				v = pointless_dynarray_ITEM_AT(uint32_t, &pending, pointless_dynarray_n_items(&pending) - 1);
+				pointless_dynarray_pop(&pending);
+			} else {
+				v = pointless_dynarray_ITEM_AT(uint32_t, &pending, next++);
+			}
 
-			bm_set_(outside_vector_bitmask, ii);
+			if (!pointless_create_heap_order_place(v, heap_index, is_placed, order))
+				goto out_of_memory;
 
-			for (i = 0; i < cv_outside_vector_at(v)->n_items; i++) {
-				uint32_t cc = ((uint32_t*)cv_outside_vector_at(v)->items)[i];
+			if (!pointless_create_heap_order_children(c, v, &children, 0))
+				goto out_of_memory;
 
-				if (!pointless_vector_check_hashable_rec(c, cc, priv_vector_bitmask, outside_vector_bitmask, depth + 1)) {
-					bm_reset_(outside_vector_bitmask, ii);
-					return 0;
-				}
-			}
+			children_buffer = (uint32_t*)pointless_dynarray_buffer(&children);
+			n_children = pointless_dynarray_n_items(&children);
 
-			bm_reset_(outside_vector_bitmask, ii);
-		// private vector
-		} else {
-			if (bm_is_set_(priv_vector_bitmask, ii))
-				return 0;
+			// the stack is popped from the end, so children are pushed in reverse
+			for (j = 0; j < n_children; j++) {
+				v = children_buffer[(c->heap_order == POINTLESS_CREATE_HEAP_ORDER_DFS) ? (n_children - j - 1) : j];
 
-			bm_set_(priv_vector_bitmask, ii);
+				if (v >= n_values || bm_is_set_(is_visited, v))
+					continue;
 
-			for (i = 0; i < pointless_dynarray_n_items(&cv_priv_vector_at(v)->vector); i++) {
-				uint32_t cc = pointless_dynarray_ITEM_AT(uint32_t, &cv_priv_vector_at(v)->vector, i);
+				bm_set_(is_visited, v);
 
-				if (!pointless_vector_check_hashable_rec(c, cc, priv_vector_bitmask, outside_vector_bitmask, depth + 1)) {
-					bm_reset_(priv_vector_bitmask, ii);
-					return 0;
-				}
+				if (!pointless_dynarray_push(&pending, &v))
+					goto out_of_memory;
 			}
-
-			bm_reset_(priv_vector_bitmask, ii);
 		}
+	}
 
-		// vector not in a cycle, and all children are hashable
-		return 1;
+	// and the rest in type order
+	for (i = 0; i < n_heap_values; i++) {
+		if (bm_is_set_(is_placed, i))
+			continue;
+
+		if (!pointless_dynarray_push(order, &i))
+			goto out_of_memory;
 	}
 
-	return pointless_is_hashable(cv_value_type(v));
+	assert(pointless_dynarray_n_items(order) == n_heap_values);
+
+	retval = 1;
+	goto cleanup;
+
+out_of_memory:
+	*error = "out of memory";
+
+cleanup:
+	pointless_dynarray_destroy(&pending);
+	pointless_dynarray_destroy(&children);
+	pointless_free(is_placed);
+	pointless_free(is_visited);
+
+	return retval;
 }
 
-static int pointless_vector_check_hashable(pointless_create_t* c, uint32_t vector, void* priv_vector_bitmask, void* outside_vector_bitmask)
+static int pointless_serialize_heap_value(pointless_create_t* c, pointless_create_cb_t* cb, pointless_create_heap_value_t* h, uint32_t n_priv_vectors, const char** error)
 {
-	assert(cv_is_outside_vector(vector) == 0);
-	return pointless_vector_check_hashable_rec(c, vector, priv_vector_bitmask, outside_vector_bitmask, 0);
+	uint32_t v = h->value;
+
+	if (!pointless_create_write_padding(cb, h->padding, error))
+		return 0;
+
+	switch (cv_value_type(v)) {
+		case POINTLESS_UNICODE_:
+			return pointless_serialize_unicode(cb, cv_unicode_at(v), error);
+		case POINTLESS_STRING_:
+			return pointless_serialize_string(cb, cv_string_at(v), error);
+		case POINTLESS_STRING_SYMBOLS:
+			return pointless_serialize_string_symbols(cb, pointless_dynarray_ITEM_AT(void*, &c->string_symbols_values, cv_value_data_u32(v)), error);
+		case POINTLESS_BITVECTOR:
+			return pointless_serialize_bitvector(cb, cv_bitvector_at(v), error);
+		case POINTLESS_SET_VALUE:
+			return pointless_serialize_set(cb, c, v, n_priv_vectors, error);
+		case POINTLESS_MAP_VALUE_VALUE:
+			return pointless_serialize_map(cb, c, v, n_priv_vectors, error);
+	}
+
+	assert(h->is_vector);
+
+	if (cv_is_outside_vector(v))
+		return pointless_serialize_vector_outside(c, v, cb, error);
+
+	return pointless_serialize_vector_priv(c, v, cb, n_priv_vectors, error);
 }
 
 static int pointless_create_output_and_end_(pointless_create_t* c, pointless_create_cb_t* cb, const char** error)
@@ -779,17 +2374,13 @@ static int pointless_create_output_and_end_(pointless_create_t* c, pointless_cre
 	// return value
 	int retval = 1;
 
-	// different version of offset
-	int is_32_offset = 0;
-	int is_64_offset = 0;
-
+	// the offset vector encoding is only known once the heap has been laid out
 	switch (c->version) {
 		case POINTLESS_FF_VERSION_OFFSET_32_OLDHASH:
 		case POINTLESS_FF_VERSION_OFFSET_32_NEWHASH:
-			is_32_offset = 1;
-			break;
 		case POINTLESS_FF_VERSION_OFFSET_64_NEWHASH:
-			is_64_offset = 1;
+		case POINTLESS_FF_VERSION_OFFSET_32_MIXHASH:
+		case POINTLESS_FF_VERSION_OFFSET_64_MIXHASH:
 			break;
 		default:
 			*error = "unsupported version";
@@ -800,8 +2391,21 @@ static int pointless_create_output_and_end_(pointless_create_t* c, pointless_cre
 	uint32_t n_priv_vectors, n_outside_vectors, n_sets, n_maps;
 	uint32_t i, n_values;
 
-	uint32_t current_offset_32;
-	uint64_t current_offset_64;
+	uint32_t version, n_heap_values;
+	uint64_t current_offset_64, offsets_n_bytes, heap_alignment, alignment;
+	int vector_alignment_log2, large_vector_alignment_log2, has_string_symbols = 0;
+
+	// heap offsets of all strings, unicodes, vectors, bitvectors, sets and maps, in that order
+	pointless_dynarray_t offsets;
+	pointless_dynarray_init(&offsets, sizeof(uint64_t));
+
+	// the heap values, in the same order, the index of each value among them, and the order they are written in
+	pointless_dynarray_t heap_values;
+	pointless_dynarray_init(&heap_values, sizeof(pointless_create_heap_value_t));
+	uint32_t* heap_index = 0;
+	pointless_dynarray_t heap_order;
+	pointless_dynarray_init(&heap_order, sizeof(uint32_t));
+	pointless_create_heap_value_t* h = 0;
 
 	pointless_dynarray_t temp;
 
@@ -820,9 +2424,56 @@ static int pointless_create_output_and_end_(pointless_create_t* c, pointless_cre
 		goto error_cleanup;
 	}
 
+	vector_alignment_log2 = pointless_create_alignment_log2(c->vector_alignment);
+	large_vector_alignment_log2 = pointless_create_alignment_log2(c->large_vector_alignment);
+
+	if (vector_alignment_log2 < 0 || large_vector_alignment_log2 < 0) {
+		*error = "unsupported vector alignment";
+		goto error_cleanup;
+	}
+
+	// older readers only know 4-byte alignment, and a 32_OLDHASH file is for them
+	if ((vector_alignment_log2 != 0 || large_vector_alignment_log2 != 0) && c->version == POINTLESS_FF_VERSION_OFFSET_32_OLDHASH) {
+		*error = "vector alignment requires a newer file format version";
+		goto error_cleanup;
+	}
+
+	if (c->string_symbols && c->version == POINTLESS_FF_VERSION_OFFSET_32_OLDHASH) {
+		*error = "compressed strings require a newer file format version";
+		goto error_cleanup;
+	}
+
+	if (cv_value_type(c->root) == POINTLESS_I64 || cv_value_type(c->root) == POINTLESS_U64) {
+		*error = "64-bit integers can only be stored in vectors of integers";
+		goto error_cleanup;
+	}
+
+	// shared schemas and Bloom filter vectors must exist before we decide which values to serialize
+	if (!pointless_create_schemas(c, error))
+		goto error_cleanup;
+
+	if (!pointless_create_bloom_vectors(c, error))
+		goto error_cleanup;
+
 	// NOTE: value vector will grow, but the first 'n_values' items are the ones we want to serialize
 	n_values = pointless_dynarray_n_items(&c->values);
 
+	// tables are checked before their vectors are renumbered
+	for (i = 0; i < n_values; i++) {
+		if (cv_value_type(i) == POINTLESS_TABLE && !pointless_create_table_check(c, i, error))
+			goto error_cleanup;
+	}
+
+	// strings are compressed before vectors are encoded, which copy the types of their items
+	if (!pointless_create_string_symbols_(c, &has_string_symbols, error))
+		goto error_cleanup;
+
+	// vectors are encoded after the table checks, which count their items, and the new vectors must be serialized too
+	if (!pointless_create_encode_vectors(c, error))
+		goto error_cleanup;
+
+	n_values = pointless_dynarray_n_items(&c->values);
+
 	// count number of non-empty vectors, sets and maps, and perform work for empty vectors
 	// we are not allowed to do this for vectors used to hold set/map keys and hashes, so we
 	// ignore those
@@ -950,14 +2601,20 @@ static int pointless_create_output_and_end_(pointless_create_t* c, pointless_cre
 			assert(cv_map_at(i)->serialize_keys < pointless_dynarray_n_items(&c->values));
 			assert(cv_map_at(i)->serialize_values < pointless_dynarray_n_items(&c->values));
 
-			// they must be of the expected type
-			assert(cv_value_type(cv_map_at(i)->serialize_hash) == POINTLESS_VECTOR_U32);
-			assert(cv_value_type(cv_map_at(i)->serialize_keys) == POINTLESS_VECTOR_VALUE_HASHABLE);
+			// they must be of the expected type, hash and key vectors of maps with a shared schema have been emptied
+			if (cv_map_at(i)->serialize_schema == POINTLESS_CREATE_VALUE_FAIL) {
+				assert(cv_value_type(cv_map_at(i)->serialize_hash) == POINTLESS_VECTOR_U32);
+				assert(cv_value_type(cv_map_at(i)->serialize_keys) == POINTLESS_VECTOR_VALUE_HASHABLE);
+				assert(pointless_dynarray_n_items(&cv_priv_vector_at(cv_map_at(i)->serialize_hash)->vector) == 0);
+				assert(pointless_dynarray_n_items(&cv_priv_vector_at(cv_map_at(i)->serialize_keys)->vector) == 0);
+			} else {
+				assert(cv_value_type(cv_map_at(i)->serialize_hash) == POINTLESS_VECTOR_EMPTY);
+				assert(cv_value_type(cv_map_at(i)->serialize_keys) == POINTLESS_VECTOR_EMPTY);
+			}
+
 			assert(cv_value_type(cv_map_at(i)->serialize_values) == POINTLESS_VECTOR_VALUE || cv_value_type(cv_map_at(i)->serialize_values) == POINTLESS_VECTOR_VALUE_HASHABLE);
 
 			// ..and they must be empty
-			assert(pointless_dynarray_n_items(&cv_priv_vector_at(cv_map_at(i)->serialize_hash)->vector) == 0);
-			assert(pointless_dynarray_n_items(&cv_priv_vector_at(cv_map_at(i)->serialize_keys)->vector) == 0);
 			assert(pointless_dynarray_n_items(&cv_priv_vector_at(cv_map_at(i)->serialize_values)->vector) == 0);
 
 			// now we can populate these
@@ -966,47 +2623,45 @@ static int pointless_create_output_and_end_(pointless_create_t* c, pointless_cre
 		}
 	}
 
-	// header
-	pointless_header_t header;
-	header.root = pointless_create_to_read_value(c, c->root, n_priv_vectors);
-	header.n_string_unicode = c->string_unicode_map_judy_count;
-	header.n_vector = n_priv_vectors + n_outside_vectors;
-	header.n_bitvector = c->bitvector_map_judy_count;
-	header.n_set = n_sets;
-	header.n_map = n_maps;
-	header.version = c->version;
+	heap_index = (uint32_t*)pointless_malloc(sizeof(uint32_t) * n_values);
 
-	// write it out
-	if (!(*cb->write)(&header, sizeof(header), cb->user, error))
+	if (heap_index == 0) {
+		*error = "out of memory";
 		goto error_cleanup;
+	}
 
-	// current offset value, refs are relative to heap base
-	current_offset_32 = 0;
-	current_offset_64 = 0;
+	for (i = 0; i < n_values; i++)
+		heap_index[i] = UINT32_MAX;
 
-	// write out offset vectors, first unicodes
+	// collect heap values, their offsets are computed once the heap order is known, first unicodes
 	debug_n_string_unicode = 0;
 
-	#define PC_WRITE_OFFSET() if (is_32_offset && !(*cb->write)(&current_offset_32, sizeof(current_offset_32), cb->user, error)) {goto error_cleanup;} if (is_64_offset && !(*cb->write)(&current_offset_64, sizeof(current_offset_64), cb->user, error)) {goto error_cleanup;}
-	#define PC_INCREMENT_OFFSET(f) {current_offset_32 += (f); current_offset_64 += (f);}
-	#define PC_ALIGN_OFFSET() {current_offset_32 = align_next_4_32(current_offset_32); current_offset_64 = align_next_4_64(current_offset_64);}
+	#define PC_HEAP_VALUE(n_bytes, is_vector) {\
+		pointless_create_heap_value_t _h = {i, (is_vector), 0, (n_bytes)};\
+		uint64_t _offset = 0;\
+		heap_index[i] = (uint32_t)pointless_dynarray_n_items(&heap_values);\
+		if (!pointless_dynarray_push(&heap_values, &_h) || !pointless_dynarray_push(&offsets, &_offset)) {*error = "out of memory"; goto error_cleanup;}\
+	}
 
 	for (i = 0; i < n_values; i++) {
 		if (cv_value_type(i) == POINTLESS_UNICODE_) {
 			assert(cv_value_data_u32(i) == debug_n_string_unicode);
 
-			PC_WRITE_OFFSET();
-			PC_INCREMENT_OFFSET(sizeof(uint32_t) + (*((uint32_t*)cv_unicode_at(i)) + 1) * sizeof(pointless_unicode_char_t));
-			PC_ALIGN_OFFSET();
+			PC_HEAP_VALUE(sizeof(uint32_t) + (*((uint32_t*)cv_unicode_at(i)) + 1) * sizeof(pointless_unicode_char_t), 0);
 			debug_n_string_unicode += 1;
 		}
 
 		if (cv_value_type(i) == POINTLESS_STRING_) {
 			assert(cv_value_data_u32(i) == debug_n_string_unicode);
 
-			PC_WRITE_OFFSET();
-			PC_INCREMENT_OFFSET(sizeof(uint32_t) + (*((uint32_t*)cv_string_at(i)) + 1) * sizeof(uint8_t));
-			PC_ALIGN_OFFSET();
+			PC_HEAP_VALUE(sizeof(uint32_t) + (*((uint32_t*)cv_string_at(i)) + 1) * sizeof(uint8_t), 0);
+			debug_n_string_unicode += 1;
+		}
+
+		if (cv_value_type(i) == POINTLESS_STRING_SYMBOLS) {
+			assert(cv_value_data_u32(i) == debug_n_string_unicode);
+
+			PC_HEAP_VALUE(sizeof(uint32_t) + POINTLESS_STRING_SYMBOLS_N_CODES(*((uint32_t*)pointless_dynarray_ITEM_AT(void*, &c->string_symbols_values, cv_value_data_u32(i)))), 0);
 			debug_n_string_unicode += 1;
 		}
 	}
@@ -1023,7 +2678,7 @@ static int pointless_create_output_and_end_(pointless_create_t* c, pointless_cre
 		if (cv_is_outside_vector(i))
 			continue;
 
-		if (cv_value_type(i) == POINTLESS_VECTOR_EMPTY)
+		if (cv_value_type(i) == POINTLESS_VECTOR_EMPTY || pointless_is_encoded_vector_type(cv_value_type(i)))
 			continue;
 
 		uint32_t vector_heap_size = 0;
@@ -1066,9 +2721,7 @@ static int pointless_create_output_and_end_(pointless_create_t* c, pointless_cre
 				break;
 		}
 
-		PC_WRITE_OFFSET();
-		PC_INCREMENT_OFFSET(vector_heap_size);
-		PC_ALIGN_OFFSET();
+		PC_HEAP_VALUE(vector_heap_size, 1);
 		debug_n_priv_vectors += 1;
 	}
 
@@ -1084,7 +2737,7 @@ static int pointless_create_output_and_end_(pointless_create_t* c, pointless_cre
 		if (!cv_is_outside_vector(i))
 			continue;
 
-		if (cv_value_type(i) == POINTLESS_VECTOR_EMPTY)
+		if (cv_value_type(i) == POINTLESS_VECTOR_EMPTY || pointless_is_encoded_vector_type(cv_value_type(i)))
 			continue;
 
 		uint32_t vector_heap_size = 0;
@@ -1123,9 +2776,7 @@ static int pointless_create_output_and_end_(pointless_create_t* c, pointless_cre
 				break;
 		}
 
-		PC_WRITE_OFFSET();
-		PC_INCREMENT_OFFSET(vector_heap_size);
-		PC_ALIGN_OFFSET();
+		PC_HEAP_VALUE(vector_heap_size, 1);
 		debug_n_outside_vectors += 1;
 	}
 
@@ -1138,9 +2789,7 @@ static int pointless_create_output_and_end_(pointless_create_t* c, pointless_cre
 		if (cv_value_type(i) == POINTLESS_BITVECTOR) {
 			assert(cv_value_data_u32(i) == debug_n_bitvectors);
 
-			PC_WRITE_OFFSET();
-			PC_INCREMENT_OFFSET(sizeof(uint32_t) + ICEIL(*((uint32_t*)cv_bitvector_at(i)), 8));
-			PC_ALIGN_OFFSET();
+			PC_HEAP_VALUE(sizeof(uint32_t) + ICEIL(*((uint32_t*)cv_bitvector_at(i)), 8), 0);
 			debug_n_bitvectors += 1;
 		}
 	}
@@ -1154,9 +2803,7 @@ static int pointless_create_output_and_end_(pointless_create_t* c, pointless_cre
 		if (cv_value_type(i) == POINTLESS_SET_VALUE) {
 			assert(cv_value_data_u32(i) == debug_n_sets);
 
-			PC_WRITE_OFFSET();
-			PC_INCREMENT_OFFSET(sizeof(pointless_set_header_t));
-			PC_ALIGN_OFFSET();
+			PC_HEAP_VALUE(sizeof(pointless_set_header_t), 0);
 			debug_n_sets += 1;
 		}
 	}
@@ -1168,97 +2815,81 @@ static int pointless_create_output_and_end_(pointless_create_t* c, pointless_cre
 		if (cv_value_type(i) == POINTLESS_MAP_VALUE_VALUE) {
 			assert(cv_value_data_u32(i) == debug_n_maps);
 
-			PC_WRITE_OFFSET();
-			PC_INCREMENT_OFFSET(sizeof(pointless_map_header_t));
-			PC_ALIGN_OFFSET();
+			PC_HEAP_VALUE(sizeof(pointless_map_header_t), 0);
 			debug_n_maps += 1;
 		}
 	}
 
-	// write out heap, unicodes first
-	for (i = 0; i < n_values; i++) {
-		if (cv_value_type(i) == POINTLESS_UNICODE_) {
-			if (!pointless_serialize_unicode(cb, cv_unicode_at(i), error))
-				goto error_cleanup;
-		}
+	#undef PC_HEAP_VALUE
 
-		if (cv_value_type(i) == POINTLESS_STRING_) {
-			if (!pointless_serialize_string(cb, cv_string_at(i), error))
-				goto error_cleanup;
-		}
-	}
+	n_heap_values = (uint32_t)pointless_dynarray_n_items(&heap_values);
 
-	// private vectors
-	for (i = 0; i < n_values; i++) {
-		switch (cv_value_type(i)) {
-			case POINTLESS_VECTOR_VALUE:
-			case POINTLESS_VECTOR_VALUE_HASHABLE:
-				assert(!cv_is_outside_vector(i));
+	if (!pointless_create_heap_order_(c, n_values, heap_index, n_heap_values, &heap_order, error))
+		goto error_cleanup;
 
-				if (!pointless_serialize_vector_priv(c, i, cb, n_priv_vectors, error))
-					goto error_cleanup;
+	// offsets, refs are relative to heap base, vectors are padded for the alignment of their items
+	current_offset_64 = 0;
 
-				break;
-			case POINTLESS_VECTOR_I8:
-			case POINTLESS_VECTOR_U8:
-			case POINTLESS_VECTOR_I16:
-			case POINTLESS_VECTOR_U16:
-			case POINTLESS_VECTOR_I32:
-			case POINTLESS_VECTOR_U32:
-			case POINTLESS_VECTOR_I64:
-			case POINTLESS_VECTOR_U64:
-			case POINTLESS_VECTOR_FLOAT:
-				if (!cv_is_outside_vector(i)) {
-					if (!pointless_serialize_vector_priv(c, i, cb, n_priv_vectors, error))
-						goto error_cleanup;
-				}
-				break;
+	for (i = 0; i < n_heap_values; i++) {
+		h = &pointless_dynarray_ITEM_AT(pointless_create_heap_value_t, &heap_values, pointless_dynarray_ITEM_AT(uint32_t, &heap_order, i));
+
+		if (h->is_vector) {
+			alignment = pointless_create_vector_item_alignment(c, h->n_bytes - sizeof(uint32_t));
+			h->padding = (uint32_t)((alignment - (current_offset_64 + sizeof(uint32_t)) % alignment) % alignment);
+			current_offset_64 += h->padding;
 		}
+
+		pointless_dynarray_ITEM_AT(uint64_t, &offsets, pointless_dynarray_ITEM_AT(uint32_t, &heap_order, i)) = current_offset_64;
+		current_offset_64 = align_next_4_64(current_offset_64 + h->n_bytes);
 	}
 
-	// outside vectors
-	for (i = 0; i < n_values; i++) {
-		switch (cv_value_type(i)) {
-			case POINTLESS_VECTOR_I8:
-			case POINTLESS_VECTOR_U8:
-			case POINTLESS_VECTOR_I16:
-			case POINTLESS_VECTOR_U16:
-			case POINTLESS_VECTOR_I32:
-			case POINTLESS_VECTOR_U32:
-			case POINTLESS_VECTOR_I64:
-			case POINTLESS_VECTOR_U64:
-			case POINTLESS_VECTOR_FLOAT:
-				if (cv_is_outside_vector(i)) {
-					if (!pointless_serialize_vector_outside(c, i, cb, error))
-						goto error_cleanup;
-				}
+	// header
+	pointless_header_t header;
+	header.root = pointless_create_to_read_value(c, c->root, n_priv_vectors);
+	header.n_string_unicode = c->string_unicode_map_judy_count;
+	header.n_vector = n_priv_vectors + n_outside_vectors;
+	header.n_bitvector = c->bitvector_map_judy_count;
+	header.n_set = n_sets;
+	header.n_map = n_maps;
 
-				break;
-		}
-	}
+	assert(pointless_dynarray_n_items(&offsets) == (uint64_t)header.n_string_unicode + header.n_vector + header.n_bitvector + header.n_set + header.n_map);
 
-	// bitvectors
-	for (i = 0; i < n_values; i++) {
-		if (cv_value_type(i) == POINTLESS_BITVECTOR) {
-			if (!pointless_serialize_bitvector(cb, cv_bitvector_at(i), error))
-				goto error_cleanup;
-		}
-	}
+	// current_offset_64 is now the heap size
+	version = pointless_create_offset_version(c, &header, (uint64_t*)pointless_dynarray_buffer(&offsets), current_offset_64);
 
-	// sets
-	for (i = 0; i < n_values; i++) {
-		if (cv_value_type(i) == POINTLESS_SET_VALUE) {
-			if (!pointless_serialize_set(cb, c, i, n_priv_vectors, error))
-				goto error_cleanup;
-		}
+	if ((version == POINTLESS_FF_VERSION_OFFSET_32_OLDHASH || version == POINTLESS_FF_VERSION_OFFSET_32_NEWHASH || version == POINTLESS_FF_VERSION_OFFSET_32_MIXHASH) && current_offset_64 > UINT32_MAX) {
+		*error = "heap too large for 32-bit offsets";
+		goto error_cleanup;
 	}
 
-	// maps
-	for (i = 0; i < n_values; i++) {
-		if (cv_value_type(i) == POINTLESS_MAP_VALUE_VALUE) {
-			if (!pointless_serialize_map(cb, c, i, n_priv_vectors, error))
-				goto error_cleanup;
-		}
+	header.version = version | ((uint32_t)vector_alignment_log2 << 16) | ((uint32_t)large_vector_alignment_log2 << 24);
+
+	if (has_string_symbols)
+		header.version |= POINTLESS_FF_STRING_SYMBOLS;
+
+	// write it out
+	if (!(*cb->write)(&header, sizeof(header), cb->user, error))
+		goto error_cleanup;
+
+	// then the offset vectors
+	if (!pointless_create_write_offsets(cb, version, (uint64_t*)pointless_dynarray_buffer(&offsets), &header, &offsets_n_bytes, error))
+		goto error_cleanup;
+
+	// the heap starts at a multiple of the larger alignment, so that vector items aligned relative to the heap are
+	// also aligned relative to the file
+	heap_alignment = (c->vector_alignment > c->large_vector_alignment) ? c->vector_alignment : c->large_vector_alignment;
+	offsets_n_bytes += sizeof(header);
+
+	if (!pointless_create_write_padding(cb, ICEIL(offsets_n_bytes, heap_alignment) * heap_alignment - offsets_n_bytes, error))
+		goto error_cleanup;
+
+
+	// write out heap, in heap order
+	for (i = 0; i < n_heap_values; i++) {
+		h = &pointless_dynarray_ITEM_AT(pointless_create_heap_value_t, &heap_values, pointless_dynarray_ITEM_AT(uint32_t, &heap_order, i));
+
+		if (!pointless_serialize_heap_value(c, cb, h, n_priv_vectors, error))
+			goto error_cleanup;
 	}
 
 	retval = 1;
@@ -1271,6 +2902,10 @@ error_cleanup:
 success_cleanup:
 
 	pointless_dynarray_destroy(&new_priv_vector_values);
+	pointless_dynarray_destroy(&offsets);
+	pointless_dynarray_destroy(&heap_values);
+	pointless_dynarray_destroy(&heap_order);
+	pointless_free(heap_index);
 	pointless_free(priv_vector_bitmask);
 	pointless_free(outside_vector_bitmask);
 
@@ -1530,6 +3165,45 @@ uint32_t pointless_create_u32(pointless_create_t* c, uint32_t v)
 	return handle;
 }
 
+static uint32_t pointless_create_int_64_priv(pointless_create_t* c, uint32_t type, uint64_t v)
+{
+	pointless_create_value_t cv;
+	cv.header.type_29 = type;
+	cv.header.is_outside_vector = 0;
+	cv.header.is_set_map_vector = 0;
+	cv.header.is_compressed_vector = 0;
+	cv.data.data_u32 = pointless_dynarray_n_items(&c->int_64_values);
+
+	if (!pointless_dynarray_push(&c->int_64_values, &v))
+		return POINTLESS_CREATE_VALUE_FAIL;
+
+	if (!pointless_dynarray_push(&c->values, &cv)) {
+		pointless_dynarray_pop(&c->int_64_values);
+		return POINTLESS_CREATE_VALUE_FAIL;
+	}
+
+	return pointless_dynarray_n_items(&c->values) - 1;
+}
+
+uint32_t pointless_create_i64(pointless_create_t* c, int64_t v)
+{
+	if (v >= 0)
+		return pointless_create_u64(c, (uint64_t)v);
+
+	if (INT32_MIN <= v)
+		return pointless_create_i32(c, (int32_t)v);
+
+	return pointless_create_int_64_priv(c, POINTLESS_I64, (uint64_t)v);
+}
+
+uint32_t pointless_create_u64(pointless_create_t* c, uint64_t v)
+{
+	if (v <= UINT32_MAX)
+		return pointless_create_u32(c, (uint32_t)v);
+
+	return pointless_create_int_64_priv(c, POINTLESS_U64, v);
+}
+
 uint32_t pointless_create_float(pointless_create_t* c, float v)
 {
 	pointless_create_and_return_inline_value_1(c, v, pointless_value_create_float);
@@ -1597,6 +3271,12 @@ uint32_t pointless_create_empty_slot(pointless_create_t* c)
 	return handle;
 }
 
+static uint32_t pointless_create_string_inline_priv(pointless_create_t* c, uint8_t* v, uint32_t len)
+{
+	pointless_create_value_t cv = pointless_value_create_string_inline(v, len);
+	return pointless_dynarray_push(&c->values, &cv) ? (pointless_dynarray_n_items(&c->values) - 1) : POINTLESS_CREATE_VALUE_FAIL;
+}
+
 static uint32_t pointless_create_null_priv(pointless_create_t* c)
 {
 	pointless_create_and_return_inline_value_2(c, pointless_value_create_null);
@@ -1708,8 +3388,13 @@ uint32_t pointless_create_string_ascii(pointless_create_t* c, uint8_t* v)
 
 	uint8_t* vv;
 
-	// create buffer to hold [uint32 + v]
 	size_t string_len = pointless_ascii_len(v);
+
+	// short strings need no buffer, and are not interned, they are compared by value
+	if (c->inline_strings && string_len <= POINTLESS_STRING_INLINE_MAX_LEN)
+		return pointless_create_string_inline_priv(c, v, (uint32_t)string_len);
+
+	// create buffer to hold [uint32 + v]
 	size_t buffer_len = sizeof(uint32_t) + sizeof(uint8_t) * (string_len + 1);
 	void* string_buffer = pointless_malloc(buffer_len);
 
@@ -2364,6 +4049,7 @@ uint32_t pointless_create_set(pointless_create_t* c)
 	pointless_dynarray_init(&set.keys, sizeof(uint32_t));
 	set.serialize_hash = pointless_create_vector_u32(c);
 	set.serialize_keys = pointless_create_vector_value(c);
+	set.serialize_bloom = POINTLESS_CREATE_VALUE_FAIL;
 
 	// NOTE: possible array leak here on failure
 	if (set.serialize_hash == POINTLESS_CREATE_VALUE_FAIL)
@@ -2427,6 +4113,9 @@ uint32_t pointless_create_map(pointless_create_t* c)
 	map.serialize_hash = pointless_create_vector_u32(c);
 	map.serialize_keys = pointless_create_vector_value(c);
 	map.serialize_values = pointless_create_vector_value(c);
+	map.serialize_bloom = POINTLESS_CREATE_VALUE_FAIL;
+	map.serialize_is_dense = 0;
+	map.serialize_schema = POINTLESS_CREATE_VALUE_FAIL;
 
 	// NOTE: possible array leak here on failure
 	if (map.serialize_hash == POINTLESS_CREATE_VALUE_FAIL)
@@ -2476,3 +4165,43 @@ uint32_t pointless_create_map_add(pointless_create_t* c, uint32_t m, uint32_t k,
 
 	return m;
 }
+
+// tables
+uint32_t pointless_create_table(pointless_create_t* c, uint32_t n_rows, uint32_t keys)
+{
+	// the table is a private value vector: [n_rows, keys, column_0, ..., column_n]
+	uint32_t n_rows_handle = pointless_create_u32(c, n_rows);
+	uint32_t vector = pointless_create_vector_value(c);
+
+	if (n_rows_handle == POINTLESS_CREATE_VALUE_FAIL || vector == POINTLESS_CREATE_VALUE_FAIL)
+		return POINTLESS_CREATE_VALUE_FAIL;
+
+	if (pointless_create_vector_value_append(c, vector, n_rows_handle) == POINTLESS_CREATE_VALUE_FAIL)
+		return POINTLESS_CREATE_VALUE_FAIL;
+
+	if (pointless_create_vector_value_append(c, vector, keys) == POINTLESS_CREATE_VALUE_FAIL)
+		return POINTLESS_CREATE_VALUE_FAIL;
+
+	// create the value, which refers to the vector handle until serialization
+	pointless_create_value_t value;
+	value.header.type_29 = POINTLESS_TABLE;
+	value.header.is_outside_vector = 0;
+	value.header.is_set_map_vector = 0;
+	value.header.is_compressed_vector = 0;
+	value.data.data_u32 = vector;
+
+	if (!pointless_dynarray_push(&c->values, &value))
+		return POINTLESS_CREATE_VALUE_FAIL;
+
+	return (pointless_dynarray_n_items(&c->values) - 1);
+}
+
+uint32_t pointless_create_table_add_column(pointless_create_t* c, uint32_t t, uint32_t column)
+{
+	assert(cv_value_type(t) == POINTLESS_TABLE);
+
+	if (pointless_create_vector_value_append(c, cv_value_data_u32(t), column) == POINTLESS_CREATE_VALUE_FAIL)
+		return POINTLESS_CREATE_VALUE_FAIL;
+
+	return t;
+}
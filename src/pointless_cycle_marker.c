@@ -62,6 +62,9 @@ static uint32_t pointless_is_container(pointless_value_t* v)
 	if (v->type == POINTLESS_VECTOR_VALUE || v->type == POINTLESS_VECTOR_VALUE_HASHABLE)
 		return 1;
 
+	if (v->type == POINTLESS_TABLE)
+		return 1;
+
 	if (v->type == POINTLESS_SET_VALUE || v->type == POINTLESS_MAP_VALUE_VALUE)
 		return 1;
 
@@ -196,6 +199,19 @@ static void pointless_cycle_marker_visit(pointless_cycle_marker_state_t* state,
 		uint32_t i, n_items = pointless_reader_vector_n_items(state->p, v);
 		pointless_value_t* children = pointless_reader_vector_value(state->p, v);
 
+		for (i = 0; i < n_items; i++) {
+			if (pointless_is_container(&children[i])) {
+				process_child(state, v_id, &children[i], count, depth);
+
+				if (state->error)
+					return;
+			}
+		}
+	} else if (v->type == POINTLESS_TABLE) {
+		// keys are followed by the columns
+		uint32_t i, n_items = pointless_reader_table_n_columns(state->p, v) + 1;
+		pointless_value_t* children = pointless_reader_table_keys(state->p, v);
+
 		for (i = 0; i < n_items; i++) {
 			if (pointless_is_container(&children[i])) {
 				process_child(state, v_id, &children[i], count, depth);
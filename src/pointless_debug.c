@@ -89,6 +89,8 @@ static void pointless_print_vector_other(pointless_debug_state_t* state, pointle
 	unsigned long long int uu = 0;
 	long long int ii = 0;
 	float ff = 0.0;
+	int64_t i64;
+	uint64_t u64;
 
 	fprintf(state->out, "H[");
 
@@ -118,12 +120,15 @@ static void pointless_print_vector_other(pointless_debug_state_t* state, pointle
 				uu = (unsigned long long int)(pointless_reader_vector_u32(state->p, v)[i]);
 				is_unsigned = 1;
 				break;
+			// 64-bit items are only 4-byte aligned
 			case POINTLESS_VECTOR_I64:
-				ii = (long long int)(pointless_reader_vector_i64(state->p, v)[i]);
+				memcpy(&i64, pointless_reader_vector_i64(state->p, v) + i, sizeof(i64));
+				ii = (long long int)i64;
 				is_signed = 1;
 				break;
 			case POINTLESS_VECTOR_U64:
-				uu = (unsigned long long int)(pointless_reader_vector_u64(state->p, v)[i]);
+				memcpy(&u64, pointless_reader_vector_u64(state->p, v) + i, sizeof(u64));
+				uu = (unsigned long long int)u64;
 				is_unsigned = 1;
 				break;
 			case POINTLESS_VECTOR_FLOAT:
@@ -172,8 +177,9 @@ static void pointless_print_unicode(pointless_debug_state_t* state, pointless_va
 
 static void pointless_print_string(pointless_debug_state_t* state, pointless_value_t* v)
 {
-	assert(v->type == POINTLESS_STRING_);
-	uint8_t* s = pointless_reader_string_value_ascii(state->p, v);
+	assert(pointless_is_string_8_type(v->type));
+	uint8_t buffer[POINTLESS_STRING_SYMBOLS_BUFFER_LEN];
+	uint8_t* s = pointless_reader_string_value_ascii_buffer(state->p, v, buffer);
 
 	fprintf(state->out, "\"");
 
@@ -224,18 +230,57 @@ static void pointless_print_vector_value(pointless_debug_state_t* state, pointle
 	fprintf(state->out, "]");
 }
 
+// a set/map key or value, the key/value vectors may be primitive vectors
+static void pointless_print_entry(pointless_debug_state_t* state, pointless_value_t* vector, uint32_t entry, uint32_t depth)
+{
+	if (vector->type == POINTLESS_VECTOR_VALUE || vector->type == POINTLESS_VECTOR_VALUE_HASHABLE) {
+		pointless_print_value(state, &pointless_reader_vector_value(state->p, vector)[entry], depth);
+		return;
+	}
+
+	pointless_complete_value_t cv = pointless_reader_vector_value_case(state->p, vector, entry);
+
+	switch (cv.type) {
+		case POINTLESS_I64:
+			fprintf(state->out, "%lli", (long long int)cv.complete_data.data_i64);
+			return;
+		case POINTLESS_U64:
+			fprintf(state->out, "%llu", (unsigned long long int)cv.complete_data.data_u64);
+			return;
+	}
+
+	pointless_value_t v = pointless_value_from_complete(&cv);
+	pointless_print_value(state, &v, depth);
+}
+
+// keys of dense maps are not stored in a vector
+static void pointless_print_map_key(pointless_debug_state_t* state, pointless_value_t* m, uint32_t entry, uint32_t depth)
+{
+	if (!pointless_reader_map_is_dense(state->p, m)) {
+		pointless_print_entry(state, pointless_map_key_vector(state->p, m), entry, depth);
+		return;
+	}
+
+	pointless_complete_value_t cv = pointless_reader_map_key(state->p, m, entry);
+	pointless_value_t v = pointless_value_from_complete(&cv);
+	pointless_print_value(state, &v, depth);
+}
+
+typedef pointless_complete_value_t (*pv_key_cb)(pointless_t* p, pointless_value_t* v, uint32_t entry);
+
 typedef struct {
 	pointless_t* p;
-	pointless_value_t* keys;
-	pointless_value_t* values;
+	pointless_value_t* v;
+	pv_key_cb key;
+	uint32_t* entries;
 	const char** error;
 } pv_sort_state_t;
 
 static int pv_cmp(int a, int b, int* c, void* user)
 {
 	pv_sort_state_t* state = (pv_sort_state_t*)user;
-	pointless_complete_value_t v_a = pointless_value_to_complete(&state->keys[a]);
-	pointless_complete_value_t v_b = pointless_value_to_complete(&state->keys[b]);
+	pointless_complete_value_t v_a = (*state->key)(state->p, state->v, state->entries[a]);
+	pointless_complete_value_t v_b = (*state->key)(state->p, state->v, state->entries[b]);
 	int32_t v = pointless_cmp_reader(state->p, &v_a, state->p, &v_b, state->error);
 	*c = (int)v;
 	return (state->error != 0);
@@ -244,23 +289,48 @@ static int pv_cmp(int a, int b, int* c, void* user)
 static void pv_swap(int a, int b, void* user)
 {
 	pv_sort_state_t* state = (pv_sort_state_t*)user;
-	pointless_value_t t = state->keys[a];
-	state->keys[a] = state->keys[b];
-	state->keys[b] = t;
-
-	if (state->values) {
-		t = state->values[a];
-		state->values[a] = state->values[b];
-		state->values[b] = t;
+	uint32_t t = state->entries[a];
+	state->entries[a] = state->entries[b];
+	state->entries[b] = t;
+}
+
+// entries of a set/map, sorted by key
+static uint32_t* pointless_print_sorted_entries(pointless_debug_state_t* state, uint32_t n_keys, uint32_t (*iter_entry)(pointless_t*, pointless_value_t*, uint32_t*, uint32_t*), pv_key_cb key, pointless_value_t* v)
+{
+	uint32_t i = 0, j = 0, entry = 0;
+	uint32_t* entries = (uint32_t*)pointless_malloc(sizeof(uint32_t) * (n_keys + 1));
+
+	if (entries == 0) {
+		*state->error = "out of memory";
+		return 0;
 	}
+
+	while ((*iter_entry)(state->p, v, &entry, &i))
+		entries[j++] = entry;
+
+	assert(j == n_keys);
+
+	pv_sort_state_t sort_state;
+	sort_state.p = state->p;
+	sort_state.v = v;
+	sort_state.key = key;
+	sort_state.entries = entries;
+	sort_state.error = state->error;
+
+	if (!bentley_sort_((int)n_keys, pv_cmp, pv_swap, (void*)&sort_state)) {
+		pointless_free(entries);
+		return 0;
+	}
+
+	return entries;
 }
 
 static void pointless_print_set(pointless_debug_state_t* state, pointless_value_t* v, uint32_t depth)
 {
 	assert(v->type == POINTLESS_SET_VALUE);
 
-	uint32_t i = 0, j = 0, first = 1;
-	pointless_value_t* k = 0;
+	uint32_t i = 0, entry = 0, first = 1;
+	pointless_value_t* key_vector = pointless_set_key_vector(state->p, v);
 
 	fprintf(state->out, "set([");
 
@@ -271,51 +341,27 @@ static void pointless_print_set(pointless_debug_state_t* state, pointless_value_
 			return;
 
 		if (state->sort_set) {
-			// allocate keys buffer
 			uint32_t n_keys = pointless_reader_set_n_items(state->p, v);
-			pointless_value_t* keys = (pointless_value_t*)pointless_malloc(sizeof(pointless_value_t) * n_keys);
-
-			if (keys == 0) {
-				*state->error = "out of memory";
-				return;
-			}
+			uint32_t* entries = pointless_print_sorted_entries(state, n_keys, pointless_reader_set_iter_entry, pointless_reader_set_key, v);
 
-			i = 0, j = 0;
-
-			while (pointless_reader_set_iter(state->p, v, &k, &i))
-				keys[j++] = *k;
-
-			assert(j == n_keys);
-
-			pv_sort_state_t sort_state;
-			sort_state.p = state->p;
-			sort_state.keys = keys;
-			sort_state.values = 0;
-			sort_state.error = state->error;
-
-			// sort keys
-			if (!bentley_sort_((int)n_keys, pv_cmp, pv_swap, (void*)&sort_state)) {
-				pointless_free(keys);
+			if (entries == 0)
 				return;
-			}
 
 			// print them out, in order
 			for (i = 0; i < n_keys; i++) {
 				if (i > 0)
 					fprintf(state->out, ", ");
 
-				pointless_print_value(state, &keys[i], depth + 1);
+				pointless_print_entry(state, key_vector, entries[i], depth + 1);
 			}
 
-			pointless_free(keys);
-			keys = 0;
-
+			pointless_free(entries);
 		} else {
-			while (pointless_reader_set_iter(state->p, v, &k, &i)) {
+			while (pointless_reader_set_iter_entry(state->p, v, &entry, &i)) {
 				if (!first)
 					fprintf(state->out, ", ");
 
-				pointless_print_value(state, k, depth + 1);
+				pointless_print_entry(state, key_vector, entry, depth + 1);
 
 				first = 0;
 			}
@@ -331,78 +377,43 @@ static void pointless_print_map(pointless_debug_state_t* state, pointless_value_
 {
 	assert(v->type == POINTLESS_MAP_VALUE_VALUE);
 
-	uint32_t i = 0, j = 0, is_first = 1;
+	uint32_t i = 0, entry = 0, is_first = 1;
+	pointless_value_t* value_vector = pointless_map_value_vector(state->p, v);
 
 	fprintf(state->out, "{");
 
 	if (pointless_print_has_container(state, v)) {
 		fprintf(state->out, "...");
 	} else {
-		pointless_value_t* key = 0;
-		pointless_value_t* value = 0;
-
 		if (!pointless_print_push_container(state, v))
 			return;
 
 		if (state->sort_map) {
-			// allocate keys buffer
 			uint32_t n_keys = pointless_reader_map_n_items(state->p, v);
-			pointless_value_t* keys = (pointless_value_t*)pointless_malloc(sizeof(pointless_value_t) * n_keys);
-			pointless_value_t* values = (pointless_value_t*)pointless_malloc(sizeof(pointless_value_t) * n_keys);
+			uint32_t* entries = pointless_print_sorted_entries(state, n_keys, pointless_reader_map_iter_entry, pointless_reader_map_key, v);
 
-			if (keys == 0 || values == 0) {
-				pointless_free(keys);
-				pointless_free(values);
-				*state->error = "out of memory";
+			if (entries == 0)
 				return;
-			}
-
-			i = 0, j = 0;
-
-			while (pointless_reader_map_iter(state->p, v, &key, &value, &i)) {
-				keys[j] = *key;
-				values[j] = *value;
-				j += 1;
-			}
-
-			assert(j == n_keys);
-
-			pv_sort_state_t sort_state;
-			sort_state.p = state->p;
-			sort_state.keys = keys;
-			sort_state.values = values;
-			sort_state.error = state->error;
-
-			// sort keys
-			if (!bentley_sort_((int)n_keys, pv_cmp, pv_swap, (void*)&sort_state)) {
-				pointless_free(keys);
-				pointless_free(values);
-				return;
-			}
 
 			// print them out, in order
 			for (i = 0; i < n_keys; i++) {
 				if (i > 0)
 					fprintf(state->out, ", ");
 
-				pointless_print_value(state, &keys[i], depth + 1);
+				pointless_print_map_key(state, v, entries[i], depth + 1);
 				fprintf(state->out, ": ");
-				pointless_print_value(state, &values[i], depth + 1);
+				pointless_print_entry(state, value_vector, entries[i], depth + 1);
 			}
 
-			pointless_free(keys);
-			pointless_free(values);
-
-			keys = 0;
-			values = 0;
+			pointless_free(entries);
 		} else {
-			while (pointless_reader_map_iter(state->p, v, &key, &value, &i)) {
+			while (pointless_reader_map_iter_entry(state->p, v, &entry, &i)) {
 				if (!is_first)
 					fprintf(state->out, ", ");
 
-				pointless_print_value(state, key, depth + 1);
+				pointless_print_map_key(state, v, entry, depth + 1);
 				fprintf(state->out, ": ");
-				pointless_print_value(state, value, depth + 1);
+				pointless_print_entry(state, value_vector, entry, depth + 1);
 
 				is_first = 0;
 			}
@@ -414,6 +425,54 @@ static void pointless_print_map(pointless_debug_state_t* state, pointless_value_
 	fprintf(state->out, "}");
 }
 
+static void pointless_print_table(pointless_debug_state_t* state, pointless_value_t* v, uint32_t depth)
+{
+	assert(v->type == POINTLESS_TABLE);
+
+	uint32_t i, n_columns = pointless_reader_table_n_columns(state->p, v);
+	pointless_value_t* columns = pointless_reader_table_columns(state->p, v);
+
+	// keys and columns, as stored
+	fprintf(state->out, "T(");
+
+	if (pointless_print_has_container(state, v)) {
+		fprintf(state->out, "...");
+	} else {
+		if (!pointless_print_push_container(state, v))
+			return;
+
+		pointless_print_value(state, pointless_reader_table_keys(state->p, v), depth + 1);
+
+		for (i = 0; i < n_columns; i++) {
+			fprintf(state->out, ", ");
+			pointless_print_value(state, &columns[i], depth + 1);
+		}
+
+		pointless_print_pop_container(state);
+	}
+
+	fprintf(state->out, ")");
+}
+
+static void pointless_print_encoded_vector(pointless_debug_state_t* state, pointless_value_t* v, uint32_t depth)
+{
+	assert(pointless_is_encoded_vector_type(v->type));
+
+	uint32_t i, n_items = pointless_reader_vector_n_items(state->p, v);
+
+	// decoded items, the values are never containers
+	fprintf(state->out, (v->type == POINTLESS_VECTOR_DICTIONARY) ? "D[" : (v->type == POINTLESS_VECTOR_RUNS) ? "R[" : (v->type == POINTLESS_VECTOR_SPLIT) ? "S[" : "B[");
+
+	for (i = 0; i < n_items; i++) {
+		pointless_print_entry(state, v, i, depth + 1);
+
+		if (i + 1 < n_items)
+			fprintf(state->out, ",");
+	}
+
+	fprintf(state->out, "]");
+}
+
 static void pointless_print_value(pointless_debug_state_t* state, pointless_value_t* v, uint32_t depth)
 {
 	switch (v->type) {
@@ -421,6 +480,8 @@ static void pointless_print_value(pointless_debug_state_t* state, pointless_valu
 			pointless_print_unicode(state, v);
 			break;
 		case POINTLESS_STRING_:
+		case POINTLESS_STRING_INLINE:
+		case POINTLESS_STRING_SYMBOLS:
 			pointless_print_string(state, v);
 			break;
 		case POINTLESS_VECTOR_VALUE:
@@ -479,6 +540,17 @@ static void pointless_print_value(pointless_debug_state_t* state, pointless_valu
 			assert(v->data.data_u32 < state->p->header->n_map);
 			pointless_print_map(state, v, depth);
 			break;
+		case POINTLESS_TABLE:
+			assert(v->data.data_u32 < state->p->header->n_vector);
+			pointless_print_table(state, v, depth);
+			break;
+		case POINTLESS_VECTOR_DICTIONARY:
+		case POINTLESS_VECTOR_RUNS:
+		case POINTLESS_VECTOR_SPLIT:
+		case POINTLESS_VECTOR_BLOCKS:
+			assert(v->data.data_u32 < state->p->header->n_vector);
+			pointless_print_encoded_vector(state, v, depth);
+			break;
 		default:
 			// should not have passed validation
 			fprintf(state->out, "<UNKNOWN:%u>", (unsigned int)v->type);
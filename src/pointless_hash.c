@@ -1,4 +1,5 @@
 #include <math.h>
+#include <string.h>
 
 #include <pointless/pointless_defs.h>
 #include <pointless/pointless_value.h>
@@ -53,96 +54,272 @@ uint32_t pointless_hash_string_v0_32_(uint8_t* s, size_t n)
 	POINTLESS_HASH_STRING_32_(s, n);
 }
 
-typedef uint32_t (*pointless_hash_reader_32_cb)(pointless_t* p, pointless_value_t* v);
-typedef uint32_t (*pointless_hash_create_32_cb)(pointless_create_t* c, pointless_create_value_t* v);
+// version 2
+#define HASH_V2_P0 0xa0761d6478bd642fULL
+#define HASH_V2_P1 0xe7037ed1a0b428dbULL
+#define HASH_V2_P2 0x8ebc6af09c88c6e3ULL
+#define HASH_V2_P3 0x589965cc75374cc3ULL
 
-// unicode is easy
-static uint32_t pointless_hash_reader_unicode_32(pointless_t* p, pointless_value_t* v)
+// seeds, for unicode strings which are not 8-bit strings
+#define HASH_V2_SEED_STRING HASH_V2_P0
+#define HASH_V2_SEED_UNICODE HASH_V2_P3
+
+static uint64_t pointless_hash_v2_mum(uint64_t a, uint64_t b)
 {
-	uint32_t* s = pointless_reader_unicode_value_ucs4(p, v);
-	uint32_t hash = 0;
+#ifdef __SIZEOF_INT128__
+	__uint128_t r = (__uint128_t)a * b;
+	return ((uint64_t)r ^ (uint64_t)(r >> 64));
+#else
+	uint64_t a_lo = (uint32_t)a, a_hi = a >> 32, b_lo = (uint32_t)b, b_hi = b >> 32;
+	uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+	uint64_t cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+	uint64_t lo = (cross << 32) | (uint32_t)lo_lo;
+	uint64_t hi = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+	return (lo ^ hi);
+#endif
+}
 
-	switch (p->header->version) {
-		case POINTLESS_FF_VERSION_OFFSET_32_OLDHASH:
-			hash = pointless_hash_unicode_ucs4_v0_32(s);
-			break;
-		case POINTLESS_FF_VERSION_OFFSET_32_NEWHASH:
-		case POINTLESS_FF_VERSION_OFFSET_64_NEWHASH:
-			hash = pointless_hash_unicode_ucs4_v1_32(s);
-			break;
-		default:
-			assert(0);
-			break;
+static uint64_t pointless_hash_v2_step(uint64_t h, uint64_t* w)
+{
+	uint64_t a = pointless_hash_v2_mum(w[0] ^ HASH_V2_P1, w[1] ^ h);
+	uint64_t b = pointless_hash_v2_mum(w[2] ^ HASH_V2_P2, w[3] ^ h);
+	return (a ^ b);
+}
+
+void pointless_hash_v2_init(pointless_hash_v2_state_t* state, uint64_t seed)
+{
+	state->h = seed;
+	state->n_bytes = 0;
+}
+
+void pointless_hash_v2_update(pointless_hash_v2_state_t* state, const void* s, size_t n)
+{
+	const uint8_t* b = (const uint8_t*)s;
+	size_t k = (size_t)(state->n_bytes % 32), m;
+
+	state->n_bytes += n;
+
+	// complete a partial block
+	if (k > 0) {
+		m = (n < 32 - k) ? n : 32 - k;
+		memcpy(state->block.u8 + k, b, m);
+
+		if (k + m < 32)
+			return;
+
+		state->h = pointless_hash_v2_step(state->h, state->block.u64);
+		b += m;
+		n -= m;
+	}
+
+	for (; n >= 32; b += 32, n -= 32) {
+		memcpy(state->block.u64, b, 32);
+		state->h = pointless_hash_v2_step(state->h, state->block.u64);
 	}
 
-	return hash;
+	memcpy(state->block.u8, b, n);
 }
 
-static uint32_t pointless_hash_create_unicode_32(pointless_create_t* c, pointless_create_value_t* v)
+void pointless_hash_v2_update_32(pointless_hash_v2_state_t* state, uint32_t v)
+{
+	assert(state->n_bytes % 4 == 0);
+
+	state->block.u32[(state->n_bytes % 32) / 4] = v;
+	state->n_bytes += 4;
+
+	if (state->n_bytes % 32 == 0)
+		state->h = pointless_hash_v2_step(state->h, state->block.u64);
+}
+
+static uint64_t pointless_hash_v2_read_64(const uint8_t* p)
+{
+	uint64_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static uint64_t pointless_hash_v2_read_32(const uint8_t* p)
 {
-	uint32_t* s = ((uint32_t*)cv_get_unicode(v) + 1);
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+// the last, partial, block of 'k' bytes, read in overlapping pieces, after wyhash, and the number of bytes
+static uint32_t pointless_hash_v2_end_priv(uint64_t h, const uint8_t* p, size_t k, uint64_t n_bytes)
+{
+	uint64_t w[4];
+
+	if (k > 16) {
+		w[0] = pointless_hash_v2_read_64(p);
+		w[1] = pointless_hash_v2_read_64(p + 8);
+		w[2] = pointless_hash_v2_read_64(p + k - 16);
+		w[3] = pointless_hash_v2_read_64(p + k - 8);
+		h = pointless_hash_v2_step(h, w);
+	} else if (k >= 4) {
+		w[0] = (pointless_hash_v2_read_32(p) << 32) | pointless_hash_v2_read_32(p + ((k >> 3) << 2));
+		w[1] = (pointless_hash_v2_read_32(p + k - 4) << 32) | pointless_hash_v2_read_32(p + k - 4 - ((k >> 3) << 2));
+		h = pointless_hash_v2_mum(w[0] ^ HASH_V2_P1, w[1] ^ h);
+	} else if (k > 0) {
+		w[0] = ((uint64_t)p[0] << 16) | ((uint64_t)p[k >> 1] << 8) | p[k - 1];
+		h = pointless_hash_v2_mum(w[0] ^ HASH_V2_P1, h);
+	}
 
-	uint32_t hash = 0;
+	h = pointless_hash_v2_mum(h ^ HASH_V2_P0, n_bytes ^ HASH_V2_P3);
+	return (uint32_t)(h ^ (h >> 32));
+}
+
+uint32_t pointless_hash_v2_end(pointless_hash_v2_state_t* state)
+{
+	return pointless_hash_v2_end_priv(state->h, state->block.u8, (size_t)(state->n_bytes % 32), state->n_bytes);
+}
+
+// same as pointless_hash_v2_update() on a new state, without the copies
+uint32_t pointless_hash_string_v2_32_(uint8_t* s, size_t n)
+{
+	uint64_t h = HASH_V2_SEED_STRING, w[4];
+	size_t i;
+
+	for (i = 0; i + 32 <= n; i += 32) {
+		memcpy(w, s + i, 32);
+		h = pointless_hash_v2_step(h, w);
+	}
 
-	switch (c->version) {
+	return pointless_hash_v2_end_priv(h, s + i, n - i, n);
+}
+
+uint32_t pointless_hash_string_v2_32(uint8_t* s)
+{
+	return pointless_hash_string_v2_32_(s, strlen((char*)s));
+}
+
+// unicode strings of 8-bit characters are narrowed, and others widened to 32-bit characters, 32 bytes at a time
+#define POINTLESS_HASH_UNICODE_V2_32(s, T) \
+	{ \
+		size_t n = 0, i, j; T m = 0; \
+		while ((s)[n]) { m |= (s)[n]; n++; } \
+		pointless_hash_v2_state_t state; \
+		union { uint8_t u8[32]; uint32_t u32[8]; } b; \
+		if (m <= 0xFF) { \
+			pointless_hash_v2_init(&state, HASH_V2_SEED_STRING); \
+			for (i = 0; i < n; i += j) { for (j = 0; j < 32 && i + j < n; j++) b.u8[j] = (uint8_t)(s)[i + j]; pointless_hash_v2_update(&state, b.u8, j); } \
+		} else { \
+			pointless_hash_v2_init(&state, HASH_V2_SEED_UNICODE); \
+			for (i = 0; i < n; i += j) { for (j = 0; j < 8 && i + j < n; j++) b.u32[j] = (uint32_t)(s)[i + j]; pointless_hash_v2_update(&state, b.u32, j * sizeof(uint32_t)); } \
+		} \
+		return pointless_hash_v2_end(&state); \
+	}
+
+uint32_t pointless_hash_unicode_ucs4_v2_32(uint32_t* s)
+{
+	POINTLESS_HASH_UNICODE_V2_32(s, uint32_t)
+}
+
+uint32_t pointless_hash_unicode_ucs2_v2_32(uint16_t* s)
+{
+	POINTLESS_HASH_UNICODE_V2_32(s, uint16_t)
+}
+
+uint32_t pointless_hash_unicode_ucs4_32(uint32_t version, uint32_t* s)
+{
+	switch (version) {
 		case POINTLESS_FF_VERSION_OFFSET_32_OLDHASH:
-			hash = pointless_hash_unicode_ucs4_v0_32(s);
-			break;
+			return pointless_hash_unicode_ucs4_v0_32(s);
 		case POINTLESS_FF_VERSION_OFFSET_32_NEWHASH:
 		case POINTLESS_FF_VERSION_OFFSET_64_NEWHASH:
-			hash = pointless_hash_unicode_ucs4_v1_32(s);
-			break;
-		default:
-			assert(0);
-			break;
+		case POINTLESS_FF_VERSION_OFFSET_DELTA_NEWHASH:
+			return pointless_hash_unicode_ucs4_v1_32(s);
+		case POINTLESS_FF_VERSION_OFFSET_32_MIXHASH:
+		case POINTLESS_FF_VERSION_OFFSET_64_MIXHASH:
+		case POINTLESS_FF_VERSION_OFFSET_DELTA_MIXHASH:
+			return pointless_hash_unicode_ucs4_v2_32(s);
 	}
 
-	return hash;
+	assert(0);
+	return 0;
 }
 
-static uint32_t pointless_hash_reader_string_32(pointless_t* p, pointless_value_t* v)
+uint32_t pointless_hash_unicode_ucs2_32(uint32_t version, uint16_t* s)
 {
-	uint8_t* s = pointless_reader_string_value_ascii(p, v);
-	uint32_t hash = 0;
-
-	switch (p->header->version) {
+	switch (version) {
 		case POINTLESS_FF_VERSION_OFFSET_32_OLDHASH:
-			hash = pointless_hash_string_v0_32(s);
-			break;
+			return pointless_hash_unicode_ucs2_v0_32(s);
 		case POINTLESS_FF_VERSION_OFFSET_32_NEWHASH:
 		case POINTLESS_FF_VERSION_OFFSET_64_NEWHASH:
-			hash = pointless_hash_string_v1_32(s);
-			break;
-		default:
-			assert(0);
-			break;
+		case POINTLESS_FF_VERSION_OFFSET_DELTA_NEWHASH:
+			return pointless_hash_unicode_ucs2_v1_32(s);
+		case POINTLESS_FF_VERSION_OFFSET_32_MIXHASH:
+		case POINTLESS_FF_VERSION_OFFSET_64_MIXHASH:
+		case POINTLESS_FF_VERSION_OFFSET_DELTA_MIXHASH:
+			return pointless_hash_unicode_ucs2_v2_32(s);
 	}
 
-	return hash;
+	assert(0);
+	return 0;
 }
 
-static uint32_t pointless_hash_create_string_32(pointless_create_t* c, pointless_create_value_t* v)
+uint32_t pointless_hash_string_32(uint32_t version, uint8_t* s)
 {
-	uint8_t* s = (uint8_t*)((uint32_t*)cv_get_string(v) + 1);
+	switch (version) {
+		case POINTLESS_FF_VERSION_OFFSET_32_OLDHASH:
+			return pointless_hash_string_v0_32(s);
+		case POINTLESS_FF_VERSION_OFFSET_32_NEWHASH:
+		case POINTLESS_FF_VERSION_OFFSET_64_NEWHASH:
+		case POINTLESS_FF_VERSION_OFFSET_DELTA_NEWHASH:
+			return pointless_hash_string_v1_32(s);
+		case POINTLESS_FF_VERSION_OFFSET_32_MIXHASH:
+		case POINTLESS_FF_VERSION_OFFSET_64_MIXHASH:
+		case POINTLESS_FF_VERSION_OFFSET_DELTA_MIXHASH:
+			return pointless_hash_string_v2_32(s);
+	}
 
-	uint32_t hash = 0;
+	assert(0);
+	return 0;
+}
 
-	switch (c->version) {
+uint32_t pointless_hash_string_32_(uint32_t version, uint8_t* s, size_t n)
+{
+	switch (version) {
 		case POINTLESS_FF_VERSION_OFFSET_32_OLDHASH:
-			hash = pointless_hash_string_v0_32(s);
-			break;
+			return pointless_hash_string_v0_32_(s, n);
 		case POINTLESS_FF_VERSION_OFFSET_32_NEWHASH:
 		case POINTLESS_FF_VERSION_OFFSET_64_NEWHASH:
-			hash = pointless_hash_string_v1_32(s);
-			break;
-		default:
-			assert(0);
-			break;
+		case POINTLESS_FF_VERSION_OFFSET_DELTA_NEWHASH:
+			return pointless_hash_string_v1_32_(s, n);
+		case POINTLESS_FF_VERSION_OFFSET_32_MIXHASH:
+		case POINTLESS_FF_VERSION_OFFSET_64_MIXHASH:
+		case POINTLESS_FF_VERSION_OFFSET_DELTA_MIXHASH:
+			return pointless_hash_string_v2_32_(s, n);
 	}
 
-	return hash;
+	assert(0);
+	return 0;
+}
+
+typedef uint32_t (*pointless_hash_reader_32_cb)(pointless_t* p, pointless_value_t* v);
+typedef uint32_t (*pointless_hash_create_32_cb)(pointless_create_t* c, pointless_create_value_t* v);
+
+// unicode is easy
+static uint32_t pointless_hash_reader_unicode_32(pointless_t* p, pointless_value_t* v)
+{
+	return pointless_hash_unicode_ucs4_32(p->version, pointless_reader_unicode_value_ucs4(p, v));
 }
 
+static uint32_t pointless_hash_create_unicode_32(pointless_create_t* c, pointless_create_value_t* v)
+{
+	return pointless_hash_unicode_ucs4_32(c->version, (uint32_t*)cv_get_unicode(v) + 1);
+}
+
+static uint32_t pointless_hash_reader_string_32(pointless_t* p, pointless_value_t* v)
+{
+	uint8_t buffer[POINTLESS_STRING_SYMBOLS_BUFFER_LEN];
+	return pointless_hash_string_32(p->version, pointless_reader_string_value_ascii_buffer(p, v, buffer));
+}
+
+static uint32_t pointless_hash_create_string_32(pointless_create_t* c, pointless_create_value_t* v)
+{
+	return pointless_hash_string_32(c->version, cv_get_string_ascii(v));
+}
 
 // integers are easy
 uint32_t pointless_hash_i32_32(int32_t v)
@@ -262,7 +439,7 @@ static uint32_t pointless_hash_reader_bitvector_32(pointless_t* p, pointless_val
 	if (v->type == POINTLESS_BITVECTOR)
 		buffer = pointless_reader_bitvector_buffer(p, v);
 
-	return pointless_bitvector_hash_32(v->type, &v->data, buffer);
+	return pointless_bitvector_hash_32(p->version, v->type, &v->data, buffer);
 }
 
 static uint32_t pointless_hash_create_bitvector_32(pointless_create_t* c, pointless_create_value_t* v)
@@ -272,7 +449,7 @@ static uint32_t pointless_hash_create_bitvector_32(pointless_create_t* c, pointl
 	if (v->header.type_29 == POINTLESS_BITVECTOR)
 		buffer = cv_get_unicode(v);
 
-	return pointless_bitvector_hash_32(v->header.type_29, &v->data, buffer);
+	return pointless_bitvector_hash_32(c->version, v->header.type_29, &v->data, buffer);
 }
 
 // nulls and empty_slot always return 0
@@ -285,21 +462,47 @@ static uint32_t pointless_hash_reader_empty_slot_32(pointless_t* p, pointless_va
 static uint32_t pointless_hash_create_empty_slot_32(pointless_create_t* c, pointless_create_value_t* v)
 	{ return 0; }
 
-void pointless_vector_hash_init_32(pointless_vector_hash_state_32_t* state, uint32_t len)
+// vectors hash the same for all versions before the version 2 hash, for which the item hashes are the bytes hashed
+void pointless_vector_hash_init_32(pointless_vector_hash_state_32_t* state, uint32_t version, uint32_t len)
 {
+	state->version = version;
 	state->mult = 1000003;
 	state->x = 0x345678;
 	state->len = len;
+
+	if (POINTLESS_FF_VERSION_IS_MIXHASH(version))
+		pointless_hash_v2_init(&state->v2, HASH_V2_SEED_STRING);
 }
 
 void pointless_vector_hash_next_32(pointless_vector_hash_state_32_t* state, uint32_t hash)
 {
+	if (POINTLESS_FF_VERSION_IS_MIXHASH(state->version)) {
+		pointless_hash_v2_update_32(&state->v2, hash);
+		return;
+	}
+
 	state->x = (state->x ^ hash) * state->mult;
 	state->mult += (82520 + state->len + state->len);
 }
 
+void pointless_vector_hash_next_n_32(pointless_vector_hash_state_32_t* state, const uint32_t* hashes, uint32_t n)
+{
+	uint32_t i;
+
+	if (POINTLESS_FF_VERSION_IS_MIXHASH(state->version)) {
+		pointless_hash_v2_update(&state->v2, hashes, n * sizeof(uint32_t));
+		return;
+	}
+
+	for (i = 0; i < n; i++)
+		pointless_vector_hash_next_32(state, hashes[i]);
+}
+
 uint32_t pointless_vector_hash_end_32(pointless_vector_hash_state_32_t* state)
 {
+	if (POINTLESS_FF_VERSION_IS_MIXHASH(state->version))
+		return pointless_hash_v2_end(&state->v2);
+
 	state->x += 97531;
 	return state->x;
 }
@@ -308,7 +511,17 @@ static uint32_t pointless_hash_reader_vector_32_priv(pointless_t* p, pointless_v
 {
 	uint32_t h, i;
 	pointless_vector_hash_state_32_t state;
-	pointless_vector_hash_init_32(&state, n_items);
+	pointless_vector_hash_init_32(&state, p->version, n_items);
+
+	// 32-bit integers hash to themselves
+	switch (v->type) {
+		case POINTLESS_VECTOR_I32:
+			pointless_vector_hash_next_n_32(&state, (uint32_t*)pointless_reader_vector_i32(p, v) + offset, n_items);
+			return pointless_vector_hash_end_32(&state);
+		case POINTLESS_VECTOR_U32:
+			pointless_vector_hash_next_n_32(&state, pointless_reader_vector_u32(p, v) + offset, n_items);
+			return pointless_vector_hash_end_32(&state);
+	}
 
 	for (i = offset; i < n_items + offset; i++) {
 		switch (v->type) {
@@ -377,7 +590,12 @@ static uint32_t pointless_hash_create_vector_32(pointless_create_t* c, pointless
 	}
 
 	pointless_vector_hash_state_32_t state;
-	pointless_vector_hash_init_32(&state, n_items);
+	pointless_vector_hash_init_32(&state, c->version, n_items);
+
+	if (!v->header.is_compressed_vector && (v->header.type_29 == POINTLESS_VECTOR_I32 || v->header.type_29 == POINTLESS_VECTOR_U32)) {
+		pointless_vector_hash_next_n_32(&state, (uint32_t*)items, n_items);
+		return pointless_vector_hash_end_32(&state);
+	}
 
 	for (i = 0; i < n_items; i++) {
 		// if vector was value based, but is now compressed, we must typecast all values
@@ -398,11 +616,12 @@ static uint32_t pointless_hash_create_vector_32(pointless_create_t* c, pointless
 				case POINTLESS_VECTOR_FLOAT:
 					h = pointless_hash_float_32(pointless_value_get_float(vv->header.type_29, &vv->data));
 					break;
-				// value based vectors can't hold 64-bit values
-				case POINTLESS_VECTOR_U64:
+				// same truncation as for native 64-bit vectors
 				case POINTLESS_VECTOR_I64:
-					h = 0;
-					assert(0);
+					h = pointless_hash_i32_32((int32_t)pointless_create_value_get_int_bits(c, vv));
+					break;
+				case POINTLESS_VECTOR_U64:
+					h = pointless_hash_u32_32((uint32_t)pointless_create_value_get_int_bits(c, vv));
 					break;
 				default:
 					h = 0;
@@ -461,6 +680,8 @@ static pointless_hash_reader_32_cb pointless_hash_reader_func_32(uint32_t t)
 		case POINTLESS_UNICODE_:
 			return pointless_hash_reader_unicode_32;
 		case POINTLESS_STRING_:
+		case POINTLESS_STRING_INLINE:
+		case POINTLESS_STRING_SYMBOLS:
 			return pointless_hash_reader_string_32;
 		case POINTLESS_I32:
 		case POINTLESS_U32:
@@ -491,8 +712,17 @@ static pointless_hash_reader_32_cb pointless_hash_reader_func_32(uint32_t t)
 		case POINTLESS_VECTOR_FLOAT:
 		case POINTLESS_VECTOR_EMPTY:
 			return pointless_hash_reader_vector_32_;
+		// hashing of integers exceeding 32-bits is not supported
+		case POINTLESS_I64:
+		case POINTLESS_U64:
 		case POINTLESS_SET_VALUE:
 		case POINTLESS_MAP_VALUE_VALUE:
+		case POINTLESS_TABLE:
+		// encoded vectors are never set/map keys
+		case POINTLESS_VECTOR_DICTIONARY:
+		case POINTLESS_VECTOR_RUNS:
+		case POINTLESS_VECTOR_SPLIT:
+		case POINTLESS_VECTOR_BLOCKS:
 			return 0;
 		case POINTLESS_EMPTY_SLOT:
 			return pointless_hash_reader_empty_slot_32;
@@ -508,6 +738,8 @@ static pointless_hash_create_32_cb pointless_hash_create_func_32(uint32_t t)
 		case POINTLESS_UNICODE_:
 			return pointless_hash_create_unicode_32;
 		case POINTLESS_STRING_:
+		case POINTLESS_STRING_INLINE:
+		case POINTLESS_STRING_SYMBOLS:
 			return pointless_hash_create_string_32;
 		case POINTLESS_I32:
 		case POINTLESS_U32:
@@ -538,8 +770,17 @@ static pointless_hash_create_32_cb pointless_hash_create_func_32(uint32_t t)
 		case POINTLESS_VECTOR_FLOAT:
 		case POINTLESS_VECTOR_EMPTY:
 			return pointless_hash_create_vector_32;
+		// hashing of integers exceeding 32-bits is not supported
+		case POINTLESS_I64:
+		case POINTLESS_U64:
 		case POINTLESS_SET_VALUE:
 		case POINTLESS_MAP_VALUE_VALUE:
+		case POINTLESS_TABLE:
+		// encoded vectors are never set/map keys
+		case POINTLESS_VECTOR_DICTIONARY:
+		case POINTLESS_VECTOR_RUNS:
+		case POINTLESS_VECTOR_SPLIT:
+		case POINTLESS_VECTOR_BLOCKS:
 			return 0;
 		case POINTLESS_EMPTY_SLOT:
 			return pointless_hash_create_empty_slot_32;
@@ -1,13 +1,20 @@
 #include <pointless/pointless_hash_table.h>
+#include <pointless/pointless_reader.h>
 
 static uint32_t next_power_of_2(uint32_t n)
 {
-	uint32_t p = 1;
-
-	while (p < n)
-		p <<= 1;
-
-	return p;
+	// compact hash table lookups compute this on every lookup, so no loop
+	if (n <= 1)
+		return 1;
+
+	n -= 1;
+	n |= n >> 1;
+	n |= n >> 2;
+	n |= n >> 4;
+	n |= n >> 8;
+	n |= n >> 16;
+
+	return n + 1;
 }
 
 uint32_t pointless_hash_compute_n_buckets(uint32_t n_items)
@@ -20,6 +27,15 @@ uint32_t pointless_hash_compute_n_buckets(uint32_t n_items)
 	return next_power_of_2(n_items + n_items / 2);
 }
 
+static uint32_t pointless_hash_table_key_eq(pointless_t* p, pointless_value_t* value, pointless_complete_value_t* key, pointless_eq_cb cb, void* user, const char** error)
+{
+	if (cb)
+		return ((*cb)(p, key, user, error) != 0);
+
+	pointless_complete_value_t v_a = pointless_value_to_complete(value);
+	return (pointless_cmp_reader(p, &v_a, p, key, error) == 0);
+}
+
 static uint32_t pointless_hash_table_probe_priv(pointless_t* p, uint32_t value_hash, pointless_value_t* value, uint32_t n_buckets, uint32_t* hash_vector, pointless_value_t* key_vector, pointless_eq_cb cb, void* user, const char** error)
 {
 	// we use the same probing strategy as Python
@@ -41,16 +57,8 @@ static uint32_t pointless_hash_table_probe_priv(pointless_t* p, uint32_t value_h
 		// test hash
 		if (value_hash == hash_vector[bucket]) {
 			// test key equality
-			uint32_t is_equal;
-
-			if (cb) {
-				pointless_complete_value_t v_a = pointless_value_to_complete(&key_vector[bucket]);
-				is_equal = ((*cb)(p, &v_a, user, error) != 0);
-			} else {
-				pointless_complete_value_t v_a = pointless_value_to_complete(value);
-				pointless_complete_value_t v_b = pointless_value_to_complete(&key_vector[bucket]);
-				is_equal = (pointless_cmp_reader(p, &v_a, p, &v_b, error) == 0);
-			}
+			pointless_complete_value_t key = pointless_value_to_complete(&key_vector[bucket]);
+			uint32_t is_equal = pointless_hash_table_key_eq(p, value, &key, cb, user, error);
 
 			if (*error)
 				return POINTLESS_HASH_TABLE_PROBE_ERROR;
@@ -70,6 +78,62 @@ static uint32_t pointless_hash_table_probe_priv(pointless_t* p, uint32_t value_h
 	return POINTLESS_HASH_TABLE_PROBE_ERROR;
 }
 
+uint32_t pointless_hash_table_bloom_n_words(uint32_t n_keys)
+{
+	uint64_t n_blocks = ICEIL((uint64_t)n_keys * POINTLESS_BLOOM_BITS_PER_KEY, POINTLESS_BLOOM_BLOCK_WORDS * 32);
+
+	if (n_blocks == 0)
+		n_blocks = 1;
+
+	return (uint32_t)(n_blocks * POINTLESS_BLOOM_BLOCK_WORDS);
+}
+
+// the key hashes are also used for bucket selection, so we remix them before picking a block and bits
+static uint64_t pointless_hash_table_bloom_mix(uint32_t hash)
+{
+	uint64_t x = (uint64_t)hash + 0x9E3779B97F4A7C15ULL;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+	return x ^ (x >> 31);
+}
+
+static uint32_t* pointless_hash_table_bloom_block(uint32_t* bloom, uint32_t n_words, uint64_t x)
+{
+	uint64_t n_blocks = n_words / POINTLESS_BLOOM_BLOCK_WORDS;
+	return bloom + ((((x >> 32) * n_blocks) >> 32) * POINTLESS_BLOOM_BLOCK_WORDS);
+}
+
+void pointless_hash_table_bloom_add(uint32_t* bloom, uint32_t n_words, uint32_t hash)
+{
+	uint64_t x = pointless_hash_table_bloom_mix(hash);
+	uint32_t* block = pointless_hash_table_bloom_block(bloom, n_words, x);
+	uint32_t i, h = (uint32_t)x, bit;
+
+	for (i = 0; i < POINTLESS_BLOOM_N_PROBES; i++) {
+		bit = h >> 23;
+		block[bit >> 5] |= (1u << (bit & 31));
+		h *= 0x9E3779B9;
+	}
+}
+
+uint32_t pointless_hash_table_bloom_maybe_contains(uint32_t* bloom, uint32_t n_words, uint32_t hash)
+{
+	uint64_t x = pointless_hash_table_bloom_mix(hash);
+	uint32_t* block = pointless_hash_table_bloom_block(bloom, n_words, x);
+	uint32_t i, h = (uint32_t)x, bit;
+
+	for (i = 0; i < POINTLESS_BLOOM_N_PROBES; i++) {
+		bit = h >> 23;
+
+		if (!(block[bit >> 5] & (1u << (bit & 31))))
+			return 0;
+
+		h *= 0x9E3779B9;
+	}
+
+	return 1;
+}
+
 void pointless_hash_table_probe_hash_init(pointless_t* p, uint32_t value_hash, uint32_t n_buckets, pointless_hash_iter_state_t* state)
 {
 	state->perturb = value_hash;
@@ -184,3 +248,252 @@ int pointless_hash_table_populate(pointless_create_t* c, uint32_t* hash_vector,
 
 	return 1;
 }
+
+uint32_t pointless_hash_table_compact_slot_size(uint32_t n_items)
+{
+	// slots hold 1 + entry, and 0 for empty slots
+	if (n_items < UINT8_MAX)
+		return sizeof(uint8_t);
+
+	if (n_items < UINT16_MAX)
+		return sizeof(uint16_t);
+
+	return sizeof(uint32_t);
+}
+
+uint32_t pointless_hash_table_compact_n_index_words(uint32_t n_items)
+{
+	uint64_t n_bytes = (uint64_t)pointless_hash_compute_n_buckets(n_items) * pointless_hash_table_compact_slot_size(n_items);
+	return (uint32_t)ICEIL(n_bytes, sizeof(uint32_t));
+}
+
+static uint32_t pointless_hash_table_compact_get(void* index, uint32_t slot_size, uint32_t bucket)
+{
+	switch (slot_size) {
+		case sizeof(uint8_t):
+			return ((uint8_t*)index)[bucket];
+		case sizeof(uint16_t):
+			return ((uint16_t*)index)[bucket];
+	}
+
+	return ((uint32_t*)index)[bucket];
+}
+
+static void pointless_hash_table_compact_set(void* index, uint32_t slot_size, uint32_t bucket, uint32_t slot)
+{
+	switch (slot_size) {
+		case sizeof(uint8_t):
+			((uint8_t*)index)[bucket] = (uint8_t)slot;
+			break;
+		case sizeof(uint16_t):
+			((uint16_t*)index)[bucket] = (uint16_t)slot;
+			break;
+		default:
+			((uint32_t*)index)[bucket] = slot;
+			break;
+	}
+}
+
+static uint32_t pointless_hash_table_compact_probe_priv(pointless_t* p, uint32_t value_hash, pointless_value_t* value, uint32_t n_items, uint32_t* hash_vector, pointless_value_t* key_vector, pointless_eq_cb cb, void* user, const char** error)
+{
+	// same probing sequence as the regular layout, but over the index slots
+	void* index = (void*)(hash_vector + n_items);
+	uint32_t slot_size = pointless_hash_table_compact_slot_size(n_items);
+	uint32_t perturb = value_hash, i = value_hash, mask = pointless_hash_compute_n_buckets(n_items) - 1, slot, entry;
+
+	while (1) {
+		slot = pointless_hash_table_compact_get(index, slot_size, i & mask);
+
+		// we hit an empty slot
+		if (slot == 0)
+			return POINTLESS_HASH_TABLE_PROBE_MISS;
+
+		entry = slot - 1;
+
+		// test hash, then key equality, the key vector may be a primitive vector
+		if (value_hash == hash_vector[entry]) {
+			pointless_complete_value_t key = pointless_reader_vector_value_case(p, key_vector, entry);
+			uint32_t is_equal = pointless_hash_table_key_eq(p, value, &key, cb, user, error);
+
+			if (*error)
+				return POINTLESS_HASH_TABLE_PROBE_ERROR;
+
+			if (is_equal)
+				return entry;
+		}
+
+		// compute recurrence
+		i = (i << 2) + i + perturb + 1;
+		perturb >>= 5;
+	}
+
+	// will never reach here
+	assert(0);
+	*error = "internal probing error";
+	return POINTLESS_HASH_TABLE_PROBE_ERROR;
+}
+
+uint32_t pointless_hash_table_compact_probe(pointless_t* p, uint32_t value_hash, pointless_value_t* value, uint32_t n_items, uint32_t* hash_vector, pointless_value_t* key_vector, const char** error)
+{
+	return pointless_hash_table_compact_probe_priv(p, value_hash, value, n_items, hash_vector, key_vector, 0, 0, error);
+}
+
+uint32_t pointless_hash_table_compact_probe_ext(pointless_t* p, uint32_t value_hash, pointless_eq_cb cb, void* user, uint32_t n_items, uint32_t* hash_vector, pointless_value_t* key_vector, const char** error)
+{
+	return pointless_hash_table_compact_probe_priv(p, value_hash, 0, n_items, hash_vector, key_vector, cb, user, error);
+}
+
+uint32_t pointless_hash_table_compact_probe_hash(pointless_t* p, uint32_t* hash_vector, uint32_t n_items, pointless_hash_iter_state_t* state, uint32_t* entry_out)
+{
+	uint32_t slot = pointless_hash_table_compact_get((void*)(hash_vector + n_items), pointless_hash_table_compact_slot_size(n_items), state->i & state->mask);
+
+	// we're at an empty slot
+	if (slot == 0)
+		return 0;
+
+	// compute recurrence
+	state->i = (state->i << 2) + state->i + state->perturb + 1;
+	state->perturb >>= 5;
+
+	// return entry
+	*entry_out = slot - 1;
+	return 1;
+}
+
+int pointless_hash_table_compact_populate(pointless_create_t* c, uint32_t* hash_vector, uint32_t* keys_vector, uint32_t n_keys, void* index, const char** error)
+{
+	uint32_t slot_size = pointless_hash_table_compact_slot_size(n_keys);
+	uint32_t mask = pointless_hash_compute_n_buckets(n_keys) - 1;
+	uint32_t value_hash, perturb, bucket, i, j, slot;
+	int32_t cmp;
+
+	for (j = 0; j < n_keys; j++) {
+		value_hash = hash_vector[j];
+		perturb = value_hash;
+		i = value_hash;
+
+		// find an empty slot
+		while (1) {
+			bucket = i & mask;
+			slot = pointless_hash_table_compact_get(index, slot_size, bucket);
+
+			if (slot == 0) {
+				pointless_hash_table_compact_set(index, slot_size, bucket, j + 1);
+				break;
+			}
+
+			// perhaps, we have an item, which is equal to ours
+			if (hash_vector[slot - 1] == value_hash) {
+				cmp = pointless_cmp_create(c, keys_vector[slot - 1], keys_vector[j], error);
+
+				if (*error)
+					return 0;
+
+				if (cmp == 0) {
+					*error = "there are duplicate keys in the set/map";
+					return 0;
+				}
+			}
+
+			// probe on
+			i = (i << 2) + i + perturb + 1;
+			perturb >>= 5;
+		}
+	}
+
+	return 1;
+}
+
+uint32_t pointless_hash_table_dense_n_words(uint32_t n_range)
+{
+	return (uint32_t)ICEIL((uint64_t)n_range, 32);
+}
+
+uint32_t pointless_hash_table_dense_is_set(uint32_t* bits, uint32_t entry)
+{
+	return ((bits[entry / 32] >> (entry % 32)) & 1);
+}
+
+void pointless_hash_table_dense_set(uint32_t* bits, uint32_t entry)
+{
+	bits[entry / 32] |= (1u << (entry % 32));
+}
+
+pointless_complete_value_t pointless_hash_table_dense_key(int64_t min_key, uint32_t entry)
+{
+	int64_t k = min_key + (int64_t)entry;
+
+	// same types as the writer uses for 32-bit integers
+	if (k < 0)
+		return pointless_complete_value_create_as_read_i32((int32_t)k);
+
+	return pointless_complete_value_create_as_read_u32((uint32_t)k);
+}
+
+uint32_t pointless_hash_table_dense_entry(int64_t min_key, uint32_t* bits, uint32_t n_words, int64_t k)
+{
+	if (k < min_key || k - min_key >= (int64_t)n_words * 32)
+		return POINTLESS_HASH_TABLE_PROBE_MISS;
+
+	uint32_t entry = (uint32_t)(k - min_key);
+
+	if (!pointless_hash_table_dense_is_set(bits, entry))
+		return POINTLESS_HASH_TABLE_PROBE_MISS;
+
+	return entry;
+}
+
+void pointless_hash_table_dense_probe_hash_init(pointless_hash_iter_state_t* state)
+{
+	state->perturb = 0;
+	state->i = 0;
+	state->mask = 0;
+}
+
+uint32_t pointless_hash_table_dense_probe_hash(int64_t min_key, uint32_t* bits, uint32_t n_words, uint32_t value_hash, pointless_hash_iter_state_t* state, uint32_t* entry_out)
+{
+	// an integer hashes to its 32 bits, so a hash is that of a single non-negative integer, and of a negative one
+	// if the top bit is set. state->i is the number of integers tried so far
+	int64_t k[2] = {(int64_t)value_hash, (int64_t)(int32_t)value_hash};
+	uint32_t n_k = (value_hash > INT32_MAX) ? 2 : 1;
+
+	while (state->i < n_k) {
+		*entry_out = pointless_hash_table_dense_entry(min_key, bits, n_words, k[state->i++]);
+
+		if (*entry_out != POINTLESS_HASH_TABLE_PROBE_MISS)
+			return 1;
+	}
+
+	return 0;
+}
+
+static uint32_t pointless_hash_table_dense_probe_priv(pointless_t* p, uint32_t value_hash, pointless_value_t* value, pointless_eq_cb cb, void* user, int64_t min_key, uint32_t* bits, uint32_t n_words, const char** error)
+{
+	pointless_hash_iter_state_t state;
+	uint32_t entry = 0;
+
+	pointless_hash_table_dense_probe_hash_init(&state);
+
+	while (pointless_hash_table_dense_probe_hash(min_key, bits, n_words, value_hash, &state, &entry)) {
+		pointless_complete_value_t key = pointless_hash_table_dense_key(min_key, entry);
+		uint32_t is_equal = pointless_hash_table_key_eq(p, value, &key, cb, user, error);
+
+		if (*error)
+			return POINTLESS_HASH_TABLE_PROBE_ERROR;
+
+		if (is_equal)
+			return entry;
+	}
+
+	return POINTLESS_HASH_TABLE_PROBE_MISS;
+}
+
+uint32_t pointless_hash_table_dense_probe(pointless_t* p, uint32_t value_hash, pointless_value_t* value, int64_t min_key, uint32_t* bits, uint32_t n_words, const char** error)
+{
+	return pointless_hash_table_dense_probe_priv(p, value_hash, value, 0, 0, min_key, bits, n_words, error);
+}
+
+uint32_t pointless_hash_table_dense_probe_ext(pointless_t* p, uint32_t value_hash, pointless_eq_cb cb, void* user, int64_t min_key, uint32_t* bits, uint32_t n_words, const char** error)
+{
+	return pointless_hash_table_dense_probe_priv(p, value_hash, 0, cb, user, min_key, bits, n_words, error);
+}
@@ -0,0 +1,323 @@
+#include <pointless/pointless_hash_table_stats.h>
+#include <pointless/pointless_reader.h>
+#include <pointless/pointless_vector_ops.h>
+
+static const char* pointless_hash_table_stats_layout[] = {
+	"regular",
+	"compact",
+	"dense"
+};
+
+static uint64_t pointless_hash_table_stats_item_size(pointless_value_t* v)
+{
+	if (v->type == POINTLESS_VECTOR_VALUE || v->type == POINTLESS_VECTOR_VALUE_HASHABLE)
+		return sizeof(pointless_value_t);
+
+	return pointless_vector_type_item_size(v->type);
+}
+
+static void pointless_hash_table_stats_add_key(pointless_hash_table_stats_t* stats, uint32_t probe_len, uint32_t is_collision)
+{
+	stats->n_probes += probe_len;
+	stats->n_collisions += is_collision;
+
+	if (probe_len > stats->max_probe_len)
+		stats->max_probe_len = probe_len;
+}
+
+static void pointless_hash_table_stats_sum(pointless_hash_table_stats_t* total, pointless_hash_table_stats_t* stats)
+{
+	total->n_tables += stats->n_tables;
+	total->n_items += stats->n_items;
+	total->n_buckets += stats->n_buckets;
+	total->n_probes += stats->n_probes;
+	total->n_collisions += stats->n_collisions;
+	total->n_empty_bytes += stats->n_empty_bytes;
+
+	if (stats->max_probe_len > total->max_probe_len)
+		total->max_probe_len = stats->max_probe_len;
+}
+
+// each key is probed for from its hash, until the probe reaches its bucket, as a lookup would
+static int pointless_hash_table_stats_regular(pointless_t* p, uint32_t n_buckets, uint32_t* hashes, pointless_value_t* keys, pointless_hash_table_stats_t* stats, const char** error)
+{
+	pointless_hash_iter_state_t state;
+	uint32_t bucket, visited, probe_len, is_collision;
+
+	for (bucket = 0; bucket < n_buckets; bucket++) {
+		if (keys[bucket].type == POINTLESS_EMPTY_SLOT)
+			continue;
+
+		pointless_hash_table_probe_hash_init(p, hashes[bucket], n_buckets, &state);
+		probe_len = 0;
+		is_collision = 0;
+
+		while (1) {
+			if (!pointless_hash_table_probe_hash(p, hashes, keys, &state, &visited)) {
+				*error = "key in hash table is not on its probe sequence";
+				return 0;
+			}
+
+			probe_len += 1;
+
+			if (visited == bucket)
+				break;
+
+			if (hashes[visited] == hashes[bucket])
+				is_collision = 1;
+		}
+
+		pointless_hash_table_stats_add_key(stats, probe_len, is_collision);
+	}
+
+	return 1;
+}
+
+// same, over the index slots, which hold entries
+static int pointless_hash_table_stats_compact(pointless_t* p, uint32_t n_items, uint32_t* hashes, pointless_hash_table_stats_t* stats, const char** error)
+{
+	pointless_hash_iter_state_t state;
+	uint32_t n_buckets = pointless_hash_compute_n_buckets(n_items);
+	uint32_t entry, visited, probe_len, is_collision;
+
+	for (entry = 0; entry < n_items; entry++) {
+		pointless_hash_table_probe_hash_init(p, hashes[entry], n_buckets, &state);
+		probe_len = 0;
+		is_collision = 0;
+
+		while (1) {
+			if (!pointless_hash_table_compact_probe_hash(p, hashes, n_items, &state, &visited)) {
+				*error = "key in compact hash table is not on its probe sequence";
+				return 0;
+			}
+
+			probe_len += 1;
+
+			if (visited == entry)
+				break;
+
+			if (hashes[visited] == hashes[entry])
+				is_collision = 1;
+		}
+
+		pointless_hash_table_stats_add_key(stats, probe_len, is_collision);
+	}
+
+	return 1;
+}
+
+int pointless_hash_table_stats(pointless_t* p, pointless_value_t* v, pointless_hash_table_stats_t* stats, const char** error)
+{
+	pointless_value_t* hash_vector = 0;
+	pointless_value_t* key_vector = 0;
+	pointless_value_t* value_vector = 0;
+	uint32_t is_compact = 0, is_dense = 0;
+
+	memset(stats, 0, sizeof(*stats));
+	stats->n_tables = 1;
+
+	switch (v->type) {
+		case POINTLESS_SET_VALUE:
+			hash_vector = pointless_set_hash_vector(p, v);
+			key_vector = pointless_set_key_vector(p, v);
+			is_compact = pointless_reader_set_is_compact(p, v);
+			stats->n_items = pointless_reader_set_n_items(p, v);
+			stats->n_buckets = pointless_reader_set_n_buckets(p, v);
+			break;
+		case POINTLESS_MAP_VALUE_VALUE:
+			hash_vector = pointless_map_hash_vector(p, v);
+			key_vector = pointless_map_key_vector(p, v);
+			value_vector = pointless_map_value_vector(p, v);
+			is_compact = pointless_reader_map_is_compact(p, v);
+			is_dense = pointless_reader_map_is_dense(p, v);
+			stats->n_items = pointless_reader_map_n_items(p, v);
+			stats->n_buckets = pointless_reader_map_n_buckets(p, v);
+			break;
+		default:
+			*error = "value is not a set or a map";
+			return 0;
+	}
+
+	uint64_t n_empty = stats->n_buckets - stats->n_items;
+
+	// integer keys are their own entries, and absent ones still have a value
+	if (is_dense) {
+		stats->layout = POINTLESS_HASH_TABLE_LAYOUT_DENSE;
+		stats->n_probes = stats->n_items;
+		stats->max_probe_len = (stats->n_items > 0);
+		stats->n_empty_bytes = n_empty * pointless_hash_table_stats_item_size(value_vector);
+		return 1;
+	}
+
+	// the index follows the hashes, and every slot not holding an entry is empty, including the padding of its
+	// last word
+	if (is_compact) {
+		uint32_t n_items = (uint32_t)stats->n_items;
+		uint64_t n_index_bytes = (uint64_t)(pointless_reader_vector_n_items(p, hash_vector) - n_items) * sizeof(uint32_t);
+
+		stats->layout = POINTLESS_HASH_TABLE_LAYOUT_COMPACT;
+		stats->n_empty_bytes = n_index_bytes - (uint64_t)n_items * pointless_hash_table_compact_slot_size(n_items);
+
+		if (n_items == 0)
+			return 1;
+
+		return pointless_hash_table_stats_compact(p, n_items, pointless_reader_vector_u32(p, hash_vector), stats, error);
+	}
+
+	// a hash, a key and a value for every bucket
+	uint64_t bucket_size = sizeof(uint32_t) + pointless_hash_table_stats_item_size(key_vector);
+
+	if (value_vector)
+		bucket_size += pointless_hash_table_stats_item_size(value_vector);
+
+	stats->layout = POINTLESS_HASH_TABLE_LAYOUT_REGULAR;
+	stats->n_empty_bytes = n_empty * bucket_size;
+
+	if (stats->n_items == 0)
+		return 1;
+
+	return pointless_hash_table_stats_regular(p, (uint32_t)stats->n_buckets, pointless_reader_vector_u32(p, hash_vector), pointless_reader_vector_value(p, key_vector), stats, error);
+}
+
+// empty bytes of a map in its hash and key vectors, which maps sharing a schema share
+static uint64_t pointless_hash_table_stats_schema_empty_bytes(pointless_t* p, pointless_value_t* m, pointless_hash_table_stats_t* stats)
+{
+	switch (stats->layout) {
+		case POINTLESS_HASH_TABLE_LAYOUT_REGULAR:
+			return (stats->n_buckets - stats->n_items) * (sizeof(uint32_t) + pointless_hash_table_stats_item_size(pointless_map_key_vector(p, m)));
+		case POINTLESS_HASH_TABLE_LAYOUT_COMPACT:
+			return stats->n_empty_bytes;
+	}
+
+	return 0;
+}
+
+// whether the hash vector of a map has been seen before, marking it in 'is_schema', a bit per vector
+static int pointless_hash_table_stats_is_shared(pointless_t* p, pointless_value_t* m, uint32_t* is_schema)
+{
+	pointless_value_t* hash_vector = pointless_map_hash_vector(p, m);
+
+	if (hash_vector->type == POINTLESS_VECTOR_EMPTY)
+		return 0;
+
+	uint32_t* word = &is_schema[hash_vector->data.data_u32 / 32];
+	uint32_t bit = (1u << (hash_vector->data.data_u32 % 32));
+	int is_shared = ((*word & bit) != 0);
+
+	*word |= bit;
+	return is_shared;
+}
+
+// sets 'is_stopped' if 'cb' stops the walk, 'is_schema' is 0 for sets, and if not summing
+static int pointless_hash_table_stats_all_type(pointless_t* p, uint32_t type, uint32_t n, pointless_hash_table_stats_cb cb, void* user, pointless_hash_table_stats_t* total, uint32_t* is_schema, int* is_stopped, const char** error)
+{
+	pointless_hash_table_stats_t stats, summed;
+	pointless_value_t v;
+	uint32_t i;
+
+	v.type = type;
+
+	for (i = 0; i < n; i++) {
+		v.data.data_u32 = i;
+
+		if (!pointless_hash_table_stats(p, &v, &stats, error))
+			return 0;
+
+		if (total) {
+			summed = stats;
+
+			// the hash and key vectors of a shared schema count once
+			if (is_schema && pointless_hash_table_stats_is_shared(p, &v, is_schema))
+				summed.n_empty_bytes -= pointless_hash_table_stats_schema_empty_bytes(p, &v, &stats);
+
+			pointless_hash_table_stats_sum(total, &summed);
+		}
+
+		if (cb && !(*cb)(p, &v, &stats, user)) {
+			*is_stopped = 1;
+			return 1;
+		}
+	}
+
+	return 1;
+}
+
+int pointless_hash_table_stats_all(pointless_t* p, pointless_hash_table_stats_cb cb, void* user, pointless_hash_table_stats_t* sets, pointless_hash_table_stats_t* maps, const char** error)
+{
+	uint32_t* is_schema = 0;
+	int is_stopped = 0;
+	int retval = 0;
+
+	if (sets)
+		memset(sets, 0, sizeof(*sets));
+
+	if (maps)
+		memset(maps, 0, sizeof(*maps));
+
+	if (!pointless_hash_table_stats_all_type(p, POINTLESS_SET_VALUE, p->header->n_set, cb, user, sets, 0, &is_stopped, error))
+		return 0;
+
+	if (is_stopped)
+		return 1;
+
+	// 1 item is allocated for the file without vectors, so that 0 means out of memory
+	if (maps) {
+		is_schema = (uint32_t*)pointless_calloc(ICEIL(p->header->n_vector, 32) + 1, sizeof(uint32_t));
+
+		if (is_schema == 0) {
+			*error = "out of memory";
+			return 0;
+		}
+	}
+
+	retval = pointless_hash_table_stats_all_type(p, POINTLESS_MAP_VALUE_VALUE, p->header->n_map, cb, user, maps, is_schema, &is_stopped, error);
+	pointless_free(is_schema);
+
+	return retval;
+}
+
+static void pointless_hash_table_stats_print_line(FILE* out, pointless_hash_table_stats_t* stats)
+{
+	double load = (stats->n_buckets > 0) ? (double)stats->n_items / (double)stats->n_buckets : 0.0;
+	double avg_probe_len = (stats->n_items > 0) ? (double)stats->n_probes / (double)stats->n_items : 0.0;
+
+	fprintf(out, "%llu items, %llu buckets, load %.2f, probe length avg %.2f max %u, %llu collisions, %llu empty bytes\n",
+		(unsigned long long)stats->n_items,
+		(unsigned long long)stats->n_buckets,
+		load,
+		avg_probe_len,
+		stats->max_probe_len,
+		(unsigned long long)stats->n_collisions,
+		(unsigned long long)stats->n_empty_bytes
+	);
+}
+
+static int pointless_hash_table_stats_print_cb(pointless_t* p, pointless_value_t* v, pointless_hash_table_stats_t* stats, void* user)
+{
+	FILE* out = (FILE*)user;
+
+	fprintf(out, "%s %u (container %u): %s, ", (v->type == POINTLESS_SET_VALUE) ? "set" : "map", v->data.data_u32, pointless_container_id(p, v), pointless_hash_table_stats_layout[stats->layout]);
+	pointless_hash_table_stats_print_line(out, stats);
+	return 1;
+}
+
+int pointless_hash_table_stats_print(pointless_t* p, FILE* out, const char** error)
+{
+	pointless_hash_table_stats_t sets, maps, total;
+
+	if (!pointless_hash_table_stats_all(p, pointless_hash_table_stats_print_cb, (void*)out, &sets, &maps, error))
+		return 0;
+
+	memset(&total, 0, sizeof(total));
+	pointless_hash_table_stats_sum(&total, &sets);
+	pointless_hash_table_stats_sum(&total, &maps);
+
+	fprintf(out, "sets: %u tables, ", sets.n_tables);
+	pointless_hash_table_stats_print_line(out, &sets);
+	fprintf(out, "maps: %u tables, ", maps.n_tables);
+	pointless_hash_table_stats_print_line(out, &maps);
+	fprintf(out, "total: %u tables, ", total.n_tables);
+	pointless_hash_table_stats_print_line(out, &total);
+
+	return 1;
+}
@@ -9,6 +9,11 @@
 		{ return je_calloc(nmemb, size); }
 	void* pointless_malloc(size_t size)
 		{ return je_malloc(size); }
+	void* pointless_malloc_aligned(size_t alignment, size_t size)
+	{
+		void* ptr = 0;
+		return (je_posix_memalign(&ptr, alignment, size) == 0) ? ptr : 0;
+	}
 	void pointless_free(void* ptr)
 		{ je_free(ptr); }
 	void* pointless_realloc(void* ptr, size_t size)
@@ -29,6 +34,11 @@
 		{ return calloc(nmemb, size); }
 	void* pointless_malloc(size_t size)
 		{ return malloc(size); }
+	void* pointless_malloc_aligned(size_t alignment, size_t size)
+	{
+		void* ptr = 0;
+		return (posix_memalign(&ptr, alignment, size) == 0) ? ptr : 0;
+	}
 	void pointless_free(void* ptr)
 		{ free(ptr); }
 	void* pointless_realloc(void* ptr, size_t size)
@@ -0,0 +1,224 @@
+#include <pointless/pointless_prepared_key.h>
+
+static void pointless_prepared_key_init(pointless_prepared_key_t* k, uint32_t type)
+{
+	k->type = type;
+	k->hash_valid = 0;
+}
+
+void pointless_prepared_key_init_string(pointless_prepared_key_t* k, uint8_t* s)
+{
+	pointless_prepared_key_init(k, POINTLESS_PREPARED_KEY_STRING);
+	k->data.string_8 = s;
+}
+
+void pointless_prepared_key_init_unicode_ucs2(pointless_prepared_key_t* k, uint16_t* s)
+{
+	pointless_prepared_key_init(k, POINTLESS_PREPARED_KEY_UNICODE_UCS2);
+	k->data.string_16 = s;
+}
+
+void pointless_prepared_key_init_unicode_ucs4(pointless_prepared_key_t* k, uint32_t* s)
+{
+	pointless_prepared_key_init(k, POINTLESS_PREPARED_KEY_UNICODE_UCS4);
+	k->data.string_32 = s;
+}
+
+int pointless_prepared_key_init_int(pointless_prepared_key_t* k, int64_t i)
+{
+	if (!(INT32_MIN <= i && i <= UINT32_MAX))
+		return 0;
+
+	pointless_prepared_key_init(k, POINTLESS_PREPARED_KEY_INT);
+	k->data.i = i;
+	return 1;
+}
+
+static uint32_t pointless_prepared_key_hash_priv(uint32_t version, pointless_prepared_key_t* k)
+{
+	// integer hashes are the same for all versions
+	if (k->type == POINTLESS_PREPARED_KEY_INT) {
+		if (k->data.i < 0)
+			return pointless_hash_i32_32((int32_t)k->data.i);
+
+		return pointless_hash_u32_32((uint32_t)k->data.i);
+	}
+
+	switch (k->type) {
+		case POINTLESS_PREPARED_KEY_STRING:
+			return pointless_hash_string_32(version, k->data.string_8);
+		case POINTLESS_PREPARED_KEY_UNICODE_UCS2:
+			return pointless_hash_unicode_ucs2_32(version, k->data.string_16);
+		case POINTLESS_PREPARED_KEY_UNICODE_UCS4:
+			return pointless_hash_unicode_ucs4_32(version, k->data.string_32);
+	}
+
+	assert(0);
+	return 0;
+}
+
+uint32_t pointless_prepared_key_hash(pointless_t* p, pointless_prepared_key_t* k)
+{
+	uint32_t version = p->version;
+
+	assert(version <= POINTLESS_FILE_FORMAT_LATEST_VERSION_);
+
+	if (!(k->hash_valid & (1 << version))) {
+		k->hash[version] = pointless_prepared_key_hash_priv(version, k);
+		k->hash_valid |= (1 << version);
+	}
+
+	return k->hash[version];
+}
+
+uint32_t pointless_prepared_key_eq(pointless_t* p, pointless_value_t* v, pointless_prepared_key_t* k)
+{
+	uint8_t buffer[POINTLESS_STRING_SYMBOLS_BUFFER_LEN];
+
+	switch (k->type) {
+		case POINTLESS_PREPARED_KEY_STRING:
+			if (pointless_is_string_8_type(v->type))
+				return (pointless_cmp_string_8_8(pointless_reader_string_value_ascii_buffer(p, v, buffer), k->data.string_8) == 0);
+			if (v->type == POINTLESS_UNICODE_)
+				return (pointless_cmp_string_32_8(pointless_reader_unicode_value_ucs4(p, v), k->data.string_8) == 0);
+			return 0;
+		case POINTLESS_PREPARED_KEY_UNICODE_UCS2:
+			if (pointless_is_string_8_type(v->type))
+				return (pointless_cmp_string_8_16(pointless_reader_string_value_ascii_buffer(p, v, buffer), k->data.string_16) == 0);
+			if (v->type == POINTLESS_UNICODE_)
+				return (pointless_cmp_string_32_16(pointless_reader_unicode_value_ucs4(p, v), k->data.string_16) == 0);
+			return 0;
+		case POINTLESS_PREPARED_KEY_UNICODE_UCS4:
+			if (pointless_is_string_8_type(v->type))
+				return (pointless_cmp_string_8_32(pointless_reader_string_value_ascii_buffer(p, v, buffer), k->data.string_32) == 0);
+			if (v->type == POINTLESS_UNICODE_)
+				return (pointless_cmp_string_32_32(pointless_reader_unicode_value_ucs4(p, v), k->data.string_32) == 0);
+			return 0;
+		case POINTLESS_PREPARED_KEY_INT:
+			switch (v->type) {
+				case POINTLESS_I32:
+					return (k->data.i == (int64_t)v->data.data_i32);
+				case POINTLESS_U32:
+				case POINTLESS_BOOLEAN:
+					return (k->data.i == (int64_t)v->data.data_u32);
+				case POINTLESS_FLOAT:
+				{
+					// same rules as any other numeric comparison
+					pointless_complete_value_t v_a = pointless_complete_value_create_as_read_i64(k->data.i);
+					pointless_complete_value_t v_b = pointless_value_to_complete(v);
+					return (pointless_cmp_reader_acyclic(0, &v_a, p, &v_b) == 0);
+				}
+			}
+			return 0;
+	}
+
+	assert(0);
+	return 0;
+}
+
+uint32_t pointless_prepared_key_eq_cb(pointless_t* p, pointless_complete_value_t* v, void* user, const char** error)
+{
+	pointless_value_t v_ = pointless_value_from_complete(v);
+	return pointless_prepared_key_eq(p, &v_, (pointless_prepared_key_t*)user);
+}
+
+// on-disk key of a compact set/map entry, the key vector may be a primitive vector
+static pointless_value_t pointless_prepared_key_compact_key(pointless_t* p, pointless_value_t* key_vector, uint32_t entry)
+{
+	if (key_vector->type == POINTLESS_VECTOR_VALUE_HASHABLE)
+		return pointless_reader_vector_value(p, key_vector)[entry];
+
+	pointless_complete_value_t v = pointless_reader_vector_value_case(p, key_vector, entry);
+	return pointless_value_from_complete(&v);
+}
+
+static uint32_t pointless_prepared_key_probe(pointless_t* p, pointless_value_t* hash_vector, pointless_value_t* key_vector, uint32_t is_compact, pointless_prepared_key_t* k)
+{
+	uint32_t hash = pointless_prepared_key_hash(p, k);
+	uint32_t* hashes = pointless_reader_vector_u32(p, hash_vector);
+	uint32_t n_keys = pointless_reader_vector_n_items(p, key_vector);
+	uint32_t bucket = 0;
+
+	pointless_hash_iter_state_t state;
+
+	if (is_compact) {
+		pointless_hash_table_probe_hash_init(p, hash, pointless_hash_compute_n_buckets(n_keys), &state);
+
+		while (pointless_hash_table_compact_probe_hash(p, hashes, n_keys, &state, &bucket)) {
+			if (hashes[bucket] == hash) {
+				pointless_value_t key = pointless_prepared_key_compact_key(p, key_vector, bucket);
+
+				if (pointless_prepared_key_eq(p, &key, k))
+					return bucket;
+			}
+		}
+
+		return POINTLESS_HASH_TABLE_PROBE_MISS;
+	}
+
+	pointless_value_t* keys = pointless_reader_vector_value(p, key_vector);
+	pointless_hash_table_probe_hash_init(p, hash, n_keys, &state);
+
+	while (pointless_hash_table_probe_hash(p, hashes, keys, &state, &bucket)) {
+		if (hashes[bucket] == hash && pointless_prepared_key_eq(p, &keys[bucket], k))
+			return bucket;
+	}
+
+	return POINTLESS_HASH_TABLE_PROBE_MISS;
+}
+
+uint32_t pointless_reader_set_probe_prepared(pointless_t* p, pointless_value_t* s, pointless_prepared_key_t* k)
+{
+	if (!pointless_reader_set_maybe_contains_hash(p, s, pointless_prepared_key_hash(p, k)))
+		return POINTLESS_HASH_TABLE_PROBE_MISS;
+
+	return pointless_prepared_key_probe(p, pointless_set_hash_vector(p, s), pointless_set_key_vector(p, s), pointless_reader_set_is_compact(p, s), k);
+}
+
+uint32_t pointless_reader_map_probe_prepared(pointless_t* p, pointless_value_t* m, pointless_prepared_key_t* k)
+{
+	// dense maps only hold integers, and need no hash
+	if (pointless_reader_map_is_dense(p, m)) {
+		if (k->type != POINTLESS_PREPARED_KEY_INT)
+			return POINTLESS_HASH_TABLE_PROBE_MISS;
+
+		return pointless_reader_map_dense_entry(p, m, k->data.i);
+	}
+
+	if (!pointless_reader_map_maybe_contains_hash(p, m, pointless_prepared_key_hash(p, k)))
+		return POINTLESS_HASH_TABLE_PROBE_MISS;
+
+	return pointless_prepared_key_probe(p, pointless_map_hash_vector(p, m), pointless_map_key_vector(p, m), pointless_reader_map_is_compact(p, m), k);
+}
+
+void pointless_reader_set_lookup_prepared(pointless_t* p, pointless_value_t* s, pointless_prepared_key_t* k, pointless_value_t** kk)
+{
+	uint32_t entry = pointless_reader_set_probe_prepared(p, s, k);
+
+	if (entry == POINTLESS_HASH_TABLE_PROBE_MISS) {
+		*kk = 0;
+		return;
+	}
+
+	pointless_value_t* key_vector = pointless_set_key_vector(p, s);
+	assert(key_vector->type == POINTLESS_VECTOR_VALUE_HASHABLE);
+	*kk = &pointless_reader_vector_value(p, key_vector)[entry];
+}
+
+void pointless_reader_map_lookup_prepared(pointless_t* p, pointless_value_t* m, pointless_prepared_key_t* k, pointless_value_t** kk, pointless_value_t** vv)
+{
+	uint32_t entry = pointless_reader_map_probe_prepared(p, m, k);
+
+	if (entry == POINTLESS_HASH_TABLE_PROBE_MISS) {
+		*kk = 0;
+		*vv = 0;
+		return;
+	}
+
+	pointless_value_t* key_vector = pointless_map_key_vector(p, m);
+	pointless_value_t* value_vector = pointless_map_value_vector(p, m);
+	assert(key_vector->type == POINTLESS_VECTOR_VALUE_HASHABLE);
+	assert(value_vector->type == POINTLESS_VECTOR_VALUE || value_vector->type == POINTLESS_VECTOR_VALUE_HASHABLE);
+	*kk = &pointless_reader_vector_value(p, key_vector)[entry];
+	*vv = &pointless_reader_vector_value(p, value_vector)[entry];
+}
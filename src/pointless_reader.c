@@ -1,5 +1,26 @@
 #include <pointless/pointless_reader.h>
 
+static void pointless_reader_init_core(pointless_t* p);
+
+uint64_t pointless_offset_vector_size(pointless_t* p, uint64_t n)
+{
+	if (p->is_32_offset)
+		return n * sizeof(uint32_t);
+
+	if (p->is_64_offset)
+		return n * sizeof(uint64_t);
+
+	uint64_t n_blocks = ICEIL(n, POINTLESS_OFFSET_DELTA_BLOCK_SIZE);
+	return n_blocks * sizeof(uint64_t) + ICEIL(n * sizeof(uint16_t), 8) * 8;
+}
+
+static char* pointless_init_delta_offsets(pointless_t* p, char* offsets, uint32_t n, uint64_t** base, uint16_t** delta)
+{
+	*base = (uint64_t*)offsets;
+	*delta = (uint16_t*)(*base + ICEIL(n, POINTLESS_OFFSET_DELTA_BLOCK_SIZE));
+	return offsets + pointless_offset_vector_size(p, n);
+}
+
 static int pointless_init(pointless_t* p, void* buf, uint64_t buflen, int force_ucs2, const char** error)
 {
 	// our header
@@ -13,27 +34,47 @@ static int pointless_init(pointless_t* p, void* buf, uint64_t buflen, int force_
 	// check for version
 	p->is_32_offset = 0;
 	p->is_64_offset = 0;
+	p->is_delta_offset = 0;
+	p->version = POINTLESS_FF_VERSION(p->header->version);
 
-	switch (p->header->version) {
+	switch (p->version) {
 		case POINTLESS_FF_VERSION_OFFSET_32_OLDHASH:
 		case POINTLESS_FF_VERSION_OFFSET_32_NEWHASH:
+		case POINTLESS_FF_VERSION_OFFSET_32_MIXHASH:
 			p->is_32_offset = 1;
 			break;
 		case POINTLESS_FF_VERSION_OFFSET_64_NEWHASH:
+		case POINTLESS_FF_VERSION_OFFSET_64_MIXHASH:
 			p->is_64_offset = 1;
 			break;
+		case POINTLESS_FF_VERSION_OFFSET_DELTA_NEWHASH:
+		case POINTLESS_FF_VERSION_OFFSET_DELTA_MIXHASH:
+			p->is_delta_offset = 1;
+			break;
 		default:
 			*error = "file version not supported";
 			return 0;
 	}
 
+	// alignments are powers of two, of at least 4 bytes
+	uint32_t vector_alignment_log2 = (p->header->version >> 16) & 0xFF;
+	uint32_t large_vector_alignment_log2 = (p->header->version >> 24) & 0xFF;
+
+	if (vector_alignment_log2 == 1 || vector_alignment_log2 > POINTLESS_FF_ALIGNMENT_MAX_LOG2 || large_vector_alignment_log2 == 1 || large_vector_alignment_log2 > POINTLESS_FF_ALIGNMENT_MAX_LOG2) {
+		*error = "file vector alignment not supported";
+		return 0;
+	}
+
+	p->vector_alignment = POINTLESS_FF_VECTOR_ALIGNMENT(p->header->version);
+	p->large_vector_alignment = POINTLESS_FF_LARGE_VECTOR_ALIGNMENT(p->header->version);
+
 	// right, we need some number of bytes for the offset vectors
 	uint64_t mandatory_size = sizeof(pointless_header_t);
-	mandatory_size += p->header->n_string_unicode * sizeof(uint32_t);
-	mandatory_size += p->header->n_vector * sizeof(uint32_t);
-	mandatory_size += p->header->n_bitvector * sizeof(uint32_t);
-	mandatory_size += p->header->n_set * sizeof(uint32_t);
-	mandatory_size += p->header->n_map * sizeof(uint32_t);
+	mandatory_size += pointless_offset_vector_size(p, p->header->n_string_unicode);
+	mandatory_size += pointless_offset_vector_size(p, p->header->n_vector);
+	mandatory_size += pointless_offset_vector_size(p, p->header->n_bitvector);
+	mandatory_size += pointless_offset_vector_size(p, p->header->n_set);
+	mandatory_size += pointless_offset_vector_size(p, p->header->n_map);
 
 	if (buflen < mandatory_size) {
 		*error = "file is too small to hold offset vectors";
@@ -53,14 +94,45 @@ static int pointless_init(pointless_t* p, void* buf, uint64_t buflen, int force_
 	p->set_offsets_64              = (uint64_t*)(p->bitvector_offsets_64        + p->header->n_bitvector);
 	p->map_offsets_64              = (uint64_t*)(p->set_offsets_64              + p->header->n_set);
 
-	// our heap
-	p->heap_len = (buflen - mandatory_size);
-	p->heap_ptr = 0;
+	p->string_unicode_offsets_base = 0;
+	p->vector_offsets_base         = 0;
+	p->bitvector_offsets_base      = 0;
+	p->set_offsets_base            = 0;
+	p->map_offsets_base            = 0;
+
+	p->string_unicode_offsets_delta = 0;
+	p->vector_offsets_delta         = 0;
+	p->bitvector_offsets_delta      = 0;
+	p->set_offsets_delta            = 0;
+	p->map_offsets_delta            = 0;
+
+	if (p->is_delta_offset) {
+		char* offsets = (char*)(p->header + 1);
+		offsets = pointless_init_delta_offsets(p, offsets, p->header->n_string_unicode, &p->string_unicode_offsets_base, &p->string_unicode_offsets_delta);
+		offsets = pointless_init_delta_offsets(p, offsets, p->header->n_vector, &p->vector_offsets_base, &p->vector_offsets_delta);
+		offsets = pointless_init_delta_offsets(p, offsets, p->header->n_bitvector, &p->bitvector_offsets_base, &p->bitvector_offsets_delta);
+		offsets = pointless_init_delta_offsets(p, offsets, p->header->n_set, &p->set_offsets_base, &p->set_offsets_delta);
+		offsets = pointless_init_delta_offsets(p, offsets, p->header->n_map, &p->map_offsets_base, &p->map_offsets_delta);
+	}
 
-	if (p->is_32_offset)
-		p->heap_ptr = (void*)(p->map_offsets_32 + p->header->n_map);
-	else
-		p->heap_ptr = (void*)(p->map_offsets_64 + p->header->n_map);
+	// our heap, padded to the larger alignment
+	uint64_t heap_alignment = (p->vector_alignment > p->large_vector_alignment) ? p->vector_alignment : p->large_vector_alignment;
+	uint64_t heap_start = ICEIL(mandatory_size, heap_alignment) * heap_alignment;
+
+	if (buflen < heap_start) {
+		*error = "file is too small to hold heap alignment";
+		return 0;
+	}
+
+	p->heap_len = (buflen - heap_start);
+	p->heap_ptr = (void*)((char*)buf + heap_start);
+
+	// the offset encoding is fixed from here on
+	pointless_reader_init_core(p);
+
+	// compressed strings are validated against the symbol table
+	if (!pointless_string_symbols_init(p, error))
+		return 0;
 
 	// let us validate the damn thing
 	pointless_validate_context_t context;
@@ -71,6 +143,10 @@ static int pointless_init(pointless_t* p, void* buf, uint64_t buflen, int force_
 
 int pointless_open_f(pointless_t* p, const char* fname, int force_ucs2, const char** error)
 {
+	p->trace = 0;
+	p->prefetch = 0;
+	p->string_symbols = 0;
+
 	p->fd = 0;
 	p->fd_len = 0;
 	p->fd_ptr = 0;
@@ -138,6 +214,11 @@ int pointless_open_f(pointless_t* p, const char* fname, int force_ucs2, const ch
 
 void pointless_close(pointless_t* p)
 {
+	// the prefetch thread reads the mapping
+	pointless_prefetch_stop(p);
+	pointless_trace_end(p);
+	pointless_string_symbols_end(p);
+
 	if (p->fd_ptr)
 		munmap(p->fd_ptr, p->fd_len);
 
@@ -149,11 +230,31 @@ void pointless_close(pointless_t* p)
 
 int pointless_open_b(pointless_t* p, const void* buffer, size_t n_buffer, int force_ucs2, const char** error)
 {
+	p->trace = 0;
+	p->prefetch = 0;
+	p->string_symbols = 0;
+
 	p->fd = 0;
 	p->fd_len = 0;
 	p->fd_ptr = 0;
 
-	p->buf = pointless_malloc(n_buffer);
+	// the copy is aligned as the vectors of the file, which are aligned relative to its start
+	size_t alignment = sizeof(void*);
+
+	if (n_buffer >= sizeof(pointless_header_t)) {
+		pointless_header_t header;
+		memcpy(&header, buffer, sizeof(header));
+
+		uint32_t vector_alignment_log2 = (header.version >> 16) & 0xFF;
+		uint32_t large_vector_alignment_log2 = (header.version >> 24) & 0xFF;
+
+		if (vector_alignment_log2 <= POINTLESS_FF_ALIGNMENT_MAX_LOG2 && large_vector_alignment_log2 <= POINTLESS_FF_ALIGNMENT_MAX_LOG2) {
+			alignment = SIMPLE_MAX(alignment, (size_t)POINTLESS_FF_VECTOR_ALIGNMENT(header.version));
+			alignment = SIMPLE_MAX(alignment, (size_t)POINTLESS_FF_LARGE_VECTOR_ALIGNMENT(header.version));
+		}
+	}
+
+	p->buf = pointless_malloc_aligned(alignment, n_buffer);
 	p->buflen = n_buffer;
 
 	if (p->buf == 0) {
@@ -179,6 +280,7 @@ pointless_value_t* pointless_root(pointless_t* p)
 uint32_t pointless_reader_unicode_len(pointless_t* p, pointless_value_t* v)
 {
 	assert(v->data.data_u32 < p->header->n_string_unicode);
+	PC_TRACE(p, v);
 	uint32_t* u_len = (uint32_t*)PC_HEAP_OFFSET(p, string_unicode_offsets, v->data.data_u32);
 	return *u_len;
 }
@@ -186,6 +288,7 @@ uint32_t pointless_reader_unicode_len(pointless_t* p, pointless_value_t* v)
 static pointless_unicode_char_t* pointless_reader_unicode_value(pointless_t* p, pointless_value_t* v)
 {
 	assert(v->data.data_u32 < p->header->n_string_unicode);
+	PC_TRACE(p, v);
 	uint32_t* u_len = (uint32_t*)PC_HEAP_OFFSET(p, string_unicode_offsets, v->data.data_u32);
 	return (pointless_unicode_char_t*)(u_len + 1);
 }
@@ -215,24 +318,219 @@ uint16_t* pointless_reader_unicode_value_ucs2_alloc(pointless_t* p, pointless_va
 
 uint32_t pointless_reader_string_len(pointless_t* p, pointless_value_t* v)
 {
+	if (v->type == POINTLESS_STRING_INLINE)
+		return pointless_ascii_len((uint8_t*)&v->data);
+
 	assert(v->data.data_u32 < p->header->n_string_unicode);
+	PC_TRACE(p, v);
 	uint32_t* u_len = (uint32_t*)PC_HEAP_OFFSET(p, string_unicode_offsets, v->data.data_u32);
+
+	if (v->type == POINTLESS_STRING_SYMBOLS)
+		return POINTLESS_STRING_SYMBOLS_LEN(*u_len);
+
 	return *u_len;
 }
 
 uint8_t* pointless_reader_string_value_ascii(pointless_t* p, pointless_value_t* v)
 {
+	if (v->type == POINTLESS_STRING_INLINE)
+		return (uint8_t*)&v->data;
+
+	assert(v->type == POINTLESS_STRING_);
 	assert(v->data.data_u32 < p->header->n_string_unicode);
+	PC_TRACE(p, v);
 	uint32_t* u_len = (uint32_t*)PC_HEAP_OFFSET(p, string_unicode_offsets, v->data.data_u32);
 	return (uint8_t*)(u_len + 1);
 }
 
+uint8_t* pointless_reader_string_value_ascii_buffer(pointless_t* p, pointless_value_t* v, uint8_t* buffer)
+{
+	if (v->type != POINTLESS_STRING_SYMBOLS)
+		return pointless_reader_string_value_ascii(p, v);
+
+	assert(p->string_symbols != 0);
+	assert(v->data.data_u32 < p->header->n_string_unicode);
+	PC_TRACE(p, v);
+	uint32_t* w = (uint32_t*)PC_HEAP_OFFSET(p, string_unicode_offsets, v->data.data_u32);
+
+	// validated when the file was opened
+	pointless_string_symbols_decode(p->string_symbols, (uint8_t*)(w + 1), POINTLESS_STRING_SYMBOLS_N_CODES(*w), buffer);
+	return buffer;
+}
+
+static pointless_value_t* pointless_reader_encoded_vector_items(pointless_t* p, pointless_value_t* v)
+{
+	assert(pointless_is_encoded_vector_type(v->type));
+
+	pointless_value_t vector;
+	vector.type = POINTLESS_VECTOR_VALUE;
+	vector.data = v->data;
+
+	assert(pointless_reader_vector_n_items(p, &vector) == 2);
+
+	return pointless_reader_vector_value(p, &vector);
+}
+
+pointless_value_t* pointless_reader_encoded_vector_values(pointless_t* p, pointless_value_t* v)
+{
+	return pointless_reader_encoded_vector_items(p, v);
+}
+
+pointless_value_t* pointless_reader_encoded_vector_codes(pointless_t* p, pointless_value_t* v)
+{
+	return pointless_reader_encoded_vector_items(p, v) + 1;
+}
+
+uint32_t pointless_reader_encoded_vector_code(pointless_t* p, pointless_value_t* codes, uint32_t i)
+{
+	switch (codes->type) {
+		case POINTLESS_VECTOR_U8:
+			return (uint32_t)pointless_reader_vector_u8(p, codes)[i];
+		case POINTLESS_VECTOR_U16:
+			return (uint32_t)pointless_reader_vector_u16(p, codes)[i];
+		case POINTLESS_VECTOR_U32:
+			return pointless_reader_vector_u32(p, codes)[i];
+	}
+
+	assert(0);
+	return 0;
+}
+
+// the run holding item 'i' is the first one ending after it
+static uint32_t pointless_reader_encoded_vector_run(pointless_t* p, pointless_value_t* ends, uint32_t i)
+{
+	uint32_t lo = 0, hi = pointless_reader_vector_n_items(p, ends), mid;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+
+		if (pointless_reader_encoded_vector_code(p, ends, mid) <= i)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+pointless_value_t* pointless_reader_split_vector_types(pointless_t* p, pointless_value_t* v)
+{
+	assert(v->type == POINTLESS_VECTOR_SPLIT);
+	return pointless_reader_encoded_vector_items(p, v);
+}
+
+pointless_value_t* pointless_reader_split_vector_data(pointless_t* p, pointless_value_t* v)
+{
+	assert(v->type == POINTLESS_VECTOR_SPLIT);
+	return pointless_reader_encoded_vector_items(p, v) + 1;
+}
+
+uint32_t pointless_reader_split_vector_type(pointless_t* p, pointless_value_t* v, uint32_t i)
+{
+	pointless_value_t* types = pointless_reader_split_vector_types(p, v);
+	uint8_t* t = pointless_reader_vector_u8(p, types);
+
+	// a single type for all items
+	if (pointless_reader_vector_n_items(p, types) == 1)
+		return (uint32_t)t[0];
+
+	return (uint32_t)t[i];
+}
+
+static pointless_complete_value_t pointless_reader_split_vector_item(pointless_t* p, pointless_value_t* v, uint32_t i)
+{
+	pointless_value_t item;
+	item.type = pointless_reader_split_vector_type(p, v, i);
+	item.data.data_u32 = pointless_reader_vector_u32(p, pointless_reader_split_vector_data(p, v))[i];
+	return pointless_value_to_complete(&item);
+}
+
+pointless_value_t* pointless_reader_block_vector_blocks(pointless_t* p, pointless_value_t* v)
+{
+	assert(v->type == POINTLESS_VECTOR_BLOCKS);
+	return pointless_reader_encoded_vector_items(p, v);
+}
+
+pointless_value_t* pointless_reader_block_vector_words(pointless_t* p, pointless_value_t* v)
+{
+	assert(v->type == POINTLESS_VECTOR_BLOCKS);
+	return pointless_reader_encoded_vector_items(p, v) + 1;
+}
+
+uint64_t pointless_reader_block_vector_block(pointless_t* p, pointless_value_t* v, uint32_t i)
+{
+	uint64_t block;
+	const char* blocks = (const char*)pointless_reader_vector_u64(p, pointless_reader_block_vector_blocks(p, v));
+	memcpy(&block, blocks + (size_t)i * sizeof(uint64_t), sizeof(block));
+	return block;
+}
+
+uint32_t pointless_reader_block_vector_item_type(pointless_t* p, pointless_value_t* v)
+{
+	return (uint32_t)(pointless_reader_block_vector_block(p, v, 0) >> 32);
+}
+
+// the block frame plus the delta of the item, which starts in one of the first 2 of the 3 words holding it
+static pointless_complete_value_t pointless_reader_block_vector_item(pointless_t* p, pointless_value_t* v, uint32_t i)
+{
+	uint64_t frame = pointless_reader_block_vector_block(p, v, 1 + 2 * (i / POINTLESS_VECTOR_BLOCK_SIZE));
+	uint64_t start = pointless_reader_block_vector_block(p, v, 2 + 2 * (i / POINTLESS_VECTOR_BLOCK_SIZE));
+	uint32_t width = (uint32_t)(start & 0xFF);
+	uint64_t bit = (start >> 8) * 32 + (uint64_t)(i % POINTLESS_VECTOR_BLOCK_SIZE) * width;
+	uint32_t* w = pointless_reader_vector_u32(p, pointless_reader_block_vector_words(p, v)) + bit / 32;
+	uint32_t shift = (uint32_t)(bit % 32);
+	uint64_t delta = (((uint64_t)w[1] << 32) | w[0]) >> shift;
+
+	if (shift + width > 64)
+		delta |= (uint64_t)w[2] << (64 - shift);
+
+	if (width < 64)
+		delta &= (((uint64_t)1 << width) - 1);
+
+	uint64_t item = frame + delta;
+
+	switch (pointless_reader_block_vector_item_type(p, v)) {
+		case POINTLESS_VECTOR_I8:
+		case POINTLESS_VECTOR_I16:
+		case POINTLESS_VECTOR_I32:
+			return pointless_complete_value_create_as_read_i32((int32_t)item);
+		case POINTLESS_VECTOR_U8:
+		case POINTLESS_VECTOR_U16:
+		case POINTLESS_VECTOR_U32:
+			return pointless_complete_value_create_as_read_u32((uint32_t)item);
+		case POINTLESS_VECTOR_I64:
+			return pointless_complete_value_create_as_read_i64((int64_t)item);
+		case POINTLESS_VECTOR_U64:
+			return pointless_complete_value_create_as_read_u64(item);
+	}
+
+	assert(0);
+	return pointless_complete_value_create_as_read_null();
+}
+
 uint32_t pointless_reader_vector_n_items(pointless_t* p, pointless_value_t* v)
 {
 	if (v->type == POINTLESS_VECTOR_EMPTY)
 		return 0;
 
+	// the number of codes, or the end of the last run
+	if (v->type == POINTLESS_VECTOR_DICTIONARY)
+		return pointless_reader_vector_n_items(p, pointless_reader_encoded_vector_codes(p, v));
+
+	if (v->type == POINTLESS_VECTOR_SPLIT)
+		return pointless_reader_vector_n_items(p, pointless_reader_split_vector_data(p, v));
+
+	if (v->type == POINTLESS_VECTOR_BLOCKS)
+		return (uint32_t)pointless_reader_block_vector_block(p, v, 0);
+
+	if (v->type == POINTLESS_VECTOR_RUNS) {
+		pointless_value_t* ends = pointless_reader_encoded_vector_codes(p, v);
+		uint32_t n_runs = pointless_reader_vector_n_items(p, ends);
+		return (n_runs > 0) ? pointless_reader_encoded_vector_code(p, ends, n_runs - 1) : 0;
+	}
+
 	assert(v->data.data_u32 < p->header->n_vector);
+	PC_TRACE(p, v);
 	uint32_t* v_len = (uint32_t*)PC_HEAP_OFFSET(p, vector_offsets, v->data.data_u32);
 
 	return *v_len;
@@ -244,6 +542,7 @@ static void* pointless_reader_vector_base_ptr(pointless_t* p, pointless_value_t*
 		return 0;
 
 	assert(v->data.data_u32 < p->header->n_vector);
+	PC_TRACE(p, v);
 	uint32_t* v_len = (uint32_t*)PC_HEAP_OFFSET(p, vector_offsets, v->data.data_u32);
 	return (void*)(v_len + 1);
 }
@@ -344,6 +643,14 @@ pointless_complete_value_t pointless_reader_vector_value_case(pointless_t* p, po
 			return pointless_complete_value_create_as_read_u64(pointless_reader_vector_u64(p, v)[i]);
 		case POINTLESS_VECTOR_FLOAT:
 			return pointless_complete_value_create_as_read_float(pointless_reader_vector_float(p, v)[i]);
+		case POINTLESS_VECTOR_DICTIONARY:
+			return pointless_reader_vector_value_case(p, pointless_reader_encoded_vector_values(p, v), pointless_reader_encoded_vector_code(p, pointless_reader_encoded_vector_codes(p, v), i));
+		case POINTLESS_VECTOR_RUNS:
+			return pointless_reader_vector_value_case(p, pointless_reader_encoded_vector_values(p, v), pointless_reader_encoded_vector_run(p, pointless_reader_encoded_vector_codes(p, v), i));
+		case POINTLESS_VECTOR_SPLIT:
+			return pointless_reader_split_vector_item(p, v, i);
+		case POINTLESS_VECTOR_BLOCKS:
+			return pointless_reader_block_vector_item(p, v, i);
 	}
 
 	assert(0);
@@ -356,6 +663,7 @@ uint32_t pointless_reader_bitvector_n_bits(pointless_t* p, pointless_value_t* v)
 
 	if (v->type == POINTLESS_BITVECTOR) {
 		assert(v->data.data_u32 < p->header->n_bitvector);
+		PC_TRACE(p, v);
 		buffer = (void*)PC_HEAP_OFFSET(p, bitvector_offsets, v->data.data_u32);
 	}
 
@@ -372,6 +680,7 @@ uint32_t pointless_reader_bitvector_is_set(pointless_t* p, pointless_value_t* v,
 
 	if (v->type == POINTLESS_BITVECTOR) {
 		assert(v->data.data_u32 < p->header->n_bitvector);
+		PC_TRACE(p, v);
 		buffer = (void*)PC_HEAP_OFFSET(p, bitvector_offsets, v->data.data_u32);
 	}
 
@@ -382,323 +691,442 @@ uint32_t pointless_reader_bitvector_is_set(pointless_t* p, pointless_value_t* v,
 
 void* pointless_reader_bitvector_buffer(pointless_t* p, pointless_value_t* v)
 {
+	PC_TRACE(p, v);
 	return (void*)PC_HEAP_OFFSET(p, bitvector_offsets, v->data.data_u32);
 }
 
-// sets
-uint32_t pointless_reader_set_n_items(pointless_t* p, pointless_value_t* s)
+// the compact layout has no empty slots in its key vector
+static uint32_t pointless_reader_is_compact(pointless_t* p, uint32_t n_items, pointless_value_t* key_vector)
 {
-	assert(s->type == POINTLESS_SET_VALUE);
-	pointless_set_header_t* header = (pointless_set_header_t*)PC_HEAP_OFFSET(p, set_offsets, s->data.data_u32);
-	assert((size_t)header % 4 == 0);
-	return header->n_items;
+	return (pointless_reader_vector_n_items(p, key_vector) == n_items);
 }
 
-uint32_t pointless_reader_set_n_buckets(pointless_t* p, pointless_value_t* s)
+// the dense layout has its smallest key in place of a key vector, only maps use it
+static uint32_t pointless_reader_is_dense(pointless_value_t* key_vector)
 {
-	assert(s->type == POINTLESS_SET_VALUE);
-	pointless_set_header_t* header = (pointless_set_header_t*)PC_HEAP_OFFSET(p, set_offsets, s->data.data_u32);
-	assert(pointless_reader_vector_n_items(p, &header->key_vector) == pointless_reader_vector_n_items(p, &header->hash_vector));
-	assert((size_t)header % 4 == 0);
-	return pointless_reader_vector_n_items(p, &header->key_vector);
+	return (key_vector->type == POINTLESS_I32 || key_vector->type == POINTLESS_U32);
 }
 
-uint32_t pointless_reader_set_iter(pointless_t* p, pointless_value_t* s, pointless_value_t** k, uint32_t* iter_state)
+static int64_t pointless_reader_dense_min_key(pointless_value_t* key_vector)
 {
-	assert(s->type == POINTLESS_SET_VALUE);
-	pointless_set_header_t* header = (pointless_set_header_t*)PC_HEAP_OFFSET(p, set_offsets, s->data.data_u32);
-	assert((size_t)header % 4 == 0);
-	assert(header->key_vector.type == POINTLESS_VECTOR_VALUE_HASHABLE);
-	uint32_t n_buckets = pointless_reader_vector_n_items(p, &header->key_vector);
+	if (key_vector->type == POINTLESS_I32)
+		return (int64_t)key_vector->data.data_i32;
+
+	return (int64_t)key_vector->data.data_u32;
+}
 
-	while (*iter_state < n_buckets) {
-		*k = &pointless_reader_vector_value(p, &header->key_vector)[*iter_state];
-		*iter_state += 1;
+// set and map functions specialized for an offset encoding, 'bloom' is the field from the set/map header
+typedef struct pointless_reader_core_s {
+	uint32_t (*bloom_maybe_contains)(pointless_t* p, uint32_t bloom, uint32_t hash);
+	uint32_t (*hash_table_probe)(pointless_t* p, uint32_t n_items, uint32_t bloom, pointless_value_t* hash_vector, pointless_value_t* key_vector, uint32_t hash, pointless_value_t* k, pointless_eq_cb cb, void* user, const char** error);
+	uint32_t (*hash_table_iter_entry)(pointless_t* p, uint32_t n_items, pointless_value_t* hash_vector, pointless_value_t* key_vector, uint32_t* entry, uint32_t* iter_state);
+	uint32_t (*set_iter)(pointless_t* p, pointless_value_t* s, pointless_value_t** k, uint32_t* iter_state);
+	uint32_t (*map_iter)(pointless_t* p, pointless_value_t* m, pointless_value_t** k, pointless_value_t** v, uint32_t* iter_state);
+	uint32_t (*set_probe)(pointless_t* p, pointless_value_t* s, pointless_value_t* k, const char** error);
+	uint32_t (*map_probe)(pointless_t* p, pointless_value_t* m, pointless_value_t* k, const char** error);
+} pointless_reader_core_t;
+
+#define PC_CORE_FN(name) pointless_reader_##name##_32
+#define PC_CORE_OFFSET(p, offsets, i) ((p)->offsets##_32[i])
+#include <pointless/pointless_reader_core.h>
+#undef PC_CORE_FN
+#undef PC_CORE_OFFSET
+
+#define PC_CORE_FN(name) pointless_reader_##name##_64
+#define PC_CORE_OFFSET(p, offsets, i) ((p)->offsets##_64[i])
+#include <pointless/pointless_reader_core.h>
+#undef PC_CORE_FN
+#undef PC_CORE_OFFSET
+
+#define PC_CORE_FN(name) pointless_reader_##name##_delta
+#define PC_CORE_OFFSET(p, offsets, i) PC_DELTA_OFFSET(p, offsets, i)
+#include <pointless/pointless_reader_core.h>
+#undef PC_CORE_FN
+#undef PC_CORE_OFFSET
+
+static void pointless_reader_init_core(pointless_t* p)
+{
+	if (p->is_32_offset)
+		p->core = &pointless_reader_core_32;
+	else if (p->is_64_offset)
+		p->core = &pointless_reader_core_64;
+	else
+		p->core = &pointless_reader_core_delta;
+}
 
-		if ((*k)->type != POINTLESS_EMPTY_SLOT)
+// iterate over the entries of a set/map with a given hash
+static uint32_t pointless_reader_hash_table_iter_hash_entry(pointless_t* p, uint32_t n_items, pointless_value_t* hash_vector, pointless_value_t* key_vector, uint32_t hash, uint32_t* entry, pointless_hash_iter_state_t* iter_state)
+{
+	uint32_t* hashes = pointless_reader_vector_u32(p, hash_vector);
+
+	if (pointless_reader_is_dense(key_vector))
+		return pointless_hash_table_dense_probe_hash(pointless_reader_dense_min_key(key_vector), hashes, pointless_reader_vector_n_items(p, hash_vector), hash, iter_state, entry);
+
+	// probe until we hit an empty bucket, or a matching hash(again)
+	if (pointless_reader_is_compact(p, n_items, key_vector)) {
+		while (pointless_hash_table_compact_probe_hash(p, hashes, n_items, iter_state, entry)) {
+			if (hashes[*entry] == hash)
+				return 1;
+		}
+
+		return 0;
+	}
+
+	pointless_value_t* keys = pointless_reader_vector_value(p, key_vector);
+
+	while (pointless_hash_table_probe_hash(p, hashes, keys, iter_state, entry)) {
+		if (hashes[*entry] == hash)
 			return 1;
 	}
 
 	return 0;
 }
 
-void pointless_reader_set_lookup(pointless_t* p, pointless_value_t* s, pointless_value_t* k, pointless_value_t** kk, const char** error)
+// sets
+static pointless_set_header_t* pointless_reader_set_header(pointless_t* p, pointless_value_t* s)
 {
-	// value must be hashable
-	if (!pointless_is_hashable(k->type)) {
-		*error = "value is not hashable";
-		return;
-	}
-
-	// this must be a set
 	assert(s->type == POINTLESS_SET_VALUE);
+	PC_TRACE(p, s);
 	pointless_set_header_t* header = (pointless_set_header_t*)PC_HEAP_OFFSET(p, set_offsets, s->data.data_u32);
 	assert((size_t)header % 4 == 0);
+	return header;
+}
 
-	// value hash
-	uint32_t hash = pointless_hash_reader_32(p, k);
+uint32_t pointless_reader_set_n_items(pointless_t* p, pointless_value_t* s)
+{
+	return pointless_reader_set_header(p, s)->n_items;
+}
 
-	// other info
-	uint32_t* hash_vector = pointless_reader_vector_u32(p, &header->hash_vector);
-	pointless_value_t* key_vector = pointless_reader_vector_value(p, &header->key_vector);
+uint32_t pointless_reader_set_n_buckets(pointless_t* p, pointless_value_t* s)
+{
+	pointless_set_header_t* header = pointless_reader_set_header(p, s);
 
-	uint32_t n_buckets = pointless_reader_vector_n_items(p, &header->key_vector);
+	if (pointless_reader_is_compact(p, header->n_items, &header->key_vector))
+		return pointless_hash_compute_n_buckets(header->n_items);
 
-	// do the probe
-	uint32_t probe = pointless_hash_table_probe(p, hash, k, n_buckets, hash_vector, key_vector, error);
+	assert(pointless_reader_vector_n_items(p, &header->key_vector) == pointless_reader_vector_n_items(p, &header->hash_vector));
+	return pointless_reader_vector_n_items(p, &header->key_vector);
+}
 
-	if (probe == POINTLESS_HASH_TABLE_PROBE_ERROR || probe == POINTLESS_HASH_TABLE_PROBE_MISS)
-		*kk = 0;
-	else
-		*kk = &key_vector[probe];
+uint32_t pointless_reader_set_is_compact(pointless_t* p, pointless_value_t* s)
+{
+	pointless_set_header_t* header = pointless_reader_set_header(p, s);
+	return pointless_reader_is_compact(p, header->n_items, &header->key_vector);
 }
 
-void pointless_reader_set_lookup_ext(pointless_t* p, pointless_value_t* s, uint32_t hash, pointless_eq_cb cb, void* user, pointless_value_t** kk, const char** error)
+uint32_t pointless_reader_set_iter_entry(pointless_t* p, pointless_value_t* s, uint32_t* entry, uint32_t* iter_state)
 {
-	// this must be a set
-	assert(s->type == POINTLESS_SET_VALUE);
-	pointless_set_header_t* header = (pointless_set_header_t*)PC_HEAP_OFFSET(p, set_offsets, s->data.data_u32);
-	assert((size_t)header % 4 == 0);
+	pointless_set_header_t* header = pointless_reader_set_header(p, s);
+	return (*p->core->hash_table_iter_entry)(p, header->n_items, &header->hash_vector, &header->key_vector, entry, iter_state);
+}
 
-	// other info
-	uint32_t* hash_vector = pointless_reader_vector_u32(p, &header->hash_vector);
-	pointless_value_t* key_vector = pointless_reader_vector_value(p, &header->key_vector);
+pointless_complete_value_t pointless_reader_set_key(pointless_t* p, pointless_value_t* s, uint32_t entry)
+{
+	return pointless_reader_vector_value_case(p, &pointless_reader_set_header(p, s)->key_vector, entry);
+}
 
-	uint32_t n_buckets = pointless_reader_vector_n_items(p, &header->key_vector);
+uint32_t pointless_reader_set_iter(pointless_t* p, pointless_value_t* s, pointless_value_t** k, uint32_t* iter_state)
+{
+	return (*p->core->set_iter)(p, s, k, iter_state);
+}
+
+uint32_t pointless_reader_set_probe(pointless_t* p, pointless_value_t* s, pointless_value_t* k, const char** error)
+{
+	return (*p->core->set_probe)(p, s, k, error);
+}
 
-	// do the probe
-	uint32_t probe = pointless_hash_table_probe_ext(p, hash, cb, user, n_buckets, hash_vector, key_vector, error);
+uint32_t pointless_reader_set_probe_ext(pointless_t* p, pointless_value_t* s, uint32_t hash, pointless_eq_cb cb, void* user, const char** error)
+{
+	pointless_set_header_t* header = pointless_reader_set_header(p, s);
+	return (*p->core->hash_table_probe)(p, header->n_items, header->bloom, &header->hash_vector, &header->key_vector, hash, 0, cb, user, error);
+}
 
-	if (probe == POINTLESS_HASH_TABLE_PROBE_ERROR || probe == POINTLESS_HASH_TABLE_PROBE_MISS)
+static void pointless_reader_set_lookup_entry(pointless_t* p, pointless_value_t* s, uint32_t probe, pointless_value_t** kk)
+{
+	if (probe == POINTLESS_HASH_TABLE_PROBE_ERROR || probe == POINTLESS_HASH_TABLE_PROBE_MISS) {
 		*kk = 0;
-	else
-		*kk = &key_vector[probe];
+		return;
+	}
+
+	pointless_value_t* key_vector = pointless_set_key_vector(p, s);
+	assert(key_vector->type == POINTLESS_VECTOR_VALUE_HASHABLE);
+	*kk = &pointless_reader_vector_value(p, key_vector)[probe];
 }
 
-pointless_value_t* pointless_set_hash_vector(pointless_t* p, pointless_value_t* s)
+void pointless_reader_set_lookup(pointless_t* p, pointless_value_t* s, pointless_value_t* k, pointless_value_t** kk, const char** error)
 {
-	// this must be a set
-	assert(s->type == POINTLESS_SET_VALUE);
-	pointless_set_header_t* header = (pointless_set_header_t*)PC_HEAP_OFFSET(p, set_offsets, s->data.data_u32);
-	assert((size_t)header % 4 == 0);
+	pointless_reader_set_lookup_entry(p, s, pointless_reader_set_probe(p, s, k, error), kk);
+}
 
-	return &header->hash_vector;
+void pointless_reader_set_lookup_ext(pointless_t* p, pointless_value_t* s, uint32_t hash, pointless_eq_cb cb, void* user, pointless_value_t** kk, const char** error)
+{
+	pointless_reader_set_lookup_entry(p, s, pointless_reader_set_probe_ext(p, s, hash, cb, user, error), kk);
 }
 
-pointless_value_t* pointless_set_key_vector(pointless_t* p, pointless_value_t* s)
+uint32_t pointless_reader_set_maybe_contains_hash(pointless_t* p, pointless_value_t* s, uint32_t hash)
 {
-	// this must be a set
-	assert(s->type == POINTLESS_SET_VALUE);
-	pointless_set_header_t* header = (pointless_set_header_t*)PC_HEAP_OFFSET(p, set_offsets, s->data.data_u32);
-	assert((size_t)header % 4 == 0);
+	return (*p->core->bloom_maybe_contains)(p, pointless_reader_set_header(p, s)->bloom, hash);
+}
 
-	return &header->key_vector;
+uint32_t pointless_reader_set_bloom(pointless_t* p, pointless_value_t* s)
+{
+	return pointless_reader_set_header(p, s)->bloom;
 }
 
-uint32_t pointless_reader_map_n_items(pointless_t* p, pointless_value_t* m)
+pointless_value_t* pointless_set_hash_vector(pointless_t* p, pointless_value_t* s)
+{
+	return &pointless_reader_set_header(p, s)->hash_vector;
+}
+
+pointless_value_t* pointless_set_key_vector(pointless_t* p, pointless_value_t* s)
+{
+	return &pointless_reader_set_header(p, s)->key_vector;
+}
+
+// maps
+static pointless_map_header_t* pointless_reader_map_header(pointless_t* p, pointless_value_t* m)
 {
 	assert(m->type == POINTLESS_MAP_VALUE_VALUE);
+	PC_TRACE(p, m);
 	pointless_map_header_t* header = (pointless_map_header_t*)PC_HEAP_OFFSET(p, map_offsets, m->data.data_u32);
 	assert((size_t)header % 4 == 0);
-	return header->n_items;
+	return header;
+}
+
+uint32_t pointless_reader_map_n_items(pointless_t* p, pointless_value_t* m)
+{
+	return pointless_reader_map_header(p, m)->n_items;
 }
 
 uint32_t pointless_reader_map_n_buckets(pointless_t* p, pointless_value_t* m)
 {
-	assert(m->type == POINTLESS_MAP_VALUE_VALUE);
-	pointless_map_header_t* header = (pointless_map_header_t*)PC_HEAP_OFFSET(p, map_offsets, m->data.data_u32);
-	assert(pointless_reader_vector_n_items(p, &header->hash_vector) == pointless_reader_vector_n_items(p, &header->key_vector));
+	pointless_map_header_t* header = pointless_reader_map_header(p, m);
+
+	// one bucket per integer in the key range
+	if (pointless_reader_is_dense(&header->key_vector))
+		return pointless_reader_vector_n_items(p, &header->value_vector);
+
 	assert(pointless_reader_vector_n_items(p, &header->key_vector) == pointless_reader_vector_n_items(p, &header->value_vector));
-	assert((size_t)header % 4 == 0);
+
+	if (pointless_reader_is_compact(p, header->n_items, &header->key_vector))
+		return pointless_hash_compute_n_buckets(header->n_items);
+
+	assert(pointless_reader_vector_n_items(p, &header->hash_vector) == pointless_reader_vector_n_items(p, &header->key_vector));
 	return pointless_reader_vector_n_items(p, &header->key_vector);
 }
 
+uint32_t pointless_reader_map_is_compact(pointless_t* p, pointless_value_t* m)
+{
+	pointless_map_header_t* header = pointless_reader_map_header(p, m);
+	return (!pointless_reader_is_dense(&header->key_vector) && pointless_reader_is_compact(p, header->n_items, &header->key_vector));
+}
 
-uint32_t pointless_reader_map_iter(pointless_t* p, pointless_value_t* m, pointless_value_t** k, pointless_value_t** v, uint32_t* iter_state)
+uint32_t pointless_reader_map_is_dense(pointless_t* p, pointless_value_t* m)
 {
-	assert(m->type == POINTLESS_MAP_VALUE_VALUE);
-	pointless_map_header_t* header = (pointless_map_header_t*)PC_HEAP_OFFSET(p, map_offsets, m->data.data_u32);
-	assert(header->key_vector.type == POINTLESS_VECTOR_VALUE_HASHABLE);
-	assert(header->value_vector.type == POINTLESS_VECTOR_VALUE || header->value_vector.type == POINTLESS_VECTOR_VALUE_HASHABLE);
-	uint32_t n_buckets = pointless_reader_vector_n_items(p, &header->key_vector);
-	assert((size_t)header % 4 == 0);
+	return pointless_reader_is_dense(&pointless_reader_map_header(p, m)->key_vector);
+}
 
-	while (*iter_state < n_buckets) {
-		*k = &pointless_reader_vector_value(p, &header->key_vector)[*iter_state];
-		*v = &pointless_reader_vector_value(p, &header->value_vector)[*iter_state];
-		*iter_state += 1;
+uint32_t pointless_reader_map_dense_entry(pointless_t* p, pointless_value_t* m, int64_t k)
+{
+	pointless_map_header_t* header = pointless_reader_map_header(p, m);
+	assert(pointless_reader_is_dense(&header->key_vector));
 
-		if ((*k)->type != POINTLESS_EMPTY_SLOT)
-			return 1;
-	}
+	uint32_t* bits = pointless_reader_vector_u32(p, &header->hash_vector);
+	uint32_t n_words = pointless_reader_vector_n_items(p, &header->hash_vector);
+	return pointless_hash_table_dense_entry(pointless_reader_dense_min_key(&header->key_vector), bits, n_words, k);
+}
 
-	return 0;
+pointless_complete_value_t pointless_reader_map_key(pointless_t* p, pointless_value_t* m, uint32_t entry)
+{
+	pointless_map_header_t* header = pointless_reader_map_header(p, m);
+
+	if (pointless_reader_is_dense(&header->key_vector))
+		return pointless_hash_table_dense_key(pointless_reader_dense_min_key(&header->key_vector), entry);
+
+	return pointless_reader_vector_value_case(p, &header->key_vector, entry);
+}
+
+pointless_complete_value_t pointless_reader_map_value(pointless_t* p, pointless_value_t* m, uint32_t entry)
+{
+	return pointless_reader_vector_value_case(p, &pointless_reader_map_header(p, m)->value_vector, entry);
+}
+
+uint32_t pointless_reader_map_iter_entry(pointless_t* p, pointless_value_t* m, uint32_t* entry, uint32_t* iter_state)
+{
+	pointless_map_header_t* header = pointless_reader_map_header(p, m);
+	return (*p->core->hash_table_iter_entry)(p, header->n_items, &header->hash_vector, &header->key_vector, entry, iter_state);
+}
+
+uint32_t pointless_reader_map_iter(pointless_t* p, pointless_value_t* m, pointless_value_t** k, pointless_value_t** v, uint32_t* iter_state)
+{
+	return (*p->core->map_iter)(p, m, k, v, iter_state);
 }
 
 void pointless_reader_map_iter_hash_init(pointless_t* p, pointless_value_t* m, uint32_t hash, pointless_hash_iter_state_t* iter_state)
 {
-	assert(m->type == POINTLESS_MAP_VALUE_VALUE);
-	pointless_map_header_t* header = (pointless_map_header_t*)PC_HEAP_OFFSET(p, map_offsets, m->data.data_u32);
+	pointless_map_header_t* header = pointless_reader_map_header(p, m);
 	assert(header->hash_vector.type == POINTLESS_VECTOR_U32);
-	uint32_t n_buckets = pointless_reader_vector_n_items(p, &header->hash_vector);
-	assert((size_t)header % 4 == 0);
-	pointless_hash_table_probe_hash_init(p, hash, n_buckets, iter_state);
+
+	if (pointless_reader_is_dense(&header->key_vector))
+		pointless_hash_table_dense_probe_hash_init(iter_state);
+	else
+		pointless_hash_table_probe_hash_init(p, hash, pointless_reader_map_n_buckets(p, m), iter_state);
 }
 
-uint32_t pointless_reader_map_iter_hash(pointless_t* p, pointless_value_t* m, uint32_t hash, pointless_value_t** kk, pointless_value_t** vv, pointless_hash_iter_state_t* iter_state)
+uint32_t pointless_reader_map_iter_hash_entry(pointless_t* p, pointless_value_t* m, uint32_t hash, uint32_t* entry, pointless_hash_iter_state_t* iter_state)
 {
-	assert(m->type == POINTLESS_MAP_VALUE_VALUE);
-	pointless_map_header_t* header = (pointless_map_header_t*)PC_HEAP_OFFSET(p, map_offsets, m->data.data_u32);
+	pointless_map_header_t* header = pointless_reader_map_header(p, m);
 	assert(header->hash_vector.type == POINTLESS_VECTOR_U32);
+	return pointless_reader_hash_table_iter_hash_entry(p, header->n_items, &header->hash_vector, &header->key_vector, hash, entry, iter_state);
+}
+
+uint32_t pointless_reader_map_iter_hash(pointless_t* p, pointless_value_t* m, uint32_t hash, pointless_value_t** kk, pointless_value_t** vv, pointless_hash_iter_state_t* iter_state)
+{
+	pointless_map_header_t* header = pointless_reader_map_header(p, m);
 	assert(header->key_vector.type == POINTLESS_VECTOR_VALUE_HASHABLE);
 	assert(header->value_vector.type == POINTLESS_VECTOR_VALUE || header->value_vector.type == POINTLESS_VECTOR_VALUE_HASHABLE);
+	uint32_t entry = 0;
 
-	assert((size_t)header % 4 == 0);
-
-	// get vector pointers
-	uint32_t* hash_vector = pointless_reader_vector_u32(p, &header->hash_vector);
-	pointless_value_t* key_vector = pointless_reader_vector_value(p, &header->key_vector);
-	pointless_value_t* value_vector = pointless_reader_vector_value(p, &header->value_vector);
-
-	// probe until we hit an empty bucket, or a matching hash(again)
-	uint32_t bucket_out = 0;
-
-	while (pointless_hash_table_probe_hash(p, hash_vector, key_vector, iter_state, &bucket_out)) {
-		if (hash_vector[bucket_out] == hash) {
-			*kk = &key_vector[bucket_out];
-			*vv = &value_vector[bucket_out];
-			return 1;
-		}
-	}
+	if (!pointless_reader_map_iter_hash_entry(p, m, hash, &entry, iter_state))
+		return 0;
 
-	return 0;
+	*kk = &pointless_reader_vector_value(p, &header->key_vector)[entry];
+	*vv = &pointless_reader_vector_value(p, &header->value_vector)[entry];
+	return 1;
 }
 
 void pointless_reader_set_iter_hash_init(pointless_t* p, pointless_value_t* s, uint32_t hash, pointless_hash_iter_state_t* iter_state)
 {
-	assert(s->type == POINTLESS_SET_VALUE);
-	pointless_set_header_t* header = (pointless_set_header_t*)PC_HEAP_OFFSET(p, set_offsets, s->data.data_u32);
+	assert(pointless_reader_set_header(p, s)->hash_vector.type == POINTLESS_VECTOR_U32);
+	pointless_hash_table_probe_hash_init(p, hash, pointless_reader_set_n_buckets(p, s), iter_state);
+}
+
+uint32_t pointless_reader_set_iter_hash_entry(pointless_t* p, pointless_value_t* s, uint32_t hash, uint32_t* entry, pointless_hash_iter_state_t* iter_state)
+{
+	pointless_set_header_t* header = pointless_reader_set_header(p, s);
 	assert(header->hash_vector.type == POINTLESS_VECTOR_U32);
-	uint32_t n_buckets = pointless_reader_vector_n_items(p, &header->hash_vector);
-	assert((size_t)header % 4 == 0);
-	pointless_hash_table_probe_hash_init(p, hash, n_buckets, iter_state);
+	return pointless_reader_hash_table_iter_hash_entry(p, header->n_items, &header->hash_vector, &header->key_vector, hash, entry, iter_state);
 }
 
 uint32_t pointless_reader_set_iter_hash(pointless_t* p, pointless_value_t* s, uint32_t hash, pointless_value_t** kk, pointless_hash_iter_state_t* iter_state)
 {
-	assert(s->type == POINTLESS_SET_VALUE);
-	pointless_set_header_t* header = (pointless_set_header_t*)PC_HEAP_OFFSET	(p, set_offsets, s->data.data_u32);
-	assert(header->hash_vector.type == POINTLESS_VECTOR_U32);
+	pointless_set_header_t* header = pointless_reader_set_header(p, s);
 	assert(header->key_vector.type == POINTLESS_VECTOR_VALUE_HASHABLE);
+	uint32_t entry = 0;
 
-	assert((size_t)header % 4 == 0);
-
-	// get vector pointers
-	uint32_t* hash_vector = pointless_reader_vector_u32(p, &header->hash_vector);
-	pointless_value_t* key_vector = pointless_reader_vector_value(p, &header->key_vector);
+	if (!pointless_reader_set_iter_hash_entry(p, s, hash, &entry, iter_state))
+		return 0;
 
-	// probe until we hit an empty bucket, or a matching hash(again)
-	uint32_t bucket_out = 0;
+	*kk = &pointless_reader_vector_value(p, &header->key_vector)[entry];
+	return 1;
+}
 
-	while (pointless_hash_table_probe_hash(p, hash_vector, key_vector, iter_state, &bucket_out)) {
-		if (hash_vector[bucket_out] == hash) {
-			*kk = &key_vector[bucket_out];
-			return 1;
-		}
-	}
+uint32_t pointless_reader_map_probe(pointless_t* p, pointless_value_t* m, pointless_value_t* k, const char** error)
+{
+	return (*p->core->map_probe)(p, m, k, error);
+}
 
-	return 0;
+uint32_t pointless_reader_map_probe_ext(pointless_t* p, pointless_value_t* m, uint32_t hash, pointless_eq_cb cb, void* user, const char** error)
+{
+	pointless_map_header_t* header = pointless_reader_map_header(p, m);
+	return (*p->core->hash_table_probe)(p, header->n_items, header->bloom, &header->hash_vector, &header->key_vector, hash, 0, cb, user, error);
 }
 
-void pointless_reader_map_lookup(pointless_t* p, pointless_value_t* m, pointless_value_t* k, pointless_value_t** kk, pointless_value_t** vv, const char** error)
+static void pointless_reader_map_lookup_entry(pointless_t* p, pointless_value_t* m, uint32_t probe, pointless_value_t** kk, pointless_value_t** vv)
 {
-	// value must be hashable
-	if (!pointless_is_hashable(k->type)) {
-		*error = "value is not hashable";
+	if (probe == POINTLESS_HASH_TABLE_PROBE_ERROR || probe == POINTLESS_HASH_TABLE_PROBE_MISS) {
+		*kk = 0;
+		*vv = 0;
 		return;
 	}
 
-	// this must be a map
-	assert(m->type == POINTLESS_MAP_VALUE_VALUE);
-	pointless_map_header_t* header = (pointless_map_header_t*)PC_HEAP_OFFSET(p, map_offsets, m->data.data_u32);
-	assert((size_t)header % 4 == 0);
+	pointless_map_header_t* header = pointless_reader_map_header(p, m);
+	assert(header->key_vector.type == POINTLESS_VECTOR_VALUE_HASHABLE);
+	assert(header->value_vector.type == POINTLESS_VECTOR_VALUE || header->value_vector.type == POINTLESS_VECTOR_VALUE_HASHABLE);
+	*kk = &pointless_reader_vector_value(p, &header->key_vector)[probe];
+	*vv = &pointless_reader_vector_value(p, &header->value_vector)[probe];
+}
 
-	// value hash
-	uint32_t hash = pointless_hash_reader_32(p, k);
+void pointless_reader_map_lookup(pointless_t* p, pointless_value_t* m, pointless_value_t* k, pointless_value_t** kk, pointless_value_t** vv, const char** error)
+{
+	pointless_reader_map_lookup_entry(p, m, pointless_reader_map_probe(p, m, k, error), kk, vv);
+}
 
-	// other info
-	uint32_t* hash_vector = pointless_reader_vector_u32(p, &header->hash_vector);
-	pointless_value_t* key_vector = pointless_reader_vector_value(p, &header->key_vector);
-	pointless_value_t* value_vector = pointless_reader_vector_value(p, &header->value_vector);
+void pointless_reader_map_lookup_ext(pointless_t* p, pointless_value_t* m, uint32_t hash, pointless_eq_cb cb, void* user, pointless_value_t** kk, pointless_value_t** vv, const char** error)
+{
+	pointless_reader_map_lookup_entry(p, m, pointless_reader_map_probe_ext(p, m, hash, cb, user, error), kk, vv);
+}
 
-	uint32_t n_buckets = pointless_reader_vector_n_items(p, &header->key_vector);
+uint32_t pointless_reader_map_maybe_contains_hash(pointless_t* p, pointless_value_t* m, uint32_t hash)
+{
+	return (*p->core->bloom_maybe_contains)(p, pointless_reader_map_header(p, m)->bloom, hash);
+}
 
-	// do the probe
-	uint32_t probe = pointless_hash_table_probe(p, hash, k, n_buckets, hash_vector, key_vector, error);
+uint32_t pointless_reader_map_bloom(pointless_t* p, pointless_value_t* m)
+{
+	return pointless_reader_map_header(p, m)->bloom;
+}
 
-	if (probe == POINTLESS_HASH_TABLE_PROBE_ERROR || probe == POINTLESS_HASH_TABLE_PROBE_MISS) {
-		*kk = 0;
-		*vv = 0;
-	} else {
-		*kk = &key_vector[probe];
-		*vv = &value_vector[probe];
-	}
+pointless_value_t* pointless_map_hash_vector(pointless_t* p, pointless_value_t* m)
+{
+	return &pointless_reader_map_header(p, m)->hash_vector;
 }
 
-void pointless_reader_map_lookup_ext(pointless_t* p, pointless_value_t* m, uint32_t hash, pointless_eq_cb cb, void* user, pointless_value_t** kk, pointless_value_t** vv, const char** error)
+pointless_value_t* pointless_map_key_vector(pointless_t* p, pointless_value_t* m)
 {
-	// this must be a map
-	assert(m->type == POINTLESS_MAP_VALUE_VALUE);
-	pointless_map_header_t* header = (pointless_map_header_t*)PC_HEAP_OFFSET(p, map_offsets, m->data.data_u32);
-	assert((size_t)header % 4 == 0);
+	return &pointless_reader_map_header(p, m)->key_vector;
+}
+
+pointless_value_t* pointless_map_value_vector(pointless_t* p, pointless_value_t* m)
+{
+	return &pointless_reader_map_header(p, m)->value_vector;
+}
 
-	// other info
-	uint32_t* hash_vector = pointless_reader_vector_u32(p, &header->hash_vector);
-	pointless_value_t* key_vector = pointless_reader_vector_value(p, &header->key_vector);
-	pointless_value_t* value_vector = pointless_reader_vector_value(p, &header->value_vector);
+static pointless_value_t* pointless_reader_table_items(pointless_t* p, pointless_value_t* t, uint32_t* n_items)
+{
+	assert(t->type == POINTLESS_TABLE);
 
-	uint32_t n_buckets = pointless_reader_vector_n_items(p, &header->key_vector);
+	pointless_value_t v;
+	v.type = POINTLESS_VECTOR_VALUE;
+	v.data = t->data;
 
-	// do the probe
-	uint32_t probe = pointless_hash_table_probe_ext(p, hash, cb, user, n_buckets, hash_vector, key_vector, error);
+	*n_items = pointless_reader_vector_n_items(p, &v);
+	assert(*n_items >= 2);
 
-	if (probe == POINTLESS_HASH_TABLE_PROBE_ERROR || probe == POINTLESS_HASH_TABLE_PROBE_MISS) {
-		*kk = 0;
-		*vv = 0;
-	} else {
-		*kk = &key_vector[probe];
-		*vv = &value_vector[probe];
-	}
+	return pointless_reader_vector_value(p, &v);
 }
 
-pointless_value_t* pointless_map_hash_vector(pointless_t* p, pointless_value_t* m)
+uint32_t pointless_reader_table_n_rows(pointless_t* p, pointless_value_t* t)
 {
-	// this must be a map
-	assert(m->type == POINTLESS_MAP_VALUE_VALUE);
-	pointless_map_header_t* header = (pointless_map_header_t*)PC_HEAP_OFFSET(p, map_offsets, m->data.data_u32);
-	assert((size_t)header % 4 == 0);
-
-	return &header->hash_vector;
+	uint32_t n_items = 0;
+	pointless_value_t* items = pointless_reader_table_items(p, t, &n_items);
+	return pointless_value_get_u32(items[0].type, &items[0].data);
 }
 
-pointless_value_t* pointless_map_key_vector(pointless_t* p, pointless_value_t* m)
+uint32_t pointless_reader_table_n_columns(pointless_t* p, pointless_value_t* t)
 {
-	// this must be a map
-	assert(m->type == POINTLESS_MAP_VALUE_VALUE);
-	pointless_map_header_t* header = (pointless_map_header_t*)PC_HEAP_OFFSET(p, map_offsets, m->data.data_u32);
-	assert((size_t)header % 4 == 0);
+	uint32_t n_items = 0;
+	pointless_reader_table_items(p, t, &n_items);
+	return n_items - 2;
+}
 
-	return &header->key_vector;
+pointless_value_t* pointless_reader_table_keys(pointless_t* p, pointless_value_t* t)
+{
+	uint32_t n_items = 0;
+	return pointless_reader_table_items(p, t, &n_items) + 1;
 }
 
-pointless_value_t* pointless_map_value_vector(pointless_t* p, pointless_value_t* m)
+pointless_value_t* pointless_reader_table_columns(pointless_t* p, pointless_value_t* t)
 {
-	// this must be a map
-	assert(m->type == POINTLESS_MAP_VALUE_VALUE);
-	pointless_map_header_t* header = (pointless_map_header_t*)PC_HEAP_OFFSET(p, map_offsets, m->data.data_u32);
-	assert((size_t)header % 4 == 0);
+	uint32_t n_items = 0;
+	return pointless_reader_table_items(p, t, &n_items) + 2;
+}
 
-	return &header->value_vector;
+pointless_complete_value_t pointless_reader_table_value(pointless_t* p, pointless_value_t* t, uint32_t row, uint32_t column)
+{
+	assert(row < pointless_reader_table_n_rows(p, t));
+	assert(column < pointless_reader_table_n_columns(p, t));
+	return pointless_reader_vector_value_case(p, pointless_reader_table_columns(p, t) + column, row);
 }
 
 // number of containers
@@ -714,7 +1142,7 @@ uint32_t pointless_n_containers(pointless_t* p)
 	return n;
 }
 
-// get ID of container (non-empty vectors, sets and maps)
+// get ID of container (non-empty vectors, tables, sets and maps)
 uint32_t pointless_container_id(pointless_t* p, pointless_value_t* c)
 {
 	switch (c->type) {
@@ -731,6 +1159,11 @@ uint32_t pointless_container_id(pointless_t* p, pointless_value_t* c)
 		case POINTLESS_VECTOR_I64:
 		case POINTLESS_VECTOR_U64:
 		case POINTLESS_VECTOR_FLOAT:
+		case POINTLESS_VECTOR_DICTIONARY:
+		case POINTLESS_VECTOR_RUNS:
+		case POINTLESS_VECTOR_SPLIT:
+		case POINTLESS_VECTOR_BLOCKS:
+		case POINTLESS_TABLE:
 			return 1 + c->data.data_u32;
 		case POINTLESS_SET_VALUE:
 			return 1 + c->data.data_u32 + p->header->n_vector;
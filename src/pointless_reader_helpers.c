@@ -15,8 +15,9 @@ static int check_string(pointless_t* p, pointless_value_t* v, void* user)
 	if (v->type == POINTLESS_UNICODE_) {
 		uint32_t* s = pointless_reader_unicode_value_ucs4(p, v);
 		return (pointless_cmp_string_32_8(s, key_s) == 0);
-	} else if (v->type == POINTLESS_STRING_) {
-		uint8_t* s = pointless_reader_string_value_ascii(p, v);
+	} else if (pointless_is_string_8_type(v->type)) {
+		uint8_t buffer[POINTLESS_STRING_SYMBOLS_BUFFER_LEN];
+		uint8_t* s = pointless_reader_string_value_ascii_buffer(p, v, buffer);
 		return (pointless_cmp_string_8_8(s, key_s) == 0);
 	}
 
@@ -30,8 +31,9 @@ static int check_string_n(pointless_t* p, pointless_value_t* v, void* user)
 	if (v->type == POINTLESS_UNICODE_) {
 		uint32_t* s = pointless_reader_unicode_value_ucs4(p, v);
 		return (pointless_cmp_string_32_8_n(s, key->s, key->n) == 0);
-	} else if (v->type == POINTLESS_STRING_) {
-		uint8_t* s = pointless_reader_string_value_ascii(p, v);
+	} else if (pointless_is_string_8_type(v->type)) {
+		uint8_t buffer[POINTLESS_STRING_SYMBOLS_BUFFER_LEN];
+		uint8_t* s = pointless_reader_string_value_ascii_buffer(p, v, buffer);
 		return (pointless_cmp_string_8_8_n(s, key->s, key->n) == 0);
 	}
 
@@ -45,8 +47,9 @@ static int check_unicode(pointless_t* p, pointless_value_t* v, void* user)
 	if (v->type == POINTLESS_UNICODE_) {
 		uint32_t* s = pointless_reader_unicode_value_ucs4(p, v);
 		return (pointless_cmp_string_32_32(s, key_s) == 0);
-	} else if (v->type == POINTLESS_STRING_) {
-		uint8_t* s = pointless_reader_string_value_ascii(p, v);
+	} else if (pointless_is_string_8_type(v->type)) {
+		uint8_t buffer[POINTLESS_STRING_SYMBOLS_BUFFER_LEN];
+		uint8_t* s = pointless_reader_string_value_ascii_buffer(p, v, buffer);
 		return (pointless_cmp_string_8_32(s, key_s) == 0);
 	}
 
@@ -99,22 +102,55 @@ static int get_value(pointless_t* p, pointless_value_t* v, void* user, void* out
 	return 1;
 }
 
+// a set/map key or value as an inline value, the key/value vectors may be primitive vectors. 64-bit integers
+// have no inline representation, and are not supported by these helpers
+static int pointless_get_entry(pointless_t* p, pointless_value_t* vector, uint32_t entry, pointless_value_t* v)
+{
+	if (vector->type == POINTLESS_VECTOR_VALUE || vector->type == POINTLESS_VECTOR_VALUE_HASHABLE) {
+		*v = pointless_reader_vector_value(p, vector)[entry];
+		return 1;
+	}
+
+	pointless_complete_value_t cv = pointless_reader_vector_value_case(p, vector, entry);
+
+	if (cv.type == POINTLESS_I64 || cv.type == POINTLESS_U64)
+		return 0;
+
+	*v = pointless_value_from_complete(&cv);
+	return 1;
+}
+
+// keys of dense maps are not stored in a vector
+static int pointless_get_map_key(pointless_t* p, pointless_value_t* m, uint32_t entry, pointless_value_t* k)
+{
+	if (pointless_reader_map_is_dense(p, m)) {
+		pointless_complete_value_t ck = pointless_reader_map_key(p, m, entry);
+		*k = pointless_value_from_complete(&ck);
+		return 1;
+	}
+
+	return pointless_get_entry(p, pointless_map_key_vector(p, m), entry, k);
+}
+
 static int pointless_get_map_(pointless_t* p, pointless_value_t* map, uint32_t hash, check_k cb_k, void* user_k, check_v cb_v, void* user_v, void* out)
 {
 	// this must be a map
 	assert(map->type == POINTLESS_MAP_VALUE_VALUE);
 
 	// our key/value
-	pointless_value_t* kk = 0;
-	pointless_value_t* vv = 0;
+	pointless_value_t kk, vv;
+	uint32_t entry = 0;
 
 	// initialize iterator
 	pointless_hash_iter_state_t iter_state;
 	pointless_reader_map_iter_hash_init(p, map, hash, &iter_state);
 
 	// iterate
-	while (pointless_reader_map_iter_hash(p, map, hash, &kk, &vv, &iter_state)) {
-		if ((*cb_k)(p, kk, user_k) && (*cb_v)(p, vv, user_v, out))
+	while (pointless_reader_map_iter_hash_entry(p, map, hash, &entry, &iter_state)) {
+		if (!pointless_get_map_key(p, map, entry, &kk) || !pointless_get_entry(p, pointless_map_value_vector(p, map), entry, &vv))
+			continue;
+
+		if ((*cb_k)(p, &kk, user_k) && (*cb_v)(p, &vv, user_v, out))
 			return 1;
 	}
 
@@ -127,15 +163,16 @@ static int pointless_get_set_(pointless_t* p, pointless_value_t* set, uint32_t h
 	assert(set->type == POINTLESS_SET_VALUE);
 
 	// our key
-	pointless_value_t* kk = 0;
+	pointless_value_t kk;
+	uint32_t entry = 0;
 
 	// initalize iterator
 	pointless_hash_iter_state_t iter_state;
 	pointless_reader_set_iter_hash_init(p, set, hash, &iter_state);
 
 	// iterate
-	while (pointless_reader_set_iter_hash(p, set, hash, &kk, &iter_state)) {
-		if ((*cb_k)(p, kk, user_k))
+	while (pointless_reader_set_iter_hash_entry(p, set, hash, &entry, &iter_state)) {
+		if (pointless_get_entry(p, pointless_set_key_vector(p, set), entry, &kk) && (*cb_k)(p, &kk, user_k))
 			return 1;
 	}
 
@@ -144,40 +181,14 @@ static int pointless_get_set_(pointless_t* p, pointless_value_t* set, uint32_t h
 
 int pointless_get_mapping_string_to_u32(pointless_t* p, pointless_value_t* map, char* key, uint32_t* value)
 {
-	uint32_t hash = 0;
-
-	switch (p->header->version) {
-		case POINTLESS_FF_VERSION_OFFSET_32_OLDHASH:
-			hash = pointless_hash_string_v0_32((uint8_t*)key);
-			break;
-		case POINTLESS_FF_VERSION_OFFSET_32_NEWHASH:
-		case POINTLESS_FF_VERSION_OFFSET_64_NEWHASH:
-			hash = pointless_hash_string_v1_32((uint8_t*)key);
-			break;
-		default:
-			assert(0);
-			break;
-	}
+	uint32_t hash = pointless_hash_string_32(p->version, (uint8_t*)key);
 
 	return pointless_get_map_(p, map, hash, check_string, (void*)key, check_and_get_u32, 0, (void*)value);
 }
 
 int pointless_get_mapping_string_to_i64(pointless_t* p, pointless_value_t* map, char* key, int64_t* value)
 {
-	uint32_t hash = 0;
-
-	switch (p->header->version) {
-		case POINTLESS_FF_VERSION_OFFSET_32_OLDHASH:
-			hash = pointless_hash_string_v0_32((uint8_t*)key);
-			break;
-		case POINTLESS_FF_VERSION_OFFSET_32_NEWHASH:
-		case POINTLESS_FF_VERSION_OFFSET_64_NEWHASH:
-			hash = pointless_hash_string_v1_32((uint8_t*)key);
-			break;
-		default:
-			assert(0);
-			break;
-	}
+	uint32_t hash = pointless_hash_string_32(p->version, (uint8_t*)key);
 
 	return pointless_get_map_(p, map, hash, check_string, (void*)key, check_and_get_i64, 0, (void*)value);
 }
@@ -301,40 +312,14 @@ int pointless_get_mapping_string_to_vector_value(pointless_t* p, pointless_value
 
 int pointless_get_mapping_string_to_value(pointless_t* p, pointless_value_t* map, char* key, pointless_value_t* value)
 {
-	uint32_t hash = 0;
-
-	switch (p->header->version) {
-		case POINTLESS_FF_VERSION_OFFSET_32_OLDHASH:
-			hash = pointless_hash_string_v0_32((uint8_t*)key);
-			break;
-		case POINTLESS_FF_VERSION_OFFSET_32_NEWHASH:
-		case POINTLESS_FF_VERSION_OFFSET_64_NEWHASH:
-			hash = pointless_hash_string_v1_32((uint8_t*)key);
-			break;
-		default:
-			assert(0);
-			break;
-	}
+	uint32_t hash = pointless_hash_string_32(p->version, (uint8_t*)key);
 
 	return pointless_get_map_(p, map, hash, check_string, (void*)key, get_value, 0, (void*)value);
 }
 
 int pointless_get_mapping_string_n_to_value(pointless_t* p, pointless_value_t* map, char* key, size_t n, pointless_value_t* value)
 {
-	uint32_t hash = 0;
-
-	switch (p->header->version) {
-		case POINTLESS_FF_VERSION_OFFSET_32_OLDHASH:
-			hash = pointless_hash_string_v0_32_((uint8_t*)key, n);
-			break;
-		case POINTLESS_FF_VERSION_OFFSET_32_NEWHASH:
-		case POINTLESS_FF_VERSION_OFFSET_64_NEWHASH:
-			hash = pointless_hash_string_v1_32_((uint8_t*)key, n);
-			break;
-		default:
-			assert(0);
-			break;
-	}
+	uint32_t hash = pointless_hash_string_32_(p->version, (uint8_t*)key, n);
 
 
 	check_string_n_t user;
@@ -346,40 +331,14 @@ int pointless_get_mapping_string_n_to_value(pointless_t* p, pointless_value_t* m
 
 int pointless_get_mapping_unicode_to_value(pointless_t* p, pointless_value_t* map, uint32_t* key, pointless_value_t* value)
 {
-	uint32_t hash = 0;
-
-	switch (p->header->version) {
-		case POINTLESS_FF_VERSION_OFFSET_32_OLDHASH:
-			hash = pointless_hash_string_v0_32((uint8_t*)key);
-			break;
-		case POINTLESS_FF_VERSION_OFFSET_32_NEWHASH:
-		case POINTLESS_FF_VERSION_OFFSET_64_NEWHASH:
-			hash = pointless_hash_string_v1_32((uint8_t*)key);
-			break;
-		default:
-			assert(0);
-			break;
-	}
+	uint32_t hash = pointless_hash_unicode_ucs4_32(p->version, key);
 
 	return pointless_get_map_(p, map, hash, check_unicode, (void*)key, get_value, 0, (void*)value);
 }
 
 int pointless_get_mapping_unicode_to_u32(pointless_t* p, pointless_value_t* map, uint32_t* key, uint32_t* value)
 {
-	uint32_t hash = 0;
-
-	switch (p->header->version) {
-		case POINTLESS_FF_VERSION_OFFSET_32_OLDHASH:
-			hash = pointless_hash_string_v0_32((uint8_t*)key);
-			break;
-		case POINTLESS_FF_VERSION_OFFSET_32_NEWHASH:
-		case POINTLESS_FF_VERSION_OFFSET_64_NEWHASH:
-			hash = pointless_hash_string_v1_32((uint8_t*)key);
-			break;
-		default:
-			assert(0);
-			break;
-	}
+	uint32_t hash = pointless_hash_unicode_ucs4_32(p->version, key);
 
 	return pointless_get_map_(p, map, hash, check_unicode, (void*)key, check_and_get_u32, 0, (void*)value);
 }
@@ -387,20 +346,7 @@ int pointless_get_mapping_unicode_to_u32(pointless_t* p, pointless_value_t* map,
 
 static int pointless_get_mapping_string_to_value_type(pointless_t* p, pointless_value_t* map, char* key, pointless_value_t* value, uint32_t type)
 {
-	uint32_t hash = 0;
-
-	switch (p->header->version) {
-		case POINTLESS_FF_VERSION_OFFSET_32_OLDHASH:
-			hash = pointless_hash_string_v0_32((uint8_t*)key);
-			break;
-		case POINTLESS_FF_VERSION_OFFSET_32_NEWHASH:
-		case POINTLESS_FF_VERSION_OFFSET_64_NEWHASH:
-			hash = pointless_hash_string_v1_32((uint8_t*)key);
-			break;
-		default:
-			assert(0);
-			break;
-	}
+	uint32_t hash = pointless_hash_string_32(p->version, (uint8_t*)key);
 
 	pointless_value_t v;
 
@@ -454,21 +400,20 @@ int pointless_has_same_keys_set_map(pointless_t* p, pointless_value_t* s, pointl
 		return 0;
 
 	// we do two iterations, and then do a query in the other data structure
-	uint32_t iter_state;
-	pointless_value_t* kk = 0;
-	pointless_value_t* vv = 0;
+	uint32_t iter_state, entry = 0;
+	pointless_value_t kk;
 
 	iter_state = 0;
 
-	while (pointless_reader_set_iter(p, s, &kk, &iter_state)) {
-		if (!pointless_is_in_map_acyclic(p, m, kk))
+	while (pointless_reader_set_iter_entry(p, s, &entry, &iter_state)) {
+		if (!pointless_get_entry(p, pointless_set_key_vector(p, s), entry, &kk) || !pointless_is_in_map_acyclic(p, m, &kk))
 			return 0;
 	}
 
 	iter_state = 0;
 
-	while (pointless_reader_map_iter(p, m, &kk, &vv, &iter_state)) {
-		if (!pointless_is_in_set_acyclic(p, s, kk))
+	while (pointless_reader_map_iter_entry(p, m, &entry, &iter_state)) {
+		if (!pointless_get_map_key(p, m, entry, &kk) || !pointless_is_in_set_acyclic(p, s, &kk))
 			return 0;
 	}
 
@@ -485,21 +430,20 @@ int pointless_has_same_keys_map_map(pointless_t* p, pointless_value_t* m_a, poin
 		return 0;
 
 	// we do two iterations, and then do a query in the other data structure
-	uint32_t iter_state;
-	pointless_value_t* kk = 0;
-	pointless_value_t* vv = 0;
+	uint32_t iter_state, entry = 0;
+	pointless_value_t kk;
 
 	iter_state = 0;
 
-	while (pointless_reader_map_iter(p, m_a, &kk, &vv, &iter_state)) {
-		if (!pointless_is_in_map_acyclic(p, m_b, kk))
+	while (pointless_reader_map_iter_entry(p, m_a, &entry, &iter_state)) {
+		if (!pointless_get_map_key(p, m_a, entry, &kk) || !pointless_is_in_map_acyclic(p, m_b, &kk))
 			return 0;
 	}
 
 	iter_state = 0;
 
-	while (pointless_reader_map_iter(p, m_b, &kk, &vv, &iter_state)) {
-		if (!pointless_is_in_map_acyclic(p, m_a, kk))
+	while (pointless_reader_map_iter_entry(p, m_b, &entry, &iter_state)) {
+		if (!pointless_get_map_key(p, m_b, entry, &kk) || !pointless_is_in_map_acyclic(p, m_a, &kk))
 			return 0;
 	}
 
@@ -512,7 +456,7 @@ int pointless_is_in_set_acyclic(pointless_t* p, pointless_value_t* s, pointless_
 	uint32_t hash = pointless_hash_reader_32(p, k);
 
 	// start the iteration
-	pointless_value_t* kk = 0;
+	uint32_t entry = 0;
 
 	pointless_complete_value_t _k = pointless_value_to_complete(k);
 	pointless_complete_value_t _kk;
@@ -520,8 +464,8 @@ int pointless_is_in_set_acyclic(pointless_t* p, pointless_value_t* s, pointless_
 	pointless_hash_iter_state_t iter_state;
 	pointless_reader_set_iter_hash_init(p, s, hash, &iter_state);
 
-	while (pointless_reader_set_iter_hash(p, s, hash, &kk, &iter_state)) {
-		_kk = pointless_value_to_complete(kk);
+	while (pointless_reader_set_iter_hash_entry(p, s, hash, &entry, &iter_state)) {
+		_kk = pointless_reader_vector_value_case(p, pointless_set_key_vector(p, s), entry);
 
 		if (pointless_cmp_reader_acyclic(p, &_kk, p, &_k) == 0)
 			return 1;
@@ -536,8 +480,7 @@ int pointless_is_in_map_acyclic(pointless_t* p, pointless_value_t* m, pointless_
 	uint32_t hash = pointless_hash_reader_32(p, k);
 
 	// start the iteration
-	pointless_value_t* kk = 0;
-	pointless_value_t* vv = 0;
+	uint32_t entry = 0;
 
 	pointless_complete_value_t _k = pointless_value_to_complete(k);
 	pointless_complete_value_t _kk;
@@ -545,8 +488,8 @@ int pointless_is_in_map_acyclic(pointless_t* p, pointless_value_t* m, pointless_
 	pointless_hash_iter_state_t iter_state;
 	pointless_reader_map_iter_hash_init(p, m, hash, &iter_state);
 
-	while (pointless_reader_map_iter_hash(p, m, hash, &kk, &vv, &iter_state)) {
-		_kk = pointless_value_to_complete(kk);
+	while (pointless_reader_map_iter_hash_entry(p, m, hash, &entry, &iter_state)) {
+		_kk = pointless_reader_map_key(p, m, entry);
 		if (pointless_cmp_reader_acyclic(p, &_kk, p, &_k) == 0)
 			return 1;
 	}
@@ -14,6 +14,9 @@ typedef struct {
 	uint32_t* bitvector_r_c_mapping;
 	uint32_t* set_r_c_mapping;
 	uint32_t* map_r_c_mapping;
+
+	// compressed strings are decoded here, the create functions copy them
+	uint8_t string_buffer[POINTLESS_STRING_SYMBOLS_BUFFER_LEN];
 } pointless_recreate_state_t;
 
 static uint32_t* pointless_malloc_uint32_init(uint32_t n_items, uint32_t init_value)
@@ -51,10 +54,13 @@ if (handle == POINTLESS_CREATE_VALUE_FAIL) {\
 	return POINTLESS_CREATE_VALUE_FAIL;\
 }
 
-static uint32_t pointless_recreate_convert_rec(pointless_recreate_state_t* state, pointless_value_t* v, uint32_t depth)
+static uint32_t pointless_recreate_entry(pointless_recreate_state_t* state, pointless_value_t* vector, uint32_t entry, uint32_t depth);
+static uint32_t pointless_recreate_number(pointless_recreate_state_t* state, pointless_complete_value_t v);
+
+// the create-time handle of a read-time container, UINT32_MAX if it has not been created
+static uint32_t pointless_recreate_mapped_handle(pointless_recreate_state_t* state, pointless_value_t* v)
 {
-	// in case of cycles, return the previously created create-time handle
-	uint32_t handle = UINT32_MAX, child_handle = UINT32_MAX, key_handle = UINT32_MAX, value_handle = UINT32_MAX;
+	pointless_header_t* header = state->p->header;
 
 	switch (v->type) {
 		case POINTLESS_VECTOR_VALUE:
@@ -68,32 +74,49 @@ static uint32_t pointless_recreate_convert_rec(pointless_recreate_state_t* state
 		case POINTLESS_VECTOR_I64:
 		case POINTLESS_VECTOR_U64:
 		case POINTLESS_VECTOR_FLOAT:
-			handle = state->vector_r_c_mapping[v->data.data_u32];
+		case POINTLESS_VECTOR_DICTIONARY:
+		case POINTLESS_VECTOR_RUNS:
+		case POINTLESS_VECTOR_SPLIT:
+		case POINTLESS_VECTOR_BLOCKS:
+		case POINTLESS_TABLE:
+			if (v->data.data_u32 < header->n_vector)
+				return state->vector_r_c_mapping[v->data.data_u32];
 			break;
 		case POINTLESS_UNICODE_:
 		case POINTLESS_STRING_:
-			handle = state->string_unicode_r_c_mapping[v->data.data_u32];
+		case POINTLESS_STRING_SYMBOLS:
+			if (v->data.data_u32 < header->n_string_unicode)
+				return state->string_unicode_r_c_mapping[v->data.data_u32];
 			break;
 		case POINTLESS_BITVECTOR:
-			handle = state->bitvector_r_c_mapping[v->data.data_u32];
+			if (v->data.data_u32 < header->n_bitvector)
+				return state->bitvector_r_c_mapping[v->data.data_u32];
 			break;
 		case POINTLESS_SET_VALUE:
-			handle = state->set_r_c_mapping[v->data.data_u32];
+			if (v->data.data_u32 < header->n_set)
+				return state->set_r_c_mapping[v->data.data_u32];
 			break;
 		case POINTLESS_MAP_VALUE_VALUE:
-			handle = state->map_r_c_mapping[v->data.data_u32];
+			if (v->data.data_u32 < header->n_map)
+				return state->map_r_c_mapping[v->data.data_u32];
 			break;
 	}
 
+	return UINT32_MAX;
+}
+
+static uint32_t pointless_recreate_convert_rec(pointless_recreate_state_t* state, pointless_value_t* v, uint32_t depth)
+{
+	// in case of cycles, return the previously created create-time handle
+	uint32_t handle = pointless_recreate_mapped_handle(state, v), child_handle = UINT32_MAX, key_handle = UINT32_MAX, value_handle = UINT32_MAX;
+
 	if (handle != UINT32_MAX)
 		return handle;
 
 	handle = POINTLESS_CREATE_VALUE_FAIL;
 
-	uint32_t n_items = 0, i = 0, n_bits = 0;
+	uint32_t n_items = 0, i = 0, n_bits = 0, entry = 0;
 	pointless_value_t* child_v = 0;
-	pointless_value_t* key = 0;
-	pointless_value_t* value = 0;
 	void* bits = 0;
 	void* source_bits = 0;
 
@@ -162,6 +185,27 @@ static uint32_t pointless_recreate_convert_rec(pointless_recreate_state_t* state
 		case POINTLESS_VECTOR_FLOAT:
 			POINTLESS_RECREATE_FUNC_3(pointless_create_vector_float_owner, state->c, pointless_reader_vector_float(state->p, v), n_items);
 			state->vector_r_c_mapping[v->data.data_u32] = handle;
+			return handle;
+		// encoded vectors are decoded into value vectors
+		case POINTLESS_VECTOR_DICTIONARY:
+		case POINTLESS_VECTOR_RUNS:
+		case POINTLESS_VECTOR_SPLIT:
+		case POINTLESS_VECTOR_BLOCKS:
+			POINTLESS_RECREATE_FUNC_1(pointless_create_vector_value, state->c);
+			state->vector_r_c_mapping[v->data.data_u32] = handle;
+
+			for (i = 0; i < n_items; i++) {
+				child_handle = pointless_recreate_entry(state, v, i, depth + 1);
+
+				if (child_handle == POINTLESS_CREATE_VALUE_FAIL)
+					return POINTLESS_CREATE_VALUE_FAIL;
+
+				if (pointless_create_vector_value_append(state->c, handle, child_handle) == POINTLESS_CREATE_VALUE_FAIL) {
+					*state->error = "pointless_create_vector_value_append() failure";
+					return POINTLESS_CREATE_VALUE_FAIL;
+				}
+			}
+
 			return handle;
 		case POINTLESS_VECTOR_EMPTY:
 			POINTLESS_RECREATE_FUNC_1(pointless_create_vector_value, state->c);
@@ -175,11 +219,18 @@ static uint32_t pointless_recreate_convert_rec(pointless_recreate_state_t* state
 				*state->error = "out of memory";
 			return handle;
 		case POINTLESS_STRING_:
-			POINTLESS_RECREATE_FUNC_2(pointless_create_string_ascii, state->c, pointless_reader_string_value_ascii(state->p, v));
+		case POINTLESS_STRING_SYMBOLS:
+			POINTLESS_RECREATE_FUNC_2(pointless_create_string_ascii, state->c, pointless_reader_string_value_ascii_buffer(state->p, v, state->string_buffer));
 			state->string_unicode_r_c_mapping[v->data.data_u32] = handle;
 			if (handle == POINTLESS_CREATE_VALUE_FAIL)
 				*state->error = "out of memory";
 			return handle;
+		case POINTLESS_STRING_INLINE:
+			// inline strings have no heap data, and are not mapped
+			POINTLESS_RECREATE_FUNC_2(pointless_create_string_ascii, state->c, pointless_reader_string_value_ascii(state->p, v));
+			if (handle == POINTLESS_CREATE_VALUE_FAIL)
+				*state->error = "out of memory";
+			return handle;
 		case POINTLESS_BITVECTOR_0:
 		case POINTLESS_BITVECTOR_1:
 		case POINTLESS_BITVECTOR_01:
@@ -224,8 +275,8 @@ static uint32_t pointless_recreate_convert_rec(pointless_recreate_state_t* state
 
 			i = 0;
 
-			while (pointless_reader_set_iter(state->p, v, &key, &i)) {
-				key_handle = pointless_recreate_convert_rec(state, key, depth + 1);
+			while (pointless_reader_set_iter_entry(state->p, v, &entry, &i)) {
+				key_handle = pointless_recreate_entry(state, pointless_set_key_vector(state->p, v), entry, depth + 1);
 
 				if (key_handle == POINTLESS_CREATE_VALUE_FAIL)
 					return POINTLESS_CREATE_VALUE_FAIL;
@@ -243,13 +294,16 @@ static uint32_t pointless_recreate_convert_rec(pointless_recreate_state_t* state
 
 			i = 0;
 
-			while (pointless_reader_map_iter(state->p, v, &key, &value, &i)) {
-				key_handle = pointless_recreate_convert_rec(state, key, depth + 1);
+			while (pointless_reader_map_iter_entry(state->p, v, &entry, &i)) {
+				if (pointless_reader_map_is_dense(state->p, v))
+					key_handle = pointless_recreate_number(state, pointless_reader_map_key(state->p, v, entry));
+				else
+					key_handle = pointless_recreate_entry(state, pointless_map_key_vector(state->p, v), entry, depth + 1);
 
 				if (key_handle == POINTLESS_CREATE_VALUE_FAIL)
 					return POINTLESS_CREATE_VALUE_FAIL;
 
-				value_handle = pointless_recreate_convert_rec(state, value, depth + 1);
+				value_handle = pointless_recreate_entry(state, pointless_map_value_vector(state->p, v), entry, depth + 1);
 
 				if (value_handle == POINTLESS_CREATE_VALUE_FAIL)
 					return POINTLESS_CREATE_VALUE_FAIL;
@@ -260,6 +314,31 @@ static uint32_t pointless_recreate_convert_rec(pointless_recreate_state_t* state
 				}
 			}
 
+			return handle;
+		case POINTLESS_TABLE:
+			key_handle = pointless_recreate_convert_rec(state, pointless_reader_table_keys(state->p, v), depth + 1);
+
+			if (key_handle == POINTLESS_CREATE_VALUE_FAIL)
+				return POINTLESS_CREATE_VALUE_FAIL;
+
+			POINTLESS_RECREATE_FUNC_3(pointless_create_table, state->c, pointless_reader_table_n_rows(state->p, v), key_handle);
+			state->vector_r_c_mapping[v->data.data_u32] = handle;
+
+			n_items = pointless_reader_table_n_columns(state->p, v);
+			child_v = pointless_reader_table_columns(state->p, v);
+
+			for (i = 0; i < n_items; i++) {
+				child_handle = pointless_recreate_convert_rec(state, &child_v[i], depth + 1);
+
+				if (child_handle == POINTLESS_CREATE_VALUE_FAIL)
+					return POINTLESS_CREATE_VALUE_FAIL;
+
+				if (pointless_create_table_add_column(state->c, handle, child_handle) == POINTLESS_CREATE_VALUE_FAIL) {
+					*state->error = "pointless_create_table_add_column() failure";
+					return POINTLESS_CREATE_VALUE_FAIL;
+				}
+			}
+
 			return handle;
 		case POINTLESS_EMPTY_SLOT:
 			POINTLESS_RECREATE_FUNC_1(pointless_create_empty_slot, state->c);
@@ -289,42 +368,102 @@ static uint32_t pointless_recreate_convert_rec(pointless_recreate_state_t* state
 	return POINTLESS_CREATE_VALUE_FAIL;
 }
 
-uint32_t pointless_recreate_value(pointless_t* p_in, pointless_value_t* v_in, pointless_create_t* c_out, const char** error)
+// a set/map key or value, the key/value vectors may be primitive vectors
+// numbers from primitive vectors and dense map keys
+static uint32_t pointless_recreate_number(pointless_recreate_state_t* state, pointless_complete_value_t v)
 {
-	pointless_recreate_state_t state;
-	uint32_t handle = POINTLESS_CREATE_VALUE_FAIL;
+	uint32_t handle = UINT32_MAX;
+
+	switch (v.type) {
+		case POINTLESS_I32:
+			POINTLESS_RECREATE_FUNC_2(pointless_create_i32, state->c, v.complete_data.data_i32);
+			return handle;
+		case POINTLESS_U32:
+			POINTLESS_RECREATE_FUNC_2(pointless_create_u32, state->c, v.complete_data.data_u32);
+			return handle;
+		case POINTLESS_I64:
+			POINTLESS_RECREATE_FUNC_2(pointless_create_i64, state->c, v.complete_data.data_i64);
+			return handle;
+		case POINTLESS_U64:
+			POINTLESS_RECREATE_FUNC_2(pointless_create_u64, state->c, v.complete_data.data_u64);
+			return handle;
+		case POINTLESS_FLOAT:
+			POINTLESS_RECREATE_FUNC_2(pointless_create_float, state->c, v.complete_data.data_f);
+			return handle;
+	}
 
-	state.p = p_in;
-	state.c = c_out;
+	*state->error = "unknown type";
+	return POINTLESS_CREATE_VALUE_FAIL;
+}
+
+static uint32_t pointless_recreate_entry(pointless_recreate_state_t* state, pointless_value_t* vector, uint32_t entry, uint32_t depth)
+{
+	if (vector->type == POINTLESS_VECTOR_VALUE || vector->type == POINTLESS_VECTOR_VALUE_HASHABLE)
+		return pointless_recreate_convert_rec(state, &pointless_reader_vector_value(state->p, vector)[entry], depth);
+
+	pointless_complete_value_t v = pointless_reader_vector_value_case(state->p, vector, entry);
+	pointless_value_t _v;
+
+	// the items of encoded vectors are not only numbers
+	switch (v.type) {
+		case POINTLESS_UNICODE_:
+		case POINTLESS_STRING_:
+		case POINTLESS_STRING_INLINE:
+		case POINTLESS_STRING_SYMBOLS:
+		case POINTLESS_BOOLEAN:
+		case POINTLESS_NULL:
+			_v = pointless_value_from_complete(&v);
+			return pointless_recreate_convert_rec(state, &_v, depth);
+	}
+
+	return pointless_recreate_number(state, v);
+}
+
+static int pointless_recreate_state_init(pointless_recreate_state_t* state, pointless_t* p_in, pointless_create_t* c_out, const char** error)
+{
+	state->p = p_in;
+	state->c = c_out;
 
-	state.error = error;
+	state->error = error;
 
-	state.string_unicode_r_c_mapping = pointless_malloc_uint32_init(p_in->header->n_string_unicode, UINT32_MAX);
-	state.vector_r_c_mapping = pointless_malloc_uint32_init(p_in->header->n_vector, UINT32_MAX);
-	state.bitvector_r_c_mapping = pointless_malloc_uint32_init(p_in->header->n_bitvector, UINT32_MAX);
-	state.set_r_c_mapping = pointless_malloc_uint32_init(p_in->header->n_set, UINT32_MAX);
-	state.map_r_c_mapping = pointless_malloc_uint32_init(p_in->header->n_map, UINT32_MAX);
-	state.normalize_bitvector = 1;
+	state->string_unicode_r_c_mapping = pointless_malloc_uint32_init(p_in->header->n_string_unicode, UINT32_MAX);
+	state->vector_r_c_mapping = pointless_malloc_uint32_init(p_in->header->n_vector, UINT32_MAX);
+	state->bitvector_r_c_mapping = pointless_malloc_uint32_init(p_in->header->n_bitvector, UINT32_MAX);
+	state->set_r_c_mapping = pointless_malloc_uint32_init(p_in->header->n_set, UINT32_MAX);
+	state->map_r_c_mapping = pointless_malloc_uint32_init(p_in->header->n_map, UINT32_MAX);
+	state->normalize_bitvector = 1;
 
-	if (state.string_unicode_r_c_mapping == 0 || state.vector_r_c_mapping == 0 || state.bitvector_r_c_mapping == 0) {
+	if (state->string_unicode_r_c_mapping == 0 || state->vector_r_c_mapping == 0 || state->bitvector_r_c_mapping == 0) {
 		*error = "out of memory";
-		goto error;
+		return 0;
 	}
 
-	if (state.set_r_c_mapping == 0 || state.map_r_c_mapping == 0) {
+	if (state->set_r_c_mapping == 0 || state->map_r_c_mapping == 0) {
 		*error = "out of memory";
-		goto error;
+		return 0;
 	}
 
-	handle = pointless_recreate_convert_rec(&state, v_in, 0);
+	return 1;
+}
 
-error:
+static void pointless_recreate_state_destroy(pointless_recreate_state_t* state)
+{
+	pointless_free(state->string_unicode_r_c_mapping);
+	pointless_free(state->vector_r_c_mapping);
+	pointless_free(state->bitvector_r_c_mapping);
+	pointless_free(state->set_r_c_mapping);
+	pointless_free(state->map_r_c_mapping);
+}
 
-	pointless_free(state.string_unicode_r_c_mapping);
-	pointless_free(state.vector_r_c_mapping);
-	pointless_free(state.bitvector_r_c_mapping);
-	pointless_free(state.set_r_c_mapping);
-	pointless_free(state.map_r_c_mapping);
+uint32_t pointless_recreate_value(pointless_t* p_in, pointless_value_t* v_in, pointless_create_t* c_out, const char** error)
+{
+	pointless_recreate_state_t state;
+	uint32_t handle = POINTLESS_CREATE_VALUE_FAIL;
+
+	if (pointless_recreate_state_init(&state, p_in, c_out, error))
+		handle = pointless_recreate_convert_rec(&state, v_in, 0);
+
+	pointless_recreate_state_destroy(&state);
 
 	return handle;
 }
@@ -374,3 +513,49 @@ int pointless_recreate_64(const char* fname_in, const char* fname_out, const cha
 {
 	return pointless_recreate_(fname_in, fname_out, error, 64);
 }
+
+int pointless_recreate_heap_order(const char* fname_in, const char* fname_out, uint32_t heap_order, pointless_value_t* trace, uint32_t n_trace, const char** error)
+{
+	pointless_t p;
+	pointless_create_t c;
+	pointless_recreate_state_t state;
+	uint32_t root = POINTLESS_CREATE_VALUE_FAIL, handle, i;
+
+	if (!pointless_open_f(&p, fname_in, 0, error))
+		return 0;
+
+	pointless_create_begin_auto(&c);
+	pointless_create_heap_order(&c, heap_order);
+
+	if (pointless_recreate_state_init(&state, &p, &c, error))
+		root = pointless_recreate_convert_rec(&state, pointless_root(&p), 0);
+
+	// traced values which are not in the output, such as those unreachable from the root, are ignored
+	for (i = 0; i < n_trace && root != POINTLESS_CREATE_VALUE_FAIL; i++) {
+		handle = pointless_recreate_mapped_handle(&state, &trace[i]);
+
+		if (handle != UINT32_MAX && !pointless_create_heap_order_trace(&c, &handle, 1)) {
+			*error = "out of memory";
+			root = POINTLESS_CREATE_VALUE_FAIL;
+		}
+	}
+
+	pointless_recreate_state_destroy(&state);
+
+	if (root == POINTLESS_CREATE_VALUE_FAIL) {
+		pointless_close(&p);
+		pointless_create_end(&c);
+		return 0;
+	}
+
+	pointless_create_set_root(&c, root);
+
+	if (!pointless_create_output_and_end_f(&c, fname_out, error)) {
+		pointless_close(&p);
+		pointless_create_end(&c);
+		return 0;
+	}
+
+	pointless_close(&p);
+	return 1;
+}
@@ -0,0 +1,347 @@
+#include <pointless/pointless_string_symbols.h>
+
+// while building, the codes of the sample are counted as pseudo codes, symbols first, then 256 + c for each
+// escaped character c
+#define POINTLESS_STRING_SYMBOLS_N_PSEUDO 512
+
+typedef struct {
+	uint8_t symbol[POINTLESS_STRING_SYMBOLS_SYMBOL_LEN];
+	uint32_t len;
+	uint64_t gain;
+} pointless_string_symbols_candidate_t;
+
+int pointless_string_symbols_init(pointless_t* p, const char** error)
+{
+	if (!(p->header->version & POINTLESS_FF_STRING_SYMBOLS))
+		return 1;
+
+	if (p->header->n_string_unicode == 0) {
+		*error = "symbol table missing";
+		return 0;
+	}
+
+	// the table is the last string, which need not be reachable from the root, so we check it here
+	uint64_t offset = PC_OFFSET(p, string_unicode_offsets, p->header->n_string_unicode - 1);
+
+	if (offset > p->heap_len || p->heap_len - offset < sizeof(uint32_t)) {
+		*error = "symbol table too large for heap";
+		return 0;
+	}
+
+	uint32_t* len = (uint32_t*)((char*)p->heap_ptr + offset);
+	uint8_t* s = (uint8_t*)(len + 1);
+
+	if (*len > POINTLESS_STRING_SYMBOLS_TABLE_LEN || p->heap_len - offset - sizeof(uint32_t) < (uint64_t)*len + 1) {
+		*error = "symbol table too large for heap";
+		return 0;
+	}
+
+	if (s[*len] != 0) {
+		*error = "missing end-of-string";
+		return 0;
+	}
+
+	pointless_string_symbols_t* t = (pointless_string_symbols_t*)pointless_calloc(1, sizeof(pointless_string_symbols_t));
+
+	if (t == 0) {
+		*error = "out of memory";
+		return 0;
+	}
+
+	uint32_t i = 0, j;
+
+	while (i < *len) {
+		uint32_t symbol_len = s[i];
+
+		if (symbol_len == 0 || symbol_len > POINTLESS_STRING_SYMBOLS_SYMBOL_LEN || symbol_len >= *len - i || t->n_symbols == POINTLESS_STRING_SYMBOLS_N_SYMBOLS) {
+			pointless_free(t);
+			*error = "invalid symbol table";
+			return 0;
+		}
+
+		for (j = 0; j < symbol_len; j++) {
+			if (s[i + 1 + j] == 0) {
+				pointless_free(t);
+				*error = "invalid symbol table";
+				return 0;
+			}
+		}
+
+		t->len[t->n_symbols] = (uint8_t)symbol_len;
+		memcpy(t->symbol[t->n_symbols], s + i + 1, symbol_len);
+		t->n_symbols += 1;
+		i += 1 + symbol_len;
+	}
+
+	p->string_symbols = t;
+	return 1;
+}
+
+void pointless_string_symbols_end(pointless_t* p)
+{
+	pointless_free(p->string_symbols);
+	p->string_symbols = 0;
+}
+
+uint32_t pointless_string_symbols_decode(pointless_string_symbols_t* t, const uint8_t* codes, uint32_t n_codes, uint8_t* buffer)
+{
+	uint32_t i, n = 0;
+
+	for (i = 0; i < n_codes; i++) {
+		uint32_t code = codes[i];
+
+		if (code == POINTLESS_STRING_SYMBOLS_ESCAPE) {
+			if (i + 1 == n_codes || codes[i + 1] == 0 || n == POINTLESS_STRING_SYMBOLS_MAX_LEN)
+				return UINT32_MAX;
+
+			buffer[n++] = codes[++i];
+			continue;
+		}
+
+		// the whole symbol is copied, the buffer has room for it
+		if (t->len[code] == 0 || n + t->len[code] > POINTLESS_STRING_SYMBOLS_MAX_LEN)
+			return UINT32_MAX;
+
+		memcpy(buffer + n, t->symbol[code], POINTLESS_STRING_SYMBOLS_SYMBOL_LEN);
+		n += t->len[code];
+	}
+
+	buffer[n] = 0;
+	return n;
+}
+
+// orders the codes by their first character, and the longest symbols first, for greedy matching
+static void pointless_string_symbols_index(pointless_string_symbols_t* t)
+{
+	uint16_t next[256];
+	uint32_t i, len;
+
+	memset(t->first, 0, sizeof(t->first));
+
+	for (i = 0; i < t->n_symbols; i++)
+		t->first[t->symbol[i][0] + 1] += 1;
+
+	for (i = 0; i < 256; i++) {
+		t->first[i + 1] += t->first[i];
+		next[i] = t->first[i];
+	}
+
+	for (len = POINTLESS_STRING_SYMBOLS_SYMBOL_LEN; len > 0; len--) {
+		for (i = 0; i < t->n_symbols; i++) {
+			if (t->len[i] == len)
+				t->by_first[next[t->symbol[i][0]]++] = (uint8_t)i;
+		}
+	}
+}
+
+// the code of the longest symbol 's' starts with, or POINTLESS_STRING_SYMBOLS_ESCAPE
+static uint32_t pointless_string_symbols_match(pointless_string_symbols_t* t, const uint8_t* s, uint32_t n)
+{
+	uint32_t i;
+
+	for (i = t->first[s[0]]; i < t->first[s[0] + 1]; i++) {
+		uint32_t code = t->by_first[i];
+
+		if (t->len[code] <= n && memcmp(t->symbol[code], s, t->len[code]) == 0)
+			return code;
+	}
+
+	return POINTLESS_STRING_SYMBOLS_ESCAPE;
+}
+
+uint32_t pointless_string_symbols_encode(pointless_string_symbols_t* t, const uint8_t* s, uint32_t len, uint8_t* codes)
+{
+	uint32_t i = 0, n = 0;
+
+	while (i < len) {
+		uint32_t code = pointless_string_symbols_match(t, s + i, len - i);
+		codes[n++] = (uint8_t)code;
+
+		if (code == POINTLESS_STRING_SYMBOLS_ESCAPE)
+			codes[n++] = s[i++];
+		else
+			i += t->len[code];
+	}
+
+	return n;
+}
+
+uint32_t pointless_string_symbols_serialize(pointless_string_symbols_t* t, uint8_t* buffer)
+{
+	uint32_t i, n = 0;
+
+	for (i = 0; i < t->n_symbols; i++) {
+		buffer[n++] = t->len[i];
+		memcpy(buffer + n, t->symbol[i], t->len[i]);
+		n += t->len[i];
+	}
+
+	buffer[n] = 0;
+	return n;
+}
+
+// pseudo code counts of a string compressed with the current table, and of each pair of adjacent pseudo codes
+static void pointless_string_symbols_count(pointless_string_symbols_t* t, const uint8_t* s, uint32_t len, uint32_t* count_1, uint32_t* count_2)
+{
+	uint32_t i = 0, prev = UINT32_MAX;
+
+	while (i < len) {
+		uint32_t code = pointless_string_symbols_match(t, s + i, len - i);
+		uint32_t pseudo = code;
+
+		if (code == POINTLESS_STRING_SYMBOLS_ESCAPE) {
+			pseudo = 256 + s[i];
+			i += 1;
+		} else {
+			i += t->len[code];
+		}
+
+		count_1[pseudo] += 1;
+
+		if (prev != UINT32_MAX)
+			count_2[prev * POINTLESS_STRING_SYMBOLS_N_PSEUDO + pseudo] += 1;
+
+		prev = pseudo;
+	}
+}
+
+static uint32_t pointless_string_symbols_pseudo(pointless_string_symbols_t* t, uint32_t pseudo, uint8_t* symbol)
+{
+	if (pseudo >= 256) {
+		symbol[0] = (uint8_t)(pseudo - 256);
+		return 1;
+	}
+
+	memcpy(symbol, t->symbol[pseudo], t->len[pseudo]);
+	return t->len[pseudo];
+}
+
+// keeps the POINTLESS_STRING_SYMBOLS_N_SYMBOLS candidates of the highest gain, in a min-heap
+static void pointless_string_symbols_offer(pointless_string_symbols_candidate_t* heap, uint32_t* n_heap, pointless_string_symbols_candidate_t* c)
+{
+	uint32_t i, child;
+
+	if (*n_heap < POINTLESS_STRING_SYMBOLS_N_SYMBOLS) {
+		i = (*n_heap)++;
+
+		while (i > 0 && heap[(i - 1) / 2].gain > c->gain) {
+			heap[i] = heap[(i - 1) / 2];
+			i = (i - 1) / 2;
+		}
+
+		heap[i] = *c;
+		return;
+	}
+
+	if (c->gain <= heap[0].gain)
+		return;
+
+	i = 0;
+
+	while ((child = 2 * i + 1) < *n_heap) {
+		if (child + 1 < *n_heap && heap[child + 1].gain < heap[child].gain)
+			child += 1;
+
+		if (heap[child].gain >= c->gain)
+			break;
+
+		heap[i] = heap[child];
+		i = child;
+	}
+
+	heap[i] = *c;
+}
+
+int pointless_string_symbols_build(pointless_string_symbols_t* t, uint8_t** strings, uint32_t* lens, uint32_t n_strings, const char** error)
+{
+	uint32_t* count_1 = (uint32_t*)pointless_calloc(POINTLESS_STRING_SYMBOLS_N_PSEUDO, sizeof(uint32_t));
+	uint32_t* count_2 = (uint32_t*)pointless_calloc(POINTLESS_STRING_SYMBOLS_N_PSEUDO * POINTLESS_STRING_SYMBOLS_N_PSEUDO, sizeof(uint32_t));
+	pointless_string_symbols_candidate_t* heap = (pointless_string_symbols_candidate_t*)pointless_malloc(POINTLESS_STRING_SYMBOLS_N_SYMBOLS * sizeof(pointless_string_symbols_candidate_t));
+
+	memset(t, 0, sizeof(*t));
+
+	if (count_1 == 0 || count_2 == 0 || heap == 0) {
+		pointless_free(count_1);
+		pointless_free(count_2);
+		pointless_free(heap);
+		*error = "out of memory";
+		return 0;
+	}
+
+	// the sample is every n-th string, about POINTLESS_STRING_SYMBOLS_SAMPLE_LEN characters in all
+	uint64_t n_chars = 0;
+	uint32_t i, j, a, b, round, n_heap, stride;
+
+	for (i = 0; i < n_strings; i++)
+		n_chars += lens[i];
+
+	stride = (uint32_t)(n_chars / POINTLESS_STRING_SYMBOLS_SAMPLE_LEN) + 1;
+
+	for (round = 0; round < POINTLESS_STRING_SYMBOLS_ROUNDS; round++) {
+		memset(count_1, 0, POINTLESS_STRING_SYMBOLS_N_PSEUDO * sizeof(uint32_t));
+		memset(count_2, 0, POINTLESS_STRING_SYMBOLS_N_PSEUDO * POINTLESS_STRING_SYMBOLS_N_PSEUDO * sizeof(uint32_t));
+
+		for (i = 0; i < n_strings; i += stride)
+			pointless_string_symbols_count(t, strings[i], lens[i], count_1, count_2);
+
+		// a symbol saves about its length for each of its codes
+		pointless_string_symbols_candidate_t c;
+		n_heap = 0;
+
+		for (a = 0; a < POINTLESS_STRING_SYMBOLS_N_PSEUDO; a++) {
+			if (count_1[a] == 0)
+				continue;
+
+			memset(c.symbol, 0, sizeof(c.symbol));
+			c.len = pointless_string_symbols_pseudo(t, a, c.symbol);
+			c.gain = (uint64_t)count_1[a] * c.len;
+			pointless_string_symbols_offer(heap, &n_heap, &c);
+
+			for (b = 0; b < POINTLESS_STRING_SYMBOLS_N_PSEUDO; b++) {
+				uint32_t n = count_2[a * POINTLESS_STRING_SYMBOLS_N_PSEUDO + b];
+				uint8_t symbol_b[POINTLESS_STRING_SYMBOLS_SYMBOL_LEN];
+
+				if (n == 0)
+					continue;
+
+				uint32_t len_b = pointless_string_symbols_pseudo(t, b, symbol_b);
+
+				if (c.len + len_b > POINTLESS_STRING_SYMBOLS_SYMBOL_LEN)
+					continue;
+
+				pointless_string_symbols_candidate_t cc = c;
+				memcpy(cc.symbol + c.len, symbol_b, len_b);
+				cc.len = c.len + len_b;
+				cc.gain = (uint64_t)n * cc.len;
+				pointless_string_symbols_offer(heap, &n_heap, &cc);
+			}
+		}
+
+		// the next table, a concatenation may equal another symbol
+		pointless_string_symbols_t next;
+		memset(&next, 0, sizeof(next));
+
+		for (i = 0; i < n_heap; i++) {
+			for (j = 0; j < next.n_symbols; j++) {
+				if (next.len[j] == heap[i].len && memcmp(next.symbol[j], heap[i].symbol, heap[i].len) == 0)
+					break;
+			}
+
+			if (j < next.n_symbols)
+				continue;
+
+			next.len[next.n_symbols] = (uint8_t)heap[i].len;
+			memcpy(next.symbol[next.n_symbols], heap[i].symbol, POINTLESS_STRING_SYMBOLS_SYMBOL_LEN);
+			next.n_symbols += 1;
+		}
+
+		*t = next;
+		pointless_string_symbols_index(t);
+	}
+
+	pointless_free(count_1);
+	pointless_free(count_2);
+	pointless_free(heap);
+
+	return 1;
+}
@@ -0,0 +1,390 @@
+#include <pointless/pointless_trace.h>
+
+typedef struct pointless_trace_s {
+	// a bit per container id, strings first, then vectors, bitvectors, sets and maps, as the offset vectors
+	uint32_t* touched;
+
+	// containers in order of first access, a type of POINTLESS_EMPTY_SLOT is a slot taken but not yet written
+	pointless_value_t* values;
+	uint64_t n_values_max;
+	uint64_t n_values;
+} pointless_trace_t;
+
+typedef struct pointless_prefetch_s {
+	pointless_t* p;
+	pointless_value_t* values;
+	uint32_t n_values;
+	uint64_t page_size;
+	volatile int stop;
+	pthread_t thread;
+} pointless_prefetch_t;
+
+typedef struct {
+	uint32_t magic;
+	uint32_t n_values;
+} pointless_trace_header_t;
+
+#define POINTLESS_TRACE_MAGIC 0x50544c50
+
+// container id of a value, and the heap offset of the container, 0 if the file has no such container
+static int pointless_trace_id(pointless_t* p, pointless_value_t* v, uint64_t* id, uint64_t* offset)
+{
+	pointless_header_t* h = p->header;
+	uint64_t base = 0;
+	uint32_t i = v->data.data_u32;
+
+	switch (v->type) {
+		case POINTLESS_UNICODE_:
+		case POINTLESS_STRING_:
+		case POINTLESS_STRING_SYMBOLS:
+			if (i >= h->n_string_unicode)
+				return 0;
+
+			*offset = PC_OFFSET(p, string_unicode_offsets, i);
+			break;
+		case POINTLESS_VECTOR_VALUE:
+		case POINTLESS_VECTOR_VALUE_HASHABLE:
+		case POINTLESS_VECTOR_I8:
+		case POINTLESS_VECTOR_U8:
+		case POINTLESS_VECTOR_I16:
+		case POINTLESS_VECTOR_U16:
+		case POINTLESS_VECTOR_I32:
+		case POINTLESS_VECTOR_U32:
+		case POINTLESS_VECTOR_I64:
+		case POINTLESS_VECTOR_U64:
+		case POINTLESS_VECTOR_FLOAT:
+			if (i >= h->n_vector)
+				return 0;
+
+			base = h->n_string_unicode;
+			*offset = PC_OFFSET(p, vector_offsets, i);
+			break;
+		case POINTLESS_BITVECTOR:
+			if (i >= h->n_bitvector)
+				return 0;
+
+			base = (uint64_t)h->n_string_unicode + h->n_vector;
+			*offset = PC_OFFSET(p, bitvector_offsets, i);
+			break;
+		case POINTLESS_SET_VALUE:
+			if (i >= h->n_set)
+				return 0;
+
+			base = (uint64_t)h->n_string_unicode + h->n_vector + h->n_bitvector;
+			*offset = PC_OFFSET(p, set_offsets, i);
+			break;
+		case POINTLESS_MAP_VALUE_VALUE:
+			if (i >= h->n_map)
+				return 0;
+
+			base = (uint64_t)h->n_string_unicode + h->n_vector + h->n_bitvector + h->n_set;
+			*offset = PC_OFFSET(p, map_offsets, i);
+			break;
+		default:
+			return 0;
+	}
+
+	*id = base + i;
+	return 1;
+}
+
+int pointless_trace_begin(pointless_t* p, uint64_t n_values_max, const char** error)
+{
+	if (p->trace) {
+		*error = "already tracing";
+		return 0;
+	}
+
+	pointless_header_t* h = p->header;
+	uint64_t n_ids = (uint64_t)h->n_string_unicode + h->n_vector + h->n_bitvector + h->n_set + h->n_map;
+
+	if (n_values_max == 0 || n_values_max > n_ids)
+		n_values_max = n_ids;
+
+	pointless_trace_t* t = (pointless_trace_t*)pointless_calloc(1, sizeof(pointless_trace_t));
+
+	if (t == 0) {
+		*error = "out of memory";
+		return 0;
+	}
+
+	// 1 item is allocated for the empty file, so that 0 means out of memory
+	t->touched = (uint32_t*)pointless_calloc(ICEIL(n_ids, 32) + 1, sizeof(uint32_t));
+	t->values = (pointless_value_t*)pointless_malloc((n_values_max + 1) * sizeof(pointless_value_t));
+	t->n_values_max = n_values_max;
+	t->n_values = 0;
+
+	if (t->touched == 0 || t->values == 0) {
+		pointless_free(t->touched);
+		pointless_free(t->values);
+		pointless_free(t);
+		*error = "out of memory";
+		return 0;
+	}
+
+	uint64_t i;
+
+	for (i = 0; i < n_values_max; i++)
+		t->values[i].type = POINTLESS_EMPTY_SLOT;
+
+	p->trace = t;
+	return 1;
+}
+
+void pointless_trace_touch(pointless_t* p, pointless_value_t* v)
+{
+	pointless_trace_t* t = p->trace;
+	uint64_t id = 0, offset = 0;
+
+	if (!pointless_trace_id(p, v, &id, &offset))
+		return;
+
+	uint32_t* word = &t->touched[id / 32];
+	uint32_t bit = (1u << (id % 32));
+
+	// the common case, the container has been recorded before
+	if (*(volatile uint32_t*)word & bit)
+		return;
+
+	// only one thread sets the bit, and only that one records the container
+	if (__sync_fetch_and_or(word, bit) & bit)
+		return;
+
+	uint64_t i = __sync_fetch_and_add(&t->n_values, 1);
+
+	if (i >= t->n_values_max)
+		return;
+
+	t->values[i].data.data_u32 = v->data.data_u32;
+	__sync_synchronize();
+	t->values[i].type = v->type;
+}
+
+void pointless_trace_end(pointless_t* p)
+{
+	if (p->trace == 0)
+		return;
+
+	pointless_free(p->trace->touched);
+	pointless_free(p->trace->values);
+	pointless_free(p->trace);
+	p->trace = 0;
+}
+
+int pointless_trace_write_f(pointless_t* p, const char* fname, const char** error)
+{
+	pointless_trace_t* t = p->trace;
+
+	if (t == 0) {
+		*error = "not tracing";
+		return 0;
+	}
+
+	uint64_t i, n = t->n_values;
+
+	if (n > t->n_values_max)
+		n = t->n_values_max;
+
+	// containers being recorded right now are left out
+	pointless_trace_header_t header;
+	header.magic = POINTLESS_TRACE_MAGIC;
+	header.n_values = 0;
+
+	for (i = 0; i < n; i++) {
+		if (t->values[i].type != POINTLESS_EMPTY_SLOT)
+			header.n_values += 1;
+	}
+
+	FILE* f = fopen(fname, "wb");
+
+	if (f == 0) {
+		*error = "error opening trace file";
+		return 0;
+	}
+
+	int ok = (fwrite(&header, sizeof(header), 1, f) == 1);
+
+	for (i = 0; ok && i < n; i++) {
+		if (t->values[i].type != POINTLESS_EMPTY_SLOT)
+			ok = (fwrite(&t->values[i], sizeof(pointless_value_t), 1, f) == 1);
+	}
+
+	if (fclose(f) != 0)
+		ok = 0;
+
+	if (!ok) {
+		*error = "error writing trace file";
+		return 0;
+	}
+
+	return 1;
+}
+
+int pointless_trace_read_f(const char* fname, pointless_value_t** values, uint32_t* n_values, const char** error)
+{
+	*values = 0;
+	*n_values = 0;
+
+	FILE* f = fopen(fname, "rb");
+
+	if (f == 0) {
+		*error = "error opening trace file";
+		return 0;
+	}
+
+	pointless_trace_header_t header;
+
+	if (fread(&header, sizeof(header), 1, f) != 1 || header.magic != POINTLESS_TRACE_MAGIC) {
+		fclose(f);
+		*error = "not a trace file";
+		return 0;
+	}
+
+	*values = (pointless_value_t*)pointless_malloc(((size_t)header.n_values + 1) * sizeof(pointless_value_t));
+
+	if (*values == 0) {
+		fclose(f);
+		*error = "out of memory";
+		return 0;
+	}
+
+	if (fread(*values, sizeof(pointless_value_t), header.n_values, f) != header.n_values) {
+		fclose(f);
+		pointless_free(*values);
+		*values = 0;
+		*error = "trace file is truncated";
+		return 0;
+	}
+
+	fclose(f);
+	*n_values = header.n_values;
+	return 1;
+}
+
+// heap range of a container, only its first byte if 'whole' is 0, clamped to the heap
+static int pointless_prefetch_range(pointless_t* p, pointless_value_t* v, int whole, uint64_t* begin, uint64_t* end)
+{
+	uint64_t id = 0;
+
+	if (!pointless_trace_id(p, v, &id, begin) || *begin + sizeof(uint32_t) > p->heap_len)
+		return 0;
+
+	*end = *begin + 1;
+
+	if (!whole)
+		return 1;
+
+	// every container starts with a 32-bit length or item count
+	uint64_t n = *(uint32_t*)((char*)p->heap_ptr + *begin);
+	uint64_t n_bytes = 0;
+
+	switch (v->type) {
+		case POINTLESS_UNICODE_:                 n_bytes = (n + 1) * sizeof(uint32_t);          break;
+		case POINTLESS_STRING_:                  n_bytes = (n + 1) * sizeof(uint8_t);           break;
+		case POINTLESS_STRING_SYMBOLS:           n_bytes = POINTLESS_STRING_SYMBOLS_N_CODES(n);  break;
+		case POINTLESS_VECTOR_VALUE:
+		case POINTLESS_VECTOR_VALUE_HASHABLE:    n_bytes = n * sizeof(pointless_value_t);       break;
+		case POINTLESS_VECTOR_I8:
+		case POINTLESS_VECTOR_U8:                n_bytes = n * sizeof(uint8_t);                 break;
+		case POINTLESS_VECTOR_I16:
+		case POINTLESS_VECTOR_U16:               n_bytes = n * sizeof(uint16_t);                break;
+		case POINTLESS_VECTOR_I32:
+		case POINTLESS_VECTOR_U32:
+		case POINTLESS_VECTOR_FLOAT:             n_bytes = n * sizeof(uint32_t);                break;
+		case POINTLESS_VECTOR_I64:
+		case POINTLESS_VECTOR_U64:               n_bytes = n * sizeof(uint64_t);                break;
+		case POINTLESS_BITVECTOR:                n_bytes = ICEIL(n, 8);                         break;
+		case POINTLESS_SET_VALUE:                n_bytes = sizeof(pointless_set_header_t) - 4;  break;
+		case POINTLESS_MAP_VALUE_VALUE:          n_bytes = sizeof(pointless_map_header_t) - 4;  break;
+	}
+
+	*end = *begin + sizeof(uint32_t) + n_bytes;
+
+	if (*end > p->heap_len)
+		*end = p->heap_len;
+
+	return 1;
+}
+
+static void* pointless_prefetch_thread(void* user)
+{
+	pointless_prefetch_t* f = (pointless_prefetch_t*)user;
+	pointless_t* p = f->p;
+	uint64_t heap_start = (uint64_t)((char*)p->heap_ptr - (char*)p->fd_ptr);
+	uint64_t begin = 0, end = 0;
+	uint32_t i;
+	int whole;
+
+	// the first page of every container before the rest of any, lookups mostly need only the headers
+	for (whole = 0; whole < 2; whole++) {
+		for (i = 0; i < f->n_values && !f->stop; i++) {
+			if (!pointless_prefetch_range(p, &f->values[i], whole, &begin, &end))
+				continue;
+
+			begin = (heap_start + begin) / f->page_size * f->page_size;
+			end = heap_start + end;
+
+			madvise((char*)p->fd_ptr + begin, end - begin, MADV_WILLNEED);
+		}
+	}
+
+	return 0;
+}
+
+int pointless_prefetch_f(pointless_t* p, const char* fname, const char** error)
+{
+	if (p->fd_ptr == 0) {
+		*error = "only mapped files can be prefetched";
+		return 0;
+	}
+
+	if (p->prefetch) {
+		*error = "already prefetching";
+		return 0;
+	}
+
+	pointless_prefetch_t* f = (pointless_prefetch_t*)pointless_calloc(1, sizeof(pointless_prefetch_t));
+
+	if (f == 0) {
+		*error = "out of memory";
+		return 0;
+	}
+
+	if (!pointless_trace_read_f(fname, &f->values, &f->n_values, error)) {
+		pointless_free(f);
+		return 0;
+	}
+
+	f->p = p;
+	f->page_size = (uint64_t)sysconf(_SC_PAGESIZE);
+	f->stop = 0;
+
+	if (pthread_create(&f->thread, 0, pointless_prefetch_thread, f) != 0) {
+		pointless_free(f->values);
+		pointless_free(f);
+		*error = "error starting prefetch thread";
+		return 0;
+	}
+
+	p->prefetch = f;
+	return 1;
+}
+
+void pointless_prefetch_wait(pointless_t* p)
+{
+	if (p->prefetch == 0)
+		return;
+
+	pthread_join(p->prefetch->thread, 0);
+	pointless_free(p->prefetch->values);
+	pointless_free(p->prefetch);
+	p->prefetch = 0;
+}
+
+void pointless_prefetch_stop(pointless_t* p)
+{
+	if (p->prefetch)
+		p->prefetch->stop = 1;
+
+	pointless_prefetch_wait(p);
+}
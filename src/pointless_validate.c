@@ -10,23 +10,63 @@ typedef struct {
 	void* map;
 } pointless_validate_state_t;
 
+// every key must pass the Bloom filter, otherwise lookups would miss it, 'keys' is 0 if there are no empty slots
+static int pointless_validate_bloom(pointless_validate_state_t* state, uint32_t bloom, uint32_t n_buckets, uint32_t* hashes, pointless_value_t* keys)
+{
+	if (bloom == 0)
+		return 1;
+
+	pointless_value_t vector;
+	vector.type = POINTLESS_VECTOR_U32;
+	vector.data.data_u32 = bloom - 1;
+
+	uint32_t* words = pointless_reader_vector_u32(state->context->p, &vector);
+	uint32_t i, n_words = pointless_reader_vector_n_items(state->context->p, &vector);
+
+	for (i = 0; i < n_buckets; i++) {
+		if ((keys == 0 || keys[i].type != POINTLESS_EMPTY_SLOT) && !pointless_hash_table_bloom_maybe_contains(words, n_words, hashes[i])) {
+			state->error = "Bloom filter does not contain a key";
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
 static int pointless_validate_set_complicated(pointless_validate_state_t* state, pointless_value_t* v)
 {
 	// get header
 	pointless_set_header_t* header = (pointless_set_header_t*)PC_HEAP_OFFSET(state->context->p, set_offsets, v->data.data_u32);
 
-	// vectors must have the same number of items
 	uint32_t n_hash = pointless_reader_vector_n_items(state->context->p, &header->hash_vector);
 	uint32_t n_keys = pointless_reader_vector_n_items(state->context->p, &header->key_vector);
 
+	uint32_t* hashes = pointless_reader_vector_u32(state->context->p, &header->hash_vector);
+
+	// compact layout
+	if (n_keys == header->n_items) {
+		if (!pointless_validate_bloom(state, header->bloom, n_keys, hashes, 0))
+			return 0;
+
+		return pointless_hash_table_validate_compact(state->context->p, n_keys, n_hash, hashes, &header->key_vector, &state->error);
+	}
+
+	// only the compact layout can have primitive key vectors
+	if (header->key_vector.type != POINTLESS_VECTOR_VALUE_HASHABLE) {
+		state->error = "set key vector not of type POINTLESS_VECTOR_VALUE_HASHABLE";
+		return 0;
+	}
+
+	pointless_value_t* keys = pointless_reader_vector_value(state->context->p, &header->key_vector);
+
+	// vectors must have the same number of items
 	if (n_hash != n_keys) {
 		state->error = "set hash and key vectors do not contain the same number of items";
 		return 0;
 	}
 
-	// get base pointers for both
-	uint32_t* hashes = pointless_reader_vector_u32(state->context->p, &header->hash_vector);
-	pointless_value_t* keys = pointless_reader_vector_value(state->context->p, &header->key_vector);
+	if (!pointless_validate_bloom(state, header->bloom, n_keys, hashes, keys))
+		return 0;
 
 	// at this stage, all items have been validated, all that is left is to test the hash-map invariants
 	return pointless_hash_table_validate(state->context->p, header->n_items, n_keys, hashes, keys, 0, &state->error);
@@ -38,26 +78,249 @@ static int pointless_validate_map_complicated(pointless_validate_state_t* state,
 	// get header
 	pointless_map_header_t* header = (pointless_map_header_t*)PC_HEAP_OFFSET(state->context->p, map_offsets, v->data.data_u32);
 
-	// vectors must have the same number of items
 	uint32_t n_hash = pointless_reader_vector_n_items(state->context->p, &header->hash_vector);
-	uint32_t n_keys = pointless_reader_vector_n_items(state->context->p, &header->key_vector);
 	uint32_t n_values = pointless_reader_vector_n_items(state->context->p, &header->value_vector);
 
+	uint32_t* hashes = pointless_reader_vector_u32(state->context->p, &header->hash_vector);
+
+	// dense layout, the heap check made sure it has no Bloom filter
+	if (header->key_vector.type == POINTLESS_I32 || header->key_vector.type == POINTLESS_U32)
+		return pointless_hash_table_validate_dense(state->context->p, header->n_items, &header->key_vector, n_hash, hashes, n_values, &state->error);
+
+	// vectors must have the same number of items
+	uint32_t n_keys = pointless_reader_vector_n_items(state->context->p, &header->key_vector);
+
+	// compact layout
+	if (n_keys == header->n_items) {
+		if (n_values != n_keys) {
+			state->error = "map key and value vectors do not contain the same number of items";
+			return 0;
+		}
+
+		if (!pointless_validate_bloom(state, header->bloom, n_keys, hashes, 0))
+			return 0;
+
+		return pointless_hash_table_validate_compact(state->context->p, n_keys, n_hash, hashes, &header->key_vector, &state->error);
+	}
+
+	// only the compact layout can have primitive key/value vectors
+	if (header->key_vector.type != POINTLESS_VECTOR_VALUE_HASHABLE) {
+		state->error = "map key vector not of type POINTLESS_VECTOR_VALUE_HASHABLE";
+		return 0;
+	}
+
+	if (header->value_vector.type != POINTLESS_VECTOR_VALUE_HASHABLE && header->value_vector.type != POINTLESS_VECTOR_VALUE) {
+		state->error = "map value vector not of type POINTLESS_VECTOR_VALUE or POINTLESS_VECTOR_VALUE_HASHABLE";
+		return 0;
+	}
+
+	pointless_value_t* keys = pointless_reader_vector_value(state->context->p, &header->key_vector);
+	pointless_value_t* values = pointless_reader_vector_value(state->context->p, &header->value_vector);
+
 	// (a == b && b == c) <=> !(a != b || b != c)
 	if (n_hash != n_keys || n_hash != n_values) {
 		state->error = "map hash, key and value vectors do not contain the same number of items";
 		return 0;
 	}
 
-	// get base pointers for both
-	uint32_t* hashes = pointless_reader_vector_u32(state->context->p, &header->hash_vector);
-	pointless_value_t* keys = pointless_reader_vector_value(state->context->p, &header->key_vector);
-	pointless_value_t* values = pointless_reader_vector_value(state->context->p, &header->value_vector);
+	if (!pointless_validate_bloom(state, header->bloom, n_keys, hashes, keys))
+		return 0;
 
 	// at this stage, all items have been validated, all that is left is to test the hash-map invariants
 	return pointless_hash_table_validate(state->context->p, header->n_items, n_keys, hashes, keys, values, &state->error);
 }
 
+static int pointless_validate_table_complicated(pointless_validate_state_t* state, pointless_value_t* v)
+{
+	// at this stage, keys and columns have been validated, so we can look at their lengths
+	uint32_t i, n_rows = pointless_reader_table_n_rows(state->context->p, v);
+	uint32_t n_columns = pointless_reader_table_n_columns(state->context->p, v);
+	pointless_value_t* columns = pointless_reader_table_columns(state->context->p, v);
+
+	if (pointless_reader_vector_n_items(state->context->p, pointless_reader_table_keys(state->context->p, v)) != n_columns) {
+		state->error = "table does not have exactly one column per key";
+		return 0;
+	}
+
+	for (i = 0; i < n_columns; i++) {
+		if (pointless_reader_vector_n_items(state->context->p, &columns[i]) != n_rows) {
+			state->error = "table column does not have one item per row";
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static int pointless_validate_split_vector_complicated(pointless_validate_state_t* state, pointless_value_t* v)
+{
+	// at this stage, types and data have been validated, but not the items they make up
+	pointless_t* p = state->context->p;
+	uint32_t i, n_types = pointless_reader_vector_n_items(p, pointless_reader_split_vector_types(p, v));
+	uint32_t n_items = pointless_reader_vector_n_items(p, pointless_reader_split_vector_data(p, v));
+
+	if (n_types != 1 && n_types != n_items) {
+		state->error = "split vector does not have a single type or one type per item";
+		return 0;
+	}
+
+	for (i = 0; i < n_items; i++) {
+		pointless_complete_value_t item = pointless_reader_vector_value_case(p, v, i);
+		pointless_value_t _item = pointless_value_from_complete(&item);
+
+		switch (_item.type) {
+			case POINTLESS_UNICODE_:
+			case POINTLESS_STRING_:
+			case POINTLESS_STRING_INLINE:
+			case POINTLESS_STRING_SYMBOLS:
+			case POINTLESS_I32:
+			case POINTLESS_U32:
+			case POINTLESS_FLOAT:
+			case POINTLESS_BOOLEAN:
+			case POINTLESS_NULL:
+				break;
+			default:
+				state->error = "split vector item is not a string, a 32-bit number, a boolean or a NULL";
+				return 0;
+		}
+
+		if (!pointless_validate_heap_ref(state->context, &_item, &state->error))
+			return 0;
+
+		if (!pointless_validate_inline_invariants(state->context, &_item, &state->error))
+			return 0;
+
+		if (!pointless_validate_heap_value(state->context, &_item, &state->error))
+			return 0;
+	}
+
+	return 1;
+}
+
+static int pointless_validate_block_vector_complicated(pointless_validate_state_t* state, pointless_value_t* v)
+{
+	// at this stage, blocks and words have been validated, but not the items they make up
+	pointless_t* p = state->context->p;
+	pointless_value_t* blocks_vector = pointless_reader_block_vector_blocks(p, v);
+	uint32_t n_blocks_items = pointless_reader_vector_n_items(p, blocks_vector);
+	uint64_t n_words = pointless_reader_vector_n_items(p, pointless_reader_block_vector_words(p, v));
+	uint64_t start, width, n_block_words;
+	uint32_t b, i, n_blocks, n_items, type;
+	int64_t item;
+
+	if (n_blocks_items == 0) {
+		state->error = "block vector has no item type";
+		return 0;
+	}
+
+	type = pointless_reader_block_vector_item_type(p, v);
+	n_items = (uint32_t)pointless_reader_block_vector_block(p, v, 0);
+	n_blocks = ICEIL(n_items, POINTLESS_VECTOR_BLOCK_SIZE);
+
+	switch (type) {
+		case POINTLESS_VECTOR_I8:
+		case POINTLESS_VECTOR_U8:
+		case POINTLESS_VECTOR_I16:
+		case POINTLESS_VECTOR_U16:
+		case POINTLESS_VECTOR_I32:
+		case POINTLESS_VECTOR_U32:
+		case POINTLESS_VECTOR_I64:
+		case POINTLESS_VECTOR_U64:
+			break;
+		default:
+			state->error = "block vector item type is not an integer vector type";
+			return 0;
+	}
+
+	if ((uint64_t)n_blocks_items != 1 + 2 * (uint64_t)n_blocks) {
+		state->error = "block vector does not have exactly one frame and start per block";
+		return 0;
+	}
+
+	// every item must be readable as 3 words, the last 2 being padding for the last item
+	for (b = 0; b < n_blocks; b++) {
+		start = pointless_reader_block_vector_block(p, v, 2 + 2 * b) >> 8;
+		width = pointless_reader_block_vector_block(p, v, 2 + 2 * b) & 0xFF;
+
+		if (width > 64) {
+			state->error = "block vector block width exceeds 64 bits";
+			return 0;
+		}
+
+		n_block_words = ICEIL(SIMPLE_MIN(n_items - b * POINTLESS_VECTOR_BLOCK_SIZE, POINTLESS_VECTOR_BLOCK_SIZE) * width, 32);
+
+		if (start > n_words || n_block_words + 2 > n_words - start) {
+			state->error = "block vector block out of bounds";
+			return 0;
+		}
+	}
+
+	// items of 8 and 16 bits must fit, the others can not overflow
+	for (i = 0; i < n_items && (type == POINTLESS_VECTOR_I8 || type == POINTLESS_VECTOR_U8 || type == POINTLESS_VECTOR_I16 || type == POINTLESS_VECTOR_U16); i++) {
+		pointless_complete_value_t v_item = pointless_reader_vector_value_case(p, v, i);
+		item = (type == POINTLESS_VECTOR_I8 || type == POINTLESS_VECTOR_I16) ? (int64_t)v_item.complete_data.data_i32 : (int64_t)v_item.complete_data.data_u32;
+
+		if ((type == POINTLESS_VECTOR_I8 && (item < INT8_MIN || item > INT8_MAX)) || (type == POINTLESS_VECTOR_U8 && item > UINT8_MAX) || (type == POINTLESS_VECTOR_I16 && (item < INT16_MIN || item > INT16_MAX)) || (type == POINTLESS_VECTOR_U16 && item > UINT16_MAX)) {
+			state->error = "block vector item does not fit its item type";
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static int pointless_validate_encoded_vector_complicated(pointless_validate_state_t* state, pointless_value_t* v)
+{
+	if (v->type == POINTLESS_VECTOR_SPLIT)
+		return pointless_validate_split_vector_complicated(state, v);
+
+	if (v->type == POINTLESS_VECTOR_BLOCKS)
+		return pointless_validate_block_vector_complicated(state, v);
+
+	// at this stage, values and codes have been validated
+	pointless_t* p = state->context->p;
+	pointless_value_t* values = pointless_reader_encoded_vector_values(p, v);
+	pointless_value_t* codes = pointless_reader_encoded_vector_codes(p, v);
+	uint32_t i, n_values = pointless_reader_vector_n_items(p, values);
+	uint32_t n_codes = pointless_reader_vector_n_items(p, codes);
+
+	if (values->type == POINTLESS_VECTOR_VALUE || values->type == POINTLESS_VECTOR_VALUE_HASHABLE) {
+		pointless_value_t* items = pointless_reader_vector_value(p, values);
+
+		for (i = 0; i < n_values; i++) {
+			if (pointless_is_vector_type(items[i].type) || items[i].type == POINTLESS_SET_VALUE || items[i].type == POINTLESS_MAP_VALUE_VALUE || items[i].type == POINTLESS_TABLE) {
+				state->error = "encoded vector values contain a container";
+				return 0;
+			}
+		}
+	}
+
+	if (v->type == POINTLESS_VECTOR_DICTIONARY) {
+		for (i = 0; i < n_codes; i++) {
+			if (pointless_reader_encoded_vector_code(p, codes, i) >= n_values) {
+				state->error = "dictionary code out of bounds";
+				return 0;
+			}
+		}
+
+		return 1;
+	}
+
+	if (n_codes != n_values) {
+		state->error = "encoded vector does not have exactly one run end per value";
+		return 0;
+	}
+
+	for (i = 1; i < n_codes; i++) {
+		if (pointless_reader_encoded_vector_code(p, codes, i - 1) >= pointless_reader_encoded_vector_code(p, codes, i)) {
+			state->error = "encoded vector run ends not strictly increasing";
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
 static uint32_t pointless_validate_pass_cb(pointless_t* p, pointless_value_t* v, uint32_t depth, void* user)
 {
 	pointless_validate_state_t* state = (pointless_validate_state_t*)user;
@@ -74,6 +337,9 @@ static uint32_t pointless_validate_pass_cb(pointless_t* p, pointless_value_t* v,
 		return POINTLESS_WALK_STOP;
 
 	// if we have validate this container already, stop iterating downwards, otherwise, mark it as visited
+	//
+	// note: tables are not marked, they are re-validated on every visit, which still terminates since all
+	//       their children are vectors
 	switch (v->type) {
 		case POINTLESS_VECTOR_VALUE:
 		case POINTLESS_VECTOR_VALUE_HASHABLE:
@@ -124,6 +390,12 @@ static uint32_t pointless_validate_pass_cb(pointless_t* p, pointless_value_t* v,
 
 		if (v->type == POINTLESS_SET_VALUE && !pointless_validate_set_complicated(state, v))
 			return POINTLESS_WALK_STOP;
+
+		if (v->type == POINTLESS_TABLE && !pointless_validate_table_complicated(state, v))
+			return POINTLESS_WALK_STOP;
+
+		if (pointless_is_encoded_vector_type(v->type) && !pointless_validate_encoded_vector_complicated(state, v))
+			return POINTLESS_WALK_STOP;
 	}
 
 	// visit children
@@ -69,3 +69,130 @@ int32_t pointless_hash_table_validate(pointless_t* p, uint32_t n_items, uint32_t
 	// we're good
 	return 1;
 }
+
+int32_t pointless_hash_table_validate_compact(pointless_t* p, uint32_t n_items, uint32_t n_hash, uint32_t* hash_vector, pointless_value_t* key_vector, const char** error)
+{
+	if (n_hash != n_items + pointless_hash_table_compact_n_index_words(n_items)) {
+		*error = "invalid hash vector length in compact hash table";
+		return 0;
+	}
+
+	// entries are dense, and their hashes must match, primitive key vectors hold 32-bit values (see validate_heap)
+	uint32_t i;
+	pointless_complete_value_t ck;
+	pointless_value_t k;
+
+	for (i = 0; i < n_items; i++) {
+		ck = pointless_reader_vector_value_case(p, key_vector, i);
+		k = pointless_value_from_complete(&ck);
+
+		if (!pointless_is_hashable(k.type) || k.type == POINTLESS_EMPTY_SLOT) {
+			*error = "key in compact set/map is not hashable";
+			return 0;
+		}
+
+		if (pointless_hash_reader_32(p, &k) != hash_vector[i]) {
+			*error = "hash for object in hash-table does not match hash in slot";
+			return 0;
+		}
+	}
+
+	// index slots must refer to entries, and there must be exactly one slot per entry
+	void* index = (void*)(hash_vector + n_items);
+	uint32_t slot_size = pointless_hash_table_compact_slot_size(n_items);
+	uint32_t n_buckets = pointless_hash_compute_n_buckets(n_items), n_used = 0, slot;
+
+	for (i = 0; i < n_buckets; i++) {
+		switch (slot_size) {
+			case sizeof(uint8_t):
+				slot = ((uint8_t*)index)[i];
+				break;
+			case sizeof(uint16_t):
+				slot = ((uint16_t*)index)[i];
+				break;
+			default:
+				slot = ((uint32_t*)index)[i];
+				break;
+		}
+
+		if (slot > n_items) {
+			*error = "compact hash table index slot out of range";
+			return 0;
+		}
+
+		n_used += (slot != 0);
+	}
+
+	if (n_used != n_items) {
+		*error = "number of non-empty slots in hash-table, does not match item count";
+		return 0;
+	}
+
+	// ...and every entry must be found through the index, which makes the slot to entry mapping one-to-one
+	for (i = 0; i < n_items; i++) {
+		ck = pointless_reader_vector_value_case(p, key_vector, i);
+		k = pointless_value_from_complete(&ck);
+
+		uint32_t probe_i = pointless_hash_table_compact_probe(p, hash_vector[i], &k, n_items, hash_vector, key_vector, error);
+
+		if (probe_i == POINTLESS_HASH_TABLE_PROBE_ERROR)
+			return 0;
+
+		if (probe_i != i) {
+			*error = "probing of key in hash-table, does not match the place it is in";
+			return 0;
+		}
+	}
+
+	// we're good
+	return 1;
+}
+
+int32_t pointless_hash_table_validate_dense(pointless_t* p, uint32_t n_items, pointless_value_t* min_key, uint32_t n_hash, uint32_t* hash_vector, uint32_t n_range, const char** error)
+{
+	if (n_items == 0 || n_range < n_items || n_range >= POINTLESS_HASH_TABLE_PROBE_ERROR) {
+		*error = "invalid key range in dense map";
+		return 0;
+	}
+
+	if (n_hash != pointless_hash_table_dense_n_words(n_range)) {
+		*error = "invalid hash vector length in dense map";
+		return 0;
+	}
+
+	// all keys must be 32-bit integers
+	int64_t max_key = (min_key->type == POINTLESS_I32) ? (int64_t)min_key->data.data_i32 : (int64_t)min_key->data.data_u32;
+	max_key += (int64_t)n_range - 1;
+
+	if (max_key > UINT32_MAX) {
+		*error = "key range of dense map exceeds 32 bits";
+		return 0;
+	}
+
+	// one bit per key, none past the range, and the range must start and end with a key
+	uint32_t i, n_used = 0;
+
+	for (i = 0; i < n_hash * 32; i++) {
+		if (!pointless_hash_table_dense_is_set(hash_vector, i))
+			continue;
+
+		if (i >= n_range) {
+			*error = "dense map key bit out of range";
+			return 0;
+		}
+
+		n_used += 1;
+	}
+
+	if (n_used != n_items) {
+		*error = "number of keys in dense map does not match item count";
+		return 0;
+	}
+
+	if (!pointless_hash_table_dense_is_set(hash_vector, 0) || !pointless_hash_table_dense_is_set(hash_vector, n_range - 1)) {
+		*error = "dense map key range is not tight";
+		return 0;
+	}
+
+	return 1;
+}
@@ -65,6 +65,17 @@ static int32_t pointless_validate_vector_heap(pointless_validate_context_t* cont
 		return 0;
 	}
 
+	// items are aligned as the header says, the heap itself is aligned to the larger of the two alignments
+	if ((offset + sizeof(uint32_t)) % context->p->vector_alignment != 0) {
+		*error = "vector items are not aligned";
+		return 0;
+	}
+
+	if (n_bytes.value - sizeof(uint32_t) >= context->p->large_vector_alignment && (offset + sizeof(uint32_t)) % context->p->large_vector_alignment != 0) {
+		*error = "large vector items are not aligned";
+		return 0;
+	}
+
 	return 1;
 }
 
@@ -172,6 +183,81 @@ static int32_t pointless_validate_string_heap(pointless_validate_context_t* cont
 	return 1;
 }
 
+static int32_t pointless_validate_string_symbols_heap(pointless_validate_context_t* context, pointless_value_t* v, const char** error)
+{
+	assert(v->data.data_u32 < context->p->header->n_string_unicode);
+	uint64_t offset = PC_OFFSET(context->p, string_unicode_offsets, v->data.data_u32);
+
+	// uint32_t | uint8_t * n_codes
+	if (!pointless_require_heap(context, offset, sizeof(uint32_t))) {
+		*error = "string too large for heap";
+		return 0;
+	}
+
+	uint32_t* w = (uint32_t*)((char*)context->p->heap_ptr + offset);
+
+	if (!pointless_require_heap(context, offset, sizeof(uint32_t) + POINTLESS_STRING_SYMBOLS_N_CODES(*w))) {
+		*error = "string too large for heap";
+		return 0;
+	}
+
+	uint8_t buffer[POINTLESS_STRING_SYMBOLS_BUFFER_LEN];
+	uint32_t len = pointless_string_symbols_decode(context->p->string_symbols, (uint8_t*)(w + 1), POINTLESS_STRING_SYMBOLS_N_CODES(*w), buffer);
+
+	if (len == UINT32_MAX || len != POINTLESS_STRING_SYMBOLS_LEN(*w)) {
+		*error = "invalid compressed string";
+		return 0;
+	}
+
+	return 1;
+}
+
+static int32_t pointless_validate_bloom_heap(pointless_validate_context_t* context, uint32_t bloom, const char** error)
+{
+	// no filter
+	if (bloom == 0)
+		return 1;
+
+	if (bloom - 1 >= context->p->header->n_vector) {
+		*error = "Bloom filter vector out of bounds";
+		return 0;
+	}
+
+	pointless_value_t vector;
+	vector.type = POINTLESS_VECTOR_U32;
+	vector.data.data_u32 = bloom - 1;
+
+	if (!pointless_validate_vector_heap(context, &vector, error))
+		return 0;
+
+	uint32_t n_words = pointless_reader_vector_n_items(context->p, &vector);
+
+	if (n_words == 0 || n_words % POINTLESS_BLOOM_BLOCK_WORDS != 0) {
+		*error = "Bloom filter vector is not a whole number of blocks";
+		return 0;
+	}
+
+	return 1;
+}
+
+// set/map key vectors, primitive keys must be read back as 32-bit values, which have the same hash as the original keys
+static int pointless_validate_key_vector_type(uint32_t t)
+{
+	switch (t) {
+		case POINTLESS_VECTOR_VALUE_HASHABLE:
+		case POINTLESS_VECTOR_I8:
+		case POINTLESS_VECTOR_U8:
+		case POINTLESS_VECTOR_I16:
+		case POINTLESS_VECTOR_U16:
+		case POINTLESS_VECTOR_I32:
+		case POINTLESS_VECTOR_U32:
+		case POINTLESS_VECTOR_FLOAT:
+			return 1;
+	}
+
+	return 0;
+}
+
 static int32_t pointless_validate_set_heap(pointless_validate_context_t* context, pointless_value_t* v, const char** error)
 {
 	// simple stuff, not allowed to check children
@@ -192,12 +278,12 @@ static int32_t pointless_validate_set_heap(pointless_validate_context_t* context
 		return 0;
 	}
 
-	if (header->key_vector.type != POINTLESS_VECTOR_VALUE_HASHABLE) {
-		*error = "set key vector not of type POINTLESS_VECTOR_VALUE_HASHABLE";
+	if (!pointless_validate_key_vector_type(header->key_vector.type)) {
+		*error = "set key vector not of type POINTLESS_VECTOR_VALUE_HASHABLE, or a 32-bit primitive vector";
 		return 0;
 	}
 
-	return 1;
+	return pointless_validate_bloom_heap(context, header->bloom, error);
 }
 
 static int32_t pointless_validate_map_heap(pointless_validate_context_t* context, pointless_value_t* v, const char** error)
@@ -220,13 +306,105 @@ static int32_t pointless_validate_map_heap(pointless_validate_context_t* context
 		return 0;
 	}
 
-	if (header->key_vector.type != POINTLESS_VECTOR_VALUE_HASHABLE) {
-		*error = "map key vector not of type POINTLESS_VECTOR_VALUE_HASHABLE";
+	// dense maps have their smallest key in place of a key vector, and no Bloom filter
+	if (header->key_vector.type == POINTLESS_I32 || header->key_vector.type == POINTLESS_U32) {
+		if (header->bloom != 0) {
+			*error = "dense map has a Bloom filter";
+			return 0;
+		}
+	} else if (!pointless_validate_key_vector_type(header->key_vector.type)) {
+		*error = "map key vector not of type POINTLESS_VECTOR_VALUE_HASHABLE, or a 32-bit primitive vector";
+		return 0;
+	}
+
+	if (!pointless_is_vector_type(header->value_vector.type) || header->value_vector.type == POINTLESS_VECTOR_EMPTY || pointless_is_encoded_vector_type(header->value_vector.type)) {
+		*error = "map value vector not of type POINTLESS_VECTOR_VALUE, POINTLESS_VECTOR_VALUE_HASHABLE, or a primitive vector";
+		return 0;
+	}
+
+	return pointless_validate_bloom_heap(context, header->bloom, error);
+}
+
+static int32_t pointless_validate_table_heap(pointless_validate_context_t* context, pointless_value_t* v, const char** error)
+{
+	// a table is a value vector on the heap
+	pointless_value_t vector;
+	vector.type = POINTLESS_VECTOR_VALUE;
+	vector.data = v->data;
+
+	if (!pointless_validate_vector_heap(context, &vector, error))
+		return 0;
+
+	uint32_t i, n_items = pointless_reader_vector_n_items(context->p, &vector);
+	pointless_value_t* items = pointless_reader_vector_value(context->p, &vector);
+
+	// row count and key vector, followed by the columns
+	if (n_items < 2) {
+		*error = "table vector too short";
 		return 0;
 	}
 
-	if (header->value_vector.type != POINTLESS_VECTOR_VALUE_HASHABLE && header->value_vector.type != POINTLESS_VECTOR_VALUE) {
-		*error = "map key vector not of type POINTLESS_VECTOR_VALUE or POINTLESS_VECTOR_VALUE_HASHABLE";
+	if (items[0].type != POINTLESS_U32) {
+		*error = "table row count not of type POINTLESS_U32";
+		return 0;
+	}
+
+	for (i = 1; i < n_items; i++) {
+		if (!pointless_is_vector_type(items[i].type)) {
+			*error = "table key vector or column not a vector";
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static int32_t pointless_validate_encoded_vector_heap(pointless_validate_context_t* context, pointless_value_t* v, const char** error)
+{
+	// an encoded vector is a value vector on the heap, just like a table
+	pointless_value_t vector;
+	vector.type = POINTLESS_VECTOR_VALUE;
+	vector.data = v->data;
+
+	if (!pointless_validate_vector_heap(context, &vector, error))
+		return 0;
+
+	// values and codes/run ends
+	if (pointless_reader_vector_n_items(context->p, &vector) != 2) {
+		*error = "encoded vector does not have exactly two items";
+		return 0;
+	}
+
+	pointless_value_t* items = pointless_reader_vector_value(context->p, &vector);
+
+	// item types and item data
+	if (v->type == POINTLESS_VECTOR_SPLIT) {
+		if (items[0].type != POINTLESS_VECTOR_U8 || items[1].type != POINTLESS_VECTOR_U32) {
+			*error = "split vector types/data not of type POINTLESS_VECTOR_U8/POINTLESS_VECTOR_U32";
+			return 0;
+		}
+
+		return 1;
+	}
+
+	// block frames/starts and packed deltas
+	if (v->type == POINTLESS_VECTOR_BLOCKS) {
+		if (items[0].type != POINTLESS_VECTOR_U64 || items[1].type != POINTLESS_VECTOR_U32) {
+			*error = "block vector blocks/words not of type POINTLESS_VECTOR_U64/POINTLESS_VECTOR_U32";
+			return 0;
+		}
+
+		return 1;
+	}
+
+	if (!pointless_is_vector_type(items[0].type) || pointless_is_encoded_vector_type(items[0].type) || items[0].type == POINTLESS_VECTOR_EMPTY) {
+		*error = "encoded vector values not a non-empty, unencoded vector";
+		return 0;
+	}
+
+	// dictionaries have at most 65536 values, so only run ends can need 32 bits
+	if (items[1].type != POINTLESS_VECTOR_U8 && items[1].type != POINTLESS_VECTOR_U16 && !(items[1].type == POINTLESS_VECTOR_U32 && v->type == POINTLESS_VECTOR_RUNS)) {
+		*error = "encoded vector codes not of type POINTLESS_VECTOR_U8, POINTLESS_VECTOR_U16, or POINTLESS_VECTOR_U32 for runs";
 		return 0;
 	}
 
@@ -254,6 +432,10 @@ int32_t pointless_validate_heap_value(pointless_validate_context_t* context, poi
 			return pointless_validate_unicode_heap(context, v, error);
 		case POINTLESS_STRING_:
 			return pointless_validate_string_heap(context, v, error);
+		case POINTLESS_STRING_SYMBOLS:
+			return pointless_validate_string_symbols_heap(context, v, error);
+		case POINTLESS_STRING_INLINE:
+			break;
 		case POINTLESS_BITVECTOR:
 			return pointless_validate_bitvector_heap(context, v, error);
 		case POINTLESS_BITVECTOR_0:
@@ -266,6 +448,13 @@ int32_t pointless_validate_heap_value(pointless_validate_context_t* context, poi
 			return pointless_validate_set_heap(context, v, error);
 		case POINTLESS_MAP_VALUE_VALUE:
 			return pointless_validate_map_heap(context, v, error);
+		case POINTLESS_TABLE:
+			return pointless_validate_table_heap(context, v, error);
+		case POINTLESS_VECTOR_DICTIONARY:
+		case POINTLESS_VECTOR_RUNS:
+		case POINTLESS_VECTOR_SPLIT:
+		case POINTLESS_VECTOR_BLOCKS:
+			return pointless_validate_encoded_vector_heap(context, v, error);
 		case POINTLESS_EMPTY_SLOT:
 			break;
 		case POINTLESS_I32:
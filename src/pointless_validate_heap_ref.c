@@ -17,6 +17,11 @@ int32_t pointless_validate_inline_invariants(pointless_validate_context_t* conte
 		case POINTLESS_BITVECTOR:
 		case POINTLESS_SET_VALUE:
 		case POINTLESS_MAP_VALUE_VALUE:
+		case POINTLESS_TABLE:
+		case POINTLESS_VECTOR_DICTIONARY:
+		case POINTLESS_VECTOR_RUNS:
+		case POINTLESS_VECTOR_SPLIT:
+		case POINTLESS_VECTOR_BLOCKS:
 			break;
 		case POINTLESS_BITVECTOR_PACKED:
 			if (v->data.bitvector_packed.n_bits > 27) {
@@ -34,6 +39,7 @@ int32_t pointless_validate_inline_invariants(pointless_validate_context_t* conte
 			break;
 		case POINTLESS_UNICODE_:
 		case POINTLESS_STRING_:
+		case POINTLESS_STRING_SYMBOLS:
 		case POINTLESS_BITVECTOR_01:
 		case POINTLESS_BITVECTOR_10:
 		case POINTLESS_BITVECTOR_0:
@@ -42,6 +48,24 @@ int32_t pointless_validate_inline_invariants(pointless_validate_context_t* conte
 		case POINTLESS_U32:
 		case POINTLESS_FLOAT:
 			break;
+		case POINTLESS_STRING_INLINE:
+		{
+			// zero-terminated, and zero-padded to the end of the data
+			uint8_t* s = (uint8_t*)&v->data;
+			uint32_t i, len = 0;
+
+			while (len < POINTLESS_STRING_INLINE_MAX_LEN && s[len] != 0)
+				len += 1;
+
+			for (i = len; i < sizeof(uint32_t); i++) {
+				if (s[i] != 0) {
+					*error = "inline strings must be zero-terminated and zero-padded";
+					return 0;
+				}
+			}
+
+			break;
+		}
 		case POINTLESS_BOOLEAN:
 			if (v->data.data_u32 != 0 && v->data.data_u32 != 1) {
 				*error = "booleans must contain 0 or 1 in data field";
@@ -81,6 +105,18 @@ int32_t pointless_validate_heap_ref(pointless_validate_context_t* context, point
 				return 0;
 			}
 
+			break;
+		case POINTLESS_STRING_SYMBOLS:
+			if (context->p->string_symbols == 0) {
+				*error = "compressed string in a file without a symbol table";
+				return 0;
+			}
+
+			if (v->data.data_u32 >= context->p->header->n_string_unicode) {
+				*error = "string/unicode reference out of bounds";
+				return 0;
+			}
+
 			break;
 		case POINTLESS_VECTOR_VALUE:
 		case POINTLESS_VECTOR_VALUE_HASHABLE:
@@ -93,6 +129,11 @@ int32_t pointless_validate_heap_ref(pointless_validate_context_t* context, point
 		case POINTLESS_VECTOR_I64:
 		case POINTLESS_VECTOR_U64:
 		case POINTLESS_VECTOR_FLOAT:
+		case POINTLESS_TABLE:
+		case POINTLESS_VECTOR_DICTIONARY:
+		case POINTLESS_VECTOR_RUNS:
+		case POINTLESS_VECTOR_SPLIT:
+		case POINTLESS_VECTOR_BLOCKS:
 			if (v->data.data_u32 >= context->p->header->n_vector) {
 				*error = "vector reference out of bounds";
 				return 0;
@@ -121,6 +162,7 @@ int32_t pointless_validate_heap_ref(pointless_validate_context_t* context, point
 
 			break;
 		case POINTLESS_VECTOR_EMPTY:
+		case POINTLESS_STRING_INLINE:
 		case POINTLESS_BITVECTOR_01:
 		case POINTLESS_BITVECTOR_10:
 		case POINTLESS_BITVECTOR_0:
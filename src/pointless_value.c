@@ -67,6 +67,23 @@ pointless_create_value_t pointless_value_create_null()
 	return vv;
 }
 
+pointless_create_value_t pointless_value_create_string_inline(uint8_t* v, uint32_t len)
+{
+	pointless_create_value_t vv;
+	uint32_t i;
+	assert(len <= POINTLESS_STRING_INLINE_MAX_LEN);
+	vv.header.type_29 = POINTLESS_STRING_INLINE;
+	vv.header.is_compressed_vector = 0;
+	vv.header.is_outside_vector = 0;
+	vv.header.is_set_map_vector = 0;
+	vv.data.data_u32 = 0;
+
+	for (i = 0; i < len; i++)
+		((uint8_t*)&vv.data)[i] = v[i];
+
+	return vv;
+}
+
 pointless_create_value_t pointless_value_create_empty_slot()
 {
 	pointless_create_value_t vv;
@@ -271,6 +288,23 @@ int64_t pointless_create_get_int_as_int64(pointless_create_value_t* v)
 		return (int64_t)pointless_create_value_get_u32(v);
 }
 
+// two's complement bits of an I32, U32, I64 or U64 value
+uint64_t pointless_create_value_get_int_bits(pointless_create_t* c, pointless_create_value_t* v)
+{
+	switch (v->header.type_29) {
+		case POINTLESS_I32:
+			return (uint64_t)(int64_t)v->data.data_i32;
+		case POINTLESS_U32:
+			return (uint64_t)v->data.data_u32;
+		case POINTLESS_I64:
+		case POINTLESS_U64:
+			return cv_get_int_64(v);
+	}
+
+	assert(0);
+	return 0;
+}
+
 int32_t pointless_create_value_get_i32(pointless_create_value_t* v)
 {
 	assert(v->header.type_29 == POINTLESS_I32);
@@ -381,12 +415,26 @@ int32_t pointless_is_vector_type(uint32_t type)
 		case POINTLESS_VECTOR_U64:
 		case POINTLESS_VECTOR_FLOAT:
 		case POINTLESS_VECTOR_EMPTY:
+		case POINTLESS_VECTOR_DICTIONARY:
+		case POINTLESS_VECTOR_RUNS:
+		case POINTLESS_VECTOR_SPLIT:
+		case POINTLESS_VECTOR_BLOCKS:
 			return 1;
 	}
 
 	return 0;
 }
 
+int32_t pointless_is_encoded_vector_type(uint32_t type)
+{
+	return (type == POINTLESS_VECTOR_DICTIONARY || type == POINTLESS_VECTOR_RUNS || type == POINTLESS_VECTOR_SPLIT || type == POINTLESS_VECTOR_BLOCKS);
+}
+
+int32_t pointless_is_string_8_type(uint32_t type)
+{
+	return (type == POINTLESS_STRING_ || type == POINTLESS_STRING_INLINE || type == POINTLESS_STRING_SYMBOLS);
+}
+
 int32_t pointless_is_integer_type(uint32_t type)
 {
 	switch (type) {
@@ -0,0 +1,756 @@
+#include <pointless/pointless_vector_ops.h>
+
+pointless_vector_number_t pointless_vector_number_i64(int64_t v)
+{
+	pointless_vector_number_t n;
+	n.type = POINTLESS_VECTOR_NUMBER_I64;
+	n.data.i = v;
+	return n;
+}
+
+pointless_vector_number_t pointless_vector_number_u64(uint64_t v)
+{
+	pointless_vector_number_t n;
+	n.type = POINTLESS_VECTOR_NUMBER_U64;
+	n.data.u = v;
+	return n;
+}
+
+pointless_vector_number_t pointless_vector_number_double(double v)
+{
+	pointless_vector_number_t n;
+	n.type = POINTLESS_VECTOR_NUMBER_DOUBLE;
+	n.data.f = v;
+	return n;
+}
+
+static int pointless_vector_check_type(uint32_t type, const char** error)
+{
+	switch (type) {
+		case POINTLESS_VECTOR_EMPTY:
+		case POINTLESS_VECTOR_I8:
+		case POINTLESS_VECTOR_U8:
+		case POINTLESS_VECTOR_I16:
+		case POINTLESS_VECTOR_U16:
+		case POINTLESS_VECTOR_I32:
+		case POINTLESS_VECTOR_U32:
+		case POINTLESS_VECTOR_I64:
+		case POINTLESS_VECTOR_U64:
+		case POINTLESS_VECTOR_FLOAT:
+			return 1;
+	}
+
+	*error = "only primitive vectors support this operation";
+	return 0;
+}
+
+// predicates are normalized into a closed interval [lo, hi] of item values, possibly negated
+typedef struct {
+	int is_empty;
+	int is_negated;
+
+	int64_t i_lo, i_hi;
+	uint64_t u_lo, u_hi;
+	float f_lo, f_hi;
+} pointless_vector_interval_t;
+
+// 2**63 and 2**64, exact as doubles
+#define POINTLESS_VECTOR_2_63 9223372036854775808.0
+#define POINTLESS_VECTOR_2_64 18446744073709551616.0
+
+// the bound functions return the smallest (lower) or largest (upper) value which is
+// >= a or <= a, or > a or < a if strict. they return 0 iff there is no such value.
+static int pointless_vector_lower_i64(pointless_vector_number_t a, int strict, int64_t* v)
+{
+	double d;
+
+	switch (a.type) {
+		case POINTLESS_VECTOR_NUMBER_I64:
+			if (strict && a.data.i == INT64_MAX)
+				return 0;
+
+			*v = a.data.i + (strict ? 1 : 0);
+			return 1;
+		case POINTLESS_VECTOR_NUMBER_U64:
+			if (a.data.u > INT64_MAX || (strict && a.data.u == INT64_MAX))
+				return 0;
+
+			*v = (int64_t)a.data.u + (strict ? 1 : 0);
+			return 1;
+		case POINTLESS_VECTOR_NUMBER_DOUBLE:
+			if (isnan(a.data.f))
+				return 0;
+
+			d = strict ? floor(a.data.f) + 1.0 : ceil(a.data.f);
+
+			if (d >= POINTLESS_VECTOR_2_63)
+				return 0;
+
+			*v = (d < -POINTLESS_VECTOR_2_63) ? INT64_MIN : (int64_t)d;
+			return 1;
+	}
+
+	return 0;
+}
+
+static int pointless_vector_upper_i64(pointless_vector_number_t a, int strict, int64_t* v)
+{
+	double d;
+
+	switch (a.type) {
+		case POINTLESS_VECTOR_NUMBER_I64:
+			if (strict && a.data.i == INT64_MIN)
+				return 0;
+
+			*v = a.data.i - (strict ? 1 : 0);
+			return 1;
+		case POINTLESS_VECTOR_NUMBER_U64:
+			if (a.data.u > INT64_MAX)
+				*v = INT64_MAX;
+			else
+				*v = (int64_t)a.data.u - (strict ? 1 : 0);
+
+			return 1;
+		case POINTLESS_VECTOR_NUMBER_DOUBLE:
+			if (isnan(a.data.f))
+				return 0;
+
+			d = strict ? ceil(a.data.f) - 1.0 : floor(a.data.f);
+
+			if (d < -POINTLESS_VECTOR_2_63)
+				return 0;
+
+			*v = (d >= POINTLESS_VECTOR_2_63) ? INT64_MAX : (int64_t)d;
+			return 1;
+	}
+
+	return 0;
+}
+
+static int pointless_vector_lower_u64(pointless_vector_number_t a, int strict, uint64_t* v)
+{
+	double d;
+
+	switch (a.type) {
+		case POINTLESS_VECTOR_NUMBER_I64:
+			*v = (a.data.i < 0) ? 0 : (uint64_t)a.data.i + (strict ? 1 : 0);
+			return 1;
+		case POINTLESS_VECTOR_NUMBER_U64:
+			if (strict && a.data.u == UINT64_MAX)
+				return 0;
+
+			*v = a.data.u + (strict ? 1 : 0);
+			return 1;
+		case POINTLESS_VECTOR_NUMBER_DOUBLE:
+			if (isnan(a.data.f))
+				return 0;
+
+			d = strict ? floor(a.data.f) + 1.0 : ceil(a.data.f);
+
+			if (d >= POINTLESS_VECTOR_2_64)
+				return 0;
+
+			*v = (d < 0.0) ? 0 : (uint64_t)d;
+			return 1;
+	}
+
+	return 0;
+}
+
+static int pointless_vector_upper_u64(pointless_vector_number_t a, int strict, uint64_t* v)
+{
+	double d;
+
+	switch (a.type) {
+		case POINTLESS_VECTOR_NUMBER_I64:
+			if (a.data.i < 0 || (strict && a.data.i == 0))
+				return 0;
+
+			*v = (uint64_t)a.data.i - (strict ? 1 : 0);
+			return 1;
+		case POINTLESS_VECTOR_NUMBER_U64:
+			if (strict && a.data.u == 0)
+				return 0;
+
+			*v = a.data.u - (strict ? 1 : 0);
+			return 1;
+		case POINTLESS_VECTOR_NUMBER_DOUBLE:
+			if (isnan(a.data.f))
+				return 0;
+
+			d = strict ? ceil(a.data.f) - 1.0 : floor(a.data.f);
+
+			if (d < 0.0)
+				return 0;
+
+			*v = (d >= POINTLESS_VECTOR_2_64) ? UINT64_MAX : (uint64_t)d;
+			return 1;
+	}
+
+	return 0;
+}
+
+static double pointless_vector_number_as_double(pointless_vector_number_t a)
+{
+	switch (a.type) {
+		case POINTLESS_VECTOR_NUMBER_I64: return (double)a.data.i;
+		case POINTLESS_VECTOR_NUMBER_U64: return (double)a.data.u;
+	}
+
+	return a.data.f;
+}
+
+static int pointless_vector_lower_f(pointless_vector_number_t a, int strict, float* v)
+{
+	double d = pointless_vector_number_as_double(a);
+
+	if (isnan(d) || (strict && d == INFINITY))
+		return 0;
+
+	*v = (float)d;
+
+	if ((double)*v < d || (strict && (double)*v == d))
+		*v = nextafterf(*v, INFINITY);
+
+	return 1;
+}
+
+static int pointless_vector_upper_f(pointless_vector_number_t a, int strict, float* v)
+{
+	double d = pointless_vector_number_as_double(a);
+
+	if (isnan(d) || (strict && d == -INFINITY))
+		return 0;
+
+	*v = (float)d;
+
+	if ((double)*v > d || (strict && (double)*v == d))
+		*v = nextafterf(*v, -INFINITY);
+
+	return 1;
+}
+
+static int pointless_vector_interval(uint32_t type, uint32_t op, pointless_vector_number_t a, pointless_vector_number_t b, pointless_vector_interval_t* r, const char** error)
+{
+	int has_lo = 0, has_hi = 0, lo_strict = 0, hi_strict = 0;
+	pointless_vector_number_t lo = a, hi = a;
+
+	switch (op) {
+		case POINTLESS_VECTOR_OP_EQ:    has_lo = 1; has_hi = 1;                 break;
+		case POINTLESS_VECTOR_OP_NE:    has_lo = 1; has_hi = 1;                 break;
+		case POINTLESS_VECTOR_OP_LT:    has_hi = 1; hi_strict = 1;              break;
+		case POINTLESS_VECTOR_OP_LE:    has_hi = 1;                             break;
+		case POINTLESS_VECTOR_OP_GT:    has_lo = 1; lo_strict = 1;              break;
+		case POINTLESS_VECTOR_OP_GE:    has_lo = 1;                             break;
+		case POINTLESS_VECTOR_OP_RANGE: has_lo = 1; has_hi = 1; hi_strict = 1; hi = b; break;
+		default:
+			*error = "unknown vector predicate";
+			return 0;
+	}
+
+	r->is_empty = 0;
+	r->is_negated = (op == POINTLESS_VECTOR_OP_NE);
+
+	int64_t i_v = 0;
+	uint64_t u_v = 0;
+	float f_v = 0.0f;
+
+	switch (type) {
+		case POINTLESS_VECTOR_I8:    r->i_lo = INT8_MIN;  r->i_hi = INT8_MAX;  break;
+		case POINTLESS_VECTOR_I16:   r->i_lo = INT16_MIN; r->i_hi = INT16_MAX; break;
+		case POINTLESS_VECTOR_I32:   r->i_lo = INT32_MIN; r->i_hi = INT32_MAX; break;
+		case POINTLESS_VECTOR_I64:   r->i_lo = INT64_MIN; r->i_hi = INT64_MAX; break;
+		case POINTLESS_VECTOR_U8:    r->u_lo = 0;         r->u_hi = UINT8_MAX;  break;
+		case POINTLESS_VECTOR_U16:   r->u_lo = 0;         r->u_hi = UINT16_MAX; break;
+		case POINTLESS_VECTOR_U32:   r->u_lo = 0;         r->u_hi = UINT32_MAX; break;
+		case POINTLESS_VECTOR_U64:   r->u_lo = 0;         r->u_hi = UINT64_MAX; break;
+		case POINTLESS_VECTOR_FLOAT: r->f_lo = -INFINITY; r->f_hi = INFINITY;   break;
+		case POINTLESS_VECTOR_EMPTY: r->is_empty = 1; return 1;
+	}
+
+	switch (type) {
+		case POINTLESS_VECTOR_I8:
+		case POINTLESS_VECTOR_I16:
+		case POINTLESS_VECTOR_I32:
+		case POINTLESS_VECTOR_I64:
+			if (has_lo && !pointless_vector_lower_i64(lo, lo_strict, &i_v))
+				r->is_empty = 1;
+			else if (has_lo && i_v > r->i_lo)
+				r->i_lo = i_v;
+
+			if (has_hi && !pointless_vector_upper_i64(hi, hi_strict, &i_v))
+				r->is_empty = 1;
+			else if (has_hi && i_v < r->i_hi)
+				r->i_hi = i_v;
+
+			if (r->i_lo > r->i_hi)
+				r->is_empty = 1;
+
+			break;
+		case POINTLESS_VECTOR_U8:
+		case POINTLESS_VECTOR_U16:
+		case POINTLESS_VECTOR_U32:
+		case POINTLESS_VECTOR_U64:
+			if (has_lo && !pointless_vector_lower_u64(lo, lo_strict, &u_v))
+				r->is_empty = 1;
+			else if (has_lo && u_v > r->u_lo)
+				r->u_lo = u_v;
+
+			if (has_hi && !pointless_vector_upper_u64(hi, hi_strict, &u_v))
+				r->is_empty = 1;
+			else if (has_hi && u_v < r->u_hi)
+				r->u_hi = u_v;
+
+			if (r->u_lo > r->u_hi)
+				r->is_empty = 1;
+
+			break;
+		case POINTLESS_VECTOR_FLOAT:
+			if (has_lo && !pointless_vector_lower_f(lo, lo_strict, &f_v))
+				r->is_empty = 1;
+			else if (has_lo)
+				r->f_lo = f_v;
+
+			if (has_hi && !pointless_vector_upper_f(hi, hi_strict, &f_v))
+				r->is_empty = 1;
+			else if (has_hi)
+				r->f_hi = f_v;
+
+			if (r->f_lo > r->f_hi)
+				r->is_empty = 1;
+
+			break;
+	}
+
+	return 1;
+}
+
+#define POINTLESS_VECTOR_SUM(T, S) for (i = 0; i < n; i++) { S += ((T*)v)[i]; } break
+
+int pointless_vector_sum(void* v, uint32_t type, size_t n, pointless_vector_number_t* sum, const char** error)
+{
+	if (!pointless_vector_check_type(type, error))
+		return 0;
+
+	// signed sums are accumulated as unsigned, to get well defined wrap-around
+	uint64_t s_i = 0, s_u = 0;
+	double s_f = 0.0;
+	size_t i;
+
+	switch (type) {
+		case POINTLESS_VECTOR_I8:    POINTLESS_VECTOR_SUM(int8_t,   s_i);
+		case POINTLESS_VECTOR_I16:   POINTLESS_VECTOR_SUM(int16_t,  s_i);
+		case POINTLESS_VECTOR_I32:   POINTLESS_VECTOR_SUM(int32_t,  s_i);
+		case POINTLESS_VECTOR_I64:   POINTLESS_VECTOR_SUM(int64_t,  s_i);
+		case POINTLESS_VECTOR_U8:    POINTLESS_VECTOR_SUM(uint8_t,  s_u);
+		case POINTLESS_VECTOR_U16:   POINTLESS_VECTOR_SUM(uint16_t, s_u);
+		case POINTLESS_VECTOR_U32:   POINTLESS_VECTOR_SUM(uint32_t, s_u);
+		case POINTLESS_VECTOR_U64:   POINTLESS_VECTOR_SUM(uint64_t, s_u);
+		case POINTLESS_VECTOR_FLOAT: POINTLESS_VECTOR_SUM(float,    s_f);
+	}
+
+	switch (type) {
+		case POINTLESS_VECTOR_I8:
+		case POINTLESS_VECTOR_I16:
+		case POINTLESS_VECTOR_I32:
+		case POINTLESS_VECTOR_I64:
+			*sum = pointless_vector_number_i64((int64_t)s_i);
+			break;
+		case POINTLESS_VECTOR_FLOAT:
+			*sum = pointless_vector_number_double(s_f);
+			break;
+		default:
+			*sum = pointless_vector_number_u64(s_u);
+			break;
+	}
+
+	return 1;
+}
+
+// integers: find the extreme value with a plain reduction, then its first position
+#define POINTLESS_VECTOR_ARG_I(T, OP) \
+	{\
+		T m = ((T*)v)[0];\
+		for (j = 1; j < n; j++)\
+			m = (((T*)v)[j] OP m) ? ((T*)v)[j] : m;\
+		for (j = 0; ((T*)v)[j] != m; j++);\
+		*i = j;\
+	}\
+	break
+
+// floats: NaN is never equal to itself, so keep track of the position
+#define POINTLESS_VECTOR_ARG_F(OP) \
+	{\
+		*i = 0;\
+		for (j = 1; j < n; j++) {\
+			if (((float*)v)[j] OP ((float*)v)[*i])\
+				*i = j;\
+		}\
+	}\
+	break
+
+int pointless_vector_argmin(void* v, uint32_t type, size_t n, size_t* i, const char** error)
+{
+	size_t j;
+
+	if (!pointless_vector_check_type(type, error))
+		return 0;
+
+	if (n == 0) {
+		*error = "vector is empty";
+		return 0;
+	}
+
+	switch (type) {
+		case POINTLESS_VECTOR_I8:    POINTLESS_VECTOR_ARG_I(int8_t,   <);
+		case POINTLESS_VECTOR_U8:    POINTLESS_VECTOR_ARG_I(uint8_t,  <);
+		case POINTLESS_VECTOR_I16:   POINTLESS_VECTOR_ARG_I(int16_t,  <);
+		case POINTLESS_VECTOR_U16:   POINTLESS_VECTOR_ARG_I(uint16_t, <);
+		case POINTLESS_VECTOR_I32:   POINTLESS_VECTOR_ARG_I(int32_t,  <);
+		case POINTLESS_VECTOR_U32:   POINTLESS_VECTOR_ARG_I(uint32_t, <);
+		case POINTLESS_VECTOR_I64:   POINTLESS_VECTOR_ARG_I(int64_t,  <);
+		case POINTLESS_VECTOR_U64:   POINTLESS_VECTOR_ARG_I(uint64_t, <);
+		case POINTLESS_VECTOR_FLOAT: POINTLESS_VECTOR_ARG_F(<);
+	}
+
+	return 1;
+}
+
+int pointless_vector_argmax(void* v, uint32_t type, size_t n, size_t* i, const char** error)
+{
+	size_t j;
+
+	if (!pointless_vector_check_type(type, error))
+		return 0;
+
+	if (n == 0) {
+		*error = "vector is empty";
+		return 0;
+	}
+
+	switch (type) {
+		case POINTLESS_VECTOR_I8:    POINTLESS_VECTOR_ARG_I(int8_t,   >);
+		case POINTLESS_VECTOR_U8:    POINTLESS_VECTOR_ARG_I(uint8_t,  >);
+		case POINTLESS_VECTOR_I16:   POINTLESS_VECTOR_ARG_I(int16_t,  >);
+		case POINTLESS_VECTOR_U16:   POINTLESS_VECTOR_ARG_I(uint16_t, >);
+		case POINTLESS_VECTOR_I32:   POINTLESS_VECTOR_ARG_I(int32_t,  >);
+		case POINTLESS_VECTOR_U32:   POINTLESS_VECTOR_ARG_I(uint32_t, >);
+		case POINTLESS_VECTOR_I64:   POINTLESS_VECTOR_ARG_I(int64_t,  >);
+		case POINTLESS_VECTOR_U64:   POINTLESS_VECTOR_ARG_I(uint64_t, >);
+		case POINTLESS_VECTOR_FLOAT: POINTLESS_VECTOR_ARG_F(>);
+	}
+
+	return 1;
+}
+
+#define POINTLESS_VECTOR_COUNT(T, LO, HI) \
+	{\
+		T lo = (T)(LO), hi = (T)(HI);\
+		for (i = 0; i < n; i++)\
+			c += (((T*)v)[i] >= lo) & (((T*)v)[i] <= hi);\
+	}\
+	break
+
+static size_t pointless_vector_count_interval(void* v, uint32_t type, size_t n, pointless_vector_interval_t* r)
+{
+	size_t i, c = 0;
+
+	if (r->is_empty)
+		return 0;
+
+	switch (type) {
+		case POINTLESS_VECTOR_I8:    POINTLESS_VECTOR_COUNT(int8_t,   r->i_lo, r->i_hi);
+		case POINTLESS_VECTOR_U8:    POINTLESS_VECTOR_COUNT(uint8_t,  r->u_lo, r->u_hi);
+		case POINTLESS_VECTOR_I16:   POINTLESS_VECTOR_COUNT(int16_t,  r->i_lo, r->i_hi);
+		case POINTLESS_VECTOR_U16:   POINTLESS_VECTOR_COUNT(uint16_t, r->u_lo, r->u_hi);
+		case POINTLESS_VECTOR_I32:   POINTLESS_VECTOR_COUNT(int32_t,  r->i_lo, r->i_hi);
+		case POINTLESS_VECTOR_U32:   POINTLESS_VECTOR_COUNT(uint32_t, r->u_lo, r->u_hi);
+		case POINTLESS_VECTOR_I64:   POINTLESS_VECTOR_COUNT(int64_t,  r->i_lo, r->i_hi);
+		case POINTLESS_VECTOR_U64:   POINTLESS_VECTOR_COUNT(uint64_t, r->u_lo, r->u_hi);
+		case POINTLESS_VECTOR_FLOAT: POINTLESS_VECTOR_COUNT(float,    r->f_lo, r->f_hi);
+	}
+
+	return c;
+}
+
+int pointless_vector_count(void* v, uint32_t type, size_t n, uint32_t op, pointless_vector_number_t a, pointless_vector_number_t b, size_t* count, const char** error)
+{
+	pointless_vector_interval_t r;
+
+	if (!pointless_vector_check_type(type, error))
+		return 0;
+
+	if (!pointless_vector_interval(type, op, a, b, &r, error))
+		return 0;
+
+	*count = pointless_vector_count_interval(v, type, n, &r);
+
+	if (r.is_negated)
+		*count = n - *count;
+
+	return 1;
+}
+
+// every index is written, but only kept if the predicate holds, so there must be room for one extra index
+#define POINTLESS_VECTOR_FILTER(T, LO, HI) \
+	{\
+		T lo = (T)(LO), hi = (T)(HI);\
+		for (i = 0; i < n; i++) {\
+			indices[k] = (uint32_t)i;\
+			k += ((((T*)v)[i] >= lo) & (((T*)v)[i] <= hi)) ^ neg;\
+		}\
+	}\
+	break
+
+int pointless_vector_filter(void* v, uint32_t type, size_t n, uint32_t op, pointless_vector_number_t a, pointless_vector_number_t b, pointless_dynarray_t* indices_, const char** error)
+{
+	pointless_vector_interval_t r;
+	size_t i, k = 0, count;
+	uint32_t* indices;
+	int neg;
+
+	if (!pointless_vector_check_type(type, error))
+		return 0;
+
+	if (n > UINT32_MAX) {
+		*error = "vector too large for 32-bit indices";
+		return 0;
+	}
+
+	if (!pointless_vector_interval(type, op, a, b, &r, error))
+		return 0;
+
+	// a negated empty interval matches everything
+	if (r.is_empty && r.is_negated) {
+		switch (type) {
+			case POINTLESS_VECTOR_FLOAT: r.f_lo = 1.0f;  r.f_hi = 0.0f; break;
+			case POINTLESS_VECTOR_U8:
+			case POINTLESS_VECTOR_U16:
+			case POINTLESS_VECTOR_U32:
+			case POINTLESS_VECTOR_U64:   r.u_lo = 1;     r.u_hi = 0;    break;
+			default:                     r.i_lo = 1;     r.i_hi = 0;    break;
+		}
+
+		r.is_empty = 0;
+	}
+
+	count = pointless_vector_count_interval(v, type, n, &r);
+
+	if (r.is_negated)
+		count = n - count;
+
+	if (count == 0)
+		return 1;
+
+	indices = (uint32_t*)pointless_malloc(sizeof(uint32_t) * (count + 1));
+
+	if (indices == 0) {
+		*error = "out of memory";
+		return 0;
+	}
+
+	neg = r.is_negated;
+
+	switch (type) {
+		case POINTLESS_VECTOR_I8:    POINTLESS_VECTOR_FILTER(int8_t,   r.i_lo, r.i_hi);
+		case POINTLESS_VECTOR_U8:    POINTLESS_VECTOR_FILTER(uint8_t,  r.u_lo, r.u_hi);
+		case POINTLESS_VECTOR_I16:   POINTLESS_VECTOR_FILTER(int16_t,  r.i_lo, r.i_hi);
+		case POINTLESS_VECTOR_U16:   POINTLESS_VECTOR_FILTER(uint16_t, r.u_lo, r.u_hi);
+		case POINTLESS_VECTOR_I32:   POINTLESS_VECTOR_FILTER(int32_t,  r.i_lo, r.i_hi);
+		case POINTLESS_VECTOR_U32:   POINTLESS_VECTOR_FILTER(uint32_t, r.u_lo, r.u_hi);
+		case POINTLESS_VECTOR_I64:   POINTLESS_VECTOR_FILTER(int64_t,  r.i_lo, r.i_hi);
+		case POINTLESS_VECTOR_U64:   POINTLESS_VECTOR_FILTER(uint64_t, r.u_lo, r.u_hi);
+		case POINTLESS_VECTOR_FLOAT: POINTLESS_VECTOR_FILTER(float,    r.f_lo, r.f_hi);
+	}
+
+	assert(k == count);
+
+	pointless_dynarray_give_data(indices_, indices, count);
+
+	return 1;
+}
+
+#define POINTLESS_VECTOR_HISTOGRAM(T) \
+	for (i = 0; i < n; i++) {\
+		double d = (double)((T*)v)[i];\
+		if (lo <= d && d < hi) {\
+			b = (size_t)((d - lo) * scale);\
+			bins[b < n_bins ? b : n_bins - 1] += 1;\
+		}\
+	}\
+	break
+
+int pointless_vector_histogram(void* v, uint32_t type, size_t n, double lo, double hi, uint64_t* bins, uint32_t n_bins, const char** error)
+{
+	size_t i, b;
+
+	if (!pointless_vector_check_type(type, error))
+		return 0;
+
+	if (n_bins == 0) {
+		*error = "histogram must have at least one bin";
+		return 0;
+	}
+
+	if (!(lo < hi) || isinf(hi - lo)) {
+		*error = "histogram range must be finite and non-empty";
+		return 0;
+	}
+
+	double scale = (double)n_bins / (hi - lo);
+
+	memset(bins, 0, sizeof(uint64_t) * n_bins);
+
+	switch (type) {
+		case POINTLESS_VECTOR_I8:    POINTLESS_VECTOR_HISTOGRAM(int8_t);
+		case POINTLESS_VECTOR_U8:    POINTLESS_VECTOR_HISTOGRAM(uint8_t);
+		case POINTLESS_VECTOR_I16:   POINTLESS_VECTOR_HISTOGRAM(int16_t);
+		case POINTLESS_VECTOR_U16:   POINTLESS_VECTOR_HISTOGRAM(uint16_t);
+		case POINTLESS_VECTOR_I32:   POINTLESS_VECTOR_HISTOGRAM(int32_t);
+		case POINTLESS_VECTOR_U32:   POINTLESS_VECTOR_HISTOGRAM(uint32_t);
+		case POINTLESS_VECTOR_I64:   POINTLESS_VECTOR_HISTOGRAM(int64_t);
+		case POINTLESS_VECTOR_U64:   POINTLESS_VECTOR_HISTOGRAM(uint64_t);
+		case POINTLESS_VECTOR_FLOAT: POINTLESS_VECTOR_HISTOGRAM(float);
+	}
+
+	return 1;
+}
+
+size_t pointless_vector_type_item_size(uint32_t type)
+{
+	switch (type) {
+		case POINTLESS_VECTOR_I8:    return sizeof(int8_t);
+		case POINTLESS_VECTOR_U8:    return sizeof(uint8_t);
+		case POINTLESS_VECTOR_I16:   return sizeof(int16_t);
+		case POINTLESS_VECTOR_U16:   return sizeof(uint16_t);
+		case POINTLESS_VECTOR_I32:   return sizeof(int32_t);
+		case POINTLESS_VECTOR_U32:   return sizeof(uint32_t);
+		case POINTLESS_VECTOR_I64:   return sizeof(int64_t);
+		case POINTLESS_VECTOR_U64:   return sizeof(uint64_t);
+		case POINTLESS_VECTOR_FLOAT: return sizeof(float);
+	}
+
+	return 0;
+}
+
+// items of 'base', which may be a mapped vector, whose 64-bit items are only 4-byte aligned, so items are read with
+// memcpy, which compilers turn into plain loads
+#define POINTLESS_VECTOR_LOAD(T, base, i, x) memcpy(&(x), (const char*)(base) + (size_t)(i) * sizeof(T), sizeof(T))
+
+// smallest and largest index, in one branch-free pass
+#define POINTLESS_VECTOR_INDEX_BOUNDS_I(T) \
+	{\
+		T x, lo, hi;\
+		POINTLESS_VECTOR_LOAD(T, index, 0, lo);\
+		hi = lo;\
+		for (i = 1; i < n_index; i++) {\
+			POINTLESS_VECTOR_LOAD(T, index, i, x);\
+			lo = (x < lo) ? x : lo;\
+			hi = (x > hi) ? x : hi;\
+		}\
+		is_negative = (lo < 0);\
+		max_index = (uint64_t)hi;\
+	}\
+	break
+
+#define POINTLESS_VECTOR_INDEX_BOUNDS_U(T) \
+	{\
+		T x, hi;\
+		POINTLESS_VECTOR_LOAD(T, index, 0, hi);\
+		for (i = 1; i < n_index; i++) {\
+			POINTLESS_VECTOR_LOAD(T, index, i, x);\
+			hi = (x > hi) ? x : hi;\
+		}\
+		max_index = (uint64_t)hi;\
+	}\
+	break
+
+// random reads from the source dominate, so ask for them a few iterations ahead
+#ifdef __GNUC__
+#define POINTLESS_VECTOR_PREFETCH(p) __builtin_prefetch((p), 0, 0)
+#else
+#define POINTLESS_VECTOR_PREFETCH(p)
+#endif
+
+#define POINTLESS_VECTOR_GATHER_DISTANCE 16
+
+#define POINTLESS_VECTOR_GATHER(TI, TV) \
+	{\
+		TI j;\
+		TV* d = (TV*)dst;\
+		i = 0;\
+		if (n_index > POINTLESS_VECTOR_GATHER_DISTANCE) {\
+			for (; i < n_index - POINTLESS_VECTOR_GATHER_DISTANCE; i++) {\
+				POINTLESS_VECTOR_LOAD(TI, index, i + POINTLESS_VECTOR_GATHER_DISTANCE, j);\
+				POINTLESS_VECTOR_PREFETCH((const char*)src + (size_t)j * sizeof(TV));\
+				POINTLESS_VECTOR_LOAD(TI, index, i, j);\
+				POINTLESS_VECTOR_LOAD(TV, src, j, d[i]);\
+			}\
+		}\
+		for (; i < n_index; i++) {\
+			POINTLESS_VECTOR_LOAD(TI, index, i, j);\
+			POINTLESS_VECTOR_LOAD(TV, src, j, d[i]);\
+		}\
+	}\
+	break
+
+// items are only copied, so the value type only matters through its size
+#define POINTLESS_VECTOR_GATHER_INDEX(TI) \
+	switch (item_size) {\
+		case 1: POINTLESS_VECTOR_GATHER(TI, uint8_t);\
+		case 2: POINTLESS_VECTOR_GATHER(TI, uint16_t);\
+		case 4: POINTLESS_VECTOR_GATHER(TI, uint32_t);\
+		case 8: POINTLESS_VECTOR_GATHER(TI, uint64_t);\
+	}\
+	break
+
+int pointless_vector_gather(void* src, uint32_t src_type, size_t n_src, void* index, uint32_t index_type, size_t n_index, void* dst, const char** error)
+{
+	size_t i, item_size = pointless_vector_type_item_size(src_type);
+	int is_negative = 0;
+	uint64_t max_index = 0;
+
+	if (!pointless_vector_check_type(src_type, error))
+		return 0;
+
+	if (n_index == 0)
+		return 1;
+
+	// validate all indices up front, so the gather itself has no checks
+	switch (index_type) {
+		case POINTLESS_VECTOR_I8:  POINTLESS_VECTOR_INDEX_BOUNDS_I(int8_t);
+		case POINTLESS_VECTOR_U8:  POINTLESS_VECTOR_INDEX_BOUNDS_U(uint8_t);
+		case POINTLESS_VECTOR_I16: POINTLESS_VECTOR_INDEX_BOUNDS_I(int16_t);
+		case POINTLESS_VECTOR_U16: POINTLESS_VECTOR_INDEX_BOUNDS_U(uint16_t);
+		case POINTLESS_VECTOR_I32: POINTLESS_VECTOR_INDEX_BOUNDS_I(int32_t);
+		case POINTLESS_VECTOR_U32: POINTLESS_VECTOR_INDEX_BOUNDS_U(uint32_t);
+		case POINTLESS_VECTOR_I64: POINTLESS_VECTOR_INDEX_BOUNDS_I(int64_t);
+		case POINTLESS_VECTOR_U64: POINTLESS_VECTOR_INDEX_BOUNDS_U(uint64_t);
+		default:
+			is_negative = 1;
+			break;
+	}
+
+	if (is_negative) {
+		*error = "index vector negative or of the wrong type";
+		return 0;
+	}
+
+	if (max_index >= n_src) {
+		*error = "index vector out of bounds";
+		return 0;
+	}
+
+	switch (index_type) {
+		case POINTLESS_VECTOR_I8:  POINTLESS_VECTOR_GATHER_INDEX(uint8_t);
+		case POINTLESS_VECTOR_U8:  POINTLESS_VECTOR_GATHER_INDEX(uint8_t);
+		case POINTLESS_VECTOR_I16: POINTLESS_VECTOR_GATHER_INDEX(uint16_t);
+		case POINTLESS_VECTOR_U16: POINTLESS_VECTOR_GATHER_INDEX(uint16_t);
+		case POINTLESS_VECTOR_I32: POINTLESS_VECTOR_GATHER_INDEX(uint32_t);
+		case POINTLESS_VECTOR_U32: POINTLESS_VECTOR_GATHER_INDEX(uint32_t);
+		case POINTLESS_VECTOR_I64: POINTLESS_VECTOR_GATHER_INDEX(uint64_t);
+		case POINTLESS_VECTOR_U64: POINTLESS_VECTOR_GATHER_INDEX(uint64_t);
+	}
+
+	return 1;
+}
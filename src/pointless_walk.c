@@ -28,6 +28,34 @@ static void pointless_walk_priv(pointless_t* p, pointless_value_t* v, uint32_t d
 			if (*stop)
 				return;
 		}
+	// tables, keys and columns
+	} else if (v->type == POINTLESS_TABLE) {
+		uint32_t i, n_columns = pointless_reader_table_n_columns(p, v);
+		pointless_value_t* keys = pointless_reader_table_keys(p, v);
+		pointless_value_t* columns = pointless_reader_table_columns(p, v);
+
+		pointless_walk_priv(p, keys, depth + 1, cb, stop, user);
+
+		if (*stop)
+			return;
+
+		for (i = 0; i < n_columns; i++) {
+			pointless_walk_priv(p, &columns[i], depth + 1, cb, stop, user);
+
+			if (*stop)
+				return;
+		}
+	// encoded vectors, values and codes
+	} else if (pointless_is_encoded_vector_type(v->type)) {
+		pointless_walk_priv(p, pointless_reader_encoded_vector_values(p, v), depth + 1, cb, stop, user);
+
+		if (*stop)
+			return;
+
+		pointless_walk_priv(p, pointless_reader_encoded_vector_codes(p, v), depth + 1, cb, stop, user);
+
+		if (*stop)
+			return;
 	// sets
 	} else if (v->type == POINTLESS_SET_VALUE) {
 		pointless_value_t* hash_vector = pointless_set_hash_vector(p, v);
@@ -0,0 +1,69 @@
+#!/usr/bin/python
+
+# map/set lookup microbenchmark
+#
+# str, unicode and int keys take a fast path in PyPointlessMap/PyPointlessSet lookups, instances
+# of their subclasses take the generic hash and comparison path, so timing both shows the gain.
+# pointless.Key objects are prepared once, and skip hashing altogether
+
+import sys, time, pointless
+
+class _str(str): pass
+class _unicode(unicode): pass
+class _int(int): pass
+
+def bench(name, f, queries, n_rounds):
+	t = time.time()
+
+	for i in xrange(n_rounds):
+		f(queries)
+
+	t = time.time() - t
+	n = len(queries) * n_rounds
+	print '%-40s %8.1f ns/lookup' % (name, t * 1e9 / n)
+	return t
+
+def main():
+	n_items = int(sys.argv[1]) if len(sys.argv) > 1 else 100000
+	n_rounds = int(sys.argv[2]) if len(sys.argv) > 2 else 10
+
+	cases = [
+		('str', [('key_%i' % (i,)) for i in xrange(n_items)], _str),
+		('unicode', [(u'key_%i' % (i,)) for i in xrange(n_items)], _unicode),
+		('int', range(n_items), _int)
+	]
+
+	for name, keys, subclass in cases:
+		m = dict((k, i) for i, k in enumerate(keys))
+
+		pointless.serialize(m, 'benchmark_lookup_%s_map.map' % (name,))
+		root_m = pointless.Pointless('benchmark_lookup_%s_map.map' % (name,)).GetRoot()
+
+		pointless.serialize(set(keys), 'benchmark_lookup_%s_set.map' % (name,))
+		root_s = pointless.Pointless('benchmark_lookup_%s_set.map' % (name,)).GetRoot()
+
+		fast = list(keys)
+		generic = map(subclass, keys)
+		prepared = map(pointless.Key, keys)
+
+		def map_getitem(queries):
+			for q in queries:
+				root_m[q]
+
+		def map_get(queries):
+			for q in queries:
+				root_m.get(q)
+
+		def set_contains(queries):
+			for q in queries:
+				q in root_s
+
+		for op_name, f in [('map[k]', map_getitem), ('map.get(k)', map_get), ('k in set', set_contains)]:
+			t_generic = bench('%s %s, generic' % (name, op_name), f, generic, n_rounds)
+			t_fast = bench('%s %s, fast' % (name, op_name), f, fast, n_rounds)
+			t_prepared = bench('%s %s, prepared' % (name, op_name), f, prepared, n_rounds)
+			print '%-40s %8.2fx' % ('%s %s, speedup' % (name, op_name), t_generic / t_fast)
+			print '%-40s %8.2fx' % ('%s %s, prepared speedup' % (name, op_name), t_generic / t_prepared)
+
+if __name__ == '__main__':
+	main()
@@ -141,56 +141,1635 @@ void create_set(pointless_create_t* c)
 	pointless_create_set_root(c, set_handle);
 }
 
+void create_set_bloom(pointless_create_t* c)
+{
+	pointless_create_bloom_threshold(c, 1);
+	create_set(c);
+}
+
+void create_set_compact(pointless_create_t* c)
+{
+	pointless_create_compact_hash_tables(c, 1);
+	create_set(c);
+}
+
 void query_set(pointless_t* p)
 {
-	pointless_value_t* set = pointless_root(p);
+	pointless_value_t* set = pointless_root(p);
+	const char* error = 0;
+
+	if (set->type != POINTLESS_SET_VALUE) {
+		fprintf(stderr, "root is not a set\n");
+		exit(EXIT_FAILURE);
+	}
+
+	uint32_t i;
+	int32_t c;
+
+	for (i = 0; i < N_INTEGERS; i++) {
+		pointless_value_t k;
+
+		if (SET_DUPLICATES) {
+			k = i < (N_INTEGERS / 2) ? pointless_value_create_as_read_u32(i) : pointless_value_create_as_read_float((float)i * 0.5f);
+		} else {
+			k = pointless_value_create_as_read_u32(i);
+		}
+
+		pointless_value_t* kk = 0;
+		pointless_reader_set_lookup(p, set, &k, &kk, &error);
+
+		if (error) {
+			fprintf(stderr, "pointless_reader_set_contains(): %s\n", error);
+			exit(EXIT_FAILURE);
+		}
+
+		if (kk == 0) {
+			fprintf(stderr, "set does not contain the expected value\n");
+			exit(EXIT_FAILURE);	
+		}
+
+		// they must be equal
+		pointless_complete_value_t _k = pointless_value_to_complete(&k);
+		pointless_complete_value_t _kk = pointless_value_to_complete(kk);
+		c = pointless_cmp_reader(0, &_k, p, &_kk, &error);
+
+		if (error) {
+			fprintf(stderr, "pointless_cmp_reader(): %s\n", error);
+			exit(EXIT_FAILURE);
+		}
+
+		if (c != 0) {
+			fprintf(stderr, "containment query did not return an equivalent item\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	// same queries with prepared keys, plus a miss
+	if (!SET_DUPLICATES) {
+		for (i = 0; i <= N_INTEGERS; i++) {
+			pointless_prepared_key_t k;
+			pointless_value_t* kk = 0;
+
+			if (!pointless_prepared_key_init_int(&k, (int64_t)i)) {
+				fprintf(stderr, "pointless_prepared_key_init_int(): failure\n");
+				exit(EXIT_FAILURE);
+			}
+
+			pointless_reader_set_lookup_prepared(p, set, &k, &kk);
+
+			if ((kk != 0) != (i < N_INTEGERS)) {
+				fprintf(stderr, "pointless_reader_set_lookup_prepared(): unexpected result\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+}
+
+// every byte of the file is in a category, and every heap object but the empty key vectors of dense maps is reached
+// from the root, or is the symbol table
+void query_anatomy(pointless_t* p)
+{
+	pointless_anatomy_t a;
+	const char* error = 0;
+	uint64_t n_bytes = 0, n_objects = 0, n_entry_bytes = 0;
+	uint32_t i;
+
+	if (!pointless_anatomy(p, &a, &error)) {
+		fprintf(stderr, "pointless_anatomy() failure: %s\n", error);
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < POINTLESS_ANATOMY_N_CATEGORIES; i++) {
+		n_bytes += a.n_bytes[i];
+
+		if (i > POINTLESS_ANATOMY_PADDING)
+			n_objects += a.n_objects[i];
+	}
+
+	for (i = 0; i < a.n_entries; i++)
+		n_entry_bytes += a.entries[i].n_bytes;
+
+	uint64_t n_file_bytes = (p->fd == 0) ? p->buflen : p->fd_len;
+	uint64_t n_heap_objects = (uint64_t)p->header->n_string_unicode + p->header->n_vector + p->header->n_bitvector + p->header->n_set + p->header->n_map;
+
+	if (n_bytes != n_file_bytes || n_objects > n_heap_objects || n_entry_bytes > n_bytes) {
+		fprintf(stderr, "pointless_anatomy(): unexpected totals\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if ((a.n_entries != 0) != (pointless_root(p)->type == POINTLESS_MAP_VALUE_VALUE) || (a.n_entries != 0 && a.n_entries != pointless_reader_map_n_items(p, pointless_root(p)))) {
+		fprintf(stderr, "pointless_anatomy(): unexpected entries\n");
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_anatomy_free(&a);
+}
+
+static int query_hash_table_stats_cb(pointless_t* p, pointless_value_t* v, pointless_hash_table_stats_t* stats, void* user)
+{
+	pointless_hash_table_stats_t* sum = (pointless_hash_table_stats_t*)user;
+
+	if (stats->n_tables != 1 || stats->n_items > stats->n_buckets || stats->n_probes < stats->n_items || stats->n_collisions > stats->n_items) {
+		fprintf(stderr, "pointless_hash_table_stats_all(): unexpected table\n");
+		exit(EXIT_FAILURE);
+	}
+
+	sum->n_tables += stats->n_tables;
+	sum->n_items += stats->n_items;
+	sum->n_probes += stats->n_probes;
+	sum->n_empty_bytes += stats->n_empty_bytes;
+	return 1;
+}
+
+void query_hash_table_stats(pointless_t* p)
+{
+	pointless_hash_table_stats_t sets, maps, sum, stats;
+	const char* error = 0;
+
+	memset(&sum, 0, sizeof(sum));
+
+	if (!pointless_hash_table_stats_all(p, query_hash_table_stats_cb, &sum, &sets, &maps, &error)) {
+		fprintf(stderr, "pointless_hash_table_stats_all() failure: %s\n", error);
+		exit(EXIT_FAILURE);
+	}
+
+	// the totals are the sums over all sets and maps
+	if (sum.n_tables != p->header->n_set + p->header->n_map || sets.n_tables != p->header->n_set || maps.n_tables != p->header->n_map) {
+		fprintf(stderr, "pointless_hash_table_stats_all(): unexpected number of tables\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (sum.n_items != sets.n_items + maps.n_items || sum.n_probes != sets.n_probes + maps.n_probes || sum.n_empty_bytes < sets.n_empty_bytes + maps.n_empty_bytes) {
+		fprintf(stderr, "pointless_hash_table_stats_all(): unexpected totals\n");
+		exit(EXIT_FAILURE);
+	}
+
+	// the empty bytes of the totals are the empty slots of the file, shared schemas counting once
+	pointless_anatomy_t a;
+
+	if (!pointless_anatomy(p, &a, &error)) {
+		fprintf(stderr, "pointless_anatomy() failure: %s\n", error);
+		exit(EXIT_FAILURE);
+	}
+
+	if (a.n_bytes[POINTLESS_ANATOMY_EMPTY_SLOTS] != sets.n_empty_bytes + maps.n_empty_bytes) {
+		fprintf(stderr, "pointless_hash_table_stats_all(): empty bytes differ from pointless_anatomy()\n");
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_anatomy_free(&a);
+
+	// small integers hash to themselves, so each key of a set or map of them is in its first bucket
+	pointless_value_t* root = pointless_root(p);
+
+	if (root->type != POINTLESS_SET_VALUE && root->type != POINTLESS_MAP_VALUE_VALUE)
+		return;
+
+	if (!pointless_hash_table_stats(p, root, &stats, &error)) {
+		fprintf(stderr, "pointless_hash_table_stats() failure: %s\n", error);
+		exit(EXIT_FAILURE);
+	}
+
+	if (stats.n_items != N_INTEGERS || stats.n_probes != N_INTEGERS || stats.max_probe_len != 1 || stats.n_collisions != 0 || stats.n_empty_bytes == 0) {
+		fprintf(stderr, "pointless_hash_table_stats(): unexpected result\n");
+		exit(EXIT_FAILURE);
+	}
+
+	uint32_t layout = POINTLESS_HASH_TABLE_LAYOUT_REGULAR;
+
+	if (root->type == POINTLESS_SET_VALUE ? pointless_reader_set_is_compact(p, root) : pointless_reader_map_is_compact(p, root))
+		layout = POINTLESS_HASH_TABLE_LAYOUT_COMPACT;
+	else if (root->type == POINTLESS_MAP_VALUE_VALUE && pointless_reader_map_is_dense(p, root))
+		layout = POINTLESS_HASH_TABLE_LAYOUT_DENSE;
+
+	if (stats.layout != layout) {
+		fprintf(stderr, "pointless_hash_table_stats(): unexpected layout\n");
+		exit(EXIT_FAILURE);
+	}
+}
+
+#define N_HASH_TABLES 4
+
+// two sets, then two maps with the same keys, sharing a schema
+void create_hash_tables(pointless_create_t* c)
+{
+	uint32_t i, j, root, tables[N_HASH_TABLES], handle = 0;
+
+	pointless_create_shared_schemas(c, 1);
+	root = pointless_create_vector_value(c);
+	CHECK_HANDLE(root);
+
+	for (j = 0; j < N_HASH_TABLES; j++) {
+		tables[j] = (j < 2) ? pointless_create_set(c) : pointless_create_map(c);
+		CHECK_HANDLE(tables[j]);
+
+		for (i = 0; i < N_INTEGERS && handle != POINTLESS_CREATE_VALUE_FAIL; i++) {
+			if (j < 2)
+				handle = pointless_create_set_add(c, tables[j], pointless_create_u32(c, i * (j + 1)));
+			else
+				handle = pointless_create_map_add(c, tables[j], pointless_create_u32(c, i), pointless_create_u32(c, i * j));
+		}
+
+		if (handle == POINTLESS_CREATE_VALUE_FAIL || pointless_create_vector_value_append(c, root, tables[j]) == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_xxx(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	pointless_create_set_root(c, root);
+}
+
+static int query_hash_tables_stop_cb(pointless_t* p, pointless_value_t* v, pointless_hash_table_stats_t* stats, void* user)
+{
+	uint32_t* n_visited = (uint32_t*)user;
+
+	if (v->type != POINTLESS_SET_VALUE) {
+		fprintf(stderr, "pointless_hash_table_stats_all(): visited a map after being stopped\n");
+		exit(EXIT_FAILURE);
+	}
+
+	*n_visited += 1;
+	return 0;
+}
+
+// stopping on the first set stops the walk, maps included
+void query_hash_tables_stop(pointless_t* p)
+{
+	pointless_hash_table_stats_t sets, maps;
+	const char* error = 0;
+	uint32_t n_visited = 0;
+
+	if (!pointless_hash_table_stats_all(p, query_hash_tables_stop_cb, &n_visited, &sets, &maps, &error)) {
+		fprintf(stderr, "pointless_hash_table_stats_all() failure: %s\n", error);
+		exit(EXIT_FAILURE);
+	}
+
+	if (n_visited != 1 || sets.n_tables != 1 || maps.n_tables != 0 || maps.n_items != 0) {
+		fprintf(stderr, "pointless_hash_table_stats_all(): did not stop after the first set\n");
+		exit(EXIT_FAILURE);
+	}
+}
+
+void create_map_typed(pointless_create_t* c)
+{
+	uint32_t i, map_handle;
+
+	pointless_create_typed_hash_tables(c, 1);
+	map_handle = pointless_create_map(c);
+
+	if (map_handle == POINTLESS_CREATE_VALUE_FAIL) {
+		fprintf(stderr, "pointless_create_map(): out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	// u8 keys, u16 values
+	for (i = 0; i < N_INTEGERS; i++) {
+		uint32_t k = pointless_create_u32(c, i);
+		uint32_t v = pointless_create_u32(c, i * 1000);
+
+		if (k == POINTLESS_CREATE_VALUE_FAIL || v == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_u32(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+
+		if (!pointless_create_map_add(c, map_handle, k, v)) {
+			fprintf(stderr, "pointless_create_map_add(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	pointless_create_set_root(c, map_handle);
+}
+
+void query_map_typed(pointless_t* p)
+{
+	pointless_value_t* map = pointless_root(p);
+	const char* error = 0;
+
+	if (map->type != POINTLESS_MAP_VALUE_VALUE) {
+		fprintf(stderr, "root is not a map\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (pointless_map_key_vector(p, map)->type != POINTLESS_VECTOR_U8 || pointless_map_value_vector(p, map)->type != POINTLESS_VECTOR_U16) {
+		fprintf(stderr, "map key/value vectors are not typed\n");
+		exit(EXIT_FAILURE);
+	}
+
+	uint32_t i;
+
+	// all keys, plus a miss, with plain and prepared keys
+	for (i = 0; i <= N_INTEGERS; i++) {
+		pointless_value_t k = pointless_value_create_as_read_u32(i);
+		pointless_prepared_key_t pk;
+		uint32_t entry = pointless_reader_map_probe(p, map, &k, &error);
+
+		if (error) {
+			fprintf(stderr, "pointless_reader_map_probe(): %s\n", error);
+			exit(EXIT_FAILURE);
+		}
+
+		if (!pointless_prepared_key_init_int(&pk, (int64_t)i) || pointless_reader_map_probe_prepared(p, map, &pk) != entry) {
+			fprintf(stderr, "pointless_reader_map_probe_prepared(): unexpected result\n");
+			exit(EXIT_FAILURE);
+		}
+
+		if ((entry != POINTLESS_HASH_TABLE_PROBE_MISS) != (i < N_INTEGERS)) {
+			fprintf(stderr, "pointless_reader_map_probe(): unexpected result\n");
+			exit(EXIT_FAILURE);
+		}
+
+		if (entry == POINTLESS_HASH_TABLE_PROBE_MISS)
+			continue;
+
+		pointless_complete_value_t kk = pointless_reader_vector_value_case(p, pointless_map_key_vector(p, map), entry);
+		pointless_complete_value_t vv = pointless_reader_vector_value_case(p, pointless_map_value_vector(p, map), entry);
+
+		if (pointless_complete_value_get_as_u64(kk.type, &kk.complete_data) != i || pointless_complete_value_get_as_u64(vv.type, &vv.complete_data) != i * 1000) {
+			fprintf(stderr, "map lookup did not return the expected key/value\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+}
+
+void create_map_dense(pointless_create_t* c)
+{
+	uint32_t i, map_handle;
+
+	pointless_create_dense_maps(c, 1);
+	map_handle = pointless_create_map(c);
+
+	if (map_handle == POINTLESS_CREATE_VALUE_FAIL) {
+		fprintf(stderr, "pointless_create_map(): out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	// even keys from -N_INTEGERS, every other integer in the range is missing
+	for (i = 0; i < N_INTEGERS; i++) {
+		uint32_t k = pointless_create_i32(c, (int32_t)(i * 2) - N_INTEGERS);
+		uint32_t v = pointless_create_u32(c, i);
+
+		if (k == POINTLESS_CREATE_VALUE_FAIL || v == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_xxx(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+
+		if (!pointless_create_map_add(c, map_handle, k, v)) {
+			fprintf(stderr, "pointless_create_map_add(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	pointless_create_set_root(c, map_handle);
+}
+
+void query_map_dense(pointless_t* p)
+{
+	pointless_value_t* map = pointless_root(p);
+	const char* error = 0;
+
+	if (map->type != POINTLESS_MAP_VALUE_VALUE || !pointless_reader_map_is_dense(p, map)) {
+		fprintf(stderr, "root is not a dense map\n");
+		exit(EXIT_FAILURE);
+	}
+
+	int32_t i;
+
+	// all integers in and around the key range
+	for (i = -N_INTEGERS - 2; i < N_INTEGERS + 2; i++) {
+		pointless_value_t k = pointless_value_create_as_read_i32(i);
+		pointless_prepared_key_t pk;
+		uint32_t entry = pointless_reader_map_probe(p, map, &k, &error);
+		uint32_t is_key = (-N_INTEGERS <= i && i < N_INTEGERS && i % 2 == 0);
+
+		if (error) {
+			fprintf(stderr, "pointless_reader_map_probe(): %s\n", error);
+			exit(EXIT_FAILURE);
+		}
+
+		if (!pointless_prepared_key_init_int(&pk, (int64_t)i) || pointless_reader_map_probe_prepared(p, map, &pk) != entry) {
+			fprintf(stderr, "pointless_reader_map_probe_prepared(): unexpected result\n");
+			exit(EXIT_FAILURE);
+		}
+
+		if ((entry != POINTLESS_HASH_TABLE_PROBE_MISS) != is_key) {
+			fprintf(stderr, "pointless_reader_map_probe(): unexpected result\n");
+			exit(EXIT_FAILURE);
+		}
+
+		if (entry == POINTLESS_HASH_TABLE_PROBE_MISS)
+			continue;
+
+		// keys are read back as I32 or U32, depending on their sign
+		pointless_complete_value_t kk = pointless_reader_map_key(p, map, entry);
+		pointless_complete_value_t vv = pointless_reader_map_value(p, map, entry);
+		pointless_complete_value_t ek = pointless_complete_value_create_as_read_i32(i);
+		pointless_complete_value_t ev = pointless_complete_value_create_as_read_u32((uint32_t)(i + N_INTEGERS) / 2);
+
+		if (pointless_cmp_reader_acyclic(p, &kk, p, &ek) != 0 || pointless_cmp_reader_acyclic(p, &vv, p, &ev) != 0) {
+			fprintf(stderr, "map lookup did not return the expected key/value\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+}
+
+static const char* shared_schema_keys[] = {"id", "name", "score"};
+
+#define N_SHARED_SCHEMA_MAPS 8
+#define N_SHARED_SCHEMA_KEYS (sizeof(shared_schema_keys) / sizeof(shared_schema_keys[0]))
+
+void create_map_shared_schema(pointless_create_t* c)
+{
+	uint32_t i, j, map_handle, vector_handle;
+
+	pointless_create_shared_schemas(c, 1);
+	vector_handle = pointless_create_vector_value(c);
+
+	if (vector_handle == POINTLESS_CREATE_VALUE_FAIL) {
+		fprintf(stderr, "pointless_create_vector_value(): out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	// maps with the same keys, in the same order, and different values
+	for (i = 0; i < N_SHARED_SCHEMA_MAPS; i++) {
+		map_handle = pointless_create_map(c);
+
+		if (map_handle == POINTLESS_CREATE_VALUE_FAIL || pointless_create_vector_value_append(c, vector_handle, map_handle) == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_map(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+
+		for (j = 0; j < N_SHARED_SCHEMA_KEYS; j++) {
+			uint32_t k = pointless_create_string_ascii(c, (uint8_t*)shared_schema_keys[j]);
+			uint32_t v = pointless_create_u32(c, i * N_SHARED_SCHEMA_KEYS + j);
+
+			if (k == POINTLESS_CREATE_VALUE_FAIL || v == POINTLESS_CREATE_VALUE_FAIL) {
+				fprintf(stderr, "pointless_create_xxx(): out of memory\n");
+				exit(EXIT_FAILURE);
+			}
+
+			if (!pointless_create_map_add(c, map_handle, k, v)) {
+				fprintf(stderr, "pointless_create_map_add(): out of memory\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+
+	pointless_create_set_root(c, vector_handle);
+}
+
+void query_map_shared_schema(pointless_t* p)
+{
+	pointless_value_t* root = pointless_root(p);
+	uint32_t i, j;
+
+	if (root->type != POINTLESS_VECTOR_VALUE || pointless_reader_vector_n_items(p, root) != N_SHARED_SCHEMA_MAPS) {
+		fprintf(stderr, "root is not a vector of maps\n");
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_value_t* maps = pointless_reader_vector_value(p, root);
+
+	for (i = 0; i < N_SHARED_SCHEMA_MAPS; i++) {
+		// all maps point to the hash and key vectors of the first one
+		if (pointless_reader_vector_u32(p, pointless_map_hash_vector(p, &maps[i])) != pointless_reader_vector_u32(p, pointless_map_hash_vector(p, &maps[0])) || pointless_reader_vector_value(p, pointless_map_key_vector(p, &maps[i])) != pointless_reader_vector_value(p, pointless_map_key_vector(p, &maps[0]))) {
+			fprintf(stderr, "maps do not share their hash and key vectors\n");
+			exit(EXIT_FAILURE);
+		}
+
+		if (i > 0 && pointless_reader_vector_value(p, pointless_map_value_vector(p, &maps[i])) == pointless_reader_vector_value(p, pointless_map_value_vector(p, &maps[0]))) {
+			fprintf(stderr, "maps share their value vectors\n");
+			exit(EXIT_FAILURE);
+		}
+
+		for (j = 0; j < N_SHARED_SCHEMA_KEYS; j++) {
+			pointless_prepared_key_t pk;
+			pointless_prepared_key_init_string(&pk, (uint8_t*)shared_schema_keys[j]);
+			uint32_t entry = pointless_reader_map_probe_prepared(p, &maps[i], &pk);
+
+			if (entry == POINTLESS_HASH_TABLE_PROBE_MISS) {
+				fprintf(stderr, "pointless_reader_map_probe_prepared(): key not found\n");
+				exit(EXIT_FAILURE);
+			}
+
+			pointless_complete_value_t vv = pointless_reader_map_value(p, &maps[i], entry);
+			pointless_complete_value_t ev = pointless_complete_value_create_as_read_u32(i * N_SHARED_SCHEMA_KEYS + j);
+
+			if (pointless_cmp_reader_acyclic(p, &vv, p, &ev) != 0) {
+				fprintf(stderr, "map lookup did not return the expected value\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+}
+
+static const char* encoded_vector_currencies[] = {"USD", "EUR", "ISK", "GBP"};
+
+#define N_ENCODED_VECTOR_CURRENCIES (sizeof(encoded_vector_currencies) / sizeof(encoded_vector_currencies[0]))
+#define N_ENCODED_VECTOR_ITEMS 200
+
+void create_vector_encoded(pointless_create_t* c)
+{
+	uint32_t i, root, dictionary, runs, v;
+
+	pointless_create_encoded_vectors(c, 1);
+
+	root = pointless_create_vector_value(c);
+	dictionary = pointless_create_vector_value(c);
+	runs = pointless_create_vector_value(c);
+
+	if (root == POINTLESS_CREATE_VALUE_FAIL || dictionary == POINTLESS_CREATE_VALUE_FAIL || runs == POINTLESS_CREATE_VALUE_FAIL) {
+		fprintf(stderr, "pointless_create_vector_value(): out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	// a few distinct strings, repeated, and two long runs
+	for (i = 0; i < N_ENCODED_VECTOR_ITEMS; i++) {
+		v = pointless_create_string_ascii(c, (uint8_t*)encoded_vector_currencies[i % N_ENCODED_VECTOR_CURRENCIES]);
+
+		if (v == POINTLESS_CREATE_VALUE_FAIL || pointless_create_vector_value_append(c, dictionary, v) == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_string_ascii(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+
+		v = (i < N_ENCODED_VECTOR_ITEMS / 2) ? pointless_create_null(c) : pointless_create_boolean_true(c);
+
+		if (v == POINTLESS_CREATE_VALUE_FAIL || pointless_create_vector_value_append(c, runs, v) == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_xxx(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if (pointless_create_vector_value_append(c, root, dictionary) == POINTLESS_CREATE_VALUE_FAIL || pointless_create_vector_value_append(c, root, runs) == POINTLESS_CREATE_VALUE_FAIL) {
+		fprintf(stderr, "pointless_create_vector_value_append(): out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_create_set_root(c, root);
+}
+
+void query_vector_encoded(pointless_t* p)
+{
+	pointless_value_t* root = pointless_root(p);
+	uint32_t i;
+
+	if (root->type != POINTLESS_VECTOR_VALUE || pointless_reader_vector_n_items(p, root) != 2) {
+		fprintf(stderr, "root is not a vector of two vectors\n");
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_value_t* vectors = pointless_reader_vector_value(p, root);
+
+	if (vectors[0].type != POINTLESS_VECTOR_DICTIONARY || vectors[1].type != POINTLESS_VECTOR_RUNS) {
+		fprintf(stderr, "vectors are not dictionary and run-length encoded\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (pointless_reader_vector_n_items(p, &vectors[0]) != N_ENCODED_VECTOR_ITEMS || pointless_reader_vector_n_items(p, &vectors[1]) != N_ENCODED_VECTOR_ITEMS) {
+		fprintf(stderr, "encoded vectors do not have the expected number of items\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < N_ENCODED_VECTOR_ITEMS; i++) {
+		pointless_complete_value_t s = pointless_reader_vector_value_case(p, &vectors[0], i);
+		pointless_complete_value_t r = pointless_reader_vector_value_case(p, &vectors[1], i);
+		pointless_value_t _s = pointless_value_from_complete(&s);
+
+		if (s.type != POINTLESS_STRING_ || strcmp((const char*)pointless_reader_string_value_ascii(p, &_s), encoded_vector_currencies[i % N_ENCODED_VECTOR_CURRENCIES]) != 0) {
+			fprintf(stderr, "dictionary encoded vector did not return the expected string\n");
+			exit(EXIT_FAILURE);
+		}
+
+		if (r.type != ((i < N_ENCODED_VECTOR_ITEMS / 2) ? POINTLESS_NULL : POINTLESS_BOOLEAN)) {
+			fprintf(stderr, "run-length encoded vector did not return the expected value\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+}
+
+static const char* string_inline_keys[] = {"", "a", "ab", "abc", "abcd", "pointless"};
+
+#define N_STRING_INLINE_KEYS (sizeof(string_inline_keys) / sizeof(string_inline_keys[0]))
+
+void create_string_inline(pointless_create_t* c)
+{
+	uint32_t i, root, map, k, v;
+
+	pointless_create_inline_strings(c, 1);
+
+	root = pointless_create_vector_value(c);
+	map = pointless_create_map(c);
+
+	if (root == POINTLESS_CREATE_VALUE_FAIL || map == POINTLESS_CREATE_VALUE_FAIL) {
+		fprintf(stderr, "pointless_create_xxx(): out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	// short strings are inline, the others on the heap, as keys and as items
+	for (i = 0; i < N_STRING_INLINE_KEYS; i++) {
+		k = pointless_create_string_ascii(c, (uint8_t*)string_inline_keys[i]);
+		v = pointless_create_u32(c, i);
+
+		if (k == POINTLESS_CREATE_VALUE_FAIL || v == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_xxx(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+
+		if (pointless_create_map_add(c, map, k, v) == POINTLESS_CREATE_VALUE_FAIL || pointless_create_vector_value_append(c, root, k) == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_xxx(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if (pointless_create_vector_value_append(c, root, map) == POINTLESS_CREATE_VALUE_FAIL) {
+		fprintf(stderr, "pointless_create_vector_value_append(): out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_create_set_root(c, root);
+}
+
+void query_string_inline(pointless_t* p)
+{
+	pointless_value_t* root = pointless_root(p);
+	uint32_t i, v;
+
+	if (root->type != POINTLESS_VECTOR_VALUE || pointless_reader_vector_n_items(p, root) != N_STRING_INLINE_KEYS + 1) {
+		fprintf(stderr, "root is not a vector of strings and a map\n");
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_value_t* items = pointless_reader_vector_value(p, root);
+	pointless_value_t* map = &items[N_STRING_INLINE_KEYS];
+
+	if (p->header->n_string_unicode != 2) {
+		fprintf(stderr, "short strings were stored on the heap\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < N_STRING_INLINE_KEYS; i++) {
+		uint32_t is_inline = (strlen(string_inline_keys[i]) <= POINTLESS_STRING_INLINE_MAX_LEN);
+
+		if (items[i].type != (is_inline ? POINTLESS_STRING_INLINE : POINTLESS_STRING_)) {
+			fprintf(stderr, "string does not have the expected type\n");
+			exit(EXIT_FAILURE);
+		}
+
+		if (strcmp((const char*)pointless_reader_string_value_ascii(p, &items[i]), string_inline_keys[i]) != 0 || pointless_reader_string_len(p, &items[i]) != strlen(string_inline_keys[i])) {
+			fprintf(stderr, "string does not have the expected value\n");
+			exit(EXIT_FAILURE);
+		}
+
+		// plain and prepared lookups
+		pointless_prepared_key_t pk;
+		pointless_prepared_key_init_string(&pk, (uint8_t*)string_inline_keys[i]);
+
+		if (!pointless_get_mapping_string_to_u32(p, map, (char*)string_inline_keys[i], &v) || v != i) {
+			fprintf(stderr, "pointless_get_mapping_string_to_u32(): unexpected result\n");
+			exit(EXIT_FAILURE);
+		}
+
+		if (pointless_reader_map_probe_prepared(p, map, &pk) == POINTLESS_HASH_TABLE_PROBE_MISS) {
+			fprintf(stderr, "pointless_reader_map_probe_prepared(): unexpected result\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if (pointless_get_mapping_string_to_u32(p, map, (char*)"abd", &v)) {
+		fprintf(stderr, "pointless_get_mapping_string_to_u32(): found a missing key\n");
+		exit(EXIT_FAILURE);
+	}
+}
+
+#define N_SPLIT_VECTOR_ITEMS 100
+
+// a mixed vector, cycling through nulls, strings, integers and floats, and a uniform one of distinct strings
+static uint32_t split_vector_item(pointless_create_t* c, uint32_t i, int is_uniform)
+{
+	char buffer[32];
+	sprintf(buffer, "item_%u", (unsigned int)i);
+
+	if (is_uniform)
+		return pointless_create_string_ascii(c, (uint8_t*)buffer);
+
+	switch (i % 4) {
+		case 0:
+			return pointless_create_null(c);
+		case 1:
+			return pointless_create_string_ascii(c, (uint8_t*)buffer);
+		case 2:
+			return pointless_create_i32(c, -(int32_t)i);
+	}
+
+	return pointless_create_float(c, (float)i + 0.5f);
+}
+
+void create_vector_split(pointless_create_t* c)
+{
+	uint32_t i, j, root, vectors[2], v;
+
+	pointless_create_split_vectors(c, 1);
+
+	root = pointless_create_vector_value(c);
+
+	if (root == POINTLESS_CREATE_VALUE_FAIL) {
+		fprintf(stderr, "pointless_create_vector_value(): out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (j = 0; j < 2; j++) {
+		vectors[j] = pointless_create_vector_value(c);
+
+		if (vectors[j] == POINTLESS_CREATE_VALUE_FAIL || pointless_create_vector_value_append(c, root, vectors[j]) == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_vector_value(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+
+		for (i = 0; i < N_SPLIT_VECTOR_ITEMS; i++) {
+			v = split_vector_item(c, i, j);
+
+			if (v == POINTLESS_CREATE_VALUE_FAIL || pointless_create_vector_value_append(c, vectors[j], v) == POINTLESS_CREATE_VALUE_FAIL) {
+				fprintf(stderr, "pointless_create_xxx(): out of memory\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+
+	pointless_create_set_root(c, root);
+}
+
+void query_vector_split(pointless_t* p)
+{
+	pointless_value_t* root = pointless_root(p);
+	uint32_t i, j, n_nulls = 0;
+
+	if (root->type != POINTLESS_VECTOR_VALUE || pointless_reader_vector_n_items(p, root) != 2) {
+		fprintf(stderr, "root is not a vector of two vectors\n");
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_value_t* vectors = pointless_reader_vector_value(p, root);
+
+	for (j = 0; j < 2; j++) {
+		if (vectors[j].type != POINTLESS_VECTOR_SPLIT || pointless_reader_vector_n_items(p, &vectors[j]) != N_SPLIT_VECTOR_ITEMS) {
+			fprintf(stderr, "vector is not a split vector of the expected length\n");
+			exit(EXIT_FAILURE);
+		}
+
+		// uniform vectors have a single type
+		if (pointless_reader_vector_n_items(p, pointless_reader_split_vector_types(p, &vectors[j])) != (j ? 1 : N_SPLIT_VECTOR_ITEMS)) {
+			fprintf(stderr, "split vector does not have the expected number of types\n");
+			exit(EXIT_FAILURE);
+		}
+
+		for (i = 0; i < N_SPLIT_VECTOR_ITEMS; i++) {
+			pointless_complete_value_t v = pointless_reader_vector_value_case(p, &vectors[j], i);
+			pointless_complete_value_t e;
+			pointless_value_t _v = pointless_value_from_complete(&v);
+			char buffer[32];
+
+			if (v.type != pointless_reader_split_vector_type(p, &vectors[j], i)) {
+				fprintf(stderr, "split vector item type mismatch\n");
+				exit(EXIT_FAILURE);
+			}
+
+			if (j == 1 || i % 4 == 1) {
+				sprintf(buffer, "item_%u", (unsigned int)i);
+
+				if (v.type != POINTLESS_STRING_ || strcmp((const char*)pointless_reader_string_value_ascii(p, &_v), buffer) != 0) {
+					fprintf(stderr, "split vector did not return the expected string\n");
+					exit(EXIT_FAILURE);
+				}
+
+				continue;
+			}
+
+			switch (i % 4) {
+				case 0:
+					e = pointless_complete_value_create_as_read_null();
+					break;
+				case 2:
+					e = pointless_complete_value_create_as_read_i32(-(int32_t)i);
+					break;
+				default:
+					e = pointless_complete_value_create_as_read_float((float)i + 0.5f);
+					break;
+			}
+
+			if (v.type != e.type || pointless_cmp_reader_acyclic(p, &v, p, &e) != 0) {
+				fprintf(stderr, "split vector did not return the expected value\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+
+	// scans over types only
+	for (i = 0; i < N_SPLIT_VECTOR_ITEMS; i++)
+		n_nulls += (pointless_reader_split_vector_type(p, &vectors[0], i) == POINTLESS_NULL);
+
+	if (n_nulls != N_SPLIT_VECTOR_ITEMS / 4) {
+		fprintf(stderr, "split vector does not have the expected number of NULLs\n");
+		exit(EXIT_FAILURE);
+	}
+}
+
+#define N_BLOCK_VECTOR_ITEMS 1000
+#define N_BLOCK_VECTORS 7
+
+static int16_t block_vector_outside[N_BLOCK_VECTOR_ITEMS];
+
+// expected item 'i' of block vector candidate kind 'k': timestamps, small counters, small negative numbers, numbers
+// using all 64 bits, and a short vector
+static uint64_t block_vector_item(uint32_t i, uint32_t k)
+{
+	switch (k) {
+		case 0:
+			return (uint64_t)(INT64_C(1700000000000) + (int64_t)i * 1000 + i % 7);
+		case 1:
+			return (uint64_t)((i * 37) % 1000);
+		case 2:
+			return (uint64_t)(int64_t)(-500 + (int32_t)(i % 100));
+		case 3:
+			return (uint64_t)i * UINT64_C(0x9E3779B97F4A7C15);
+	}
+
+	return (uint64_t)i;
+}
+
+// kind of the items of each vector: value vectors of each kind, then the counters and small negative numbers as a
+// primitive vector and an outside vector
+static uint32_t block_vector_kinds[N_BLOCK_VECTORS] = {0, 1, 2, 3, 4, 1, 2};
+
+void create_vector_blocks(pointless_create_t* c)
+{
+	uint32_t i, j, k, root, vectors[N_BLOCK_VECTORS], v = 0;
+
+	pointless_create_block_vectors(c, 1);
+
+	for (i = 0; i < N_BLOCK_VECTOR_ITEMS; i++)
+		block_vector_outside[i] = (int16_t)(int64_t)block_vector_item(i, 2);
+
+	root = pointless_create_vector_value(c);
+
+	for (j = 0; j < 5; j++)
+		vectors[j] = pointless_create_vector_value(c);
+
+	vectors[5] = pointless_create_vector_u32(c);
+	vectors[6] = pointless_create_vector_i16_owner(c, block_vector_outside, N_BLOCK_VECTOR_ITEMS);
+
+	for (j = 0; j < N_BLOCK_VECTORS; j++) {
+		if (root == POINTLESS_CREATE_VALUE_FAIL || vectors[j] == POINTLESS_CREATE_VALUE_FAIL || pointless_create_vector_value_append(c, root, vectors[j]) == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_vector_xxx(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	for (i = 0; i < N_BLOCK_VECTOR_ITEMS; i++) {
+		for (j = 0; j < 5; j++) {
+			k = block_vector_kinds[j];
+
+			if (k == 4 && i >= 10)
+				continue;
+
+			if (k == 2)
+				v = pointless_create_i32(c, (int32_t)(int64_t)block_vector_item(i, k));
+			else if (k == 0)
+				v = pointless_create_i64(c, (int64_t)block_vector_item(i, k));
+			else
+				v = pointless_create_u64(c, block_vector_item(i, k));
+
+			if (v == POINTLESS_CREATE_VALUE_FAIL || pointless_create_vector_value_append(c, vectors[j], v) == POINTLESS_CREATE_VALUE_FAIL)
+				break;
+		}
+
+		if (j < 5)
+			break;
+
+		if (pointless_create_vector_u32_append(c, vectors[5], (uint32_t)block_vector_item(i, 1)) == POINTLESS_CREATE_VALUE_FAIL)
+			break;
+	}
+
+	if (i < N_BLOCK_VECTOR_ITEMS) {
+		fprintf(stderr, "pointless_create_xxx(): out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_create_set_root(c, root);
+}
+
+void query_vector_blocks(pointless_t* p)
+{
+	pointless_value_t* root = pointless_root(p);
+	uint32_t i, j, k;
+
+	// the 64-bit numbers do not get smaller, the short vector is too short, and vectors created as primitive vectors
+	// are never block vectors
+	static uint32_t types[N_BLOCK_VECTORS] = {POINTLESS_VECTOR_BLOCKS, POINTLESS_VECTOR_BLOCKS, POINTLESS_VECTOR_BLOCKS, POINTLESS_VECTOR_U64, POINTLESS_VECTOR_U8, POINTLESS_VECTOR_U32, POINTLESS_VECTOR_I16};
+	static uint32_t item_types[3] = {POINTLESS_VECTOR_U64, POINTLESS_VECTOR_U16, POINTLESS_VECTOR_I16};
+
+	if (root->type != POINTLESS_VECTOR_VALUE || pointless_reader_vector_n_items(p, root) != N_BLOCK_VECTORS) {
+		fprintf(stderr, "root is not a vector of %u vectors\n", (unsigned int)N_BLOCK_VECTORS);
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_value_t* vectors = pointless_reader_vector_value(p, root);
+
+	for (j = 0; j < N_BLOCK_VECTORS; j++) {
+		k = block_vector_kinds[j];
+		uint32_t n_items = (k == 4) ? 10 : N_BLOCK_VECTOR_ITEMS;
+
+		if (vectors[j].type != types[j] || pointless_reader_vector_n_items(p, &vectors[j]) != n_items) {
+			fprintf(stderr, "vector %u is not of the expected type and length\n", (unsigned int)j);
+			exit(EXIT_FAILURE);
+		}
+
+		if (j < 3 && pointless_reader_block_vector_item_type(p, &vectors[j]) != item_types[j]) {
+			fprintf(stderr, "block vector %u does not have the expected item type\n", (unsigned int)j);
+			exit(EXIT_FAILURE);
+		}
+
+		for (i = 0; i < n_items; i++) {
+			pointless_complete_value_t v = pointless_reader_vector_value_case(p, &vectors[j], i);
+			pointless_complete_value_t e;
+
+			// positive 64-bit numbers are read as unsigned
+			switch (k) {
+				case 0:
+				case 3:
+					e = pointless_complete_value_create_as_read_u64(block_vector_item(i, k));
+					break;
+				case 2:
+					e = pointless_complete_value_create_as_read_i32((int32_t)(int64_t)block_vector_item(i, k));
+					break;
+				default:
+					e = pointless_complete_value_create_as_read_u32((uint32_t)block_vector_item(i, k));
+					break;
+			}
+
+			if (v.type != e.type || pointless_cmp_reader_acyclic(p, &v, p, &e) != 0) {
+				fprintf(stderr, "vector %u did not return the expected item %u\n", (unsigned int)j, (unsigned int)i);
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+}
+
+#define N_STRING_SYMBOLS_KEYS 300
+
+static void string_symbols_key(uint32_t i, char* buffer)
+{
+	sprintf(buffer, "https://www.example.com/hotels/%u/rooms?lang=%s", (unsigned int)(i * 7919), (i % 2) ? "en" : "de");
+}
+
+void create_string_symbols(pointless_create_t* c)
+{
+	uint32_t i, root, map, k, v;
+	char buffer[512];
+
+	pointless_create_string_symbols(c, 1);
+
+	root = pointless_create_vector_value(c);
+	map = pointless_create_map(c);
+
+	if (root == POINTLESS_CREATE_VALUE_FAIL || map == POINTLESS_CREATE_VALUE_FAIL) {
+		fprintf(stderr, "pointless_create_xxx(): out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	// similar strings as items and keys, and a string too long to be compressed
+	for (i = 0; i <= N_STRING_SYMBOLS_KEYS; i++) {
+		if (i < N_STRING_SYMBOLS_KEYS) {
+			string_symbols_key(i, buffer);
+		} else {
+			memset(buffer, 'x', 300);
+			buffer[300] = 0;
+		}
+
+		k = pointless_create_string_ascii(c, (uint8_t*)buffer);
+		v = pointless_create_u32(c, i);
+
+		if (k == POINTLESS_CREATE_VALUE_FAIL || v == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_xxx(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+
+		if (pointless_create_map_add(c, map, k, v) == POINTLESS_CREATE_VALUE_FAIL || pointless_create_vector_value_append(c, root, k) == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_xxx(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if (pointless_create_vector_value_append(c, root, map) == POINTLESS_CREATE_VALUE_FAIL) {
+		fprintf(stderr, "pointless_create_vector_value_append(): out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_create_set_root(c, root);
+}
+
+void query_string_symbols(pointless_t* p)
+{
+	pointless_value_t* root = pointless_root(p);
+	uint32_t i, v;
+	char buffer[512];
+	uint8_t decoded[POINTLESS_STRING_SYMBOLS_BUFFER_LEN];
+
+	if (root->type != POINTLESS_VECTOR_VALUE || pointless_reader_vector_n_items(p, root) != N_STRING_SYMBOLS_KEYS + 2) {
+		fprintf(stderr, "root is not a vector of strings and a map\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (p->string_symbols == 0 || !(p->header->version & POINTLESS_FF_STRING_SYMBOLS)) {
+		fprintf(stderr, "file has no symbol table\n");
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_value_t* items = pointless_reader_vector_value(p, root);
+	pointless_value_t* map = &items[N_STRING_SYMBOLS_KEYS + 1];
+
+	if (items[N_STRING_SYMBOLS_KEYS].type != POINTLESS_STRING_ || pointless_reader_string_len(p, &items[N_STRING_SYMBOLS_KEYS]) != 300) {
+		fprintf(stderr, "long string was compressed\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < N_STRING_SYMBOLS_KEYS; i++) {
+		string_symbols_key(i, buffer);
+
+		if (items[i].type != POINTLESS_STRING_SYMBOLS) {
+			fprintf(stderr, "string was not compressed\n");
+			exit(EXIT_FAILURE);
+		}
+
+		if (strcmp((const char*)pointless_reader_string_value_ascii_buffer(p, &items[i], decoded), buffer) != 0 || pointless_reader_string_len(p, &items[i]) != strlen(buffer)) {
+			fprintf(stderr, "string does not have the expected value\n");
+			exit(EXIT_FAILURE);
+		}
+
+		// plain and prepared lookups, hashing and comparing the decoded string
+		pointless_prepared_key_t pk;
+		pointless_prepared_key_init_string(&pk, (uint8_t*)buffer);
+
+		if (!pointless_get_mapping_string_to_u32(p, map, buffer, &v) || v != i) {
+			fprintf(stderr, "pointless_get_mapping_string_to_u32(): unexpected result\n");
+			exit(EXIT_FAILURE);
+		}
+
+		if (pointless_reader_map_probe_prepared(p, map, &pk) == POINTLESS_HASH_TABLE_PROBE_MISS) {
+			fprintf(stderr, "pointless_reader_map_probe_prepared(): unexpected result\n");
+			exit(EXIT_FAILURE);
+		}
+
+		// compressed strings compare as their characters
+		if (i > 0) {
+			char prev[512];
+			string_symbols_key(i - 1, prev);
+
+			pointless_complete_value_t a = pointless_value_to_complete(&items[i - 1]);
+			pointless_complete_value_t b = pointless_value_to_complete(&items[i]);
+			int32_t c = pointless_cmp_reader_acyclic(p, &a, p, &b);
+			int32_t e = strcmp(prev, buffer);
+
+			if ((c < 0) != (e < 0) || (c > 0) != (e > 0)) {
+				fprintf(stderr, "pointless_cmp_reader_acyclic(): unexpected result\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+
+	if (pointless_get_mapping_string_to_u32(p, map, (char*)"https://www.example.com/hotels/1/rooms?lang=de", &v)) {
+		fprintf(stderr, "pointless_get_mapping_string_to_u32(): found a missing key\n");
+		exit(EXIT_FAILURE);
+	}
+}
+
+#define N_DELTA_OFFSET_KEYS 40
+
+void create_offsets_delta(pointless_create_t* c)
+{
+	uint32_t i, j, root, k, v;
+	char buffer[32];
+
+	pointless_create_delta_offsets(c, 1);
+
+	root = pointless_create_map(c);
+
+	if (root == POINTLESS_CREATE_VALUE_FAIL) {
+		fprintf(stderr, "pointless_create_map(): out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	// more strings and vectors than fit in one offset block
+	for (i = 0; i < N_DELTA_OFFSET_KEYS; i++) {
+		sprintf(buffer, "key_%u", (unsigned int)i);
+		k = pointless_create_string_ascii(c, (uint8_t*)buffer);
+		v = pointless_create_vector_u32(c);
+
+		if (k == POINTLESS_CREATE_VALUE_FAIL || v == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_xxx(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+
+		for (j = 0; j < i; j++) {
+			if (pointless_create_vector_u32_append(c, v, i * j) == POINTLESS_CREATE_VALUE_FAIL) {
+				fprintf(stderr, "pointless_create_vector_u32_append(): out of memory\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+
+		if (pointless_create_map_add(c, root, k, v) == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_map_add(): failure\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	pointless_create_set_root(c, root);
+}
+
+void query_offsets_delta(pointless_t* p)
+{
+	pointless_value_t* root = pointless_root(p);
+	uint32_t i, j, n_items;
+	uint32_t* items;
+	char buffer[32];
+
+	if (p->version != POINTLESS_FF_VERSION_OFFSET_DELTA_NEWHASH) {
+		fprintf(stderr, "file does not have delta offsets\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < N_DELTA_OFFSET_KEYS; i++) {
+		sprintf(buffer, "key_%u", (unsigned int)i);
+
+		if (!pointless_get_mapping_string_to_vector_u32(p, root, buffer, &items, &n_items) || n_items != i) {
+			fprintf(stderr, "pointless_get_mapping_string_to_vector_u32(): unexpected result\n");
+			exit(EXIT_FAILURE);
+		}
+
+		for (j = 0; j < i; j++) {
+			if (items[j] != i * j) {
+				fprintf(stderr, "vector did not return the expected value\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+}
+
+#define N_MIX_HASH_KEYS 1000
+#define N_MIX_HASH_VECTOR_ITEMS 41
+#define N_MIX_HASH_BITS 100
+
+static const char* mix_hash_anagrams[] = {"abc", "acb", "bac", "bca", "cab", "cba"};
+
+#define N_MIX_HASH_ANAGRAMS (sizeof(mix_hash_anagrams) / sizeof(mix_hash_anagrams[0]))
+
+static void mix_hash_ucs4(const char* s, uint32_t* u)
+{
+	do {
+		*u++ = (uint8_t)*s;
+	} while (*s++);
+}
+
+static void mix_hash_add(pointless_create_t* c, uint32_t map, uint32_t k, uint32_t v)
+{
+	CHECK_HANDLE(k);
+	CHECK_HANDLE(v);
+
+	if (pointless_create_map_add(c, map, k, v) == POINTLESS_CREATE_VALUE_FAIL) {
+		fprintf(stderr, "pointless_create_map_add(): failure\n");
+		exit(EXIT_FAILURE);
+	}
+}
+
+void create_hash_mix(pointless_create_t* c)
+{
+	uint32_t i, root, map, vector, vector_copy, bitvector_copy;
+	uint32_t unicode[32];
+	uint8_t bits[N_MIX_HASH_BITS / 8 + 1];
+	char buffer[32];
+
+	pointless_create_mix_hash(c, 1);
+
+	root = pointless_create_vector_value(c);
+	map = pointless_create_map(c);
+	CHECK_HANDLE(root);
+	CHECK_HANDLE(map);
+
+	// 8-bit and unicode strings
+	for (i = 0; i < N_MIX_HASH_KEYS; i++) {
+		sprintf(buffer, "key_%u", (unsigned int)i);
+		mix_hash_add(c, map, pointless_create_string_ascii(c, (uint8_t*)buffer), pointless_create_u32(c, i));
+
+		sprintf(buffer, "unicode_key_%u", (unsigned int)i);
+		mix_hash_ucs4(buffer, unicode);
+		mix_hash_add(c, map, pointless_create_unicode_ucs4(c, unicode), pointless_create_u32(c, i));
+	}
+
+	for (i = 0; i < N_MIX_HASH_ANAGRAMS; i++)
+		mix_hash_add(c, map, pointless_create_string_ascii(c, (uint8_t*)mix_hash_anagrams[i]), pointless_create_u32(c, i));
+
+	// a unicode string with characters outside 8 bits
+	unicode[0] = 0x3B1;
+	unicode[1] = 0x3B2;
+	unicode[2] = 0;
+	mix_hash_add(c, map, pointless_create_unicode_ucs4(c, unicode), pointless_create_u32(c, 0x3B1));
+
+	// a vector of integers, and the same as a value vector
+	vector = pointless_create_vector_u32(c);
+	vector_copy = pointless_create_vector_value(c);
+	CHECK_HANDLE(vector);
+	CHECK_HANDLE(vector_copy);
+
+	for (i = 0; i < N_MIX_HASH_VECTOR_ITEMS; i++) {
+		if (pointless_create_vector_u32_append(c, vector, i * i) == POINTLESS_CREATE_VALUE_FAIL || pointless_create_vector_value_append(c, vector_copy, pointless_create_u32(c, i * i)) == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_vector_xxx_append(): failure\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	mix_hash_add(c, map, vector, pointless_create_u32(c, 1));
+
+	// zeros followed by ones, normalized to a POINTLESS_BITVECTOR_01 as a key
+	memset(bits, 0, sizeof(bits));
+
+	for (i = N_MIX_HASH_BITS / 2; i < N_MIX_HASH_BITS; i++)
+		bm_set_(bits, i);
+
+	mix_hash_add(c, map, pointless_create_bitvector(c, bits, N_MIX_HASH_BITS), pointless_create_u32(c, 2));
+	bitvector_copy = pointless_create_bitvector_no_normalize(c, bits, N_MIX_HASH_BITS);
+	CHECK_HANDLE(bitvector_copy);
+
+	if (pointless_create_vector_value_append(c, root, map) == POINTLESS_CREATE_VALUE_FAIL ||
+		pointless_create_vector_value_append(c, root, vector_copy) == POINTLESS_CREATE_VALUE_FAIL ||
+		pointless_create_vector_value_append(c, root, bitvector_copy) == POINTLESS_CREATE_VALUE_FAIL) {
+		fprintf(stderr, "pointless_create_vector_value_append(): failure\n");
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_create_set_root(c, root);
+}
+
+static void query_hash_mix_value(pointless_t* p, pointless_value_t* map, pointless_value_t* k, uint32_t expected)
+{
+	pointless_value_t* kk = 0;
+	pointless_value_t* vv = 0;
 	const char* error = 0;
 
-	if (set->type != POINTLESS_SET_VALUE) {
-		fprintf(stderr, "root is not a set\n");
+	pointless_reader_map_lookup(p, map, k, &kk, &vv, &error);
+
+	if (vv == 0 || vv->type != POINTLESS_U32 || vv->data.data_u32 != expected) {
+		fprintf(stderr, "pointless_reader_map_lookup(): unexpected result %s\n", error ? error : "");
 		exit(EXIT_FAILURE);
 	}
+}
 
-	uint32_t i;
-	int32_t c;
+void query_hash_mix(pointless_t* p)
+{
+	pointless_value_t* root = pointless_root(p);
+	pointless_value_t* map = pointless_reader_vector_value(p, root);
+	pointless_prepared_key_t pk;
+	pointless_hash_v2_state_t state;
+	pointless_vector_hash_state_32_t v_state;
+	uint32_t i, j, value, h, hashes[N_MIX_HASH_VECTOR_ITEMS];
+	uint32_t unicode[64];
+	uint16_t unicode_16[32];
+	char buffer[64];
+
+	if (!POINTLESS_FF_VERSION_IS_MIXHASH(p->version)) {
+		fprintf(stderr, "file does not have the version 2 hash\n");
+		exit(EXIT_FAILURE);
+	}
 
-	for (i = 0; i < N_INTEGERS; i++) {
-		pointless_value_t k;
+	// each string is found from an 8-bit, a 32-bit and a 16-bit key
+	for (i = 0; i < N_MIX_HASH_KEYS; i++) {
+		sprintf(buffer, "key_%u", (unsigned int)i);
+		mix_hash_ucs4(buffer, unicode);
 
-		if (SET_DUPLICATES) {
-			k = i < (N_INTEGERS / 2) ? pointless_value_create_as_read_u32(i) : pointless_value_create_as_read_float((float)i * 0.5f);
-		} else {
-			k = pointless_value_create_as_read_u32(i);
+		if (!pointless_get_mapping_string_to_u32(p, map, buffer, &value) || value != i || !pointless_get_mapping_unicode_to_u32(p, map, unicode, &value) || value != i) {
+			fprintf(stderr, "pointless_get_mapping_xxx_to_u32(): unexpected result\n");
+			exit(EXIT_FAILURE);
 		}
 
-		pointless_value_t* kk = 0;
-		pointless_reader_set_lookup(p, set, &k, &kk, &error);
+		sprintf(buffer, "unicode_key_%u", (unsigned int)i);
+		mix_hash_ucs4(buffer, unicode);
 
-		if (error) {
-			fprintf(stderr, "pointless_reader_set_contains(): %s\n", error);
+		for (j = 0; j < 32; j++)
+			unicode_16[j] = (uint16_t)unicode[j];
+
+		pointless_prepared_key_init_unicode_ucs2(&pk, unicode_16);
+
+		if (!pointless_get_mapping_string_to_u32(p, map, buffer, &value) || value != i || !pointless_get_mapping_unicode_to_u32(p, map, unicode, &value) || value != i || pointless_reader_map_probe_prepared(p, map, &pk) == POINTLESS_HASH_TABLE_PROBE_MISS) {
+			fprintf(stderr, "pointless_get_mapping_xxx_to_u32(): unexpected result\n");
 			exit(EXIT_FAILURE);
 		}
+	}
 
-		if (kk == 0) {
-			fprintf(stderr, "set does not contain the expected value\n");
-			exit(EXIT_FAILURE);	
+	unicode[0] = 0x3B1;
+	unicode[1] = 0x3B2;
+	unicode[2] = 0;
+	unicode_16[0] = 0x3B1;
+	unicode_16[1] = 0x3B2;
+	unicode_16[2] = 0;
+	pointless_prepared_key_init_unicode_ucs2(&pk, unicode_16);
+
+	if (!pointless_get_mapping_unicode_to_u32(p, map, unicode, &value) || value != 0x3B1 || pointless_reader_map_probe_prepared(p, map, &pk) == POINTLESS_HASH_TABLE_PROBE_MISS) {
+		fprintf(stderr, "pointless_get_mapping_unicode_to_u32(): unexpected result\n");
+		exit(EXIT_FAILURE);
+	}
+
+	// anagrams collide in the version 0 hash, but not here
+	for (i = 0; i < N_MIX_HASH_ANAGRAMS; i++) {
+		for (j = 0; j < i; j++) {
+			if (pointless_hash_string_v2_32((uint8_t*)mix_hash_anagrams[i]) == pointless_hash_string_v2_32((uint8_t*)mix_hash_anagrams[j])) {
+				fprintf(stderr, "anagrams %s and %s collide\n", mix_hash_anagrams[i], mix_hash_anagrams[j]);
+				exit(EXIT_FAILURE);
+			}
 		}
+	}
 
-		// they must be equal
-		pointless_complete_value_t _k = pointless_value_to_complete(&k);
-		pointless_complete_value_t _kk = pointless_value_to_complete(kk);
-		c = pointless_cmp_reader(0, &_k, p, &_kk, &error);
+	// the hash does not depend on how the bytes are split, and 8-bit unicode strings hash as 8-bit strings
+	sprintf(buffer, "0123456789abcdefghijklmnopqrstuvwxyz");
+	mix_hash_ucs4(buffer, unicode);
 
-		if (error) {
-			fprintf(stderr, "pointless_cmp_reader(): %s\n", error);
+	if (pointless_hash_unicode_ucs4_v2_32(unicode) != pointless_hash_string_v2_32((uint8_t*)buffer)) {
+		fprintf(stderr, "pointless_hash_unicode_ucs4_v2_32(): unexpected hash\n");
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_hash_v2_init(&state, 0);
+	pointless_hash_v2_update(&state, buffer, strlen(buffer));
+	h = pointless_hash_v2_end(&state);
+
+	for (i = 0; i <= strlen(buffer); i++) {
+		pointless_hash_v2_init(&state, 0);
+		pointless_hash_v2_update(&state, buffer, i);
+		pointless_hash_v2_update(&state, buffer + i, strlen(buffer) - i);
+
+		if (pointless_hash_v2_end(&state) != h) {
+			fprintf(stderr, "pointless_hash_v2_update(): hash depends on split at %u\n", (unsigned int)i);
 			exit(EXIT_FAILURE);
 		}
+	}
 
-		if (c != 0) {
-			fprintf(stderr, "containment query did not return an equivalent item\n");
+	// nor on whether vector items come one at a time
+	for (i = 0; i < N_MIX_HASH_VECTOR_ITEMS; i++)
+		hashes[i] = i * i;
+
+	pointless_vector_hash_init_32(&v_state, p->version, N_MIX_HASH_VECTOR_ITEMS);
+	pointless_vector_hash_next_n_32(&v_state, hashes, 3);
+
+	for (i = 3; i < N_MIX_HASH_VECTOR_ITEMS; i++)
+		pointless_vector_hash_next_32(&v_state, hashes[i]);
+
+	if (pointless_vector_hash_end_32(&v_state) != pointless_hash_reader_32(p, pointless_reader_vector_value(p, root) + 1)) {
+		fprintf(stderr, "pointless_vector_hash_next_n_32(): unexpected hash\n");
+		exit(EXIT_FAILURE);
+	}
+
+	// a value vector finds the equal vector of integers, and a full bitvector the equal normalized one
+	query_hash_mix_value(p, map, pointless_reader_vector_value(p, root) + 1, 1);
+	query_hash_mix_value(p, map, pointless_reader_vector_value(p, root) + 2, 2);
+}
+
+#define N_VECTOR_ALIGNED_KEYS 8
+
+void create_vector_aligned(pointless_create_t* c)
+{
+	uint32_t i, j, root, k, v;
+	char buffer[32];
+
+	// cache lines for all vectors, pages for those of at least a page
+	pointless_create_vector_alignment(c, 64, 4096);
+
+	root = pointless_create_map(c);
+
+	if (root == POINTLESS_CREATE_VALUE_FAIL) {
+		fprintf(stderr, "pointless_create_map(): out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < N_VECTOR_ALIGNED_KEYS; i++) {
+		sprintf(buffer, "key_%u", (unsigned int)i);
+		k = pointless_create_string_ascii(c, (uint8_t*)buffer);
+		v = pointless_create_vector_u32(c);
+
+		if (k == POINTLESS_CREATE_VALUE_FAIL || v == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_xxx(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+
+		for (j = 0; j < i * 300; j++) {
+			if (pointless_create_vector_u32_append(c, v, i + j) == POINTLESS_CREATE_VALUE_FAIL) {
+				fprintf(stderr, "pointless_create_vector_u32_append(): out of memory\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+
+		if (pointless_create_map_add(c, root, k, v) == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_map_add(): failure\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	pointless_create_set_root(c, root);
+}
+
+static void query_vector_aligned_priv(pointless_t* p)
+{
+	pointless_value_t* root = pointless_root(p);
+	uint32_t i, j, n_items;
+	uint32_t* items;
+	uint64_t address;
+	char buffer[32];
+
+	if (p->vector_alignment != 64 || p->large_vector_alignment != 4096) {
+		fprintf(stderr, "file does not have the expected vector alignment\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < N_VECTOR_ALIGNED_KEYS; i++) {
+		sprintf(buffer, "key_%u", (unsigned int)i);
+
+		if (!pointless_get_mapping_string_to_vector_u32(p, root, buffer, &items, &n_items) || n_items != i * 300) {
+			fprintf(stderr, "pointless_get_mapping_string_to_vector_u32(): unexpected result\n");
+			exit(EXIT_FAILURE);
+		}
+
+		// the alignment holds in memory, not only in the file
+		address = (uint64_t)(size_t)items;
+
+		if (n_items > 0 && (address % 64 != 0 || (n_items * sizeof(uint32_t) >= 4096 && address % 4096 != 0))) {
+			fprintf(stderr, "vector items are not aligned\n");
+			exit(EXIT_FAILURE);
+		}
+
+		for (j = 0; j < n_items; j++) {
+			if (items[j] != i + j) {
+				fprintf(stderr, "vector did not return the expected value\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+}
+
+// the mapped file, then a copy of it opened as a buffer
+void query_vector_aligned(pointless_t* p)
+{
+	pointless_t b;
+	const char* error = 0;
+
+	query_vector_aligned_priv(p);
+
+	if (!pointless_open_b(&b, p->fd_ptr, p->fd_len, 0, &error)) {
+		fprintf(stderr, "pointless_open_b() failure: %s\n", error);
+		exit(EXIT_FAILURE);
+	}
+
+	query_vector_aligned_priv(&b);
+	pointless_close(&b);
+}
+
+#define N_HEAP_ORDER_KEYS 20
+
+void create_heap_order(pointless_create_t* c)
+{
+	uint32_t i, j, root, k, v, traced = 0;
+	char buffer[32];
+
+	pointless_create_heap_order(c, POINTLESS_CREATE_HEAP_ORDER_DFS);
+
+	root = pointless_create_map(c);
+
+	if (root == POINTLESS_CREATE_VALUE_FAIL) {
+		fprintf(stderr, "pointless_create_map(): out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < N_HEAP_ORDER_KEYS; i++) {
+		sprintf(buffer, "key_%u", (unsigned int)i);
+		k = pointless_create_string_ascii(c, (uint8_t*)buffer);
+		v = pointless_create_vector_u32(c);
+
+		if (k == POINTLESS_CREATE_VALUE_FAIL || v == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_xxx(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+
+		for (j = 0; j <= i; j++) {
+			if (pointless_create_vector_u32_append(c, v, i * j) == POINTLESS_CREATE_VALUE_FAIL) {
+				fprintf(stderr, "pointless_create_vector_u32_append(): out of memory\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+
+		if (pointless_create_map_add(c, root, k, v) == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_map_add(): failure\n");
+			exit(EXIT_FAILURE);
+		}
+
+		if (i == N_HEAP_ORDER_KEYS - 1)
+			traced = v;
+	}
+
+	// the last vector goes first, then the map
+	if (!pointless_create_heap_order_trace(c, &traced, 1)) {
+		fprintf(stderr, "pointless_create_heap_order_trace(): out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_create_set_root(c, root);
+}
+
+void query_heap_order(pointless_t* p)
+{
+	pointless_value_t* root = pointless_root(p);
+	uint32_t i, j, n_items;
+	uint32_t* items;
+	char buffer[32];
+
+	for (i = 0; i < N_HEAP_ORDER_KEYS; i++) {
+		sprintf(buffer, "key_%u", (unsigned int)i);
+
+		if (!pointless_get_mapping_string_to_vector_u32(p, root, buffer, &items, &n_items) || n_items != i + 1) {
+			fprintf(stderr, "pointless_get_mapping_string_to_vector_u32(): unexpected result\n");
+			exit(EXIT_FAILURE);
+		}
+
+		for (j = 0; j < n_items; j++) {
+			if (items[j] != i * j) {
+				fprintf(stderr, "vector did not return the expected value\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+
+		// the traced vector starts the heap, followed by the map
+		if (i == N_HEAP_ORDER_KEYS - 1) {
+			if ((char*)items - sizeof(uint32_t) != (char*)p->heap_ptr) {
+				fprintf(stderr, "traced vector is not first on the heap\n");
+				exit(EXIT_FAILURE);
+			}
+
+			if (PC_OFFSET(p, map_offsets, root->data.data_u32) != sizeof(uint32_t) * (n_items + 1)) {
+				fprintf(stderr, "map does not follow the traced vector\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+}
+
+// a lookup traces the map, its vectors, the strings compared and the value, each once
+void query_trace(pointless_t* p)
+{
+	pointless_value_t* root = pointless_root(p);
+	pointless_value_t* trace = 0;
+	uint32_t i, n_trace = 0, n_items = 0;
+	uint32_t* items = 0;
+	const char* error = 0;
+
+	if (!pointless_trace_begin(p, 0, &error)) {
+		fprintf(stderr, "pointless_trace_begin() failure: %s\n", error);
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < 2; i++) {
+		if (!pointless_get_mapping_string_to_vector_u32(p, root, (char*)"key_3", &items, &n_items) || n_items != 4) {
+			fprintf(stderr, "pointless_get_mapping_string_to_vector_u32(): unexpected result\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if (!pointless_trace_write_f(p, "heap_order.trace", &error) || !pointless_trace_read_f("heap_order.trace", &trace, &n_trace, &error)) {
+		fprintf(stderr, "pointless_trace_xxx() failure: %s\n", error);
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_trace_end(p);
+
+	if (n_trace < 3 || trace[0].type != POINTLESS_MAP_VALUE_VALUE || trace[0].data.data_u32 != root->data.data_u32) {
+		fprintf(stderr, "trace does not start with the map\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (trace[n_trace - 1].type != POINTLESS_VECTOR_U32 || (char*)p->heap_ptr + PC_OFFSET(p, vector_offsets, trace[n_trace - 1].data.data_u32) + sizeof(uint32_t) != (char*)items) {
+		fprintf(stderr, "trace does not end with the value\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < n_trace; i++) {
+		if (trace[i].type == POINTLESS_VECTOR_U32 && i != n_trace - 1 && trace[i].data.data_u32 == trace[n_trace - 1].data.data_u32) {
+			fprintf(stderr, "trace holds a container twice\n");
 			exit(EXIT_FAILURE);
 		}
 	}
+
+	pointless_free(trace);
+
+	// replay it
+	if (!pointless_prefetch_f(p, "heap_order.trace", &error)) {
+		fprintf(stderr, "pointless_prefetch_f() failure: %s\n", error);
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_prefetch_wait(p);
 }
 
 void create_special_a(pointless_create_t* c)
@@ -509,3 +2088,96 @@ void query_special_d(pointless_t* p)
 		}
 	}
 }
+
+#define TABLE_N_ROWS 100
+
+void create_table(pointless_create_t* c)
+{
+	// three columns: small integers, floats and strings
+	uint32_t keys = pointless_create_vector_value(c), i;
+	uint32_t columns[3];
+	char name[32];
+
+	CHECK_HANDLE(keys);
+
+	for (i = 0; i < 3; i++) {
+		columns[i] = pointless_create_vector_value(c);
+		CHECK_HANDLE(columns[i]);
+	}
+
+	if (pointless_create_vector_value_append(c, keys, pointless_create_string_ascii(c, (uint8_t*)"id")) == POINTLESS_CREATE_VALUE_FAIL ||
+		pointless_create_vector_value_append(c, keys, pointless_create_string_ascii(c, (uint8_t*)"score")) == POINTLESS_CREATE_VALUE_FAIL ||
+		pointless_create_vector_value_append(c, keys, pointless_create_string_ascii(c, (uint8_t*)"name")) == POINTLESS_CREATE_VALUE_FAIL) {
+		fprintf(stderr, "pointless_create_vector_value_append() failure\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < TABLE_N_ROWS; i++) {
+		snprintf(name, sizeof(name), "row_%u", i);
+
+		if (pointless_create_vector_value_append(c, columns[0], pointless_create_u32(c, i % 50)) == POINTLESS_CREATE_VALUE_FAIL ||
+			pointless_create_vector_value_append(c, columns[1], pointless_create_float(c, (float)i * 0.5f)) == POINTLESS_CREATE_VALUE_FAIL ||
+			pointless_create_vector_value_append(c, columns[2], pointless_create_string_ascii(c, (uint8_t*)name)) == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_vector_value_append() failure\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	uint32_t table = pointless_create_table(c, TABLE_N_ROWS, keys);
+	CHECK_HANDLE(table);
+
+	for (i = 0; i < 3; i++) {
+		if (pointless_create_table_add_column(c, table, columns[i]) == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "pointless_create_table_add_column() failure\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	pointless_create_set_root(c, table);
+}
+
+void query_table(pointless_t* p)
+{
+	pointless_value_t* root = pointless_root(p);
+	pointless_value_t* columns = 0;
+	uint32_t i;
+
+	if (root->type != POINTLESS_TABLE) {
+		fprintf(stderr, "query_table(): root is not a table\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (pointless_reader_table_n_rows(p, root) != TABLE_N_ROWS || pointless_reader_table_n_columns(p, root) != 3) {
+		fprintf(stderr, "query_table(): table is not %u x 3\n", TABLE_N_ROWS);
+		exit(EXIT_FAILURE);
+	}
+
+	// numeric columns must have been compressed
+	columns = pointless_reader_table_columns(p, root);
+
+	if (columns[0].type != POINTLESS_VECTOR_U8 || columns[1].type != POINTLESS_VECTOR_FLOAT) {
+		fprintf(stderr, "query_table(): columns not compressed (%u, %u)\n", columns[0].type, columns[1].type);
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < TABLE_N_ROWS; i++) {
+		pointless_complete_value_t id = pointless_reader_table_value(p, root, i, 0);
+		pointless_complete_value_t score = pointless_reader_table_value(p, root, i, 1);
+		pointless_complete_value_t name = pointless_reader_table_value(p, root, i, 2);
+
+		if (id.type != POINTLESS_U32 || id.complete_data.data_u32 != i % 50) {
+			fprintf(stderr, "query_table(): bad id in row %u\n", i);
+			exit(EXIT_FAILURE);
+		}
+
+		if (score.type != POINTLESS_FLOAT || score.complete_data.data_f != (float)i * 0.5f) {
+			fprintf(stderr, "query_table(): bad score in row %u\n", i);
+			exit(EXIT_FAILURE);
+		}
+
+		if (name.type != POINTLESS_STRING_) {
+			fprintf(stderr, "query_table(): bad name in row %u\n", i);
+			exit(EXIT_FAILURE);
+		}
+	}
+}
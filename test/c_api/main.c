@@ -18,6 +18,42 @@ static void print_map(const char* fname)
 	pointless_close(&p);
 }
 
+static void print_hash_table_stats(const char* fname)
+{
+	pointless_t p;
+	const char* error = 0;
+
+	if (!pointless_open_f(&p, fname, 0, &error)) {
+		fprintf(stderr, "pointless_open_f() failure: %s\n", error);
+		exit(EXIT_FAILURE);
+	}
+
+	if (!pointless_hash_table_stats_print(&p, stdout, &error)) {
+		fprintf(stderr, "pointless_hash_table_stats_print() failure: %s\n", error);
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_close(&p);
+}
+
+static void print_anatomy(const char* fname)
+{
+	pointless_t p;
+	const char* error = 0;
+
+	if (!pointless_open_f(&p, fname, 0, &error)) {
+		fprintf(stderr, "pointless_open_f() failure: %s\n", error);
+		exit(EXIT_FAILURE);
+	}
+
+	if (!pointless_anatomy_print(&p, stdout, &error)) {
+		fprintf(stderr, "pointless_anatomy_print() failure: %s\n", error);
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_close(&p);
+}
+
 static void measure_load_time(const char* fname)
 {
 	pointless_t p;
@@ -57,6 +93,35 @@ static void run_re_create_64(const char* fname_in, const char* fname_out)
 	}
 }
 
+static void run_re_create_heap_order(const char* fname_in, const char* fname_out, uint32_t heap_order)
+{
+	const char* error = 0;
+
+	if (!pointless_recreate_heap_order(fname_in, fname_out, heap_order, 0, 0, &error)) {
+		fprintf(stderr, "pointless_recreate_heap_order() failure: %s\n", error);
+		exit(EXIT_FAILURE);
+	}
+}
+
+static void run_re_create_traced(const char* fname_in, const char* fname_trace, const char* fname_out)
+{
+	const char* error = 0;
+	pointless_value_t* trace = 0;
+	uint32_t n_trace = 0;
+
+	if (!pointless_trace_read_f(fname_trace, &trace, &n_trace, &error)) {
+		fprintf(stderr, "pointless_trace_read_f() failure: %s\n", error);
+		exit(EXIT_FAILURE);
+	}
+
+	if (!pointless_recreate_heap_order(fname_in, fname_out, POINTLESS_CREATE_HEAP_ORDER_DFS, trace, n_trace, &error)) {
+		fprintf(stderr, "pointless_recreate_heap_order() failure: %s\n", error);
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_free(trace);
+}
+
 static void print_usage_exit()
 {
 	fprintf(stderr, "usage: ./pointless_util OPTIONS\n");
@@ -67,9 +132,15 @@ static void print_usage_exit()
 	fprintf(stderr, "   --test-performance-64\n");
 	fprintf(stderr, "   --measure-load-time pointless.map\n");
 	fprintf(stderr, "   --test-hash\n");
+	fprintf(stderr, "   --test-hash-keys keys.txt\n");
 	fprintf(stderr, "   --dump-file pointless.map\n");
+	fprintf(stderr, "   --hash-table-stats pointless.map\n");
+	fprintf(stderr, "   --anatomy pointless.map\n");
 	fprintf(stderr, "   --re-create-32 pointless_in.map pointless_out.map\n");
 	fprintf(stderr, "   --re-create-64 pointless_in.map pointless_out.map\n");
+	fprintf(stderr, "   --re-create-dfs pointless_in.map pointless_out.map\n");
+	fprintf(stderr, "   --re-create-bfs pointless_in.map pointless_out.map\n");
+	fprintf(stderr, "   --re-create-traced pointless_in.map pointless_in.trace pointless_out.map\n");
 	fprintf(stderr, "   --measure-32-64-bit-difference pointless.map [...]\n");
 	exit(EXIT_FAILURE);
 }
@@ -87,8 +158,90 @@ static void run_unit_test(create_begin_cb cb)
 
 	create_wrapper("set.map", cb, create_set);
 	query_wrapper("set.map", query_set);
+	query_wrapper("set.map", query_anatomy);
+	query_wrapper("set.map", query_hash_table_stats);
 	print_map("set.map");
 
+	create_wrapper("set_bloom.map", cb, create_set_bloom);
+	query_wrapper("set_bloom.map", query_set);
+	query_wrapper("set_bloom.map", query_anatomy);
+
+	create_wrapper("set_compact.map", cb, create_set_compact);
+	query_wrapper("set_compact.map", query_set);
+	query_wrapper("set_compact.map", query_anatomy);
+	query_wrapper("set_compact.map", query_hash_table_stats);
+	print_map("set_compact.map");
+
+	create_wrapper("hash_tables.map", cb, create_hash_tables);
+	query_wrapper("hash_tables.map", query_anatomy);
+	query_wrapper("hash_tables.map", query_hash_table_stats);
+	query_wrapper("hash_tables.map", query_hash_tables_stop);
+	print_map("hash_tables.map");
+
+	create_wrapper("map_typed.map", cb, create_map_typed);
+	query_wrapper("map_typed.map", query_map_typed);
+	query_wrapper("map_typed.map", query_anatomy);
+	print_map("map_typed.map");
+
+	create_wrapper("map_dense.map", cb, create_map_dense);
+	query_wrapper("map_dense.map", query_map_dense);
+	query_wrapper("map_dense.map", query_anatomy);
+	query_wrapper("map_dense.map", query_hash_table_stats);
+	print_map("map_dense.map");
+
+	create_wrapper("map_shared_schema.map", cb, create_map_shared_schema);
+	query_wrapper("map_shared_schema.map", query_map_shared_schema);
+	query_wrapper("map_shared_schema.map", query_anatomy);
+	query_wrapper("map_shared_schema.map", query_hash_table_stats);
+	print_map("map_shared_schema.map");
+
+	create_wrapper("vector_encoded.map", cb, create_vector_encoded);
+	query_wrapper("vector_encoded.map", query_vector_encoded);
+	query_wrapper("vector_encoded.map", query_anatomy);
+	print_map("vector_encoded.map");
+
+	create_wrapper("string_inline.map", cb, create_string_inline);
+	query_wrapper("string_inline.map", query_string_inline);
+	query_wrapper("string_inline.map", query_anatomy);
+	print_map("string_inline.map");
+
+	create_wrapper("vector_split.map", cb, create_vector_split);
+	query_wrapper("vector_split.map", query_vector_split);
+	query_wrapper("vector_split.map", query_anatomy);
+	print_map("vector_split.map");
+
+	create_wrapper("vector_blocks.map", cb, create_vector_blocks);
+	query_wrapper("vector_blocks.map", query_vector_blocks);
+	query_wrapper("vector_blocks.map", query_anatomy);
+	print_map("vector_blocks.map");
+
+	create_wrapper("string_symbols.map", cb, create_string_symbols);
+	query_wrapper("string_symbols.map", query_string_symbols);
+	query_wrapper("string_symbols.map", query_anatomy);
+	print_map("string_symbols.map");
+
+	create_wrapper("offsets_delta.map", cb, create_offsets_delta);
+	query_wrapper("offsets_delta.map", query_offsets_delta);
+	query_wrapper("offsets_delta.map", query_anatomy);
+	print_map("offsets_delta.map");
+
+	create_wrapper("hash_mix.map", cb, create_hash_mix);
+	query_wrapper("hash_mix.map", query_hash_mix);
+	query_wrapper("hash_mix.map", query_anatomy);
+	query_wrapper("hash_mix.map", query_hash_table_stats);
+	print_map("hash_mix.map");
+
+	create_wrapper("vector_aligned.map", cb, create_vector_aligned);
+	query_wrapper("vector_aligned.map", query_vector_aligned);
+	query_wrapper("vector_aligned.map", query_anatomy);
+	print_map("vector_aligned.map");
+
+	create_wrapper("heap_order.map", cb, create_heap_order);
+	query_wrapper("heap_order.map", query_heap_order);
+	query_wrapper("heap_order.map", query_anatomy);
+	query_wrapper("heap_order.map", query_trace);
+	print_map("heap_order.map");
+
 	create_wrapper("special_a.map", cb, create_special_a);
 	print_map("special_a.map");
 
@@ -101,13 +254,37 @@ static void run_unit_test(create_begin_cb cb)
 	create_wrapper("special_d.map", cb, create_special_d);
 	print_map("special_d.map");
 	query_wrapper("special_d.map", query_special_d);
+	query_wrapper("special_d.map", query_anatomy);
 	print_map("special_d.map");
+
+	create_wrapper("table.map", cb, create_table);
+	query_wrapper("table.map", query_table);
+	query_wrapper("table.map", query_anatomy);
+	print_map("table.map");
 }
 
 static void run_performance_test(create_begin_cb cb)
 {
 	create_wrapper("set_1M.map", cb, create_1M_set);
 	query_wrapper("set_1M.map", query_1M_set);
+	query_wrapper("set_1M.map", iter_1M_set);
+
+	// same, in the compact layout
+	create_wrapper("set_1M_compact.map", cb, create_1M_set_compact);
+	query_wrapper("set_1M_compact.map", query_1M_set);
+	query_wrapper("set_1M_compact.map", iter_1M_set);
+
+	// 90% negative lookups, with and without a Bloom filter
+	create_wrapper("set_1M_spread.map", cb, create_1M_set_spread);
+	query_wrapper("set_1M_spread.map", query_1M_set_miss);
+
+	create_wrapper("set_1M_spread_bloom.map", cb, create_1M_set_spread_bloom);
+	query_wrapper("set_1M_spread_bloom.map", query_1M_set_miss);
+
+	// lookups and iteration of a map
+	create_wrapper("map_1M.map", cb, create_1M_map);
+	query_wrapper("map_1M.map", query_1M_map);
+	query_wrapper("map_1M.map", iter_1M_map);
 }
 
 static uint64_t measure_32_64_difference(const char* fname)
@@ -162,8 +339,14 @@ int main(int argc, char** argv)
 	} else if (argc == 3) {
 		if (strcmp(argv[1], "--dump-file") == 0)
 			print_map(argv[2]);
+		else if (strcmp(argv[1], "--hash-table-stats") == 0)
+			print_hash_table_stats(argv[2]);
+		else if (strcmp(argv[1], "--anatomy") == 0)
+			print_anatomy(argv[2]);
 		else if (strcmp(argv[1], "--measure-load-time") == 0)
 			measure_load_time(argv[2]);
+		else if (strcmp(argv[1], "--test-hash-keys") == 0)
+			benchmark_hash_keys(argv[2]);
 		else
 			print_usage_exit();
 
@@ -172,6 +355,15 @@ int main(int argc, char** argv)
 			run_re_create_32(argv[2], argv[3]);
 		else if (strcmp(argv[1], "--re-create-64") == 0)
 			run_re_create_64(argv[2], argv[3]);
+		else if (strcmp(argv[1], "--re-create-dfs") == 0)
+			run_re_create_heap_order(argv[2], argv[3], POINTLESS_CREATE_HEAP_ORDER_DFS);
+		else if (strcmp(argv[1], "--re-create-bfs") == 0)
+			run_re_create_heap_order(argv[2], argv[3], POINTLESS_CREATE_HEAP_ORDER_BFS);
+		else
+			print_usage_exit();
+	} else if (argc == 5) {
+		if (strcmp(argv[1], "--re-create-traced") == 0)
+			run_re_create_traced(argv[2], argv[3], argv[4]);
 		else
 			print_usage_exit();
 	} else {
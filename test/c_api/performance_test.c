@@ -48,6 +48,12 @@ void create_1M_set(pointless_create_t* c)
 	pointless_create_set_root(c, s);
 }
 
+void create_1M_set_compact(pointless_create_t* c)
+{
+	pointless_create_compact_hash_tables(c, 1);
+	create_1M_set(c);
+}
+
 void query_1M_set(pointless_t* p)
 {
 	pointless_value_t* set = pointless_root(p);
@@ -77,3 +83,188 @@ void query_1M_set(pointless_t* p)
 		}
 	}
 }
+
+void iter_1M_set(pointless_t* p)
+{
+	pointless_value_t* set = pointless_root(p);
+	pointless_value_t* k = 0;
+	uint32_t i, iter_state, n_keys;
+	uint64_t sum;
+
+	if (set->type != POINTLESS_SET_VALUE) {
+		fprintf(stderr, "iter_1M_set(): root is not a set\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < 10; i++) {
+		iter_state = 0;
+		n_keys = 0;
+		sum = 0;
+
+		while (pointless_reader_set_iter(p, set, &k, &iter_state)) {
+			sum += k->data.data_u32;
+			n_keys += 1;
+		}
+
+		if (n_keys != ONE_MILLION || sum != (uint64_t)ONE_MILLION * (ONE_MILLION - 1) / 2) {
+			fprintf(stderr, "iter_1M_set(): set does not contain the expected values\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+}
+
+// keys spread over the whole 32-bit range, so that misses do not all land in one region of the hash table
+#define SPREAD_KEY(i) ((uint32_t)(i) * 2654435761U)
+
+static void create_1M_set_spread_priv(pointless_create_t* c, uint32_t bloom_threshold)
+{
+	uint32_t i, t, s;
+
+	pointless_create_bloom_threshold(c, bloom_threshold);
+
+	s = pointless_create_set(c);
+
+	if (s == POINTLESS_CREATE_VALUE_FAIL) {
+		fprintf(stderr, "create_1M_set_spread(): out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < ONE_MILLION; i++) {
+		t = pointless_create_u32(c, SPREAD_KEY(i));
+
+		if (t == POINTLESS_CREATE_VALUE_FAIL || !pointless_create_set_add(c, s, t)) {
+			fprintf(stderr, "create_1M_set_spread(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	pointless_create_set_root(c, s);
+}
+
+void create_1M_set_spread(pointless_create_t* c)
+{
+	create_1M_set_spread_priv(c, 0);
+}
+
+void create_1M_set_spread_bloom(pointless_create_t* c)
+{
+	create_1M_set_spread_priv(c, 1);
+}
+
+void query_1M_set_miss(pointless_t* p)
+{
+	pointless_value_t* set = pointless_root(p);
+	const char* error = 0;
+
+	if (set->type != POINTLESS_SET_VALUE) {
+		fprintf(stderr, "query_1M_set_miss(): root is not a set\n");
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_value_t k;
+	uint32_t i, n_found = 0;
+
+	// every 10th key is in the set
+	for (i = 0; i < ONE_MILLION; i++) {
+		k = pointless_value_create_as_read_u32(SPREAD_KEY((i % 10 == 0) ? i : ONE_MILLION + i));
+		pointless_value_t* kk = 0;
+		pointless_reader_set_lookup(p, set, &k, &kk, &error);
+
+		if (error) {
+			fprintf(stderr, "query_1M_set_miss(): pointless_reader_set_contains() failure: %s\n", error);
+			exit(EXIT_FAILURE);
+		}
+
+		n_found += (kk != 0);
+	}
+
+	if (n_found != ONE_MILLION / 10) {
+		fprintf(stderr, "query_1M_set_miss(): unexpected number of keys found\n");
+		exit(EXIT_FAILURE);
+	}
+}
+
+void create_1M_map(pointless_create_t* c)
+{
+	uint32_t i, k, v, m;
+
+	m = pointless_create_map(c);
+
+	if (m == POINTLESS_CREATE_VALUE_FAIL) {
+		fprintf(stderr, "create_1M_map(): out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < ONE_MILLION; i++) {
+		k = pointless_create_u32(c, SPREAD_KEY(i));
+		v = pointless_create_u32(c, i);
+
+		if (k == POINTLESS_CREATE_VALUE_FAIL || v == POINTLESS_CREATE_VALUE_FAIL || pointless_create_map_add(c, m, k, v) == POINTLESS_CREATE_VALUE_FAIL) {
+			fprintf(stderr, "create_1M_map(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	pointless_create_set_root(c, m);
+}
+
+void query_1M_map(pointless_t* p)
+{
+	pointless_value_t* map = pointless_root(p);
+	const char* error = 0;
+
+	if (map->type != POINTLESS_MAP_VALUE_VALUE) {
+		fprintf(stderr, "query_1M_map(): root is not a map\n");
+		exit(EXIT_FAILURE);
+	}
+
+	pointless_value_t k;
+	uint32_t i;
+
+	for (i = 0; i < ONE_MILLION; i++) {
+		k = pointless_value_create_as_read_u32(SPREAD_KEY(i));
+		pointless_value_t* kk = 0;
+		pointless_value_t* vv = 0;
+		pointless_reader_map_lookup(p, map, &k, &kk, &vv, &error);
+
+		if (error) {
+			fprintf(stderr, "query_1M_map(): pointless_reader_map_lookup() failure: %s\n", error);
+			exit(EXIT_FAILURE);
+		}
+
+		if (vv == 0 || vv->data.data_u32 != i) {
+			fprintf(stderr, "query_1M_map(): map does not contain the expected value\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+}
+
+void iter_1M_map(pointless_t* p)
+{
+	pointless_value_t* map = pointless_root(p);
+	pointless_value_t* k = 0;
+	pointless_value_t* v = 0;
+	uint32_t i, iter_state, n_items;
+	uint64_t sum;
+
+	if (map->type != POINTLESS_MAP_VALUE_VALUE) {
+		fprintf(stderr, "iter_1M_map(): root is not a map\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < 10; i++) {
+		iter_state = 0;
+		n_items = 0;
+		sum = 0;
+
+		while (pointless_reader_map_iter(p, map, &k, &v, &iter_state)) {
+			sum += v->data.data_u32;
+			n_items += 1;
+		}
+
+		if (n_items != ONE_MILLION || sum != (uint64_t)ONE_MILLION * (ONE_MILLION - 1) / 2) {
+			fprintf(stderr, "iter_1M_map(): map does not contain the expected values\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+}
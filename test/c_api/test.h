@@ -14,6 +14,9 @@
 // hash validator
 void validate_hash_semantics();
 
+// string hash speed, collisions and probe lengths, for a file of keys, one per line
+void benchmark_hash_keys(const char* fname);
+
 // create/query test-cases
 typedef void (*create_begin_cb)(pointless_create_t* c);
 typedef void (*create_cb)(pointless_create_t* c);
@@ -26,15 +29,56 @@ void create_tuple(pointless_create_t* c);
 void create_very_simple(pointless_create_t* c);
 void create_simple(pointless_create_t* c);
 void create_set(pointless_create_t* c);
+void create_set_bloom(pointless_create_t* c);
+void create_set_compact(pointless_create_t* c);
 void query_set(pointless_t* p);
+void query_hash_table_stats(pointless_t* p);
+void query_anatomy(pointless_t* p);
+void create_hash_tables(pointless_create_t* c);
+void query_hash_tables_stop(pointless_t* p);
+void create_map_typed(pointless_create_t* c);
+void query_map_typed(pointless_t* p);
+void create_map_dense(pointless_create_t* c);
+void query_map_dense(pointless_t* p);
+void create_map_shared_schema(pointless_create_t* c);
+void query_map_shared_schema(pointless_t* p);
+void create_vector_encoded(pointless_create_t* c);
+void query_vector_encoded(pointless_t* p);
+void create_string_inline(pointless_create_t* c);
+void query_string_inline(pointless_t* p);
+void create_vector_split(pointless_create_t* c);
+void query_vector_split(pointless_t* p);
+void create_vector_blocks(pointless_create_t* c);
+void query_vector_blocks(pointless_t* p);
+void create_string_symbols(pointless_create_t* c);
+void query_string_symbols(pointless_t* p);
+void create_offsets_delta(pointless_create_t* c);
+void query_offsets_delta(pointless_t* p);
+void create_hash_mix(pointless_create_t* c);
+void query_hash_mix(pointless_t* p);
+void create_vector_aligned(pointless_create_t* c);
+void query_vector_aligned(pointless_t* p);
+void create_heap_order(pointless_create_t* c);
+void query_heap_order(pointless_t* p);
+void query_trace(pointless_t* p);
 void create_special_a(pointless_create_t* c);
 void create_special_b(pointless_create_t* c);
 void create_special_c(pointless_create_t* c);
 void create_special_d(pointless_create_t* c);
 void query_special_d(pointless_t* p);
+void create_table(pointless_create_t* c);
+void query_table(pointless_t* p);
 
 // performance tests
 void create_1M_set(pointless_create_t* c);
+void create_1M_set_compact(pointless_create_t* c);
 void query_1M_set(pointless_t* p);
+void iter_1M_set(pointless_t* p);
+void create_1M_set_spread(pointless_create_t* c);
+void create_1M_set_spread_bloom(pointless_create_t* c);
+void query_1M_set_miss(pointless_t* p);
+void create_1M_map(pointless_create_t* c);
+void query_1M_map(pointless_t* p);
+void iter_1M_map(pointless_t* p);
 
 #endif
@@ -46,3 +46,129 @@ void validate_hash_semantics()
 		}
 	}
 }
+
+// string hashes of each file format version, and how they spread a key set over a hash table
+typedef uint32_t (*benchmark_hash_cb)(uint8_t* s);
+
+static int benchmark_hash_cmp_key(const void* a, const void* b)
+{
+	return strcmp(*(const char**)a, *(const char**)b);
+}
+
+static int benchmark_hash_cmp_hash(const void* a, const void* b)
+{
+	uint32_t h_a = *(const uint32_t*)a, h_b = *(const uint32_t*)b;
+	return (h_a < h_b) ? -1 : (h_a > h_b);
+}
+
+static void benchmark_hash(const char* name, benchmark_hash_cb cb, char** keys, uint32_t n_keys)
+{
+	uint32_t n_buckets = pointless_hash_compute_n_buckets(n_keys), mask = n_buckets - 1;
+	uint32_t* hashes = (uint32_t*)pointless_malloc(sizeof(uint32_t) * n_keys);
+	uint8_t* is_used = (uint8_t*)pointless_calloc(n_buckets, sizeof(uint8_t));
+	uint32_t i, r, n_rounds = 1 + 10000000 / (n_keys + 1), n_colliding = 0, n_probed = 0, probe_max = 0;
+	uint32_t perturb, j, bucket, probe;
+	uint64_t probe_sum = 0;
+	volatile uint32_t sink = 0;
+
+	if (hashes == 0 || is_used == 0) {
+		fprintf(stderr, "benchmark_hash(): out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	clock_t t_0 = clock();
+
+	for (r = 0; r < n_rounds; r++) {
+		for (i = 0; i < n_keys; i++)
+			sink += (*cb)((uint8_t*)keys[i]);
+	}
+
+	clock_t t_1 = clock();
+
+	// insert the keys, in order, with the recurrence of the hash table probes
+	for (i = 0; i < n_keys; i++) {
+		hashes[i] = (*cb)((uint8_t*)keys[i]);
+		perturb = j = hashes[i];
+
+		for (probe = 1; is_used[bucket = j & mask]; probe++) {
+			j = (j << 2) + j + perturb + 1;
+			perturb >>= 5;
+		}
+
+		is_used[bucket] = 1;
+		probe_sum += probe;
+		n_probed += (probe > 1);
+		probe_max = (probe > probe_max) ? probe : probe_max;
+	}
+
+	// keys sharing their 32-bit hash with another key
+	qsort(hashes, n_keys, sizeof(uint32_t), benchmark_hash_cmp_hash);
+
+	for (i = 0; i < n_keys; i++) {
+		if ((i > 0 && hashes[i] == hashes[i - 1]) || (i + 1 < n_keys && hashes[i] == hashes[i + 1]))
+			n_colliding += 1;
+	}
+
+	printf("%s: %.1f ns/key, %u colliding keys, probe length %.3f average, %u max, %u keys not in their first bucket\n",
+		name,
+		(double)(t_1 - t_0) / (double)CLOCKS_PER_SEC * 1e9 / ((double)n_rounds * (n_keys ? n_keys : 1)),
+		n_colliding,
+		n_keys ? (double)probe_sum / (double)n_keys : 0.0,
+		probe_max,
+		n_probed
+	);
+
+	pointless_free(hashes);
+	pointless_free(is_used);
+}
+
+void benchmark_hash_keys(const char* fname)
+{
+	FILE* f = fopen(fname, "r");
+	char line[4096];
+	char** keys = 0;
+	uint32_t n_keys = 0, n_alloc = 0, i, n_unique = 0;
+
+	if (f == 0) {
+		fprintf(stderr, "unable to open %s\n", fname);
+		exit(EXIT_FAILURE);
+	}
+
+	// one key per line
+	while (fgets(line, sizeof(line), f)) {
+		line[strcspn(line, "\r\n")] = 0;
+
+		if (n_keys == n_alloc) {
+			n_alloc = n_alloc ? n_alloc * 2 : 1024;
+			keys = (char**)pointless_realloc(keys, sizeof(char*) * n_alloc);
+		}
+
+		if (keys == 0 || (keys[n_keys++] = strdup(line)) == 0) {
+			fprintf(stderr, "benchmark_hash_keys(): out of memory\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	fclose(f);
+
+	// the keys of a set or map are unique
+	qsort(keys, n_keys, sizeof(char*), benchmark_hash_cmp_key);
+
+	for (i = 0; i < n_keys; i++) {
+		if (n_unique > 0 && strcmp(keys[n_unique - 1], keys[i]) == 0)
+			free(keys[i]);
+		else
+			keys[n_unique++] = keys[i];
+	}
+
+	printf("%u keys, %u buckets\n", n_unique, pointless_hash_compute_n_buckets(n_unique));
+
+	benchmark_hash("v0 (OLDHASH)", pointless_hash_string_v0_32, keys, n_unique);
+	benchmark_hash("v1 (NEWHASH)", pointless_hash_string_v1_32, keys, n_unique);
+	benchmark_hash("v2 (MIXHASH)", pointless_hash_string_v2_32, keys, n_unique);
+
+	for (i = 0; i < n_unique; i++)
+		free(keys[i]);
+
+	pointless_free(keys);
+}
@@ -274,6 +274,132 @@ class TestPrimVector(unittest.TestCase):
 
 					self.assert_(False)
 
+	def testProjSortStable(self):
+		random.seed(0)
+
+		tcs = ['i8', 'u8', 'i16', 'u16', 'i32', 'u32', 'i64', 'u64', 'f']
+
+		for i in xrange(20):
+			n = random.randint(1, 5000)
+
+			# few distinct values per vector, so there are plenty of ties
+			pp_vv = []
+
+			for j in xrange(random.randint(1, 6)):
+				tc = random.choice(tcs)
+
+				if tc == 'f':
+					values = [-1.5, -0.0, 0.0, 2.5, 1e10]
+				elif tc.startswith('i'):
+					values = [-100, -1, 0, 1, 100]
+				else:
+					values = [0, 1, 100, 200]
+
+				pp_vv.append(pointless.PointlessPrimVector(tc, sequence = (random.choice(values) for k in xrange(n))))
+
+			py_vv = [list(v) for v in pp_vv]
+
+			# projection with repeated indices, in random order
+			py_proj = [random.randint(0, n - 1) for k in xrange(random.randint(0, 2 * n))]
+			pp_proj = pointless.PointlessPrimVector('u32', sequence = py_proj)
+
+			# python sort is stable
+			py_proj.sort(key = lambda k: tuple(v[k] for v in py_vv))
+			pp_proj.sort_proj(*pp_vv)
+
+			self.assert_(py_proj == list(pp_proj))
+
+		# signed projection values above the value vector length
+		v = pointless.PointlessPrimVector('u32', sequence = [3, 2, 1])
+		p = pointless.PointlessPrimVector('i32', sequence = [0, 1, 3])
+		self.assertRaises(ValueError, p.sort_proj, v)
+
+	def testReductions(self):
+		random.seed(0)
+
+		tcs = ['i8', 'u8', 'i16', 'u16', 'i32', 'u32', 'i64', 'u64', 'f']
+		ops = {'==': lambda a, b: a == b, '!=': lambda a, b: a != b, '<': lambda a, b: a < b, '<=': lambda a, b: a <= b, '>': lambda a, b: a > b, '>=': lambda a, b: a >= b}
+
+		for tc in tcs:
+			for n in [1, 2, 3, 17, 1000]:
+				pp_v = RandomPrimVector(n, tc)
+				pointless.serialize(pp_v, 'deleteme.map')
+				po_v = pointless.Pointless('deleteme.map').GetRoot()
+				py_v = list(pp_v)
+
+				# operands of every kind, including ones outside the range of the vector type
+				operands = [random.choice(py_v), random.choice(py_v), 0, -1, 0.5, -2**65, 2**65, 2**63, float('inf')]
+
+				for v in [pp_v, po_v]:
+					if tc == 'f':
+						self.assertAlmostEqual(v.sum(), sum(py_v), delta = 1e-6 * sum(abs(a) for a in py_v))
+					elif tc.startswith('i'):
+						self.assert_(v.sum() == (sum(py_v) + 2**63) % 2**64 - 2**63)
+					else:
+						self.assert_(v.sum() == sum(py_v) % 2**64)
+
+					self.assert_(v.argmin() == py_v.index(min(py_v)))
+					self.assert_(v.argmax() == py_v.index(max(py_v)))
+					self.assert_(v.min() == min(py_v))
+					self.assert_(v.max() == max(py_v))
+
+					for a in operands:
+						for op, f in ops.iteritems():
+							self.assert_(list(v.filter(op, a)) == [i for i, x in enumerate(py_v) if f(x, a)])
+
+						for b in operands:
+							py_r = [i for i, x in enumerate(py_v) if a <= x < b]
+							self.assert_(v.count_range(a, b) == len(py_r))
+							self.assert_(list(v.filter_range(a, b)) == py_r)
+
+					lo = float(min(py_v))
+					hi = lo + 2.0 * max(1.0, abs(lo), float(max(py_v) - min(py_v)))
+					h = v.histogram(lo, hi, 10)
+					self.assert_(h.typecode == 'u64' and len(h) == 10 and sum(h) == n)
+
+				del po_v
+
+		# empty and non-primitive vectors
+		v = pointless.PointlessPrimVector('i32')
+		self.assert_(v.sum() == 0 and v.count_range(0, 10) == 0 and len(v.filter('==', 0)) == 0)
+		self.assertRaises(ValueError, v.argmin)
+		self.assertRaises(ValueError, v.max)
+		self.assertRaises(ValueError, v.histogram, 0.0, 1.0, 0)
+		self.assertRaises(ValueError, v.filter, '<>', 0)
+
+		pointless.serialize([1, 'a'], 'deleteme.map')
+		self.assertRaises(ValueError, pointless.Pointless('deleteme.map').GetRoot().sum)
+
+	def testFromRemap(self):
+		random.seed(0)
+
+		tcs = ['i8', 'u8', 'i16', 'u16', 'i32', 'u32', 'i64', 'u64', 'f']
+
+		for i in xrange(50):
+			n = random.randint(1, 1000)
+			py_r = RandomPrimVector(n, random.choice(tcs))
+			py_v = [random.randint(0, n - 1) for j in xrange(random.randint(0, 2 * n))]
+
+			# the index type must be able to hold n - 1
+			v_tc = random.choice([tc for tc in tcs if tc != 'f' and (tc[1:] != '8' or n <= 128)])
+			pp_v = pointless.PointlessPrimVector(v_tc, sequence = py_v)
+
+			pointless.serialize([py_r, pp_v], 'deleteme.map')
+			po_r, po_v = pointless.Pointless('deleteme.map').GetRoot()
+
+			for r in [py_r, po_r]:
+				for v in [pp_v, po_v]:
+					g = pointless.PointlessPrimVector.FromRemap(r, v)
+					self.assert_(g.typecode == py_r.typecode)
+					self.assert_(list(g) == [py_r[j] for j in py_v])
+
+			del po_r, po_v
+
+		r = pointless.PointlessPrimVector('u32', sequence = [1, 2, 3])
+		self.assertRaises(ValueError, pointless.PointlessPrimVector.FromRemap, r, pointless.PointlessPrimVector('i32', sequence = [0, -1]))
+		self.assertRaises(ValueError, pointless.PointlessPrimVector.FromRemap, r, pointless.PointlessPrimVector('u8', sequence = [0, 3]))
+		self.assertRaises(ValueError, pointless.PointlessPrimVector.FromRemap, r, pointless.PointlessPrimVector('f', sequence = [0.0]))
+
 	def testSerialize(self):
 		random.seed(0)
 
@@ -1,6 +1,6 @@
 #!/usr/bin/python
 
-import operator, pointless, random
+import operator, os, pointless, random
 
 from twisted.trial import unittest
 
@@ -94,3 +94,308 @@ class TestPointless(unittest.TestCase):
 					self.assertApproximates(a, b, 0.001)
 
 			del v_b
+
+	def testEncodedVectors(self):
+		currencies = ['USD', 'EUR', 'ISK', 'GBP'] * 250
+		flags = [None] * 500 + [True] * 300 + [None] * 200
+		rows = [{'id': i, 'currency': currencies[i]} for i in xrange(1000)]
+		keys = set([tuple(currencies[:20])])
+		v_a = [currencies, flags, rows[0], keys]
+
+		a = pointless.serialize_to_buffer(v_a)
+		b = pointless.serialize_to_buffer(v_a, encoded_vectors = True)
+		self.assert_(len(b) * 2 < len(a))
+
+		v_b = pointless.Pointless(b).GetRoot()
+		self.assertEquals(pointless.pointless_cmp(v_a, v_b), 0)
+		self.assertEquals(list(v_b[0]), currencies)
+		self.assertEquals(list(v_b[1]), flags)
+		self.assertEquals(list(v_b[0][5:9]), currencies[5:9])
+		self.assertEquals(list(v_b[1][495:505]), flags[495:505])
+		self.assertEquals(v_b[1][-1], None)
+		self.assert_('ISK' in v_b[0])
+		self.assert_(True in v_b[1])
+		self.assert_(tuple(currencies[:20]) in v_b[3])
+		self.assertRaises(ValueError, operator.attrgetter('typecode'), v_b[0])
+
+		# table columns are vectors like any other
+		t = pointless.Pointless(pointless.serialize_to_buffer(rows, columnar = True, encoded_vectors = True)).GetRoot()
+		self.assertEquals(list(t.column('currency')), currencies)
+		self.assertEquals(t[998]['currency'], currencies[998])
+
+		del v_b, t
+
+	def testSplitVectors(self):
+		mixed = [[None, 'row_%i' % i, -i, i + 0.5, True, u'\u20ac%i' % i][i % 6] for i in xrange(600)]
+		names = ['name_%i' % i for i in xrange(600)]
+		short = [['a', 'bc', 'def', 'ghij'][i % 4] + str(i % 10) for i in xrange(600)]
+		v_a = [mixed, names, short, {'names': names[:20]}]
+
+		a = pointless.serialize_to_buffer(v_a)
+		b = pointless.serialize_to_buffer(v_a, split_vectors = True)
+		c = pointless.serialize_to_buffer(v_a, split_vectors = True, encoded_vectors = True, inline_strings = True)
+		self.assert_(len(b) < len(a))
+		self.assert_(len(c) < len(b))
+
+		for buf in (b, c):
+			v_b = pointless.Pointless(buf).GetRoot()
+			self.assertEquals(pointless.pointless_cmp(v_a, v_b), 0)
+			self.assertEquals(list(v_b[0]), mixed)
+			self.assertEquals(list(v_b[1]), names)
+			self.assertEquals(list(v_b[2]), short)
+			self.assertEquals(list(v_b[0][10:20]), mixed[10:20])
+			self.assertEquals(v_b[0][-1], mixed[-1])
+			self.assert_('row_7' in v_b[0])
+			self.assert_(u'\u20ac5' in v_b[0])
+			self.assert_('name_599' in v_b[1])
+			self.assertEquals(list(v_b[3]['names']), names[:20])
+			self.assertRaises(ValueError, operator.attrgetter('typecode'), v_b[0])
+			del v_b
+
+	def testBlockVectors(self):
+		stamps = [1700000000000 + i * 1000 + i % 7 for i in xrange(1000)]
+		counts = [(i * 37) % 1000 for i in xrange(1000)]
+		deltas = pointless.PointlessPrimVector('i16', sequence = (-500 + i % 100 for i in xrange(1000)))
+		ids = pointless.PointlessPrimVector('u32', sequence = xrange(1000))
+		v_a = [stamps, counts, deltas, set([tuple(counts[:300])]), {'short': counts[:10]}, ids]
+
+		a = pointless.serialize_to_buffer(v_a)
+		b = pointless.serialize_to_buffer(v_a, block_vectors = True)
+		self.assert_(len(b) < len(a))
+
+		v_b = pointless.Pointless(b).GetRoot()
+		self.assertEquals(pointless.pointless_cmp(stamps, v_b[0]), 0)
+		self.assertEquals(pointless.pointless_cmp(counts, v_b[1]), 0)
+		self.assertEquals(list(v_b[0]), stamps)
+		self.assertEquals(list(v_b[1]), counts)
+		self.assertEquals(list(v_b[2]), list(deltas))
+		self.assertEquals(list(v_b[1][100:300]), counts[100:300])
+		self.assertEquals(v_b[0][-1], stamps[-1])
+		self.assert_(999 in v_b[1])
+		self.assert_(tuple(counts[:300]) in v_b[3])
+		self.assertEquals(list(v_b[4]['short']), counts[:10])
+		self.assertRaises(ValueError, operator.attrgetter('typecode'), v_b[1])
+
+		# block encoded lists are value-based, primitive vectors are not block encoded
+		self.assertRaises(ValueError, v_b[1].max)
+		self.assertRaises(ValueError, v_b[1].sum)
+		self.assertRaises(SystemError, len, buffer(v_b[1]))
+		self.assertEquals(v_b[2].typecode, 'i16')
+		self.assertEquals(v_b[2].min(), -500)
+		self.assertEquals(v_b[5].typecode, 'u32')
+		self.assertEquals(v_b[5].max(), 999)
+		self.assertEquals(v_b[5].sum(), 499500)
+		self.assertEquals(len(buffer(v_b[5])), 4000)
+		del v_b
+
+	def testStringSymbols(self):
+		# the high byte of the format version in the file header
+		flags = lambda buf: buf[29]
+
+		names = ['Hotel %s %i' % (['Central', 'Plaza', 'Grand', 'Park'][i % 4], i) for i in xrange(1000)]
+		urls = ['https://www.example.com/hotels/%i?lang=en' % (i * 31) for i in xrange(1000)]
+		v_a = [names, urls, dict((n, i) for i, n in enumerate(names)), set(urls[:100]), u'H\xf4tel Caf\xe9 du Parc', u'\u4e2d\u6587', 'x' * 300]
+
+		a = pointless.serialize_to_buffer(v_a)
+		b = pointless.serialize_to_buffer(v_a, string_symbols = True)
+		self.assertEquals(flags(a), 0)
+		self.assertEquals(flags(b), 0x80)
+		self.assert_(len(b) < len(a) * 3 / 4)
+
+		v_b = pointless.Pointless(b).GetRoot()
+		self.assertEquals(pointless.pointless_cmp(v_a, v_b), 0)
+		self.assertEquals(list(v_b[0]), names)
+		self.assertEquals(list(v_b[1]), urls)
+		self.assertEquals(v_b[2]['Hotel Park 999'], 999)
+		self.assert_('Hotel Plaza 1' in v_b[2])
+		self.assert_('Hotel Plaza 2' not in v_b[2])
+		self.assert_(urls[99] in v_b[3])
+		self.assert_(urls[100] not in v_b[3])
+		self.assertEquals(v_b[4], v_a[4])
+		self.assertEquals(v_b[5], v_a[5])
+		self.assertEquals(v_b[6], v_a[6])
+		self.assertEquals(sorted(v_b[0]), sorted(names))
+		del v_b
+
+		# too few strings to pay for the table
+		c = pointless.serialize_to_buffer(['Hotel Central'], string_symbols = True)
+		self.assertEquals(flags(c), 0)
+
+	def testDeltaOffsets(self):
+		# the version field of the file header
+		version = lambda buf: buf[28]
+
+		names = ['name_%i' % i for i in xrange(1000)]
+		v_a = [names, dict((n, [i] * (i % 7)) for i, n in enumerate(names)), set(names[:100])]
+
+		a = pointless.serialize_to_buffer(v_a)
+		b = pointless.serialize_to_buffer(v_a, delta_offsets = True)
+		self.assertEquals(version(a), 1)
+		self.assertEquals(version(b), 3)
+		self.assert_(len(b) < len(a))
+
+		v_b = pointless.Pointless(b).GetRoot()
+		self.assertEquals(pointless.pointless_cmp(v_a, v_b), 0)
+		self.assertEquals(list(v_b[1]['name_999']), [999] * 5)
+		self.assert_('name_99' in v_b[2])
+		del v_b
+
+	def testMixHash(self):
+		# the version field of the file header
+		version = lambda buf: buf[28]
+
+		bitvector = lambda: pointless.PointlessBitvector(sequence = [i >= 50 for i in xrange(100)])
+		names = ['name_%i' % i for i in xrange(1000)]
+		anagrams = ['abc', 'acb', 'bac', 'bca', 'cab', 'cba']
+		v_a = [dict((n, i) for i, n in enumerate(names)), set(anagrams), {(1, 2, 3): 'tuple', u'\u03b1\u03b2': 'unicode', u'caf\xe9': 'latin-1', bitvector(): 'bitvector'}]
+
+		a = pointless.serialize_to_buffer(v_a)
+		b = pointless.serialize_to_buffer(v_a, mix_hash = True)
+		c = pointless.serialize_to_buffer(v_a, mix_hash = True, delta_offsets = True)
+		self.assertEquals(version(a), 1)
+		self.assertEquals(version(b), 4)
+		self.assertEquals(version(c), 6)
+
+		for buf in [b, c]:
+			v_b = pointless.Pointless(buf).GetRoot()
+			self.assertEquals(pointless.pointless_cmp(v_a, v_b), 0)
+			self.assertEquals(v_b[0]['name_999'], 999)
+			self.assertEquals(v_b[0][u'name_5'], 5)
+			self.assert_('name_1000' not in v_b[0])
+
+			for s in anagrams:
+				self.assert_(s in v_b[1])
+
+			self.assertEquals(v_b[2][(1, 2, 3)], 'tuple')
+			self.assertEquals(v_b[2][u'\u03b1\u03b2'], 'unicode')
+			self.assertEquals(v_b[2][u'caf\xe9'], 'latin-1')
+			self.assertEquals(v_b[2][bitvector()], 'bitvector')
+			del v_b
+
+		# anagrams collide in the version 0 hash only, and equal str and unicode hash the same in all versions
+		self.assertEquals(len(set(pointless.pyobject_hash(s, 0) for s in anagrams)), 1)
+		self.assertEquals(len(set(pointless.pyobject_hash(s, 4) for s in anagrams)), len(anagrams))
+		self.assert_(all(pointless.pyobject_hash('abc', v) == pointless.pyobject_hash(u'abc', v) for v in xrange(7)))
+
+		# a block of offsets spanning more heap than the deltas reach
+		v_c = ['x' * 300000] + names[:20]
+		c = pointless.serialize_to_buffer(v_c, delta_offsets = True)
+		self.assertEquals(version(c), 1)
+		self.assertEquals(pointless.pointless_cmp(v_c, pointless.Pointless(c).GetRoot()), 0)
+
+	def testVectorAlignment(self):
+		# the vector alignment fields of the file header version
+		alignment = lambda buf: (buf[30], buf[31])
+
+		v_a = [range(10), range(5000), [1.5] * 3000, ['x'] * 100, {'a': range(20)}]
+
+		a = pointless.serialize_to_buffer(v_a)
+		b = pointless.serialize_to_buffer(v_a, vector_alignment = 64, large_vector_alignment = 4096)
+		self.assertEquals(alignment(a), (0, 0))
+		self.assertEquals(alignment(b), (6, 12))
+		self.assert_(len(b) > len(a))
+		self.assertEquals(pointless.pointless_cmp(v_a, pointless.Pointless(b).GetRoot()), 0)
+
+		fname = 'test_vector_alignment.map'
+		pointless.serialize(v_a, fname, vector_alignment = 4096, delta_offsets = True)
+		self.assertEquals(pointless.pointless_cmp(v_a, pointless.Pointless(fname).GetRoot()), 0)
+
+		for x in [0, 2, 3, 48, 1 << 17]:
+			self.assertRaises(IOError, pointless.serialize_to_buffer, v_a, vector_alignment = x)
+			self.assertRaises(IOError, pointless.serialize_to_buffer, v_a, large_vector_alignment = x)
+
+	def testHeapOrder(self):
+		names = ['name_%i' % i for i in xrange(200)]
+		rows = [{'id': i, 'name': n, 'tags': set(names[i:i + 3])} for i, n in enumerate(names)]
+		v_a = {'rows': rows, 'names': names * 2, 'ids': range(1000), 'flags': [True, False, None] * 20, 'd': dict((i, n) for i, n in enumerate(names))}
+
+		options = [{}, {'columnar': True}, {'compact_hash_tables': True, 'typed_hash_tables': True, 'dense_maps': True}, {'shared_schemas': True, 'encoded_vectors': True, 'bloom_threshold': 10}, {'split_vectors': True, 'delta_offsets': True, 'vector_alignment': 64}]
+
+		for kwargs in options:
+			a = pointless.serialize_to_buffer(v_a, **kwargs)
+
+			for heap_order in ['dfs', 'bfs']:
+				b = pointless.serialize_to_buffer(v_a, heap_order = heap_order, **kwargs)
+				self.assertEquals(pointless.pointless_cmp(v_a, pointless.Pointless(b).GetRoot()), 0)
+
+				# only the order changes, unless delta offsets or alignment depend on it
+				if 'delta_offsets' not in kwargs:
+					self.assertEquals(len(a), len(b))
+
+		self.assertRaises(ValueError, pointless.serialize_to_buffer, v_a, heap_order = 'random')
+
+	def testTrace(self):
+		names = ['name_%i' % i for i in xrange(200)]
+		v = {'rows': [{'id': i, 'name': n} for i, n in enumerate(names)], 'ids': range(1000)}
+		pointless.serialize(v, 'deleteme.map')
+
+		p = pointless.Pointless('deleteme.map')
+		self.assertRaises(IOError, p.WriteTrace, 'deleteme.trace')
+		p.StartTrace()
+		self.assertRaises(ValueError, p.StartTrace)
+		self.assertEquals(p.GetRoot()['rows'][5]['name'], 'name_5')
+		p.WriteTrace('deleteme.trace')
+		p.StopTrace()
+		del p
+
+		# replayed on open, in the background
+		p = pointless.Pointless('deleteme.map', prefetch = 'deleteme.trace')
+		self.assertEquals(pointless.pointless_cmp(v, p.GetRoot()), 0)
+		del p
+
+		self.assertRaises(IOError, pointless.Pointless, 'deleteme.map', prefetch = 'deleteme.map')
+		self.assertRaises(IOError, pointless.Pointless, pointless.serialize_to_buffer(v), prefetch = 'deleteme.trace')
+
+		os.unlink('deleteme.trace')
+
+	def testAnatomy(self):
+		names = ['name_%i' % i for i in xrange(200)]
+		v = {'rows': [{'id': i, 'name': n} for i, n in enumerate(names)], 'ids': range(1000), 'tags': set(names)}
+
+		for kwargs in [{}, {'compact_hash_tables': True, 'bloom_threshold': 10}]:
+			buffer = pointless.serialize_to_buffer(v, **kwargs)
+			a = pointless.Pointless(buffer).GetAnatomy()
+
+			# every byte is in a category, and every entry of the root map in order
+			self.assertEquals(sum(a['bytes'].itervalues()), len(buffer))
+			self.assertEquals([k for k, n in a['entries']], list(pointless.Pointless(buffer).GetRoot().iterkeys()))
+			self.assert_(sum(n for k, n in a['entries']) < len(buffer))
+
+			entries = dict(a['entries'])
+			self.assert_(entries['ids'] >= 2 * 1000)
+			self.assert_(entries['rows'] > entries['tags'])
+			self.assertEquals(a['objects']['set/map headers'], 1 + 200 + 1)
+			self.assert_(a['bytes']['strings'] > 0 and a['bytes']['hash vectors'] > 0 and a['bytes']['empty slots'] > 0)
+			self.assertEquals(a['bytes']['bloom filters'] > 0, 'bloom_threshold' in kwargs)
+
+		# not a map, no entries
+		a = pointless.Pointless(pointless.serialize_to_buffer([1, 2, 3])).GetAnatomy()
+		self.assertEquals(a['entries'], [])
+		self.assertEquals(a['objects']['value vectors'] + a['objects']['u8 vectors'], 1)
+
+	def testInlineStrings(self):
+		words = ['', 'a', 'ab', 'abc', 'abcd', 'pointless', u'\xe9t\xe9', u'\xe9']
+		d = dict((w, i) for i, w in enumerate(words))
+		v_a = [words * 100, d, set(words), sorted(words)]
+
+		a = pointless.serialize_to_buffer(v_a, unwiden_strings = True)
+		b = pointless.serialize_to_buffer(v_a, unwiden_strings = True, inline_strings = True)
+		self.assert_(len(b) < len(a))
+
+		v_b = pointless.Pointless(b).GetRoot()
+		self.assertEquals(pointless.pointless_cmp(v_a, v_b), 0)
+		self.assertEquals(pointless.pointless_cmp(pointless.Pointless(a).GetRoot(), v_b), 0)
+		self.assertEquals(list(v_b[0]), words * 100)
+		self.assertEquals(dict(v_b[1]), d)
+
+		for i, w in enumerate(words):
+			self.assertEquals(v_b[1][w], i)
+			self.assertEquals(v_b[1][pointless.Key(w)], i)
+			self.assert_(w in v_b[2])
+
+		self.assert_('abd' not in v_b[1])
+		self.assert_('ab' < v_b[0][3] < 'abd')
+		self.assertEquals(list(v_b[3]), sorted(words))
+		self.assertEquals(repr(v_b[0][1]), repr('a'))
+
+		del v_b
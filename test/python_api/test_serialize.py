@@ -78,3 +78,29 @@ class TestSerialize(unittest.TestCase):
 		v_ = p.GetRoot()
 		str(v)
 		str(v_)
+
+	def testInt64(self):
+		fname = 'test_int64.map'
+
+		# vectors of integers exceeding 32 bits become 64-bit vectors
+		cases = [
+			([2**40, 1, 2], 'u64'),
+			([-2**40, 5], 'i64'),
+			([2**64 - 1, 0], 'u64'),
+			((2**31, -2**31), 'i64'),
+			([2**32 - 1, 0], 'u32')
+		]
+
+		for v, typecode in cases:
+			pointless.serialize(v, fname)
+			root = pointless.Pointless(fname).GetRoot()
+			self.assertEquals(root.typecode, typecode)
+			self.assertEquals(list(root), list(v))
+			del root
+
+		# ...but there is nowhere to store them outside of integer vectors
+		for v in [[-1, 2**63], [2**33, 'a'], [2**40, 1.0]]:
+			self.assertRaises(IOError, pointless.serialize, v, fname)
+
+		for v in [2**40, {'a': 2**40}, set([2**40])]:
+			self.assertRaises(ValueError, pointless.serialize, v, fname)
@@ -103,3 +103,311 @@ class TestSetMap(unittest.TestCase):
 				del root_c
 
 			del root_a
+
+	def testKeyFastPath(self):
+		# str, unicode and int keys take a fast path, subclasses take the generic one, both must agree
+		class _str(str): pass
+		class _unicode(unicode): pass
+		class _int(int): pass
+
+		fname = 'test_key_fast_path.map'
+
+		keys = ['a', 'abc', u'unicode', u'\u2603', 0, 1, -1, 2**31 - 1, -2**31, 2**32 - 1, True, 0.5, (1, 'a')]
+		m = dict((k, i) for i, k in enumerate(keys))
+
+		pointless.serialize(m, fname)
+		root_m = pointless.Pointless(fname).GetRoot()
+
+		pointless.serialize(set(keys), fname)
+		root_s = pointless.Pointless(fname).GetRoot()
+
+		queries = ['', 'a', 'ab', 'abc', 'abcd', 'unicode', u'abc', u'\u2603', u'\u2604', 0, 1, 2, -1, -2, 2**31 - 1, -2**31, 2**32 - 1, 2**32 - 2]
+
+		for q in queries:
+			if isinstance(q, unicode):
+				qq = _unicode(q)
+			elif isinstance(q, str):
+				qq = _str(q)
+			else:
+				qq = _int(q)
+
+			self.assertEquals(q in root_m, qq in root_m)
+			self.assertEquals(q in root_s, qq in root_s)
+			self.assertEquals(root_m.get(q, -1), root_m.get(qq, -1))
+			self.assertEquals(root_m.get(q, -1), m.get(q, -1))
+
+		self.assertRaises(KeyError, lambda: root_m['missing'])
+		self.assertRaises(ValueError, lambda: root_m[2**32])
+		self.assertRaises(ValueError, lambda: 2**32 in root_s)
+
+	def testPreparedKey(self):
+		fname = 'test_prepared_key.map'
+
+		# one key, many maps
+		maps = [{'price': i, u'currency': 'EUR', 1: i, (1, 2): i} for i in xrange(10)]
+
+		pointless.serialize(maps, fname)
+		root = pointless.Pointless(fname).GetRoot()
+
+		price = pointless.Key('price')
+		currency = pointless.Key(u'currency')
+		one = pointless.Key(1)
+		pair = pointless.Key((1, 2))
+		missing = pointless.Key('missing')
+
+		self.assertEquals(price.key, 'price')
+		self.assertEquals(pointless.Key(price).key, 'price')
+
+		for m, mm in zip(maps, root):
+			self.assertEquals(mm[price], m['price'])
+			self.assertEquals(mm[currency], 'EUR')
+			self.assertEquals(mm[one], m[1])
+			self.assertEquals(mm[pair], m[(1, 2)])
+			self.assertEquals(mm.get(missing, -1), -1)
+			self.assert_(price in mm)
+			self.assert_(missing not in mm)
+			self.assertRaises(KeyError, lambda: mm[missing])
+
+		pointless.serialize(set(['price', 1]), 'test_prepared_key_set.map')
+		s = pointless.Pointless('test_prepared_key_set.map').GetRoot()
+		self.assert_(price in s)
+		self.assert_(one in s)
+		self.assert_(currency not in s)
+
+		self.assertRaises(ValueError, pointless.Key, [1, 2])
+		self.assertRaises(ValueError, pointless.Key, 2**40)
+
+	def testBloom(self):
+		keys = ['key_%i' % (i,) for i in xrange(1000)] + range(1000) + [(i, i) for i in xrange(100)]
+		missing = ['missing_%i' % (i,) for i in xrange(1000)] + range(1000, 2000) + [(i, -i) for i in xrange(1, 100)]
+		d = dict((k, i) for i, k in enumerate(keys))
+
+		pointless.serialize([d, set(keys), {1: 2}], 'test_bloom.map', bloom_threshold = 10)
+		pointless.serialize([d, set(keys), {1: 2}], 'test_no_bloom.map')
+
+		self.assert_(len(open('test_bloom.map').read()) > len(open('test_no_bloom.map').read()))
+
+		for fname in ['test_bloom.map', 'test_no_bloom.map']:
+			dd, ss, small = pointless.Pointless(fname).GetRoot()
+
+			for k in keys:
+				self.assertEquals(dd[k], d[k])
+				self.assertEquals(dd[pointless.Key(k)], d[k])
+				self.assert_(k in ss)
+
+			for k in missing:
+				self.assert_(k not in dd)
+				self.assert_(pointless.Key(k) not in dd)
+				self.assert_(k not in ss)
+				self.assertEquals(dd.get(k, -1), -1)
+
+			self.assertEquals(small[1], 2)
+			self.assert_(3 not in small)
+
+	def testCompactHashTables(self):
+		fname = 'test_compact.map'
+
+		# 8, 16 and 32-bit index slots
+		for n in [0, 1, 2, 254, 255, 256, 1000, 70000]:
+			keys = [(i * 7919) % 100003 for i in xrange(n)]
+			missing = [-1, 100003, 'missing'] + [k + 100003 for k in keys[:100]]
+			d = dict((k, i) for i, k in enumerate(keys))
+			s = set(keys)
+
+			for bloom_threshold in [0, 1]:
+				pointless.serialize([d, s], fname, compact_hash_tables = True, bloom_threshold = bloom_threshold)
+				dd, ss = pointless.Pointless(fname).GetRoot()
+
+				# entries are iterated in the order they were added
+				self.assertEquals(len(dd), n)
+				self.assertEquals(len(ss), n)
+				self.assertEquals(dd.keys(), d.keys())
+				self.assertEquals(dd.items(), d.items())
+				self.assertEquals(list(ss), list(s))
+
+				for k in keys:
+					self.assertEquals(dd[k], d[k])
+					self.assertEquals(dd[pointless.Key(k)], d[k])
+					self.assert_(k in ss)
+
+				for k in missing:
+					self.assert_(k not in dd)
+					self.assert_(pointless.Key(k) not in dd)
+					self.assert_(k not in ss)
+
+		# mixed keys
+		d = {'a': 1, u'b': 2, (1, 2): 3, 1.5: 4, None: 5}
+		pointless.serialize(d, fname, compact_hash_tables = True)
+		dd = pointless.Pointless(fname).GetRoot()
+		self.assertEquals(dd.values(), d.values())
+
+		# smaller than the regular layout
+		d = dict((i, i) for i in xrange(1000))
+		compact = pointless.serialize_to_buffer(d, compact_hash_tables = True)
+		regular = pointless.serialize_to_buffer(d)
+		self.assert_(len(compact) < len(regular))
+
+	def testTypedHashTables(self):
+		fname = 'test_typed.map'
+
+		# 8, 16 and 32-bit integers, floats, and keys/values which can not be typed
+		key_lists = [
+			range(200),
+			range(-1000, 1000, 3),
+			[i * 2654435761 % 2**32 for i in xrange(1000)],
+			[i + 0.5 for i in xrange(100)],
+			[True, 2, 3],
+			[1, 2.5],
+			['a', 1]
+		]
+
+		value_lists = [
+			lambda i: i,
+			lambda i: -i,
+			lambda i: i * 100000,
+			lambda i: i * 0.25,
+			lambda i: str(i)
+		]
+
+		for keys in key_lists:
+			for value in value_lists:
+				d = dict((k, value(i)) for i, k in enumerate(keys))
+				s = set(keys)
+
+				for bloom_threshold in [0, 1]:
+					pointless.serialize([d, s], fname, typed_hash_tables = True, bloom_threshold = bloom_threshold)
+					dd, ss = pointless.Pointless(fname).GetRoot()
+
+					self.assertEquals(len(dd), len(d))
+					self.assertEquals(len(ss), len(s))
+					self.assertEquals(sorted(dd.keys()), sorted(d.keys()))
+					self.assertEquals(sorted(dd.values()), sorted(d.values()))
+					self.assertEquals(sorted(dd.items()), sorted(d.items()))
+					self.assertEquals(sorted(ss), sorted(s))
+					self.assertEquals(eval(str(dd)), d)
+
+					for k in keys:
+						self.assertEquals(dd[k], d[k])
+						self.assertEquals(dd.get(k), d[k])
+						self.assertEquals(dd[pointless.Key(k)], d[k])
+						self.assert_(k in ss)
+
+					for k in [-2000, 2**32 - 1, 0.75, 'missing']:
+						self.assert_(k not in dd)
+						self.assert_(pointless.Key(k) not in dd)
+						self.assert_(k not in ss)
+
+		# numeric keys match across types
+		pointless.serialize({1: 2, 3: 4}, fname, typed_hash_tables = True)
+		dd = pointless.Pointless(fname).GetRoot()
+		self.assertEquals(dd[1.0], 2)
+		self.assertEquals(dd[3L], 4)
+
+		# a map from u32 ids to u16 counts
+		d = dict((i * 2654435761 % 2**32, i % 1000) for i in xrange(10000))
+		typed = pointless.serialize_to_buffer(d, typed_hash_tables = True)
+		regular = pointless.serialize_to_buffer(d)
+		self.assert_(len(typed) * 2 < len(regular))
+
+	def testDenseMaps(self):
+		fname = 'test_dense.map'
+
+		# dense ranges, with and without gaps, near both ends of the 32-bit range, and maps which are not dense
+		key_lists = [
+			range(1000),
+			range(-500, 500, 2),
+			range(2**32 - 100, 2**32),
+			range(-2**31, -2**31 + 10),
+			[7],
+			[0, 1000000],
+			[1, 2.5],
+			[True, 2, 3],
+			['a', 1]
+		]
+
+		value_lists = [
+			lambda i: i,
+			lambda i: i * 0.25,
+			lambda i: str(i)
+		]
+
+		for keys in key_lists:
+			for value in value_lists:
+				d = dict((k, value(i)) for i, k in enumerate(keys))
+
+				for typed in [False, True]:
+					pointless.serialize(d, fname, dense_maps = True, typed_hash_tables = typed, bloom_threshold = 1)
+					dd = pointless.Pointless(fname).GetRoot()
+
+					self.assertEquals(len(dd), len(d))
+					self.assertEquals(sorted(dd.items()), sorted(d.items()))
+					self.assertEquals(eval(str(dd)), d)
+
+					for k in keys:
+						self.assertEquals(dd[k], d[k])
+						self.assertEquals(dd.get(k), d[k])
+						self.assertEquals(dd[pointless.Key(k)], d[k])
+
+					for k in [-2**31 + 20, -1, 1001, 2**32 - 101, 0.75, 'missing']:
+						if k not in d:
+							self.assert_(k not in dd)
+							self.assert_(pointless.Key(k) not in dd)
+
+		# numeric keys match across types
+		pointless.serialize({1: 2, 3: 4}, fname, dense_maps = True)
+		dd = pointless.Pointless(fname).GetRoot()
+		self.assertEquals(dd[1.0], 2)
+		self.assertEquals(dd[3L], 4)
+		self.assertEquals(dd[True], 2)
+		self.assert_(1.5 not in dd)
+
+		# dense maps iterate in key order
+		d = dict((i, i) for i in xrange(100, 0, -1))
+		pointless.serialize(d, fname, dense_maps = True)
+		self.assertEquals(list(pointless.Pointless(fname).GetRoot()), range(1, 101))
+
+		# a map from dense ids to u16 counts
+		d = dict((i, i % 1000) for i in xrange(10000))
+		dense = pointless.serialize_to_buffer(d, dense_maps = True, typed_hash_tables = True)
+		typed = pointless.serialize_to_buffer(d, typed_hash_tables = True)
+		self.assert_(len(dense) * 2 < len(typed))
+
+	def testSharedSchemas(self):
+		fname = 'test_shared_schemas.map'
+		keys = ['id', 'name', 'score', 'tags', 1, 2.5, None]
+
+		# records with the same keys, records with other keys, and records whose keys only differ in type
+		records = [dict((k, i * len(keys) + j) for j, k in enumerate(keys)) for i in xrange(50)]
+		records += [{'id': i, 'other': i} for i in xrange(10)]
+		records += [{1: 'a'}, {1.0: 'b'}, {True: 'c'}, {1: 'd'}, {}, {}]
+
+		for dense in [False, True]:
+			for typed in [False, True]:
+				for bloom_threshold in [0, 1]:
+					pointless.serialize(records, fname, shared_schemas = True, dense_maps = dense, typed_hash_tables = typed, bloom_threshold = bloom_threshold)
+					rr = pointless.Pointless(fname).GetRoot()
+
+					self.assertEquals(len(rr), len(records))
+
+					for r, rr_ in zip(records, rr):
+						self.assertEquals(sorted(rr_.items()), sorted(r.items()))
+						self.assertEquals([type(k) for k in sorted(rr_.keys())], [type(k) for k in sorted(r.keys())])
+
+						for k, v in r.iteritems():
+							self.assertEquals(rr_[k], v)
+							self.assert_(pointless.Key(k) in rr_)
+
+						self.assert_('missing' not in rr_)
+
+		# the hash and key vectors are stored once
+		records = [dict((str(k), i) for k in xrange(12)) for i in xrange(1000)]
+		shared = pointless.serialize_to_buffer(records, shared_schemas = True)
+		plain = pointless.serialize_to_buffer(records)
+		self.assert_(len(shared) * 2 < len(plain))
+
+		# dense maps share their presence bits
+		records = [dict((k, i) for k in xrange(10)) for i in xrange(100)]
+		shared = pointless.serialize_to_buffer(records, shared_schemas = True, dense_maps = True)
+		plain = pointless.serialize_to_buffer(records, dense_maps = True)
+		self.assertEquals(sorted(pointless.Pointless(shared).GetRoot()[99].items()), sorted(records[99].items()))
+		self.assert_(len(shared) < len(plain))
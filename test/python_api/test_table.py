@@ -0,0 +1,86 @@
+#!/usr/bin/python
+
+import os, pointless
+
+from twisted.trial import unittest
+
+class TestTable(unittest.TestCase):
+	def _rows(self, n):
+		return [{'id': i, 'score': i * 0.5, 'name': 'row_%i' % (i,), 'tags': [i, None]} for i in xrange(n)]
+
+	def testRoundTrip(self):
+		fname = 'test_table.map'
+		rows = self._rows(1000)
+
+		pointless.serialize(rows, fname, columnar = True)
+		p = pointless.Pointless(fname)
+		t = p.GetRoot()
+
+		self.assert_(isinstance(t, pointless.PointlessTable))
+		self.assertEquals(len(t), len(rows))
+		self.assertEquals(sorted(t.keys()), sorted(rows[0].keys()))
+
+		for row, row_ in zip(rows, t):
+			self.assertEquals(len(row_), len(row))
+			self.assertEquals(sorted(row_.keys()), sorted(row.keys()))
+
+			for k, v in row.iteritems():
+				self.assert_(k in row_)
+				self.assert_(pointless.pointless_cmp(v, row_[k]) == 0)
+
+		self.assertEquals(t[-1]['id'], 999)
+		self.assertEquals(t[-1][pointless.Key('id')], 999)
+		self.assertEquals(t[10].get('missing', 7), 7)
+		self.assertRaises(KeyError, lambda: t[10]['missing'])
+		self.assertRaises(IndexError, lambda: t[1000])
+
+		str(t)
+		str(t[0])
+
+	def testColumn(self):
+		fname = 'test_table_column.map'
+		rows = self._rows(1000)
+
+		pointless.serialize(rows, fname, columnar = True)
+		t = pointless.Pointless(fname).GetRoot()
+
+		# numeric columns are compressed vectors, supporting the vector operations
+		ids = t.column('id')
+		self.assertEquals(ids.typecode, 'u16')
+		self.assertEquals(ids.sum(), sum(r['id'] for r in rows))
+		self.assertEquals(t.column('score').typecode, 'f')
+		self.assertEquals(list(t.column('name')), [r['name'] for r in rows])
+		self.assertRaises(KeyError, t.column, 'missing')
+
+	def testSmaller(self):
+		fname_a = 'test_table_a.map'
+		fname_b = 'test_table_b.map'
+		rows = self._rows(1000)
+
+		pointless.serialize(rows, fname_a, columnar = True)
+		pointless.serialize(rows, fname_b)
+
+		self.assert_(os.path.getsize(fname_a) < os.path.getsize(fname_b))
+
+	def testNotTable(self):
+		fname = 'test_table_not.map'
+
+		# differing keys, non-dicts, empty dicts and empty lists are all plain vectors
+		cases = [
+			[{'a': 1}, {'b': 1}],
+			[{'a': 1}, {'a': 1, 'b': 2}],
+			[{'a': 1}, 1],
+			[{}, {}],
+			[]
+		]
+
+		for v in cases:
+			pointless.serialize(v, fname, columnar = True)
+			root = pointless.Pointless(fname).GetRoot()
+			self.assert_(isinstance(root, pointless.PointlessVector))
+			self.assert_(pointless.pointless_cmp(v, root) == 0)
+			del root
+
+		# columnar is opt-in
+		pointless.serialize(self._rows(10), fname)
+		self.assert_(isinstance(pointless.Pointless(fname).GetRoot(), pointless.PointlessVector))